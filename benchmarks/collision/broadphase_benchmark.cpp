@@ -0,0 +1,511 @@
+#include "axiom/collision/collision_layers.hpp"
+#include "axiom/collision/dynamic_aabb_tree.hpp"
+#include "axiom/collision/overlapping_pair_cache.hpp"
+#include "axiom/collision/sweep_and_prune.hpp"
+#include "axiom/collision/uniform_grid.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Bodies on a jittered grid with unit spacing (neighbours nearly touch)
+struct Scene {
+    std::vector<Vec3> centers;
+    std::vector<Vec3> velocities;
+};
+
+Scene makeScene(size_t bodyCount, float movingFraction) {
+    Scene scene;
+    scene.centers.resize(bodyCount);
+    scene.velocities.resize(bodyCount);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> jitter(-0.1f, 0.1f);
+    std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const auto side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(bodyCount))));
+    for (size_t i = 0; i < bodyCount; ++i) {
+        const auto x = static_cast<float>(i % side);
+        const auto y = static_cast<float>((i / side) % side);
+        const auto z = static_cast<float>(i / (side * side));
+        scene.centers[i] = Vec3(x + jitter(rng), y + jitter(rng), z + jitter(rng)) * 1.2f;
+        if (unit(rng) < movingFraction) {
+            scene.velocities[i] = Vec3(speed(rng), speed(rng), speed(rng));
+        }
+    }
+    return scene;
+}
+
+AABB bodyBounds(const Vec3& center) {
+    return AABB::fromCenterExtents(center, Vec3(0.5f));
+}
+
+}  // namespace
+
+// ============================================================================
+// Benchmark: DynamicAABBTree - Build
+// ============================================================================
+
+static void BM_DynamicAABBTree_Build(benchmark::State& state) {
+    const Scene scene = makeScene(static_cast<size_t>(state.range(0)), 0.0f);
+
+    for (auto _ : state) {
+        DynamicAABBTreeConfig config;
+        config.initialCapacity = static_cast<uint32_t>(2 * scene.centers.size());
+        DynamicAABBTree tree(config);
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            tree.createProxy(bodyBounds(scene.centers[i]), i);
+        }
+        benchmark::DoNotOptimize(tree.getHeight());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DynamicAABBTree_Build)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Benchmark: Broadphase step
+// ============================================================================
+
+// Args: body count, percentage of bodies moving at up to 3 m/s (the rest
+// jiggle by solver noise). 5% is a mostly resting scene, 100% a debris pile.
+
+static void BM_DynamicAABBTree_Step(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    Scene scene = makeScene(static_cast<size_t>(state.range(0)),
+                            static_cast<float>(state.range(1)) * 0.01f);
+
+    DynamicAABBTree tree;
+    std::vector<ProxyMove> moves(scene.centers.size());
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        moves[i].id = tree.createProxy(bodyBounds(scene.centers[i]), i);
+    }
+    tree.clearMoved();
+
+    size_t pairs = 0;
+    size_t reinserted = 0;
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        const float noise = (frame++ & 1u) ? 0.001f : -0.001f;
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            const Vec3 displacement = scene.velocities[i] * Dt + Vec3(noise);
+            scene.centers[i] = scene.centers[i] + displacement;
+            moves[i].aabb = bodyBounds(scene.centers[i]);
+            moves[i].displacement = displacement;
+        }
+
+        reinserted += tree.moveProxies(moves);
+        pairs += tree.updatePairs([](ProxyId a, ProxyId b) { benchmark::DoNotOptimize(a + b); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["reinserts/frame"] =
+        benchmark::Counter(static_cast<double>(reinserted), benchmark::Counter::kAvgIterations);
+    state.counters["pairs/frame"] =
+        benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DynamicAABBTree_Step)
+    ->Args({10000, 5})
+    ->Args({100000, 5})
+    ->Args({100000, 100})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_SweepAndPrune_Step(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    Scene scene = makeScene(static_cast<size_t>(state.range(0)),
+                            static_cast<float>(state.range(1)) * 0.01f);
+
+    SweepAndPrune sap;
+    std::vector<ProxyId> ids(scene.centers.size());
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        ids[i] = sap.createProxy(bodyBounds(scene.centers[i]), i);
+    }
+    sap.update();
+
+    size_t pairs = 0;
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        const float noise = (frame++ & 1u) ? 0.001f : -0.001f;
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            scene.centers[i] = scene.centers[i] + scene.velocities[i] * Dt + Vec3(noise);
+            sap.moveProxy(ids[i], bodyBounds(scene.centers[i]));
+        }
+
+        pairs += sap.updatePairs([](ProxyId a, ProxyId b) { benchmark::DoNotOptimize(a + b); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["pairs/frame"] =
+        benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SweepAndPrune_Step)
+    ->Args({10000, 5})
+    ->Args({100000, 5})
+    ->Args({100000, 100})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_UniformGrid_Step(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    Scene scene = makeScene(static_cast<size_t>(state.range(0)),
+                            static_cast<float>(state.range(1)) * 0.01f);
+
+    UniformGrid grid;
+    std::vector<ProxyId> ids(scene.centers.size());
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        ids[i] = grid.createProxy(bodyBounds(scene.centers[i]), i);
+    }
+
+    size_t pairs = 0;
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        const float noise = (frame++ & 1u) ? 0.001f : -0.001f;
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            scene.centers[i] = scene.centers[i] + scene.velocities[i] * Dt + Vec3(noise);
+            grid.moveProxy(ids[i], bodyBounds(scene.centers[i]));
+        }
+
+        pairs += grid.updatePairs([](ProxyId a, ProxyId b) { benchmark::DoNotOptimize(a + b); });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["pairs/frame"] =
+        benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kAvgIterations);
+    state.counters["entries"] = static_cast<double>(grid.getStats().entryCount);
+}
+BENCHMARK(BM_UniformGrid_Step)
+    ->Args({10000, 5})
+    ->Args({100000, 5})
+    ->Args({100000, 100})
+    ->Args({500000, 100})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Benchmark: Collision layers
+// ============================================================================
+
+// A 200 x 200 floor of overlapping static tiles with 5000 bodies moving above
+// it. Arg 0: one SweepAndPrune for everything, pairs filtered afterwards.
+// Arg 1: LayeredBroadphase (static tree queried by a dynamic sweep-and-prune).
+
+static void BM_CollisionLayers_StaticWorld(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    constexpr int FloorSide = 200;
+    const bool layered = state.range(0) != 0;
+
+    Scene scene = makeScene(5000, 1.0f);
+    std::vector<AABB> tiles;
+    for (int x = 0; x < FloorSide; ++x) {
+        for (int z = 0; z < FloorSide; ++z) {
+            const Vec3 center(static_cast<float>(x) * 0.5f, -0.5f, static_cast<float>(z) * 0.5f);
+            tiles.push_back(AABB::fromCenterExtents(center, Vec3(0.3f, 0.5f, 0.3f)));
+        }
+    }
+
+    LayeredBroadphase layers;
+    SweepAndPrune single;
+    std::vector<bool> isStatic;
+    for (const AABB& tile : tiles) {
+        if (layered) {
+            layers.createProxy(CollisionLayer::Static, tile, {}, 0);
+        } else {
+            single.createProxy(tile, 0);
+            isStatic.push_back(true);
+        }
+    }
+    std::vector<ProxyId> ids(scene.centers.size());
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        const AABB bounds = bodyBounds(scene.centers[i]);
+        if (layered) {
+            ids[i] = layers.createProxy(CollisionLayer::Dynamic, bounds, {}, i);
+        } else {
+            ids[i] = single.createProxy(bounds, i);
+            isStatic.push_back(false);
+        }
+    }
+
+    size_t pairs = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            const Vec3 displacement = scene.velocities[i] * Dt;
+            scene.centers[i] = scene.centers[i] + displacement;
+            if (layered) {
+                layers.moveProxy(ids[i], bodyBounds(scene.centers[i]), displacement);
+            } else {
+                single.moveProxy(ids[i], bodyBounds(scene.centers[i]));
+            }
+        }
+
+        if (layered) {
+            pairs += layers.updatePairs(
+                [](ProxyId a, ProxyId b) { benchmark::DoNotOptimize(a + b); });
+        } else {
+            single.updatePairs([&](ProxyId a, ProxyId b) {
+                if (!(isStatic[a] && isStatic[b])) {
+                    benchmark::DoNotOptimize(a + b);
+                    ++pairs;
+                }
+            });
+        }
+    }
+
+    state.counters["pairs/frame"] =
+        benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CollisionLayers_StaticWorld)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// 100k bodies created in random order, so neighbours in space are far apart in
+// the broadphase storage; half of them jiggle in place, the rest are static.
+// Arg 0 never reorders; Arg 1 lets the Morton reorder finish during warm-up.
+
+static void BM_CollisionLayers_Reorder(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    constexpr int WarmUpSteps = 40;
+    Scene scene = makeScene(100000, 0.5f);
+    std::vector<size_t> order(scene.centers.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+    LayeredBroadphaseConfig config;
+    config.reorderShardSize = state.range(0) != 0 ? 4096 : 0;
+    LayeredBroadphase layers(config);
+    std::vector<ProxyId> ids(scene.centers.size());
+    for (const size_t i : order) {
+        const auto layer =
+            scene.velocities[i] != Vec3::zero() ? CollisionLayer::Dynamic : CollisionLayer::Static;
+        ids[i] = layers.createProxy(layer, bodyBounds(scene.centers[i]), {}, i);
+    }
+
+    // Alternate the direction so every step sees the same scene
+    float direction = 1.0f;
+    const auto step = [&] {
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            if (scene.velocities[i] != Vec3::zero()) {
+                const Vec3 displacement = scene.velocities[i] * (direction * Dt);
+                scene.centers[i] = scene.centers[i] + displacement;
+                layers.moveProxy(ids[i], bodyBounds(scene.centers[i]), displacement);
+            }
+        }
+        direction = -direction;
+        layers.updatePairs([](ProxyId a, ProxyId b) { benchmark::DoNotOptimize(a + b); });
+    };
+    for (int i = 0; i < WarmUpSteps; ++i) {
+        step();
+    }
+
+    for (auto _ : state) {
+        step();
+    }
+
+    const LayeredBroadphaseStats& stats = layers.getStats();
+    state.counters["pairs/frame"] = stats.pairCount;
+    state.counters["distant"] =
+        static_cast<double>(stats.distantPairs) / static_cast<double>(stats.pairCount);
+}
+BENCHMARK(BM_CollisionLayers_Reorder)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// 20k bodies, a fifth of them moving, among 4000 trigger volumes. Arg 0
+// routes the volumes through the pair path (a tree layer paired with the
+// bodies, pairs kept in an OverlappingPairCache); Arg 1 puts them in the
+// Trigger layer, whose overlaps come out as enter/exit events.
+
+static void BM_CollisionLayers_Triggers(benchmark::State& state) {
+    constexpr float Dt = 1.0f / 120.0f;
+    const bool events = state.range(0) != 0;
+    Scene scene = makeScene(20000, 0.2f);
+
+    LayeredBroadphase layers;
+    OverlappingPairCache cache;
+    std::vector<ProxyId> ids(scene.centers.size());
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        ids[i] = layers.createProxy(CollisionLayer::Dynamic, bodyBounds(scene.centers[i]), {}, i);
+    }
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(0.0f, 33.0f);
+    const auto volumeLayer = events ? CollisionLayer::Trigger : CollisionLayer::Projectile;
+    for (int i = 0; i < 4000; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        layers.createProxy(volumeLayer, AABB::fromCenterExtents(center, Vec3(1.5f)), {}, 0);
+    }
+    cache.beginUpdate();
+    layers.updatePairs([&](ProxyId a, ProxyId b) { cache.addPair(a, b); });
+    cache.endUpdate();
+
+    // Alternate the direction so every step sees the same scene
+    float direction = 1.0f;
+    size_t reported = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < scene.centers.size(); ++i) {
+            if (scene.velocities[i] != Vec3::zero()) {
+                const Vec3 displacement = scene.velocities[i] * (direction * Dt);
+                scene.centers[i] = scene.centers[i] + displacement;
+                layers.moveProxy(ids[i], bodyBounds(scene.centers[i]), displacement);
+            }
+        }
+        direction = -direction;
+
+        cache.beginUpdate();
+        layers.updatePairs([&](ProxyId a, ProxyId b) { cache.addPair(a, b); });
+        cache.endUpdate();
+        reported += events ? layers.getTriggerEvents().size()
+                           : cache.getAddedPairs().size() + cache.getRemovedPairs().size();
+    }
+
+    state.counters["pairs"] = cache.getPairCount();
+    state.counters["trigger_overlaps"] = layers.getStats().triggerOverlaps;
+    state.counters["changes/frame"] =
+        benchmark::Counter(static_cast<double>(reported), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CollisionLayers_Triggers)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Benchmark: DynamicAABBTree - Rebuild
+// ============================================================================
+
+// Args: 0 rebuilds on the step thread in one call, 1 slices the build over the
+// rebuild steps, 2 builds on a job system worker. The reported time is the
+// longest single call: the spike the step thread sees. A short sleep between
+// calls stands in for the rest of the step, when the worker gets to run.
+
+static void BM_DynamicAABBTree_Rebuild(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    const int mode = static_cast<int>(state.range(0));
+    const Scene scene = makeScene(100000, 0.0f);
+
+    DynamicAABBTreeConfig config;
+    config.initialCapacity = static_cast<uint32_t>(2 * scene.centers.size());
+    config.rebuildCostRatio = 0.01f;  // Always due, so every cycle rebuilds
+    DynamicAABBTree tree(config);
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        tree.createProxy(bodyBounds(scene.centers[i]), i);
+    }
+    const float incrementalCost = tree.getSahCost();
+
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 2;  // The step thread and one background worker
+    axiom::core::JobSystem jobs(jobConfig);
+    axiom::core::JobSystem* jobSystem = mode == 2 ? &jobs : nullptr;
+
+    for (auto _ : state) {
+        double worst = 0.0;
+        if (mode == 0) {
+            const auto start = Clock::now();
+            tree.rebuild();
+            worst = std::chrono::duration<double>(Clock::now() - start).count();
+        } else {
+            bool installed = false;
+            while (!installed) {
+                const auto start = Clock::now();
+                installed = tree.updateRebuild(jobSystem);
+                const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                worst = std::max(worst, elapsed);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        state.SetIterationTime(worst);
+    }
+
+    state.counters["sah_incremental"] = incrementalCost;
+    state.counters["sah_rebuilt"] = tree.getSahCost();
+}
+BENCHMARK(BM_DynamicAABBTree_Rebuild)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Benchmark: DynamicAABBTree - Region query
+// ============================================================================
+
+static void BM_DynamicAABBTree_Query(benchmark::State& state) {
+    const Scene scene = makeScene(100000, 0.0f);
+    DynamicAABBTree tree;
+    for (size_t i = 0; i < scene.centers.size(); ++i) {
+        tree.createProxy(bodyBounds(scene.centers[i]), i);
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(0.0f, 55.0f);
+    const auto halfExtent = static_cast<float>(state.range(0));
+
+    size_t hits = 0;
+    for (auto _ : state) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const AABB region = AABB::fromCenterExtents(center, Vec3(halfExtent));
+        tree.query(region, [&hits](ProxyId) {
+            ++hits;
+            return true;
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hits/query"] =
+        benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DynamicAABBTree_Query)->Arg(1)->Arg(4)->Arg(16);
+
+// ============================================================================
+// Benchmark: OverlappingPairCache - Update
+// ============================================================================
+
+// Args: pair count. Each frame 2% of the pairs are replaced by new ones, about
+// the churn of a settling pile.
+
+static void BM_OverlappingPairCache_Update(benchmark::State& state) {
+    const auto pairCount = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<ProxyId> proxy(0, static_cast<ProxyId>(pairCount));
+    const auto randomPair = [&] {
+        const ProxyId a = proxy(rng);
+        return std::pair<ProxyId, ProxyId>(a, a + 1 + proxy(rng) % 64);
+    };
+
+    std::vector<std::pair<ProxyId, ProxyId>> pairs(pairCount);
+    for (auto& pair : pairs) {
+        pair = randomPair();
+    }
+
+    OverlappingPairCache cache;
+    size_t added = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < pairCount / 50; ++i) {
+            pairs[next] = randomPair();
+            next = (next + 1) % pairCount;
+        }
+        state.ResumeTiming();
+
+        cache.beginUpdate();
+        for (const auto& [a, b] : pairs) {
+            cache.addPair(a, b);
+        }
+        cache.endUpdate();
+        added += cache.getAddedPairs().size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["added/frame"] =
+        benchmark::Counter(static_cast<double>(added), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_OverlappingPairCache_Update)->Arg(10000)->Arg(300000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
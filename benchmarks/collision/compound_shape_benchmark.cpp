@@ -0,0 +1,123 @@
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/contact_kernels.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float MaxDistance = 0.02f;
+
+/// Vehicle-like compound: a 4 m x 1 m x 2 m cluster of boxes and capsules
+std::vector<CompoundChild> makeChildren(uint32_t count) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> x(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> y(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> z(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> size(0.1f, 0.3f);
+    std::vector<CompoundChild> children;
+    for (uint32_t i = 0; i < count; ++i) {
+        const ConvexShape shape = i % 3 == 0
+                                      ? ConvexShape::capsule(size(rng), 2.0f * size(rng))
+                                      : ConvexShape::box(Vec3(size(rng), size(rng), size(rng)));
+        children.push_back({shape, Transform(Vec3(x(rng), y(rng), z(rng)))});
+    }
+    return children;
+}
+
+/// Small boxes around the compound, most of them touching some child
+std::vector<Transform> makeProbes(size_t count) {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> x(-2.5f, 2.5f);
+    std::uniform_real_distribution<float> y(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> z(-1.5f, 1.5f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    std::vector<Transform> probes;
+    for (size_t i = 0; i < count; ++i) {
+        probes.emplace_back(Vec3(x(rng), y(rng), z(rng)),
+                            Quat::fromAxisAngle(Vec3::unitY(), angle(rng)));
+    }
+    return probes;
+}
+
+}  // namespace
+
+// ============================================================================
+// Contacts
+// ============================================================================
+
+static void BM_CompoundShape_Contacts(benchmark::State& state) {
+    // The compound's kernel, which visits only the children under the probe,
+    // against running the kernel of every child in turn
+    const bool everyChild = state.range(1) != 0;
+    const std::vector<CompoundChild> children =
+        makeChildren(static_cast<uint32_t>(state.range(0)));
+    const CompoundShape compound = CompoundShape::create(children).value();
+    const ConvexShape shape = ConvexShape::compoundShape(compound);
+    const ConvexShape probe = ConvexShape::box(Vec3(0.2f));
+    const std::vector<Transform> probes = makeProbes(1024);
+    const Transform transform;
+    uint64_t points = 0;
+    for (auto _ : state) {
+        for (const Transform& probeTransform : probes) {
+            if (everyChild) {
+                for (uint32_t child = 0; child < compound.getChildCount(); ++child) {
+                    const CompoundChild& part = compound.getChild(child);
+                    ContactManifold manifold;
+                    generateContacts(
+                        {&part.shape, &part.transform, &probe, &probeTransform, nullptr},
+                        MaxDistance, manifold);
+                    points += manifold.pointCount;
+                }
+            } else {
+                ContactManifold manifold;
+                generateContacts({&shape, &transform, &probe, &probeTransform, nullptr},
+                                 MaxDistance, manifold);
+                points += manifold.pointCount;
+            }
+        }
+    }
+    const int64_t pairs = state.iterations() * static_cast<int64_t>(probes.size());
+    state.SetItemsProcessed(pairs);
+    state.counters["points"] = static_cast<double>(points) / static_cast<double>(pairs);
+}
+BENCHMARK(BM_CompoundShape_Contacts)
+    ->ArgNames({"children", "every_child"})
+    ->Args({8, 0})
+    ->Args({8, 1})
+    ->Args({40, 0})
+    ->Args({40, 1})
+    ->Args({160, 0})
+    ->Args({160, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Bounds
+// ============================================================================
+
+static void BM_CompoundShape_Bounds(benchmark::State& state) {
+    // Cached bounds of a body at rest against recomputing them every step
+    const bool cached = state.range(0) != 0;
+    const CompoundShape compound = CompoundShape::create(makeChildren(40)).value();
+    const ConvexShape shape = ConvexShape::compoundShape(compound);
+    const Transform transform(Vec3(1.0f, 2.0f, 3.0f), Quat::fromAxisAngle(Vec3::unitY(), 0.3f));
+    CompoundBoundsCache cache;
+    for (auto _ : state) {
+        if (cached) {
+            benchmark::DoNotOptimize(compound.updateBounds(transform, cache));
+        } else {
+            benchmark::DoNotOptimize(shape.computeAABB(transform));
+        }
+    }
+}
+BENCHMARK(BM_CompoundShape_Bounds)->ArgName("cached")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
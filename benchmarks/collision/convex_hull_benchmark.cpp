@@ -0,0 +1,123 @@
+#include "axiom/collision/convex_hull.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/shape.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Scanned rock: points on a lumpy unit sphere, every one of them on the hull
+std::vector<Vec3> makeRockCloud(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> component(0.0f, 1.0f);
+    std::vector<Vec3> points;
+    points.reserve(count);
+    while (points.size() < count) {
+        const Vec3 direction = Vec3(component(rng), component(rng), component(rng)).normalized();
+        points.push_back(Vec3(direction.x * 1.2f, direction.y * 0.8f, direction.z));
+    }
+    return points;
+}
+
+ConvexHull makeHull(size_t vertexCount) {
+    ConvexHullConfig config;
+    config.maxVertices = static_cast<uint32_t>(vertexCount);
+    return ConvexHull::create(makeRockCloud(vertexCount * 4, 1), config).value();
+}
+
+std::vector<Vec3> makeDirections(size_t count) {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::vector<Vec3> directions(count);
+    for (Vec3& direction : directions) {
+        direction = Vec3(component(rng), component(rng), component(rng));
+    }
+    return directions;
+}
+
+}  // namespace
+
+// ============================================================================
+// Build
+// ============================================================================
+
+static void BM_ConvexHull_Build(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const std::vector<Vec3> points = makeRockCloud(count, 3);
+    ConvexHullConfig config;
+    config.maxVertices = static_cast<uint32_t>(state.range(1));
+    uint32_t vertexCount = 0;
+    for (auto _ : state) {
+        const auto hull = ConvexHull::create(points, config);
+        vertexCount = hull.value().getVertexCount();
+        benchmark::DoNotOptimize(vertexCount);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.counters["vertices"] = static_cast<double>(vertexCount);
+}
+BENCHMARK(BM_ConvexHull_Build)
+    ->ArgNames({"points", "max"})
+    ->Args({1000, 64})
+    ->Args({1000, 1000})
+    ->Args({100000, 256})
+    ->Args({100000, 100000})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Support
+// ============================================================================
+
+static void BM_ConvexHull_Support(benchmark::State& state) {
+    // 0: linear scan over the vertices, 1: hill-climbing
+    const auto vertexCount = static_cast<size_t>(state.range(0));
+    const bool climb = state.range(1) != 0;
+    const ConvexHull hull = makeHull(vertexCount);
+    const ConvexShape scanned = ConvexShape::convex(hull.getVertices());
+    const std::vector<Vec3> directions = makeDirections(1024);
+    for (auto _ : state) {
+        for (const Vec3& direction : directions) {
+            benchmark::DoNotOptimize(climb ? hull.support(direction)
+                                           : scanned.supportCore(direction));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(directions.size()));
+}
+BENCHMARK(BM_ConvexHull_Support)
+    ->ArgNames({"vertices", "climb"})
+    ->ArgsProduct({{16, 32, 64, 256, 1024, 4096}, {0, 1}});
+
+static void BM_ConvexHull_Gjk(benchmark::State& state) {
+    // Imported 256-vertex rock against crates around it
+    const bool climb = state.range(0) != 0;
+    const ConvexHull hull = makeHull(256);
+    const ConvexShape rock = climb ? ConvexShape::convexHull(hull, 0.02f)
+                                   : ConvexShape::convex(hull.getVertices(), 0.02f);
+    const ConvexShape crate = ConvexShape::box(Vec3(0.3f));
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> component(-1.6f, 1.6f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    std::vector<Transform> crates;
+    for (int i = 0; i < 1024; ++i) {
+        crates.emplace_back(Vec3(component(rng), component(rng), component(rng)),
+                            Quat::fromAxisAngle(Vec3::unitY(), angle(rng)));
+    }
+    const Transform origin(Vec3::zero());
+    for (auto _ : state) {
+        for (const Transform& transform : crates) {
+            benchmark::DoNotOptimize(collideConvex(rock, origin, crate, transform, 0.05f));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(crates.size()));
+}
+BENCHMARK(BM_ConvexHull_Gjk)->ArgName("climb")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Rolling terrain of 1 km^2 sampled every metre (about two million triangles)
+constexpr uint32_t SampleCount = 1025;
+constexpr float CellSize = 1.0f;
+constexpr float TerrainSize = static_cast<float>(SampleCount - 1) * CellSize;
+
+std::vector<float> makeHeights() {
+    std::vector<float> heights;
+    for (uint32_t z = 0; z < SampleCount; ++z) {
+        for (uint32_t x = 0; x < SampleCount; ++x) {
+            const float px = static_cast<float>(x) * CellSize;
+            const float pz = static_cast<float>(z) * CellSize;
+            heights.push_back(4.0f * std::sin(px * 0.05f) * std::cos(pz * 0.07f) +
+                              0.5f * std::sin(px * 0.7f + pz * 0.3f));
+        }
+    }
+    return heights;
+}
+
+/// Built once and shared by the query benchmarks
+const HeightField& getHeightField() {
+    static const HeightField field = [] {
+        const std::vector<float> heights = makeHeights();
+        return HeightField::create(heights, SampleCount, SampleCount, CellSize).value();
+    }();
+    return field;
+}
+
+/// The same triangles as a TriangleMesh, for comparison
+const TriangleMesh& getTerrainMesh() {
+    static const TriangleMesh mesh = [] {
+        const HeightField& field = getHeightField();
+        std::vector<Vec3> vertices;
+        std::vector<uint32_t> indices;
+        for (uint32_t z = 0; z < SampleCount; ++z) {
+            for (uint32_t x = 0; x < SampleCount; ++x) {
+                vertices.emplace_back(static_cast<float>(x) * CellSize, field.getHeight(x, z),
+                                      static_cast<float>(z) * CellSize);
+            }
+        }
+        for (uint32_t z = 0; z + 1 < SampleCount; ++z) {
+            for (uint32_t x = 0; x + 1 < SampleCount; ++x) {
+                const uint32_t i = z * SampleCount + x;
+                indices.insert(indices.end(), {i, i + SampleCount, i + SampleCount + 1});
+                indices.insert(indices.end(), {i, i + SampleCount + 1, i + 1});
+            }
+        }
+        return TriangleMesh::create(vertices, indices).value();
+    }();
+    return mesh;
+}
+
+std::vector<Vec3> makePoints(size_t count, float height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(0.0f, TerrainSize);
+    std::vector<Vec3> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.emplace_back(position(rng), height, position(rng));
+    }
+    return points;
+}
+
+}  // namespace
+
+// ============================================================================
+// Build
+// ============================================================================
+
+static void BM_HeightField_Build(benchmark::State& state) {
+    const std::vector<float> heights = makeHeights();
+    for (auto _ : state) {
+        auto field = HeightField::create(heights, SampleCount, SampleCount, CellSize);
+        benchmark::DoNotOptimize(field);
+    }
+    const HeightFieldStats stats = getHeightField().getStats();
+    const double triangles = 2.0 * static_cast<double>(stats.cellCount);
+    state.counters["bytes_per_triangle"] = static_cast<double>(stats.memoryBytes) / triangles;
+    state.counters["mesh_bytes_per_triangle"] =
+        static_cast<double>(getTerrainMesh().getStats().memoryBytes) / triangles;
+}
+BENCHMARK(BM_HeightField_Build)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+static void BM_HeightField_Raycast(benchmark::State& state) {
+    // Ground probes: straight down, and long grazing rays across the terrain
+    const bool mesh = state.range(0) != 0;
+    const bool grazing = state.range(1) != 0;
+    const HeightField& field = getHeightField();
+    const TriangleMesh& reference = getTerrainMesh();
+    const std::vector<Vec3> origins = makePoints(1024, 10.0f, 1);
+    const Vec3 direction = grazing ? Vec3(0.8f, -0.05f, 0.6f).normalized() : Vec3(0, -1.0f, 0);
+    uint64_t hits = 0;
+    for (auto _ : state) {
+        for (const Vec3& origin : origins) {
+            bool found = false;
+            if (mesh) {
+                MeshRayHit hit;
+                found = reference.raycast(origin, direction, 200.0f, hit);
+                benchmark::DoNotOptimize(hit);
+            } else {
+                HeightFieldRayHit hit;
+                found = field.raycast(origin, direction, 200.0f, hit);
+                benchmark::DoNotOptimize(hit);
+            }
+            hits += found ? 1 : 0;
+        }
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(origins.size());
+    state.SetItemsProcessed(queries);
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(queries);
+}
+BENCHMARK(BM_HeightField_Raycast)
+    ->ArgNames({"mesh", "grazing"})
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_HeightField_QueryAABB(benchmark::State& state) {
+    // Body-sized boxes touching the ground, as the contact kernels query them
+    const bool mesh = state.range(0) != 0;
+    const HeightField& field = getHeightField();
+    const TriangleMesh& reference = getTerrainMesh();
+    const std::vector<Vec3> centers = makePoints(1024, 0.0f, 3);
+    uint64_t triangles = 0;
+    const auto count = [&](uint32_t, const auto&) {
+        ++triangles;
+        return true;
+    };
+    for (auto _ : state) {
+        for (const Vec3& center : centers) {
+            const AABB box = AABB::fromCenterExtents(center, Vec3(1.0f, 8.0f, 1.0f));
+            if (mesh) {
+                reference.queryAABB(box, count);
+            } else {
+                field.queryAABB(box, count);
+            }
+        }
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(centers.size());
+    state.SetItemsProcessed(queries);
+    state.counters["triangles_per_query"] =
+        static_cast<double>(triangles) / static_cast<double>(queries);
+}
+BENCHMARK(BM_HeightField_QueryAABB)->ArgName("mesh")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
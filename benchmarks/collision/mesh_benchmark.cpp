@@ -0,0 +1,151 @@
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Rolling terrain of 2 * cells * cells triangles over [-size, size]^2
+struct Terrain {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+};
+
+Terrain makeTerrain(uint32_t cells, float size) {
+    Terrain terrain;
+    const float step = 2.0f * size / static_cast<float>(cells);
+    for (uint32_t z = 0; z <= cells; ++z) {
+        for (uint32_t x = 0; x <= cells; ++x) {
+            const float px = -size + step * static_cast<float>(x);
+            const float pz = -size + step * static_cast<float>(z);
+            const float height = 4.0f * std::sin(px * 0.05f) * std::cos(pz * 0.07f) +
+                                 0.5f * std::sin(px * 0.7f + pz * 0.3f);
+            terrain.vertices.emplace_back(px, height, pz);
+        }
+    }
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            const uint32_t i = z * (cells + 1) + x;
+            terrain.indices.insert(terrain.indices.end(), {i, i + cells + 1, i + 1});
+            terrain.indices.insert(terrain.indices.end(), {i + 1, i + cells + 1, i + cells + 2});
+        }
+    }
+    return terrain;
+}
+
+/// About one million triangles over 1 km^2, built once and shared by the query benchmarks
+constexpr uint32_t TerrainCells = 724;
+constexpr float TerrainSize = 500.0f;
+
+const TriangleMesh& getTerrainMesh() {
+    static const TriangleMesh mesh = [] {
+        const Terrain terrain = makeTerrain(TerrainCells, TerrainSize);
+        return TriangleMesh::create(terrain.vertices, terrain.indices).value();
+    }();
+    return mesh;
+}
+
+std::vector<Vec3> makePoints(size_t count, float height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-TerrainSize, TerrainSize);
+    std::vector<Vec3> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.emplace_back(position(rng), height, position(rng));
+    }
+    return points;
+}
+
+}  // namespace
+
+// ============================================================================
+// Build
+// ============================================================================
+
+static void BM_Mesh_Build(benchmark::State& state) {
+    const bool parallel = state.range(0) != 0;
+    const Terrain terrain = makeTerrain(TerrainCells, TerrainSize);
+    axiom::core::JobSystem jobs;
+    TriangleMeshConfig config;
+    config.jobSystem = parallel ? &jobs : nullptr;
+    for (auto _ : state) {
+        auto mesh = TriangleMesh::create(terrain.vertices, terrain.indices, config);
+        benchmark::DoNotOptimize(mesh);
+    }
+    const TriangleMeshStats stats = getTerrainMesh().getStats();
+    state.counters["triangles"] = static_cast<double>(stats.triangleCount);
+    state.counters["bytes_per_triangle"] =
+        static_cast<double>(stats.memoryBytes) / static_cast<double>(stats.triangleCount);
+}
+BENCHMARK(BM_Mesh_Build)->ArgName("parallel")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+static void BM_Mesh_Raycast(benchmark::State& state) {
+    // Ground probes: straight down, and long grazing rays across the terrain
+    const bool grazing = state.range(0) != 0;
+    const TriangleMesh& mesh = getTerrainMesh();
+    const std::vector<Vec3> origins = makePoints(1024, 10.0f, 1);
+    const Vec3 direction = grazing ? Vec3(0.8f, -0.05f, 0.6f).normalized() : Vec3(0, -1.0f, 0);
+    uint64_t hits = 0;
+    for (auto _ : state) {
+        for (const Vec3& origin : origins) {
+            MeshRayHit hit;
+            if (mesh.raycast(origin, direction, 200.0f, hit)) {
+                ++hits;
+            }
+            benchmark::DoNotOptimize(hit);
+        }
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(origins.size());
+    state.SetItemsProcessed(queries);
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(queries);
+}
+BENCHMARK(BM_Mesh_Raycast)->ArgName("grazing")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+static void BM_Mesh_ClosestPoint(benchmark::State& state) {
+    const TriangleMesh& mesh = getTerrainMesh();
+    const std::vector<Vec3> points = makePoints(1024, 6.0f, 2);
+    for (auto _ : state) {
+        for (const Vec3& point : points) {
+            MeshClosestPoint result;
+            benchmark::DoNotOptimize(mesh.closestPoint(point, 20.0f, result));
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_Mesh_ClosestPoint)->Unit(benchmark::kMicrosecond);
+
+static void BM_Mesh_QueryAABB(benchmark::State& state) {
+    // Body-sized boxes touching the ground, as the mesh-convex kernel queries them
+    const TriangleMesh& mesh = getTerrainMesh();
+    const std::vector<Vec3> centers = makePoints(1024, 0.0f, 3);
+    uint64_t triangles = 0;
+    for (auto _ : state) {
+        for (const Vec3& center : centers) {
+            const AABB box = AABB::fromCenterExtents(center, Vec3(1.0f, 8.0f, 1.0f));
+            mesh.queryAABB(box, [&](uint32_t, const auto&) {
+                ++triangles;
+                return true;
+            });
+        }
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(centers.size());
+    state.SetItemsProcessed(queries);
+    state.counters["triangles_per_query"] =
+        static_cast<double>(triangles) / static_cast<double>(queries);
+}
+BENCHMARK(BM_Mesh_QueryAABB)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
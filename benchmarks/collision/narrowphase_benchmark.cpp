@@ -0,0 +1,241 @@
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/narrowphase.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Irregular 16-point hull, roughly unit sized
+std::array<Vec3, 16> makeRock(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> radius(0.4f, 0.6f);
+    std::array<Vec3, 16> points;
+    for (Vec3& point : points) {
+        Vec3 direction(component(rng), component(rng), component(rng));
+        point = direction.normalized() * radius(rng);
+    }
+    return points;
+}
+
+/// Pairs of rocks in light contact, jittering a little every frame like a settled pile
+struct Pile {
+    std::vector<Transform> a;
+    std::vector<Transform> b;
+};
+
+Pile makePile(size_t pairCount) {
+    Pile pile;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    for (size_t i = 0; i < pairCount; ++i) {
+        const Vec3 base(static_cast<float>(i % 64) * 3.0f, 0.0f, static_cast<float>(i / 64) * 3.0f);
+        pile.a.emplace_back(base, Quat::fromAxisAngle(Vec3::unitY(), angle(rng)));
+        pile.b.emplace_back(base + Vec3(0.0f, 0.95f, 0.0f),
+                            Quat::fromAxisAngle(Vec3::unitX(), angle(rng)));
+    }
+    return pile;
+}
+
+void jitter(Pile& pile, uint32_t frame) {
+    const float offset = (frame % 2 == 0 ? 1.0f : -1.0f) * 0.002f;
+    for (Transform& transform : pile.b) {
+        transform.position.x += offset;
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// GJK/EPA
+// ============================================================================
+
+static void BM_Gjk_RockPile(benchmark::State& state) {
+    const auto pairCount = static_cast<size_t>(state.range(0));
+    const bool warm = state.range(1) != 0;
+    const std::array<Vec3, 16> rockA = makeRock(1);
+    const std::array<Vec3, 16> rockB = makeRock(2);
+    const ConvexShape shapeA = ConvexShape::convex(rockA, 0.02f);
+    const ConvexShape shapeB = ConvexShape::convex(rockB, 0.02f);
+
+    Pile pile = makePile(pairCount);
+    std::vector<SimplexCache> caches(pairCount);
+    uint32_t frame = 0;
+    uint64_t iterations = 0;
+    uint64_t queries = 0;
+    for (auto _ : state) {
+        jitter(pile, frame++);
+        for (size_t i = 0; i < pairCount; ++i) {
+            const ConvexContact contact = collideConvex(shapeA, pile.a[i], shapeB, pile.b[i], 0.05f,
+                                                        warm ? &caches[i] : nullptr);
+            iterations += contact.gjkIterations;
+            benchmark::DoNotOptimize(contact);
+        }
+        queries += pairCount;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(queries));
+    state.counters["gjk_iterations"] =
+        static_cast<double>(iterations) / static_cast<double>(queries);
+}
+BENCHMARK(BM_Gjk_RockPile)
+    ->ArgNames({"pairs", "warm"})
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Gjk_SeparatedPairs(benchmark::State& state) {
+    // Broadphase pairs whose shapes do not touch: the cached axis rejects them
+    const bool warm = state.range(0) != 0;
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f));
+    Pile pile = makePile(4096);
+    for (Transform& transform : pile.b) {
+        transform.position.y += 0.5f;
+    }
+    std::vector<SimplexCache> caches(pile.a.size());
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        jitter(pile, frame++);
+        for (size_t i = 0; i < pile.a.size(); ++i) {
+            benchmark::DoNotOptimize(
+                collideConvex(box, pile.a[i], box, pile.b[i], 0.0f, warm ? &caches[i] : nullptr));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 4096));
+}
+BENCHMARK(BM_Gjk_SeparatedPairs)
+    ->ArgName("warm")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Contact kernels
+// ============================================================================
+
+static void BM_Contacts_Resting(benchmark::State& state) {
+    // Shapes resting on the ground or on a box: through the analytic kernels,
+    // or through GJK/EPA with the ground as a large box
+    const auto kind = static_cast<size_t>(state.range(0));
+    const bool generic = state.range(1) != 0;
+    const std::array<ConvexShape, 3> bodies = {ConvexShape::sphere(0.5f),
+                                               ConvexShape::box(Vec3(0.5f)),
+                                               ConvexShape::capsule(0.3f, 1.0f)};
+    const ConvexShape plane = ConvexShape::plane();
+    const ConvexShape groundBox = ConvexShape::box(Vec3(1000.0f, 1.0f, 1000.0f));
+    const ConvexShape crate = ConvexShape::box(Vec3(0.5f));
+    const ConvexShape& body = bodies[kind % 3];
+    const bool onBox = kind >= 3;
+    const ConvexShape& ground = onBox ? crate : (generic ? groundBox : plane);
+
+    constexpr size_t PairCount = 4096;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> tilt(-0.2f, 0.2f);
+    std::vector<Transform> transforms;
+    transforms.reserve(2 * PairCount);
+    for (size_t i = 0; i < PairCount; ++i) {
+        const float x = static_cast<float>(i % 64) * 3.0f;
+        const float z = static_cast<float>(i / 64) * 3.0f;
+        const float groundTop = onBox ? 0.5f : 0.0f;
+        const Vec3 groundCenter(x, generic && !onBox ? -1.0f : 0.0f, z);
+        transforms.emplace_back(groundCenter);
+        transforms.emplace_back(Vec3(x + tilt(rng), groundTop + 0.48f, z),
+                                Quat::fromAxisAngle(Vec3::unitY(), tilt(rng)));
+    }
+    std::vector<ContactPair> pairs;
+    for (size_t i = 0; i < PairCount; ++i) {
+        pairs.push_back({&body, &transforms[2 * i + 1], &ground, &transforms[2 * i], nullptr});
+    }
+
+    ContactDispatcher dispatcher;
+    std::vector<ContactManifold> manifolds(PairCount);
+    for (auto _ : state) {
+        if (generic) {
+            for (size_t i = 0; i < PairCount; ++i) {
+                manifolds[i].clear();
+                collideConvexGeneric(pairs[i], 0.02f, manifolds[i]);
+            }
+        } else {
+            dispatcher.generate(pairs, 0.02f, manifolds);
+        }
+        benchmark::DoNotOptimize(manifolds.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(PairCount));
+}
+BENCHMARK(BM_Contacts_Resting)
+    ->ArgNames({"shape", "generic"})
+    ->ArgsProduct({{0, 1, 2, 3, 4, 5}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Parallel narrowphase
+// ============================================================================
+
+static void BM_Narrowphase_RockPile(benchmark::State& state) {
+    // Every pair of a settled rock pile through the pair cache, on 0 (no job
+    // system) to 8 workers; the output is the same for every worker count
+    const auto workers = static_cast<uint32_t>(state.range(0));
+    constexpr size_t PairCount = 8192;
+    const std::array<Vec3, 16> rockA = makeRock(1);
+    const std::array<Vec3, 16> rockB = makeRock(2);
+    const ConvexShape shapeA = ConvexShape::convex(rockA);
+    const ConvexShape shapeB = ConvexShape::convex(rockB);
+    Pile pile = makePile(PairCount);
+
+    std::vector<SceneObject> objects(2 * PairCount);
+    OverlappingPairCache cache({.initialCapacity = PairCount});
+    cache.beginUpdate();
+    for (uint32_t i = 0; i < PairCount; ++i) {
+        cache.addPair(2 * i, 2 * i + 1);
+    }
+    cache.endUpdate();
+
+    std::unique_ptr<axiom::core::JobSystem> jobs;
+    if (workers > 0) {
+        axiom::core::JobSystemConfig config;
+        config.workerCount = workers;
+        jobs = std::make_unique<axiom::core::JobSystem>(config);
+    }
+    Narrowphase narrowphase;
+    uint32_t frame = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        jitter(pile, frame++);
+        for (size_t i = 0; i < PairCount; ++i) {
+            objects[2 * i] = {&shapeA, pile.a[i]};
+            objects[2 * i + 1] = {&shapeB, pile.b[i]};
+        }
+        state.ResumeTiming();
+        narrowphase.update(cache, objects, jobs.get());
+        benchmark::DoNotOptimize(narrowphase.getContacts().data());
+        if (jobs != nullptr) {
+            jobs->flipScratchAllocators();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(PairCount));
+    state.counters["touching"] = static_cast<double>(narrowphase.getStats().touchingCount);
+    state.counters["overflow"] = static_cast<double>(narrowphase.getStats().overflowCount);
+}
+BENCHMARK(BM_Narrowphase_RockPile)
+    ->ArgName("workers")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
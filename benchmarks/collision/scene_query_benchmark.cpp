@@ -0,0 +1,159 @@
+#include "axiom/collision/scene_query.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float WorldSize = 200.0f;
+
+/// Rolling ground mesh under a few thousand boxes and spheres, as in an open level
+struct World {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    TriangleMesh mesh;
+    std::vector<std::unique_ptr<ConvexShape>> shapes;
+    std::vector<SceneObject> objects;
+    LayeredBroadphase broadphase;
+
+    World() {
+        constexpr uint32_t Cells = 256;
+        const float step = 2.0f * WorldSize / static_cast<float>(Cells);
+        for (uint32_t z = 0; z <= Cells; ++z) {
+            for (uint32_t x = 0; x <= Cells; ++x) {
+                const float px = -WorldSize + step * static_cast<float>(x);
+                const float pz = -WorldSize + step * static_cast<float>(z);
+                vertices.emplace_back(px, 3.0f * std::sin(px * 0.05f) * std::cos(pz * 0.07f), pz);
+            }
+        }
+        for (uint32_t z = 0; z < Cells; ++z) {
+            for (uint32_t x = 0; x < Cells; ++x) {
+                const uint32_t i = z * (Cells + 1) + x;
+                indices.insert(indices.end(), {i, i + Cells + 1, i + 1});
+                indices.insert(indices.end(), {i + 1, i + Cells + 1, i + Cells + 2});
+            }
+        }
+        mesh = TriangleMesh::create(vertices, indices).value();
+        add(CollisionLayer::Static, ConvexShape::triangleMesh(mesh), Transform(Vec3::zero()));
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> position(-WorldSize, WorldSize);
+        std::uniform_real_distribution<float> height(2.0f, 12.0f);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+        for (uint32_t i = 0; i < 4000; ++i) {
+            const ConvexShape shape = i % 2 == 0
+                                          ? ConvexShape::box(Vec3(size(rng), size(rng), size(rng)))
+                                          : ConvexShape::sphere(size(rng));
+            const Transform transform(Vec3(position(rng), height(rng), position(rng)),
+                                      Quat::fromAxisAngle(Vec3::unitY(), angle(rng)));
+            add(i % 4 == 0 ? CollisionLayer::Static : CollisionLayer::Dynamic, shape, transform);
+        }
+        broadphase.updatePairs([](ProxyId, ProxyId) {});
+    }
+
+    void add(CollisionLayer layer, const ConvexShape& shape, const Transform& transform) {
+        shapes.push_back(std::make_unique<ConvexShape>(shape));
+        objects.push_back({shapes.back().get(), transform});
+        broadphase.createProxy(layer, shape.computeAABB(transform), {}, objects.size() - 1);
+    }
+};
+
+const World& getWorld() {
+    static const World world;
+    return world;
+}
+
+/// Line-of-sight checks: 10k rays from agents towards nearby targets, in random order
+std::vector<Ray> makeSightRays(size_t count) {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> position(-WorldSize, WorldSize);
+    std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+    std::vector<Ray> rays;
+    for (size_t i = 0; i < count; ++i) {
+        const Vec3 origin(position(rng), 6.0f, position(rng));
+        const Vec3 target = origin + Vec3(offset(rng), -4.0f, offset(rng));
+        const Vec3 delta = target - origin;
+        rays.push_back({origin, delta.normalized(), delta.length()});
+    }
+    return rays;
+}
+
+}  // namespace
+
+// ============================================================================
+// Rays
+// ============================================================================
+
+static void BM_SceneQuery_Raycast(benchmark::State& state) {
+    // 0: one ray per call, 1: one batch, 2: one batch across the job system
+    const int64_t mode = state.range(0);
+    const bool anyHit = state.range(1) != 0;
+    const World& world = getWorld();
+    const SceneQuery scene(world.broadphase, world.objects);
+    const std::vector<Ray> rays = makeSightRays(10000);
+    std::vector<SceneHit> hits(rays.size());
+    axiom::core::JobSystem jobs;
+    SceneQueryOptions options;
+    options.mode = anyHit ? SceneQueryMode::AnyHit : SceneQueryMode::ClosestHit;
+    options.jobSystem = mode == 2 ? &jobs : nullptr;
+
+    uint64_t hitCount = 0;
+    for (auto _ : state) {
+        if (mode == 0) {
+            for (size_t i = 0; i < rays.size(); ++i) {
+                hitCount += scene.raycast({&rays[i], 1}, {&hits[i], 1}, options);
+            }
+        } else {
+            hitCount += scene.raycast(rays, hits, options);
+        }
+        benchmark::DoNotOptimize(hits.data());
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(rays.size());
+    state.SetItemsProcessed(queries);
+    state.counters["hit_rate"] = static_cast<double>(hitCount) / static_cast<double>(queries);
+}
+BENCHMARK(BM_SceneQuery_Raycast)
+    ->ArgNames({"mode", "any"})
+    ->ArgsProduct({{0, 1, 2}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Shape casts
+// ============================================================================
+
+static void BM_SceneQuery_ShapeCast(benchmark::State& state) {
+    // Character-sized capsules swept along the ground
+    const World& world = getWorld();
+    const SceneQuery scene(world.broadphase, world.objects);
+    const ConvexShape capsule = ConvexShape::capsule(0.4f, 1.0f);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-WorldSize, WorldSize);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::vector<ShapeCast> casts;
+    for (int i = 0; i < 1000; ++i) {
+        const Vec3 direction = Vec3(component(rng), -0.2f, component(rng)).normalized();
+        casts.push_back({&capsule, Transform(Vec3(position(rng), 5.0f, position(rng))),
+                         direction, 10.0f});
+    }
+    std::vector<SceneHit> hits(casts.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scene.shapeCast(casts, hits));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(casts.size()));
+}
+BENCHMARK(BM_SceneQuery_ShapeCast)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,167 @@
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Rock of about 2 m: a sphere with bumps, 128 x 256 quads (65k triangles)
+constexpr uint32_t Rings = 128;
+constexpr uint32_t Segments = 256;
+constexpr float Pi = 3.14159265f;
+
+/// Cloth-sized particles
+constexpr float ParticleRadius = 0.01f;
+constexpr float ContactDistance = 0.01f;
+
+constexpr SignedDistanceFieldConfig FieldConfig = {.cellSize = 0.02f, .narrowBand = 0.06f};
+
+float getRockRadius(float theta, float phi) {
+    return 1.0f + 0.08f * std::sin(5.0f * theta) * std::cos(7.0f * phi) +
+           0.03f * std::sin(17.0f * theta + 11.0f * phi);
+}
+
+struct RockMesh {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+};
+
+const RockMesh& getRockMesh() {
+    static const RockMesh rock = [] {
+        RockMesh mesh;
+        const auto direction = [](float theta, float phi) {
+            return Vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                        std::sin(theta) * std::sin(phi));
+        };
+        // Poles, then the rings between them
+        mesh.vertices.push_back(direction(0.0f, 0.0f) * getRockRadius(0.0f, 0.0f));
+        mesh.vertices.push_back(direction(Pi, 0.0f) * getRockRadius(Pi, 0.0f));
+        for (uint32_t ring = 1; ring < Rings; ++ring) {
+            const float theta = Pi * static_cast<float>(ring) / static_cast<float>(Rings);
+            for (uint32_t segment = 0; segment < Segments; ++segment) {
+                const float phi = 2.0f * Pi * static_cast<float>(segment) / Segments;
+                mesh.vertices.push_back(direction(theta, phi) * getRockRadius(theta, phi));
+            }
+        }
+        const auto at = [](uint32_t ring, uint32_t segment) {
+            return 2 + (ring - 1) * Segments + segment % Segments;
+        };
+        for (uint32_t segment = 0; segment < Segments; ++segment) {
+            mesh.indices.insert(mesh.indices.end(), {0u, at(1, segment + 1), at(1, segment)});
+            mesh.indices.insert(mesh.indices.end(),
+                                {1u, at(Rings - 1, segment), at(Rings - 1, segment + 1)});
+            for (uint32_t ring = 1; ring + 1 < Rings; ++ring) {
+                const uint32_t a = at(ring, segment);
+                const uint32_t b = at(ring, segment + 1);
+                const uint32_t c = at(ring + 1, segment);
+                const uint32_t d = at(ring + 1, segment + 1);
+                mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+            }
+        }
+        return mesh;
+    }();
+    return rock;
+}
+
+/// Built once and shared by the query benchmarks
+const SignedDistanceField& getField() {
+    static const SignedDistanceField field = [] {
+        const RockMesh& rock = getRockMesh();
+        return SignedDistanceField::create(rock.vertices, rock.indices, FieldConfig).value();
+    }();
+    return field;
+}
+
+const TriangleMesh& getMesh() {
+    static const TriangleMesh mesh = [] {
+        const RockMesh& rock = getRockMesh();
+        return TriangleMesh::create(rock.vertices, rock.indices).value();
+    }();
+    return mesh;
+}
+
+/// Particles of a cloth draped over the rock: a shell just around its surface
+std::vector<Vec3> makeParticles(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> offset(-0.02f, 0.05f);
+    std::vector<Vec3> particles;
+    for (size_t i = 0; i < count; ++i) {
+        const float theta = std::acos(1.0f - 2.0f * unit(rng));
+        const float phi = 2.0f * Pi * unit(rng);
+        const float radius = getRockRadius(theta, phi) + offset(rng);
+        particles.emplace_back(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta),
+                               radius * std::sin(theta) * std::sin(phi));
+    }
+    return particles;
+}
+
+}  // namespace
+
+// ============================================================================
+// Build
+// ============================================================================
+
+static void BM_SignedDistanceField_Build(benchmark::State& state) {
+    const RockMesh& rock = getRockMesh();
+    for (auto _ : state) {
+        auto field = SignedDistanceField::create(rock.vertices, rock.indices, FieldConfig);
+        benchmark::DoNotOptimize(field);
+    }
+    const DistanceFieldStats stats = getField().getStats();
+    state.counters["bricks"] = static_cast<double>(stats.brickCount);
+    state.counters["brick_slots"] = static_cast<double>(stats.brickSlotCount);
+    state.counters["memory_kb"] = static_cast<double>(stats.memoryBytes) / 1024.0;
+    state.counters["mesh_memory_kb"] =
+        static_cast<double>(getMesh().getStats().memoryBytes) / 1024.0;
+}
+BENCHMARK(BM_SignedDistanceField_Build)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Particles
+// ============================================================================
+
+static void BM_SignedDistanceField_Particles(benchmark::State& state) {
+    // Field lookups against closest-point queries through the mesh BVH
+    const bool mesh = state.range(0) != 0;
+    const SignedDistanceField& field = getField();
+    const TriangleMesh& reference = getMesh();
+    const std::vector<Vec3> particles = makeParticles(16384, 1);
+    std::vector<DistanceFieldContact> contacts(particles.size());
+    const Transform transform;
+    uint64_t touching = 0;
+    for (auto _ : state) {
+        if (mesh) {
+            for (const Vec3& particle : particles) {
+                MeshClosestPoint closest;
+                const bool found =
+                    reference.closestPoint(particle, ParticleRadius + ContactDistance, closest);
+                benchmark::DoNotOptimize(closest);
+                touching += found ? 1 : 0;
+            }
+        } else {
+            touching += field.collideParticles(transform, particles, ParticleRadius,
+                                               ContactDistance, contacts);
+            benchmark::DoNotOptimize(contacts.data());
+        }
+    }
+    const int64_t queries = state.iterations() * static_cast<int64_t>(particles.size());
+    state.SetItemsProcessed(queries);
+    state.counters["touching"] = static_cast<double>(touching) / static_cast<double>(queries);
+}
+BENCHMARK(BM_SignedDistanceField_Particles)
+    ->ArgName("mesh")
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+#include "axiom/core/cache_line.hpp"
+#include "axiom/core/mpmc_queue.hpp"
+#include "axiom/core/seqlock.hpp"
+#include "axiom/core/spin_mutex.hpp"
+#include "axiom/core/spsc_queue.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+using namespace axiom::core;
+
+// ============================================================================
+// Benchmark: SpscQueue - Producer/consumer throughput
+// ============================================================================
+
+static void BM_SpscQueue_Throughput(benchmark::State& state) {
+    static SpscQueue<uint64_t> queue(1024);
+
+    // Thread 0 produces, thread 1 consumes; both run the same number of iterations
+    uint64_t value = 0;
+    if (state.thread_index() == 0) {
+        for (auto _ : state) {
+            while (!queue.tryPush(value)) {
+                cpuRelax();
+            }
+            ++value;
+        }
+    } else {
+        for (auto _ : state) {
+            while (!queue.tryPop(value)) {
+                cpuRelax();
+            }
+            benchmark::DoNotOptimize(value);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_Throughput)->Threads(2)->UseRealTime();
+
+static void BM_SpscQueue_PushPopSingleThread(benchmark::State& state) {
+    SpscQueue<uint64_t> queue(1024);
+    uint64_t value = 0;
+
+    for (auto _ : state) {
+        queue.tryPush(value);
+        queue.tryPop(value);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_PushPopSingleThread);
+
+// ============================================================================
+// Benchmark: MpmcQueue vs mutex-protected ring
+// ============================================================================
+
+static void BM_MpmcQueue_PushPop(benchmark::State& state) {
+    static MpmcQueue<uint64_t> queue(4096);
+    uint64_t value = static_cast<uint64_t>(state.thread_index());
+
+    for (auto _ : state) {
+        while (!queue.tryPush(value)) {
+            cpuRelax();
+        }
+        while (!queue.tryPop(value)) {
+            cpuRelax();
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MpmcQueue_PushPop)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_MutexQueue_PushPop(benchmark::State& state) {
+    static std::mutex mutex;
+    static uint64_t ring[4096];
+    static uint64_t head = 0;
+    static uint64_t tail = 0;
+    uint64_t value = static_cast<uint64_t>(state.thread_index());
+
+    for (auto _ : state) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ring[tail++ & 4095] = value;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            value = ring[head++ & 4095];
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexQueue_PushPop)->ThreadRange(1, 8)->UseRealTime();
+
+// ============================================================================
+// Benchmark: SeqLock read
+// ============================================================================
+
+namespace {
+
+struct BodySnapshot {
+    float position[3];
+    float orientation[4];
+    uint32_t frame;
+};
+
+}  // namespace
+
+static void BM_SeqLock_Load(benchmark::State& state) {
+    static SeqLock<BodySnapshot> lock;
+
+    // Thread 0 keeps publishing while the others read
+    if (state.thread_index() == 0 && state.threads() > 1) {
+        BodySnapshot snapshot{};
+        for (auto _ : state) {
+            ++snapshot.frame;
+            lock.store(snapshot);
+        }
+    } else {
+        for (auto _ : state) {
+            BodySnapshot snapshot = lock.load();
+            benchmark::DoNotOptimize(snapshot);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SeqLock_Load)->ThreadRange(1, 4)->UseRealTime();
+
+// ============================================================================
+// Benchmark: SpinMutex vs std::mutex - Short critical sections
+// ============================================================================
+
+template <typename Mutex>
+static void BM_Mutex_ShortCriticalSection(benchmark::State& state) {
+    static Mutex mutex;
+    static uint64_t shared = 0;
+
+    for (auto _ : state) {
+        std::lock_guard<Mutex> lock(mutex);
+        ++shared;
+        benchmark::DoNotOptimize(shared);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Mutex_ShortCriticalSection, SpinMutex)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mutex_ShortCriticalSection, std::mutex)->ThreadRange(1, 8)->UseRealTime();
+
+// ============================================================================
+// Benchmark: Shared atomic vs ShardedCounter - False sharing
+// ============================================================================
+
+static void BM_SharedAtomic_Increment(benchmark::State& state) {
+    static std::atomic<uint64_t> counter{0};
+
+    for (auto _ : state) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedAtomic_Increment)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ShardedCounter_Increment(benchmark::State& state) {
+    static ShardedCounter counter;
+
+    for (auto _ : state) {
+        counter.add();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedCounter_Increment)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
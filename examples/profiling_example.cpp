@@ -17,6 +17,9 @@
  *   1. Launch Tracy server application
  *   2. Run this example
  *   3. Tracy will automatically connect and display profiling data
+ *
+ * On Linux, building with -DAXIOM_ENABLE_HW_COUNTERS=ON additionally prints
+ * IPC and cache/branch misses per zone at exit.
  */
 
 #include <axiom/core/profiler.hpp>
@@ -155,6 +158,7 @@ public:
         // Integration
         {
             AXIOM_PROFILE_SCOPE("Integration");
+            AXIOM_PROFILE_ELEMENTS(objects_.size());
             for (auto& obj : objects_) {
                 obj.integrate(dt);
             }
@@ -227,5 +231,10 @@ int main() {
     std::this_thread::sleep_for(std::chrono::seconds(1));
 #endif
 
+#ifdef AXIOM_ENABLE_HW_COUNTERS
+    std::cout << "\nHardware counters per zone:\n";
+    axiom::core::HwCounterRegistry::getInstance().writeText(std::cout);
+#endif
+
     return 0;
 }
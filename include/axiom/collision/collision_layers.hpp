@@ -0,0 +1,565 @@
+#pragma once
+
+#include "axiom/collision/dynamic_aabb_tree.hpp"
+#include "axiom/collision/proxy.hpp"
+#include "axiom/collision/sweep_and_prune.hpp"
+#include "axiom/collision/uniform_grid.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}
+
+namespace axiom::collision {
+
+/// Broad class of collision objects; each layer has its own broadphase structure
+enum class CollisionLayer : uint32_t {
+    Static = 0,      ///< Level geometry and other bodies that never move
+    Dynamic = 1,     ///< Simulated rigid bodies
+    Debris = 2,      ///< Numerous small bodies that only collide with the world
+    Trigger = 3,     ///< Sensor volumes (overlaps are reported, never resolved)
+    Projectile = 4,  ///< Small fast bodies (bullets, grenades)
+};
+
+/// Number of collision layers
+constexpr size_t CollisionLayerCount = 5;
+
+/// Bit of a layer in a layer mask
+constexpr uint32_t layerBit(CollisionLayer layer) noexcept {
+    return 1u << static_cast<uint32_t>(layer);
+}
+
+/// Mask selecting every layer
+constexpr uint32_t AllLayers = (1u << CollisionLayerCount) - 1;
+
+/// Per-object collision filter, with the semantics of gui::FilterInfo
+///
+/// Two objects in the same non-zero group always collide (positive group) or
+/// never collide (negative group). Otherwise each object's category must be
+/// in the other's mask.
+struct CollisionFilter {
+    uint32_t categoryBits = 0x0001;  ///< Collision category bits
+    uint32_t maskBits = 0xFFFF;      ///< Collision mask bits (what this object collides with)
+    int16_t groupIndex = 0;          ///< Collision group index (negative = never collide)
+};
+
+/// Test whether two filters allow a collision
+constexpr bool shouldCollide(const CollisionFilter& a, const CollisionFilter& b) noexcept {
+    if (a.groupIndex == b.groupIndex && a.groupIndex != 0) {
+        return a.groupIndex > 0;
+    }
+    return (a.categoryBits & b.maskBits) != 0 && (b.categoryBits & a.maskBits) != 0;
+}
+
+/// Symmetric table of the layer pairs whose objects are tested against each other
+class LayerPairMatrix {
+public:
+    /// Create a matrix with every pair disabled
+    constexpr LayerPairMatrix() noexcept = default;
+
+    /// The engine defaults
+    ///
+    /// Static geometry is tested against everything but itself and triggers;
+    /// debris only against static and dynamic bodies; triggers against
+    /// dynamic bodies and projectiles; projectiles not against each other.
+    static constexpr LayerPairMatrix defaults() noexcept {
+        using enum CollisionLayer;
+        LayerPairMatrix matrix;
+        matrix.enable(Static, Dynamic);
+        matrix.enable(Static, Debris);
+        matrix.enable(Static, Projectile);
+        matrix.enable(Dynamic, Dynamic);
+        matrix.enable(Dynamic, Debris);
+        matrix.enable(Dynamic, Trigger);
+        matrix.enable(Dynamic, Projectile);
+        matrix.enable(Trigger, Projectile);
+        return matrix;
+    }
+
+    /// Enable or disable the tests between two layers
+    ///
+    /// Static-vs-static cannot be enabled: nothing there ever moves.
+    constexpr void enable(CollisionLayer a, CollisionLayer b, bool enabled = true) noexcept {
+        if (a == CollisionLayer::Static && b == CollisionLayer::Static) {
+            return;
+        }
+        if (enabled) {
+            rows_[index(a)] |= layerBit(b);
+            rows_[index(b)] |= layerBit(a);
+        } else {
+            rows_[index(a)] &= ~layerBit(b);
+            rows_[index(b)] &= ~layerBit(a);
+        }
+    }
+
+    /// Check whether two layers are tested against each other
+    constexpr bool isEnabled(CollisionLayer a, CollisionLayer b) const noexcept {
+        return (rows_[index(a)] & layerBit(b)) != 0;
+    }
+
+    /// Get the mask of the layers a layer is tested against
+    constexpr uint32_t getMask(CollisionLayer layer) const noexcept { return rows_[index(layer)]; }
+
+private:
+    static constexpr size_t index(CollisionLayer layer) noexcept {
+        return static_cast<size_t>(layer);
+    }
+
+    std::array<uint32_t, CollisionLayerCount> rows_{};
+};
+
+/// Broadphase structure used by a layer
+enum class BroadphaseKind : uint32_t {
+    DynamicAABBTree = 0,  ///< Best for static, resting and sparse objects
+    SweepAndPrune = 1,    ///< Best for dense piles with coherent motion
+    UniformGrid = 2,      ///< Best for many small objects of similar size
+};
+
+/// Configuration of a LayeredBroadphase
+struct LayeredBroadphaseConfig {
+    /// Job system handed to the sweep-and-prune and grid structures, and running
+    /// the background rebuilds of the tree layers (nullptr = single-threaded)
+    core::JobSystem* jobSystem = nullptr;
+
+    /// Structure of each layer, indexed by CollisionLayer
+    std::array<BroadphaseKind, CollisionLayerCount> structures = {
+        BroadphaseKind::DynamicAABBTree,  // Static
+        BroadphaseKind::SweepAndPrune,    // Dynamic
+        BroadphaseKind::UniformGrid,      // Debris
+        BroadphaseKind::DynamicAABBTree,  // Trigger
+        BroadphaseKind::DynamicAABBTree,  // Projectile
+    };
+
+    /// Layer pairs tested against each other
+    LayerPairMatrix layerPairs = LayerPairMatrix::defaults();
+
+    /// Proxies moved to their place in Morton order per updatePairs() while a
+    /// reorder runs (0 = never reorder)
+    uint32_t reorderShardSize = 4096;
+
+    /// Start a reorder once this fraction of the pairs are distant in storage
+    /// (and twice the fraction left by the last reorder)
+    float reorderThreshold = 0.25f;
+};
+
+/// Kind of a TriggerEvent
+enum class TriggerEventType : uint8_t {
+    Enter = 0,  ///< The proxies started overlapping
+    Exit = 1,   ///< The proxies stopped overlapping, or one of them was destroyed
+};
+
+/// Change in the overlap of a Trigger-layer proxy and another proxy
+///
+/// When two triggers overlap, trigger is the lower id.
+struct TriggerEvent {
+    ProxyId trigger = InvalidProxyId;  ///< Proxy of the Trigger layer
+    ProxyId other = InvalidProxyId;    ///< Proxy it overlaps
+    TriggerEventType type = TriggerEventType::Enter;
+};
+
+/// Statistics of the last LayeredBroadphase::updatePairs()
+struct LayeredBroadphaseStats {
+    uint32_t candidatePairs = 0;    ///< Pairs found by the structures
+    uint32_t pairCount = 0;         ///< Pairs left after filtering
+    uint32_t skippedQueries = 0;    ///< Cross-layer queries no filter in the target layer accepts
+    uint32_t treeRebuilds = 0;      ///< Tree layers whose background rebuild was installed
+    uint32_t distantPairs = 0;      ///< Pairs whose proxies are far apart in storage
+    uint32_t reorderedProxies = 0;  ///< Proxies moved into Morton order
+    uint32_t triggerQueries = 0;    ///< Queries of moved proxies for trigger overlaps
+    uint32_t triggerOverlaps = 0;   ///< Trigger overlaps after the update
+};
+
+/// Broadphase split into collision layers, each with its own structure
+///
+/// Objects of different kinds want different broadphases - a tree for huge
+/// static geometry, sweep-and-prune for piles of rigid bodies, a grid for
+/// debris - and most kinds never collide with some others. Putting
+/// everything into one structure and filtering the pairs afterwards spends
+/// most of the broadphase on pairs that are thrown away: every body resting
+/// on a large level produces static pairs, and the level itself produces
+/// static-vs-static pairs.
+///
+/// Here every layer owns a structure chosen in the config, and a
+/// LayerPairMatrix decides which layers are ever tested. A layer paired with
+/// itself reports its own pairs; for two different layers, every object of
+/// the smaller one queries the structure of the other (the static layer is
+/// always the one queried). Before querying, an object's filter is tested
+/// against the union of the categories and masks of the target layer, so a
+/// body that ignores a layer never visits its structure.
+///
+/// Candidate pairs are collected in batches. Each batch is filtered in a
+/// branch-free loop over structure-of-arrays copies of the filters and tight
+/// bounds - category/mask/group and exact AABB overlap - before any pair is
+/// emitted. Reported ids are global to the LayeredBroadphase, so the pairs
+/// feed an OverlappingPairCache directly.
+///
+/// Those arrays are dense and indexed by storage slot; a ProxyId goes
+/// through an indirection table to its slot, so ids stay stable while slots
+/// move. Proxies are created at the end and destroyed by moving the last
+/// one into the hole, so over time neighbours in space end up far apart in
+/// storage. Every pair whose slots are more than ReorderWindow apart counts as
+/// distant; once too many are, the slots are sorted by the Morton code of the
+/// proxy centers (radix sort) and the permutation is applied a shard of
+/// reorderShardSize proxies per updatePairs(), after which the layers'
+/// member lists follow slot order. Nearby proxies then share cache lines, and
+/// the queries of a layer walk the others' structures in spatial order.
+///
+/// The Trigger layer holds sensor volumes. Their overlaps never go through
+/// updatePairs(), so they get no pair cache entry, contact manifold or solver
+/// constraint; the broadphase keeps them itself, as a sorted list, from one
+/// update to the next. Only the proxies created, moved or refiltered since
+/// the last update are queried against the layers paired with Trigger, the
+/// overlaps between proxies that did not move carry over untouched, and the
+/// difference with the last update is written to one flat buffer of enter
+/// and exit events (getTriggerEvents()).
+///
+/// Like SweepAndPrune and UniformGrid, updatePairs() reports every
+/// overlapping pair, in the same order for the same input.
+///
+/// Example usage:
+/// @code
+/// LayeredBroadphase broadphase({.jobSystem = &jobs});
+/// ProxyId ground = broadphase.createProxy(CollisionLayer::Static, level.aabb, {}, levelIndex);
+/// ProxyId crate = broadphase.createProxy(CollisionLayer::Dynamic, body.aabb, body.filter, i);
+///
+/// // Every step
+/// broadphase.moveProxy(crate, body.aabb, body.velocity * dt);
+/// pairCache.beginUpdate();
+/// broadphase.updatePairs([&](ProxyId a, ProxyId b) { pairCache.addPair(a, b); });
+/// pairCache.endUpdate();
+///
+/// for (const TriggerEvent& event : broadphase.getTriggerEvents()) {
+///     gameplay.onTrigger(event.trigger, event.other, event.type);
+/// }
+/// @endcode
+class LayeredBroadphase {
+public:
+    /// Create an empty broadphase
+    /// @param config Configuration
+    explicit LayeredBroadphase(const LayeredBroadphaseConfig& config = {});
+
+    /// Destructor
+    ~LayeredBroadphase() = default;
+
+    // Non-copyable (proxy ids are tied to one broadphase)
+    LayeredBroadphase(const LayeredBroadphase&) = delete;
+    LayeredBroadphase& operator=(const LayeredBroadphase&) = delete;
+
+    // Movable
+    LayeredBroadphase(LayeredBroadphase&&) noexcept = default;
+    LayeredBroadphase& operator=(LayeredBroadphase&&) noexcept = default;
+
+    // === Proxies ===
+
+    /// Add a proxy to a layer
+    /// @param layer Layer of the object
+    /// @param aabb Tight bounds of the object
+    /// @param filter Collision filter
+    /// @param userData Value returned by getUserData (typically a body index)
+    /// @return Proxy id, unique across layers
+    ProxyId createProxy(CollisionLayer layer, const math::AABB& aabb,
+                        const CollisionFilter& filter, uint64_t userData);
+
+    /// Remove a proxy
+    ///
+    /// A proxy with trigger overlaps keeps its id reserved until the next
+    /// updatePairs(), which reports its exits.
+    /// @param id Proxy created by this broadphase
+    void destroyProxy(ProxyId id);
+
+    /// Set the bounds of a proxy
+    /// @param id Proxy to move
+    /// @param aabb New tight bounds
+    /// @param displacement Displacement over the last step (used by tree layers)
+    void moveProxy(ProxyId id, const math::AABB& aabb, const math::Vec3& displacement);
+
+    /// Change the filter of a proxy (takes effect at the next updatePairs())
+    /// @param id Proxy id
+    /// @param filter New collision filter
+    void setFilter(ProxyId id, const CollisionFilter& filter);
+
+    /// Get the layer of a proxy
+    CollisionLayer getLayer(ProxyId id) const noexcept { return proxies_[id].layer; }
+
+    /// Get the storage slot of a proxy (moves when proxies are destroyed or reordered)
+    uint32_t getSlot(ProxyId id) const noexcept { return proxies_[id].slot; }
+
+    /// Get the filter of a proxy
+    CollisionFilter getFilter(ProxyId id) const noexcept;
+
+    /// Get the tight bounds of a proxy
+    math::AABB getAABB(ProxyId id) const noexcept;
+
+    /// Get the user data of a proxy
+    uint64_t getUserData(ProxyId id) const noexcept { return proxies_[id].userData; }
+
+    /// Get the number of proxies in all layers
+    uint32_t getProxyCount() const noexcept { return proxyCount_; }
+
+    /// Get the number of proxies in a layer
+    uint32_t getProxyCount(CollisionLayer layer) const noexcept {
+        return static_cast<uint32_t>(layers_[static_cast<size_t>(layer)].members.size());
+    }
+
+    /// Get the layer pair matrix
+    const LayerPairMatrix& getLayerPairs() const noexcept { return config_.layerPairs; }
+
+    // === Update and queries ===
+
+    /// Update every layer, then report every overlapping pair the layer pairs and filters allow
+    /// @param callback Called as void(ProxyId a, ProxyId b) with a < b
+    /// @return Number of pairs reported
+    template <typename Callback>
+    size_t updatePairs(Callback&& callback);
+
+    /// Report every proxy of the selected layers whose tight bounds overlap an AABB
+    ///
+    /// Uses the structures as of the last updatePairs().
+    /// @param aabb Query bounds
+    /// @param layerMask Layers to search (bits from layerBit())
+    /// @param callback Called as bool(ProxyId); return false to stop the query
+    template <typename Callback>
+    void query(const math::AABB& aabb, uint32_t layerMask, Callback&& callback) const;
+
+    /// Visit the proxies of the selected layers that a ray-like bounds test accepts
+    ///
+    /// Tree layers are walked nearest subtree first and culled against the
+    /// current maximum distance (see DynamicAABBTree::queryOrdered);
+    /// sweep-and-prune and grid layers have no hierarchy to order, so their
+    /// proxies overlapping the query bounds are tested in structure order.
+    /// Uses the structures as of the last updatePairs().
+    /// @param bounds Bounds of everything the query can reach (e.g. of the ray segments)
+    /// @param maxDistance Initial maximum distance
+    /// @param layerMask Layers to search (bits from layerBit())
+    /// @param boundsTest Called as float(const AABB&); returns the entry
+    ///                   distance, or infinity for a miss
+    /// @param callback Called as float(ProxyId) for proxies whose tight bounds
+    ///                 pass; returns the new maximum distance, or a negative
+    ///                 value to stop the query
+    template <typename BoundsTest, typename Callback>
+    void queryOrdered(const math::AABB& bounds, float maxDistance, uint32_t layerMask,
+                      BoundsTest&& boundsTest, Callback&& callback) const;
+
+    /// Get the statistics of the last updatePairs()
+    const LayeredBroadphaseStats& getStats() const noexcept { return stats_; }
+
+    /// Get the trigger events of the last updatePairs()
+    ///
+    /// The exits of destroyed proxies come first, then the other events;
+    /// each group is sorted by (trigger, other).
+    std::span<const TriggerEvent> getTriggerEvents() const noexcept { return triggerEvents_; }
+
+    /// Get the number of trigger overlaps a proxy is part of, as of the last updatePairs()
+    uint32_t getTriggerOverlapCount(ProxyId id) const noexcept {
+        return proxies_[id].triggerOverlaps;
+    }
+
+    /// Check whether a Morton reorder is being applied
+    bool isReordering() const noexcept { return !reorderOrder_.empty(); }
+
+    /// Slots further apart than this make a distant pair
+    static constexpr uint32_t ReorderWindow = 256;
+
+private:
+    static constexpr uint32_t NullProxy = UINT32_MAX;
+
+    /// Candidate pairs filtered at once
+    static constexpr size_t BatchSize = 256;
+
+    using Structure = std::variant<DynamicAABBTree, SweepAndPrune, UniformGrid>;
+
+    /// Indirection from a stable ProxyId to the proxy's storage slot
+    struct Proxy {
+        uint64_t userData = 0;
+        uint32_t slot = NullProxy;
+        uint32_t nextFree = NullProxy;
+        uint32_t triggerOverlaps = 0;
+        CollisionLayer layer = CollisionLayer::Static;
+        bool alive = false;
+    };
+
+    struct Layer {
+        Structure structure;
+        std::vector<uint32_t> members;  ///< Slots of the layer's proxies
+        uint32_t categoryUnion = 0;     ///< OR of the members' categories
+        uint32_t maskUnion = 0;         ///< OR of the members' masks
+        bool hasGroups = false;         ///< Some member has a positive group
+        bool unionsDirty = false;       ///< A filter was removed or changed
+    };
+
+    static Structure makeStructure(BroadphaseKind kind, const LayeredBroadphaseConfig& config);
+    void refreshUnions(Layer& layer) noexcept;
+
+    void findPairs();
+    void findLayerPairs(Layer& layer);
+    void findCrossPairs(CollisionLayer driverLayer, CollisionLayer targetLayer);
+
+    /// Add a candidate pair of slots, filtering the batch once it is full
+    void addCandidate(uint32_t a, uint32_t b);
+
+    /// Filter the candidate batch and append the survivors to pairs_
+    void flushCandidates();
+
+    /// Check whether no member of a layer can accept the proxy of a slot
+    bool rejectsAll(const Layer& target, uint32_t slot) const noexcept;
+
+    /// Query the moved proxies of the layers paired with Trigger and the moved
+    /// triggers, collecting their overlaps in triggerFound_
+    void findTriggerPairs();
+
+    /// Collect the overlaps of the proxy of a slot with the members of a layer
+    void queryTriggerPairs(uint32_t slot, const Layer& target);
+
+    /// Carry over the overlaps of proxies that did not move and write the events
+    void updateTriggerOverlaps();
+
+    /// Get the tight bounds stored in a slot
+    math::AABB getSlotAABB(uint32_t slot) const noexcept;
+
+    /// Get the filter stored in a slot
+    CollisionFilter getSlotFilter(uint32_t slot) const noexcept;
+
+    /// Exchange the proxies of two slots, updating every reference to them
+    void swapSlots(uint32_t a, uint32_t b) noexcept;
+
+    /// Update the id table, member list and structure of the proxy moved into a slot
+    void relinkSlot(uint32_t slot) noexcept;
+
+    /// Sort the slots by the Morton code of the proxy centers
+    void beginReorder();
+
+    /// Move the next shard of proxies to their Morton slots
+    void updateReorder();
+
+    /// Put the member lists back in slot order once every proxy is placed
+    void finishReorder();
+
+    LayeredBroadphaseConfig config_;
+    std::array<Layer, CollisionLayerCount> layers_;
+    std::vector<Proxy> proxies_;
+    uint32_t freeList_ = NullProxy;
+    uint32_t proxyCount_ = 0;
+
+    // Indexed by slot: ids, structure ids, member list positions, changes
+    // since the last update, then the filters and tight bounds of the batch
+    // filter
+    std::vector<ProxyId> ids_;
+    std::vector<ProxyId> locals_;
+    std::vector<uint32_t> members_;
+    std::vector<uint8_t> moved_;
+    std::vector<uint32_t> categoryBits_;
+    std::vector<uint32_t> maskBits_;
+    std::vector<int32_t> groupIndex_;
+    std::array<std::vector<float>, 3> min_;
+    std::array<std::vector<float>, 3> max_;
+
+    std::array<uint32_t, BatchSize> batchA_{};
+    std::array<uint32_t, BatchSize> batchB_{};
+    std::array<uint8_t, BatchSize> batchKeep_{};
+    size_t batchCount_ = 0;
+
+    std::vector<std::pair<ProxyId, ProxyId>> pairs_;
+    LayeredBroadphaseStats stats_;
+
+    std::vector<ProxyId> reorderOrder_;  ///< Ids in Morton order while reordering
+    std::vector<uint64_t> reorderKeys_;  ///< Radix sort keys (Morton code, slot)
+    std::vector<uint64_t> reorderTemp_;  ///< Radix sort scratch
+    size_t reorderCursor_ = 0;           ///< Next entry of reorderOrder_ to place
+    uint32_t reorderSlot_ = 0;           ///< Slot it goes to
+    float reorderedFraction_ = 0.0f;     ///< Distant fraction after the last reorder
+    bool measureReorder_ = false;        ///< Record it at the next updatePairs()
+
+    std::vector<uint64_t> triggerOverlaps_;      ///< Sorted (trigger << 32 | other) keys
+    std::vector<uint64_t> triggerFound_;         ///< Overlaps of this update
+    std::vector<TriggerEvent> triggerEvents_;    ///< Events of the last update
+    std::vector<ProxyId> deadTriggerIds_;        ///< Destroyed with overlaps, not yet freed
+};
+
+//=============================================================================
+// Template implementations
+//=============================================================================
+
+template <typename Callback>
+size_t LayeredBroadphase::updatePairs(Callback&& callback) {
+    findPairs();
+    for (const auto& [a, b] : pairs_) {
+        callback(a, b);
+    }
+    return pairs_.size();
+}
+
+template <typename Callback>
+void LayeredBroadphase::query(const math::AABB& aabb, uint32_t layerMask,
+                              Callback&& callback) const {
+    for (size_t index = 0; index < CollisionLayerCount; ++index) {
+        if ((layerMask & (1u << index)) == 0) {
+            continue;
+        }
+
+        bool keepGoing = true;
+        std::visit(
+            [&](const auto& structure) {
+                structure.query(aabb, [&](ProxyId local) {
+                    // Trees hold fat bounds; report tight overlaps only
+                    const auto slot = static_cast<uint32_t>(structure.getUserData(local));
+                    if (getSlotAABB(slot).intersects(aabb) && !callback(ids_[slot])) {
+                        keepGoing = false;
+                    }
+                    return keepGoing;
+                });
+            },
+            layers_[index].structure);
+        if (!keepGoing) {
+            return;
+        }
+    }
+}
+
+template <typename BoundsTest, typename Callback>
+void LayeredBroadphase::queryOrdered(const math::AABB& bounds, float maxDistance,
+                                     uint32_t layerMask, BoundsTest&& boundsTest,
+                                     Callback&& callback) const {
+    for (size_t index = 0; index < CollisionLayerCount; ++index) {
+        if ((layerMask & (1u << index)) == 0) {
+            continue;
+        }
+
+        const Layer& layer = layers_[index];
+        if (const auto* tree = std::get_if<DynamicAABBTree>(&layer.structure)) {
+            tree->queryOrdered(maxDistance, boundsTest, [&](ProxyId local) {
+                // The tree holds fat bounds; retest the tight ones
+                const auto slot = static_cast<uint32_t>(tree->getUserData(local));
+                if (boundsTest(getSlotAABB(slot)) <= maxDistance) {
+                    maxDistance = callback(ids_[slot]);
+                }
+                return maxDistance;
+            });
+        } else {
+            std::visit(
+                [&](const auto& structure) {
+                    structure.query(bounds, [&](ProxyId local) {
+                        const auto slot = static_cast<uint32_t>(structure.getUserData(local));
+                        if (boundsTest(getSlotAABB(slot)) <= maxDistance) {
+                            maxDistance = callback(ids_[slot]);
+                        }
+                        return maxDistance >= 0.0f;
+                    });
+                },
+                layer.structure);
+        }
+        if (maxDistance < 0.0f) {
+            return;
+        }
+    }
+}
+
+}  // namespace axiom::collision
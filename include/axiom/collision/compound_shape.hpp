@@ -0,0 +1,176 @@
+#pragma once
+
+#include "axiom/collision/shape.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/result.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/transform.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::collision {
+
+/// Child of a CompoundShape
+struct CompoundChild {
+    ConvexShape shape;          ///< Sphere, box, capsule or convex hull
+    math::Transform transform;  ///< Placement in the compound (scale is ignored)
+};
+
+/// World bounds of a compound, kept between frames by its owner
+struct CompoundBoundsCache {
+    math::Transform transform;  ///< Placement the bounds were computed for
+    math::AABB bounds;          ///< Union of the children's world bounds
+    bool valid = false;         ///< Whether bounds have been computed
+};
+
+/// Statistics of a built CompoundShape
+struct CompoundShapeStats {
+    uint32_t childCount = 0;  ///< Children
+    uint32_t nodeCount = 0;   ///< BVH nodes
+    uint32_t depth = 0;       ///< Levels of the BVH (1 for a single leaf)
+};
+
+/// Rigid group of convex shapes, one body with one broadphase proxy
+///
+/// Vehicles and props built from dozens of primitives would otherwise need
+/// a proxy per piece, multiplying the broadphase pairs. Here the children
+/// keep their local bounds, computed once, in an immutable bounding volume
+/// hierarchy: the contact kernel brings the other shape's bounds into the
+/// compound's space and descends only into the children they overlap, each
+/// running that child's own kernel.
+///
+/// ConvexShape::computeAABB() of a compound merges the world bounds of
+/// every child; updateBounds() caches that result and redoes it only when
+/// the body has moved.
+///
+/// Example usage:
+/// @code
+/// const std::array<CompoundChild, 2> parts = {
+///     CompoundChild{ConvexShape::box(Vec3(2.0f, 0.5f, 1.0f)), Transform()},
+///     CompoundChild{ConvexShape::box(Vec3(1.0f, 0.4f, 0.9f)), Transform(Vec3(0, 0.9f, 0))}};
+/// auto car = CompoundShape::create(parts);
+/// const ConvexShape shape = ConvexShape::compoundShape(car.value());
+/// @endcode
+class CompoundShape {
+public:
+    /// Children per BVH leaf, at most
+    static constexpr uint32_t MaxLeafChildren = 2;
+
+    /// Build a compound
+    /// @param children Children; copied (a hull's points are not, and must outlive the compound)
+    /// @return The compound, or InvalidShape if there are no children or a child is a plane,
+    ///         mesh, height field, distance field or compound
+    static core::Result<CompoundShape> create(std::span<const CompoundChild> children);
+
+    /// Create an empty compound
+    CompoundShape() = default;
+
+    // === Queries ===
+
+    /// Visit the children whose bounds overlap a box
+    /// @param bounds Box in compound space
+    /// @param callback Called as bool(uint32_t child) for each overlapping
+    ///                 child; return false to stop
+    template <typename Callback>
+    void queryAABB(const math::AABB& bounds, Callback&& callback) const {
+        query([&](const math::AABB& box) { return box.intersects(bounds); }, callback);
+    }
+
+    /// Visit the children whose bounds pass a test, descending only into
+    /// nodes whose bounds pass it (e.g. a ray packet's slab test)
+    /// @param test Called as bool(const math::AABB& localBounds)
+    /// @param callback Called as bool(uint32_t child); return false to stop
+    template <typename Test, typename Callback>
+    void query(Test&& test, Callback&& callback) const;
+
+    /// Get the world placement of a child
+    /// @param index Child index
+    /// @param transform Placement of the compound (scale is ignored)
+    math::Transform placeChild(uint32_t index, const math::Transform& transform) const noexcept;
+
+    /// Get the world bounds, recomputing them only if the compound has moved
+    /// @param transform Placement of the compound
+    /// @param cache Bounds of the previous call for this body
+    /// @return The union of the children's world bounds
+    const math::AABB& updateBounds(const math::Transform& transform,
+                                   CompoundBoundsCache& cache) const noexcept;
+
+    // === Properties ===
+
+    /// Get the number of children
+    uint32_t getChildCount() const noexcept { return static_cast<uint32_t>(children_.size()); }
+
+    /// Get a child, in input order
+    const CompoundChild& getChild(uint32_t index) const noexcept { return children_[index]; }
+
+    /// Get the bounds of a child in compound space
+    const math::AABB& getChildBounds(uint32_t index) const noexcept {
+        return childBounds_[index];
+    }
+
+    /// Get the bounds of all children in compound space
+    const math::AABB& getBounds() const noexcept { return bounds_; }
+
+    /// Get the radius about the compound origin containing every child
+    float getBoundingRadius() const noexcept { return boundingRadius_; }
+
+    /// Get the statistics of the BVH
+    CompoundShapeStats getStats() const noexcept;
+
+private:
+    /// BVH node: an inner node's children are the next node and the node at
+    /// `first`; a leaf lists `count` entries of leafChildren_ from `first`
+    struct Node {
+        math::AABB bounds;
+        uint32_t first = 0;  ///< Leaf: first entry of leafChildren_; inner: second child node
+        uint32_t count = 0;  ///< Leaf: number of children; 0 for inner nodes
+    };
+
+    /// Deepest traversal stack: one pending sibling per level of a median-split tree
+    static constexpr uint32_t StackSize = 64;
+
+    /// Build the subtree over leafChildren_[begin, end)
+    uint32_t build(uint32_t begin, uint32_t end, uint32_t depth);
+
+    std::vector<CompoundChild> children_;
+    std::vector<math::AABB> childBounds_;  ///< Local bounds of each child
+    std::vector<Node> nodes_;              ///< Depth first, root first
+    std::vector<uint32_t> leafChildren_;   ///< Child indices in leaf order
+    math::AABB bounds_;
+    float boundingRadius_ = 0.0f;
+    uint32_t depth_ = 0;
+};
+
+template <typename Test, typename Callback>
+void CompoundShape::query(Test&& test, Callback&& callback) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    std::array<uint32_t, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const uint32_t index = stack[--stackSize];
+        const Node& node = nodes_[index];
+        if (!test(node.bounds)) {
+            continue;
+        }
+        if (node.count == 0) {
+            AXIOM_ASSERT(stackSize + 2 <= StackSize, "Compound traversal stack overflow");
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = index + 1;
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const uint32_t child = leafChildren_[i];
+            if (test(childBounds_[child]) && !callback(child)) {
+                return;
+            }
+        }
+    }
+}
+
+}  // namespace axiom::collision
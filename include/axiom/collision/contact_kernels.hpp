@@ -0,0 +1,199 @@
+#pragma once
+
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/transform.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::collision {
+
+/// Two placed shapes to generate contacts for
+struct ContactPair {
+    const ConvexShape* shapeA = nullptr;
+    const math::Transform* transformA = nullptr;
+    const ConvexShape* shapeB = nullptr;
+    const math::Transform* transformB = nullptr;
+    SimplexCache* cache = nullptr;  ///< Optional; used by the generic GJK path
+};
+
+/// Contact generator for one pair of shape types
+///
+/// Fills the manifold with the points closer than maxDistance; leaves it
+/// empty when the shapes are further apart.
+using ContactKernel = void (*)(const ContactPair& pair, float maxDistance,
+                               ContactManifold& manifold);
+
+// ----------------------------------------------------------------------------
+// Kernels. Each expects the shape types in its name, in that order.
+// ----------------------------------------------------------------------------
+
+void collideSphereSphere(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideSphereBox(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideSphereCapsule(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideSpherePlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideBoxBox(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideBoxPlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideCapsuleCapsule(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collideCapsulePlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+void collidePlaneConvex(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+
+/// Static triangle mesh against any bounded convex shape: GJK/EPA against
+/// each triangle overlapping the convex's bounds, one point per triangle.
+/// Points on triangles facing away from the deepest contact are dropped so
+/// the manifold keeps one normal.
+void collideMeshConvex(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+
+/// Height field against any bounded convex shape, as collideMeshConvex();
+/// the triangles are generated from the heights under the convex's bounds
+void collideHeightFieldConvex(const ContactPair& pair, float maxDistance,
+                              ContactManifold& manifold);
+
+/// Signed distance field against any bounded convex shape: the field is
+/// sampled at the convex's core points (box corners and center, capsule ends
+/// and center, hull vertices, sphere center), one point each. Faces and edges
+/// resting on sharp features between those points are not detected.
+void collideDistanceFieldConvex(const ContactPair& pair, float maxDistance,
+                                ContactManifold& manifold);
+
+/// Compound against any shape: the kernel of each child whose bounds
+/// overlap the other shape's runs, and their points are merged under one
+/// normal as in collideMeshConvex()
+void collideCompound(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+
+/// Generic path for any two bounded convex shapes: GJK/EPA, one point
+void collideConvexGeneric(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+
+/// No contacts (plane-plane and any pair of planes, meshes, height fields and
+/// distance fields)
+void collideNothing(const ContactPair& pair, float maxDistance, ContactManifold& manifold);
+
+/// Run a kernel with A and B swapped and flip its result back
+template <ContactKernel Kernel>
+void collideFlipped(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const ContactPair swapped{pair.shapeB, pair.transformB, pair.shapeA, pair.transformA,
+                              pair.cache};
+    Kernel(swapped, maxDistance, manifold);
+    manifold.flip();
+}
+
+/// Kernels indexed by [typeA][typeB]
+using ContactKernelTable = std::array<std::array<ContactKernel, ShapeTypeCount>, ShapeTypeCount>;
+
+namespace detail {
+
+constexpr ContactKernelTable makeContactKernelTable() {
+    constexpr auto index = [](ShapeType type) { return static_cast<size_t>(type); };
+
+    ContactKernelTable table{};
+    for (auto& row : table) {
+        row.fill(&collideNothing);
+    }
+
+    // Bounded convex shapes default to GJK/EPA
+    constexpr std::array<ShapeType, 4> Bounded = {ShapeType::Sphere, ShapeType::Box,
+                                                  ShapeType::Capsule, ShapeType::Convex};
+    for (const ShapeType a : Bounded) {
+        for (const ShapeType b : Bounded) {
+            table[index(a)][index(b)] = &collideConvexGeneric;
+        }
+    }
+
+    // Analytic kernels, stored once per ordering
+    const auto set = [&](ShapeType a, ShapeType b, ContactKernel kernel, ContactKernel flipped) {
+        table[index(a)][index(b)] = kernel;
+        table[index(b)][index(a)] = flipped;
+    };
+    table[index(ShapeType::Sphere)][index(ShapeType::Sphere)] = &collideSphereSphere;
+    table[index(ShapeType::Box)][index(ShapeType::Box)] = &collideBoxBox;
+    table[index(ShapeType::Capsule)][index(ShapeType::Capsule)] = &collideCapsuleCapsule;
+    set(ShapeType::Sphere, ShapeType::Box, &collideSphereBox, &collideFlipped<collideSphereBox>);
+    set(ShapeType::Sphere, ShapeType::Capsule, &collideSphereCapsule,
+        &collideFlipped<collideSphereCapsule>);
+    set(ShapeType::Sphere, ShapeType::Plane, &collideSpherePlane,
+        &collideFlipped<collideSpherePlane>);
+    set(ShapeType::Box, ShapeType::Plane, &collideBoxPlane, &collideFlipped<collideBoxPlane>);
+    set(ShapeType::Capsule, ShapeType::Plane, &collideCapsulePlane,
+        &collideFlipped<collideCapsulePlane>);
+    set(ShapeType::Plane, ShapeType::Convex, &collidePlaneConvex,
+        &collideFlipped<collidePlaneConvex>);
+    for (const ShapeType b : Bounded) {
+        set(ShapeType::Mesh, b, &collideMeshConvex, &collideFlipped<collideMeshConvex>);
+        set(ShapeType::HeightField, b, &collideHeightFieldConvex,
+            &collideFlipped<collideHeightFieldConvex>);
+        set(ShapeType::DistanceField, b, &collideDistanceFieldConvex,
+            &collideFlipped<collideDistanceFieldConvex>);
+    }
+    for (size_t b = 0; b < ShapeTypeCount; ++b) {
+        set(ShapeType::Compound, static_cast<ShapeType>(b), &collideCompound,
+            &collideFlipped<collideCompound>);
+    }
+    table[index(ShapeType::Compound)][index(ShapeType::Compound)] = &collideCompound;
+    return table;
+}
+
+}  // namespace detail
+
+/// Compile-time dispatch table of the contact kernels
+inline constexpr ContactKernelTable ContactKernels = detail::makeContactKernelTable();
+
+/// Get the kernel for a pair of shape types
+constexpr ContactKernel getContactKernel(ShapeType a, ShapeType b) noexcept {
+    return ContactKernels[static_cast<size_t>(a)][static_cast<size_t>(b)];
+}
+
+/// Generate the contacts of one pair through the dispatch table
+/// @param pair Shapes and placements
+/// @param maxDistance Points further apart than this are dropped
+/// @param manifold Receives the contacts
+inline void generateContacts(const ContactPair& pair, float maxDistance,
+                             ContactManifold& manifold) {
+    manifold.clear();
+    getContactKernel(pair.shapeA->type, pair.shapeB->type)(pair, maxDistance, manifold);
+}
+
+/// Statistics of the last ContactDispatcher::generate()
+struct ContactDispatcherStats {
+    uint32_t pairCount = 0;      ///< Pairs processed
+    uint32_t touchingCount = 0;  ///< Pairs with at least one point
+    uint32_t pointCount = 0;     ///< Contact points generated
+    uint32_t genericCount = 0;   ///< Pairs that went through GJK/EPA
+};
+
+/// Contact generation for many pairs, grouped by shape-type pair
+///
+/// Pairs are bucketed by (typeA, typeB) with a counting sort so that each
+/// kernel runs over one contiguous batch. The most common primitive pairs
+/// (sphere-sphere, sphere-plane) have branch-free batch kernels working on
+/// structure-of-arrays chunks; the others loop over their scalar kernel.
+///
+/// Example usage:
+/// @code
+/// ContactDispatcher dispatcher;
+/// std::vector<ContactManifold> manifolds(pairs.size());
+/// dispatcher.generate(pairs, 0.02f, manifolds);
+/// @endcode
+class ContactDispatcher {
+public:
+    /// Generate the contacts of every pair
+    /// @param pairs Shapes and placements
+    /// @param maxDistance Points further apart than this are dropped
+    /// @param manifolds Receives one manifold per pair, in the same order
+    void generate(std::span<const ContactPair> pairs, float maxDistance,
+                  std::span<ContactManifold> manifolds);
+
+    /// Get the statistics of the last generate()
+    const ContactDispatcherStats& getStats() const noexcept { return stats_; }
+
+private:
+    std::vector<uint32_t> order_;
+    std::array<uint32_t, ShapeTypeCount * ShapeTypeCount + 1> bucketStart_{};
+    ContactDispatcherStats stats_;
+};
+
+}  // namespace axiom::collision
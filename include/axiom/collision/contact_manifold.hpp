@@ -0,0 +1,150 @@
+#pragma once
+
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/transform.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace axiom::collision {
+
+/// Maximum number of points in a contact manifold
+constexpr uint32_t MaxManifoldPoints = 4;
+
+/// Feature id of points that have no stable feature (e.g. from GJK/EPA);
+/// PersistentManifold matches them by proximity only
+constexpr uint32_t NoFeatureId = UINT32_MAX;
+
+/// One contact point between two shapes, in world space
+struct ContactPoint {
+    math::Vec3 pointA;        ///< Point on the surface of A
+    math::Vec3 pointB;        ///< Point on the surface of B
+    float separation = 0.0f;  ///< Signed distance along the normal; negative when penetrating
+    uint32_t featureId = 0;   ///< Identifies the features that made the point, stable across frames
+};
+
+/// Contact points between two shapes sharing one normal
+struct ContactManifold {
+    math::Vec3 normal;  ///< Unit normal pointing from A to B
+    std::array<ContactPoint, MaxManifoldPoints> points;
+    uint32_t pointCount = 0;
+
+    /// Remove all points
+    void clear() noexcept { pointCount = 0; }
+
+    /// Swap the roles of A and B
+    void flip() noexcept;
+};
+
+/// Choose at most MaxManifoldPoints points that keep the contact area
+///
+/// Keeps the deepest point, then the point furthest from it, then the two
+/// points adding the most area around them. The chosen points are moved to the
+/// front of the span.
+///
+/// @param normal Contact normal
+/// @param points Candidate points; reordered
+/// @return Number of points kept
+uint32_t reduceContactPoints(const math::Vec3& normal, std::span<ContactPoint> points) noexcept;
+
+//=============================================================================
+// Persistent manifolds
+//=============================================================================
+
+/// A contact point kept across frames, with the solver state it accumulates
+struct ManifoldPoint {
+    math::Vec3 localA;                      ///< Point on A, in A's local space
+    math::Vec3 localB;                      ///< Point on B, in B's local space
+    math::Vec3 pointA;                      ///< Point on A in world space, as of the last update
+    math::Vec3 pointB;                      ///< Point on B in world space, as of the last update
+    float separation = 0.0f;                ///< Signed distance along the normal
+    uint32_t featureId = NoFeatureId;       ///< Feature id of the contact that made the point
+    float normalImpulse = 0.0f;             ///< Accumulated normal impulse, for warm starting
+    std::array<float, 2> tangentImpulse{};  ///< Accumulated friction impulses
+    uint32_t lifetime = 0;                  ///< Updates the point has persisted for
+};
+
+/// Thresholds of PersistentManifold
+struct PersistentManifoldSettings {
+    /// New points without a matching feature id replace an old point closer than this
+    float matchDistance = 0.02f;
+    /// Old points separating further than this along the normal are dropped
+    float breakingDistance = 0.02f;
+    /// Old points whose anchors slid apart further than this along the surface are dropped
+    float driftDistance = 0.02f;
+};
+
+/// Contact manifold of one pair, kept from frame to frame
+///
+/// Every update merges the freshly generated contacts into the points of the
+/// previous frame. A new point takes over the accumulated impulses of the old
+/// point with the same feature id or, failing that, of the nearest old point
+/// within matchDistance, so the solver can warm start from them. Old points
+/// that were not regenerated are kept while their body-local anchors, moved
+/// with the bodies, stay within breakingDistance and driftDistance: this is
+/// what builds up a full manifold from the single point of GJK/EPA. When more
+/// than MaxManifoldPoints remain, the same area-maximizing reduction as
+/// reduceContactPoints() chooses the survivors.
+///
+/// Storage is inline and fixed-size, so manifolds can live in the pair cache
+/// without any allocation.
+///
+/// Example usage:
+/// @code
+/// ContactManifold contacts;
+/// generateContacts(pair, maxDistance, contacts);
+/// cache.getManifold(id).update(contacts, transformA, transformB);
+/// for (ManifoldPoint& point : cache.getManifold(id).getPoints()) {
+///     warmStart(point.normalImpulse, point.tangentImpulse);
+/// }
+/// @endcode
+class PersistentManifold {
+public:
+    /// Merge the contacts generated this frame
+    /// @param contacts New contacts; an empty manifold clears the persistent one
+    /// @param transformA Current placement of A
+    /// @param transformB Current placement of B
+    /// @param settings Matching and pruning thresholds
+    void update(const ContactManifold& contacts, const math::Transform& transformA,
+                const math::Transform& transformB, const PersistentManifoldSettings& settings = {});
+
+    /// Move the points with the bodies and drop the stale ones, without new contacts
+    /// @param transformA Current placement of A
+    /// @param transformB Current placement of B
+    /// @param settings Pruning thresholds
+    void refresh(const math::Transform& transformA, const math::Transform& transformB,
+                 const PersistentManifoldSettings& settings = {});
+
+    /// Remove all points
+    void clear() noexcept { pointCount_ = 0; }
+
+    /// Get the contact normal, pointing from A to B
+    const math::Vec3& getNormal() const noexcept { return normal_; }
+
+    /// Get the points
+    std::span<const ManifoldPoint> getPoints() const noexcept {
+        return {points_.data(), pointCount_};
+    }
+
+    /// Get the points, for the solver to store its impulses
+    std::span<ManifoldPoint> getPoints() noexcept { return {points_.data(), pointCount_}; }
+
+    /// Get the number of points
+    uint32_t getPointCount() const noexcept { return pointCount_; }
+
+    /// Get the number of new points of the last update that matched an old point
+    uint32_t getMatchedCount() const noexcept { return matchedCount_; }
+
+private:
+    void refresh(const ShapeFrame& frameA, const ShapeFrame& frameB,
+                 const PersistentManifoldSettings& settings) noexcept;
+
+    std::array<ManifoldPoint, MaxManifoldPoints> points_;
+    math::Vec3 normal_;
+    uint32_t pointCount_ = 0;
+    uint32_t matchedCount_ = 0;
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/transform.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace axiom::collision {
+
+/// Continuous collision mode of a body
+///
+/// Each level adds to the previous one, so the cost is only paid by the
+/// bodies that opt in.
+enum class CcdMode : uint8_t {
+    None,         ///< Discrete: bounds and contacts at the start of the step only
+    Speculative,  ///< Swept bounds, and contacts it may reach during the step
+    Bullet        ///< Speculative, plus a time of impact that stops it at the first hit
+};
+
+/// Settings of continuous collision detection
+struct CcdSettings {
+    /// Contacts closer than this are always generated, whatever the velocities
+    float contactMargin = 0.02f;
+    /// Speculative contacts are generated at most this far ahead
+    float maxSpeculativeDistance = 4.0f;
+    /// A bullet stops this far from the surface it hits, so the contact
+    /// solver starts from a small positive separation
+    float toiSeparation = 0.005f;
+    /// Conservative advancement stops after this many steps and reports the
+    /// impact at the time reached, which is still before the contact
+    uint32_t maxToiIterations = 32;
+};
+
+/// Motion of a body over one step
+///
+/// The velocities are the ones the body moves with during the step (after
+/// forces, before the position update). The body rotates about the origin
+/// of its shape, which is taken as its center of mass.
+struct BodyMotion {
+    const ConvexShape* shape = nullptr;  ///< Shape of the body
+    math::Transform transform;           ///< Placement at the start of the step
+    math::Vec3 linearVelocity;           ///< World linear velocity
+    math::Vec3 angularVelocity;          ///< World angular velocity (radians per second)
+    CcdMode mode = CcdMode::None;        ///< Continuous collision mode
+};
+
+/// Result of computeTimeOfImpact()
+struct TimeOfImpact {
+    float fraction = 1.0f;    ///< Fraction of the step before the bodies touch (1 without impact)
+    math::Vec3 normal;        ///< Unit normal at the impact, pointing from A to B
+    math::Vec3 pointA;        ///< Closest point on A at the impact
+    math::Vec3 pointB;        ///< Closest point on B at the impact
+    uint32_t iterations = 0;  ///< Advancement steps taken
+    bool hit = false;         ///< The bodies touch during the step
+};
+
+/// Get the placement of a body after part of its step
+/// @param motion Body motion
+/// @param time Time since the start of the step, in seconds
+math::Transform integrateMotion(const BodyMotion& motion, float time) noexcept;
+
+/// Compute the bounds of everything a body covers during a step
+///
+/// The start bounds swept along the linear motion, grown by the largest
+/// distance rotation can move a point of the shape. Bodies without CCD get
+/// their start bounds. Pass the result to the broadphase so that pairs a
+/// fast body will meet during the step exist before it gets there:
+/// @code
+/// broadphase.moveProxy(proxy, computeSweptAABB(motion, dt), motion.linearVelocity * dt);
+/// @endcode
+/// @param motion Body motion
+/// @param dt Step duration in seconds
+math::AABB computeSweptAABB(const BodyMotion& motion, float dt) noexcept;
+
+/// Generate the contacts of a pair, including those it may reach during the step
+///
+/// Speculative contacts: the pair is queried up to a distance the bodies can
+/// close in one step (at most maxSpeculativeDistance), then points that the
+/// relative velocity at the point does not close within the step are
+/// dropped. What remains has a positive separation the solver only removes
+/// the excess approach from, so fast bodies stop at the surface instead of
+/// passing through it, without sub-stepping. Pairs without CCD on either
+/// body only get contacts within contactMargin.
+///
+/// @param a First body
+/// @param b Second body
+/// @param dt Step duration in seconds
+/// @param manifold Receives the contacts (normal from A to B)
+/// @param cache Optional per-pair simplex cache
+/// @param settings CCD settings
+void generateSpeculativeContacts(const BodyMotion& a, const BodyMotion& b, float dt,
+                                 ContactManifold& manifold, SimplexCache* cache = nullptr,
+                                 const CcdSettings& settings = {});
+
+/// Find when two bodies first touch during a step
+///
+/// Conservative advancement: each step measures the distance at the current
+/// time and advances by that distance divided by a bound on the approach
+/// speed - the relative velocity along the normal plus the angular speed of
+/// each body times its bounding radius - so it never steps past the first
+/// contact. Against a mesh or height field, each triangle under the swept
+/// bounds is advanced against separately; a compound is measured by its
+/// nearest child. Distance fields are not swept: a field has no usable
+/// distance bound beyond its narrow band, so fast bodies rely on speculative
+/// contacts against it. Pairs of two planes, meshes, height fields or
+/// distance fields never impact.
+///
+/// Bodies that start within toiSeparation of each other impact at fraction
+/// 0 if they are approaching, and not at all if they are separating: a
+/// bullet leaving a surface is not held on it.
+///
+/// @param a First body
+/// @param b Second body
+/// @param dt Step duration in seconds
+/// @param settings CCD settings
+TimeOfImpact computeTimeOfImpact(const BodyMotion& a, const BodyMotion& b, float dt,
+                                 const CcdSettings& settings = {}) noexcept;
+
+/// Find the first impact of every bullet during a step
+///
+/// Only pairs with a bullet in them are tested, so bodies that did not opt
+/// in cost nothing here. A physics step then moves each bullet that hit to
+/// its impact pose (integrateMotion(motion, fraction * dt)), resolves the
+/// contact there, and spends the rest of the step from that pose.
+///
+/// @param bodies Motions of all bodies
+/// @param pairs Broadphase pairs, as indices into bodies
+/// @param dt Step duration in seconds
+/// @param impacts Receives the earliest impact of each body (same size as bodies);
+///                bodies that are not bullets or hit nothing get fraction 1
+/// @param settings CCD settings
+/// @return Number of bullets that hit something
+uint32_t computeBulletImpacts(std::span<const BodyMotion> bodies,
+                              std::span<const std::pair<uint32_t, uint32_t>> pairs, float dt,
+                              std::span<TimeOfImpact> impacts, const CcdSettings& settings = {});
+
+}  // namespace axiom::collision
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "axiom/core/result.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::collision {
+
+/// Configuration of ConvexHull::create()
+struct ConvexHullConfig {
+    /// Largest number of hull vertices (at least 4); the hull stops growing there
+    uint32_t maxVertices = 256;
+    /// Points closer than this to a face count as on it, relative to the
+    /// diagonal of the point cloud bounds
+    float relativeTolerance = 1.0e-5f;
+};
+
+/// Plane of a hull face: points p on the face satisfy normal.dot(p) == offset
+struct HullPlane {
+    math::Vec3 normal;    ///< Unit normal, pointing out of the hull
+    float offset = 0.0f;  ///< Distance of the plane from the origin along the normal
+};
+
+/// Convex hull of a point cloud, with the adjacency needed to hill-climb it
+///
+/// Built with quickhull: starting from a tetrahedron of extreme points, the
+/// point furthest outside any face is added, the faces it sees are removed
+/// and the horizon they leave is closed with a fan of new faces, until no
+/// point is left outside. Each face keeps the points above it, so a point is
+/// only tested against the faces near where it was last assigned.
+///
+/// Simplification: the hull always grows by the point furthest outside the
+/// current hull, so stopping at maxVertices keeps the vertices that matter
+/// most to its shape. The result lies inside the hull of all the points.
+///
+/// Faces are triangles, counter-clockwise seen from outside (the index
+/// layout of debug::DebugShape). Besides the face planes and the face
+/// across each edge, the hull stores the vertex-edge graph, which support()
+/// climbs: on a convex polytope the only local maximum of a linear function
+/// over that graph is the global one. Starting from the best of six axis
+/// extremes, a query visits about sqrt(n) vertices instead of all n.
+///
+/// Example usage:
+/// @code
+/// auto hull = ConvexHull::create(meshVertices);
+/// const ConvexShape shape = ConvexShape::convexHull(hull.value());
+/// @endcode
+class ConvexHull {
+public:
+    /// Build the hull of a point cloud
+    /// @param points Points to enclose
+    /// @param config Build settings
+    /// @return The hull, or InvalidShape if the points are fewer than four or
+    ///         all lie within tolerance of one plane
+    static core::Result<ConvexHull> create(std::span<const math::Vec3> points,
+                                           const ConvexHullConfig& config = {});
+
+    /// Create an empty hull
+    ConvexHull() = default;
+
+    // === Queries ===
+
+    /// Get the index of the vertex furthest along a direction
+    /// @param direction Direction (need not be normalized)
+    uint32_t supportIndex(const math::Vec3& direction) const noexcept;
+
+    /// Get the vertex furthest along a direction
+    /// @param direction Direction (need not be normalized)
+    const math::Vec3& support(const math::Vec3& direction) const noexcept {
+        return vertices_[supportIndex(direction)];
+    }
+
+    // === Properties ===
+
+    /// Get the hull vertices
+    std::span<const math::Vec3> getVertices() const noexcept { return vertices_; }
+
+    /// Get the number of vertices
+    uint32_t getVertexCount() const noexcept { return static_cast<uint32_t>(vertices_.size()); }
+
+    /// Get the number of (triangular) faces
+    uint32_t getFaceCount() const noexcept { return static_cast<uint32_t>(planes_.size()); }
+
+    /// Get the vertex indices of the faces, three per face
+    std::span<const uint32_t> getIndices() const noexcept { return indices_; }
+
+    /// Get the plane of each face
+    std::span<const HullPlane> getPlanes() const noexcept { return planes_; }
+
+    /// Get the face across each face edge, three per face; entry 3 * f + i is
+    /// across the edge from vertex i to vertex (i + 1) % 3 of face f
+    std::span<const uint32_t> getFaceNeighbors() const noexcept { return faceNeighbors_; }
+
+    /// Get the vertices sharing an edge with a vertex
+    std::span<const uint32_t> getVertexNeighbors(uint32_t vertex) const noexcept {
+        const uint32_t first = neighborOffsets_[vertex];
+        return {vertexNeighbors_.data() + first, neighborOffsets_[vertex + 1] - first};
+    }
+
+    /// Get the bounds of the hull
+    const math::AABB& getBounds() const noexcept { return bounds_; }
+
+private:
+    std::vector<math::Vec3> vertices_;
+    std::vector<uint32_t> indices_;          ///< Three per face
+    std::vector<HullPlane> planes_;          ///< One per face
+    std::vector<uint32_t> faceNeighbors_;    ///< Three per face
+    std::vector<uint32_t> neighborOffsets_;  ///< Start of each vertex in vertexNeighbors_
+    std::vector<uint32_t> vertexNeighbors_;
+    std::array<uint32_t, 6> seeds_{};        ///< Vertices furthest along -X, +X, -Y, +Y, -Z, +Z
+    math::AABB bounds_;
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,502 @@
+#pragma once
+
+#include "axiom/collision/proxy.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}  // namespace axiom::core
+
+namespace axiom::collision {
+
+/// Configuration of a DynamicAABBTree
+struct DynamicAABBTreeConfig {
+    /// Margin added around the tight bounds on every side (world units)
+    ///
+    /// A larger margin lets bodies jiggle in place without touching the tree,
+    /// at the price of more false-positive pairs.
+    float fatMargin = 0.1f;
+
+    /// Scale applied to the per-frame displacement when predicting motion
+    ///
+    /// The fat bounds are stretched along the displacement so that a body
+    /// moving at constant velocity stays inside its proxy for several frames.
+    float displacementMultiplier = 4.0f;
+
+    /// Number of nodes reserved up front (a tree of N proxies uses 2N - 1 nodes)
+    uint32_t initialCapacity = 1024;
+
+    /// updateRebuild() starts a rebuild once the SAH cost exceeds its value
+    /// after the last rebuild by this factor (0 = never rebuild)
+    float rebuildCostRatio = 1.5f;
+
+    /// Trees with fewer proxies are never rebuilt
+    uint32_t rebuildMinProxies = 256;
+
+    /// Number of updateRebuild() calls a rebuild spans before it is installed
+    uint32_t rebuildSteps = 4;
+};
+
+/// Dynamic bounding volume hierarchy over fat AABB proxies
+///
+/// Every proxy is a leaf holding a "fat" AABB: the tight bounds of the body,
+/// enlarged by a margin and stretched along its predicted displacement. As
+/// long as the tight bounds stay inside the fat bounds, moving a proxy costs a
+/// containment test and leaves the tree untouched, so a scene of mostly
+/// resting (or slowly moving) bodies pays almost nothing per frame.
+///
+/// Proxies whose tight bounds escape are removed and re-inserted. Insertion
+/// descends towards the sibling with the lowest surface area cost (SAH), and
+/// every ancestor of a modified leaf is rebalanced with AVL-style rotations,
+/// which keeps the height logarithmic even for sorted or streaming insertions.
+///
+/// Nodes live in one contiguous pool indexed by 32-bit ids; freed nodes are
+/// recycled through an intrusive free list. Proxy ids are node indices and stay
+/// valid until destroyProxy().
+///
+/// Proxies that were created, re-inserted or touched are recorded in a moved
+/// buffer. updatePairs() queries the tree once per moved proxy and reports each
+/// new overlapping pair once, which is how the broadphase feeds pair creation.
+///
+/// Incremental insertions degrade the tree over time. Its SAH cost (the
+/// internal node area over the root's) is tracked as nodes change; called once
+/// per step, updateRebuild() notices when the cost has grown by
+/// rebuildCostRatio and rebuilds the tree top-down with a binned SAH. The
+/// build runs from a snapshot of the leaves, on a job system worker or in
+/// slices on the calling thread, while the tree keeps serving queries and
+/// absorbing updates; every proxy created, re-inserted or destroyed meanwhile
+/// is recorded. rebuildSteps calls later the built nodes replace the internal
+/// nodes in one pass and the recorded proxies are inserted again. Proxy ids are
+/// node indices, so they stay valid across the rebuild, and the install happens
+/// at a fixed step whatever the thread timing, so results stay deterministic.
+///
+/// The tree is not thread-safe: concurrent const queries are fine, but any
+/// modification requires exclusive access.
+///
+/// Example usage:
+/// @code
+/// DynamicAABBTree tree;
+/// ProxyId id = tree.createProxy(body.aabb, bodyIndex);
+///
+/// // Every step
+/// tree.moveProxy(id, body.aabb, body.velocity * dt);
+/// tree.updatePairs([&](ProxyId a, ProxyId b) {
+///     pairCache.add(tree.getUserData(a), tree.getUserData(b));
+/// });
+///
+/// // Region query
+/// tree.query(region, [&](ProxyId id) {
+///     hits.push_back(tree.getUserData(id));
+///     return true;  // Keep going
+/// });
+/// @endcode
+class DynamicAABBTree {
+public:
+    /// Create an empty tree
+    /// @param config Tree configuration
+    explicit DynamicAABBTree(const DynamicAABBTreeConfig& config = {});
+
+    /// Destructor (waits for a background rebuild)
+    ~DynamicAABBTree();
+
+    // Non-copyable (proxy ids are tied to one tree)
+    DynamicAABBTree(const DynamicAABBTree&) = delete;
+    DynamicAABBTree& operator=(const DynamicAABBTree&) = delete;
+
+    // Movable, also while a rebuild is running
+    DynamicAABBTree(DynamicAABBTree&&) noexcept;
+    DynamicAABBTree& operator=(DynamicAABBTree&&) noexcept;
+
+    // === Proxies ===
+
+    /// Create a proxy and insert it into the tree
+    /// @param aabb Tight bounds of the object
+    /// @param userData Value returned by getUserData (typically a body index)
+    /// @return Proxy id (added to the moved buffer)
+    ProxyId createProxy(const math::AABB& aabb, uint64_t userData);
+
+    /// Remove a proxy from the tree
+    /// @param id Proxy created by this tree
+    void destroyProxy(ProxyId id);
+
+    /// Update the bounds of a proxy
+    ///
+    /// The tree is only modified if the tight bounds left the fat bounds, or if
+    /// the fat bounds have become much larger than needed (a fast body that came
+    /// to rest). A re-inserted proxy is added to the moved buffer.
+    ///
+    /// @param id Proxy to move
+    /// @param aabb New tight bounds
+    /// @param displacement Displacement over the last step, used to stretch the fat bounds
+    /// @return true if the proxy was re-inserted
+    bool moveProxy(ProxyId id, const math::AABB& aabb, const math::Vec3& displacement);
+
+    /// Update the bounds of many proxies at once
+    ///
+    /// Equivalent to calling moveProxy() for every entry, but all escaped
+    /// proxies are removed before any is re-inserted, so insertions see the
+    /// final tree rather than one still holding stale leaves.
+    ///
+    /// @param moves Proxies to move (each id at most once)
+    /// @return Number of proxies re-inserted
+    size_t moveProxies(std::span<const ProxyMove> moves);
+
+    /// Add a proxy to the moved buffer without changing its bounds
+    ///
+    /// Its pairs are reported again by the next updatePairs(), e.g. after its
+    /// collision filter changed.
+    ///
+    /// @param id Proxy to touch
+    void touchProxy(ProxyId id);
+
+    /// Get the fat bounds stored for a proxy
+    /// @param id Proxy id
+    /// @return Fat AABB
+    const math::AABB& getFatAABB(ProxyId id) const noexcept { return nodes_[id].aabb; }
+
+    /// Get the user data of a proxy
+    /// @param id Proxy id
+    /// @return Value passed to createProxy
+    uint64_t getUserData(ProxyId id) const noexcept { return nodes_[id].userData; }
+
+    /// Replace the user data of a proxy
+    /// @param id Proxy id
+    /// @param userData New value returned by getUserData
+    void setUserData(ProxyId id, uint64_t userData) noexcept { nodes_[id].userData = userData; }
+
+    /// Check if a proxy is in the moved buffer
+    /// @param id Proxy id
+    /// @return true if the proxy was created, re-inserted or touched since the last updatePairs()
+    bool wasMoved(ProxyId id) const noexcept { return nodes_[id].moved; }
+
+    /// Get the proxies in the moved buffer
+    /// @return Moved proxy ids (destroyed entries hold InvalidProxyId)
+    std::span<const ProxyId> getMovedProxies() const noexcept { return movedBuffer_; }
+
+    /// Empty the moved buffer without reporting pairs
+    void clearMoved() noexcept;
+
+    // === Queries ===
+
+    /// Report every proxy whose fat bounds overlap an AABB
+    /// @param aabb Query bounds
+    /// @param callback Called as bool(ProxyId); return false to stop the query
+    template <typename Callback>
+    void query(const math::AABB& aabb, Callback&& callback) const;
+
+    /// Visit the proxies a ray-like bounds test accepts, nearest subtree first
+    ///
+    /// Like a ray cast: subtrees whose entry distance is beyond the current
+    /// maximum are skipped, and the callback can shorten the maximum as it
+    /// finds hits, so a closest-hit query stops descending once nothing
+    /// nearer can remain.
+    /// @param maxDistance Initial maximum distance
+    /// @param boundsTest Called as float(const AABB&) on fat bounds; returns the
+    ///                   entry distance, or infinity for a miss
+    /// @param callback Called as float(ProxyId); returns the new maximum
+    ///                 distance, or a negative value to stop the query
+    template <typename BoundsTest, typename Callback>
+    void queryOrdered(float maxDistance, BoundsTest&& boundsTest, Callback&& callback) const;
+
+    /// Report the new overlapping pairs of the moved proxies, then empty the moved buffer
+    ///
+    /// Each moved proxy is queried against the tree with its fat bounds. Pairs
+    /// of two moved proxies are reported once. Pairs are based on fat bounds,
+    /// so they may include pairs that already existed in the previous step;
+    /// the pair cache is expected to ignore duplicates.
+    ///
+    /// @param callback Called as void(ProxyId a, ProxyId b) with a < b
+    /// @return Number of pairs reported
+    template <typename Callback>
+    size_t updatePairs(Callback&& callback);
+
+    /// Visit every proxy (e.g. to draw the world AABBs)
+    /// @param callback Called as void(ProxyId, const math::AABB& fatAABB)
+    template <typename Callback>
+    void forEachProxy(Callback&& callback) const;
+
+    // === Rebuilds ===
+
+    /// Advance the background rebuild; call once per step
+    ///
+    /// Starts a rebuild when the SAH cost calls for one, slices the build on
+    /// this thread when it started without a job system, and installs it on
+    /// the rebuildSteps-th call after it started, waiting for the job if needed.
+    ///
+    /// @param jobSystem Runs a rebuild started by this call (nullptr = build in slices)
+    /// @return true if a rebuilt tree was installed
+    bool updateRebuild(core::JobSystem* jobSystem = nullptr);
+
+    /// Rebuild the whole tree now, on the calling thread
+    ///
+    /// Finishes a rebuild in progress first, then builds from scratch.
+    void rebuild();
+
+    /// Check whether a rebuild is in progress
+    bool isRebuilding() const noexcept;
+
+    /// Get the number of rebuilds installed
+    uint32_t getRebuildCount() const noexcept { return rebuildCount_; }
+
+    // === Statistics ===
+
+    /// Get the number of proxies
+    uint32_t getProxyCount() const noexcept { return proxyCount_; }
+
+    /// Get the number of allocated nodes (leaves and internal nodes)
+    uint32_t getNodeCount() const noexcept { return nodeCount_; }
+
+    /// Get the height of the tree (0 for a single leaf, -1 when empty)
+    int32_t getHeight() const noexcept;
+
+    /// Get the largest height difference between the two children of any node
+    int32_t getMaxBalance() const noexcept;
+
+    /// Get the total surface area of all nodes divided by the root's
+    ///
+    /// A measure of tree quality: the expected number of nodes visited by a
+    /// random query grows with it.
+    ///
+    /// @return Area ratio (0 when empty)
+    float getAreaRatio() const noexcept;
+
+    /// Get the total surface area of the internal nodes divided by the root's
+    ///
+    /// The cost model rebuilds are triggered from, kept up to date
+    /// incrementally as internal nodes change.
+    ///
+    /// @return SAH cost (0 when the root is a leaf or the tree is empty)
+    float getSahCost() const noexcept;
+
+    /// Get the configuration
+    const DynamicAABBTreeConfig& getConfig() const noexcept { return config_; }
+
+    /// Check the structure and bounds of the whole tree (for tests and debugging)
+    /// @return true if parent links, heights, bounds, node counts and the free list are consistent
+    bool validate() const;
+
+private:
+    static constexpr uint32_t NullNode = UINT32_MAX;
+
+    struct Node {
+        math::AABB aabb;        ///< Fat bounds (leaf) or union of the children
+        uint64_t userData = 0;  ///< Leaf payload
+        union {
+            uint32_t parent;  ///< Parent node (allocated nodes)
+            uint32_t next;    ///< Next free node (free nodes)
+        };
+        uint32_t child1 = NullNode;  ///< First child (NullNode for leaves)
+        uint32_t child2 = NullNode;  ///< Second child (NullNode for leaves)
+        int16_t height = -1;         ///< 0 for leaves, -1 for free nodes
+        bool moved = false;          ///< In the moved buffer
+
+        Node() noexcept : parent(NullNode) {}
+
+        bool isLeaf() const noexcept { return child1 == NullNode; }
+    };
+
+    /// Traversal stack that only touches the heap for very deep trees
+    template <typename Entry>
+    class BasicNodeStack {
+    public:
+        void push(const Entry& entry) {
+            if (size_ < InlineCapacity) {
+                inline_[size_] = entry;
+            } else {
+                overflow_.push_back(entry);
+            }
+            ++size_;
+        }
+
+        Entry pop() {
+            --size_;
+            if (size_ < InlineCapacity) {
+                return inline_[size_];
+            }
+            const Entry entry = overflow_.back();
+            overflow_.pop_back();
+            return entry;
+        }
+
+        bool isEmpty() const noexcept { return size_ == 0; }
+
+    private:
+        static constexpr size_t InlineCapacity = 128;
+        std::array<Entry, InlineCapacity> inline_;
+        std::vector<Entry> overflow_;
+        size_t size_ = 0;
+    };
+
+    using NodeStack = BasicNodeStack<uint32_t>;
+
+    /// Snapshot, build state and recorded deltas of a rebuild (on the heap, so
+    /// a background build survives moving the tree)
+    struct Rebuild;
+
+    /// Node waiting in an ordered traversal, with the entry distance of its bounds
+    struct OrderedNode {
+        uint32_t index;
+        float distance;
+    };
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t index) noexcept;
+
+    void insertLeaf(uint32_t leaf);
+    void removeLeaf(uint32_t leaf);
+    uint32_t balance(uint32_t index) noexcept;
+    void refitAncestors(uint32_t index) noexcept;
+    void setInternalAABB(Node& node, const math::AABB& aabb) noexcept;
+
+    void beginRebuild(core::JobSystem* jobSystem);
+    void installRebuild();
+    void recordRebuildDelta(uint32_t index);
+
+    math::AABB computeFatAABB(const math::AABB& aabb,
+                              const math::Vec3& displacement) const noexcept;
+    bool needsReinsert(uint32_t index, const math::AABB& aabb, const math::AABB& fatAABB,
+                       const math::Vec3& displacement) const noexcept;
+    void markMoved(uint32_t index);
+
+    int32_t validateSubtree(uint32_t index, uint32_t parent, uint32_t& leafCount,
+                            uint32_t& nodeCount) const;
+
+    DynamicAABBTreeConfig config_;
+    std::vector<Node> nodes_;
+    uint32_t root_ = NullNode;
+    uint32_t freeList_ = NullNode;
+    uint32_t nodeCount_ = 0;
+    uint32_t proxyCount_ = 0;
+    std::vector<ProxyId> movedBuffer_;
+    std::vector<uint32_t> movedIndex_;      ///< Position in movedBuffer_ of moved leaves, by node
+    std::vector<uint32_t> reinsertBuffer_;  ///< Scratch for moveProxies
+    double internalArea_ = 0.0;             ///< Sum of the internal node areas
+    float rebuiltCost_ = 0.0f;              ///< SAH cost after the last rebuild
+    uint32_t rebuildCount_ = 0;
+    std::unique_ptr<Rebuild> rebuild_;      ///< Allocated by the first rebuild
+};
+
+//=============================================================================
+// Template implementations
+//=============================================================================
+
+template <typename Callback>
+void DynamicAABBTree::query(const math::AABB& aabb, Callback&& callback) const {
+    if (root_ == NullNode) {
+        return;
+    }
+
+    NodeStack stack;
+    stack.push(root_);
+    while (!stack.isEmpty()) {
+        const uint32_t index = stack.pop();
+        const Node& node = nodes_[index];
+        if (!node.aabb.intersects(aabb)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            if (!callback(static_cast<ProxyId>(index))) {
+                return;
+            }
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template <typename BoundsTest, typename Callback>
+void DynamicAABBTree::queryOrdered(float maxDistance, BoundsTest&& boundsTest,
+                                   Callback&& callback) const {
+    if (root_ == NullNode) {
+        return;
+    }
+    const float rootDistance = boundsTest(nodes_[root_].aabb);
+    if (!(rootDistance <= maxDistance)) {
+        return;
+    }
+
+    BasicNodeStack<OrderedNode> stack;
+    stack.push({root_, rootDistance});
+    while (!stack.isEmpty()) {
+        const OrderedNode entry = stack.pop();
+        if (entry.distance > maxDistance) {
+            continue;
+        }
+
+        const Node& node = nodes_[entry.index];
+        if (node.isLeaf()) {
+            maxDistance = callback(static_cast<ProxyId>(entry.index));
+            if (maxDistance < 0.0f) {
+                return;
+            }
+            continue;
+        }
+
+        OrderedNode first{node.child1, boundsTest(nodes_[node.child1].aabb)};
+        OrderedNode second{node.child2, boundsTest(nodes_[node.child2].aabb)};
+        if (first.distance > second.distance) {
+            std::swap(first, second);
+        }
+        // Push the farther child first so the nearer one is visited next
+        if (second.distance <= maxDistance) {
+            stack.push(second);
+        }
+        if (first.distance <= maxDistance) {
+            stack.push(first);
+        }
+    }
+}
+
+template <typename Callback>
+size_t DynamicAABBTree::updatePairs(Callback&& callback) {
+    size_t pairCount = 0;
+    for (const ProxyId queryId : movedBuffer_) {
+        if (queryId == InvalidProxyId) {
+            continue;  // Destroyed after it moved
+        }
+
+        query(nodes_[queryId].aabb, [&](ProxyId other) {
+            if (other == queryId) {
+                return true;
+            }
+            // A pair of two moved proxies is reported by the lower id only
+            if (nodes_[other].moved && other < queryId) {
+                return true;
+            }
+            if (queryId < other) {
+                callback(queryId, other);
+            } else {
+                callback(other, queryId);
+            }
+            ++pairCount;
+            return true;
+        });
+    }
+
+    clearMoved();
+    return pairCount;
+}
+
+template <typename Callback>
+void DynamicAABBTree::forEachProxy(Callback&& callback) const {
+    const auto capacity = static_cast<uint32_t>(nodes_.size());
+    for (uint32_t index = 0; index < capacity; ++index) {
+        const Node& node = nodes_[index];
+        if (node.height == 0) {
+            callback(static_cast<ProxyId>(index), node.aabb);
+        }
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace axiom::collision::detail {
+
+/// 1 / component, kept finite for axis-aligned directions
+///
+/// A zero component would give 0 * infinity = NaN in a slab test.
+inline float safeInverse(float component) noexcept {
+    constexpr float Tiny = 1.0e-20f;
+    return 1.0f / (std::abs(component) < Tiny ? std::copysign(Tiny, component) : component);
+}
+
+/// Spread the low 10 bits of a value to every third bit (one axis of a 30-bit Morton code)
+constexpr uint32_t spreadBits(uint32_t value) noexcept {
+    value &= 0x3FFu;
+    value = (value | (value << 16)) & 0x030000FFu;
+    value = (value | (value << 8)) & 0x0300F00Fu;
+    value = (value | (value << 4)) & 0x030C30C3u;
+    value = (value | (value << 2)) & 0x09249249u;
+    return value;
+}
+
+/// Closest point on triangle abc (Ericson, Real-Time Collision Detection 5.1.5)
+inline math::Vec3 closestPointOnTriangle(const math::Vec3& p, const math::Vec3& a,
+                                         const math::Vec3& b, const math::Vec3& c) noexcept {
+    const math::Vec3 ab = b - a;
+    const math::Vec3 ac = c - a;
+    const math::Vec3 ap = p - a;
+    const float d1 = ab.dot(ap);
+    const float d2 = ac.dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+
+    const math::Vec3 bp = p - b;
+    const float d3 = ab.dot(bp);
+    const float d4 = ac.dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const math::Vec3 cp = p - c;
+    const float d5 = ab.dot(cp);
+    const float d6 = ac.dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+/// Two-sided ray-triangle intersection (Moller-Trumbore)
+///
+/// The distance is taken from the triangle plane once the hit is accepted:
+/// Moller-Trumbore's edge2.dot(q) / determinant loses most of its digits on
+/// sliver triangles.
+/// @return Distance along the ray, or a negative value for a miss
+inline float intersectTriangle(const math::Vec3& origin, const math::Vec3& direction,
+                               const std::array<math::Vec3, 3>& vertices) noexcept {
+    const math::Vec3 edge1 = vertices[1] - vertices[0];
+    const math::Vec3 edge2 = vertices[2] - vertices[0];
+    const math::Vec3 p = direction.cross(edge2);
+    const float determinant = edge1.dot(p);
+    if (std::abs(determinant) < 1.0e-12f) {
+        return -1.0f;
+    }
+    const float inverse = 1.0f / determinant;
+    const math::Vec3 s = origin - vertices[0];
+    const float u = s.dot(p) * inverse;
+    if (u < 0.0f || u > 1.0f) {
+        return -1.0f;
+    }
+    const math::Vec3 q = s.cross(edge1);
+    const float v = direction.dot(q) * inverse;
+    if (v < 0.0f || u + v > 1.0f) {
+        return -1.0f;
+    }
+    const math::Vec3 normal = edge1.cross(edge2);
+    return (vertices[0] - origin).dot(normal) / direction.dot(normal);
+}
+
+}  // namespace axiom::collision::detail
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/transform.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace axiom::collision {
+
+/// Final GJK simplex of a pair, kept between frames to warm-start the next query
+///
+/// The support points are stored in each shape's local space, so they stay
+/// meaningful as the bodies move: for a resting or slowly moving pair GJK
+/// starts next to the answer and converges in one or two iterations. While the
+/// shapes are apart the cache also keeps the separating axis, which rejects the
+/// pair next frame without running GJK at all if it still separates them.
+///
+/// OverlappingPair holds one per broadphase pair; a new pair starts cold.
+struct SimplexCache {
+    std::array<math::Vec3, 4> localA;  ///< Simplex support points on the core of shape A
+    std::array<math::Vec3, 4> localB;  ///< Simplex support points on the core of shape B
+    math::Vec3 separatingAxis;         ///< Last separating axis in A's local frame, or zero
+    uint32_t count = 0;                ///< Number of simplex points (0 when cold)
+
+    /// Forget the cached simplex and axis
+    void reset() noexcept {
+        count = 0;
+        separatingAxis = math::Vec3::zero();
+    }
+};
+
+/// Result of a convex-vs-convex query
+///
+/// Points and normal are in world space. When the shapes are further apart
+/// than the query's maxDistance, `distance` may only be a lower bound and the
+/// points are not meaningful.
+struct ConvexContact {
+    math::Vec3 normal;               ///< Unit normal pointing from A to B
+    math::Vec3 pointA;               ///< Closest (or deepest) point on A
+    math::Vec3 pointB;               ///< Closest (or deepest) point on B
+    float distance = 0.0f;           ///< Signed distance; negative when penetrating
+    uint32_t gjkIterations = 0;      ///< Support evaluations made by GJK
+    uint32_t epaIterations = 0;      ///< Polytope expansions made by EPA (0 unless cores overlap)
+    bool touching = false;           ///< distance <= maxDistance
+    bool separatedByCache = false;   ///< Rejected by the cached separating axis alone
+};
+
+/// Result of castConvex()
+struct ConvexCast {
+    math::Vec3 point;         ///< Contact point on B when the shapes first touch
+    math::Vec3 normal;        ///< Unit normal of B at the contact, facing the swept shape
+    float distance = 0.0f;    ///< Distance travelled before touching (0 when starting inside)
+    uint32_t iterations = 0;  ///< Advancement steps taken
+    bool hit = false;         ///< The shapes touch within the sweep
+};
+
+/// Compute the distance or penetration between two convex shapes
+///
+/// GJK finds the distance between the shape cores; the radii are then applied
+/// analytically, so only contacts deeper than the radii run EPA.
+///
+/// @param a First shape
+/// @param transformA Placement of the first shape (scale is ignored)
+/// @param b Second shape
+/// @param transformB Placement of the second shape (scale is ignored)
+/// @param maxDistance Shapes further apart than this are reported as not touching
+/// @param cache Optional per-pair cache, read for warm-starting and updated
+ConvexContact collideConvex(const ConvexShape& a, const math::Transform& transformA,
+                            const ConvexShape& b, const math::Transform& transformB,
+                            float maxDistance = 0.0f, SimplexCache* cache = nullptr) noexcept;
+
+/// Test whether two convex shapes overlap (GJK only, no EPA)
+/// @param a First shape
+/// @param transformA Placement of the first shape (scale is ignored)
+/// @param b Second shape
+/// @param transformB Placement of the second shape (scale is ignored)
+/// @param cache Optional per-pair cache, read for warm-starting and updated
+bool overlapConvex(const ConvexShape& a, const math::Transform& transformA, const ConvexShape& b,
+                   const math::Transform& transformB, SimplexCache* cache = nullptr) noexcept;
+
+/// Sweep a convex shape along a straight line against another convex shape
+///
+/// Conservative advancement: each step measures the distance with GJK and
+/// moves A by that distance divided by its approach speed along the normal,
+/// which can never step past the first contact. GJK is warm-started from the
+/// previous step, so each step costs one or two support evaluations once the
+/// shapes are close. A shape that starts overlapping B reports a hit at
+/// distance 0 with the penetration normal. A zero-radius sphere casts a ray.
+///
+/// @param a Swept shape
+/// @param transformA Start placement of the swept shape (scale is ignored)
+/// @param direction Unit sweep direction
+/// @param maxDistance Length of the sweep
+/// @param b Target shape
+/// @param transformB Placement of the target (scale is ignored)
+/// @param tolerance The shapes touch once they are closer than this
+ConvexCast castConvex(const ConvexShape& a, const math::Transform& transformA,
+                      const math::Vec3& direction, float maxDistance, const ConvexShape& b,
+                      const math::Transform& transformB, float tolerance = 1.0e-3f) noexcept;
+
+}  // namespace axiom::collision
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/result.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::collision {
+
+/// Closest hit of HeightField::raycast()
+struct HeightFieldRayHit {
+    float distance = 0.0f;  ///< Distance along the ray
+    math::Vec3 point;       ///< Hit point in height field space
+    math::Vec3 normal;      ///< Unit triangle normal, facing the ray origin
+    uint32_t triangle = 0;  ///< Triangle index (2 * cell + half)
+    uint8_t material = 0;   ///< Material of the cell
+};
+
+/// Statistics of a built HeightField
+struct HeightFieldStats {
+    uint32_t cellCount = 0;   ///< Cells (two triangles each)
+    uint32_t levelCount = 0;  ///< Levels of the min/max pyramid
+    size_t memoryBytes = 0;   ///< Heights, materials and pyramid
+};
+
+/// Terrain as a regular grid of 16-bit heights, for large open levels
+///
+/// Samples are cellSize apart along local X and Z, starting at the origin,
+/// with Y up. Heights are quantized to 16 bits over the range of the input
+/// (the step is getHeightStep(), half of which is the largest error), and
+/// each cell has an 8-bit material; HoleMaterial removes the cell. At two
+/// bytes per sample plus one per cell, a terrain takes a tenth of the memory
+/// of the same triangles in a TriangleMesh and nothing is built per triangle:
+/// the two triangles of a cell are generated from its four corner heights
+/// when a query reaches it.
+///
+/// Culling uses a min/max pyramid. Level 0 holds the height range of each
+/// block of BlockSize x BlockSize cells and every level above halves the
+/// blocks along each axis, up to a single root. AABB queries descend it
+/// keeping the blocks whose height range meets the box; rays descend it
+/// nearest block first, and walk the cells of each level 0 block they
+/// reach with a 2D grid DDA, ending at the first cell they hit.
+///
+/// Triangle index t is half t % 2 of cell t / 2, with cell = z * cellsX + x.
+/// Triangle 0 of a cell is (x, z), (x, z + 1), (x + 1, z + 1) and triangle 1
+/// is (x, z), (x + 1, z + 1), (x + 1, z), both counter-clockwise seen from
+/// above. Contact points on a height field carry the triangle index as their
+/// feature id, so getMaterial(featureId) gives the material under a body.
+///
+/// Example usage:
+/// @code
+/// auto terrain = HeightField::create(heights, 4097, 4097, 0.5f, materials);
+/// const ConvexShape ground = ConvexShape::heightField(terrain.value());
+/// HeightFieldRayHit hit;
+/// if (terrain.value().raycast(origin, direction, 500.0f, hit)) {
+///     playFootstep(hit.material);
+/// }
+/// @endcode
+class HeightField {
+public:
+    /// Material of a cell without triangles
+    static constexpr uint8_t HoleMaterial = 0xFF;
+
+    /// Cells per side of a level 0 pyramid block
+    static constexpr uint32_t BlockSize = 8;
+
+    /// Build a height field
+    /// @param heights Row-major samples, sampleCountX per row, sampleCountZ rows
+    /// @param sampleCountX Samples along X (at least 2)
+    /// @param sampleCountZ Samples along Z (at least 2)
+    /// @param cellSize Distance between neighboring samples
+    /// @param materials Optional row-major cell materials ((sampleCountX - 1) per row);
+    ///                  all cells get material 0 without them
+    /// @return The height field, or InvalidShape if the sizes do not match, a
+    ///         height is not finite or the cell size is not positive
+    static core::Result<HeightField> create(std::span<const float> heights, uint32_t sampleCountX,
+                                            uint32_t sampleCountZ, float cellSize,
+                                            std::span<const uint8_t> materials = {});
+
+    /// Create an empty height field
+    HeightField() = default;
+
+    // === Queries ===
+
+    /// Report both triangles of every cell whose bounds overlap an AABB (holes
+    /// are skipped); this includes every triangle whose own bounds overlap it
+    /// @param aabb Query bounds in height field space
+    /// @param callback Called as bool(uint32_t triangle, const std::array<math::Vec3, 3>&);
+    ///                 return false to stop the query
+    template <typename Callback>
+    void queryAABB(const math::AABB& aabb, Callback&& callback) const;
+
+    /// Find the closest triangle hit by a ray (triangles are two-sided)
+    /// @param origin Ray origin in height field space
+    /// @param direction Unit ray direction
+    /// @param maxDistance Length of the ray
+    /// @param hit Receives the closest hit
+    /// @return true if the ray hits the height field
+    bool raycast(const math::Vec3& origin, const math::Vec3& direction, float maxDistance,
+                 HeightFieldRayHit& hit) const noexcept;
+
+    /// Get the vertices of a triangle
+    std::array<math::Vec3, 3> getTriangle(uint32_t triangle) const noexcept;
+
+    /// Get the material of the cell holding a triangle
+    uint8_t getMaterial(uint32_t triangle) const noexcept {
+        return materials_.empty() ? uint8_t{0} : materials_[triangle / 2];
+    }
+
+    /// Get the dequantized height of a sample
+    float getHeight(uint32_t x, uint32_t z) const noexcept {
+        return heightOffset_ + heightStep_ * static_cast<float>(heights_[z * sampleCountX_ + x]);
+    }
+
+    // === Properties ===
+
+    /// Get the bounds of the height field
+    const math::AABB& getBounds() const noexcept { return bounds_; }
+
+    /// Get the number of samples along X
+    uint32_t getSampleCountX() const noexcept { return sampleCountX_; }
+
+    /// Get the number of samples along Z
+    uint32_t getSampleCountZ() const noexcept { return sampleCountZ_; }
+
+    /// Get the distance between neighboring samples
+    float getCellSize() const noexcept { return cellSize_; }
+
+    /// Get the quantization step of the heights
+    float getHeightStep() const noexcept { return heightStep_; }
+
+    /// Get the statistics of the height field
+    HeightFieldStats getStats() const noexcept;
+
+private:
+    /// Quantized height range of a pyramid block
+    struct Range {
+        uint16_t min;
+        uint16_t max;
+    };
+
+    /// One level of the pyramid
+    struct Level {
+        uint32_t blocksX;
+        uint32_t blocksZ;
+        uint32_t first;       ///< Index of the first block in ranges_
+        uint32_t blockCells;  ///< Cells per block side
+    };
+
+    /// Block of the pyramid pending in a query
+    struct PendingBlock {
+        uint32_t level;
+        uint32_t x;
+        uint32_t z;
+        float enter;  ///< Ray queries: distance where the ray enters the block
+        float exit;   ///< Ray queries: distance where it leaves
+    };
+
+    /// Deepest traversal stack: three pending siblings per level, 32 levels
+    static constexpr uint32_t StackSize = 128;
+
+    uint32_t getCellsX() const noexcept { return sampleCountX_ - 1; }
+    uint32_t getCellsZ() const noexcept { return sampleCountZ_ - 1; }
+
+    math::Vec3 getVertex(uint32_t x, uint32_t z) const noexcept {
+        return math::Vec3(static_cast<float>(x) * cellSize_, getHeight(x, z),
+                          static_cast<float>(z) * cellSize_);
+    }
+
+    bool isHole(uint32_t cell) const noexcept {
+        return !materials_.empty() && materials_[cell] == HoleMaterial;
+    }
+
+    /// Quantize a height, rounding down or up
+    uint16_t quantize(float height, bool roundUp) const noexcept;
+
+    const Range& getRange(uint32_t level, uint32_t x, uint32_t z) const noexcept {
+        const Level& info = levels_[level];
+        return ranges_[info.first + z * info.blocksX + x];
+    }
+
+    /// Walk the cells of a level 0 block along a ray, from tEnter to tExit
+    bool raycastBlock(uint32_t blockX, uint32_t blockZ, const math::Vec3& origin,
+                      const math::Vec3& direction, float tEnter, float tExit,
+                      float maxDistance, HeightFieldRayHit& hit) const noexcept;
+
+    math::AABB bounds_;
+    float cellSize_ = 1.0f;
+    float inverseCellSize_ = 1.0f;
+    float heightOffset_ = 0.0f;  ///< Height of quantized value 0
+    float heightStep_ = 0.0f;    ///< Height of one quantization step
+    float inverseHeightStep_ = 0.0f;
+    uint32_t sampleCountX_ = 0;
+    uint32_t sampleCountZ_ = 0;
+    std::vector<uint16_t> heights_;   ///< Row-major samples
+    std::vector<uint8_t> materials_;  ///< Row-major cells; empty when all are 0
+    std::vector<Level> levels_;       ///< Level 0 first
+    std::vector<Range> ranges_;       ///< Blocks of every level
+};
+
+//=============================================================================
+// Inline / template implementations
+//=============================================================================
+
+inline std::array<math::Vec3, 3> HeightField::getTriangle(uint32_t triangle) const noexcept {
+    const uint32_t cell = triangle / 2;
+    const uint32_t x = cell % getCellsX();
+    const uint32_t z = cell / getCellsX();
+    if (triangle % 2 == 0) {
+        return {getVertex(x, z), getVertex(x, z + 1), getVertex(x + 1, z + 1)};
+    }
+    return {getVertex(x, z), getVertex(x + 1, z + 1), getVertex(x + 1, z)};
+}
+
+template <typename Callback>
+void HeightField::queryAABB(const math::AABB& aabb, Callback&& callback) const {
+    if (levels_.empty() || aabb.max.x < 0.0f || aabb.max.z < 0.0f ||
+        aabb.min.x > bounds_.max.x || aabb.min.z > bounds_.max.z ||
+        aabb.min.y > bounds_.max.y || aabb.max.y < bounds_.min.y) {
+        return;
+    }
+
+    // Query in cells and quantized heights
+    const auto toCell = [&](float coordinate, uint32_t cellCount) {
+        const float cell = std::floor(coordinate * inverseCellSize_);
+        return static_cast<uint32_t>(std::clamp(cell, 0.0f, static_cast<float>(cellCount - 1)));
+    };
+    const uint32_t minX = toCell(aabb.min.x, getCellsX());
+    const uint32_t maxX = toCell(aabb.max.x, getCellsX());
+    const uint32_t minZ = toCell(aabb.min.z, getCellsZ());
+    const uint32_t maxZ = toCell(aabb.max.z, getCellsZ());
+    const uint16_t low = quantize(aabb.min.y, false);
+    const uint16_t high = quantize(aabb.max.y, true);
+
+    std::array<PendingBlock, StackSize> stack;
+    uint32_t stackSize = 0;
+    const auto top = static_cast<uint32_t>(levels_.size() - 1);
+    stack[stackSize++] = {top, 0, 0, 0.0f, 0.0f};
+    while (stackSize > 0) {
+        const PendingBlock block = stack[--stackSize];
+        const Range& range = getRange(block.level, block.x, block.z);
+        if (range.max < low || range.min > high) {
+            continue;
+        }
+        const uint32_t size = levels_[block.level].blockCells;
+        if (block.level > 0) {
+            // Children that overlap the query rectangle
+            const uint32_t half = size / 2;
+            const Level& below = levels_[block.level - 1];
+            for (uint32_t child = 0; child < 4; ++child) {
+                const uint32_t childX = 2 * block.x + (child & 1);
+                const uint32_t childZ = 2 * block.z + (child >> 1);
+                if (childX < below.blocksX && childZ < below.blocksZ &&
+                    childX * half <= maxX && (childX + 1) * half > minX &&
+                    childZ * half <= maxZ && (childZ + 1) * half > minZ) {
+                    stack[stackSize++] = {block.level - 1, childX, childZ, 0.0f, 0.0f};
+                }
+            }
+            continue;
+        }
+
+        // Cells of a level 0 block, each culled by its corner heights
+        const uint32_t beginX = std::max(minX, block.x * size);
+        const uint32_t endX = std::min(maxX, block.x * size + size - 1);
+        const uint32_t beginZ = std::max(minZ, block.z * size);
+        const uint32_t endZ = std::min(maxZ, block.z * size + size - 1);
+        for (uint32_t z = beginZ; z <= endZ; ++z) {
+            for (uint32_t x = beginX; x <= endX; ++x) {
+                const uint32_t cell = z * getCellsX() + x;
+                const uint16_t h00 = heights_[z * sampleCountX_ + x];
+                const uint16_t h10 = heights_[z * sampleCountX_ + x + 1];
+                const uint16_t h01 = heights_[(z + 1) * sampleCountX_ + x];
+                const uint16_t h11 = heights_[(z + 1) * sampleCountX_ + x + 1];
+                if (std::max({h00, h10, h01, h11}) < low ||
+                    std::min({h00, h10, h01, h11}) > high || isHole(cell)) {
+                    continue;
+                }
+                if (!callback(2 * cell, getTriangle(2 * cell)) ||
+                    !callback(2 * cell + 1, getTriangle(2 * cell + 1))) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace axiom::collision
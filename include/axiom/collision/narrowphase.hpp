@@ -0,0 +1,165 @@
+#pragma once
+
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/overlapping_pair_cache.hpp"
+#include "axiom/collision/proxy.hpp"
+#include "axiom/collision/scene_query.hpp"
+#include "axiom/core/cache_line.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}  // namespace axiom::core
+
+namespace axiom::memory {
+class FrameAllocator;
+}  // namespace axiom::memory
+
+namespace axiom::collision {
+
+/// Configuration of a Narrowphase
+struct NarrowphaseConfig {
+    /// Points further apart than this are dropped
+    float maxDistance = 0.02f;
+    /// Pairs per batch: the unit of work handed to a worker
+    uint32_t batchSize = 64;
+    /// Capacity of the scratch used when update() runs without a job system,
+    /// or on a thread that is not one of its workers (split between two frames)
+    size_t scratchBytes = 1024 * 1024;
+    /// Matching and pruning of the persistent manifolds
+    PersistentManifoldSettings manifold{};
+};
+
+/// Touching pair reported by Narrowphase::update()
+struct NarrowphaseContact {
+    PairId pair = InvalidPairId;  ///< Pair in the OverlappingPairCache
+    ProxyId a = InvalidProxyId;   ///< First proxy (a < b)
+    ProxyId b = InvalidProxyId;   ///< Second proxy
+    ContactManifold manifold;     ///< Contacts generated this frame, normal from a to b
+};
+
+/// Statistics of the last Narrowphase::update()
+struct NarrowphaseStats {
+    uint32_t pairCount = 0;      ///< Pairs processed
+    uint32_t touchingCount = 0;  ///< Pairs with at least one point
+    uint32_t pointCount = 0;     ///< Contact points generated
+    uint32_t genericCount = 0;   ///< Pairs that went through GJK/EPA
+    uint32_t batchCount = 0;     ///< Batches the pairs were split into
+    uint32_t overflowCount = 0;  ///< Batches that did not fit in scratch memory
+    bool reordered = false;      ///< The key order was sorted from scratch, not patched
+};
+
+/// Contact generation for every pair of an OverlappingPairCache, in parallel
+///
+/// Narrowphase takes most of a contact-heavy step and its pairs are
+/// independent, so the pairs are cut into batches of batchSize and spread
+/// over the workers of a job system. A batch goes through a per-worker
+/// ContactDispatcher, then each pair's simplex cache and persistent manifold
+/// are updated in place: a pair belongs to exactly one batch, so its state
+/// is written by one thread and needs no lock.
+///
+/// Each worker appends the touching pairs of its batches to its own stream,
+/// blocks carved from the worker's FrameAllocator scratch, so workers never
+/// share a cache line or an allocation. The pairs are kept sorted by key
+/// (a << 32 | b) from frame to frame by applying the cache's added and
+/// removed pairs, and batches are cut from that order; the final merge
+/// concatenates the batch blocks in batch order. Contacts therefore come
+/// out sorted by pair key, identical whatever the number of threads and
+/// whichever worker ran which batch.
+///
+/// Call update() after every OverlappingPairCache::endUpdate(); if updates
+/// of the cache were missed, the key order is sorted from scratch. The job
+/// system's scratch must be flipped once per frame as usual
+/// (JobSystem::flipScratchAllocators()); a batch that does not fit in it
+/// falls back to heap memory owned by its stream.
+///
+/// Example usage:
+/// @code
+/// cache.endUpdate();
+/// narrowphase.update(cache, objects, &jobs);
+/// for (const NarrowphaseContact& contact : narrowphase.getContacts()) {
+///     solver.addContact(contact.a, contact.b, cache.getManifold(contact.pair));
+/// }
+/// jobs.flipScratchAllocators();
+/// @endcode
+class Narrowphase {
+public:
+    /// Create a narrowphase
+    /// @param config Configuration
+    explicit Narrowphase(const NarrowphaseConfig& config = {});
+
+    /// Destructor
+    ~Narrowphase();
+
+    Narrowphase(const Narrowphase&) = delete;
+    Narrowphase& operator=(const Narrowphase&) = delete;
+    Narrowphase(Narrowphase&&) = delete;
+    Narrowphase& operator=(Narrowphase&&) = delete;
+
+    /// Generate the contacts of every pair and update their persistent state
+    /// @param cache Pairs, after endUpdate(); their simplex caches and
+    ///              persistent manifolds are updated
+    /// @param objects Shapes and placements, indexed by ProxyId; pairs with a
+    ///                nullptr shape never touch
+    /// @param jobSystem Optional; when set, the batches are split across its workers
+    void update(OverlappingPairCache& cache, std::span<const SceneObject> objects,
+                core::JobSystem* jobSystem = nullptr);
+
+    /// Get the touching pairs of the last update(), sorted by pair key
+    std::span<const NarrowphaseContact> getContacts() const noexcept { return contacts_; }
+
+    /// Get the statistics of the last update()
+    const NarrowphaseStats& getStats() const noexcept { return stats_; }
+
+private:
+    /// Pair in key order
+    struct SortedPair {
+        uint64_t key = 0;
+        PairId id = InvalidPairId;
+    };
+
+    /// Touching pairs of one batch
+    struct BatchOutput {
+        const NarrowphaseContact* contacts = nullptr;  ///< Scratch block, or nullptr if overflowed
+        uint32_t stream = 0;                           ///< Stream that ran the batch
+        uint32_t offset = 0;                           ///< Overflow: first entry in the stream
+        uint32_t count = 0;
+    };
+
+    /// Per-worker state; each on its own cache lines
+    struct alignas(core::CacheLineSize) Stream {
+        ContactDispatcher dispatcher;
+        std::vector<PairId> ids;
+        std::vector<ContactPair> pairs;
+        std::vector<ContactManifold> manifolds;
+        std::vector<NarrowphaseContact> overflow;
+        NarrowphaseStats stats;
+    };
+
+    /// Patch the key order with the cache's deltas, or rebuild it if updates were missed
+    void updateOrder(const OverlappingPairCache& cache);
+
+    /// Run one batch on the calling thread's stream
+    void runBatch(uint32_t batch, OverlappingPairCache& cache,
+                  std::span<const SceneObject> objects, core::JobSystem* jobSystem);
+
+    NarrowphaseConfig config_;
+    std::vector<SortedPair> order_;
+    const OverlappingPairCache* orderCache_ = nullptr;  ///< Cache order_ was built from
+    uint32_t orderUpdate_ = 0;                          ///< Cache update order_ is current for
+    std::vector<SortedPair> merged_;   ///< Scratch for updateOrder()
+    std::vector<uint8_t> removed_;     ///< Scratch for updateOrder(), indexed by PairId
+    std::vector<Stream> streams_;      ///< One per worker, then one for any other thread
+    std::vector<BatchOutput> batches_;
+    std::unique_ptr<memory::FrameAllocator> scratch_;  ///< For the last stream
+    std::vector<NarrowphaseContact> contacts_;
+    NarrowphaseStats stats_;
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/proxy.hpp"
+#include "axiom/core/spin_mutex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::collision {
+
+/// Handle to a pair stored in an OverlappingPairCache
+using PairId = uint32_t;
+
+/// Invalid pair handle
+constexpr PairId InvalidPairId = UINT32_MAX;
+
+/// Two overlapping proxies, with a < b
+struct OverlappingPair {
+    ProxyId a = InvalidProxyId;
+    ProxyId b = InvalidProxyId;
+    uint64_t userData = 0;        ///< Owned by the narrowphase (e.g. index of per-pair state)
+    SimplexCache simplex;         ///< GJK warm-start state; cold for a new pair
+    PersistentManifold manifold;  ///< Contacts kept across frames; empty for a new pair
+};
+
+/// Configuration of an OverlappingPairCache
+struct OverlappingPairCacheConfig {
+    /// Number of pairs the table is sized for up front
+    uint32_t initialCapacity = 1024;
+};
+
+/// Statistics of the last OverlappingPairCache::endUpdate()
+struct OverlappingPairCacheStats {
+    uint32_t pairCount = 0;      ///< Pairs in the cache
+    uint32_t addedCount = 0;     ///< Pairs added by the update
+    uint32_t removedCount = 0;   ///< Pairs removed by the update
+    uint32_t slotCount = 0;      ///< Slots of the hash table
+    uint32_t overflowCount = 0;  ///< Insertions deferred because the table was full
+};
+
+/// Persistent set of overlapping proxy pairs with per-frame deltas
+///
+/// Most pairs persist from one frame to the next, and so does whatever the
+/// narrowphase derived from them - contact manifolds, GJK simplices, friction
+/// anchors. The cache keeps every pair under a stable PairId from the frame
+/// it starts overlapping to the frame it stops, and each update produces only
+/// the pairs that were added and removed, so the narrowphase creates and
+/// destroys its per-pair state incrementally instead of rebuilding it.
+///
+/// Pairs live in an open-addressing hash table with linear probing, keyed by
+/// (a << 32 | b). A slot holds the key, the pair id and the frame the pair
+/// was last reported, 16 bytes, so a lookup is usually a single cache line
+/// and finding a persisting pair only rewrites its frame stamp. Pairs not
+/// reported during an update are removed by one linear pass over the slots,
+/// with backward-shift deletion (no tombstones).
+///
+/// addPair() may be called from several threads between beginUpdate() and
+/// endUpdate(): slots are claimed with a compare-and-swap, and new keys are
+/// collected in a lock-free list. When the table reaches its load limit
+/// during the update, further new pairs go to a mutex-protected overflow list
+/// and are inserted by endUpdate(), after the table has grown. endUpdate()
+/// processes new and removed pairs in key order, so pair ids and deltas do
+/// not depend on thread timing.
+///
+/// SweepAndPrune and UniformGrid report every overlapping pair each update.
+/// DynamicAABBTree only reports the new pairs of moved proxies; keep its
+/// persisting pairs with refreshPairs() before endUpdate().
+///
+/// Example usage:
+/// @code
+/// cache.beginUpdate();
+/// sap.updatePairs([&](ProxyId a, ProxyId b) { cache.addPair(a, b); });
+/// cache.endUpdate();
+///
+/// for (PairId id : cache.getRemovedPairs()) {
+///     constraints.release(cache.getPair(id).userData);
+/// }
+/// for (PairId id : cache.getAddedPairs()) {
+///     cache.setUserData(id, constraints.acquire());
+/// }
+/// @endcode
+class OverlappingPairCache {
+public:
+    /// Create an empty cache
+    /// @param config Configuration
+    explicit OverlappingPairCache(const OverlappingPairCacheConfig& config = {});
+
+    /// Destructor
+    ~OverlappingPairCache() = default;
+
+    // Non-copyable, non-movable (addPair may be running on other threads)
+    OverlappingPairCache(const OverlappingPairCache&) = delete;
+    OverlappingPairCache& operator=(const OverlappingPairCache&) = delete;
+    OverlappingPairCache(OverlappingPairCache&&) = delete;
+    OverlappingPairCache& operator=(OverlappingPairCache&&) = delete;
+
+    // === Update ===
+
+    /// Start collecting the pairs of a frame
+    ///
+    /// Releases the ids of the pairs removed by the previous update and makes
+    /// room in the table for the pairs about to be reported.
+    void beginUpdate();
+
+    /// Report an overlapping pair (thread-safe until endUpdate())
+    /// @param a Proxy id
+    /// @param b Proxy id, different from a (the order does not matter)
+    void addPair(ProxyId a, ProxyId b) noexcept;
+
+    /// Keep pairs that were not reported this frame
+    ///
+    /// Call between beginUpdate() and endUpdate(), from one thread.
+    /// @param keep Called as bool(const OverlappingPair&) for every pair not
+    ///             reported so far; return true to keep the pair
+    template <typename Predicate>
+    void refreshPairs(Predicate&& keep);
+
+    /// Finish the frame: remove the pairs not reported and build the deltas
+    void endUpdate();
+
+    /// Pairs added by the last update, in key order
+    std::span<const PairId> getAddedPairs() const noexcept { return added_; }
+
+    /// Pairs removed by the last update
+    ///
+    /// Their ids and user data stay valid until the next beginUpdate().
+    std::span<const PairId> getRemovedPairs() const noexcept { return removed_; }
+
+    // === Pairs ===
+
+    /// Remove every pair of a proxy
+    ///
+    /// Call outside beginUpdate()/endUpdate() when destroying a proxy, so a
+    /// recycled proxy id does not inherit its pairs. The pairs are listed in
+    /// the removed pairs of the next update.
+    /// @param proxy Proxy id
+    void removePairsContaining(ProxyId proxy);
+
+    /// Find a pair
+    /// @param a Proxy id
+    /// @param b Proxy id (the order does not matter)
+    /// @return Pair id, or InvalidPairId if the proxies do not overlap
+    PairId findPair(ProxyId a, ProxyId b) const noexcept;
+
+    /// Get a pair
+    /// @param id Pair id
+    const OverlappingPair& getPair(PairId id) const noexcept { return pairs_[id]; }
+
+    /// Set the user data of a pair
+    /// @param id Pair id
+    /// @param userData Value returned in getPair(id).userData
+    void setUserData(PairId id, uint64_t userData) noexcept { pairs_[id].userData = userData; }
+
+    /// Get the GJK simplex cache of a pair, for collideConvex()/overlapConvex()
+    /// @param id Pair id
+    SimplexCache& getSimplexCache(PairId id) noexcept { return pairs_[id].simplex; }
+
+    /// Get the persistent contact manifold of a pair
+    /// @param id Pair id
+    PersistentManifold& getManifold(PairId id) noexcept { return pairs_[id].manifold; }
+
+    /// Get the number of points in the manifolds of all pairs
+    uint32_t getContactPointCount() const noexcept;
+
+    /// Get the number of pairs
+    uint32_t getPairCount() const noexcept { return pairCount_; }
+
+    /// Get one past the largest pair id in use (the size of arrays indexed by PairId)
+    uint32_t getPairCapacity() const noexcept { return static_cast<uint32_t>(pairs_.size()); }
+
+    /// Call fn(PairId, const OverlappingPair&) for every pair, in no particular order
+    template <typename Fn>
+    void forEachPair(Fn&& fn) const;
+
+    /// Get the number of updates started so far
+    uint32_t getUpdateCount() const noexcept { return frame_; }
+
+    /// Get the statistics of the last update
+    const OverlappingPairCacheStats& getStats() const noexcept { return stats_; }
+
+private:
+    static constexpr uint64_t EmptyKey = UINT64_MAX;
+
+    struct Slot {
+        uint64_t key = EmptyKey;      ///< a << 32 | b
+        PairId pair = InvalidPairId;  ///< InvalidPairId until endUpdate() for new pairs
+        uint32_t lastSeen = 0;        ///< Frame the pair was last reported
+    };
+
+    static uint64_t makeKey(ProxyId a, ProxyId b) noexcept;
+    uint32_t slotOf(uint64_t key) const noexcept;
+
+    /// Find the slot holding a key
+    /// @return Slot index, or UINT32_MAX if the key is not in the table
+    uint32_t findSlot(uint64_t key) const noexcept;
+
+    /// Insert a key from a single thread (no-op if present)
+    /// @return true if the key was new
+    bool insertSerial(uint64_t key) noexcept;
+
+    void eraseSlot(uint32_t index) noexcept;
+    void rehash(uint32_t slotCount);
+
+    /// Resize the table if pairCount does not fit at the target load or leaves it mostly empty
+    void reserveSlots(size_t pairCount);
+
+    PairId allocatePair(uint64_t key);
+
+    /// Erase the pairs of staleKeys_, appending their ids in key order
+    void removeStaleKeys(std::vector<PairId>& removed);
+
+    OverlappingPairCacheConfig config_;
+    std::vector<Slot> slots_;
+    uint32_t slotMask_ = 0;
+    uint32_t slotBits_ = 0;
+    uint32_t occupiedSlots_ = 0;     ///< Updated atomically while updating_
+    uint32_t maxOccupiedSlots_ = 0;  ///< Load limit for concurrent insertion
+    uint32_t frame_ = 0;
+    bool updating_ = false;
+
+    std::vector<OverlappingPair> pairs_;
+    std::vector<PairId> freePairs_;
+    uint32_t pairCount_ = 0;
+
+    std::vector<uint64_t> newKeys_;  ///< Keys claimed during the update (pre-sized)
+    uint32_t newKeyCount_ = 0;       ///< Updated atomically while updating_
+    std::vector<uint64_t> overflowKeys_;
+    core::SpinMutex overflowMutex_;
+    std::vector<uint64_t> addedKeys_;
+
+    std::vector<PairId> added_;
+    std::vector<PairId> removed_;
+    std::vector<PairId> pendingRemoved_;  ///< From removePairsContaining(), reported next update
+    std::vector<uint64_t> staleKeys_;
+    OverlappingPairCacheStats stats_;
+};
+
+//=============================================================================
+// Template implementations
+//=============================================================================
+
+template <typename Predicate>
+void OverlappingPairCache::refreshPairs(Predicate&& keep) {
+    for (Slot& slot : slots_) {
+        if (slot.key != EmptyKey && slot.lastSeen != frame_ && keep(pairs_[slot.pair])) {
+            slot.lastSeen = frame_;
+        }
+    }
+}
+
+template <typename Fn>
+void OverlappingPairCache::forEachPair(Fn&& fn) const {
+    for (const Slot& slot : slots_) {
+        if (slot.key != EmptyKey) {
+            fn(slot.pair, pairs_[slot.pair]);
+        }
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <cstdint>
+
+namespace axiom::collision {
+
+/// Handle to a proxy stored in a broadphase structure
+using ProxyId = uint32_t;
+
+/// Invalid proxy handle
+constexpr ProxyId InvalidProxyId = UINT32_MAX;
+
+/// Motion of one proxy, for the batch moveProxies() of the broadphase structures
+struct ProxyMove {
+    ProxyId id = InvalidProxyId;  ///< Proxy to move
+    math::AABB aabb;              ///< New tight bounds
+    math::Vec3 displacement;      ///< Displacement over the last step (for prediction)
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace axiom::collision {
+
+/// Up to eight rays traversed together, in structure-of-arrays form
+///
+/// A packet visits each node of a hierarchy once for all of its rays, so
+/// coherent rays (neighbouring probes, the wheels of a vehicle, a fan of
+/// line-of-sight checks) share every node fetch. Box and triangle tests are
+/// plain loops over the eight lanes, which the compiler turns into 8-wide
+/// vector code.
+///
+/// Each lane has its own length, which closest-hit queries shorten to the
+/// nearest hit found so far; lanes outside activeMask are ignored.
+struct RayPacket {
+    /// Number of lanes
+    static constexpr uint32_t Width = 8;
+
+    /// Mask with every lane set
+    static constexpr uint32_t FullMask = (1u << Width) - 1;
+
+    std::array<float, Width> originX{};
+    std::array<float, Width> originY{};
+    std::array<float, Width> originZ{};
+    std::array<float, Width> directionX{};
+    std::array<float, Width> directionY{};
+    std::array<float, Width> directionZ{};
+    std::array<float, Width> inverseX{};  ///< 1 / directionX, finite for axis-aligned rays
+    std::array<float, Width> inverseY{};
+    std::array<float, Width> inverseZ{};
+    std::array<float, Width> length{};  ///< Current length of each ray
+    uint32_t activeMask = 0;            ///< Lanes still being traced
+
+    /// Set a lane and mark it active
+    /// @param lane Lane index
+    /// @param origin Ray origin
+    /// @param direction Unit ray direction
+    /// @param maxDistance Length of the ray
+    void setRay(uint32_t lane, const math::Vec3& origin, const math::Vec3& direction,
+                float maxDistance) noexcept {
+        originX[lane] = origin.x;
+        originY[lane] = origin.y;
+        originZ[lane] = origin.z;
+        directionX[lane] = direction.x;
+        directionY[lane] = direction.y;
+        directionZ[lane] = direction.z;
+        inverseX[lane] = detail::safeInverse(direction.x);
+        inverseY[lane] = detail::safeInverse(direction.y);
+        inverseZ[lane] = detail::safeInverse(direction.z);
+        length[lane] = maxDistance;
+        activeMask |= 1u << lane;
+    }
+
+    /// Get the origin of a lane
+    math::Vec3 getOrigin(uint32_t lane) const noexcept {
+        return math::Vec3(originX[lane], originY[lane], originZ[lane]);
+    }
+
+    /// Get the direction of a lane
+    math::Vec3 getDirection(uint32_t lane) const noexcept {
+        return math::Vec3(directionX[lane], directionY[lane], directionZ[lane]);
+    }
+
+    /// Get the longest active ray (0 when no lane is active)
+    float getMaxLength() const noexcept {
+        float longest = 0.0f;
+        for (uint32_t lane = 0; lane < Width; ++lane) {
+            const bool active = ((activeMask >> lane) & 1u) != 0;
+            longest = std::max(longest, active ? length[lane] : 0.0f);
+        }
+        return longest;
+    }
+
+    /// Slab test of the active rays against a box
+    /// @param box Box to test
+    /// @param entry Receives the smallest entry distance among the rays that reach the box
+    /// @return Mask of the lanes whose rays reach the box within their length
+    uint32_t intersect(const math::AABB& box, float& entry) const noexcept {
+        // Slabs of all lanes first (one vector loop), then the mask
+        std::array<float, Width> entryDistance;
+        std::array<float, Width> exitDistance;
+        for (uint32_t lane = 0; lane < Width; ++lane) {
+            const float x0 = (box.min.x - originX[lane]) * inverseX[lane];
+            const float x1 = (box.max.x - originX[lane]) * inverseX[lane];
+            const float y0 = (box.min.y - originY[lane]) * inverseY[lane];
+            const float y1 = (box.max.y - originY[lane]) * inverseY[lane];
+            const float z0 = (box.min.z - originZ[lane]) * inverseZ[lane];
+            const float z1 = (box.max.z - originZ[lane]) * inverseZ[lane];
+            entryDistance[lane] = std::max(std::max(std::min(x0, x1), std::min(y0, y1)),
+                                           std::max(std::min(z0, z1), 0.0f));
+            exitDistance[lane] = std::min(std::min(std::max(x0, x1), std::max(y0, y1)),
+                                          std::min(std::max(z0, z1), length[lane]));
+        }
+
+        uint32_t mask = 0;
+        float nearest = std::numeric_limits<float>::infinity();
+        for (uint32_t lane = 0; lane < Width; ++lane) {
+            const bool hit = (entryDistance[lane] <= exitDistance[lane]) &
+                             (((activeMask >> lane) & 1u) != 0);
+            mask |= static_cast<uint32_t>(hit) << lane;
+            nearest = hit ? std::min(nearest, entryDistance[lane]) : nearest;
+        }
+        entry = nearest;
+        return mask;
+    }
+
+    /// Get the same rays in the local space of a frame (lengths and active lanes are kept)
+    RayPacket toLocal(const ShapeFrame& frame) const noexcept {
+        RayPacket local;
+        for (uint32_t lane = 0; lane < Width; ++lane) {
+            local.setRay(lane, frame.toLocal(getOrigin(lane)), frame.unrotate(getDirection(lane)),
+                         length[lane]);
+        }
+        local.activeMask = activeMask;
+        return local;
+    }
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "axiom/collision/collision_layers.hpp"
+#include "axiom/collision/proxy.hpp"
+#include "axiom/collision/ray_packet.hpp"
+#include "axiom/collision/shape.hpp"
+#include "axiom/math/transform.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace axiom::core {
+class JobSystem;
+}  // namespace axiom::core
+
+namespace axiom::collision {
+
+/// Ray of a batched scene query
+struct Ray {
+    math::Vec3 origin;         ///< Start point
+    math::Vec3 direction;      ///< Unit direction
+    float maxDistance = 0.0f;  ///< Length of the ray
+};
+
+/// Swept shape of a batched scene query
+struct ShapeCast {
+    const ConvexShape* shape = nullptr;  ///< Swept sphere, box, capsule or hull
+    math::Transform transform;           ///< Start placement (scale is ignored)
+    math::Vec3 direction;                ///< Unit sweep direction
+    float maxDistance = 0.0f;            ///< Length of the sweep
+};
+
+/// Result of one ray or shape cast of a SceneQuery
+struct SceneHit {
+    ProxyId proxy = InvalidProxyId;  ///< Proxy hit, or InvalidProxyId for a miss
+    float distance = 0.0f;           ///< Distance travelled to the hit (0 when starting inside)
+    math::Vec3 point;                ///< World hit point
+    math::Vec3 normal;               ///< Unit world normal of the surface hit, facing the query
+    uint32_t triangle = UINT32_MAX;  ///< Mesh or height field triangle hit, or UINT32_MAX
+
+    /// Whether the query hit anything
+    bool hasHit() const noexcept { return proxy != InvalidProxyId; }
+};
+
+/// What a scene query reports for each ray or cast
+enum class SceneQueryMode : uint8_t {
+    ClosestHit,  ///< The nearest hit
+    AnyHit       ///< Whichever hit is found first (occlusion and line-of-sight tests)
+};
+
+/// Options of a SceneQuery batch
+struct SceneQueryOptions {
+    SceneQueryMode mode = SceneQueryMode::ClosestHit;
+    /// Layers to search (bits from layerBit())
+    uint32_t layerMask = AllLayers;
+    /// Only proxies whose filter category intersects this mask are hit
+    uint32_t categoryMask = UINT32_MAX;
+    /// Optional; when set, the batch is split across the workers
+    core::JobSystem* jobSystem = nullptr;
+};
+
+/// Shape and placement of a broadphase proxy, indexed by the proxy's user data
+struct SceneObject {
+    const ConvexShape* shape = nullptr;  ///< Shape; nullptr objects are never hit
+    math::Transform transform;           ///< Placement (scale is ignored)
+};
+
+/// Batched ray casts and shape casts against a LayeredBroadphase
+///
+/// Line-of-sight checks, audio occlusion and wheel probes issue thousands of
+/// rays per frame. Casting them one at a time through a callback walks the
+/// same tree nodes over and over from a cold cache; here a batch is sorted
+/// so that neighbouring rays (same direction octant, nearby origins along a
+/// Morton curve) travel together, and each group of eight is traced as one
+/// RayPacket: every broadphase node and mesh node is fetched once for the
+/// packet and visited nearest first, and the lanes are tested together.
+///
+/// Closest-hit queries shorten each lane as hits are found, which culls
+/// everything behind them; any-hit queries retire a lane at its first hit
+/// and stop once the packet is empty. Spheres, boxes and planes are hit
+/// analytically, meshes through TriangleMesh's packet traversal, height
+/// fields and distance fields lane by lane through their own raycast(), and
+/// other shapes with castConvex(). Shape casts are traced one at a time with
+/// castConvex() against the candidates along their swept bounds; against a
+/// distance field, the cast's core points are advanced through the field.
+/// Compounds pass rays and casts on to the children their bounds reach.
+///
+/// Results are written to the caller's buffer at the index of their query,
+/// so they do not depend on the sorting or on the number of threads. The
+/// broadphase is read as of its last updatePairs(); a batch must not run
+/// concurrently with changes to it.
+///
+/// Example usage:
+/// @code
+/// SceneQuery scene(broadphase, objects);
+/// scene.raycast(rays, hits, {.mode = SceneQueryMode::AnyHit, .jobSystem = &jobs});
+/// for (size_t i = 0; i < rays.size(); ++i) {
+///     agents[i].canSeeTarget = !hits[i].hasHit();
+/// }
+/// @endcode
+class SceneQuery {
+public:
+    /// Rays traced together
+    static constexpr uint32_t PacketWidth = RayPacket::Width;
+
+    /// Create a query over a broadphase
+    /// @param broadphase Broadphase holding the objects' proxies
+    /// @param objects Shapes and placements, indexed by the proxies' user data;
+    ///                not copied, must outlive the query
+    SceneQuery(const LayeredBroadphase& broadphase, std::span<const SceneObject> objects) noexcept
+        : broadphase_(broadphase), objects_(objects) {}
+
+    /// Cast a batch of rays
+    /// @param rays Rays to cast
+    /// @param hits Receives one result per ray (at least rays.size() entries)
+    /// @param options Mode, filters and optional job system
+    /// @return Number of rays that hit
+    uint32_t raycast(std::span<const Ray> rays, std::span<SceneHit> hits,
+                     const SceneQueryOptions& options = {}) const;
+
+    /// Sweep a batch of convex shapes
+    /// @param casts Shape casts
+    /// @param hits Receives one result per cast (at least casts.size() entries)
+    /// @param options Mode, filters and optional job system
+    /// @return Number of casts that hit
+    uint32_t shapeCast(std::span<const ShapeCast> casts, std::span<SceneHit> hits,
+                       const SceneQueryOptions& options = {}) const;
+
+private:
+    /// Trace up to PacketWidth rays together
+    void tracePacket(std::span<const Ray> rays, std::span<const uint32_t> order,
+                     std::span<SceneHit> hits, const SceneQueryOptions& options) const;
+
+    /// Sweep one shape
+    SceneHit traceCast(const ShapeCast& cast, const SceneQueryOptions& options) const;
+
+    /// Get the object of a proxy, or nullptr if the filters exclude it
+    const SceneObject* getObject(ProxyId id, const SceneQueryOptions& options) const noexcept;
+
+    const LayeredBroadphase& broadphase_;
+    std::span<const SceneObject> objects_;
+};
+
+}  // namespace axiom::collision
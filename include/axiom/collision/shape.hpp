@@ -0,0 +1,220 @@
+#pragma once
+
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/transform.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace axiom::collision {
+
+class CompoundShape;
+class ConvexHull;
+class HeightField;
+class SignedDistanceField;
+class TriangleMesh;
+
+/// Collision shape types
+///
+/// Same values and order as debug::ShapeType, which mirrors this enum for the
+/// debug renderer (the collision module does not depend on debug). The
+/// debug module static_asserts that the two stay in sync.
+enum class ShapeType : uint8_t {
+    Sphere,         ///< Sphere centered at the origin
+    Box,            ///< Box centered at the origin
+    Capsule,        ///< Capsule along local Y
+    Plane,          ///< Infinite plane
+    Convex,         ///< Convex hull of a point cloud
+    Mesh,           ///< Triangle mesh
+    HeightField,    ///< Height field terrain
+    DistanceField,  ///< Signed distance field of a closed mesh
+    Compound        ///< Rigid group of convex shapes
+};
+
+/// Number of ShapeType values
+constexpr uint32_t ShapeTypeCount = 9;
+
+/// Convex shape described by its support function, for GJK/EPA
+///
+/// Every convex shape is a "core" (a point, segment, box or point cloud) swept
+/// by a sphere of `radius`. GJK runs on the cores, which keeps spheres and
+/// capsules exact and lets shallow contacts skip EPA entirely.
+///
+/// A plane is the half-space below the local XZ plane (normal +Y). It is
+/// convex but unbounded, so only the analytic contact kernels handle it.
+/// Likewise static triangle meshes and height fields are only handled by
+/// their contact kernels, which run GJK against the individual triangles,
+/// and distance fields by theirs, which sample the field at points of the
+/// other shape's core. A compound is a group of convex children; its kernel
+/// runs the children's kernels.
+///
+/// The shape does not own convex hull vertices, meshes, height fields,
+/// distance fields or compounds; they must outlive it.
+struct ConvexShape {
+    ShapeType type = ShapeType::Sphere;        ///< Any ShapeType
+    float radius = 0.0f;                       ///< Sphere/capsule radius, or rounding of a box/hull
+    float halfHeight = 0.0f;                   ///< Capsule: half the segment length along local Y
+    math::Vec3 halfExtents;                    ///< Box: half size on each axis
+    const math::Vec3* vertices = nullptr;      ///< Convex: hull points in local space
+    uint32_t vertexCount = 0;                  ///< Convex: number of hull points
+    const ConvexHull* hull = nullptr;          ///< Convex: adjacency to hill-climb, if built
+    const TriangleMesh* mesh = nullptr;        ///< Mesh: the triangle mesh
+    const HeightField* terrain = nullptr;      ///< HeightField: the height field
+    const SignedDistanceField* sdf = nullptr;  ///< DistanceField: the distance field
+    const CompoundShape* compound = nullptr;   ///< Compound: the children
+
+    /// Create a sphere
+    static ConvexShape sphere(float radius) noexcept;
+
+    /// Create a box
+    /// @param halfExtents Half size on each axis
+    /// @param radius Optional rounding of the edges
+    static ConvexShape box(const math::Vec3& halfExtents, float radius = 0.0f) noexcept;
+
+    /// Create a capsule along local Y
+    /// @param radius Radius of the capsule
+    /// @param height Length of the segment between the two cap centers (as in debug::DebugShape)
+    static ConvexShape capsule(float radius, float height) noexcept;
+
+    /// Create a plane: the half-space y <= 0 in local space
+    static ConvexShape plane() noexcept;
+
+    /// Create a convex hull
+    /// @param points Hull points in local space; not copied, must outlive the shape
+    /// @param radius Optional rounding of the hull
+    static ConvexShape convex(std::span<const math::Vec3> points, float radius = 0.0f) noexcept;
+
+    /// Create a convex hull from a built ConvexHull
+    ///
+    /// Support queries on hulls with more than HillClimbThreshold vertices
+    /// hill-climb the hull's vertex graph instead of scanning every vertex.
+    /// @param hull Hull; not copied, must outlive the shape
+    /// @param radius Optional rounding of the hull
+    static ConvexShape convexHull(const ConvexHull& hull, float radius = 0.0f) noexcept;
+
+    /// Hulls with more vertices than this use hill-climbing for support queries
+    static constexpr uint32_t HillClimbThreshold = 32;
+
+    /// Create a static triangle mesh shape
+    /// @param mesh Mesh; not copied, must outlive the shape
+    static ConvexShape triangleMesh(const TriangleMesh& mesh) noexcept;
+
+    /// Create a static height field shape
+    /// @param terrain Height field; not copied, must outlive the shape
+    static ConvexShape heightField(const HeightField& terrain) noexcept;
+
+    /// Create a static signed distance field shape
+    /// @param sdf Distance field; not copied, must outlive the shape
+    static ConvexShape signedDistanceField(const SignedDistanceField& sdf) noexcept;
+
+    /// Create a compound shape
+    /// @param compound Children; not copied, must outlive the shape
+    static ConvexShape compoundShape(const CompoundShape& compound) noexcept;
+
+    /// Get the point of the core furthest along a local direction
+    /// @param direction Direction in local space (need not be normalized)
+    math::Vec3 supportCore(const math::Vec3& direction) const noexcept {
+        switch (type) {
+            case ShapeType::Box:
+                return math::Vec3(direction.x < 0.0f ? -halfExtents.x : halfExtents.x,
+                                  direction.y < 0.0f ? -halfExtents.y : halfExtents.y,
+                                  direction.z < 0.0f ? -halfExtents.z : halfExtents.z);
+            case ShapeType::Capsule:
+                return math::Vec3(0.0f, direction.y < 0.0f ? -halfHeight : halfHeight, 0.0f);
+            case ShapeType::Convex:
+                return supportHull(direction);
+            case ShapeType::Sphere:
+            default:
+                return math::Vec3::zero();
+        }
+    }
+
+    /// Visit points of the core that stand in for it against a distance field:
+    /// the center of a sphere, the ends and middle of a capsule segment, the
+    /// corners and center of a box, and the points of a convex hull
+    /// @param callback Called as void(uint32_t index, const math::Vec3& localPoint)
+    template <typename Callback>
+    void forEachCorePoint(Callback&& callback) const {
+        switch (type) {
+            case ShapeType::Box:
+                for (uint32_t corner = 0; corner < 8; ++corner) {
+                    callback(corner,
+                             math::Vec3((corner & 1) != 0 ? halfExtents.x : -halfExtents.x,
+                                        (corner & 2) != 0 ? halfExtents.y : -halfExtents.y,
+                                        (corner & 4) != 0 ? halfExtents.z : -halfExtents.z));
+                }
+                callback(8u, math::Vec3::zero());
+                break;
+            case ShapeType::Capsule:
+                callback(0u, math::Vec3(0.0f, -halfHeight, 0.0f));
+                callback(1u, math::Vec3(0.0f, halfHeight, 0.0f));
+                callback(2u, math::Vec3::zero());
+                break;
+            case ShapeType::Convex:
+                for (uint32_t i = 0; i < vertexCount; ++i) {
+                    callback(i, vertices[i]);
+                }
+                break;
+            case ShapeType::Sphere:
+            default:
+                callback(0u, math::Vec3::zero());
+                break;
+        }
+    }
+
+    /// Compute the world bounds of the shape (unbounded for a plane)
+    /// @param transform Placement of the shape (scale is ignored)
+    math::AABB computeAABB(const math::Transform& transform) const noexcept;
+
+    /// Compute the radius of a sphere about the shape origin that contains the shape
+    ///
+    /// Bounds how far any point of the shape moves when it rotates (0 for a plane,
+    /// which is never rotated by a body).
+    float computeBoundingRadius() const noexcept;
+
+private:
+    math::Vec3 supportHull(const math::Vec3& direction) const noexcept;
+};
+
+/// Placement of a shape with its rotation expanded to a matrix
+///
+/// Narrowphase code rotates many directions and points per query; expanding
+/// the quaternion once makes each rotation nine multiply-adds.
+struct ShapeFrame {
+    math::Vec3 position;             ///< World position of the shape origin
+    std::array<math::Vec3, 3> axes;  ///< Local X, Y and Z axes in world space
+
+    /// Expand a transform (scale is ignored)
+    explicit ShapeFrame(const math::Transform& transform) noexcept
+        : position(transform.position) {
+        const math::Quat& q = transform.rotation;
+        axes[0] = math::Vec3(1.0f - 2.0f * (q.y * q.y + q.z * q.z), 2.0f * (q.x * q.y + q.w * q.z),
+                             2.0f * (q.x * q.z - q.w * q.y));
+        axes[1] = math::Vec3(2.0f * (q.x * q.y - q.w * q.z), 1.0f - 2.0f * (q.x * q.x + q.z * q.z),
+                             2.0f * (q.y * q.z + q.w * q.x));
+        axes[2] = math::Vec3(2.0f * (q.x * q.z + q.w * q.y), 2.0f * (q.y * q.z - q.w * q.x),
+                             1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+    }
+
+    /// Rotate a local direction to world space
+    math::Vec3 rotate(const math::Vec3& local) const noexcept {
+        return axes[0] * local.x + axes[1] * local.y + axes[2] * local.z;
+    }
+
+    /// Rotate a world direction to local space
+    math::Vec3 unrotate(const math::Vec3& world) const noexcept {
+        return math::Vec3(axes[0].dot(world), axes[1].dot(world), axes[2].dot(world));
+    }
+
+    /// Transform a local point to world space
+    math::Vec3 toWorld(const math::Vec3& local) const noexcept { return position + rotate(local); }
+
+    /// Transform a world point to local space
+    math::Vec3 toLocal(const math::Vec3& world) const noexcept {
+        return unrotate(world - position);
+    }
+};
+
+}  // namespace axiom::collision
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "axiom/collision/proxy.hpp"
+#include "axiom/math/aabb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}
+
+namespace axiom::collision {
+
+/// Configuration of a SweepAndPrune broadphase
+struct SweepAndPruneConfig {
+    /// Job system used for the radix sort fallback (nullptr = single-threaded)
+    core::JobSystem* jobSystem = nullptr;
+
+    /// Average distance (in positions) the insertion sort may move each entry
+    /// before giving up and re-sorting with a radix sort
+    ///
+    /// Insertion sort is linear for coherent motion but quadratic after
+    /// teleports, mass spawns or a change of sweep axis.
+    float maxShiftsPerEntry = 8.0f;
+
+    /// Band width in multiples of the mean proxy size on the band axis
+    float bandWidthScale = 2.0f;
+
+    /// Below this many proxies everything is swept as a single band
+    uint32_t minBandedProxies = 512;
+
+    /// Number of proxies reserved up front
+    uint32_t initialCapacity = 1024;
+};
+
+/// Statistics of the last SweepAndPrune::update()
+struct SweepAndPruneStats {
+    uint32_t sweepAxis = 0;        ///< Axis entries are sorted on (0 = x, 1 = y, 2 = z)
+    uint32_t bandAxis = 1;         ///< Axis space is cut into bands along
+    float bandWidth = 0.0f;        ///< Width of a band (0 = single band)
+    uint32_t entryCount = 0;       ///< Sorted entries (a proxy has one per band it spans)
+    uint32_t outOfOrder = 0;       ///< Entries found out of order before sorting
+    bool usedRadixSort = false;    ///< true if the radix sort fallback ran
+    uint64_t insertionShifts = 0;  ///< Positions moved by the insertion sort
+};
+
+/// Sweep-and-prune broadphase for dense scenes with coherent motion
+///
+/// A single sorted axis prunes poorly once a volume is densely filled: each
+/// proxy shares its slab of the sweep axis with a large part of the scene. The
+/// space is therefore cut into bands along a second axis and each band is swept
+/// on its own. Entries are sorted by (band, lower bound on the sweep axis); a
+/// proxy spanning several bands has an entry in each, and a pair is reported
+/// only in the first band both proxies share.
+///
+/// Every update refreshes the keys and restores the order with an insertion
+/// sort, which is nearly linear when everything moves a little - box stacks,
+/// debris piles, granular material. When the insertion sort exceeds its budget
+/// (teleports, mass spawning, a new axis or band width) the entries are
+/// re-sorted with a radix sort instead, split over the job system's workers if
+/// one is configured.
+///
+/// After sorting, the bounds are gathered into structure-of-arrays buffers in
+/// entry order. The sweep visits each entry once and scans forward over the
+/// contiguous run of entries in its band that start before it ends; the other
+/// two axes are tested for the whole run in one branch-free loop that the
+/// compiler vectorizes.
+///
+/// The sweep and band axes are the two axes with the largest spread of proxy
+/// centers and the band width follows the mean proxy size. Both are
+/// re-evaluated every update, with hysteresis. Proxies far larger than the
+/// band width (terrain, level geometry) get many entries and belong in a
+/// separate broadphase.
+///
+/// Unlike DynamicAABBTree, the bounds are used as given (no fat margin), and
+/// updatePairs() reports every overlapping pair, not only new ones.
+///
+/// Example usage:
+/// @code
+/// SweepAndPrune sap({.jobSystem = &jobs});
+/// ProxyId id = sap.createProxy(body.aabb, bodyIndex);
+///
+/// // Every step
+/// sap.moveProxy(id, body.aabb);
+/// sap.updatePairs([&](ProxyId a, ProxyId b) {
+///     pairCache.add(sap.getUserData(a), sap.getUserData(b));
+/// });
+/// @endcode
+class SweepAndPrune {
+public:
+    /// Create an empty broadphase
+    /// @param config Configuration
+    explicit SweepAndPrune(const SweepAndPruneConfig& config = {});
+
+    /// Destructor
+    ~SweepAndPrune() = default;
+
+    // Non-copyable (proxy ids are tied to one broadphase)
+    SweepAndPrune(const SweepAndPrune&) = delete;
+    SweepAndPrune& operator=(const SweepAndPrune&) = delete;
+
+    // Movable
+    SweepAndPrune(SweepAndPrune&&) noexcept = default;
+    SweepAndPrune& operator=(SweepAndPrune&&) noexcept = default;
+
+    // === Proxies ===
+
+    /// Add a proxy (sorted into place by the next update)
+    /// @param aabb Bounds of the object
+    /// @param userData Value returned by getUserData (typically a body index)
+    /// @return Proxy id
+    ProxyId createProxy(const math::AABB& aabb, uint64_t userData);
+
+    /// Remove a proxy
+    /// @param id Proxy created by this broadphase
+    void destroyProxy(ProxyId id);
+
+    /// Set the bounds of a proxy (takes effect at the next update)
+    /// @param id Proxy to move
+    /// @param aabb New bounds
+    void moveProxy(ProxyId id, const math::AABB& aabb);
+
+    /// Set the bounds of many proxies
+    /// @param moves Proxies to move (displacements are ignored)
+    void moveProxies(std::span<const ProxyMove> moves);
+
+    /// Get the bounds of a proxy
+    /// @param id Proxy id
+    /// @return Bounds passed to createProxy or the last move
+    const math::AABB& getAABB(ProxyId id) const noexcept { return proxies_[id].aabb; }
+
+    /// Get the user data of a proxy
+    /// @param id Proxy id
+    /// @return Value passed to createProxy
+    uint64_t getUserData(ProxyId id) const noexcept { return proxies_[id].userData; }
+
+    /// Replace the user data of a proxy
+    /// @param id Proxy id
+    /// @param userData New value returned by getUserData
+    void setUserData(ProxyId id, uint64_t userData) noexcept { proxies_[id].userData = userData; }
+
+    /// Get the number of proxies
+    uint32_t getProxyCount() const noexcept { return proxyCount_; }
+
+    // === Update and queries ===
+
+    /// Sort the entries and refresh the sweep buffers
+    ///
+    /// Called by updatePairs(); call it directly before query() when proxies
+    /// moved but no pairs are needed.
+    void update();
+
+    /// Update, then report every overlapping pair
+    /// @param callback Called as void(ProxyId a, ProxyId b) with a < b
+    /// @return Number of pairs reported
+    template <typename Callback>
+    size_t updatePairs(Callback&& callback);
+
+    /// Report every proxy overlapping an AABB, using the bounds of the last update()
+    /// @param aabb Query bounds
+    /// @param callback Called as bool(ProxyId); return false to stop the query
+    template <typename Callback>
+    void query(const math::AABB& aabb, Callback&& callback) const;
+
+    /// Get the statistics of the last update
+    const SweepAndPruneStats& getStats() const noexcept { return stats_; }
+
+    /// Get the sweep axis chosen for the next update (0 = x, 1 = y, 2 = z)
+    uint32_t getSweepAxis() const noexcept { return nextLayout_.sweepAxis; }
+
+private:
+    static constexpr uint32_t NullProxy = UINT32_MAX;
+
+    struct Proxy {
+        math::AABB aabb;
+        uint64_t userData = 0;
+        uint32_t nextFree = NullProxy;
+        int32_t bandLo = 0;   ///< Bands with an entry; empty while bandLo > bandHi
+        int32_t bandHi = -1;  ///< (entries of destroyed proxies linger until the next update)
+        bool alive = false;
+    };
+
+    /// Axes and band width of the sorted entries
+    struct Layout {
+        uint32_t sweepAxis = 0;
+        uint32_t bandAxis = 1;
+        uint32_t thirdAxis = 2;
+        float bandWidth = 0.0f;  ///< 0 = single band
+
+        bool operator==(const Layout&) const = default;
+    };
+
+    /// Entry data in sorted order; axis 0 is the sweep axis, 1 the band axis
+    struct SweepBuffers {
+        std::array<std::vector<float>, 3> min;
+        std::array<std::vector<float>, 3> max;
+        std::vector<uint32_t> band;    ///< Band of the entry (biased)
+        std::vector<uint32_t> bandLo;  ///< First band of the entry's proxy (biased)
+        std::vector<ProxyId> ids;
+    };
+
+    int32_t bandOf(float value) const noexcept;
+    static uint32_t biasBand(int32_t band) noexcept;
+    static uint64_t makeKey(uint32_t biasedBand, float sweepMin) noexcept;
+
+    void rebuildEntries();
+    void refreshKeys();
+    bool insertionSort(uint64_t maxShifts) noexcept;
+    void mergeAdded();
+    void radixSort();
+    void gather();
+    void chooseLayout();
+
+    /// Find the end of the run of entries in the band of entry i that start before it ends
+    size_t runEnd(size_t i) const noexcept;
+
+    /// Test entry i of the sweep buffers against the run [i + 1, end) of its band
+    /// @return Number of pairs written to mask_ (entry k is 1 for a pair with i + 1 + k)
+    size_t testRun(size_t i, size_t end) noexcept;
+
+    SweepAndPruneConfig config_;
+    std::vector<Proxy> proxies_;
+    uint32_t freeList_ = NullProxy;
+    uint32_t proxyCount_ = 0;
+
+    Layout layout_;                 ///< Layout of the sorted entries
+    Layout nextLayout_;             ///< Layout for the next update
+    std::vector<uint64_t> keys_;    ///< (biased band << 32) | sortable lower bound, sorted
+    std::vector<ProxyId> entries_;  ///< Proxy of each key
+    std::vector<std::pair<uint64_t, ProxyId>> added_;  ///< Entries to merge into the next update
+    std::vector<uint64_t> radixKeysTemp_;
+    std::vector<ProxyId> radixEntriesTemp_;
+    SweepBuffers sweep_;
+    float maxSweepExtent_ = 0.0f;  ///< Largest proxy size on the sweep axis (for queries)
+    std::vector<uint8_t> mask_;    ///< Scratch for testRun
+    SweepAndPruneStats stats_;
+};
+
+//=============================================================================
+// Template implementations
+//=============================================================================
+
+template <typename Callback>
+size_t SweepAndPrune::updatePairs(Callback&& callback) {
+    update();
+
+    const size_t count = sweep_.ids.size();
+    size_t pairCount = 0;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        const size_t end = runEnd(i);
+        if (end == i + 1 || testRun(i, end) == 0) {
+            continue;
+        }
+
+        const ProxyId a = sweep_.ids[i];
+        for (size_t k = 0; k < end - i - 1; ++k) {
+            if (mask_[k] != 0) {
+                const ProxyId b = sweep_.ids[i + 1 + k];
+                if (a < b) {
+                    callback(a, b);
+                } else {
+                    callback(b, a);
+                }
+                ++pairCount;
+            }
+        }
+    }
+    return pairCount;
+}
+
+template <typename Callback>
+void SweepAndPrune::query(const math::AABB& aabb, Callback&& callback) const {
+    const size_t count = keys_.size();
+    const uint32_t sweepAxis = layout_.sweepAxis;
+    const uint32_t bandAxis = layout_.bandAxis;
+    const uint32_t thirdAxis = layout_.thirdAxis;
+    const uint32_t queryBandLo = biasBand(bandOf(aabb.min[bandAxis]));
+    const uint32_t queryBandHi = biasBand(bandOf(aabb.max[bandAxis]));
+
+    // No proxy starting before (query min - largest extent) can reach the query
+    const float scanStart = aabb.min[sweepAxis] - maxSweepExtent_;
+    uint64_t searchKey = makeKey(queryBandLo, scanStart);
+    size_t first = 0;
+    while (true) {
+        size_t last = count;
+        while (first < last) {
+            const size_t mid = first + (last - first) / 2;
+            if (keys_[mid] < searchKey) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        if (first == count || sweep_.band[first] > queryBandHi) {
+            return;
+        }
+
+        // Landed past empty bands: search the first non-empty one from the scan start
+        const uint32_t band = sweep_.band[first];
+        if (band != static_cast<uint32_t>(searchKey >> 32)) {
+            searchKey = makeKey(band, scanStart);
+            continue;
+        }
+
+        // Each proxy is reported in the first band it shares with the query
+        size_t i = first;
+        for (; i < count && sweep_.band[i] == band && sweep_.min[0][i] <= aabb.max[sweepAxis];
+             ++i) {
+            if (std::max(sweep_.bandLo[i], queryBandLo) == band &&
+                sweep_.max[0][i] >= aabb.min[sweepAxis] && sweep_.min[1][i] <= aabb.max[bandAxis] &&
+                sweep_.max[1][i] >= aabb.min[bandAxis] && sweep_.min[2][i] <= aabb.max[thirdAxis] &&
+                sweep_.max[2][i] >= aabb.min[thirdAxis]) {
+                if (!callback(sweep_.ids[i])) {
+                    return;
+                }
+            }
+        }
+
+        if (band == queryBandHi) {
+            return;
+        }
+        searchKey = makeKey(band + 1, scanStart);
+        first = i;
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "axiom/collision/ray_packet.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/result.hpp"
+#include "axiom/math/aabb.hpp"
+#include "axiom/math/vec3.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}  // namespace axiom::core
+
+namespace axiom::collision {
+
+/// Configuration of TriangleMesh::create()
+struct TriangleMeshConfig {
+    /// Largest number of triangles in a leaf (1 to 8)
+    uint32_t maxLeafTriangles = 4;
+    /// Number of SAH bins per axis (2 to 64)
+    uint32_t binCount = 16;
+    /// Optional; when set, large subtrees are built in parallel
+    core::JobSystem* jobSystem = nullptr;
+};
+
+/// Closest hit of TriangleMesh::raycast()
+struct MeshRayHit {
+    float distance = 0.0f;  ///< Distance along the ray
+    math::Vec3 point;       ///< Hit point in mesh space
+    math::Vec3 normal;      ///< Unit triangle normal, facing the ray origin
+    uint32_t triangle = 0;  ///< Index of the triangle in the input index buffer
+};
+
+/// Result of TriangleMesh::closestPoint()
+struct MeshClosestPoint {
+    math::Vec3 point;       ///< Closest point on the mesh, in mesh space
+    float distance = 0.0f;  ///< Distance from the query point
+    uint32_t triangle = 0;  ///< Index of the triangle in the input index buffer
+};
+
+/// Statistics of a built TriangleMesh
+struct TriangleMeshStats {
+    uint32_t triangleCount = 0;     ///< Triangles
+    uint32_t vertexCount = 0;       ///< Vertices referenced by the triangles
+    uint32_t nodeCount = 0;         ///< 4-wide nodes
+    uint32_t leafCount = 0;         ///< Leaves (children holding triangles)
+    uint32_t depth = 0;             ///< Levels of 4-wide nodes
+    size_t memoryBytes = 0;         ///< Nodes, triangles and vertices
+    bool compressedIndices = true;  ///< Triangles use 8-byte delta-encoded indices
+};
+
+/// Static triangle mesh with a quantized 4-wide BVH, for level geometry
+///
+/// The hierarchy is built once with a binned surface area heuristic into a
+/// binary tree, then collapsed into nodes with four children by repeatedly
+/// opening the child with the largest surface area. Each node is one 64-byte
+/// cache line: the four child boxes in structure-of-arrays form as 16-bit
+/// integers relative to the mesh bounds, rounded outward, and four child
+/// references. Tests against the four children are plain loops over those
+/// arrays, which the compiler vectorizes; AABB queries compare integers
+/// directly after quantizing the query box once.
+///
+/// Triangles are stored in leaf order, and vertices are renumbered in the
+/// order the leaves first use them, so the indices of a triangle are close to
+/// each other: a triangle is stored as its first index and two 16-bit deltas
+/// (8 bytes instead of 12). Meshes whose deltas do not fit fall back to full
+/// indices. Queries report the index of the triangle in the input buffer.
+///
+/// With a job system, subtrees below a size threshold are built in parallel
+/// once the serial top levels have split the mesh; the result does not depend
+/// on the number of threads.
+///
+/// Everything is in mesh space; placing the mesh in the world is up to the
+/// caller (see collideMeshConvex()).
+///
+/// Example usage:
+/// @code
+/// auto mesh = TriangleMesh::create(vertices, indices);
+/// MeshRayHit hit;
+/// if (mesh.value().raycast(origin, direction, 100.0f, hit)) {
+///     spawnDecal(hit.point, hit.normal);
+/// }
+/// mesh.value().queryAABB(bounds, [&](uint32_t triangle, const auto& vertices) {
+///     collide(vertices);
+///     return true;
+/// });
+/// @endcode
+class TriangleMesh {
+public:
+    /// Quantized 4-wide node: one cache line
+    struct alignas(64) Node {
+        std::array<uint16_t, 4> minX;
+        std::array<uint16_t, 4> minY;
+        std::array<uint16_t, 4> minZ;
+        std::array<uint16_t, 4> maxX;
+        std::array<uint16_t, 4> maxY;
+        std::array<uint16_t, 4> maxZ;
+        std::array<uint32_t, 4> children;  ///< Node index, encoded leaf, or EmptyChild
+    };
+
+    /// Child reference of an unused slot
+    static constexpr uint32_t EmptyChild = UINT32_MAX;
+
+    /// Largest number of triangles a mesh can hold
+    static constexpr uint32_t MaxTriangles = 1u << 28;
+
+    /// Build a mesh
+    /// @param vertices Vertex positions
+    /// @param indices Three vertex indices per triangle
+    /// @param config Build settings
+    /// @return The mesh, or InvalidShape if there are no triangles, an index is
+    ///         out of range or the index count is not a multiple of three
+    static core::Result<TriangleMesh> create(std::span<const math::Vec3> vertices,
+                                             std::span<const uint32_t> indices,
+                                             const TriangleMeshConfig& config = {});
+
+    /// Create an empty mesh
+    TriangleMesh() = default;
+
+    // === Queries ===
+
+    /// Report every triangle whose bounds overlap an AABB
+    /// @param aabb Query bounds in mesh space
+    /// @param callback Called as bool(uint32_t triangle, const std::array<math::Vec3, 3>&);
+    ///                 return false to stop the query
+    template <typename Callback>
+    void queryAABB(const math::AABB& aabb, Callback&& callback) const;
+
+    /// Find the closest triangle hit by a ray (triangles are two-sided)
+    /// @param origin Ray origin in mesh space
+    /// @param direction Unit ray direction
+    /// @param maxDistance Length of the ray
+    /// @param hit Receives the closest hit
+    /// @return true if the ray hits the mesh
+    bool raycast(const math::Vec3& origin, const math::Vec3& direction, float maxDistance,
+                 MeshRayHit& hit) const noexcept;
+
+    /// Cast a packet of rays (triangles are two-sided)
+    ///
+    /// Each node is fetched once for all the rays of the packet, and children
+    /// are visited nearest first. A closest-hit lane is shortened to every hit
+    /// it finds; an any-hit lane leaves the active mask at its first hit, and
+    /// the traversal ends once no lane is left.
+    /// @param packet Rays in mesh space; lengths and active mask are updated
+    /// @param hits Receives the hit of every lane in the returned mask
+    /// @param anyHit Stop each ray at its first hit instead of the closest one
+    /// @return Mask of the lanes that hit the mesh
+    uint32_t raycast(RayPacket& packet, std::array<MeshRayHit, RayPacket::Width>& hits,
+                     bool anyHit = false) const noexcept;
+
+    /// Find the point of the mesh closest to a point
+    /// @param point Query point in mesh space
+    /// @param maxDistance Points further away than this are ignored
+    /// @param result Receives the closest point
+    /// @return true if a triangle is within maxDistance
+    bool closestPoint(const math::Vec3& point, float maxDistance,
+                      MeshClosestPoint& result) const noexcept;
+
+    /// Visit every triangle (e.g. to draw the mesh)
+    /// @param callback Called as void(uint32_t triangle, const std::array<math::Vec3, 3>&)
+    template <typename Callback>
+    void forEachTriangle(Callback&& callback) const;
+
+    // === Properties ===
+
+    /// Get the bounds of the mesh
+    const math::AABB& getBounds() const noexcept { return bounds_; }
+
+    /// Get the number of triangles
+    uint32_t getTriangleCount() const noexcept { return static_cast<uint32_t>(ids_.size()); }
+
+    /// Get the nodes, root first
+    std::span<const Node> getNodes() const noexcept { return nodes_; }
+
+    /// Get the statistics of the mesh
+    TriangleMeshStats getStats() const noexcept;
+
+private:
+    /// Triangle with delta-encoded indices
+    struct PackedTriangle {
+        uint32_t first;
+        int16_t delta1;
+        int16_t delta2;
+    };
+
+    /// Query box in quantized coordinates
+    struct QuantizedBox {
+        std::array<uint16_t, 3> min;
+        std::array<uint16_t, 3> max;
+    };
+
+    /// Deepest traversal stack: three pending siblings per level
+    static constexpr uint32_t StackSize = 256;
+
+    static constexpr uint32_t LeafFlag = 0x80000000u;
+    static constexpr uint32_t LeafCountShift = 28;
+    static constexpr uint32_t LeafFirstMask = (1u << LeafCountShift) - 1;
+
+    static bool isLeaf(uint32_t child) noexcept { return (child & LeafFlag) != 0; }
+    static uint32_t leafFirst(uint32_t child) noexcept { return child & LeafFirstMask; }
+    static uint32_t leafCount(uint32_t child) noexcept {
+        return ((child >> LeafCountShift) & 0x7u) + 1;
+    }
+
+    /// Quantize a box, rounding outward; false if it misses the mesh bounds
+    bool quantize(const math::AABB& aabb, QuantizedBox& box) const noexcept;
+
+    /// Get the bounds of a child of a node, rounded outward
+    math::AABB getChildBounds(const Node& node, uint32_t slot) const noexcept;
+
+    /// Get the vertices of a triangle, by storage index
+    std::array<math::Vec3, 3> getVertices(uint32_t index) const noexcept;
+
+    math::AABB bounds_;
+    math::Vec3 origin_;  ///< Position of quantized coordinate 0
+    math::Vec3 scale_;   ///< Size of one quantization step
+    math::Vec3 inverseScale_;
+    std::vector<Node> nodes_;
+    std::vector<math::Vec3> vertices_;           ///< In order of first use by the leaves
+    std::vector<PackedTriangle> packed_;         ///< Triangles, when compressed_
+    std::vector<std::array<uint32_t, 3>> wide_;  ///< Triangles, otherwise
+    std::vector<uint32_t> ids_;                  ///< Input index of each stored triangle
+    bool compressed_ = true;
+};
+
+static_assert(sizeof(TriangleMesh::Node) == 64, "A mesh node must fill one cache line");
+
+//=============================================================================
+// Inline / template implementations
+//=============================================================================
+
+inline std::array<math::Vec3, 3> TriangleMesh::getVertices(uint32_t index) const noexcept {
+    if (compressed_) {
+        const PackedTriangle& triangle = packed_[index];
+        const auto first = static_cast<int64_t>(triangle.first);
+        return {vertices_[triangle.first], vertices_[static_cast<size_t>(first + triangle.delta1)],
+                vertices_[static_cast<size_t>(first + triangle.delta2)]};
+    }
+    const std::array<uint32_t, 3>& triangle = wide_[index];
+    return {vertices_[triangle[0]], vertices_[triangle[1]], vertices_[triangle[2]]};
+}
+
+template <typename Callback>
+void TriangleMesh::queryAABB(const math::AABB& aabb, Callback&& callback) const {
+    QuantizedBox box;
+    if (nodes_.empty() || !quantize(aabb, box)) {
+        return;
+    }
+
+    std::array<uint32_t, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes_[stack[--stackSize]];
+
+        // Integer overlap of the four children at once
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const bool overlaps = (node.minX[i] <= box.max[0]) & (node.maxX[i] >= box.min[0]) &
+                                  (node.minY[i] <= box.max[1]) & (node.maxY[i] >= box.min[1]) &
+                                  (node.minZ[i] <= box.max[2]) & (node.maxZ[i] >= box.min[2]) &
+                                  (node.children[i] != EmptyChild);
+            mask |= static_cast<uint32_t>(overlaps) << i;
+        }
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            if ((mask & (1u << i)) == 0) {
+                continue;
+            }
+            const uint32_t child = node.children[i];
+            if (!isLeaf(child)) {
+                AXIOM_ASSERT(stackSize < StackSize, "Mesh traversal stack overflow");
+                stack[stackSize++] = child;
+                continue;
+            }
+            const uint32_t end = leafFirst(child) + leafCount(child);
+            for (uint32_t index = leafFirst(child); index < end; ++index) {
+                const std::array<math::Vec3, 3> vertices = getVertices(index);
+                math::AABB triangleBounds(vertices[0]);
+                triangleBounds.expand(vertices[1]);
+                triangleBounds.expand(vertices[2]);
+                if (triangleBounds.intersects(aabb) && !callback(ids_[index], vertices)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+template <typename Callback>
+void TriangleMesh::forEachTriangle(Callback&& callback) const {
+    const auto count = static_cast<uint32_t>(ids_.size());
+    for (uint32_t index = 0; index < count; ++index) {
+        callback(ids_[index], getVertices(index));
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "axiom/collision/proxy.hpp"
+#include "axiom/math/aabb.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace axiom::core {
+class JobSystem;
+}
+
+namespace axiom::collision {
+
+/// Configuration of a UniformGrid broadphase
+struct UniformGridConfig {
+    /// Job system used to build the grid and find pairs (nullptr = single-threaded)
+    core::JobSystem* jobSystem = nullptr;
+
+    /// Fixed cell size (0 = derived from the median proxy size every update)
+    float cellSize = 0.0f;
+
+    /// Cell size in multiples of the median proxy size, when not fixed
+    ///
+    /// Larger cells mean fewer entries per proxy but more tests per cell.
+    float cellSizeScale = 1.5f;
+
+    /// Proxies covering more cells are kept out of the grid and tested against every proxy
+    uint32_t maxCellsPerProxy = 64;
+
+    /// Number of proxies reserved up front
+    uint32_t initialCapacity = 1024;
+};
+
+/// Statistics of the last UniformGrid::update()
+struct UniformGridStats {
+    float cellSize = 0.0f;        ///< Edge length of a cell
+    uint32_t entryCount = 0;      ///< (cell, proxy) entries (a proxy has one per cell it covers)
+    uint32_t cellCount = 0;       ///< Occupied cells
+    uint32_t bucketCount = 0;     ///< Buckets of the cell table
+    uint32_t maxOccupancy = 0;    ///< Largest number of entries in a cell
+    uint32_t oversizedCount = 0;  ///< Proxies kept out of the grid
+};
+
+/// Hashed uniform grid broadphase for many objects of similar size
+///
+/// Debris, granular material and projectiles are numerous, small and all
+/// about the same size. A grid handles them in linear time with no
+/// hierarchy to refit: every update throws the cells away and rebuilds them
+/// from the current bounds.
+///
+/// The rebuild is a counting sort of (cell, proxy) entries into a table of
+/// hashed buckets: one pass counts the entries per bucket, a prefix sum turns
+/// the counts into bucket offsets, and a second pass writes each entry -
+/// bounds included - straight into its bucket. Every cell is then one
+/// contiguous run, so pair tests stream through memory, and the bucket
+/// offsets double as the cell table: looking a cell up is a hash, an offset
+/// read and a short scan. Both passes and the pair search are split over the
+/// job system's workers if one is configured; buckets are finally ordered by
+/// (cell, proxy) so the result does not depend on thread timing.
+///
+/// Proxies larger than a cell are inserted into every cell they cover. A
+/// pair sharing several cells is reported only from the cell holding the
+/// lower corner of their intersection, which needs no global set. Proxies
+/// covering more than maxCellsPerProxy cells stay out of the grid and are
+/// tested against every proxy instead.
+///
+/// The cell size follows the median proxy size, sampled every update, unless
+/// a fixed size is configured. Like SweepAndPrune, the bounds are used as
+/// given and updatePairs() reports every overlapping pair, in the same order
+/// for the same input.
+///
+/// Example usage:
+/// @code
+/// UniformGrid grid({.jobSystem = &jobs});
+/// ProxyId id = grid.createProxy(pebble.aabb, pebbleIndex);
+///
+/// // Every step
+/// grid.moveProxy(id, pebble.aabb);
+/// grid.updatePairs([&](ProxyId a, ProxyId b) {
+///     pairCache.add(grid.getUserData(a), grid.getUserData(b));
+/// });
+/// @endcode
+class UniformGrid {
+public:
+    /// Create an empty grid
+    /// @param config Configuration
+    explicit UniformGrid(const UniformGridConfig& config = {});
+
+    /// Destructor
+    ~UniformGrid() = default;
+
+    // Non-copyable (proxy ids are tied to one broadphase)
+    UniformGrid(const UniformGrid&) = delete;
+    UniformGrid& operator=(const UniformGrid&) = delete;
+
+    // Movable
+    UniformGrid(UniformGrid&&) noexcept = default;
+    UniformGrid& operator=(UniformGrid&&) noexcept = default;
+
+    // === Proxies ===
+
+    /// Add a proxy (inserted into the cells by the next update)
+    /// @param aabb Bounds of the object
+    /// @param userData Value returned by getUserData (typically a body index)
+    /// @return Proxy id
+    ProxyId createProxy(const math::AABB& aabb, uint64_t userData);
+
+    /// Remove a proxy
+    /// @param id Proxy created by this grid
+    void destroyProxy(ProxyId id);
+
+    /// Set the bounds of a proxy (takes effect at the next update)
+    /// @param id Proxy to move
+    /// @param aabb New bounds
+    void moveProxy(ProxyId id, const math::AABB& aabb);
+
+    /// Set the bounds of many proxies
+    /// @param moves Proxies to move (displacements are ignored)
+    void moveProxies(std::span<const ProxyMove> moves);
+
+    /// Get the bounds of a proxy
+    /// @param id Proxy id
+    /// @return Bounds passed to createProxy or the last move
+    const math::AABB& getAABB(ProxyId id) const noexcept { return proxies_[id].aabb; }
+
+    /// Get the user data of a proxy
+    /// @param id Proxy id
+    /// @return Value passed to createProxy
+    uint64_t getUserData(ProxyId id) const noexcept { return proxies_[id].userData; }
+
+    /// Replace the user data of a proxy
+    /// @param id Proxy id
+    /// @param userData New value returned by getUserData
+    void setUserData(ProxyId id, uint64_t userData) noexcept { proxies_[id].userData = userData; }
+
+    /// Get the number of proxies
+    uint32_t getProxyCount() const noexcept { return proxyCount_; }
+
+    // === Update and queries ===
+
+    /// Rebuild the cells from the current bounds
+    ///
+    /// Called by updatePairs(); call it directly before query() when proxies
+    /// moved but no pairs are needed.
+    void update();
+
+    /// Update, then report every overlapping pair
+    /// @param callback Called as void(ProxyId a, ProxyId b) with a < b
+    /// @return Number of pairs reported
+    template <typename Callback>
+    size_t updatePairs(Callback&& callback);
+
+    /// Report every proxy overlapping an AABB, using the cells of the last update()
+    /// @param aabb Query bounds
+    /// @param callback Called as bool(ProxyId); return false to stop the query
+    template <typename Callback>
+    void query(const math::AABB& aabb, Callback&& callback) const;
+
+    /// Get the statistics of the last update
+    const UniformGridStats& getStats() const noexcept { return stats_; }
+
+private:
+    static constexpr uint32_t NullProxy = UINT32_MAX;
+
+    struct Proxy {
+        math::AABB aabb;
+        uint64_t userData = 0;
+        uint32_t nextFree = NullProxy;
+        bool alive = false;
+    };
+
+    /// Integer cell coordinates covered by a proxy
+    struct CellRange {
+        std::array<int32_t, 3> lo;
+        std::array<int32_t, 3> hi;
+        uint32_t cellCount = 0;  ///< 0 for destroyed and oversized proxies
+        bool oversized = false;
+    };
+
+    /// A proxy in one cell; the entries of a cell are contiguous
+    struct CellEntry {
+        uint64_t cell;                     ///< Packed cell coordinates
+        math::AABB bounds;                 ///< Bounds of the proxy
+        std::array<int32_t, 3> firstCell;  ///< Lowest cell of the proxy per axis
+        ProxyId id;
+    };
+
+    void chooseCellSize();
+    CellRange cellRange(const math::AABB& aabb) const noexcept;
+    uint32_t bucketOf(uint64_t cell) const noexcept;
+    static uint64_t packCell(int32_t x, int32_t y, int32_t z) noexcept;
+    static std::array<int32_t, 3> unpackCell(uint64_t cell) noexcept;
+
+    void countEntries();
+    void scatterEntries();
+    void sortBuckets();
+    void findPairs();
+
+    /// Find the entries of a cell
+    /// @return [begin, end) in entries_ (empty if the cell is unoccupied)
+    std::pair<uint32_t, uint32_t> findCell(uint64_t cell) const noexcept;
+
+    /// Test whether an entry overlaps an AABB
+    static bool overlaps(const CellEntry& entry, const math::AABB& aabb) noexcept;
+
+    UniformGridConfig config_;
+    std::vector<Proxy> proxies_;
+    uint32_t freeList_ = NullProxy;
+    uint32_t proxyCount_ = 0;
+
+    float cellSize_ = 1.0f;
+    float inverseCellSize_ = 1.0f;
+    uint32_t bucketBits_ = 0;
+    bool parallelBuild_ = false;  ///< Counting sort runs on several threads this update
+
+    std::vector<CellRange> ranges_;       ///< Per proxy, for the last update
+    std::vector<uint32_t> bucketStarts_;  ///< First entry of each bucket (+ end)
+    std::vector<uint32_t> bucketCursors_; ///< Scatter positions during the build
+    std::vector<CellEntry> entries_;      ///< Grouped by bucket, then cell, then proxy
+    std::vector<uint32_t> cellStarts_;    ///< First entry of each cell (+ end)
+    std::vector<ProxyId> oversized_;      ///< Proxies kept out of the grid
+    std::vector<std::vector<std::pair<ProxyId, ProxyId>>> pairChunks_;
+    std::vector<float> sizeSamples_;
+    UniformGridStats stats_;
+};
+
+//=============================================================================
+// Template implementations
+//=============================================================================
+
+template <typename Callback>
+size_t UniformGrid::updatePairs(Callback&& callback) {
+    update();
+    findPairs();
+
+    // Chunks cover the cells in order, so the report order is deterministic
+    size_t pairCount = 0;
+    for (const auto& chunk : pairChunks_) {
+        for (const auto& [a, b] : chunk) {
+            callback(a, b);
+        }
+        pairCount += chunk.size();
+    }
+    return pairCount;
+}
+
+template <typename Callback>
+void UniformGrid::query(const math::AABB& aabb, Callback&& callback) const {
+    if (entries_.empty() && oversized_.empty()) {
+        return;
+    }
+    const CellRange range = cellRange(aabb);
+    const auto cellsCovered = static_cast<int64_t>(range.hi[0] - range.lo[0] + 1) *
+                              static_cast<int64_t>(range.hi[1] - range.lo[1] + 1) *
+                              static_cast<int64_t>(range.hi[2] - range.lo[2] + 1);
+
+    if (cellsCovered > static_cast<int64_t>(stats_.cellCount)) {
+        // Visiting the occupied cells is cheaper than looking up every covered one
+        for (size_t c = 0; c + 1 < cellStarts_.size(); ++c) {
+            const std::array<int32_t, 3> cell = unpackCell(entries_[cellStarts_[c]].cell);
+            for (uint32_t e = cellStarts_[c]; e < cellStarts_[c + 1]; ++e) {
+                // Report each proxy from its first cell only
+                const CellEntry& entry = entries_[e];
+                if (entry.firstCell == cell && overlaps(entry, aabb) && !callback(entry.id)) {
+                    return;
+                }
+            }
+        }
+    } else {
+        for (int32_t x = range.lo[0]; x <= range.hi[0]; ++x) {
+            for (int32_t y = range.lo[1]; y <= range.hi[1]; ++y) {
+                for (int32_t z = range.lo[2]; z <= range.hi[2]; ++z) {
+                    const auto [begin, end] = findCell(packCell(x, y, z));
+                    for (uint32_t e = begin; e < end; ++e) {
+                        // Report each proxy from the first cell it shares with the query
+                        const CellEntry& entry = entries_[e];
+                        if (std::max(entry.firstCell[0], range.lo[0]) == x &&
+                            std::max(entry.firstCell[1], range.lo[1]) == y &&
+                            std::max(entry.firstCell[2], range.lo[2]) == z &&
+                            overlaps(entry, aabb) && !callback(entry.id)) {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (const ProxyId id : oversized_) {
+        if (proxies_[id].aabb.intersects(aabb) && !callback(id)) {
+            return;
+        }
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define AXIOM_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define AXIOM_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define AXIOM_CPU_RELAX() std::this_thread::yield()
+#endif
+
+namespace axiom::core {
+
+/// Cache line size assumed for padding (x86-64 and most ARM cores)
+///
+/// std::hardware_destructive_interference_size is not used because its value
+/// may differ between compilers and flags, which would make it an ABI hazard.
+inline constexpr size_t CacheLineSize = 64;
+
+/// Hint to the CPU that the caller is busy-waiting
+///
+/// Lowers power use and frees execution resources for the sibling hyperthread
+/// while spinning on a value owned by another core.
+inline void cpuRelax() noexcept {
+    AXIOM_CPU_RELAX();
+}
+
+/// Value padded to occupy whole cache lines
+///
+/// Prevents false sharing between values written by different threads, e.g.
+/// per-worker counters stored in an array.
+///
+/// @tparam T Wrapped type
+template <typename T>
+struct alignas(CacheLineSize) CacheLinePadded {
+    T value{};
+
+    CacheLinePadded() = default;
+
+    template <typename... Args>
+    explicit CacheLinePadded(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    T& get() noexcept { return value; }
+    const T& get() const noexcept { return value; }
+
+    T* operator->() noexcept { return &value; }
+    const T* operator->() const noexcept { return &value; }
+};
+
+/// Atomic on its own cache line
+template <typename T>
+using PaddedAtomic = CacheLinePadded<std::atomic<T>>;
+
+/// Event counter sharded across cache lines
+///
+/// A single atomic incremented from many threads ping-pongs its cache line
+/// between cores. ShardedCounter spreads increments over padded shards, picked
+/// per thread, and only sums them on load(). Increments are wait-free; load()
+/// is not a snapshot while writers are active.
+///
+/// Example usage:
+/// @code
+/// ShardedCounter contactsGenerated;
+///
+/// // Any worker thread
+/// contactsGenerated.add(manifold.pointCount);
+///
+/// // Once per frame
+/// stats.contactCount = contactsGenerated.load();
+/// contactsGenerated.reset();
+/// @endcode
+class ShardedCounter {
+public:
+    /// Create a counter
+    /// @param shardCount Number of shards (0 = hardware concurrency), rounded up to a power of two
+    explicit ShardedCounter(uint32_t shardCount = 0) {
+        if (shardCount == 0) {
+            shardCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        uint32_t count = 1;
+        while (count < shardCount) {
+            count <<= 1;
+        }
+        mask_ = count - 1;
+        shards_ = std::make_unique<PaddedAtomic<uint64_t>[]>(count);
+    }
+
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    /// Add to the counter (wait-free)
+    /// @param amount Amount to add
+    void add(uint64_t amount = 1) noexcept {
+        shards_[getThreadSlot() & mask_]->fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// Sum all shards
+    uint64_t load() const noexcept {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i <= mask_; ++i) {
+            total += shards_[i]->load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// Reset all shards to zero (not atomic with respect to concurrent add())
+    void reset() noexcept {
+        for (uint32_t i = 0; i <= mask_; ++i) {
+            shards_[i]->store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// Get the number of shards
+    uint32_t getShardCount() const noexcept { return mask_ + 1; }
+
+private:
+    /// Per-thread slot, handed out round-robin so concurrent threads land on different shards
+    static uint32_t getThreadSlot() noexcept {
+        static std::atomic<uint32_t> nextSlot{0};
+        thread_local const uint32_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    std::unique_ptr<PaddedAtomic<uint64_t>[]> shards_;
+    uint32_t mask_ = 0;
+};
+
+}  // namespace axiom::core
@@ -0,0 +1,449 @@
+#pragma once
+
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/result.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace axiom::core {
+
+class TaskExecutor;
+
+template <typename T = void>
+class Task;
+
+/// Statistics of the coroutine frame pool
+struct CoroutineFrameStats {
+    uint64_t pooledAllocations = 0;  ///< Frames served from a size-class pool
+    uint64_t heapAllocations = 0;    ///< Frames too large for the pools (plain operator new)
+    uint64_t liveFrames = 0;         ///< Frames currently allocated
+};
+
+/// Get coroutine frame allocation statistics (totals since program start)
+CoroutineFrameStats getCoroutineFrameStats() noexcept;
+
+namespace detail {
+
+/// Largest coroutine frame served from the pools; bigger frames fall back to operator new
+constexpr size_t MaxPooledCoroutineFrame = 4096;
+
+/// Allocate a coroutine frame from the size-class pools
+void* allocateCoroutineFrame(size_t size);
+
+/// Return a coroutine frame to its size-class pool
+void deallocateCoroutineFrame(void* ptr, size_t size) noexcept;
+
+/// Base for promise types whose frames come from the coroutine frame pools
+struct PooledFramePromise {
+    static void* operator new(size_t size) { return allocateCoroutineFrame(size); }
+    static void operator delete(void* ptr, size_t size) noexcept {
+        deallocateCoroutineFrame(ptr, size);
+    }
+};
+
+/// Resumes the awaiting coroutine (if any) when a Task finishes
+struct TaskFinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+template <typename T>
+struct TaskPromise : PooledFramePromise {
+    Task<T> get_return_object() noexcept;
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    template <typename U>
+    void return_value(U&& value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T takeResult() { return std::move(*result); }
+
+    std::coroutine_handle<> continuation;
+    std::optional<T> result;
+};
+
+template <>
+struct TaskPromise<void> : PooledFramePromise {
+    Task<void> get_return_object() noexcept;
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+    void return_void() const noexcept {}
+    void takeResult() const noexcept {}
+
+    std::coroutine_handle<> continuation;
+};
+
+/// Eagerly started, self-destroying coroutine used to drive Tasks from plain code
+struct DetachedTask {
+    struct promise_type : PooledFramePromise {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void unhandled_exception() const noexcept { std::terminate(); }
+        void return_void() const noexcept {}
+    };
+};
+
+/// Suspended coroutine waiting for a condition checked by the executor's poll thread
+struct PollNode {
+    bool (*poll)(PollNode& node) = nullptr;
+    std::coroutine_handle<> handle;
+};
+
+/// Suspended coroutine waiting for blocking work on the executor's I/O thread
+struct IoNode {
+    void (*execute)(IoNode& node) = nullptr;
+    std::coroutine_handle<> handle;
+};
+
+}  // namespace detail
+
+/// Lazily started coroutine producing a T
+///
+/// A Task does nothing until it is awaited. co_await on a Task starts it on
+/// the awaiting thread and resumes the awaiter, by symmetric transfer, when it
+/// finishes - so chains of Tasks never grow the stack. Coroutine frames are
+/// allocated from size-class pools rather than the general heap.
+///
+/// Tasks must not throw: an exception escaping a Task terminates the program.
+///
+/// Example usage:
+/// @code
+/// Task<int> computeAsync() { co_return 42; }
+///
+/// Task<void> streamIn(TaskExecutor& executor) {
+///     co_await executor.schedule();                      // continue on the pool
+///     auto bytes = co_await executor.readFile("level.bin");  // no thread blocked
+///     int value = co_await computeAsync();
+/// }
+///
+/// executor.spawn(streamIn(executor));
+/// @endcode
+///
+/// @tparam T Result type (void for none; references are not supported)
+template <typename T>
+class [[nodiscard]] Task {
+    static_assert(!std::is_reference_v<T>, "Task<T&> is not supported");
+
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() noexcept = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    /// Check if the Task holds a coroutine
+    bool isValid() const noexcept { return static_cast<bool>(handle_); }
+
+    /// Check if the coroutine has run to completion
+    bool isReady() const noexcept { return !handle_ || handle_.done(); }
+
+    /// Start the task and suspend until it completes
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().takeResult(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+
+/// Run a Task to completion, blocking the calling thread
+///
+/// The task starts on the calling thread and continues wherever its awaits
+/// resume it. Must not be called from a TaskExecutor thread.
+///
+/// @param task Task to run
+/// @return The task's result
+template <typename T>
+T syncWait(Task<T> task) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool done = false;
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+
+    auto run = [&]() -> detail::DetachedTask {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            result.emplace(true);
+        } else {
+            result.emplace(co_await std::move(task));
+        }
+        // Notify under the lock: syncWait() may return (destroying the condition) right after
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        condition.notify_one();
+    };
+    run();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&done] { return done; });
+
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*result);
+    }
+}
+
+/// Configuration for TaskExecutor
+struct TaskExecutorConfig {
+    uint32_t threadCount = 2;                           ///< Threads resuming coroutines
+    std::chrono::microseconds pollInterval{100};         ///< How often pending polls are checked
+};
+
+/// Small thread pool that resumes coroutines
+///
+/// Besides the resume threads, the executor runs a poll thread and an I/O
+/// thread. Waits on conditions that offer no notification - job counters, GPU
+/// fences and timeline semaphores - are registered with the poll thread, which
+/// checks them every pollInterval and schedules the waiting coroutine once
+/// satisfied. Blocking file reads run on the I/O thread. In both cases the
+/// coroutine is suspended, so no resume thread (and no JobSystem worker) is
+/// blocked while waiting.
+///
+/// Suspended awaiters live inside the coroutine frame, so registering a wait
+/// does not allocate.
+///
+/// Example usage:
+/// @code
+/// TaskExecutor executor;
+///
+/// Task<void> readback(TaskExecutor& executor, JobSystem& jobs, gpu::Fence& fence) {
+///     JobCounter counter;
+///     jobs.run(counter, [] { packContacts(); });
+///     co_await executor.untilDone(counter);               // job finished
+///     co_await gpu::untilSignaled(executor, fence);       // GPU copy finished
+///     auto file = co_await executor.readFile("cache.bin");
+/// }
+///
+/// executor.spawn(readback(executor, jobs, fence));
+/// executor.waitIdle();
+/// @endcode
+class TaskExecutor {
+public:
+    /// Create the executor and start its threads
+    /// @param config Thread count and poll interval
+    explicit TaskExecutor(const TaskExecutorConfig& config = {});
+
+    /// Stop and join all threads
+    /// @pre waitIdle() returned and no other coroutine is suspended on this executor
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+    TaskExecutor(TaskExecutor&&) = delete;
+    TaskExecutor& operator=(TaskExecutor&&) = delete;
+
+    /// Get the number of resume threads
+    uint32_t getThreadCount() const noexcept { return static_cast<uint32_t>(threads_.size()); }
+
+    /// Check if the calling thread is one of this executor's resume threads
+    bool isExecutorThread() const noexcept;
+
+    /// Awaitable that continues the coroutine on a resume thread
+    auto schedule() noexcept {
+        struct Awaiter {
+            TaskExecutor* executor;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { executor->enqueue(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+    /// Awaitable that suspends until a predicate returns true
+    ///
+    /// The predicate is evaluated once immediately, then on the poll thread. It
+    /// must be cheap and non-blocking. The coroutine resumes on a resume thread.
+    ///
+    /// @param predicate Callable with signature bool()
+    template <typename Predicate>
+    auto pollUntil(Predicate predicate) {
+        struct Awaiter : detail::PollNode {
+            TaskExecutor* executor;
+            Predicate predicate;
+
+            Awaiter(TaskExecutor* exec, Predicate pred)
+                : executor(exec), predicate(std::move(pred)) {
+                poll = [](detail::PollNode& node) {
+                    return static_cast<Awaiter&>(node).predicate();
+                };
+            }
+
+            bool await_ready() { return predicate(); }
+
+            void await_suspend(std::coroutine_handle<> awaiting) {
+                handle = awaiting;
+                executor->addPoll(this);
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter(this, std::move(predicate));
+    }
+
+    /// Awaitable that suspends until a job counter reaches zero
+    ///
+    /// The jobs must be able to run on JobSystem worker threads: with a JobSystem
+    /// whose only worker is the (participating) main thread they only execute
+    /// inside JobSystem::wait().
+    ///
+    /// @param counter Counter to wait on (must outlive the await)
+    auto untilDone(const JobCounter& counter) {
+        return pollUntil([&counter] { return counter.isDone(); });
+    }
+
+    /// Awaitable that reads a whole file on the I/O thread
+    ///
+    /// co_await yields Result<std::vector<uint8_t>>: the file contents, or
+    /// FileNotFound / FileReadFailed.
+    ///
+    /// @param path Path of the file to read
+    auto readFile(std::string path) {
+        struct Awaiter : detail::IoNode {
+            TaskExecutor* executor;
+            std::string path;
+            Result<std::vector<uint8_t>> result;
+
+            Awaiter(TaskExecutor* exec, std::string filePath)
+                : executor(exec), path(std::move(filePath)) {
+                execute = [](detail::IoNode& node) {
+                    auto& self = static_cast<Awaiter&>(node);
+                    self.result = readFileBlocking(self.path);
+                };
+            }
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> awaiting) {
+                handle = awaiting;
+                executor->submitIo(this);
+            }
+
+            Result<std::vector<uint8_t>> await_resume() { return std::move(result); }
+        };
+        return Awaiter(this, std::move(path));
+    }
+
+    /// Run a Task to completion on the executor without waiting for it
+    /// @param task Task to run (its frame is destroyed when it completes)
+    void spawn(Task<void> task);
+
+    /// Block until every spawned Task completed
+    void waitIdle();
+
+    /// Get the number of spawned Tasks that have not completed
+    uint32_t getPendingTaskCount() const noexcept {
+        return pendingTasks_.load(std::memory_order_acquire);
+    }
+
+    /// Read a whole file, blocking the calling thread
+    /// @param path Path of the file to read
+    /// @return File contents, or FileNotFound / FileReadFailed
+    static Result<std::vector<uint8_t>> readFileBlocking(const std::string& path);
+
+private:
+    static detail::DetachedTask runDetached(TaskExecutor* executor, Task<void> task);
+
+    void enqueue(std::coroutine_handle<> handle);
+    void addPoll(detail::PollNode* node);
+    void submitIo(detail::IoNode* node);
+    void onTaskFinished();
+
+    void resumeThreadMain();
+    void pollThreadMain();
+    void ioThreadMain();
+
+    std::chrono::microseconds pollInterval_;
+    std::vector<std::thread> threads_;
+    std::thread pollThread_;
+    std::thread ioThread_;
+    std::atomic<bool> stopping_{false};
+
+    std::mutex readyMutex_;
+    std::condition_variable readyCondition_;
+    std::deque<std::coroutine_handle<>> ready_;
+
+    std::mutex pollMutex_;
+    std::condition_variable pollCondition_;
+    std::vector<detail::PollNode*> newPolls_;
+
+    std::mutex ioMutex_;
+    std::condition_variable ioCondition_;
+    std::deque<detail::IoNode*> ioQueue_;
+
+    std::atomic<uint32_t> pendingTasks_{0};
+    std::mutex idleMutex_;
+    std::condition_variable idleCondition_;
+};
+
+}  // namespace axiom::core
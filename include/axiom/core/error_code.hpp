@@ -53,6 +53,10 @@ enum class ErrorCode {
     InvalidParameter = 600,  ///< Function parameter is invalid
     OutOfRange,              ///< Value is out of valid range
 
+    // IO errors (700-799)
+    FileNotFound = 700,  ///< File does not exist or cannot be opened
+    FileReadFailed,      ///< File could not be read completely
+
     // Add more error codes as needed
 };
 
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace axiom::core {
+
+/// Hardware event counted per profile zone
+enum class HwEvent : uint8_t {
+    Cycles,                ///< Core clock cycles (user space)
+    Instructions,          ///< Retired instructions
+    L1DataMisses,          ///< L1 data cache read misses
+    LastLevelCacheMisses,  ///< Last-level cache read misses (usually DRAM accesses)
+    BranchMisses,          ///< Mispredicted branches
+    Count
+};
+
+/// Number of hardware events
+constexpr size_t HwEventCount = static_cast<size_t>(HwEvent::Count);
+
+/// Convert HwEvent to string representation
+/// @param event The event to convert
+/// @return Human-readable event name
+const char* hwEventToString(HwEvent event) noexcept;
+
+/// Values of the hardware counters (a reading or a delta between two readings)
+struct HwCounterValues {
+    std::array<uint64_t, HwEventCount> values{};  ///< Count per event
+    uint32_t validMask = 0;                       ///< Bit per event that could be counted
+
+    /// Check if an event was counted
+    bool has(HwEvent event) const noexcept {
+        return (validMask & (1u << static_cast<uint32_t>(event))) != 0;
+    }
+
+    /// Get the count of an event (0 if it was not counted)
+    uint64_t get(HwEvent event) const noexcept { return values[static_cast<size_t>(event)]; }
+};
+
+/// Check if the calling thread can count an event
+///
+/// Counters are opened lazily, once per thread, on the first query or read.
+/// They are unavailable on non-Linux platforms, in containers without
+/// perf_event access, or when kernel.perf_event_paranoid forbids it; the
+/// profiler then falls back to timing only.
+///
+/// @param event Event to check
+/// @return true if the event is counted for this thread
+bool isHwEventAvailable(HwEvent event) noexcept;
+
+/// Read the calling thread's counters (user-space events since the thread opened them)
+/// @return Current counter values (validMask is 0 if no counter is available)
+HwCounterValues readThreadHwCounters() noexcept;
+
+/// Handle to a registered hardware counter zone
+using HwZoneId = uint32_t;
+
+/// Returned by registration when the registry is full
+constexpr HwZoneId InvalidHwZoneId = UINT32_MAX;
+
+/// Accumulated counters of one zone
+///
+/// Zones are inclusive: a nested zone's events also count towards its parent.
+struct HwZoneStats {
+    std::string name;          ///< Zone name
+    uint64_t calls = 0;        ///< Number of times the zone was entered
+    uint64_t elements = 0;     ///< Elements processed (from AXIOM_PROFILE_ELEMENTS)
+    uint64_t nanoseconds = 0;  ///< Total wall time
+    HwCounterValues counters;  ///< Total counts (validMask: counted on at least one call)
+
+    /// Instructions per cycle (0 if not counted)
+    double getIpc() const noexcept;
+
+    /// Average count of an event per element, or per call if no elements were reported
+    /// @param event Event to average
+    /// @return Average count (0 if not counted)
+    double getPerElement(HwEvent event) const noexcept;
+
+    /// Total wall time in milliseconds
+    double getMilliseconds() const noexcept { return static_cast<double>(nanoseconds) * 1e-6; }
+};
+
+/// Process-wide accumulation of hardware counters per profile zone
+///
+/// Zones are registered once by static name. HwCounterScope reads the
+/// calling thread's counters on entry and exit and adds the deltas, the wall
+/// time and the element count to the zone. Each worker thread counts only its
+/// own events, so zones executed in parallel report the sum over threads.
+///
+/// Reading the counters costs a system call per scope boundary (roughly a
+/// microsecond), so hardware counting is meant for profiling builds
+/// (AXIOM_ENABLE_HW_COUNTERS) and coarse zones - a broadphase update, a
+/// solver iteration - rather than per-body work.
+///
+/// Example usage:
+/// @code
+/// void Broadphase::update() {
+///     AXIOM_PROFILE_SCOPE("Broadphase::update");
+///     AXIOM_PROFILE_ELEMENTS(proxyCount_);
+///     // ...
+/// }
+///
+/// // On exit
+/// HwCounterRegistry::getInstance().writeText(std::cout);
+/// //   Broadphase::update  calls=600  ms=41.2  IPC=1.84  L1D/elem=3.10  LLC/elem=0.42 ...
+/// @endcode
+class HwCounterRegistry {
+public:
+    /// Maximum number of distinct zones
+    static constexpr size_t MaxZones = 256;
+
+    /// Get the singleton instance
+    static HwCounterRegistry& getInstance() noexcept;
+
+    HwCounterRegistry(const HwCounterRegistry&) = delete;
+    HwCounterRegistry& operator=(const HwCounterRegistry&) = delete;
+    HwCounterRegistry(HwCounterRegistry&&) = delete;
+    HwCounterRegistry& operator=(HwCounterRegistry&&) = delete;
+
+    /// Register (or look up) a zone
+    /// @param name Zone name (copied; registering the same name twice returns the same id)
+    /// @return Zone id, or InvalidHwZoneId if the registry is full
+    HwZoneId registerZone(const char* name);
+
+    /// Add one execution of a zone
+    /// @param id Zone id (InvalidHwZoneId is ignored)
+    /// @param delta Counter deltas over the execution
+    /// @param nanoseconds Wall time of the execution
+    /// @param elements Elements processed
+    void record(HwZoneId id, const HwCounterValues& delta, uint64_t nanoseconds,
+                uint64_t elements) noexcept;
+
+    /// Copy the accumulated statistics of every zone that was entered at least once
+    /// @return Zones sorted by total wall time, longest first
+    std::vector<HwZoneStats> snapshot() const;
+
+    /// Write a human-readable report (one line per zone)
+    /// @param out Output stream to write the report to
+    void writeText(std::ostream& out) const;
+
+    /// Zero all zones (registrations are kept)
+    void reset() noexcept;
+
+private:
+    struct Zone;
+
+    HwCounterRegistry();
+    ~HwCounterRegistry();
+
+    mutable std::mutex mutex_;            ///< Guards registration
+    std::vector<std::string> names_;      ///< Zone names by id
+    std::atomic<uint32_t> zoneCount_{0};  ///< Published zone count
+    std::unique_ptr<Zone[]> zones_;       ///< Accumulators by id
+};
+
+/// RAII scope that attributes the calling thread's counter deltas to a zone
+///
+/// Scopes nest per thread and must not be held across a co_await: a coroutine
+/// resumed on another thread would read the other thread's counters.
+class HwCounterScope {
+public:
+    /// Read the counters and start timing
+    /// @param id Zone to record into on destruction
+    explicit HwCounterScope(HwZoneId id) noexcept;
+
+    /// Read the counters again and record the deltas
+    ~HwCounterScope();
+
+    HwCounterScope(const HwCounterScope&) = delete;
+    HwCounterScope& operator=(const HwCounterScope&) = delete;
+    HwCounterScope(HwCounterScope&&) = delete;
+    HwCounterScope& operator=(HwCounterScope&&) = delete;
+
+    /// Add to the element count of the calling thread's innermost active scope
+    /// @param count Elements processed (ignored if no scope is active)
+    static void addElements(uint64_t count) noexcept;
+
+private:
+    HwZoneId id_;
+    uint64_t elements_ = 0;
+    HwCounterScope* parent_;
+    HwCounterValues start_;
+    std::chrono::steady_clock::time_point startTime_;
+};
+
+}  // namespace axiom::core
+
+//=============================================================================
+// Hardware Counter Macros
+//=============================================================================
+
+// Used by AXIOM_PROFILE_SCOPE / AXIOM_PROFILE_FUNCTION / AXIOM_PROFILE_ELEMENTS
+// in profiler.hpp; prefer those in engine code.
+
+#define AXIOM_HW_COUNTER_CONCAT_IMPL(a, b) a##b
+#define AXIOM_HW_COUNTER_CONCAT(a, b) AXIOM_HW_COUNTER_CONCAT_IMPL(a, b)
+
+#ifdef AXIOM_ENABLE_HW_COUNTERS
+
+/// Attribute hardware counters of the enclosing scope to the zone @p name
+#define AXIOM_HW_COUNTER_SCOPE(name)                                                               \
+    static const ::axiom::core::HwZoneId AXIOM_HW_COUNTER_CONCAT(axiomHwZoneId_, __LINE__) =       \
+        ::axiom::core::HwCounterRegistry::getInstance().registerZone(name);                        \
+    const ::axiom::core::HwCounterScope AXIOM_HW_COUNTER_CONCAT(axiomHwScope_, __LINE__)(          \
+        AXIOM_HW_COUNTER_CONCAT(axiomHwZoneId_, __LINE__))
+
+/// Add to the element count of the innermost hardware counter scope
+#define AXIOM_HW_COUNTER_ELEMENTS(count)                                                           \
+    ::axiom::core::HwCounterScope::addElements(static_cast<uint64_t>(count))
+
+#else  // AXIOM_ENABLE_HW_COUNTERS not defined
+
+/// @brief No-op when hardware counters are disabled
+#define AXIOM_HW_COUNTER_SCOPE(name) ((void)0)
+
+/// @brief No-op when hardware counters are disabled
+#define AXIOM_HW_COUNTER_ELEMENTS(count) ((void)0)
+
+#endif  // AXIOM_ENABLE_HW_COUNTERS
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+#include "axiom/core/work_stealing_deque.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace axiom::memory {
+class FrameAllocator;
+}  // namespace axiom::memory
+
+namespace axiom::core {
+
+class JobSystem;
+
+/// Configuration for JobSystem
+struct JobSystemConfig {
+    /// Total number of workers, including the main thread when it participates
+    /// (0 = one worker per hardware thread)
+    uint32_t workerCount = 0;
+
+    /// If true, the constructing thread is worker 0: it owns a deque and scratch
+    /// memory and executes jobs while blocked in wait(). If false, all workers are
+    /// background threads and the constructing thread only submits and waits.
+    bool mainThreadParticipates = true;
+
+    /// Capacity of each worker's FrameAllocator scratch (split between two frames)
+    size_t scratchBytesPerWorker = 2 * 1024 * 1024;
+};
+
+/// Fork/join counter
+///
+/// Incremented for every job submitted with it and decremented when that job
+/// finishes. JobSystem::wait() returns once it reaches zero. A counter can be
+/// reused after it has been waited on.
+class JobCounter {
+public:
+    JobCounter() = default;
+    ~JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+    JobCounter(JobCounter&&) = delete;
+    JobCounter& operator=(JobCounter&&) = delete;
+
+    /// Check if all jobs submitted with this counter have finished
+    bool isDone() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+    /// Get the number of unfinished jobs
+    uint32_t getPending() const noexcept { return pending_.load(std::memory_order_acquire); }
+
+    /// Add pending work that is not (yet) a submitted job
+    ///
+    /// Lets wait() cover work that is scheduled later, e.g. task graph nodes
+    /// whose dependencies have not been satisfied. Balance each unit with release().
+    ///
+    /// @param count Number of work units to add
+    void add(uint32_t count = 1) noexcept { pending_.fetch_add(count, std::memory_order_relaxed); }
+
+    /// Mark one unit of work added with add() as finished
+    void release() noexcept { pending_.fetch_sub(1, std::memory_order_release); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> pending_{0};
+};
+
+namespace detail {
+
+/// Type-erased job (two cache lines, functor stored inline)
+struct alignas(CacheLineSize) Job {
+    /// Bytes available for the job's functor
+    static constexpr size_t StorageSize = 96;
+
+    void (*invoke)(Job& job) = nullptr;  ///< Runs and destroys the stored functor
+    JobCounter* counter = nullptr;       ///< Counter to decrement on completion
+    Job* next = nullptr;                 ///< Free-list link
+    uint32_t owner = 0;                  ///< Index of the job pool this job belongs to
+    alignas(16) unsigned char storage[StorageSize];
+};
+
+static_assert(sizeof(Job) == 128, "Job should occupy exactly two cache lines");
+
+}  // namespace detail
+
+/// Work-stealing job system
+///
+/// Runs one worker per hardware thread. Each worker owns a Chase-Lev deque:
+/// it pushes and pops its own jobs LIFO and steals FIFO from random victims
+/// when it runs dry. Jobs submitted from threads that are not workers go to a
+/// shared injection queue. Idle workers spin briefly, then sleep until new work
+/// is submitted.
+///
+/// Job storage comes from per-worker pools (no heap allocation after warm-up);
+/// a job finished on another thread is returned to its owner's pool through a
+/// lock-free list. Each worker also owns a FrameAllocator for per-frame scratch
+/// memory (see getScratchAllocator()).
+///
+/// Jobs must not throw. Functors larger than detail::Job::StorageSize bytes are
+/// rejected at compile time - capture large state by pointer or reference.
+///
+/// Example usage:
+/// @code
+/// JobSystem jobs;  // one worker per core, main thread participates
+///
+/// // Fork/join
+/// JobCounter counter;
+/// jobs.run(counter, [&] { updateAABBs(); });
+/// jobs.run(counter, [&] { integrateParticles(); });
+/// jobs.wait(counter);  // main thread executes jobs while waiting
+///
+/// // Data-parallel loop, automatically chunked
+/// jobs.parallelFor(bodyCount, 0, [&](uint32_t begin, uint32_t end) {
+///     for (uint32_t i = begin; i < end; ++i) {
+///         integrate(bodies[i], dt);
+///     }
+/// });
+///
+/// // Once per frame, when no jobs are in flight
+/// jobs.flipScratchAllocators();
+/// @endcode
+class JobSystem {
+public:
+    /// Worker index returned for threads that do not belong to this job system
+    static constexpr uint32_t InvalidWorkerIndex = UINT32_MAX;
+
+    /// Create the job system and start its worker threads
+    /// @param config Worker count, main-thread participation and scratch size
+    explicit JobSystem(const JobSystemConfig& config = {});
+
+    /// Stop and join all worker threads
+    /// @pre Every counter used with this system has been waited on
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    /// Get the total number of workers (including the main thread if it participates)
+    uint32_t getWorkerCount() const noexcept { return static_cast<uint32_t>(workers_.size()); }
+
+    /// Get the worker index of the calling thread
+    /// @return Index in [0, getWorkerCount()), or InvalidWorkerIndex for other threads
+    uint32_t getCurrentWorkerIndex() const noexcept;
+
+    /// Submit a job
+    /// @param counter Counter incremented now and decremented when the job finishes
+    /// @param fn Callable with signature void() (moved into inline job storage)
+    template <typename Fn>
+    void run(JobCounter& counter, Fn&& fn) {
+        using F = std::decay_t<Fn>;
+        static_assert(sizeof(F) <= detail::Job::StorageSize,
+                      "Job functor too large - capture by reference or pointer");
+        static_assert(alignof(F) <= 16, "Job functor alignment too large");
+
+        detail::Job* job = allocateJob();
+        new (static_cast<void*>(job->storage)) F(std::forward<Fn>(fn));
+        job->invoke = &invokeJob<F>;
+        job->counter = &counter;
+        counter.pending_.fetch_add(1, std::memory_order_relaxed);
+        submit(job);
+    }
+
+    /// Block until a counter reaches zero
+    ///
+    /// Worker threads (including a participating main thread) execute other
+    /// jobs while waiting, so nested fork/join never deadlocks. Other threads
+    /// yield until the counter is done.
+    ///
+    /// @param counter Counter to wait on
+    void wait(JobCounter& counter);
+
+    /// Run fn over [0, count) in parallel and wait for completion
+    ///
+    /// The range is split recursively in halves; each split pushes the upper half
+    /// as a stealable job and continues with the lower half, until a chunk is no
+    /// larger than the grain size. The calling thread processes the first chunk.
+    ///
+    /// @param count Number of elements
+    /// @param grainSize Largest chunk passed to fn (0 = automatic, ~8 chunks per worker)
+    /// @param fn Callable with signature void(uint32_t begin, uint32_t end)
+    template <typename Fn>
+    void parallelFor(uint32_t count, uint32_t grainSize, Fn&& fn) {
+        if (count == 0) {
+            return;
+        }
+
+        const uint32_t grain = grainSize > 0 ? grainSize : getAutoGrainSize(count);
+        if (count <= grain) {
+            fn(uint32_t{0}, count);
+            return;
+        }
+
+        JobCounter counter;
+        ParallelForRange<std::remove_reference_t<Fn>> range{this, &fn, &counter, grain};
+        range.execute(0, count);
+        wait(counter);
+    }
+
+    /// Get the calling worker's scratch allocator
+    ///
+    /// Memory stays valid until the second flipScratchAllocators() call after the
+    /// allocation, i.e. for the rest of the current frame and the next one.
+    ///
+    /// @return FrameAllocator owned by the calling worker
+    /// @pre The calling thread is a worker of this job system
+    memory::FrameAllocator& getScratchAllocator();
+
+    /// Flip every worker's scratch allocator (once per frame, while no jobs are running)
+    void flipScratchAllocators();
+
+    /// Compute the automatic grain size for a parallelFor over count elements
+    uint32_t getAutoGrainSize(uint32_t count) const noexcept;
+
+private:
+    struct Worker;
+    struct JobPool;
+
+    /// Recursive splitter used by parallelFor (lives on the caller's stack)
+    template <typename Fn>
+    struct ParallelForRange {
+        JobSystem* system;
+        Fn* fn;
+        JobCounter* counter;
+        uint32_t grain;
+
+        void execute(uint32_t begin, uint32_t end) const {
+            while (end - begin > grain) {
+                const uint32_t mid = begin + (end - begin) / 2;
+                system->run(*counter, [this, mid, end] { execute(mid, end); });
+                end = mid;
+            }
+            (*fn)(begin, end);
+        }
+    };
+
+    template <typename F>
+    static void invokeJob(detail::Job& job) {
+        F* fn = std::launder(static_cast<F*>(static_cast<void*>(job.storage)));
+        (*fn)();
+        fn->~F();
+    }
+
+    detail::Job* allocateJob();
+    void releaseJob(detail::Job* job);
+    void submit(detail::Job* job);
+    void execute(detail::Job* job);
+    bool tryRunOne(uint32_t workerIndex);
+    bool trySteal(uint32_t workerIndex, detail::Job*& out);
+    bool tryPopInjected(detail::Job*& out);
+    void workerMain(uint32_t workerIndex);
+    void sleepUntilWork();
+    void wakeWorkers();
+
+    std::vector<std::unique_ptr<Worker>> workers_;  ///< Worker state, index = worker index
+    uint32_t firstThreadWorker_ = 0;                ///< 1 if worker 0 is the main thread
+
+    std::unique_ptr<JobPool> externalPool_;  ///< Jobs submitted from non-worker threads
+    std::deque<detail::Job*> injected_;      ///< Jobs submitted from non-worker threads
+    std::mutex externalMutex_;               ///< Guards externalPool_ and injected_
+    std::atomic<size_t> injectedCount_{0};   ///< Size of injected_ (read without the lock)
+
+    alignas(CacheLineSize) std::atomic<int64_t> queuedJobs_{0};  ///< Jobs queued but not yet taken
+    std::atomic<uint32_t> sleepingWorkers_{0};        ///< Workers blocked in sleepUntilWork()
+    std::atomic<bool> stopping_{false};               ///< Set by the destructor
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+};
+
+}  // namespace axiom::core
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace axiom::core {
+
+/// Kind of a registered metric
+enum class MetricKind : uint8_t {
+    Counter,   ///< Monotonically increasing sum (e.g. pairs tested, allocations)
+    Gauge,     ///< Last written value (e.g. body count, memory in use)
+    Histogram  ///< Distribution of sampled values with percentile queries (e.g. step time)
+};
+
+/// Convert MetricKind to string representation
+/// @param kind The metric kind to convert
+/// @return Lower-case name of the kind ("counter", "gauge", "histogram")
+const char* metricKindToString(MetricKind kind) noexcept;
+
+/// Handle to a registered metric (index into the registry)
+using MetricId = uint32_t;
+
+/// Returned by registration when the registry is full or a name is reused with another kind
+constexpr MetricId InvalidMetricId = UINT32_MAX;
+
+/// Well-known metric names shared between the physics pipeline and the debug GUI
+namespace metric_names {
+constexpr const char* StepTime = "Physics.StepTime";                ///< Histogram, milliseconds
+constexpr const char* BroadphaseTime = "Physics.BroadphaseTime";    ///< Histogram, milliseconds
+constexpr const char* NarrowphaseTime = "Physics.NarrowphaseTime";  ///< Histogram, milliseconds
+constexpr const char* SolverTime = "Physics.SolverTime";            ///< Histogram, milliseconds
+constexpr const char* IntegrationTime = "Physics.IntegrationTime";  ///< Histogram, milliseconds
+constexpr const char* BroadphasePairs = "BroadphasePairs";          ///< Histogram, pair count
+}  // namespace metric_names
+
+/// Merged view of a histogram at the time of a snapshot
+///
+/// Buckets are log-linear (HDR-style): every power of two is split into
+/// HistogramSubBuckets linear sub-buckets, which bounds the relative error of
+/// any percentile to about 3% independently of magnitude. count/sum/min/max
+/// are exact.
+struct HistogramSnapshot {
+    uint64_t count = 0;             ///< Number of recorded samples
+    double sum = 0.0;               ///< Sum of all samples
+    double min = 0.0;               ///< Smallest recorded sample (0 if empty)
+    double max = 0.0;               ///< Largest recorded sample (0 if empty)
+    std::vector<uint64_t> buckets;  ///< Per-bucket sample counts (empty if count == 0)
+
+    /// Number of linear sub-buckets per power of two
+    static constexpr size_t SubBuckets = 16;
+
+    /// Smallest binary exponent that gets its own buckets (2^-17 ~ 7.6e-6)
+    static constexpr int MinExponent = -16;
+
+    /// Largest binary exponent that gets its own buckets (2^48 ~ 2.8e14)
+    static constexpr int MaxExponent = 48;
+
+    /// Total number of buckets
+    static constexpr size_t BucketCount =
+        static_cast<size_t>(MaxExponent - MinExponent + 1) * SubBuckets;
+
+    /// Map a sample to its bucket index (values below range land in bucket 0)
+    /// @param value Sample value
+    /// @return Bucket index in [0, BucketCount)
+    static size_t bucketIndex(double value) noexcept;
+
+    /// Get the representative (mid-point) value of a bucket
+    /// @param index Bucket index
+    /// @return Value in the middle of the bucket's range
+    static double bucketValue(size_t index) noexcept;
+
+    /// Mean of all samples
+    /// @return sum / count, or 0 if empty
+    double mean() const noexcept;
+
+    /// Query a percentile
+    /// @param p Fraction in [0, 1] (0.5 = median, 0.99 = p99)
+    /// @return Approximate value below which the fraction p of samples fall (exact for 0 and 1)
+    double percentile(double p) const noexcept;
+
+    /// Median
+    double p50() const noexcept { return percentile(0.50); }
+
+    /// 95th percentile
+    double p95() const noexcept { return percentile(0.95); }
+
+    /// 99th percentile
+    double p99() const noexcept { return percentile(0.99); }
+
+    /// Merge another histogram into this one (e.g. to combine runs or processes)
+    /// @param other Histogram to accumulate
+    void merge(const HistogramSnapshot& other);
+};
+
+/// Value of a single metric at the time of a snapshot
+struct MetricSample {
+    std::string name;                        ///< Registered name
+    MetricKind kind = MetricKind::Counter;   ///< Metric kind
+    uint64_t counter = 0;                    ///< Counter total (Counter only)
+    double gauge = 0.0;                      ///< Last written value (Gauge only)
+    HistogramSnapshot histogram;             ///< Merged distribution (Histogram only)
+};
+
+/// Point-in-time copy of every registered metric, merged across all threads
+class MetricsSnapshot {
+public:
+    /// Find a metric by name
+    /// @param name Registered metric name
+    /// @return Pointer to the sample, or nullptr if no such metric exists
+    const MetricSample* find(const char* name) const noexcept;
+
+    /// Find a histogram by name
+    /// @param name Registered metric name
+    /// @return Pointer to the histogram, or nullptr if missing or not a histogram
+    const HistogramSnapshot* findHistogram(const char* name) const noexcept;
+
+    /// Write a human-readable report (one line per metric)
+    /// @param out Output stream to write the report to
+    void writeText(std::ostream& out) const;
+
+    /// Write the snapshot as a JSON object keyed by metric name
+    /// @param out Output stream to write the JSON document to
+    void writeJson(std::ostream& out) const;
+
+    /// All metrics in registration order
+    const std::vector<MetricSample>& metrics() const noexcept { return metrics_; }
+
+private:
+    friend class MetricsRegistry;
+
+    std::vector<MetricSample> metrics_;
+};
+
+/// Process-wide registry of counters, gauges and histograms
+///
+/// Metrics are registered once by static name and then updated through the
+/// returned MetricId. Counter and histogram updates go to a per-thread shard
+/// that only its owning thread writes, so the hot path is a handful of relaxed
+/// loads and stores with no locks and no shared cache lines. snapshot() merges
+/// all shards on demand; it may run concurrently with updates and sees every
+/// update that happened-before it. Gauges hold a single "last value" and are
+/// stored centrally.
+///
+/// Shards of exited threads are kept (their totals remain part of every
+/// snapshot) and are handed to the next thread that starts recording.
+///
+/// Example usage:
+/// @code
+/// // Hot path - registration happens once per call site
+/// AXIOM_METRIC_HISTOGRAM(metric_names::StepTime, stepMs);
+/// AXIOM_METRIC_COUNTER("Narrowphase.GJKCalls", gjkCalls);
+///
+/// // Periodically (e.g. once per second or on exit)
+/// MetricsSnapshot snap = MetricsRegistry::getInstance().snapshot();
+/// if (const HistogramSnapshot* h = snap.findHistogram(metric_names::StepTime)) {
+///     AXIOM_LOG_INFO("Physics", "step p99 = %.3f ms", h->p99());
+/// }
+/// snap.writeJson(file);
+/// @endcode
+class MetricsRegistry {
+public:
+    /// Maximum number of distinct metrics
+    static constexpr size_t MaxMetrics = 256;
+
+    /// Get the singleton instance
+    /// @return Reference to the global metrics registry
+    static MetricsRegistry& getInstance() noexcept;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    MetricsRegistry(MetricsRegistry&&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+    /// Register (or look up) a metric
+    /// @param name Metric name (copied; registering the same name twice returns the same id)
+    /// @param kind Metric kind
+    /// @return Metric id, or InvalidMetricId if the registry is full or the name has another kind
+    MetricId registerMetric(const char* name, MetricKind kind);
+
+    /// Register (or look up) a counter
+    MetricId registerCounter(const char* name) { return registerMetric(name, MetricKind::Counter); }
+
+    /// Register (or look up) a gauge
+    MetricId registerGauge(const char* name) { return registerMetric(name, MetricKind::Gauge); }
+
+    /// Register (or look up) a histogram
+    MetricId registerHistogram(const char* name) {
+        return registerMetric(name, MetricKind::Histogram);
+    }
+
+    /// Get the number of registered metrics
+    size_t getMetricCount() const noexcept;
+
+    /// Add to a counter
+    /// @param id Counter id (InvalidMetricId is ignored)
+    /// @param delta Amount to add
+    void add(MetricId id, uint64_t delta = 1) noexcept;
+
+    /// Set a gauge
+    /// @param id Gauge id (InvalidMetricId is ignored)
+    /// @param value New value
+    void set(MetricId id, double value) noexcept;
+
+    /// Record a histogram sample
+    /// @param id Histogram id (InvalidMetricId is ignored)
+    /// @param value Sample value
+    void record(MetricId id, double value) noexcept;
+
+    /// Merge all thread shards into a snapshot
+    /// @return Snapshot of every registered metric
+    MetricsSnapshot snapshot() const;
+
+    /// Zero all counters, gauges and histograms (registrations are kept)
+    /// @note Updates racing with reset() may survive it
+    void reset() noexcept;
+
+private:
+    struct HistogramShard;
+    struct Shard;
+    struct ShardLease;
+
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    Shard& localShard() noexcept;
+    Shard* acquireShard();
+    void releaseShard(Shard* shard) noexcept;
+    HistogramShard& localHistogram(Shard& shard, MetricId id) noexcept;
+
+    mutable std::mutex mutex_;                      ///< Guards registration and shard list
+    std::vector<std::string> names_;                ///< Metric names by id
+    std::vector<MetricKind> kinds_;                 ///< Metric kinds by id
+    std::atomic<uint32_t> metricCount_{0};          ///< Published metric count
+    std::unique_ptr<std::atomic<double>[]> gauges_;  ///< Gauge values by id
+    std::vector<std::unique_ptr<Shard>> shards_;    ///< All shards ever created
+};
+
+/// RAII timer that records its lifetime in milliseconds into a histogram
+class ScopedMetricTimer {
+public:
+    /// Start timing
+    /// @param id Histogram id to record into on destruction
+    explicit ScopedMetricTimer(MetricId id) noexcept
+        : id_(id), start_(std::chrono::steady_clock::now()) {}
+
+    /// Stop timing and record the elapsed time
+    ~ScopedMetricTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        MetricsRegistry::getInstance().record(
+            id_, std::chrono::duration<double, std::milli>(elapsed).count());
+    }
+
+    ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+    ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+    ScopedMetricTimer(ScopedMetricTimer&&) = delete;
+    ScopedMetricTimer& operator=(ScopedMetricTimer&&) = delete;
+
+private:
+    MetricId id_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace axiom::core
+
+//=============================================================================
+// Metric Macros
+//=============================================================================
+
+// Each call site registers its metric once (function-local static) and then
+// only performs the shard update. Names must be string literals or otherwise
+// outlive the first call.
+
+#define AXIOM_METRIC_CONCAT_IMPL(a, b) a##b
+#define AXIOM_METRIC_CONCAT(a, b) AXIOM_METRIC_CONCAT_IMPL(a, b)
+
+#ifdef AXIOM_ENABLE_METRICS
+
+/// Add to a named counter
+/// @param name Counter name (string literal)
+/// @param delta Amount to add (converted to uint64_t)
+#define AXIOM_METRIC_COUNTER(name, delta)                                                          \
+    do {                                                                                           \
+        static const ::axiom::core::MetricId axiomMetricId_ =                                      \
+            ::axiom::core::MetricsRegistry::getInstance().registerCounter(name);                   \
+        ::axiom::core::MetricsRegistry::getInstance().add(axiomMetricId_,                          \
+                                                          static_cast<uint64_t>(delta));           \
+    } while (false)
+
+/// Set a named gauge
+/// @param name Gauge name (string literal)
+/// @param val New value (converted to double)
+#define AXIOM_METRIC_GAUGE(name, val)                                                              \
+    do {                                                                                           \
+        static const ::axiom::core::MetricId axiomMetricId_ =                                      \
+            ::axiom::core::MetricsRegistry::getInstance().registerGauge(name);                     \
+        ::axiom::core::MetricsRegistry::getInstance().set(axiomMetricId_,                          \
+                                                          static_cast<double>(val));               \
+    } while (false)
+
+/// Record a sample into a named histogram
+/// @param name Histogram name (string literal)
+/// @param val Sample value (converted to double)
+#define AXIOM_METRIC_HISTOGRAM(name, val)                                                          \
+    do {                                                                                           \
+        static const ::axiom::core::MetricId axiomMetricId_ =                                      \
+            ::axiom::core::MetricsRegistry::getInstance().registerHistogram(name);                 \
+        ::axiom::core::MetricsRegistry::getInstance().record(axiomMetricId_,                       \
+                                                             static_cast<double>(val));            \
+    } while (false)
+
+/// Record the duration of the enclosing scope (milliseconds) into a named histogram
+/// @param name Histogram name (string literal)
+#define AXIOM_METRIC_SCOPE_TIMER(name)                                                             \
+    static const ::axiom::core::MetricId AXIOM_METRIC_CONCAT(axiomMetricTimerId_, __LINE__) =      \
+        ::axiom::core::MetricsRegistry::getInstance().registerHistogram(name);                     \
+    const ::axiom::core::ScopedMetricTimer AXIOM_METRIC_CONCAT(axiomMetricTimer_, __LINE__)(       \
+        AXIOM_METRIC_CONCAT(axiomMetricTimerId_, __LINE__))
+
+#else  // AXIOM_ENABLE_METRICS not defined
+
+/// @brief No-op when metrics are disabled
+#define AXIOM_METRIC_COUNTER(name, delta) ((void)0)
+
+/// @brief No-op when metrics are disabled
+#define AXIOM_METRIC_GAUGE(name, val) ((void)0)
+
+/// @brief No-op when metrics are disabled
+#define AXIOM_METRIC_HISTOGRAM(name, val) ((void)0)
+
+/// @brief No-op when metrics are disabled
+#define AXIOM_METRIC_SCOPE_TIMER(name) ((void)0)
+
+#endif  // AXIOM_ENABLE_METRICS
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace axiom::core {
+
+/// Bounded multi-producer / multi-consumer queue
+///
+/// Dmitry Vyukov's bounded MPMC queue: every slot carries a sequence number
+/// telling producers and consumers whose turn it is, so a push or pop costs a
+/// single CAS on the shared position plus one release store on the slot.
+/// There is no ABA problem and no per-element allocation. The queue is
+/// lock-free but not wait-free: a producer preempted between claiming a slot
+/// and publishing it makes tryPop() report empty until it resumes.
+///
+/// Example usage:
+/// @code
+/// MpmcQueue<uint32_t> dirtyBodies(1024);
+///
+/// // Any thread
+/// while (!dirtyBodies.tryPush(bodyIndex)) { cpuRelax(); }
+///
+/// // Any thread
+/// uint32_t index = 0;
+/// while (dirtyBodies.tryPop(index)) { refit(index); }
+/// @endcode
+///
+/// @tparam T Element type (default constructible and move assignable)
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_default_constructible_v<T>, "MpmcQueue requires default constructible T");
+    static_assert(std::is_move_assignable_v<T>, "MpmcQueue requires move assignable T");
+
+public:
+    /// Create a queue
+    /// @param capacity Maximum number of elements (rounded up to a power of two, at least 2)
+    explicit MpmcQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        cells_ = std::make_unique<Cell[]>(rounded);
+        for (size_t i = 0; i < rounded; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    MpmcQueue(MpmcQueue&&) = delete;
+    MpmcQueue& operator=(MpmcQueue&&) = delete;
+
+    /// Push an element (any thread)
+    /// @param value Element to push
+    /// @return false if the queue is full (value is left untouched)
+    template <typename U>
+    bool tryPush(U&& value) {
+        Cell* cell = nullptr;
+        size_t position = enqueuePosition_->load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[position & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition_->compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;  // The slot still holds an element from the previous lap
+            } else {
+                position = enqueuePosition_->load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::forward<U>(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop the oldest element (any thread)
+    /// @param out Receives the element
+    /// @return false if the queue is empty
+    bool tryPop(T& out) {
+        Cell* cell = nullptr;
+        size_t position = dequeuePosition_->load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells_[position & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition_->compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;  // The producer of this slot has not published yet
+            } else {
+                position = dequeuePosition_->load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->data);
+        cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Get the number of queued elements (approximate while other threads are active)
+    size_t getSizeApprox() const noexcept {
+        const size_t dequeued = dequeuePosition_->load(std::memory_order_relaxed);
+        const size_t enqueued = enqueuePosition_->load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    /// Get the maximum number of elements
+    size_t getCapacity() const noexcept { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+
+    PaddedAtomic<size_t> enqueuePosition_;
+    PaddedAtomic<size_t> dequeuePosition_;
+    size_t mask_ = 0;
+    std::unique_ptr<Cell[]> cells_;
+};
+
+}  // namespace axiom::core
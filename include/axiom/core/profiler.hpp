@@ -29,9 +29,25 @@
  * cmake --build build/windows-relwithdebinfo
  * @endcode
  *
+ * When AXIOM_ENABLE_METRICS is defined, AXIOM_PROFILE_VALUE additionally records
+ * every sample into a MetricsRegistry histogram of the same name, so percentiles
+ * remain available for long runs and for builds without Tracy.
+ *
+ * When AXIOM_ENABLE_HW_COUNTERS is defined (Linux only), AXIOM_PROFILE_SCOPE and
+ * AXIOM_PROFILE_FUNCTION also read the calling thread's hardware performance
+ * counters (cycles, instructions, L1D/LLC misses, branch misses) on entry and
+ * exit and attribute the deltas to the zone. Combined with AXIOM_PROFILE_ELEMENTS
+ * this reports IPC and misses per element; without counter access it degrades to
+ * timing only.
+ *
  * @see https://github.com/wolfpld/tracy
+ * @see axiom/core/metrics.hpp
+ * @see axiom/core/hw_counters.hpp
  */
 
+#include "axiom/core/hw_counters.hpp"
+#include "axiom/core/metrics.hpp"
+
 #ifdef AXIOM_ENABLE_PROFILING
 
 // Include Tracy Profiler headers
@@ -60,7 +76,9 @@
  * }
  * @endcode
  */
-#define AXIOM_PROFILE_SCOPE(name) ZoneScopedN(name)
+#define AXIOM_PROFILE_SCOPE(name)                                                                  \
+    ZoneScopedN(name);                                                                             \
+    AXIOM_HW_COUNTER_SCOPE(name)
 
 /**
  * @brief Profile the current function
@@ -76,7 +94,20 @@
  * }
  * @endcode
  */
-#define AXIOM_PROFILE_FUNCTION() ZoneScoped
+#define AXIOM_PROFILE_FUNCTION()                                                                   \
+    ZoneScoped;                                                                                    \
+    AXIOM_HW_COUNTER_SCOPE(__func__)
+
+/**
+ * @brief Name the calling thread in the profiler timeline
+ * @param name Thread name (must outlive the thread, e.g. a string literal or member string)
+ *
+ * Example:
+ * @code
+ * AXIOM_PROFILE_THREAD_NAME("Physics Worker");
+ * @endcode
+ */
+#define AXIOM_PROFILE_THREAD_NAME(name) tracy::SetThreadName(name)
 
 /**
  * @brief Add a text annotation to the current profiling zone
@@ -100,6 +131,7 @@
  *
  * Creates a time-series plot in Tracy that can be visualized
  * alongside timing data. Useful for tracking counters, memory usage, etc.
+ * The sample is also recorded into the metrics histogram @p name.
  *
  * Example:
  * @code
@@ -107,7 +139,11 @@
  * AXIOM_PROFILE_VALUE("MemoryUsage", allocatedBytes);
  * @endcode
  */
-#define AXIOM_PROFILE_VALUE(name, val) TracyPlot(name, val)
+#define AXIOM_PROFILE_VALUE(name, val)                                                             \
+    do {                                                                                           \
+        TracyPlot(name, val);                                                                      \
+        AXIOM_METRIC_HISTOGRAM(name, val);                                                         \
+    } while (false)
 
 /**
  * @brief Profile a GPU zone (Vulkan)
@@ -172,17 +208,20 @@
 /// @brief No-op when profiling disabled
 #define AXIOM_PROFILE_FRAME() ((void)0)
 
-/// @brief No-op when profiling disabled
-#define AXIOM_PROFILE_SCOPE(name) ((void)0)
+/// @brief Hardware counter zone only (no-op when hardware counters are also disabled)
+#define AXIOM_PROFILE_SCOPE(name) AXIOM_HW_COUNTER_SCOPE(name)
+
+/// @brief Hardware counter zone only (no-op when hardware counters are also disabled)
+#define AXIOM_PROFILE_FUNCTION() AXIOM_HW_COUNTER_SCOPE(__func__)
 
 /// @brief No-op when profiling disabled
-#define AXIOM_PROFILE_FUNCTION() ((void)0)
+#define AXIOM_PROFILE_THREAD_NAME(name) ((void)0)
 
 /// @brief No-op when profiling disabled
 #define AXIOM_PROFILE_TAG(name, val) ((void)0)
 
-/// @brief No-op when profiling disabled
-#define AXIOM_PROFILE_VALUE(name, val) ((void)0)
+/// @brief Records into the metrics histogram @p name (no-op when metrics are also disabled)
+#define AXIOM_PROFILE_VALUE(name, val) AXIOM_METRIC_HISTOGRAM(name, val)
 
 /// @brief No-op when profiling disabled
 #define AXIOM_PROFILE_GPU_ZONE(ctx, name) ((void)0)
@@ -197,3 +236,19 @@
 #define AXIOM_PROFILE_FREE(ptr) ((void)0)
 
 #endif  // AXIOM_ENABLE_PROFILING
+
+/**
+ * @brief Report the number of elements processed by the innermost profile zone
+ * @param count Element count (bodies, pairs, contacts, ...)
+ *
+ * Used by the hardware counter report to normalize misses per element, which
+ * makes layout changes comparable across scene sizes. No-op unless
+ * AXIOM_ENABLE_HW_COUNTERS is defined.
+ *
+ * Example:
+ * @code
+ * AXIOM_PROFILE_SCOPE("Integrate");
+ * AXIOM_PROFILE_ELEMENTS(bodies.size());
+ * @endcode
+ */
+#define AXIOM_PROFILE_ELEMENTS(count) AXIOM_HW_COUNTER_ELEMENTS(count)
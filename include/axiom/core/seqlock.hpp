@@ -0,0 +1,108 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace axiom::core {
+
+/// Sequence lock protecting a small, trivially copyable value
+///
+/// One writer publishes snapshots; any number of readers copy the latest one
+/// without ever blocking the writer. The sequence is odd while a write is in
+/// progress and readers retry if it was odd or changed during their copy.
+/// This suits double-buffered state handed between threads every frame, such
+/// as the physics thread publishing body transforms for the render thread.
+///
+/// The payload is stored as relaxed atomic words rather than as a plain T, so
+/// the racy copy a reader may discard is still well defined under the C++
+/// memory model (and invisible to ThreadSanitizer).
+///
+/// Example usage:
+/// @code
+/// SeqLock<CameraState> camera;
+///
+/// // Physics thread
+/// camera.store(state);
+///
+/// // Render thread
+/// CameraState latest = camera.load();
+/// @endcode
+///
+/// @tparam T Value type (trivially copyable; keep it small, readers retry the whole copy)
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires trivially copyable T");
+    static_assert(std::is_default_constructible_v<T>, "SeqLock requires default constructible T");
+
+public:
+    SeqLock() { writeWords(T{}); }
+
+    explicit SeqLock(const T& value) { writeWords(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /// Publish a new value (one writer at a time; serialize writers externally)
+    /// @param value Value to publish
+    void store(const T& value) noexcept {
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        writeWords(value);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// Try to copy the value once
+    /// @param out Receives the value on success
+    /// @return false if a write was in progress (out is unspecified)
+    bool tryLoad(T& out) const noexcept {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        readWords(out);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+    /// Copy the value, spinning while a write is in progress
+    T load() const noexcept {
+        T value;
+        while (!tryLoad(value)) {
+            cpuRelax();
+        }
+        return value;
+    }
+
+    /// Get the number of completed stores
+    uint64_t getVersion() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void writeWords(const T& value) noexcept {
+        uint64_t words[WordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < WordCount; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    void readWords(T& value) const noexcept {
+        uint64_t words[WordCount];
+        for (size_t i = 0; i < WordCount; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&value, words, sizeof(T));
+    }
+
+    alignas(CacheLineSize) std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[WordCount];
+};
+
+}  // namespace axiom::core
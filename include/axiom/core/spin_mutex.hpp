@@ -0,0 +1,97 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace axiom::core {
+
+/// Mutex that spins briefly before parking the thread
+///
+/// Uncontended lock/unlock is a single atomic each. Under contention the
+/// thread first spins (critical sections in the engine are usually a few
+/// hundred cycles, much less than a context switch), then parks on the lock
+/// word with std::atomic::wait (a futex on Linux) instead of burning a core.
+/// unlock() only issues a wake-up when a thread is actually parked.
+///
+/// Satisfies the standard Lockable requirements, so it works with
+/// std::lock_guard, std::unique_lock and std::scoped_lock.
+///
+/// Example usage:
+/// @code
+/// SpinMutex mutex;
+/// {
+///     std::lock_guard<SpinMutex> lock(mutex);
+///     islands.push_back(island);
+/// }
+/// @endcode
+class SpinMutex {
+public:
+    /// Spin iterations before parking
+    static constexpr uint32_t DefaultSpinCount = 128;
+
+    /// Create an unlocked mutex
+    /// @param spinCount Spin iterations before parking (0 = park immediately)
+    explicit SpinMutex(uint32_t spinCount = DefaultSpinCount) noexcept : spinCount_(spinCount) {}
+
+    SpinMutex(const SpinMutex&) = delete;
+    SpinMutex& operator=(const SpinMutex&) = delete;
+
+    /// Acquire the mutex, spinning and then parking while it is held
+    void lock() noexcept {
+        uint32_t expected = Unlocked;
+        if (state_.compare_exchange_strong(expected, Locked, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+            return;
+        }
+
+        for (uint32_t spin = 0; spin < spinCount_; ++spin) {
+            cpuRelax();
+            if (state_.load(std::memory_order_relaxed) == Unlocked) {
+                expected = Unlocked;
+                if (state_.compare_exchange_weak(expected, Locked, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+
+        // Mark the lock contended: whoever holds it will wake us on unlock(). Once
+        // parked, we must keep acquiring as Contended since others may still be waiting.
+        while (state_.exchange(Contended, std::memory_order_acquire) != Unlocked) {
+            state_.wait(Contended, std::memory_order_relaxed);
+        }
+    }
+
+    /// Try to acquire the mutex without waiting
+    /// @return true if the mutex was acquired
+    bool tryLock() noexcept {
+        uint32_t expected = Unlocked;
+        return state_.compare_exchange_strong(expected, Locked, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    /// Lockable requirement (same as tryLock())
+    bool try_lock() noexcept { return tryLock(); }
+
+    /// Release the mutex
+    void unlock() noexcept {
+        if (state_.exchange(Unlocked, std::memory_order_release) == Contended) {
+            state_.notify_one();
+        }
+    }
+
+    /// Check if the mutex is currently held (for assertions only)
+    bool isLocked() const noexcept { return state_.load(std::memory_order_relaxed) != Unlocked; }
+
+private:
+    static constexpr uint32_t Unlocked = 0;
+    static constexpr uint32_t Locked = 1;     ///< Held, no thread parked
+    static constexpr uint32_t Contended = 2;  ///< Held, threads may be parked
+
+    std::atomic<uint32_t> state_{Unlocked};
+    uint32_t spinCount_;
+};
+
+}  // namespace axiom::core
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace axiom::core {
+
+/// Bounded single-producer / single-consumer ring buffer
+///
+/// Exactly one thread may push and exactly one (other) thread may pop. Both
+/// operations are wait-free. Each side keeps a private copy of the other
+/// side's index and only reloads the shared atomic when the copy says the
+/// ring is full (producer) or empty (consumer), so in steady state producer
+/// and consumer do not touch each other's cache lines.
+///
+/// Example usage:
+/// @code
+/// SpscQueue<LogRecord> records(4096);
+///
+/// // Producer thread
+/// if (!records.tryPush(record)) { ++droppedRecords; }
+///
+/// // Consumer thread
+/// LogRecord record;
+/// while (records.tryPop(record)) { sink.write(record); }
+/// @endcode
+///
+/// @tparam T Element type (default constructible and move assignable)
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_default_constructible_v<T>, "SpscQueue requires default constructible T");
+    static_assert(std::is_move_assignable_v<T>, "SpscQueue requires move assignable T");
+
+public:
+    /// Create a queue
+    /// @param capacity Maximum number of elements (rounded up to a power of two, at least 2)
+    explicit SpscQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        slots_ = std::make_unique<T[]>(rounded);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    SpscQueue(SpscQueue&&) = delete;
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    /// Push an element (producer thread only)
+    /// @param value Element to push
+    /// @return false if the queue is full (value is left untouched)
+    template <typename U>
+    bool tryPush(U&& value) {
+        const uint64_t write = producer_.write.load(std::memory_order_relaxed);
+        if (write - producer_.cachedRead > mask_) {
+            producer_.cachedRead = consumer_.read.load(std::memory_order_acquire);
+            if (write - producer_.cachedRead > mask_) {
+                return false;
+            }
+        }
+        slots_[write & mask_] = std::forward<U>(value);
+        producer_.write.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop the oldest element (consumer thread only)
+    /// @param out Receives the element
+    /// @return false if the queue is empty
+    bool tryPop(T& out) {
+        const uint64_t read = consumer_.read.load(std::memory_order_relaxed);
+        if (read == consumer_.cachedWrite) {
+            consumer_.cachedWrite = producer_.write.load(std::memory_order_acquire);
+            if (read == consumer_.cachedWrite) {
+                return false;
+            }
+        }
+        out = std::move(slots_[read & mask_]);
+        consumer_.read.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Get the number of queued elements (approximate while both sides are active)
+    size_t getSizeApprox() const noexcept {
+        const uint64_t read = consumer_.read.load(std::memory_order_acquire);
+        const uint64_t write = producer_.write.load(std::memory_order_acquire);
+        return write > read ? static_cast<size_t>(write - read) : 0;
+    }
+
+    /// Check if the queue is empty (approximate while both sides are active)
+    bool isEmpty() const noexcept { return getSizeApprox() == 0; }
+
+    /// Get the maximum number of elements
+    size_t getCapacity() const noexcept { return mask_ + 1; }
+
+private:
+    struct alignas(CacheLineSize) ProducerSide {
+        std::atomic<uint64_t> write{0};
+        uint64_t cachedRead = 0;  ///< Producer's last view of consumer_.read
+    };
+
+    struct alignas(CacheLineSize) ConsumerSide {
+        std::atomic<uint64_t> read{0};
+        uint64_t cachedWrite = 0;  ///< Consumer's last view of producer_.write
+    };
+
+    ProducerSide producer_;
+    ConsumerSide consumer_;
+    size_t mask_ = 0;
+    std::unique_ptr<T[]> slots_;
+};
+
+}  // namespace axiom::core
@@ -0,0 +1,339 @@
+#pragma once
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/metrics.hpp"
+#include "axiom/core/result.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace axiom::core {
+
+class TaskGraph;
+
+/// Pipeline stage a task graph node's execution time is attributed to
+enum class TaskStage : uint8_t {
+    None,         ///< Not attributed to any stage
+    Broadphase,   ///< Broadphase collision detection (AABB update, pair finding)
+    Narrowphase,  ///< Narrowphase collision detection (contact generation)
+    Solver,       ///< Island building and constraint solving
+    Integration,  ///< Velocity and position integration
+    Count         ///< Number of stages (not a valid stage)
+};
+
+/// Convert TaskStage to string representation
+/// @param stage The stage to convert
+/// @return Name of the stage
+const char* taskStageToString(TaskStage stage) noexcept;
+
+/// Timings of one executed frame, in milliseconds
+///
+/// Stage times are the sum of all frame-head nodes attributed to that stage.
+/// Nodes that overlap the next frame are not included (see overlapsNextFrame()).
+struct TaskGraphTimings {
+    uint64_t frame = 0;     ///< Frame index these timings belong to
+    float totalMs = 0.0f;   ///< Wall time from frame start until every frame-head node finished
+    std::array<float, static_cast<size_t>(TaskStage::Count)> stageMs{};  ///< Indexed by TaskStage
+
+    /// Get the time attributed to a stage
+    /// @param stage Stage to query
+    /// @return Time in milliseconds
+    float getStageMs(TaskStage stage) const noexcept { return stageMs[static_cast<size_t>(stage)]; }
+};
+
+/// Typed handle to a resource registered with TaskGraph::addResource()
+/// @tparam T Type of the resource data
+template <typename T>
+class TaskResource {
+public:
+    /// Create an invalid handle
+    TaskResource() = default;
+
+    /// Check if the handle refers to a resource
+    bool isValid() const noexcept { return index_ != UINT32_MAX; }
+
+    /// Get the resource index within its graph
+    uint32_t getIndex() const noexcept { return index_; }
+
+private:
+    friend class TaskGraph;
+
+    explicit TaskResource(uint32_t index) noexcept : index_(index) {}
+
+    uint32_t index_ = UINT32_MAX;
+};
+
+/// Execution context passed to a task graph node
+///
+/// Gives typed access to the resources the node declared. Accessing a resource
+/// the node did not declare (or writing one it only reads) trips an assertion,
+/// which keeps the declarations - and therefore the schedule - honest.
+class TaskContext {
+public:
+    /// Read access to a declared resource
+    /// @pre The node declared reads() or writes() for this resource
+    template <typename T>
+    const T& read(TaskResource<T> resource) const {
+        return *static_cast<const T*>(lookup(resource.getIndex(), false));
+    }
+
+    /// Write access to a declared resource
+    /// @pre The node declared writes() for this resource
+    template <typename T>
+    T& write(TaskResource<T> resource) const {
+        return *static_cast<T*>(lookup(resource.getIndex(), true));
+    }
+
+    /// Get the job system executing the graph (for parallelFor inside a node)
+    JobSystem& getJobSystem() const noexcept { return *jobs_; }
+
+    /// Get the index of the frame being executed
+    uint64_t getFrameIndex() const noexcept { return frame_; }
+
+private:
+    friend class TaskGraph;
+
+    TaskContext(const TaskGraph& graph, uint32_t node, JobSystem& jobs, uint64_t frame) noexcept
+        : graph_(&graph), node_(node), jobs_(&jobs), frame_(frame) {}
+
+    void* lookup(uint32_t resource, bool write) const;
+
+    const TaskGraph* graph_;
+    uint32_t node_;
+    JobSystem* jobs_;
+    uint64_t frame_;
+};
+
+/// Node callback
+using TaskFunction = std::function<void(TaskContext&)>;
+
+/// Fluent interface for declaring a node's resource accesses
+class TaskNodeBuilder {
+public:
+    /// Declare that the node reads a resource
+    template <typename T>
+    TaskNodeBuilder& reads(TaskResource<T> resource) {
+        addAccess(resource.getIndex(), false);
+        return *this;
+    }
+
+    /// Declare that the node writes (or reads and writes) a resource
+    template <typename T>
+    TaskNodeBuilder& writes(TaskResource<T> resource) {
+        addAccess(resource.getIndex(), true);
+        return *this;
+    }
+
+    /// Attribute the node's execution time to a pipeline stage
+    TaskNodeBuilder& stage(TaskStage stage);
+
+    /// Let the node run concurrently with the next frame's head
+    ///
+    /// Use for the independent tail of a step (debug-draw generation, statistics).
+    /// TaskGraph::execute() returns without waiting for such nodes; next-frame
+    /// nodes touching the same resources wait for them automatically. Only other
+    /// overlapping nodes may depend on an overlapping node.
+    TaskNodeBuilder& overlapsNextFrame();
+
+    /// Get the node index
+    uint32_t getIndex() const noexcept { return node_; }
+
+private:
+    friend class TaskGraph;
+
+    TaskNodeBuilder(TaskGraph& graph, uint32_t node) noexcept : graph_(&graph), node_(node) {}
+
+    void addAccess(uint32_t resource, bool write);
+
+    TaskGraph* graph_;
+    uint32_t node_;
+};
+
+/// Declarative frame task graph
+///
+/// Nodes declare which resources they read and write. compile() derives the
+/// dependency DAG once from those declarations, in declaration order: a reader
+/// runs after the previous writer, and a writer runs after the previous writer
+/// and every reader since. execute() then runs one frame on a JobSystem with a
+/// single atomic decrement per edge - there are no locks and no per-frame
+/// allocations.
+///
+/// Nodes marked overlapsNextFrame() form the frame tail: execute() returns as
+/// soon as the head is done, so the tail of frame N runs alongside the head of
+/// frame N+1. Conflicting nodes of frame N+1 wait for the tail nodes they share
+/// resources with. At most one frame of overlap is allowed: frame N+2 starts
+/// only after the tail of frame N finished.
+///
+/// Example usage:
+/// @code
+/// TaskGraph graph;
+/// auto bodies = graph.addResource("Bodies", &bodyStorage);
+/// auto aabbs = graph.addResource("AABBs", &aabbStorage);
+/// auto pairs = graph.addResource("Pairs", &pairStorage);
+/// auto debug = graph.addResource("DebugDraw", &debugLines);
+///
+/// graph.addNode("Update AABBs", [&](TaskContext& ctx) {
+///          updateAABBs(ctx.read(bodies), ctx.write(aabbs));
+///      })
+///     .reads(bodies).writes(aabbs).stage(TaskStage::Broadphase);
+/// graph.addNode("Broadphase", [&](TaskContext& ctx) {
+///          findPairs(ctx.read(aabbs), ctx.write(pairs));
+///      })
+///     .reads(aabbs).writes(pairs).stage(TaskStage::Broadphase);
+/// graph.addNode("Debug draw", [&](TaskContext& ctx) {
+///          drawAABBs(ctx.read(aabbs), ctx.write(debug));
+///      })
+///     .reads(aabbs).writes(debug).overlapsNextFrame();
+///
+/// if (graph.compile().isFailure()) { return; }
+///
+/// while (running) {
+///     graph.execute(jobs);
+///     gui::applyTaskGraphTimings(graph.getLastFrameTimings(), stats);
+/// }
+/// graph.waitIdle(jobs);
+/// @endcode
+class TaskGraph {
+public:
+    /// Number of frames that can be in flight at once
+    /// (head of N+1, tail of N, plus one being primed)
+    static constexpr size_t FrameSlots = 3;
+
+    TaskGraph();
+
+    /// Destroy the graph
+    /// @pre waitIdle() was called after the last execute()
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph(TaskGraph&&) = delete;
+    TaskGraph& operator=(TaskGraph&&) = delete;
+
+    /// Register a resource
+    /// @param name Debug name (must have static lifetime)
+    /// @param data Resource storage (must outlive the graph)
+    /// @return Typed handle for node declarations and TaskContext access
+    template <typename T>
+    TaskResource<T> addResource(const char* name, T* data) {
+        AXIOM_ASSERT(!compiled_, "Resources must be added before compile()");
+        resources_.push_back(Resource{name, static_cast<void*>(data)});
+        return TaskResource<T>(static_cast<uint32_t>(resources_.size() - 1));
+    }
+
+    /// Add a node
+    /// @param name Debug name (must have static lifetime)
+    /// @param fn Node body, executed as a job
+    /// @return Builder for declaring resource accesses
+    TaskNodeBuilder addNode(const char* name, TaskFunction fn);
+
+    /// Build the dependency DAG
+    /// @return Error (InvalidParameter) if a frame-head node depends on an overlapping node
+    Result<void> compile();
+
+    /// Check if compile() succeeded
+    bool isCompiled() const noexcept { return compiled_; }
+
+    /// Execute one frame and wait until every frame-head node finished
+    ///
+    /// The calling thread helps execute jobs while waiting. Overlapping tail
+    /// nodes may still be running when this returns.
+    ///
+    /// @param jobs Job system to run nodes on (must be the same every frame)
+    /// @pre compile() succeeded
+    void execute(JobSystem& jobs);
+
+    /// Wait until all nodes of all executed frames finished
+    /// @param jobs Job system passed to execute()
+    void waitIdle(JobSystem& jobs);
+
+    /// Get the timings of the most recent execute()
+    const TaskGraphTimings& getLastFrameTimings() const noexcept { return lastTimings_; }
+
+    /// Get the number of frames executed so far
+    uint64_t getFrameCount() const noexcept { return frameCount_; }
+
+    /// Get the number of nodes
+    uint32_t getNodeCount() const noexcept { return static_cast<uint32_t>(nodes_.size()); }
+
+    /// Get a node's debug name
+    const char* getNodeName(uint32_t node) const noexcept { return nodes_[node]->name; }
+
+    /// Get the most recent execution time of a node (milliseconds)
+    float getNodeTimeMs(uint32_t node) const noexcept {
+        return nodes_[node]->lastTimeMs.load(std::memory_order_relaxed);
+    }
+
+    /// Get the nodes that depend directly on a node within a frame (valid after compile())
+    const std::vector<uint32_t>& getNodeSuccessors(uint32_t node) const noexcept {
+        return nodes_[node]->successors;
+    }
+
+private:
+    friend class TaskContext;
+    friend class TaskNodeBuilder;
+
+    struct Resource {
+        const char* name;
+        void* data;
+    };
+
+    struct Access {
+        uint32_t resource;
+        bool write;
+    };
+
+    struct Node {
+        const char* name = nullptr;
+        TaskFunction fn;
+        std::vector<Access> accesses;
+        TaskStage stage = TaskStage::None;
+        bool tail = false;
+
+        std::vector<uint32_t> successors;           ///< Same-frame dependents
+        std::vector<uint32_t> nextFrameSuccessors;  ///< Next-frame dependents (tail nodes only)
+        int32_t predecessorCount = 0;               ///< Same-frame dependencies
+        int32_t previousFramePredecessorCount = 0;  ///< Previous-frame tail nodes to wait for
+
+        /// Unsatisfied dependencies per frame slot. Tail nodes of the previous frame may
+        /// decrement a slot before execute() primes it, so the value can go negative.
+        std::array<std::atomic<int32_t>, FrameSlots> remaining{};
+
+        std::atomic<float> lastTimeMs{0.0f};
+    };
+
+    struct FrameSlot {
+        JobCounter head;  ///< Frame-head nodes not yet finished
+        JobCounter tail;  ///< Overlapping nodes not yet finished
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(TaskStage::Count)> stageNs{};
+    };
+
+    static bool conflicts(const Node& a, const Node& b) noexcept;
+    static void addEdge(std::vector<uint32_t>& edges, uint32_t to);
+
+    void launch(uint32_t node, uint64_t frame);
+    void runNode(uint32_t node, uint64_t frame);
+
+    std::vector<Resource> resources_;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::array<FrameSlot, FrameSlots> slots_;
+    JobCounter jobs_;  ///< Every node job in flight
+    JobSystem* jobSystem_ = nullptr;
+
+    uint32_t headNodeCount_ = 0;
+    uint32_t tailNodeCount_ = 0;
+    bool compiled_ = false;
+    uint64_t frameCount_ = 0;
+    TaskGraphTimings lastTimings_;
+
+    std::array<MetricId, static_cast<size_t>(TaskStage::Count)> stageMetrics_{};
+    MetricId stepMetric_ = InvalidMetricId;
+};
+
+}  // namespace axiom::core
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "axiom/core/cache_line.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace axiom::core {
+
+/// Chase-Lev work-stealing deque
+///
+/// A single owner thread pushes and pops at the bottom (LIFO, cache-warm),
+/// while any number of thief threads steal from the top (FIFO, oldest and
+/// usually largest work first). The owner path is wait-free except when the
+/// buffer grows; stealing is lock-free. Memory orderings follow Lê et al.,
+/// "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+///
+/// Grown-out buffers are retained until the deque is destroyed, because a
+/// thief may still be reading from an old buffer when the owner grows.
+///
+/// Example usage:
+/// @code
+/// WorkStealingDeque<Job*> deque;
+///
+/// // Owner thread
+/// deque.push(job);
+/// Job* mine = nullptr;
+/// if (deque.pop(mine)) { execute(mine); }
+///
+/// // Any other thread
+/// Job* stolen = nullptr;
+/// if (deque.steal(stolen)) { execute(stolen); }
+/// @endcode
+///
+/// @tparam T Element type (must be trivially copyable, typically a pointer)
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "WorkStealingDeque requires trivially copyable T");
+
+public:
+    /// Create a deque
+    /// @param initialCapacity Initial buffer capacity (rounded up to a power of two)
+    explicit WorkStealingDeque(size_t initialCapacity = 1024) {
+        size_t capacity = 2;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        buffers_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+    /// Push an element at the bottom (owner thread only)
+    /// @param value Element to push
+    void push(T value) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (b - t > static_cast<int64_t>(buffer->capacity) - 1) {
+            buffer = grow(buffer, b, t);
+        }
+
+        buffer->put(b, value);
+        bottom_.store(b + 1, std::memory_order_release);  // publishes the slot to thieves
+    }
+
+    /// Pop the most recently pushed element (owner thread only)
+    /// @param out Receives the element on success
+    /// @return true if an element was popped, false if the deque was empty
+    bool pop(T& out) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty - restore bottom
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = buffer->get(b);
+        if (t == b) {
+            // Last element: race against thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Steal the oldest element (any thread)
+    /// @param out Receives the element on success
+    /// @return true if an element was stolen, false if empty or another thread won the race
+    bool steal(T& out) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return false;
+        }
+
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        const T value = buffer->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    /// Approximate number of elements (exact only when no other thread is active)
+    size_t size() const noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    /// Check if the deque appears empty
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Current buffer capacity
+    size_t capacity() const noexcept { return buffer_.load(std::memory_order_relaxed)->capacity; }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t cap)
+            : capacity(cap), mask(cap - 1), slots(std::make_unique<std::atomic<T>[]>(cap)) {}
+
+        T get(int64_t index) const noexcept {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T value) noexcept {
+            slots[static_cast<size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Buffer* grow(Buffer* old, int64_t bottom, int64_t top) {
+        auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Buffer* result = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(result, std::memory_order_release);
+        return result;
+    }
+
+    // top_ is written by thieves and bottom_ by the owner: keep them on separate cache lines
+    alignas(CacheLineSize) std::atomic<int64_t> top_{0};
+    alignas(CacheLineSize) std::atomic<int64_t> bottom_{0};
+    alignas(CacheLineSize) std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers_;  ///< Current and retired buffers (owner only)
+};
+
+}  // namespace axiom::core
@@ -14,6 +14,7 @@ namespace axiom {
 namespace collision {
 struct Shape;
 struct ContactPoint;
+class PersistentManifold;
 }  // namespace collision
 
 namespace dynamics {
@@ -83,14 +84,17 @@ struct PhysicsDebugDrawConfig {
 };
 
 /// Shape types for debug visualization
-/// These match the collision system's shape types (to be implemented in Phase 3-4)
+/// These match collision::ShapeType (checked in physics_debug_draw.cpp)
 enum class ShapeType {
-    Sphere,   ///< Sphere shape
-    Box,      ///< Oriented box shape
-    Capsule,  ///< Capsule shape (cylinder with hemispherical caps)
-    Plane,    ///< Infinite plane
-    Convex,   ///< Convex hull
-    Mesh      ///< Triangle mesh (concave)
+    Sphere,         ///< Sphere shape
+    Box,            ///< Oriented box shape
+    Capsule,        ///< Capsule shape (cylinder with hemispherical caps)
+    Plane,          ///< Infinite plane
+    Convex,         ///< Convex hull
+    Mesh,           ///< Triangle mesh (concave)
+    HeightField,    ///< Height field terrain, drawn from its triangles like a mesh
+    DistanceField,  ///< Signed distance field, drawn from its source mesh like a mesh
+    Compound        ///< Group of shapes; each child is drawn as a shape of its own
 };
 
 /// Simplified shape data for debug drawing (used until full collision system is implemented)
@@ -104,7 +108,7 @@ struct DebugShape {
     float height = 0.0f;     ///< Capsule height
     math::Vec3 normal;       ///< Plane normal
 
-    // For convex/mesh (future use)
+    // For convex/mesh
     const float* vertices = nullptr;    ///< Pointer to vertex data
     size_t vertexCount = 0;             ///< Number of vertices
     const uint32_t* indices = nullptr;  ///< Pointer to index data
@@ -196,6 +200,10 @@ public:
     /// @param contact Contact point data
     void drawContactPoint(const DebugContactPoint& contact);
 
+    /// Draw every point of a persistent contact manifold
+    /// @param manifold Manifold of one pair; points are drawn on B's surface
+    void drawContactManifold(const collision::PersistentManifold& manifold);
+
     /// Draw a constraint/joint connection
     /// @param constraint Constraint data
     void drawConstraint(const DebugConstraint& constraint);
@@ -263,7 +271,7 @@ private:
     /// Draw a plane shape
     void drawPlane(const DebugShape& shape, const math::Vec4& color);
 
-    /// Draw a convex hull shape
+    /// Draw a convex hull or triangle mesh shape
     void drawConvexHull(const DebugShape& shape, const math::Vec4& color);
 
     /// Get a color for a simulation island (deterministic color based on index)
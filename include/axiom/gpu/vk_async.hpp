@@ -0,0 +1,41 @@
+#pragma once
+
+#include "axiom/core/coroutine.hpp"
+#include "axiom/gpu/vk_sync.hpp"
+
+#include <cstdint>
+
+namespace axiom::gpu {
+
+/// Awaitable that suspends a coroutine until a fence is signaled
+///
+/// Unlike Fence::wait(), no thread blocks: the executor's poll thread checks
+/// the fence (vkGetFenceStatus) and resumes the coroutine once it is signaled.
+///
+/// Example usage:
+/// @code
+/// core::Task<void> readback(core::TaskExecutor& executor, Fence& fence, GpuBuffer& buffer) {
+///     co_await untilSignaled(executor, fence);
+///     consumeResults(buffer.map());
+/// }
+/// @endcode
+///
+/// @param executor Executor that resumes the coroutine
+/// @param fence Fence to wait for (must outlive the await)
+inline auto untilSignaled(core::TaskExecutor& executor, const Fence& fence) {
+    return executor.pollUntil([&fence] { return fence.isSignaled(); });
+}
+
+/// Awaitable that suspends a coroutine until a timeline semaphore reaches a value
+///
+/// Non-blocking counterpart of TimelineSemaphore::wait().
+///
+/// @param executor Executor that resumes the coroutine
+/// @param semaphore Semaphore to wait on (must outlive the await)
+/// @param value Counter value to wait for
+inline auto untilValue(core::TaskExecutor& executor, const TimelineSemaphore& semaphore,
+                       uint64_t value) {
+    return executor.pollUntil([&semaphore, value] { return semaphore.getValue() >= value; });
+}
+
+}  // namespace axiom::gpu
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "axiom/collision/overlapping_pair_cache.hpp"
+#include "axiom/core/metrics.hpp"
+#include "axiom/core/task_graph.hpp"
 #include "axiom/debug/physics_debug_draw.hpp"
 #include "axiom/math/vec3.hpp"
 
@@ -28,8 +31,41 @@ struct PhysicsWorldStats {
     float narrowphaseTime = 0.0f;  ///< Narrowphase collision detection time
     float solverTime = 0.0f;       ///< Constraint solver time
     float integrationTime = 0.0f;  ///< Integration time
+
+    // Long-running distributions (filled from the metrics registry, see applyMetrics)
+    uint64_t stepSampleCount = 0;     ///< Number of recorded steps
+    float stepTimeP50 = 0.0f;         ///< Median step time (ms)
+    float stepTimeP95 = 0.0f;         ///< 95th percentile step time (ms)
+    float stepTimeP99 = 0.0f;         ///< 99th percentile step time (ms)
+    float stepTimeMax = 0.0f;         ///< Worst step time (ms)
+    uint32_t broadphasePairsP50 = 0;  ///< Median broadphase pair count
+    uint32_t broadphasePairsP99 = 0;  ///< 99th percentile broadphase pair count
+    uint32_t broadphasePairsMax = 0;  ///< Largest broadphase pair count
 };
 
+/// Fill the distribution fields of PhysicsWorldStats from a metrics snapshot
+///
+/// Reads the histograms named in core::metric_names (StepTime, BroadphasePairs).
+/// Missing or empty histograms leave the corresponding fields untouched.
+///
+/// @param snapshot Snapshot from core::MetricsRegistry::snapshot()
+/// @param stats Statistics to update
+void applyMetrics(const core::MetricsSnapshot& snapshot, PhysicsWorldStats& stats);
+
+/// Fill the per-frame timing fields of PhysicsWorldStats from a task graph frame
+///
+/// totalStepTime receives the frame time; the stage fields receive the time of
+/// the nodes attributed to the matching core::TaskStage.
+///
+/// @param timings Timings from core::TaskGraph::getLastFrameTimings()
+/// @param stats Statistics to update
+void applyTaskGraphTimings(const core::TaskGraphTimings& timings, PhysicsWorldStats& stats);
+
+/// Fill contactPointCount from the persistent manifolds of the pair cache
+/// @param pairs Pair cache after the narrowphase updated its manifolds
+/// @param stats Statistics to update
+void applyContactManifolds(const collision::OverlappingPairCache& pairs, PhysicsWorldStats& stats);
+
 /// Configuration for physics simulation
 struct PhysicsWorldConfig {
     math::Vec3 gravity = math::Vec3(0.0f, -9.81f, 0.0f);  ///< Gravity vector (m/s^2)
@@ -0,0 +1,675 @@
+#include "axiom/collision/collision_layers.hpp"
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace axiom::collision {
+
+namespace {
+
+template <typename T>
+constexpr bool IsTree = std::is_same_v<std::decay_t<T>, DynamicAABBTree>;
+
+size_t layerIndex(CollisionLayer layer) noexcept {
+    return static_cast<size_t>(layer);
+}
+
+}  // namespace
+
+LayeredBroadphase::LayeredBroadphase(const LayeredBroadphaseConfig& config) : config_(config) {
+    for (size_t index = 0; index < CollisionLayerCount; ++index) {
+        layers_[index].structure = makeStructure(config_.structures[index], config_);
+    }
+}
+
+LayeredBroadphase::Structure LayeredBroadphase::makeStructure(
+    BroadphaseKind kind, const LayeredBroadphaseConfig& config) {
+    switch (kind) {
+        case BroadphaseKind::SweepAndPrune: {
+            SweepAndPruneConfig sapConfig;
+            sapConfig.jobSystem = config.jobSystem;
+            return Structure(std::in_place_type<SweepAndPrune>, sapConfig);
+        }
+        case BroadphaseKind::UniformGrid: {
+            UniformGridConfig gridConfig;
+            gridConfig.jobSystem = config.jobSystem;
+            return Structure(std::in_place_type<UniformGrid>, gridConfig);
+        }
+        case BroadphaseKind::DynamicAABBTree:
+        default:
+            return Structure(std::in_place_type<DynamicAABBTree>);
+    }
+}
+
+//=============================================================================
+// Proxies
+//=============================================================================
+
+ProxyId LayeredBroadphase::createProxy(CollisionLayer layer, const math::AABB& aabb,
+                                       const CollisionFilter& filter, uint64_t userData) {
+    AXIOM_ASSERT(layerIndex(layer) < CollisionLayerCount, "Invalid collision layer");
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    uint32_t index;
+    if (freeList_ != NullProxy) {
+        index = freeList_;
+        freeList_ = proxies_[index].nextFree;
+    } else {
+        index = static_cast<uint32_t>(proxies_.size());
+        AXIOM_ASSERT(index != NullProxy, "LayeredBroadphase proxy pool exhausted");
+        proxies_.emplace_back();
+    }
+
+    // New proxies take the slot after the last one
+    const uint32_t slot = proxyCount_;
+    Layer& target = layers_[layerIndex(layer)];
+    Proxy& proxy = proxies_[index];
+    proxy.userData = userData;
+    proxy.slot = slot;
+    proxy.nextFree = NullProxy;
+    proxy.triggerOverlaps = 0;
+    proxy.layer = layer;
+    proxy.alive = true;
+
+    ids_.push_back(index);
+    locals_.push_back(std::visit(
+        [&](auto& structure) { return structure.createProxy(aabb, slot); }, target.structure));
+    members_.push_back(static_cast<uint32_t>(target.members.size()));
+    moved_.push_back(1);
+    target.members.push_back(slot);
+    categoryBits_.push_back(filter.categoryBits);
+    maskBits_.push_back(filter.maskBits);
+    groupIndex_.push_back(filter.groupIndex);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        min_[axis].push_back(aabb.min[axis]);
+        max_[axis].push_back(aabb.max[axis]);
+    }
+    target.categoryUnion |= filter.categoryBits;
+    target.maskUnion |= filter.maskBits;
+    target.hasGroups |= filter.groupIndex > 0;
+
+    ++proxyCount_;
+    return static_cast<ProxyId>(index);
+}
+
+void LayeredBroadphase::destroyProxy(ProxyId id) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+
+    Proxy& proxy = proxies_[id];
+    const uint32_t slot = proxy.slot;
+    Layer& layer = layers_[layerIndex(proxy.layer)];
+    std::visit([&](auto& structure) { structure.destroyProxy(locals_[slot]); }, layer.structure);
+
+    // Swap-remove from the member list
+    const uint32_t lastMember = layer.members.back();
+    layer.members[members_[slot]] = lastMember;
+    members_[lastMember] = members_[slot];
+    layer.members.pop_back();
+    layer.unionsDirty = true;
+
+    // Move the last slot into the hole, keeping the slots dense
+    const uint32_t last = proxyCount_ - 1;
+    if (slot != last) {
+        ids_[slot] = ids_[last];
+        locals_[slot] = locals_[last];
+        members_[slot] = members_[last];
+        moved_[slot] = moved_[last];
+        categoryBits_[slot] = categoryBits_[last];
+        maskBits_[slot] = maskBits_[last];
+        groupIndex_[slot] = groupIndex_[last];
+        for (size_t axis = 0; axis < 3; ++axis) {
+            min_[axis][slot] = min_[axis][last];
+            max_[axis][slot] = max_[axis][last];
+        }
+        relinkSlot(slot);
+    }
+    ids_.pop_back();
+    locals_.pop_back();
+    members_.pop_back();
+    moved_.pop_back();
+    categoryBits_.pop_back();
+    maskBits_.pop_back();
+    groupIndex_.pop_back();
+    for (size_t axis = 0; axis < 3; ++axis) {
+        min_[axis].pop_back();
+        max_[axis].pop_back();
+    }
+
+    proxy.alive = false;
+    proxy.slot = NullProxy;
+    --proxyCount_;
+
+    // The next update drops its trigger overlaps and frees the id, so a
+    // recycled id cannot inherit them
+    if (proxy.triggerOverlaps > 0) {
+        deadTriggerIds_.push_back(id);
+        return;
+    }
+    proxy.nextFree = freeList_;
+    freeList_ = id;
+}
+
+void LayeredBroadphase::moveProxy(ProxyId id, const math::AABB& aabb,
+                                  const math::Vec3& displacement) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    const Proxy& proxy = proxies_[id];
+    const uint32_t slot = proxy.slot;
+    std::visit(
+        [&](auto& structure) {
+            if constexpr (IsTree<decltype(structure)>) {
+                structure.moveProxy(locals_[slot], aabb, displacement);
+            } else {
+                structure.moveProxy(locals_[slot], aabb);
+            }
+        },
+        layers_[layerIndex(proxy.layer)].structure);
+
+    for (size_t axis = 0; axis < 3; ++axis) {
+        min_[axis][slot] = aabb.min[axis];
+        max_[axis][slot] = aabb.max[axis];
+    }
+    moved_[slot] = 1;
+}
+
+void LayeredBroadphase::setFilter(ProxyId id, const CollisionFilter& filter) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+
+    const uint32_t slot = proxies_[id].slot;
+    categoryBits_[slot] = filter.categoryBits;
+    maskBits_[slot] = filter.maskBits;
+    groupIndex_[slot] = filter.groupIndex;
+    moved_[slot] = 1;
+    layers_[layerIndex(proxies_[id].layer)].unionsDirty = true;
+}
+
+CollisionFilter LayeredBroadphase::getFilter(ProxyId id) const noexcept {
+    return getSlotFilter(proxies_[id].slot);
+}
+
+math::AABB LayeredBroadphase::getAABB(ProxyId id) const noexcept {
+    return getSlotAABB(proxies_[id].slot);
+}
+
+math::AABB LayeredBroadphase::getSlotAABB(uint32_t slot) const noexcept {
+    return math::AABB(math::Vec3(min_[0][slot], min_[1][slot], min_[2][slot]),
+                      math::Vec3(max_[0][slot], max_[1][slot], max_[2][slot]));
+}
+
+CollisionFilter LayeredBroadphase::getSlotFilter(uint32_t slot) const noexcept {
+    return {categoryBits_[slot], maskBits_[slot], static_cast<int16_t>(groupIndex_[slot])};
+}
+
+void LayeredBroadphase::swapSlots(uint32_t a, uint32_t b) noexcept {
+    std::swap(ids_[a], ids_[b]);
+    std::swap(locals_[a], locals_[b]);
+    std::swap(members_[a], members_[b]);
+    std::swap(moved_[a], moved_[b]);
+    std::swap(categoryBits_[a], categoryBits_[b]);
+    std::swap(maskBits_[a], maskBits_[b]);
+    std::swap(groupIndex_[a], groupIndex_[b]);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        std::swap(min_[axis][a], min_[axis][b]);
+        std::swap(max_[axis][a], max_[axis][b]);
+    }
+
+    relinkSlot(a);
+    relinkSlot(b);
+}
+
+void LayeredBroadphase::relinkSlot(uint32_t slot) noexcept {
+    // Point the id table, member list and structure at the proxy's new slot
+    Proxy& proxy = proxies_[ids_[slot]];
+    Layer& layer = layers_[layerIndex(proxy.layer)];
+    proxy.slot = slot;
+    layer.members[members_[slot]] = slot;
+    std::visit([&](auto& structure) { structure.setUserData(locals_[slot], slot); },
+               layer.structure);
+}
+
+void LayeredBroadphase::refreshUnions(Layer& layer) noexcept {
+    uint32_t categories = 0;
+    uint32_t masks = 0;
+    bool groups = false;
+    for (const uint32_t slot : layer.members) {
+        categories |= categoryBits_[slot];
+        masks |= maskBits_[slot];
+        groups |= groupIndex_[slot] > 0;
+    }
+    layer.categoryUnion = categories;
+    layer.maskUnion = masks;
+    layer.hasGroups = groups;
+    layer.unionsDirty = false;
+}
+
+//=============================================================================
+// Morton reorder
+//=============================================================================
+
+void LayeredBroadphase::beginReorder() {
+    AXIOM_PROFILE_SCOPE("LayeredBroadphase::beginReorder");
+
+    // Quantize the proxy centers to 10 bits per axis within their bounds
+    math::Vec3 low(std::numeric_limits<float>::max());
+    math::Vec3 high(std::numeric_limits<float>::lowest());
+    for (uint32_t slot = 0; slot < proxyCount_; ++slot) {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const float center = 0.5f * (min_[axis][slot] + max_[axis][slot]);
+            low[axis] = std::min(low[axis], center);
+            high[axis] = std::max(high[axis], center);
+        }
+    }
+    math::Vec3 scale;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float extent = high[axis] - low[axis];
+        scale[axis] = extent > 0.0f ? 1023.0f / extent : 0.0f;
+    }
+
+    // Keys hold the Morton code above the slot, so equal codes keep slot order
+    reorderKeys_.resize(proxyCount_);
+    reorderTemp_.resize(proxyCount_);
+    for (uint32_t slot = 0; slot < proxyCount_; ++slot) {
+        uint32_t morton = 0;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const float center = 0.5f * (min_[axis][slot] + max_[axis][slot]);
+            const float cell = std::clamp((center - low[axis]) * scale[axis], 0.0f, 1023.0f);
+            morton |= detail::spreadBits(static_cast<uint32_t>(cell)) << axis;
+        }
+        reorderKeys_[slot] = uint64_t{morton} << 32 | slot;
+    }
+
+    // LSD radix sort of the 30 code bits, 10 at a time
+    std::array<uint32_t, 1024> offsets{};
+    for (uint32_t shift = 32; shift < 62; shift += 10) {
+        offsets.fill(0);
+        for (const uint64_t key : reorderKeys_) {
+            ++offsets[(key >> shift) & 0x3FFu];
+        }
+        uint32_t sum = 0;
+        for (uint32_t& offset : offsets) {
+            const uint32_t count = offset;
+            offset = sum;
+            sum += count;
+        }
+        for (const uint64_t key : reorderKeys_) {
+            reorderTemp_[offsets[(key >> shift) & 0x3FFu]++] = key;
+        }
+        reorderKeys_.swap(reorderTemp_);
+    }
+
+    // Remember ids, not slots: slots move if proxies are destroyed meanwhile
+    reorderOrder_.resize(proxyCount_);
+    for (uint32_t index = 0; index < proxyCount_; ++index) {
+        reorderOrder_[index] = ids_[static_cast<uint32_t>(reorderKeys_[index])];
+    }
+    reorderCursor_ = 0;
+    reorderSlot_ = 0;
+}
+
+void LayeredBroadphase::updateReorder() {
+    AXIOM_PROFILE_SCOPE("LayeredBroadphase::updateReorder");
+
+    // Place the proxies in order, skipping destroyed ones and those already
+    // moved into the sorted prefix by a destroy
+    uint32_t budget = std::max(config_.reorderShardSize, 1u);
+    while (budget > 0 && reorderCursor_ < reorderOrder_.size() && reorderSlot_ < proxyCount_) {
+        const ProxyId id = reorderOrder_[reorderCursor_++];
+        if (!proxies_[id].alive || proxies_[id].slot < reorderSlot_) {
+            continue;
+        }
+        if (proxies_[id].slot != reorderSlot_) {
+            swapSlots(proxies_[id].slot, reorderSlot_);
+        }
+        ++reorderSlot_;
+        ++stats_.reorderedProxies;
+        --budget;
+    }
+
+    if (reorderCursor_ == reorderOrder_.size() || reorderSlot_ >= proxyCount_) {
+        finishReorder();
+    }
+}
+
+void LayeredBroadphase::finishReorder() {
+    // Walk the members in storage order, and so in Morton order
+    for (Layer& layer : layers_) {
+        std::sort(layer.members.begin(), layer.members.end());
+        for (uint32_t index = 0; index < layer.members.size(); ++index) {
+            members_[layer.members[index]] = index;
+        }
+    }
+    reorderOrder_.clear();
+    measureReorder_ = true;
+}
+
+//=============================================================================
+// Pairs
+//=============================================================================
+
+void LayeredBroadphase::findPairs() {
+    AXIOM_PROFILE_SCOPE("LayeredBroadphase::findPairs");
+    AXIOM_PROFILE_ELEMENTS(proxyCount_);
+
+    stats_ = {};
+    pairs_.clear();
+    batchCount_ = 0;
+
+    if (isReordering()) {
+        updateReorder();
+    }
+
+    for (Layer& layer : layers_) {
+        if (layer.unionsDirty) {
+            refreshUnions(layer);
+        }
+        // Degraded trees are rebuilt in the background and swapped in a few steps later
+        if (auto* tree = std::get_if<DynamicAABBTree>(&layer.structure)) {
+            stats_.treeRebuilds += tree->updateRebuild(config_.jobSystem) ? 1u : 0u;
+        }
+    }
+
+    // Bring every structure up to date: self-paired layers report their pairs
+    // while updating, the others are only queried. Trigger overlaps are kept
+    // apart and never reported as pairs.
+    for (size_t index = 0; index < CollisionLayerCount; ++index) {
+        const auto layer = static_cast<CollisionLayer>(index);
+        if (layer != CollisionLayer::Trigger && config_.layerPairs.isEnabled(layer, layer)) {
+            findLayerPairs(layers_[index]);
+        } else {
+            std::visit(
+                [](auto& structure) {
+                    if constexpr (IsTree<decltype(structure)>) {
+                        structure.clearMoved();
+                    } else {
+                        structure.update();
+                    }
+                },
+                layers_[index].structure);
+        }
+    }
+
+    for (size_t a = 0; a < CollisionLayerCount; ++a) {
+        for (size_t b = a + 1; b < CollisionLayerCount; ++b) {
+            const auto layerA = static_cast<CollisionLayer>(a);
+            const auto layerB = static_cast<CollisionLayer>(b);
+            if (!config_.layerPairs.isEnabled(layerA, layerB) || layers_[a].members.empty() ||
+                layers_[b].members.empty() || layerA == CollisionLayer::Trigger ||
+                layerB == CollisionLayer::Trigger) {
+                continue;
+            }
+
+            // Walk the smaller layer and query the other; static geometry is
+            // only ever queried
+            const bool walkA = layerB == CollisionLayer::Static ||
+                               (layerA != CollisionLayer::Static &&
+                                layers_[a].members.size() <= layers_[b].members.size());
+            if (walkA) {
+                findCrossPairs(layerA, layerB);
+            } else {
+                findCrossPairs(layerB, layerA);
+            }
+        }
+    }
+
+    flushCandidates();
+    stats_.pairCount = static_cast<uint32_t>(pairs_.size());
+
+    findTriggerPairs();
+    updateTriggerOverlaps();
+    std::fill(moved_.begin(), moved_.end(), uint8_t{0});
+
+    // Reorder the storage once too many pairs straddle it; a reorder cannot
+    // bring the fraction below what it left last time, so wait for twice that
+    if (stats_.pairCount > 0) {
+        const float distant =
+            static_cast<float>(stats_.distantPairs) / static_cast<float>(stats_.pairCount);
+        if (measureReorder_) {
+            reorderedFraction_ = distant;
+            measureReorder_ = false;
+        } else if (config_.reorderShardSize > 0 && !isReordering() &&
+                   distant > std::max(config_.reorderThreshold, 2.0f * reorderedFraction_)) {
+            beginReorder();
+        }
+    }
+}
+
+void LayeredBroadphase::findLayerPairs(Layer& layer) {
+    std::visit(
+        [&](auto& structure) {
+            if constexpr (IsTree<decltype(structure)>) {
+                // The tree only reports new pairs of moved proxies; query every
+                // member to get all of them
+                structure.clearMoved();
+                for (const uint32_t slot : layer.members) {
+                    const ProxyId local = locals_[slot];
+                    structure.query(structure.getFatAABB(local), [&](ProxyId other) {
+                        if (other > local) {
+                            addCandidate(slot, static_cast<uint32_t>(structure.getUserData(other)));
+                        }
+                        return true;
+                    });
+                }
+            } else {
+                structure.updatePairs([&](ProxyId a, ProxyId b) {
+                    addCandidate(static_cast<uint32_t>(structure.getUserData(a)),
+                                 static_cast<uint32_t>(structure.getUserData(b)));
+                });
+            }
+        },
+        layer.structure);
+}
+
+void LayeredBroadphase::findCrossPairs(CollisionLayer driverLayer, CollisionLayer targetLayer) {
+    const Layer& driver = layers_[layerIndex(driverLayer)];
+    const Layer& target = layers_[layerIndex(targetLayer)];
+
+    std::visit(
+        [&](const auto& structure) {
+            for (const uint32_t slot : driver.members) {
+                if (rejectsAll(target, slot)) {
+                    ++stats_.skippedQueries;
+                    continue;
+                }
+
+                structure.query(getSlotAABB(slot), [&](ProxyId local) {
+                    addCandidate(slot, static_cast<uint32_t>(structure.getUserData(local)));
+                    return true;
+                });
+            }
+        },
+        target.structure);
+}
+
+void LayeredBroadphase::addCandidate(uint32_t a, uint32_t b) {
+    batchA_[batchCount_] = a;
+    batchB_[batchCount_] = b;
+    if (++batchCount_ == BatchSize) {
+        flushCandidates();
+    }
+}
+
+void LayeredBroadphase::flushCandidates() {
+    const size_t count = batchCount_;
+    stats_.candidatePairs += static_cast<uint32_t>(count);
+
+    // Branch-free over the whole batch: group/category/mask rules, then the
+    // tight bounds (trees hold fat bounds)
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t a = batchA_[i];
+        const uint32_t b = batchB_[i];
+        const int32_t groupA = groupIndex_[a];
+        const int32_t groupB = groupIndex_[b];
+        const bool sameGroup = (groupA == groupB) & (groupA != 0);
+        const bool masks =
+            ((categoryBits_[a] & maskBits_[b]) != 0) & ((categoryBits_[b] & maskBits_[a]) != 0);
+        const bool filter = (sameGroup & (groupA > 0)) | (!sameGroup & masks);
+        const bool overlap =
+            (min_[0][a] <= max_[0][b]) & (min_[0][b] <= max_[0][a]) &
+            (min_[1][a] <= max_[1][b]) & (min_[1][b] <= max_[1][a]) &
+            (min_[2][a] <= max_[2][b]) & (min_[2][b] <= max_[2][a]);
+        batchKeep_[i] = static_cast<uint8_t>(filter & overlap);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (batchKeep_[i] != 0) {
+            const uint32_t a = batchA_[i];
+            const uint32_t b = batchB_[i];
+            pairs_.emplace_back(std::minmax(ids_[a], ids_[b]));
+            stats_.distantPairs += (a > b ? a - b : b - a) > ReorderWindow ? 1u : 0u;
+        }
+    }
+    batchCount_ = 0;
+}
+
+bool LayeredBroadphase::rejectsAll(const Layer& target, uint32_t slot) const noexcept {
+    // A shared positive group overrides the masks, so only reject when that
+    // is impossible
+    const bool groupOverride = groupIndex_[slot] > 0 && target.hasGroups;
+    return !groupOverride && ((categoryBits_[slot] & target.maskUnion) == 0 ||
+                              (maskBits_[slot] & target.categoryUnion) == 0);
+}
+
+//=============================================================================
+// Triggers
+//=============================================================================
+
+void LayeredBroadphase::findTriggerPairs() {
+    triggerFound_.clear();
+    const Layer& triggers = layers_[layerIndex(CollisionLayer::Trigger)];
+    if (triggers.members.empty()) {
+        return;
+    }
+
+    // Overlaps only change where a proxy moved: moved proxies look for the
+    // triggers they touch, moved triggers for the proxies they touch
+    const uint32_t mask = config_.layerPairs.getMask(CollisionLayer::Trigger);
+    for (size_t index = 0; index < CollisionLayerCount; ++index) {
+        const Layer& other = layers_[index];
+        if ((mask & (1u << index)) == 0 || other.members.empty()) {
+            continue;
+        }
+        if (&other != &triggers) {
+            for (const uint32_t slot : other.members) {
+                if (moved_[slot] != 0) {
+                    queryTriggerPairs(slot, triggers);
+                }
+            }
+        }
+        for (const uint32_t slot : triggers.members) {
+            if (moved_[slot] != 0) {
+                queryTriggerPairs(slot, other);
+            }
+        }
+    }
+}
+
+void LayeredBroadphase::queryTriggerPairs(uint32_t slot, const Layer& target) {
+    if (rejectsAll(target, slot)) {
+        ++stats_.skippedQueries;
+        return;
+    }
+    ++stats_.triggerQueries;
+
+    const math::AABB aabb = getSlotAABB(slot);
+    const CollisionFilter filter = getSlotFilter(slot);
+    std::visit(
+        [&](const auto& structure) {
+            structure.query(aabb, [&](ProxyId local) {
+                const auto found = static_cast<uint32_t>(structure.getUserData(local));
+                if (found == slot || !getSlotAABB(found).intersects(aabb) ||
+                    !shouldCollide(filter, getSlotFilter(found))) {
+                    return true;
+                }
+
+                // Key on the trigger, or on the lower id of two triggers
+                ProxyId trigger = ids_[slot];
+                ProxyId other = ids_[found];
+                if (proxies_[trigger].layer != CollisionLayer::Trigger ||
+                    (proxies_[other].layer == CollisionLayer::Trigger && other < trigger)) {
+                    std::swap(trigger, other);
+                }
+                triggerFound_.push_back(uint64_t{trigger} << 32 | other);
+                return true;
+            });
+        },
+        target.structure);
+}
+
+void LayeredBroadphase::updateTriggerOverlaps() {
+    triggerEvents_.clear();
+
+    // Destroyed proxies leave all their overlaps in one pass; then their ids
+    // can be recycled
+    if (!deadTriggerIds_.empty()) {
+        std::erase_if(triggerOverlaps_, [&](uint64_t key) {
+            const ProxyId trigger = static_cast<ProxyId>(key >> 32);
+            const ProxyId other = static_cast<ProxyId>(key);
+            if (proxies_[trigger].alive && proxies_[other].alive) {
+                return false;
+            }
+            --proxies_[trigger].triggerOverlaps;
+            --proxies_[other].triggerOverlaps;
+            triggerEvents_.push_back({trigger, other, TriggerEventType::Exit});
+            return true;
+        });
+        for (const ProxyId id : deadTriggerIds_) {
+            AXIOM_ASSERT(proxies_[id].triggerOverlaps == 0, "Trigger overlap count out of sync");
+            proxies_[id].nextFree = freeList_;
+            freeList_ = id;
+        }
+        deadTriggerIds_.clear();
+    }
+
+    // Overlaps between proxies that did not move still hold; moved ones were
+    // just found again (twice when both sides moved)
+    for (const uint64_t key : triggerOverlaps_) {
+        const ProxyId trigger = static_cast<ProxyId>(key >> 32);
+        const ProxyId other = static_cast<ProxyId>(key);
+        if (moved_[proxies_[trigger].slot] == 0 && moved_[proxies_[other].slot] == 0) {
+            triggerFound_.push_back(key);
+        }
+    }
+    std::sort(triggerFound_.begin(), triggerFound_.end());
+    triggerFound_.erase(std::unique(triggerFound_.begin(), triggerFound_.end()),
+                        triggerFound_.end());
+
+    // Both lists are sorted: keys only in the old one exit, keys only in the
+    // new one enter
+    const auto emit = [&](uint64_t key, TriggerEventType type) {
+        const ProxyId trigger = static_cast<ProxyId>(key >> 32);
+        const ProxyId other = static_cast<ProxyId>(key);
+        if (type == TriggerEventType::Enter) {
+            ++proxies_[trigger].triggerOverlaps;
+            ++proxies_[other].triggerOverlaps;
+        } else {
+            --proxies_[trigger].triggerOverlaps;
+            --proxies_[other].triggerOverlaps;
+        }
+        triggerEvents_.push_back({trigger, other, type});
+    };
+    size_t before = 0;
+    size_t after = 0;
+    while (before < triggerOverlaps_.size() || after < triggerFound_.size()) {
+        if (after == triggerFound_.size() ||
+            (before < triggerOverlaps_.size() && triggerOverlaps_[before] < triggerFound_[after])) {
+            emit(triggerOverlaps_[before++], TriggerEventType::Exit);
+        } else if (before == triggerOverlaps_.size() ||
+                   triggerFound_[after] < triggerOverlaps_[before]) {
+            emit(triggerFound_[after++], TriggerEventType::Enter);
+        } else {
+            ++before;
+            ++after;
+        }
+    }
+
+    triggerOverlaps_.swap(triggerFound_);
+    stats_.triggerOverlaps = static_cast<uint32_t>(triggerOverlaps_.size());
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,125 @@
+#include "axiom/collision/compound_shape.hpp"
+
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace axiom::collision {
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+core::Result<CompoundShape> CompoundShape::create(std::span<const CompoundChild> children) {
+    AXIOM_PROFILE_FUNCTION();
+
+    if (children.empty()) {
+        return core::Result<CompoundShape>::failure(core::ErrorCode::InvalidShape,
+                                                    "Compound has no children");
+    }
+    if (children.size() > UINT32_MAX / 2) {
+        return core::Result<CompoundShape>::failure(core::ErrorCode::InvalidShape,
+                                                    "Compound has too many children");
+    }
+    for (const CompoundChild& child : children) {
+        const ShapeType type = child.shape.type;
+        if (type != ShapeType::Sphere && type != ShapeType::Box && type != ShapeType::Capsule &&
+            type != ShapeType::Convex) {
+            return core::Result<CompoundShape>::failure(
+                core::ErrorCode::InvalidShape,
+                "Compound children must be spheres, boxes, capsules or convex hulls");
+        }
+    }
+
+    CompoundShape compound;
+    compound.children_.assign(children.begin(), children.end());
+    compound.childBounds_.reserve(children.size());
+    for (const CompoundChild& child : children) {
+        const math::AABB bounds = child.shape.computeAABB(child.transform);
+        compound.childBounds_.push_back(bounds);
+        compound.bounds_.merge(bounds);
+        compound.boundingRadius_ =
+            std::max(compound.boundingRadius_,
+                     child.transform.position.length() + child.shape.computeBoundingRadius());
+    }
+
+    const auto count = static_cast<uint32_t>(children.size());
+    compound.leafChildren_.resize(count);
+    std::iota(compound.leafChildren_.begin(), compound.leafChildren_.end(), 0u);
+    compound.nodes_.reserve(2 * size_t{count});
+    compound.build(0, count, 1);
+    return core::Result<CompoundShape>::success(std::move(compound));
+}
+
+uint32_t CompoundShape::build(uint32_t begin, uint32_t end, uint32_t depth) {
+    depth_ = std::max(depth_, depth);
+    const auto index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    math::AABB bounds = childBounds_[leafChildren_[begin]];
+    math::AABB centers(bounds.center());
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        bounds.merge(childBounds_[leafChildren_[i]]);
+        centers.expand(childBounds_[leafChildren_[i]].center());
+    }
+    nodes_[index].bounds = bounds;
+    if (end - begin <= MaxLeafChildren) {
+        nodes_[index].first = begin;
+        nodes_[index].count = end - begin;
+        return index;
+    }
+
+    // Median split along the widest spread of the child centers
+    const math::Vec3 spread = centers.max - centers.min;
+    size_t axis = spread.x >= spread.y ? 0 : 1;
+    axis = spread.z > spread[axis] ? 2 : axis;
+    const uint32_t middle = begin + (end - begin) / 2;
+    const auto first = leafChildren_.begin();
+    std::nth_element(first + begin, first + middle, first + end, [&](uint32_t a, uint32_t b) {
+        return childBounds_[a].center()[axis] < childBounds_[b].center()[axis];
+    });
+    build(begin, middle, depth + 1);
+    nodes_[index].first = build(middle, end, depth + 1);
+    return index;
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+math::Transform CompoundShape::placeChild(uint32_t index,
+                                          const math::Transform& transform) const noexcept {
+    const math::Transform& local = children_[index].transform;
+    return math::Transform(transform.position + transform.rotation * local.position,
+                           transform.rotation * local.rotation);
+}
+
+const math::AABB& CompoundShape::updateBounds(const math::Transform& transform,
+                                              CompoundBoundsCache& cache) const noexcept {
+    if (cache.valid && cache.transform.position == transform.position &&
+        cache.transform.rotation == transform.rotation) {
+        return cache.bounds;
+    }
+    cache.bounds = math::AABB();
+    for (uint32_t child = 0; child < getChildCount(); ++child) {
+        cache.bounds.merge(children_[child].shape.computeAABB(placeChild(child, transform)));
+    }
+    cache.transform = transform;
+    cache.valid = true;
+    return cache.bounds;
+}
+
+//=============================================================================
+// Properties
+//=============================================================================
+
+CompoundShapeStats CompoundShape::getStats() const noexcept {
+    CompoundShapeStats stats;
+    stats.childCount = getChildCount();
+    stats.nodeCount = static_cast<uint32_t>(nodes_.size());
+    stats.depth = depth_;
+    return stats;
+}
+
+}  // namespace axiom::collision
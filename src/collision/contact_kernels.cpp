@@ -0,0 +1,959 @@
+#include "axiom/collision/contact_kernels.hpp"
+
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::Vec3;
+
+constexpr float DirectionEpsilon = 1.0e-6f;
+
+/// Candidate points gathered before reduction; reduced in place when full so
+/// any number of candidates fits
+class PointBuffer {
+public:
+    void add(const ContactPoint& point) noexcept {
+        if (count_ == points_.size()) {
+            count_ = reduceContactPoints(normal_, std::span(points_.data(), count_));
+        }
+        points_[count_++] = point;
+    }
+
+    void setNormal(const Vec3& normal) noexcept { normal_ = normal; }
+
+    const Vec3& getNormal() const noexcept { return normal_; }
+
+    bool isEmpty() const noexcept { return count_ == 0; }
+
+    void clear() noexcept { count_ = 0; }
+
+    void emit(ContactManifold& manifold) noexcept {
+        if (count_ == 0) {
+            return;
+        }
+        count_ = reduceContactPoints(normal_, std::span(points_.data(), count_));
+        manifold.normal = normal_;
+        std::copy_n(points_.begin(), count_, manifold.points.begin());
+        manifold.pointCount = count_;
+    }
+
+private:
+    std::array<ContactPoint, 16> points_;
+    Vec3 normal_;
+    uint32_t count_ = 0;
+};
+
+void addPoint(ContactManifold& manifold, const Vec3& pointA, const Vec3& pointB,
+              float separation, uint32_t featureId) noexcept {
+    AXIOM_ASSERT(manifold.pointCount < MaxManifoldPoints, "Contact manifold is full");
+    manifold.points[manifold.pointCount++] = {pointA, pointB, separation, featureId};
+}
+
+/// Contact between two spheres; the fallback normal is used when the centers coincide
+void collideSpheres(const Vec3& centerA, float radiusA, const Vec3& centerB, float radiusB,
+                    const Vec3& fallbackNormal, float maxDistance, uint32_t featureId,
+                    ContactManifold& manifold) noexcept {
+    const Vec3 delta = centerB - centerA;
+    const float reach = radiusA + radiusB + maxDistance;
+    const float distanceSquared = delta.lengthSquared();
+    if (distanceSquared > reach * reach) {
+        return;
+    }
+    const float distance = std::sqrt(distanceSquared);
+    const Vec3 normal = distance > DirectionEpsilon ? delta / distance : fallbackNormal;
+    manifold.normal = normal;
+    addPoint(manifold, centerA + normal * radiusA, centerB - normal * radiusB,
+             distance - radiusA - radiusB, featureId);
+}
+
+/// Closest point on segment [p, q] to a point, as a parameter in [0, 1]
+float closestOnSegment(const Vec3& p, const Vec3& q, const Vec3& point) noexcept {
+    const Vec3 d = q - p;
+    const float length = d.lengthSquared();
+    return length > 0.0f ? std::clamp((point - p).dot(d) / length, 0.0f, 1.0f) : 0.0f;
+}
+
+/// Closest points between segments [p1, q1] and [p2, q2] as parameters
+/// (Ericson, Real-Time Collision Detection 5.1.9)
+std::pair<float, float> closestBetweenSegments(const Vec3& p1, const Vec3& q1, const Vec3& p2,
+                                               const Vec3& q2) noexcept {
+    const Vec3 d1 = q1 - p1;
+    const Vec3 d2 = q2 - p2;
+    const Vec3 r = p1 - p2;
+    const float a = d1.lengthSquared();
+    const float e = d2.lengthSquared();
+    const float f = d2.dot(r);
+
+    if (a <= DirectionEpsilon && e <= DirectionEpsilon) {
+        return {0.0f, 0.0f};
+    }
+    if (a <= DirectionEpsilon) {
+        return {0.0f, std::clamp(f / e, 0.0f, 1.0f)};
+    }
+    const float c = d1.dot(r);
+    if (e <= DirectionEpsilon) {
+        return {std::clamp(-c / a, 0.0f, 1.0f), 0.0f};
+    }
+
+    const float b = d1.dot(d2);
+    const float denominator = a * e - b * b;
+    float s = denominator > 0.0f ? std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f) : 0.0f;
+    float t = (b * s + f) / e;
+    if (t < 0.0f) {
+        t = 0.0f;
+        s = std::clamp(-c / a, 0.0f, 1.0f);
+    } else if (t > 1.0f) {
+        t = 1.0f;
+        s = std::clamp((b - c) / a, 0.0f, 1.0f);
+    }
+    return {s, t};
+}
+
+/// Segment of a capsule core in world space
+std::pair<Vec3, Vec3> capsuleSegment(const ConvexShape& capsule, const ShapeFrame& frame) noexcept {
+    const Vec3 half = frame.axes[1] * capsule.halfHeight;
+    return {frame.position - half, frame.position + half};
+}
+
+/// Contact between a point of the core of A, swept by its radius, and a plane
+/// owned by B
+void addPlanePoint(const Vec3& core, float radius, const ShapeFrame& plane, float maxDistance,
+                   uint32_t featureId, PointBuffer& buffer) noexcept {
+    const Vec3& up = plane.axes[1];
+    const float height = (core - plane.position).dot(up);
+    const float separation = height - radius;
+    if (separation <= maxDistance) {
+        buffer.add({core - up * radius, core - up * height, separation, featureId});
+    }
+}
+
+//=============================================================================
+// Box-box
+//=============================================================================
+
+/// Feature ids of box-box contacts
+constexpr uint32_t EdgeContactFlag = 0x40000000u;
+constexpr uint32_t ReferenceIsBFlag = 0x80000000u;
+
+/// Vertex of a clipped incident face
+struct ClipVertex {
+    Vec3 position;
+    uint32_t id = 0;
+};
+
+using ClipPolygon = std::array<ClipVertex, 8>;
+
+/// Keep the part of a polygon below the plane dot(n, p) = offset
+uint32_t clipPolygon(const ClipPolygon& input, uint32_t count, const Vec3& normal, float offset,
+                     uint32_t planeIndex, ClipPolygon& output) noexcept {
+    uint32_t outCount = 0;
+    float startDistance = normal.dot(input[count - 1].position) - offset;
+    for (uint32_t i = 0; i < count; ++i) {
+        // Walk the edges (i - 1, i) so each distance is computed once
+        const ClipVertex& start = input[i == 0 ? count - 1 : i - 1];
+        const ClipVertex& end = input[i];
+        const float endDistance = normal.dot(end.position) - offset;
+
+        if (startDistance <= 0.0f) {
+            output[outCount++] = start;
+        }
+        if ((startDistance <= 0.0f) != (endDistance <= 0.0f)) {
+            // The edge crosses the plane: a new vertex named after the plane and edge
+            const float t = startDistance / (startDistance - endDistance);
+            const uint32_t id =
+                0x8000u | (planeIndex << 8) | ((start.id & 0xFu) << 4) | (end.id & 0xFu);
+            output[outCount++] = {start.position + (end.position - start.position) * t, id};
+        }
+        startDistance = endDistance;
+    }
+    return outCount;
+}
+
+struct Box {
+    ShapeFrame frame;
+    Vec3 halfExtents;
+};
+
+/// Face contact: clip the incident face of `incident` against the reference
+/// face `axis` of `reference`
+void boxFaceContact(const Box& reference, const Box& incident, size_t axis, bool referenceIsB,
+                    float maxDistance, ContactManifold& manifold) noexcept {
+    const Vec3 towardIncident = incident.frame.position - reference.frame.position;
+    const float sign = reference.frame.axes[axis].dot(towardIncident) >= 0.0f ? 1.0f : -1.0f;
+    const Vec3 referenceNormal = reference.frame.axes[axis] * sign;
+
+    // The incident face is the one most anti-parallel to the reference normal
+    size_t incidentAxis = 0;
+    float best = -1.0f;
+    for (size_t k = 0; k < 3; ++k) {
+        const float alignment = std::abs(incident.frame.axes[k].dot(referenceNormal));
+        if (alignment > best) {
+            best = alignment;
+            incidentAxis = k;
+        }
+    }
+    const float incidentSign =
+        incident.frame.axes[incidentAxis].dot(referenceNormal) > 0.0f ? -1.0f : 1.0f;
+    const size_t u = (incidentAxis + 1) % 3;
+    const size_t v = (incidentAxis + 2) % 3;
+    const Vec3 faceCenter = incident.frame.position + incident.frame.axes[incidentAxis] *
+                                                          (incidentSign *
+                                                           incident.halfExtents[incidentAxis]);
+    const Vec3 du = incident.frame.axes[u] * incident.halfExtents[u];
+    const Vec3 dv = incident.frame.axes[v] * incident.halfExtents[v];
+
+    // Ping-pong between two buffers instead of copying after every plane
+    std::array<ClipPolygon, 2> buffers;
+    ClipPolygon* polygon = &buffers[0];
+    ClipPolygon* scratch = &buffers[1];
+    (*polygon)[0] = {faceCenter + du + dv, 0};
+    (*polygon)[1] = {faceCenter - du + dv, 1};
+    (*polygon)[2] = {faceCenter - du - dv, 2};
+    (*polygon)[3] = {faceCenter + du - dv, 3};
+    uint32_t count = 4;
+
+    // Clip against the four side planes of the reference face
+    const size_t a1 = (axis + 1) % 3;
+    const size_t a2 = (axis + 2) % 3;
+    uint32_t planeIndex = 0;
+    for (const size_t side : {a1, a2}) {
+        for (const float direction : {1.0f, -1.0f}) {
+            const Vec3 normal = reference.frame.axes[side] * direction;
+            const float offset =
+                normal.dot(reference.frame.position) + reference.halfExtents[side];
+            count = clipPolygon(*polygon, count, normal, offset, planeIndex++, *scratch);
+            std::swap(polygon, scratch);
+            if (count == 0) {
+                return;
+            }
+        }
+    }
+
+    const Vec3 referenceCenter =
+        reference.frame.position + referenceNormal * reference.halfExtents[axis];
+    const uint32_t referenceFace = static_cast<uint32_t>(axis) * 2 + (sign < 0.0f ? 1 : 0);
+    const uint32_t incidentFace =
+        static_cast<uint32_t>(incidentAxis) * 2 + (incidentSign < 0.0f ? 1 : 0);
+    const uint32_t faceBits = (referenceIsB ? ReferenceIsBFlag : 0) | (referenceFace << 24) |
+                              (incidentFace << 16);
+
+    // A quad clipped by four planes has at most eight vertices, so the
+    // candidates fit without the reducing PointBuffer
+    std::array<ContactPoint, 8> candidates;
+    uint32_t candidateCount = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const Vec3& point = (*polygon)[i].position;
+        const float separation = (point - referenceCenter).dot(referenceNormal);
+        if (separation > maxDistance) {
+            continue;
+        }
+        const Vec3 onReference = point - referenceNormal * separation;
+        const uint32_t featureId = faceBits | (*polygon)[i].id;
+        if (referenceIsB) {
+            candidates[candidateCount++] = {point, onReference, separation, featureId};
+        } else {
+            candidates[candidateCount++] = {onReference, point, separation, featureId};
+        }
+    }
+    if (candidateCount == 0) {
+        return;
+    }
+    const Vec3 normal = referenceIsB ? -referenceNormal : referenceNormal;
+    const uint32_t kept =
+        reduceContactPoints(normal, std::span(candidates.data(), candidateCount));
+    manifold.normal = normal;
+    std::copy_n(candidates.begin(), kept, manifold.points.begin());
+    manifold.pointCount = kept;
+}
+
+/// Edge contact between edge axis i of A and edge axis j of B
+void boxEdgeContact(const Box& a, const Box& b, size_t i, size_t j, float maxDistance,
+                    ContactManifold& manifold) noexcept {
+    Vec3 axis = a.frame.axes[i].cross(b.frame.axes[j]).normalized();
+    if (axis.dot(b.frame.position - a.frame.position) < 0.0f) {
+        axis = -axis;
+    }
+
+    // The supporting edge of each box along the axis
+    uint32_t edgeBits = 0;
+    Vec3 centerA = a.frame.position;
+    Vec3 centerB = b.frame.position;
+    for (size_t k = 0; k < 3; ++k) {
+        if (k != i) {
+            const bool positive = a.frame.axes[k].dot(axis) > 0.0f;
+            centerA += a.frame.axes[k] * (positive ? a.halfExtents[k] : -a.halfExtents[k]);
+            edgeBits |= (positive ? 1u : 0u) << k;
+        }
+        if (k != j) {
+            const bool positive = b.frame.axes[k].dot(axis) < 0.0f;
+            centerB += b.frame.axes[k] * (positive ? b.halfExtents[k] : -b.halfExtents[k]);
+            edgeBits |= (positive ? 1u : 0u) << (k + 3);
+        }
+    }
+    const Vec3 halfA = a.frame.axes[i] * a.halfExtents[i];
+    const Vec3 halfB = b.frame.axes[j] * b.halfExtents[j];
+    const auto [s, t] =
+        closestBetweenSegments(centerA - halfA, centerA + halfA, centerB - halfB, centerB + halfB);
+    const Vec3 pointA = centerA - halfA + halfA * (2.0f * s);
+    const Vec3 pointB = centerB - halfB + halfB * (2.0f * t);
+    const float separation = (pointB - pointA).dot(axis);
+    if (separation > maxDistance) {
+        return;
+    }
+    manifold.normal = axis;
+    addPoint(manifold, pointA, pointB, separation,
+             EdgeContactFlag | (static_cast<uint32_t>(i * 3 + j) << 8) | edgeBits);
+}
+
+//=============================================================================
+// Batch kernels
+//=============================================================================
+
+using BatchKernel = void (*)(std::span<const ContactPair> pairs, std::span<const uint32_t> order,
+                             float maxDistance, ContactManifold* manifolds);
+
+constexpr size_t BatchChunk = 64;
+
+template <ContactKernel Kernel>
+void runBatch(std::span<const ContactPair> pairs, std::span<const uint32_t> order,
+              float maxDistance, ContactManifold* manifolds) {
+    for (const uint32_t index : order) {
+        manifolds[index].clear();
+        Kernel(pairs[index], maxDistance, manifolds[index]);
+    }
+}
+
+/// Sphere-sphere over structure-of-arrays chunks: the distance math is
+/// branch-free and vectorizes; only touching pairs write a point
+void batchSphereSphere(std::span<const ContactPair> pairs, std::span<const uint32_t> order,
+                       float maxDistance, ContactManifold* manifolds) {
+    std::array<float, BatchChunk> dx, dy, dz, radiusA, radiusB, distance;
+    for (size_t base = 0; base < order.size(); base += BatchChunk) {
+        const size_t count = std::min(BatchChunk, order.size() - base);
+        for (size_t k = 0; k < count; ++k) {
+            const ContactPair& pair = pairs[order[base + k]];
+            const Vec3 delta = pair.transformB->position - pair.transformA->position;
+            dx[k] = delta.x;
+            dy[k] = delta.y;
+            dz[k] = delta.z;
+            radiusA[k] = pair.shapeA->radius;
+            radiusB[k] = pair.shapeB->radius;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            distance[k] = std::sqrt(dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k]);
+        }
+        for (size_t k = 0; k < count; ++k) {
+            ContactManifold& manifold = manifolds[order[base + k]];
+            manifold.clear();
+            const float separation = distance[k] - radiusA[k] - radiusB[k];
+            if (separation > maxDistance) {
+                continue;
+            }
+            const Vec3 normal = distance[k] > DirectionEpsilon
+                                    ? Vec3(dx[k], dy[k], dz[k]) / distance[k]
+                                    : Vec3::unitY();
+            const ContactPair& pair = pairs[order[base + k]];
+            manifold.normal = normal;
+            addPoint(manifold, pair.transformA->position + normal * radiusA[k],
+                     pair.transformB->position - normal * radiusB[k], separation, 0);
+        }
+    }
+}
+
+/// Sphere-plane over structure-of-arrays chunks
+void batchSpherePlane(std::span<const ContactPair> pairs, std::span<const uint32_t> order,
+                      float maxDistance, ContactManifold* manifolds) {
+    std::array<float, BatchChunk> height, radius;
+    std::array<Vec3, BatchChunk> up;
+    for (size_t base = 0; base < order.size(); base += BatchChunk) {
+        const size_t count = std::min(BatchChunk, order.size() - base);
+        for (size_t k = 0; k < count; ++k) {
+            const ContactPair& pair = pairs[order[base + k]];
+            up[k] = ShapeFrame(*pair.transformB).axes[1];
+            height[k] = (pair.transformA->position - pair.transformB->position).dot(up[k]);
+            radius[k] = pair.shapeA->radius;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            ContactManifold& manifold = manifolds[order[base + k]];
+            manifold.clear();
+            const float separation = height[k] - radius[k];
+            if (separation > maxDistance) {
+                continue;
+            }
+            const Vec3& center = pairs[order[base + k]].transformA->position;
+            manifold.normal = -up[k];
+            addPoint(manifold, center - up[k] * radius[k], center - up[k] * height[k],
+                     separation, 0);
+        }
+    }
+}
+
+constexpr size_t kernelIndex(ShapeType a, ShapeType b) {
+    return static_cast<size_t>(a) * ShapeTypeCount + static_cast<size_t>(b);
+}
+
+template <size_t... Index>
+constexpr std::array<BatchKernel, sizeof...(Index)> makeBatchKernels(
+    std::index_sequence<Index...>) {
+    std::array<BatchKernel, sizeof...(Index)> kernels = {
+        &runBatch<ContactKernels[Index / ShapeTypeCount][Index % ShapeTypeCount]>...};
+    kernels[kernelIndex(ShapeType::Sphere, ShapeType::Sphere)] = &batchSphereSphere;
+    kernels[kernelIndex(ShapeType::Sphere, ShapeType::Plane)] = &batchSpherePlane;
+    return kernels;
+}
+
+/// Batch kernels indexed by typeA * ShapeTypeCount + typeB
+constexpr auto BatchKernels =
+    makeBatchKernels(std::make_index_sequence<ShapeTypeCount * ShapeTypeCount>());
+
+}  // namespace
+
+//=============================================================================
+// Sphere kernels
+//=============================================================================
+
+void collideSphereSphere(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    collideSpheres(pair.transformA->position, pair.shapeA->radius, pair.transformB->position,
+                   pair.shapeB->radius, Vec3::unitY(), maxDistance, 0, manifold);
+}
+
+void collideSphereBox(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const Vec3& center = pair.transformA->position;
+    const float radiusA = pair.shapeA->radius;
+    const float radiusB = pair.shapeB->radius;
+    const Vec3& halfExtents = pair.shapeB->halfExtents;
+    const ShapeFrame box(*pair.transformB);
+
+    const Vec3 local = box.toLocal(center);
+    const Vec3 clamped(std::clamp(local.x, -halfExtents.x, halfExtents.x),
+                       std::clamp(local.y, -halfExtents.y, halfExtents.y),
+                       std::clamp(local.z, -halfExtents.z, halfExtents.z));
+    const Vec3 delta = local - clamped;
+    const float distanceSquared = delta.lengthSquared();
+
+    Vec3 surface = clamped;
+    Vec3 outward;
+    float separation;
+    uint32_t featureId = 0;
+    if (distanceSquared > 0.0f) {
+        const float reach = radiusA + radiusB + maxDistance;
+        if (distanceSquared > reach * reach) {
+            return;
+        }
+        const float distance = std::sqrt(distanceSquared);
+        outward = delta / distance;
+        separation = distance - radiusA - radiusB;
+    } else {
+        // Center inside the box: push out through the nearest face
+        size_t axis = 0;
+        float depth = halfExtents.x - std::abs(local.x);
+        for (size_t k = 1; k < 3; ++k) {
+            const float faceDepth = halfExtents[k] - std::abs(local[k]);
+            if (faceDepth < depth) {
+                depth = faceDepth;
+                axis = k;
+            }
+        }
+        const float sign = local[axis] < 0.0f ? -1.0f : 1.0f;
+        outward = Vec3::zero();
+        outward[axis] = sign;
+        surface[axis] = sign * halfExtents[axis];
+        separation = -depth - radiusA - radiusB;
+        featureId = 1 + static_cast<uint32_t>(axis) * 2 + (sign < 0.0f ? 1 : 0);
+    }
+
+    const Vec3 normal = -box.rotate(outward);
+    manifold.normal = normal;
+    addPoint(manifold, center + normal * radiusA, box.toWorld(surface) - normal * radiusB,
+             separation, featureId);
+}
+
+void collideSphereCapsule(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const Vec3& center = pair.transformA->position;
+    const auto [p, q] = capsuleSegment(*pair.shapeB, ShapeFrame(*pair.transformB));
+    const Vec3 closest = p + (q - p) * closestOnSegment(p, q, center);
+    collideSpheres(center, pair.shapeA->radius, closest, pair.shapeB->radius, Vec3::unitY(),
+                   maxDistance, 0, manifold);
+}
+
+void collideSpherePlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const ShapeFrame plane(*pair.transformB);
+    PointBuffer buffer;
+    buffer.setNormal(-plane.axes[1]);
+    addPlanePoint(pair.transformA->position, pair.shapeA->radius, plane, maxDistance, 0, buffer);
+    buffer.emit(manifold);
+}
+
+//=============================================================================
+// Box kernels
+//=============================================================================
+
+void collideBoxBox(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    if (pair.shapeA->radius > 0.0f || pair.shapeB->radius > 0.0f) {
+        // Separating axes are not exact for rounded boxes
+        collideConvexGeneric(pair, maxDistance, manifold);
+        return;
+    }
+
+    const Box a{ShapeFrame(*pair.transformA), pair.shapeA->halfExtents};
+    const Box b{ShapeFrame(*pair.transformB), pair.shapeB->halfExtents};
+
+    // Rotation of B in A's frame, and the offset between them in both frames
+    std::array<std::array<float, 3>, 3> rotation;
+    std::array<std::array<float, 3>, 3> absRotation;
+    bool parallel = false;
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            rotation[i][j] = a.frame.axes[i].dot(b.frame.axes[j]);
+            absRotation[i][j] = std::abs(rotation[i][j]) + DirectionEpsilon;
+            parallel |= absRotation[i][j] >= 1.0f;
+        }
+    }
+    const Vec3 offset = b.frame.position - a.frame.position;
+    const Vec3 offsetA = a.frame.unrotate(offset);
+    const Vec3 offsetB = b.frame.unrotate(offset);
+
+    // Face axes of A and B
+    float faceSeparationA = -std::numeric_limits<float>::max();
+    float faceSeparationB = -std::numeric_limits<float>::max();
+    size_t faceA = 0;
+    size_t faceB = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const float extent = a.halfExtents[i] + absRotation[i][0] * b.halfExtents[0] +
+                             absRotation[i][1] * b.halfExtents[1] +
+                             absRotation[i][2] * b.halfExtents[2];
+        const float separation = std::abs(offsetA[i]) - extent;
+        if (separation > maxDistance) {
+            return;
+        }
+        if (separation > faceSeparationA) {
+            faceSeparationA = separation;
+            faceA = i;
+        }
+    }
+    for (size_t j = 0; j < 3; ++j) {
+        const float extent = b.halfExtents[j] + absRotation[0][j] * a.halfExtents[0] +
+                             absRotation[1][j] * a.halfExtents[1] +
+                             absRotation[2][j] * a.halfExtents[2];
+        const float separation = std::abs(offsetB[j]) - extent;
+        if (separation > maxDistance) {
+            return;
+        }
+        if (separation > faceSeparationB) {
+            faceSeparationB = separation;
+            faceB = j;
+        }
+    }
+
+    // Edge axes A_i x B_j (Ericson, Real-Time Collision Detection 4.4.1)
+    float edgeSeparation = -std::numeric_limits<float>::max();
+    size_t edgeA = 0;
+    size_t edgeB = 0;
+    if (!parallel) {
+        for (size_t i = 0; i < 3; ++i) {
+            const size_t i1 = (i + 1) % 3;
+            const size_t i2 = (i + 2) % 3;
+            for (size_t j = 0; j < 3; ++j) {
+                const size_t j1 = (j + 1) % 3;
+                const size_t j2 = (j + 2) % 3;
+                const float length = std::sqrt(rotation[i1][j] * rotation[i1][j] +
+                                               rotation[i2][j] * rotation[i2][j]);
+                if (length < 1.0e-3f) {
+                    continue;
+                }
+                const float extentA =
+                    a.halfExtents[i1] * absRotation[i2][j] + a.halfExtents[i2] * absRotation[i1][j];
+                const float extentB =
+                    b.halfExtents[j1] * absRotation[i][j2] + b.halfExtents[j2] * absRotation[i][j1];
+                const float distance =
+                    std::abs(offsetA[i2] * rotation[i1][j] - offsetA[i1] * rotation[i2][j]);
+                const float separation = (distance - extentA - extentB) / length;
+                if (separation > maxDistance) {
+                    return;
+                }
+                if (separation > edgeSeparation) {
+                    edgeSeparation = separation;
+                    edgeA = i;
+                    edgeB = j;
+                }
+            }
+        }
+    }
+
+    // Prefer faces, and A's faces, unless the alternative is clearly better:
+    // this keeps the chosen features stable from frame to frame
+    constexpr float RelativeTolerance = 0.98f;
+    constexpr float AbsoluteTolerance = 0.001f;
+    const bool useB = faceSeparationB > RelativeTolerance * faceSeparationA + AbsoluteTolerance;
+    const float faceSeparation = useB ? faceSeparationB : faceSeparationA;
+    if (edgeSeparation > RelativeTolerance * faceSeparation + AbsoluteTolerance) {
+        boxEdgeContact(a, b, edgeA, edgeB, maxDistance, manifold);
+    } else if (useB) {
+        boxFaceContact(b, a, faceB, true, maxDistance, manifold);
+    } else {
+        boxFaceContact(a, b, faceA, false, maxDistance, manifold);
+    }
+}
+
+void collideBoxPlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const ShapeFrame box(*pair.transformA);
+    const ShapeFrame plane(*pair.transformB);
+    const Vec3& halfExtents = pair.shapeA->halfExtents;
+
+    PointBuffer buffer;
+    buffer.setNormal(-plane.axes[1]);
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        const Vec3 local((corner & 1) != 0 ? halfExtents.x : -halfExtents.x,
+                         (corner & 2) != 0 ? halfExtents.y : -halfExtents.y,
+                         (corner & 4) != 0 ? halfExtents.z : -halfExtents.z);
+        addPlanePoint(box.toWorld(local), pair.shapeA->radius, plane, maxDistance, corner, buffer);
+    }
+    buffer.emit(manifold);
+}
+
+//=============================================================================
+// Capsule kernels
+//=============================================================================
+
+void collideCapsuleCapsule(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const auto [p1, q1] = capsuleSegment(*pair.shapeA, ShapeFrame(*pair.transformA));
+    const auto [p2, q2] = capsuleSegment(*pair.shapeB, ShapeFrame(*pair.transformB));
+    const float radiusA = pair.shapeA->radius;
+    const float radiusB = pair.shapeB->radius;
+    const Vec3 d1 = q1 - p1;
+    const Vec3 d2 = q2 - p2;
+
+    // Intersecting cores give no direction; fall back to the common perpendicular
+    Vec3 fallback = d1.cross(d2);
+    if (fallback.lengthSquared() <= DirectionEpsilon) {
+        fallback = Vec3::unitY();
+    } else {
+        fallback = fallback.normalized();
+        if (fallback.dot(pair.transformB->position - pair.transformA->position) < 0.0f) {
+            fallback = -fallback;
+        }
+    }
+
+    // Parallel capsules lying along each other touch along a line: two points
+    const float lengths = d1.lengthSquared() * d2.lengthSquared();
+    if (lengths > 0.0f && d1.cross(d2).lengthSquared() <= 1.0e-4f * lengths) {
+        const float inverseLength = 1.0f / d1.lengthSquared();
+        const float t0 = (p2 - p1).dot(d1) * inverseLength;
+        const float t1 = (q2 - p1).dot(d1) * inverseLength;
+        const float begin = std::max(0.0f, std::min(t0, t1));
+        const float end = std::min(1.0f, std::max(t0, t1));
+        if (end - begin > 1.0e-3f) {
+            uint32_t featureId = 1;
+            for (const float t : {begin, end}) {
+                const Vec3 onA = p1 + d1 * t;
+                const Vec3 onB = p2 + d2 * closestOnSegment(p2, q2, onA);
+                collideSpheres(onA, radiusA, onB, radiusB, fallback, maxDistance, featureId++,
+                               manifold);
+            }
+            return;
+        }
+    }
+
+    const auto [s, t] = closestBetweenSegments(p1, q1, p2, q2);
+    collideSpheres(p1 + d1 * s, radiusA, p2 + d2 * t, radiusB, fallback, maxDistance, 0,
+                   manifold);
+}
+
+void collideCapsulePlane(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const auto [p, q] = capsuleSegment(*pair.shapeA, ShapeFrame(*pair.transformA));
+    const ShapeFrame plane(*pair.transformB);
+    PointBuffer buffer;
+    buffer.setNormal(-plane.axes[1]);
+    addPlanePoint(p, pair.shapeA->radius, plane, maxDistance, 0, buffer);
+    addPlanePoint(q, pair.shapeA->radius, plane, maxDistance, 1, buffer);
+    buffer.emit(manifold);
+}
+
+//=============================================================================
+// Convex kernels
+//=============================================================================
+
+void collidePlaneConvex(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    // Run as convex-vs-plane, then hand the result back in plane-convex order
+    const ShapeFrame hull(*pair.transformB);
+    const ShapeFrame plane(*pair.transformA);
+    const ConvexShape& shape = *pair.shapeB;
+
+    PointBuffer buffer;
+    buffer.setNormal(-plane.axes[1]);
+    for (uint32_t i = 0; i < shape.vertexCount; ++i) {
+        addPlanePoint(hull.toWorld(shape.vertices[i]), shape.radius, plane, maxDistance, i, buffer);
+    }
+    buffer.emit(manifold);
+    manifold.flip();
+}
+
+//=============================================================================
+// Mesh and height field kernels
+//=============================================================================
+
+namespace {
+
+/// Bounds of the bounded shape B, grown by maxDistance, in the space of A
+math::AABB getLocalBounds(const ContactPair& pair, float maxDistance) noexcept {
+    const ShapeFrame frame(*pair.transformA);
+    math::AABB bounds = pair.shapeB->computeAABB(*pair.transformB);
+    bounds.expand(maxDistance);
+    const Vec3 center = frame.toLocal(bounds.center());
+    const Vec3 extents = bounds.extents();
+    Vec3 localExtents;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const Vec3& direction = frame.axes[axis];
+        localExtents[axis] = std::abs(direction.x) * extents.x +
+                             std::abs(direction.y) * extents.y +
+                             std::abs(direction.z) * extents.z;
+    }
+    return math::AABB(center - localExtents, center + localExtents);
+}
+
+/// GJK/EPA of the convex B against each triangle of A overlapping its bounds
+/// @param query Calls queryAABB(localBounds, callback) on the mesh or height field
+template <typename Query>
+void collideTrianglesConvex(const ContactPair& pair, float maxDistance, ContactManifold& manifold,
+                            Query&& query) {
+    // Triangles whose normal is within ~25 degrees of the manifold normal share it
+    constexpr float NormalTolerance = 0.9f;
+
+    PointBuffer buffer;
+    float deepest = std::numeric_limits<float>::max();
+    const auto addTriangle = [&](uint32_t triangle, const std::array<Vec3, 3>& vertices) {
+        const ConvexShape shape = ConvexShape::convex(vertices);
+        const ConvexContact contact =
+            collideConvex(shape, *pair.transformA, *pair.shapeB, *pair.transformB, maxDistance);
+        if (!contact.touching) {
+            return true;
+        }
+        if (buffer.isEmpty()) {
+            buffer.setNormal(contact.normal);
+        } else if (contact.normal.dot(buffer.getNormal()) < NormalTolerance) {
+            // A deeper contact on a differently facing triangle takes over
+            if (contact.distance >= deepest) {
+                return true;
+            }
+            buffer.clear();
+            buffer.setNormal(contact.normal);
+        }
+        deepest = std::min(deepest, contact.distance);
+        buffer.add({contact.pointA, contact.pointB, contact.distance, triangle});
+        return true;
+    };
+    query(getLocalBounds(pair, maxDistance), addTriangle);
+    buffer.emit(manifold);
+}
+
+}  // namespace
+
+void collideMeshConvex(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const TriangleMesh& mesh = *pair.shapeA->mesh;
+    collideTrianglesConvex(pair, maxDistance, manifold,
+                           [&](const math::AABB& bounds, const auto& callback) {
+                               mesh.queryAABB(bounds, callback);
+                           });
+}
+
+void collideHeightFieldConvex(const ContactPair& pair, float maxDistance,
+                              ContactManifold& manifold) {
+    const HeightField& terrain = *pair.shapeA->terrain;
+    collideTrianglesConvex(pair, maxDistance, manifold,
+                           [&](const math::AABB& bounds, const auto& callback) {
+                               terrain.queryAABB(bounds, callback);
+                           });
+}
+
+//=============================================================================
+// Distance field kernel
+//=============================================================================
+
+void collideDistanceFieldConvex(const ContactPair& pair, float maxDistance,
+                                ContactManifold& manifold) {
+    // Points whose normal is within ~25 degrees of the manifold normal share it
+    constexpr float NormalTolerance = 0.9f;
+
+    const SignedDistanceField& field = *pair.shapeA->sdf;
+    const ConvexShape& shape = *pair.shapeB;
+    math::AABB bounds = shape.computeAABB(*pair.transformB);
+    bounds.expand(maxDistance);
+    if (!pair.shapeA->computeAABB(*pair.transformA).intersects(bounds)) {
+        return;
+    }
+
+    const ShapeFrame frame(*pair.transformA);
+    const ShapeFrame hull(*pair.transformB);
+    PointBuffer buffer;
+    float deepest = std::numeric_limits<float>::max();
+    shape.forEachCorePoint([&](uint32_t index, const Vec3& localPoint) {
+        const Vec3 core = hull.toWorld(localPoint);
+        Vec3 gradient;
+        const float distance = field.sampleGradient(frame.toLocal(core), gradient);
+        const float separation = distance - shape.radius;
+        const float length = gradient.length();
+        if (separation > maxDistance || length < DirectionEpsilon) {
+            return;
+        }
+        const Vec3 normal = frame.rotate(gradient / length);
+        if (buffer.isEmpty()) {
+            buffer.setNormal(normal);
+        } else if (normal.dot(buffer.getNormal()) < NormalTolerance) {
+            // A deeper point on a differently facing part of the surface takes over
+            if (separation >= deepest) {
+                return;
+            }
+            buffer.clear();
+            buffer.setNormal(normal);
+        }
+        deepest = std::min(deepest, separation);
+        buffer.add({core - normal * distance, core - normal * shape.radius, separation, index});
+    });
+    buffer.emit(manifold);
+}
+
+//=============================================================================
+// Compound kernel
+//=============================================================================
+
+namespace {
+
+/// Feature id of a child's contact point, distinct for each child
+uint32_t getCompoundFeatureId(uint32_t child, uint32_t featureId) noexcept {
+    if (featureId == NoFeatureId) {
+        return NoFeatureId;
+    }
+    const uint32_t mixed = featureId ^ ((child + 1) * 0x9E3779B1u);
+    return mixed == NoFeatureId ? mixed - 1 : mixed;
+}
+
+}  // namespace
+
+void collideCompound(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    // Children whose normal is within ~25 degrees of the manifold normal share it
+    constexpr float NormalTolerance = 0.9f;
+
+    const CompoundShape& compound = *pair.shapeA->compound;
+    const ConvexShape& other = *pair.shapeB;
+
+    // Only the children near B; every child may touch a plane
+    const math::AABB bounds =
+        other.type == ShapeType::Plane ? compound.getBounds() : getLocalBounds(pair, maxDistance);
+
+    PointBuffer buffer;
+    float deepest = std::numeric_limits<float>::max();
+    compound.queryAABB(bounds, [&](uint32_t child) {
+        const ConvexShape& shape = compound.getChild(child).shape;
+        const math::Transform transform = compound.placeChild(child, *pair.transformA);
+        const ContactPair childPair{&shape, &transform, &other, pair.transformB, nullptr};
+        ContactManifold childManifold;
+        getContactKernel(shape.type, other.type)(childPair, maxDistance, childManifold);
+        if (childManifold.pointCount == 0) {
+            return true;
+        }
+        float childDeepest = std::numeric_limits<float>::max();
+        for (uint32_t i = 0; i < childManifold.pointCount; ++i) {
+            childDeepest = std::min(childDeepest, childManifold.points[i].separation);
+        }
+        if (buffer.isEmpty()) {
+            buffer.setNormal(childManifold.normal);
+        } else if (childManifold.normal.dot(buffer.getNormal()) < NormalTolerance) {
+            // A deeper contact on a differently facing child takes over
+            if (childDeepest >= deepest) {
+                return true;
+            }
+            buffer.clear();
+            buffer.setNormal(childManifold.normal);
+        }
+        deepest = std::min(deepest, childDeepest);
+        for (uint32_t i = 0; i < childManifold.pointCount; ++i) {
+            ContactPoint point = childManifold.points[i];
+            point.featureId = getCompoundFeatureId(child, point.featureId);
+            buffer.add(point);
+        }
+        return true;
+    });
+    buffer.emit(manifold);
+}
+
+//=============================================================================
+// Generic kernels
+//=============================================================================
+
+void collideConvexGeneric(const ContactPair& pair, float maxDistance, ContactManifold& manifold) {
+    const ConvexContact contact = collideConvex(*pair.shapeA, *pair.transformA, *pair.shapeB,
+                                                *pair.transformB, maxDistance, pair.cache);
+    if (!contact.touching) {
+        return;
+    }
+    manifold.normal = contact.normal;
+    addPoint(manifold, contact.pointA, contact.pointB, contact.distance, NoFeatureId);
+}
+
+void collideNothing(const ContactPair&, float, ContactManifold&) {}
+
+//=============================================================================
+// ContactDispatcher
+//=============================================================================
+
+void ContactDispatcher::generate(std::span<const ContactPair> pairs, float maxDistance,
+                                 std::span<ContactManifold> manifolds) {
+    AXIOM_PROFILE_SCOPE("ContactDispatcher::generate");
+    AXIOM_PROFILE_ELEMENTS(pairs.size());
+    AXIOM_ASSERT(manifolds.size() >= pairs.size(), "One manifold per pair is required");
+
+    stats_ = {};
+    stats_.pairCount = static_cast<uint32_t>(pairs.size());
+
+    // Counting sort of the pairs by kernel
+    const auto kernelOf = [](const ContactPair& pair) {
+        return kernelIndex(pair.shapeA->type, pair.shapeB->type);
+    };
+    bucketStart_.fill(0);
+    for (const ContactPair& pair : pairs) {
+        ++bucketStart_[kernelOf(pair) + 1];
+    }
+    for (size_t k = 1; k < bucketStart_.size(); ++k) {
+        bucketStart_[k] += bucketStart_[k - 1];
+    }
+    order_.resize(pairs.size());
+    std::array<uint32_t, ShapeTypeCount * ShapeTypeCount> cursor;
+    std::copy_n(bucketStart_.begin(), cursor.size(), cursor.begin());
+    for (uint32_t index = 0; index < pairs.size(); ++index) {
+        order_[cursor[kernelOf(pairs[index])]++] = index;
+    }
+
+    for (size_t kernel = 0; kernel < BatchKernels.size(); ++kernel) {
+        const uint32_t begin = bucketStart_[kernel];
+        const uint32_t end = bucketStart_[kernel + 1];
+        if (begin == end) {
+            continue;
+        }
+        BatchKernels[kernel](pairs, std::span(order_).subspan(begin, end - begin), maxDistance,
+                             manifolds.data());
+        if (ContactKernels[kernel / ShapeTypeCount][kernel % ShapeTypeCount] ==
+            &collideConvexGeneric) {
+            stats_.genericCount += end - begin;
+        }
+    }
+
+    for (size_t index = 0; index < pairs.size(); ++index) {
+        const uint32_t points = manifolds[index].pointCount;
+        stats_.touchingCount += points > 0 ? 1 : 0;
+        stats_.pointCount += points;
+    }
+}
+
+}  // namespace axiom::collision
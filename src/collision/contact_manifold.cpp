@@ -0,0 +1,226 @@
+#include "axiom/collision/contact_manifold.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace axiom::collision {
+
+void ContactManifold::flip() noexcept {
+    normal = -normal;
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        std::swap(points[i].pointA, points[i].pointB);
+    }
+}
+
+//=============================================================================
+// Reduction
+//=============================================================================
+
+namespace {
+
+/// Area-maximizing selection over any point type with pointB and separation
+template <typename Point>
+uint32_t reducePoints(const math::Vec3& normal, std::span<Point> points) noexcept {
+    const auto count = static_cast<uint32_t>(points.size());
+    if (count <= MaxManifoldPoints) {
+        return count;
+    }
+
+    // Positions are compared on B's surface; the separation is along the normal
+    const auto position = [&](uint32_t index) { return points[index].pointB; };
+
+    // 1. The deepest point
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < count; ++i) {
+        if (points[i].separation < points[best].separation) {
+            best = i;
+        }
+    }
+    std::swap(points[0], points[best]);
+
+    // 2. The point furthest from it
+    const math::Vec3 p0 = position(0);
+    best = 1;
+    float bestScore = -1.0f;
+    for (uint32_t i = 1; i < count; ++i) {
+        const float score = (position(i) - p0).lengthSquared();
+        if (score > bestScore) {
+            bestScore = score;
+            best = i;
+        }
+    }
+    std::swap(points[1], points[best]);
+
+    // 3. The point making the largest triangle with them, on either side
+    const math::Vec3 p1 = position(1);
+    best = 2;
+    bestScore = -1.0f;
+    for (uint32_t i = 2; i < count; ++i) {
+        const float area = std::abs((p1 - p0).cross(position(i) - p0).dot(normal));
+        if (area > bestScore) {
+            bestScore = area;
+            best = i;
+        }
+    }
+    std::swap(points[2], points[best]);
+
+    // 4. The point furthest outside that triangle: the most negative signed
+    // area against one of its edges
+    const math::Vec3 p2 = position(2);
+    const float winding = (p1 - p0).cross(p2 - p0).dot(normal) < 0.0f ? -1.0f : 1.0f;
+    best = 3;
+    bestScore = 0.0f;
+    for (uint32_t i = 3; i < count; ++i) {
+        const math::Vec3 q = position(i);
+        const float a0 = (p1 - p0).cross(q - p0).dot(normal) * winding;
+        const float a1 = (p2 - p1).cross(q - p1).dot(normal) * winding;
+        const float a2 = (p0 - p2).cross(q - p2).dot(normal) * winding;
+        const float outside = std::min(a0, std::min(a1, a2));
+        if (outside < bestScore) {
+            bestScore = outside;
+            best = i;
+        }
+    }
+    if (bestScore == 0.0f) {
+        // Every other point lies inside the triangle
+        return 3;
+    }
+    std::swap(points[3], points[best]);
+    return MaxManifoldPoints;
+}
+
+}  // namespace
+
+uint32_t reduceContactPoints(const math::Vec3& normal, std::span<ContactPoint> points) noexcept {
+    return reducePoints(normal, points);
+}
+
+//=============================================================================
+// PersistentManifold
+//=============================================================================
+
+void PersistentManifold::update(const ContactManifold& contacts,
+                                const math::Transform& transformA,
+                                const math::Transform& transformB,
+                                const PersistentManifoldSettings& settings) {
+    matchedCount_ = 0;
+    if (contacts.pointCount == 0) {
+        clear();
+        return;
+    }
+
+    // Old points are measured against the new normal
+    const ShapeFrame frameA(transformA);
+    const ShapeFrame frameB(transformB);
+    normal_ = contacts.normal;
+    refresh(frameA, frameB, settings);
+
+    std::array<ManifoldPoint, 2 * MaxManifoldPoints> merged;
+    std::array<int32_t, MaxManifoldPoints> matchOf;
+    std::array<bool, MaxManifoldPoints> taken{};
+    const uint32_t newCount = contacts.pointCount;
+
+    // Match by feature id first, then the remaining points by proximity, so
+    // a near miss cannot steal the old point of an exact feature match
+    for (uint32_t i = 0; i < newCount; ++i) {
+        matchOf[i] = -1;
+        const uint32_t featureId = contacts.points[i].featureId;
+        if (featureId == NoFeatureId) {
+            continue;
+        }
+        for (uint32_t j = 0; j < pointCount_; ++j) {
+            if (!taken[j] && points_[j].featureId == featureId) {
+                matchOf[i] = static_cast<int32_t>(j);
+                taken[j] = true;
+                break;
+            }
+        }
+    }
+    const float matchDistanceSquared = settings.matchDistance * settings.matchDistance;
+    for (uint32_t i = 0; i < newCount; ++i) {
+        if (matchOf[i] >= 0) {
+            continue;
+        }
+        float best = matchDistanceSquared;
+        for (uint32_t j = 0; j < pointCount_; ++j) {
+            const float distanceSquared =
+                (points_[j].pointB - contacts.points[i].pointB).lengthSquared();
+            if (!taken[j] && distanceSquared <= best) {
+                best = distanceSquared;
+                matchOf[i] = static_cast<int32_t>(j);
+            }
+        }
+        if (matchOf[i] >= 0) {
+            taken[static_cast<size_t>(matchOf[i])] = true;
+        }
+    }
+
+    // New points, carrying the solver state of their match
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < newCount; ++i) {
+        const ContactPoint& contact = contacts.points[i];
+        ManifoldPoint& point = merged[count++];
+        point.localA = frameA.toLocal(contact.pointA);
+        point.localB = frameB.toLocal(contact.pointB);
+        point.pointA = contact.pointA;
+        point.pointB = contact.pointB;
+        point.separation = contact.separation;
+        point.featureId = contact.featureId;
+        if (matchOf[i] >= 0) {
+            const ManifoldPoint& old = points_[static_cast<size_t>(matchOf[i])];
+            point.normalImpulse = old.normalImpulse;
+            point.tangentImpulse = old.tangentImpulse;
+            point.lifetime = old.lifetime;
+            ++matchedCount_;
+        }
+    }
+
+    // Old points that were not regenerated but are still in contact
+    for (uint32_t j = 0; j < pointCount_; ++j) {
+        if (!taken[j]) {
+            merged[count++] = points_[j];
+        }
+    }
+
+    if (count > MaxManifoldPoints) {
+        count = reducePoints(normal_, std::span(merged.data(), count));
+    }
+    std::copy_n(merged.begin(), count, points_.begin());
+    pointCount_ = count;
+}
+
+void PersistentManifold::refresh(const math::Transform& transformA,
+                                 const math::Transform& transformB,
+                                 const PersistentManifoldSettings& settings) {
+    if (pointCount_ > 0) {
+        refresh(ShapeFrame(transformA), ShapeFrame(transformB), settings);
+    }
+}
+
+void PersistentManifold::refresh(const ShapeFrame& frameA, const ShapeFrame& frameB,
+                                 const PersistentManifoldSettings& settings) noexcept {
+    const float driftSquared = settings.driftDistance * settings.driftDistance;
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < pointCount_; ++i) {
+        ManifoldPoint point = points_[i];
+        point.pointA = frameA.toWorld(point.localA);
+        point.pointB = frameB.toWorld(point.localB);
+        const math::Vec3 delta = point.pointB - point.pointA;
+        point.separation = delta.dot(normal_);
+        if (point.separation > settings.breakingDistance) {
+            continue;
+        }
+        // The anchors slid apart along the surface: the point no longer exists
+        const math::Vec3 tangential = delta - normal_ * point.separation;
+        if (tangential.lengthSquared() > driftSquared) {
+            continue;
+        }
+        ++point.lifetime;
+        points_[kept++] = point;
+    }
+    pointCount_ = kept;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,384 @@
+#include "axiom/collision/continuous_collision.hpp"
+
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Transform;
+using math::Vec3;
+
+/// Meshes and height fields, which are advanced against triangle by triangle
+bool isTriangulated(const ConvexShape& shape) noexcept {
+    return shape.type == ShapeType::Mesh || shape.type == ShapeType::HeightField;
+}
+
+/// Distance between two placed shapes, for conservative advancement
+struct Separation {
+    float distance = 0.0f;
+    Vec3 normal;  ///< From A to B
+    Vec3 pointA;
+    Vec3 pointB;
+};
+
+bool isBounded(const ConvexShape& shape) noexcept {
+    return shape.type != ShapeType::Plane && shape.type != ShapeType::DistanceField &&
+           !isTriangulated(shape);
+}
+
+bool isContinuous(const BodyMotion& motion) noexcept {
+    return motion.mode != CcdMode::None;
+}
+
+/// Largest speed of any point of a body relative to its origin, from rotation
+float getRotationSpeed(const BodyMotion& motion) noexcept {
+    return motion.angularVelocity.length() * motion.shape->computeBoundingRadius();
+}
+
+/// Gap between the bodies' bounding boxes at the start of the step; a lower
+/// bound on their separation that does not depend on GJK
+float getBoundsSeparation(const BodyMotion& a, const BodyMotion& b) noexcept {
+    const AABB boundsA = a.shape->computeAABB(a.transform);
+    const AABB boundsB = b.shape->computeAABB(b.transform);
+    float gap = -std::numeric_limits<float>::max();
+    for (size_t axis = 0; axis < 3; ++axis) {
+        gap = std::max({gap, boundsB.min[axis] - boundsA.max[axis],
+                        boundsA.min[axis] - boundsB.max[axis]});
+    }
+    return gap;
+}
+
+Separation flipped(const Separation& separation) noexcept {
+    return {separation.distance, -separation.normal, separation.pointB, separation.pointA};
+}
+
+/// Separation of the nearest child of a compound
+/// @param measure Called as Separation(const ConvexShape& child, const Transform& placement)
+template <typename Measure>
+Separation measureChildren(const ConvexShape& shape, const Transform& transform,
+                           Measure&& measure) noexcept {
+    const CompoundShape& compound = *shape.compound;
+    Separation nearest;
+    nearest.distance = std::numeric_limits<float>::max();
+    for (uint32_t child = 0; child < compound.getChildCount(); ++child) {
+        const Separation separation =
+            measure(compound.getChild(child).shape, compound.placeChild(child, transform));
+        if (separation.distance < nearest.distance) {
+            nearest = separation;
+        }
+    }
+    return nearest;
+}
+
+/// Separation of two bounded shapes (GJK, warm-started across advancement
+/// steps); a compound is as far as its nearest child
+Separation measureConvex(const ConvexShape& a, const Transform& transformA, const ConvexShape& b,
+                         const Transform& transformB, SimplexCache& cache) noexcept {
+    if (a.type == ShapeType::Compound) {
+        return measureChildren(a, transformA, [&](const ConvexShape& child,
+                                                  const Transform& placement) {
+            SimplexCache childCache;
+            return measureConvex(child, placement, b, transformB, childCache);
+        });
+    }
+    if (b.type == ShapeType::Compound) {
+        return flipped(measureConvex(b, transformB, a, transformA, cache));
+    }
+    const ConvexContact contact = collideConvex(a, transformA, b, transformB,
+                                                std::numeric_limits<float>::max(), &cache);
+    return {contact.distance, contact.normal, contact.pointA, contact.pointB};
+}
+
+/// Separation of a bounded shape A above a plane B
+Separation measurePlane(const ConvexShape& a, const Transform& transformA,
+                        const Transform& transformB) noexcept {
+    if (a.type == ShapeType::Compound) {
+        return measureChildren(a, transformA, [&](const ConvexShape& child,
+                                                  const Transform& placement) {
+            return measurePlane(child, placement, transformB);
+        });
+    }
+    const ShapeFrame frameA(transformA);
+    const ShapeFrame plane(transformB);
+    const Vec3 up = plane.axes[1];
+    const Vec3 lowest = frameA.toWorld(a.supportCore(frameA.unrotate(-up))) - up * a.radius;
+    const float distance = up.dot(lowest - plane.position);
+    return {distance, -up, lowest, lowest - up * distance};
+}
+
+/// Advance two bodies until the measured separation reaches the target
+/// @param limit Stop once the time passes this (seconds), without an impact
+template <typename Measure>
+TimeOfImpact advance(const BodyMotion& a, const BodyMotion& b, float dt, float limit,
+                     const CcdSettings& settings, Measure&& measure) noexcept {
+    // Rotation moves no point of a body faster than this
+    const float rotationSpeed = getRotationSpeed(a) + getRotationSpeed(b);
+    const Vec3 relativeVelocity = a.linearVelocity - b.linearVelocity;
+    const float target = settings.toiSeparation;
+    const float tolerance = 0.25f * target;
+
+    TimeOfImpact impact;
+    float time = 0.0f;
+    Separation separation;
+    while (impact.iterations < settings.maxToiIterations) {
+        ++impact.iterations;
+        separation = measure(integrateMotion(a, time), integrateMotion(b, time));
+        float distance = separation.distance;
+        float closing = relativeVelocity.dot(separation.normal);
+        if (time == 0.0f && distance <= target + tolerance) {
+            // A contact at the start that the bounding boxes rule out is a
+            // failed measurement, not an impact: advance on the box gap at
+            // the fastest closing speed instead
+            const float bounds = getBoundsSeparation(a, b);
+            if (bounds > target + tolerance) {
+                distance = bounds;
+                closing = relativeVelocity.length();
+            }
+        }
+        if (distance <= target + tolerance) {
+            if (time == 0.0f && closing <= 0.0f) {
+                return impact;  // Already touching but leaving
+            }
+            break;
+        }
+
+        // No point closes the gap faster than this
+        const float approach = closing + rotationSpeed;
+        if (approach <= 1.0e-9f) {
+            return impact;
+        }
+        time += (distance - target) / approach;
+        if (time > std::min(dt, limit)) {
+            return impact;
+        }
+    }
+
+    impact.hit = true;
+    impact.fraction = dt > 0.0f ? time / dt : 0.0f;
+    impact.normal = separation.normal;
+    impact.pointA = separation.pointA;
+    impact.pointB = separation.pointB;
+    return impact;
+}
+
+/// Time of impact of a bounded body A against a mesh or height field body B,
+/// triangle by triangle
+TimeOfImpact advanceAgainstTriangles(const BodyMotion& a, const BodyMotion& b, float dt,
+                                const CcdSettings& settings) noexcept {
+    // Triangles under A's sweep, relative to wherever B moves during the step
+    BodyMotion sweeping = a;
+    sweeping.mode = CcdMode::Speculative;
+    AABB swept = computeSweptAABB(sweeping, dt);
+    swept.expand((b.linearVelocity.length() + getRotationSpeed(b)) * dt);
+    const ShapeFrame frame(b.transform);
+    AABB local;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        local.expand(frame.toLocal(Vec3((corner & 1) != 0 ? swept.max.x : swept.min.x,
+                                            (corner & 2) != 0 ? swept.max.y : swept.min.y,
+                                            (corner & 4) != 0 ? swept.max.z : swept.min.z)));
+    }
+
+    TimeOfImpact first;
+    uint32_t iterations = 0;
+    const auto addTriangle = [&](uint32_t, const std::array<Vec3, 3>& vertices) {
+        const ConvexShape triangle = ConvexShape::convex(vertices);
+        SimplexCache cache;
+        const TimeOfImpact impact =
+            advance(a, b, dt, first.fraction * dt, settings,
+                    [&](const Transform& transformA, const Transform& transformB) {
+                        return measureConvex(*a.shape, transformA, triangle, transformB, cache);
+                    });
+        iterations += impact.iterations;
+        if (impact.hit && (!first.hit || impact.fraction < first.fraction)) {
+            first = impact;
+        }
+        return true;
+    };
+    if (b.shape->type == ShapeType::Mesh) {
+        b.shape->mesh->queryAABB(local, addTriangle);
+    } else {
+        b.shape->terrain->queryAABB(local, addTriangle);
+    }
+    first.iterations = iterations;
+    return first;
+}
+
+}  // namespace
+
+//=============================================================================
+// Motion and bounds
+//=============================================================================
+
+math::Transform integrateMotion(const BodyMotion& motion, float time) noexcept {
+    Transform transform = motion.transform;
+    transform.position = motion.transform.position + motion.linearVelocity * time;
+    const float angularSpeed = motion.angularVelocity.length();
+    if (angularSpeed > 1.0e-9f) {
+        const math::Quat turn =
+            math::Quat::fromAxisAngle(motion.angularVelocity / angularSpeed, angularSpeed * time);
+        transform.rotation = turn * motion.transform.rotation;
+    }
+    return transform;
+}
+
+math::AABB computeSweptAABB(const BodyMotion& motion, float dt) noexcept {
+    AXIOM_ASSERT(motion.shape != nullptr, "Body motion without a shape");
+    const AABB start = motion.shape->computeAABB(motion.transform);
+    if (!isContinuous(motion)) {
+        return start;
+    }
+
+    // Every point of the body is its start position moved by the linear
+    // motion, plus at most the arc rotation moves it along
+    const Vec3 displacement = motion.linearVelocity * dt;
+    AABB swept = start;
+    swept.merge(AABB(start.min + displacement, start.max + displacement));
+    const float angle = motion.angularVelocity.length() * dt;
+    if (angle > 0.0f) {
+        const float radius = motion.shape->computeBoundingRadius();
+        swept.expand(std::min(radius * angle, 2.0f * radius));
+    }
+    return swept;
+}
+
+//=============================================================================
+// Speculative contacts
+//=============================================================================
+
+void generateSpeculativeContacts(const BodyMotion& a, const BodyMotion& b, float dt,
+                                 ContactManifold& manifold, SimplexCache* cache,
+                                 const CcdSettings& settings) {
+    AXIOM_ASSERT(a.shape != nullptr && b.shape != nullptr, "Body motion without a shape");
+    const bool continuous = isContinuous(a) || isContinuous(b);
+    float reach = 0.0f;
+    if (continuous) {
+        const float speed = (a.linearVelocity - b.linearVelocity).length() +
+                            getRotationSpeed(a) + getRotationSpeed(b);
+        reach = std::min(speed * dt, settings.maxSpeculativeDistance);
+    }
+
+    const ContactPair pair{a.shape, &a.transform, b.shape, &b.transform, cache};
+    generateContacts(pair, settings.contactMargin + reach, manifold);
+    if (!continuous) {
+        return;
+    }
+
+    // Keep the points the bodies close within the step
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        const ContactPoint& point = manifold.points[i];
+        const Vec3 velocityA =
+            a.linearVelocity + a.angularVelocity.cross(point.pointA - a.transform.position);
+        const Vec3 velocityB =
+            b.linearVelocity + b.angularVelocity.cross(point.pointB - b.transform.position);
+        const float closing = (velocityA - velocityB).dot(manifold.normal);
+        if (point.separation <= settings.contactMargin + std::max(closing, 0.0f) * dt) {
+            manifold.points[kept++] = point;
+        }
+    }
+    manifold.pointCount = kept;
+}
+
+//=============================================================================
+// Time of impact
+//=============================================================================
+
+TimeOfImpact computeTimeOfImpact(const BodyMotion& a, const BodyMotion& b, float dt,
+                                 const CcdSettings& settings) noexcept {
+    AXIOM_ASSERT(a.shape != nullptr && b.shape != nullptr, "Body motion without a shape");
+    const ConvexShape& shapeA = *a.shape;
+    const ConvexShape& shapeB = *b.shape;
+    const float limit = std::numeric_limits<float>::max();
+
+    if (isBounded(shapeA) && isBounded(shapeB)) {
+        SimplexCache cache;
+        return advance(a, b, dt, limit, settings,
+                       [&](const Transform& transformA, const Transform& transformB) {
+                           return measureConvex(shapeA, transformA, shapeB, transformB, cache);
+                       });
+    }
+    if (isBounded(shapeA) && shapeB.type == ShapeType::Plane) {
+        return advance(a, b, dt, limit, settings,
+                       [&](const Transform& transformA, const Transform& transformB) {
+                           return measurePlane(shapeA, transformA, transformB);
+                       });
+    }
+    if (shapeA.type == ShapeType::Plane && isBounded(shapeB)) {
+        return advance(a, b, dt, limit, settings,
+                       [&](const Transform& transformA, const Transform& transformB) {
+                           return flipped(measurePlane(shapeB, transformB, transformA));
+                       });
+    }
+    if (isBounded(shapeA) && isTriangulated(shapeB)) {
+        return advanceAgainstTriangles(a, b, dt, settings);
+    }
+    if (isTriangulated(shapeA) && isBounded(shapeB)) {
+        TimeOfImpact impact = advanceAgainstTriangles(b, a, dt, settings);
+        impact.normal = -impact.normal;
+        std::swap(impact.pointA, impact.pointB);
+        return impact;
+    }
+    return {};
+}
+
+uint32_t computeBulletImpacts(std::span<const BodyMotion> bodies,
+                              std::span<const std::pair<uint32_t, uint32_t>> pairs, float dt,
+                              std::span<TimeOfImpact> impacts, const CcdSettings& settings) {
+    AXIOM_PROFILE_SCOPE("computeBulletImpacts");
+    AXIOM_PROFILE_ELEMENTS(pairs.size());
+    AXIOM_ASSERT(impacts.size() >= bodies.size(), "One impact is needed per body");
+
+    std::fill(impacts.begin(), impacts.begin() + static_cast<std::ptrdiff_t>(bodies.size()),
+              TimeOfImpact{});
+    const auto keepFirst = [](TimeOfImpact& current, const TimeOfImpact& impact) {
+        if (!current.hit || impact.fraction < current.fraction) {
+            current = impact;
+        }
+    };
+    for (const auto& [indexA, indexB] : pairs) {
+        const BodyMotion& a = bodies[indexA];
+        const BodyMotion& b = bodies[indexB];
+        const bool bulletA = a.mode == CcdMode::Bullet;
+        const bool bulletB = b.mode == CcdMode::Bullet;
+        if (!bulletA && !bulletB) {
+            continue;
+        }
+
+        const TimeOfImpact impact = computeTimeOfImpact(a, b, dt, settings);
+        if (!impact.hit) {
+            continue;
+        }
+        if (bulletA) {
+            keepFirst(impacts[indexA], impact);
+        }
+        if (bulletB) {
+            TimeOfImpact seenFromB = impact;
+            seenFromB.normal = -impact.normal;
+            seenFromB.pointA = impact.pointB;
+            seenFromB.pointB = impact.pointA;
+            keepFirst(impacts[indexB], seenFromB);
+        }
+    }
+
+    uint32_t hitCount = 0;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        if (impacts[i].hit) {
+            ++hitCount;
+        }
+    }
+    return hitCount;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,493 @@
+#include "axiom/collision/convex_hull.hpp"
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Vec3;
+
+constexpr uint32_t NoFace = UINT32_MAX;
+
+/// Triangle of the hull under construction
+struct BuildFace {
+    std::array<uint32_t, 3> vertices{};  ///< Point indices, counter-clockwise from outside
+    std::array<uint32_t, 3> neighbors{NoFace, NoFace, NoFace};  ///< Across edge i -> i + 1
+    Vec3 normal;
+    float offset = 0.0f;
+    std::vector<uint32_t> outside;  ///< Points above the face
+    uint32_t furthest = 0;          ///< Outside point furthest from the face
+    float furthestDistance = 0.0f;
+    uint32_t visitMark = 0;
+    bool removed = false;
+
+    float distance(const Vec3& point) const noexcept { return normal.dot(point) - offset; }
+};
+
+/// Edge of the region a new point sees, with the face beyond it that stays
+struct HorizonEdge {
+    uint32_t from;
+    uint32_t to;
+    uint32_t face;
+};
+
+/// Incremental quickhull over a point cloud
+class HullBuilder {
+public:
+    HullBuilder(std::span<const Vec3> points, float tolerance)
+        : points_(points), tolerance_(tolerance), startAt_(points.size(), NoFace),
+          endAt_(points.size(), NoFace) {}
+
+    /// Create the starting tetrahedron; false if the points are (nearly) planar
+    bool buildSimplex(const char*& error);
+
+    /// Add points until none is outside or the hull has maxVertices vertices
+    void expand(uint32_t maxVertices);
+
+    const std::vector<BuildFace>& getFaces() const noexcept { return faces_; }
+
+private:
+    uint32_t addFace(uint32_t a, uint32_t b, uint32_t c);
+
+    /// Give each point to the face it is furthest above, unless it is within
+    /// tolerance of the hull
+    void assignPoints(std::span<const uint32_t> candidates, std::span<const uint32_t> faces);
+
+    /// Whether a point is within tolerance of one of the faces' triangles
+    bool isNearFaces(uint32_t point, std::span<const uint32_t> faces) const noexcept;
+
+    /// Add a point above a face; false if its horizon is not a simple loop
+    bool addPoint(uint32_t eyeFace);
+
+    std::span<const Vec3> points_;
+    float tolerance_;
+    std::vector<BuildFace> faces_;
+    /// Faces with points outside, by furthest distance; entries go stale as
+    /// faces are removed and are skipped then
+    std::priority_queue<std::pair<float, uint32_t>> queue_;
+    uint32_t vertexCount_ = 0;
+    uint32_t visitMark_ = 0;
+
+    // Scratch, kept across points
+    std::vector<uint32_t> startAt_;  ///< New face whose horizon edge starts at a point
+    std::vector<uint32_t> endAt_;    ///< New face whose horizon edge ends at a point
+    std::vector<uint32_t> visible_;
+    std::vector<uint32_t> stack_;
+    std::vector<HorizonEdge> horizon_;
+    std::vector<uint32_t> newFaces_;
+    std::vector<uint32_t> orphans_;
+};
+
+uint32_t HullBuilder::addFace(uint32_t a, uint32_t b, uint32_t c) {
+    BuildFace face;
+    face.vertices = {a, b, c};
+    const Vec3& pa = points_[a];
+    const Vec3& pb = points_[b];
+    const Vec3& pc = points_[c];
+    face.normal = (pb - pa).cross(pc - pa).normalized();
+    face.offset = face.normal.dot((pa + pb + pc) / 3.0f);
+    faces_.push_back(std::move(face));
+    return static_cast<uint32_t>(faces_.size() - 1);
+}
+
+bool HullBuilder::buildSimplex(const char*& error) {
+    // Two most distant extreme points along the axes
+    std::array<uint32_t, 6> extremes{};
+    for (uint32_t i = 0; i < points_.size(); ++i) {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (points_[i][axis] < points_[extremes[2 * axis]][axis]) {
+                extremes[2 * axis] = i;
+            }
+            if (points_[i][axis] > points_[extremes[2 * axis + 1]][axis]) {
+                extremes[2 * axis + 1] = i;
+            }
+        }
+    }
+    uint32_t a = extremes[0];
+    uint32_t b = extremes[1];
+    for (size_t axis = 1; axis < 3; ++axis) {
+        const uint32_t low = extremes[2 * axis];
+        const uint32_t high = extremes[2 * axis + 1];
+        if ((points_[high] - points_[low]).lengthSquared() >
+            (points_[b] - points_[a]).lengthSquared()) {
+            a = low;
+            b = high;
+        }
+    }
+    if ((points_[b] - points_[a]).length() <= tolerance_) {
+        error = "Convex hull points are coincident";
+        return false;
+    }
+
+    // Furthest from the line, then furthest from the plane
+    const Vec3 axis = (points_[b] - points_[a]).normalized();
+    uint32_t c = a;
+    float best = 0.0f;
+    for (uint32_t i = 0; i < points_.size(); ++i) {
+        const float distance = (points_[i] - points_[a]).cross(axis).length();
+        if (distance > best) {
+            best = distance;
+            c = i;
+        }
+    }
+    if (best <= tolerance_) {
+        error = "Convex hull points are collinear";
+        return false;
+    }
+    const Vec3 normal = (points_[b] - points_[a]).cross(points_[c] - points_[a]).normalized();
+    uint32_t d = a;
+    best = 0.0f;
+    for (uint32_t i = 0; i < points_.size(); ++i) {
+        const float distance = std::abs(normal.dot(points_[i] - points_[a]));
+        if (distance > best) {
+            best = distance;
+            d = i;
+        }
+    }
+    if (best <= tolerance_) {
+        error = "Convex hull points are coplanar";
+        return false;
+    }
+
+    // Orient the base away from the apex; the sides then follow from it
+    if (normal.dot(points_[d] - points_[a]) > 0.0f) {
+        std::swap(b, c);
+    }
+    addFace(a, b, c);
+    addFace(a, d, b);
+    addFace(b, d, c);
+    addFace(c, d, a);
+    faces_[0].neighbors = {1, 2, 3};
+    faces_[1].neighbors = {3, 2, 0};
+    faces_[2].neighbors = {1, 3, 0};
+    faces_[3].neighbors = {2, 1, 0};
+    vertexCount_ = 4;
+
+    std::vector<uint32_t> candidates;
+    candidates.reserve(points_.size());
+    for (uint32_t i = 0; i < points_.size(); ++i) {
+        if (i != a && i != b && i != c && i != d) {
+            candidates.push_back(i);
+        }
+    }
+    const std::array<uint32_t, 4> simplex = {0, 1, 2, 3};
+    assignPoints(candidates, simplex);
+    return true;
+}
+
+void HullBuilder::assignPoints(std::span<const uint32_t> candidates,
+                               std::span<const uint32_t> faces) {
+    for (const uint32_t point : candidates) {
+        uint32_t bestFace = NoFace;
+        float bestDistance = 0.0f;
+        for (const uint32_t face : faces) {
+            const float distance = faces_[face].distance(points_[point]);
+            if (distance > bestDistance) {
+                bestDistance = distance;
+                bestFace = face;
+            }
+        }
+        // Within tolerance of a plane is not within tolerance of the hull: on
+        // a flat cloud, faces meet at knife edges, and a point metres beyond
+        // one is barely above either plane. Such points stay outside.
+        if (bestFace == NoFace || (bestDistance <= tolerance_ && isNearFaces(point, faces))) {
+            continue;  // Inside the hull: dropped for good
+        }
+        BuildFace& face = faces_[bestFace];
+        if (face.outside.empty() || bestDistance > face.furthestDistance) {
+            face.furthest = point;
+            face.furthestDistance = bestDistance;
+        }
+        face.outside.push_back(point);
+    }
+    for (const uint32_t face : faces) {
+        if (!faces_[face].outside.empty()) {
+            queue_.emplace(faces_[face].furthestDistance, face);
+        }
+    }
+}
+
+bool HullBuilder::isNearFaces(uint32_t point, std::span<const uint32_t> faces) const noexcept {
+    const Vec3& position = points_[point];
+    for (const uint32_t face : faces) {
+        const std::array<uint32_t, 3>& vertices = faces_[face].vertices;
+        const Vec3 closest = detail::closestPointOnTriangle(
+            position, points_[vertices[0]], points_[vertices[1]], points_[vertices[2]]);
+        if ((closest - position).lengthSquared() <= tolerance_ * tolerance_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HullBuilder::expand(uint32_t maxVertices) {
+    while (vertexCount_ < maxVertices) {
+        // Point furthest outside the hull: the best vertex to add next
+        if (queue_.empty()) {
+            return;
+        }
+        const auto [furthest, eyeFace] = queue_.top();
+        queue_.pop();
+        const BuildFace& top = faces_[eyeFace];
+        if (top.removed || top.outside.empty() || top.furthestDistance != furthest) {
+            continue;
+        }
+        if (addPoint(eyeFace)) {
+            ++vertexCount_;
+            continue;
+        }
+
+        // Rounding left the visible region with a hole in it: skip the point,
+        // which is within a few tolerances of the hull
+        BuildFace& face = faces_[eyeFace];
+        face.outside.erase(std::find(face.outside.begin(), face.outside.end(), face.furthest));
+        face.furthestDistance = 0.0f;
+        for (const uint32_t point : face.outside) {
+            const float distance = face.distance(points_[point]);
+            if (distance > face.furthestDistance) {
+                face.furthestDistance = distance;
+                face.furthest = point;
+            }
+        }
+        if (!face.outside.empty()) {
+            queue_.emplace(face.furthestDistance, eyeFace);
+        }
+    }
+}
+
+bool HullBuilder::addPoint(uint32_t eyeFace) {
+    const uint32_t eye = faces_[eyeFace].furthest;
+    const Vec3& eyePoint = points_[eye];
+
+    // Faces the point sees, and the edges where they meet the others
+    ++visitMark_;
+    visible_.clear();
+    horizon_.clear();
+    stack_.clear();
+    stack_.push_back(eyeFace);
+    faces_[eyeFace].visitMark = visitMark_;
+    while (!stack_.empty()) {
+        const uint32_t index = stack_.back();
+        stack_.pop_back();
+        visible_.push_back(index);
+        const BuildFace& face = faces_[index];
+        for (uint32_t edge = 0; edge < 3; ++edge) {
+            const uint32_t neighbor = face.neighbors[edge];
+            BuildFace& other = faces_[neighbor];
+            if (other.visitMark == visitMark_) {
+                continue;
+            }
+            // Every face the point is above goes, even within tolerance: a
+            // face kept there leaves a concave edge, and points dropped as
+            // inside behind it can end up outside by many tolerances
+            if (other.distance(eyePoint) > 0.0f) {
+                other.visitMark = visitMark_;
+                stack_.push_back(neighbor);
+            } else {
+                horizon_.push_back({face.vertices[edge], face.vertices[(edge + 1) % 3], neighbor});
+            }
+        }
+    }
+
+    // The horizon must be one loop through distinct vertices
+    bool simple = true;
+    for (uint32_t i = 0; i < horizon_.size(); ++i) {
+        simple = simple && startAt_[horizon_[i].from] == NoFace;
+        startAt_[horizon_[i].from] = i;
+    }
+    if (simple) {
+        uint32_t edge = 0;
+        size_t length = 0;
+        do {
+            edge = startAt_[horizon_[edge].to];
+            ++length;
+        } while (edge != NoFace && edge != 0 && length < horizon_.size());
+        simple = edge == 0 && length == horizon_.size();
+    }
+    for (const HorizonEdge& edge : horizon_) {
+        startAt_[edge.from] = NoFace;
+    }
+    if (!simple) {
+        return false;
+    }
+
+    // Close the horizon with a fan of faces around the point
+    newFaces_.clear();
+    for (const HorizonEdge& edge : horizon_) {
+        const uint32_t index = addFace(edge.from, edge.to, eye);
+        newFaces_.push_back(index);
+        startAt_[edge.from] = index;
+        endAt_[edge.to] = index;
+        BuildFace& beyond = faces_[edge.face];
+        for (uint32_t side = 0; side < 3; ++side) {
+            if (beyond.vertices[side] == edge.to && beyond.vertices[(side + 1) % 3] == edge.from) {
+                beyond.neighbors[side] = index;
+            }
+        }
+    }
+    for (size_t i = 0; i < horizon_.size(); ++i) {
+        BuildFace& face = faces_[newFaces_[i]];
+        face.neighbors = {horizon_[i].face, startAt_[horizon_[i].to], endAt_[horizon_[i].from]};
+    }
+    for (const HorizonEdge& edge : horizon_) {
+        startAt_[edge.from] = NoFace;
+        endAt_[edge.to] = NoFace;
+    }
+
+    // Points above the removed faces move to the new ones
+    orphans_.clear();
+    for (const uint32_t index : visible_) {
+        BuildFace& face = faces_[index];
+        face.removed = true;
+        for (const uint32_t point : face.outside) {
+            if (point != eye) {
+                orphans_.push_back(point);
+            }
+        }
+        std::vector<uint32_t>().swap(face.outside);
+    }
+    assignPoints(orphans_, newFaces_);
+    return true;
+}
+
+}  // namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+core::Result<ConvexHull> ConvexHull::create(std::span<const math::Vec3> points,
+                                            const ConvexHullConfig& config) {
+    AXIOM_PROFILE_FUNCTION();
+    AXIOM_ASSERT(config.maxVertices >= 4, "maxVertices must be at least 4");
+
+    if (points.size() < 4) {
+        return core::Result<ConvexHull>::failure(core::ErrorCode::InvalidShape,
+                                                 "Convex hull needs at least 4 points");
+    }
+    AABB cloud;
+    for (const Vec3& point : points) {
+        cloud.expand(point);
+    }
+    const float tolerance = config.relativeTolerance * (cloud.max - cloud.min).length();
+
+    HullBuilder builder(points, tolerance);
+    const char* error = nullptr;
+    if (!builder.buildSimplex(error)) {
+        return core::Result<ConvexHull>::failure(core::ErrorCode::InvalidShape, error);
+    }
+    builder.expand(config.maxVertices);
+
+    // Compact the surviving faces and the points they use, in input order
+    const std::vector<BuildFace>& faces = builder.getFaces();
+    std::vector<uint32_t> faceIndex(faces.size(), NoFace);
+    std::vector<uint32_t> vertexIndex(points.size(), NoFace);
+    uint32_t faceCount = 0;
+    for (uint32_t i = 0; i < faces.size(); ++i) {
+        if (!faces[i].removed) {
+            faceIndex[i] = faceCount++;
+            for (const uint32_t point : faces[i].vertices) {
+                vertexIndex[point] = 0;
+            }
+        }
+    }
+
+    ConvexHull hull;
+    for (uint32_t i = 0; i < points.size(); ++i) {
+        if (vertexIndex[i] != NoFace) {
+            vertexIndex[i] = static_cast<uint32_t>(hull.vertices_.size());
+            hull.vertices_.push_back(points[i]);
+            hull.bounds_.expand(points[i]);
+        }
+    }
+    hull.indices_.reserve(3 * size_t{faceCount});
+    hull.planes_.reserve(faceCount);
+    hull.faceNeighbors_.reserve(3 * size_t{faceCount});
+    for (const BuildFace& face : faces) {
+        if (face.removed) {
+            continue;
+        }
+        for (uint32_t i = 0; i < 3; ++i) {
+            hull.indices_.push_back(vertexIndex[face.vertices[i]]);
+            hull.faceNeighbors_.push_back(faceIndex[face.neighbors[i]]);
+        }
+        hull.planes_.push_back({face.normal, face.offset});
+    }
+
+    // Vertex-edge graph: every edge is the edge u -> v of exactly one face,
+    // and v -> u of the face across it
+    const uint32_t vertexCount = hull.getVertexCount();
+    hull.neighborOffsets_.assign(vertexCount + 1, 0);
+    for (const uint32_t vertex : hull.indices_) {
+        ++hull.neighborOffsets_[vertex + 1];
+    }
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        hull.neighborOffsets_[i + 1] += hull.neighborOffsets_[i];
+    }
+    hull.vertexNeighbors_.assign(hull.indices_.size(), 0);
+    std::vector<uint32_t> cursor(hull.neighborOffsets_.begin(), hull.neighborOffsets_.end() - 1);
+    for (size_t face = 0; face < faceCount; ++face) {
+        for (size_t i = 0; i < 3; ++i) {
+            const uint32_t from = hull.indices_[3 * face + i];
+            hull.vertexNeighbors_[cursor[from]++] = hull.indices_[3 * face + (i + 1) % 3];
+        }
+    }
+
+    for (size_t axis = 0; axis < 3; ++axis) {
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            const Vec3& vertex = hull.vertices_[i];
+            if (vertex[axis] < hull.vertices_[hull.seeds_[2 * axis]][axis]) {
+                hull.seeds_[2 * axis] = i;
+            }
+            if (vertex[axis] > hull.vertices_[hull.seeds_[2 * axis + 1]][axis]) {
+                hull.seeds_[2 * axis + 1] = i;
+            }
+        }
+    }
+    return core::Result<ConvexHull>::success(std::move(hull));
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+uint32_t ConvexHull::supportIndex(const math::Vec3& direction) const noexcept {
+    AXIOM_ASSERT(!vertices_.empty(), "Convex hull is empty");
+
+    uint32_t best = seeds_[0];
+    float bestDot = vertices_[best].dot(direction);
+    for (size_t i = 1; i < seeds_.size(); ++i) {
+        const float d = vertices_[seeds_[i]].dot(direction);
+        if (d > bestDot) {
+            bestDot = d;
+            best = seeds_[i];
+        }
+    }
+
+    // Steepest ascent: each step strictly increases the dot product, so it
+    // ends, and on a convex hull it ends at the global maximum
+    for (;;) {
+        const uint32_t current = best;
+        for (uint32_t i = neighborOffsets_[current]; i < neighborOffsets_[current + 1]; ++i) {
+            const uint32_t neighbor = vertexNeighbors_[i];
+            const float d = vertices_[neighbor].dot(direction);
+            if (d > bestDot) {
+                bestDot = d;
+                best = neighbor;
+            }
+        }
+        if (best == current) {
+            return best;
+        }
+    }
+}
+
+}  // namespace axiom::collision
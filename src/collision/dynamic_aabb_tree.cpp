@@ -0,0 +1,878 @@
+#include "axiom/collision/dynamic_aabb_tree.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace axiom::collision {
+
+namespace {
+
+int16_t parentHeight(int16_t a, int16_t b) noexcept {
+    return static_cast<int16_t>(1 + std::max(a, b));
+}
+
+/// Centroid bins evaluated per split of a rebuild
+constexpr uint32_t RebuildBinCount = 16;
+
+/// Marks a child reference of a built node as an index into the snapshot leaves
+constexpr uint32_t RebuildLeafBit = 0x80000000u;
+
+}  // namespace
+
+//=============================================================================
+// Rebuild state
+//=============================================================================
+
+struct DynamicAABBTree::Rebuild {
+    /// Leaf as it was when the rebuild started
+    struct Leaf {
+        math::AABB aabb;
+        math::Vec3 center;
+        uint32_t id = NullNode;
+        uint32_t rank = 0;  ///< Position in ids
+    };
+
+    /// Internal node of the new tree; children are built nodes or leaves (RebuildLeafBit)
+    struct BuiltNode {
+        uint32_t child1 = NullNode;
+        uint32_t child2 = NullNode;
+    };
+
+    /// Range of leaves still to be split under a built node
+    struct Task {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t node = 0;
+    };
+
+    // Owned by the build (a job while jobSystem is set)
+    std::vector<Leaf> leaves;
+    std::vector<BuiltNode> nodes;
+    std::vector<Task> tasks;
+
+    // Owned by the tree's thread
+    core::JobSystem* jobSystem = nullptr;
+    core::JobCounter counter;
+    bool active = false;
+    uint32_t stepsLeft = 0;
+    size_t budget = 0;             ///< Leaves split per slice when building without a job
+    std::vector<uint8_t> dirty;    ///< Indexed by node: proxy changed since the snapshot
+    std::vector<uint32_t> deltas;  ///< Proxies changed since the snapshot, once each
+    std::vector<uint32_t> ids;          ///< Snapshot leaves in id order
+    std::vector<uint32_t> internals;    ///< Scratch for installRebuild(): old internal nodes
+    std::vector<uint32_t> linked;       ///< Scratch for installRebuild(), by built node
+    std::vector<uint32_t> leafParents;  ///< Scratch for installRebuild(), by leaf rank
+
+    Rebuild() = default;
+    Rebuild(const Rebuild&) = delete;
+    Rebuild& operator=(const Rebuild&) = delete;
+
+    ~Rebuild() {
+        if (jobSystem != nullptr) {
+            jobSystem->wait(counter);
+        }
+    }
+
+    /// Split pending ranges until about maxLeaves leaves were visited
+    /// @return true once the build is complete
+    bool advance(size_t maxLeaves) {
+        size_t visited = 0;
+        while (!tasks.empty() && visited < maxLeaves) {
+            const Task task = tasks.back();
+            tasks.pop_back();
+            split(task);
+            visited += task.end - task.begin;
+        }
+        return tasks.empty();
+    }
+
+    /// Partition a range at the best binned SAH split of its longest centroid axis
+    void split(const Task& task) {
+        const auto first = leaves.begin() + task.begin;
+        const auto last = leaves.begin() + task.end;
+        uint32_t middle = task.begin + (task.end - task.begin) / 2;
+
+        math::AABB centers;
+        for (auto it = first; it != last; ++it) {
+            centers.expand(it->center);
+        }
+        const math::Vec3 extent = centers.size();
+        size_t axis = extent.x > extent.y ? 0 : 1;
+        axis = extent[axis] > extent.z ? axis : 2;
+
+        if (task.end - task.begin > 2 && extent[axis] > 0.0f) {
+            const float origin = centers.min[axis];
+            const float scale = static_cast<float>(RebuildBinCount) / extent[axis];
+            const auto binOf = [&](const Leaf& leaf) {
+                const auto bin = static_cast<uint32_t>((leaf.center[axis] - origin) * scale);
+                return std::min(bin, RebuildBinCount - 1);
+            };
+
+            std::array<math::AABB, RebuildBinCount> binBounds;
+            std::array<uint32_t, RebuildBinCount> binCounts{};
+            for (auto it = first; it != last; ++it) {
+                const uint32_t bin = binOf(*it);
+                binBounds[bin].merge(it->aabb);
+                ++binCounts[bin];
+            }
+
+            // Right-hand costs first, then sweep from the left for the cheapest plane
+            std::array<float, RebuildBinCount> rightCost{};
+            math::AABB right;
+            uint32_t rightCount = 0;
+            for (uint32_t bin = RebuildBinCount - 1; bin > 0; --bin) {
+                right.merge(binBounds[bin]);
+                rightCount += binCounts[bin];
+                rightCost[bin] = rightCount > 0
+                                     ? right.surfaceArea() * static_cast<float>(rightCount)
+                                     : 0.0f;
+            }
+            math::AABB left;
+            uint32_t leftCount = 0;
+            uint32_t bestBin = 1;
+            float bestCost = std::numeric_limits<float>::max();
+            for (uint32_t bin = 1; bin < RebuildBinCount; ++bin) {
+                left.merge(binBounds[bin - 1]);
+                leftCount += binCounts[bin - 1];
+                const float leftCost =
+                    leftCount > 0 ? left.surfaceArea() * static_cast<float>(leftCount) : 0.0f;
+                if (leftCost + rightCost[bin] < bestCost) {
+                    bestCost = leftCost + rightCost[bin];
+                    bestBin = bin;
+                }
+            }
+
+            // The extreme centroids fall in the first and last bins: no side is empty
+            const auto split = std::partition(
+                first, last, [&](const Leaf& leaf) { return binOf(leaf) < bestBin; });
+            middle = static_cast<uint32_t>(split - leaves.begin());
+        }
+
+        const auto makeChild = [&](uint32_t begin, uint32_t end) {
+            if (end - begin == 1) {
+                return RebuildLeafBit | begin;
+            }
+            const auto node = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+            tasks.push_back({begin, end, node});
+            return node;
+        };
+        const uint32_t child1 = makeChild(task.begin, middle);
+        const uint32_t child2 = makeChild(middle, task.end);
+        nodes[task.node] = {child1, child2};
+    }
+};
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+DynamicAABBTree::DynamicAABBTree(const DynamicAABBTreeConfig& config) : config_(config) {
+    AXIOM_ASSERT(config_.rebuildSteps > 0, "A rebuild spans at least one step");
+    nodes_.reserve(config_.initialCapacity);
+}
+
+DynamicAABBTree::~DynamicAABBTree() = default;
+
+DynamicAABBTree::DynamicAABBTree(DynamicAABBTree&&) noexcept = default;
+
+DynamicAABBTree& DynamicAABBTree::operator=(DynamicAABBTree&&) noexcept = default;
+
+//=============================================================================
+// Proxies
+//=============================================================================
+
+ProxyId DynamicAABBTree::createProxy(const math::AABB& aabb, uint64_t userData) {
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    const uint32_t index = allocateNode();
+    Node& node = nodes_[index];
+    node.aabb = computeFatAABB(aabb, math::Vec3::zero());
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(index);
+    recordRebuildDelta(index);
+    ++proxyCount_;
+    markMoved(index);
+    return static_cast<ProxyId>(index);
+}
+
+void DynamicAABBTree::destroyProxy(ProxyId id) {
+    AXIOM_ASSERT(id < nodes_.size() && nodes_[id].height == 0, "Invalid proxy id");
+
+    if (nodes_[id].moved) {
+        // Keep the buffer's order; updatePairs skips the hole
+        const uint32_t position = movedIndex_[id];
+        AXIOM_ASSERT(movedBuffer_[position] == id, "Moved proxy missing from the moved buffer");
+        movedBuffer_[position] = InvalidProxyId;
+    }
+
+    removeLeaf(id);
+    freeNode(id);
+    recordRebuildDelta(id);
+    --proxyCount_;
+}
+
+bool DynamicAABBTree::moveProxy(ProxyId id, const math::AABB& aabb,
+                                const math::Vec3& displacement) {
+    AXIOM_ASSERT(id < nodes_.size() && nodes_[id].height == 0, "Invalid proxy id");
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    const math::AABB fatAABB = computeFatAABB(aabb, displacement);
+    if (!needsReinsert(id, aabb, fatAABB, displacement)) {
+        return false;
+    }
+
+    removeLeaf(id);
+    nodes_[id].aabb = fatAABB;
+    insertLeaf(id);
+    markMoved(id);
+    recordRebuildDelta(id);
+    return true;
+}
+
+size_t DynamicAABBTree::moveProxies(std::span<const ProxyMove> moves) {
+    AXIOM_PROFILE_SCOPE("DynamicAABBTree::moveProxies");
+    AXIOM_PROFILE_ELEMENTS(moves.size());
+
+    reinsertBuffer_.clear();
+    for (const ProxyMove& move : moves) {
+        AXIOM_ASSERT(move.id < nodes_.size() && nodes_[move.id].height == 0, "Invalid proxy id");
+        AXIOM_ASSERT(move.aabb.isValid(), "Proxy bounds must be valid");
+
+        const math::AABB fatAABB = computeFatAABB(move.aabb, move.displacement);
+        if (needsReinsert(move.id, move.aabb, fatAABB, move.displacement)) {
+            removeLeaf(move.id);
+            nodes_[move.id].aabb = fatAABB;
+            reinsertBuffer_.push_back(move.id);
+        }
+    }
+
+    for (const uint32_t index : reinsertBuffer_) {
+        insertLeaf(index);
+        markMoved(index);
+        recordRebuildDelta(index);
+    }
+    return reinsertBuffer_.size();
+}
+
+void DynamicAABBTree::touchProxy(ProxyId id) {
+    AXIOM_ASSERT(id < nodes_.size() && nodes_[id].height == 0, "Invalid proxy id");
+    markMoved(id);
+}
+
+void DynamicAABBTree::clearMoved() noexcept {
+    for (const ProxyId id : movedBuffer_) {
+        if (id != InvalidProxyId) {
+            nodes_[id].moved = false;
+        }
+    }
+    movedBuffer_.clear();
+}
+
+//=============================================================================
+// Statistics
+//=============================================================================
+
+int32_t DynamicAABBTree::getHeight() const noexcept {
+    return root_ == NullNode ? -1 : nodes_[root_].height;
+}
+
+int32_t DynamicAABBTree::getMaxBalance() const noexcept {
+    int32_t maxBalance = 0;
+    for (const Node& node : nodes_) {
+        if (node.height <= 1) {
+            continue;  // Free node, leaf, or parent of two leaves
+        }
+        const int32_t balance = std::abs(nodes_[node.child2].height - nodes_[node.child1].height);
+        maxBalance = std::max(maxBalance, balance);
+    }
+    return maxBalance;
+}
+
+float DynamicAABBTree::getAreaRatio() const noexcept {
+    if (root_ == NullNode) {
+        return 0.0f;
+    }
+
+    const float rootArea = nodes_[root_].aabb.surfaceArea();
+    if (rootArea <= 0.0f) {
+        return 0.0f;
+    }
+
+    float totalArea = 0.0f;
+    for (const Node& node : nodes_) {
+        if (node.height >= 0) {
+            totalArea += node.aabb.surfaceArea();
+        }
+    }
+    return totalArea / rootArea;
+}
+
+float DynamicAABBTree::getSahCost() const noexcept {
+    if (root_ == NullNode || nodes_[root_].isLeaf()) {
+        return 0.0f;
+    }
+    const float rootArea = nodes_[root_].aabb.surfaceArea();
+    return rootArea > 0.0f ? static_cast<float>(internalArea_ / static_cast<double>(rootArea))
+                           : 0.0f;
+}
+
+bool DynamicAABBTree::validate() const {
+    for (size_t index = 0; index < movedBuffer_.size(); ++index) {
+        const ProxyId id = movedBuffer_[index];
+        if (id != InvalidProxyId &&
+            (id >= nodes_.size() || !nodes_[id].moved || movedIndex_[id] != index)) {
+            return false;
+        }
+    }
+
+    uint32_t freeCount = 0;
+    for (uint32_t index = freeList_; index != NullNode; index = nodes_[index].next) {
+        if (index >= nodes_.size() || nodes_[index].height != -1 || ++freeCount > nodes_.size()) {
+            return false;
+        }
+    }
+    if (nodeCount_ + freeCount != nodes_.size()) {
+        return false;
+    }
+
+    if (root_ == NullNode) {
+        return nodeCount_ == 0 && proxyCount_ == 0;
+    }
+
+    uint32_t leafCount = 0;
+    uint32_t nodeCount = 0;
+    if (validateSubtree(root_, NullNode, leafCount, nodeCount) < 0) {
+        return false;
+    }
+    return leafCount == proxyCount_ && nodeCount == nodeCount_;
+}
+
+int32_t DynamicAABBTree::validateSubtree(uint32_t index, uint32_t parent, uint32_t& leafCount,
+                                         uint32_t& nodeCount) const {
+    if (index >= nodes_.size()) {
+        return -1;
+    }
+
+    const Node& node = nodes_[index];
+    if (node.parent != parent || node.height < 0) {
+        return -1;
+    }
+    ++nodeCount;
+
+    if (node.isLeaf()) {
+        ++leafCount;
+        return node.child2 == NullNode && node.height == 0 ? 0 : -1;
+    }
+
+    const int32_t height1 = validateSubtree(node.child1, index, leafCount, nodeCount);
+    const int32_t height2 = validateSubtree(node.child2, index, leafCount, nodeCount);
+    if (height1 < 0 || height2 < 0 || node.height != 1 + std::max(height1, height2)) {
+        return -1;
+    }
+    if (node.aabb != math::AABB::merge(nodes_[node.child1].aabb, nodes_[node.child2].aabb)) {
+        return -1;
+    }
+    return node.height;
+}
+
+//=============================================================================
+// Node pool
+//=============================================================================
+
+uint32_t DynamicAABBTree::allocateNode() {
+    uint32_t index;
+    if (freeList_ != NullNode) {
+        index = freeList_;
+        freeList_ = nodes_[index].next;
+        nodes_[index] = Node();
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        AXIOM_ASSERT(index != NullNode, "DynamicAABBTree node pool exhausted");
+        nodes_.emplace_back();
+    }
+
+    nodes_[index].height = 0;
+    ++nodeCount_;
+    return index;
+}
+
+void DynamicAABBTree::freeNode(uint32_t index) noexcept {
+    Node& node = nodes_[index];
+    node.next = freeList_;
+    node.child1 = NullNode;
+    node.child2 = NullNode;
+    node.height = -1;
+    node.moved = false;
+    freeList_ = index;
+    --nodeCount_;
+}
+
+//=============================================================================
+// Insertion and removal
+//=============================================================================
+
+void DynamicAABBTree::insertLeaf(uint32_t leaf) {
+    if (root_ == NullNode) {
+        root_ = leaf;
+        nodes_[leaf].parent = NullNode;
+        return;
+    }
+
+    // Descend towards the sibling that minimizes the surface area added to the tree
+    const math::AABB leafAABB = nodes_[leaf].aabb;
+    uint32_t index = root_;
+    while (!nodes_[index].isLeaf()) {
+        const Node& node = nodes_[index];
+        const float area = node.aabb.surfaceArea();
+        const float combinedArea = math::AABB::merge(node.aabb, leafAABB).surfaceArea();
+
+        // Cost of making the leaf a sibling of this node
+        const float cost = 2.0f * combinedArea;
+
+        // Every ancestor of a deeper sibling grows as well
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descentCost = [&](uint32_t child) {
+            const Node& childNode = nodes_[child];
+            const float mergedArea = math::AABB::merge(leafAABB, childNode.aabb).surfaceArea();
+            const float childCost =
+                childNode.isLeaf() ? mergedArea : mergedArea - childNode.aabb.surfaceArea();
+            return childCost + inheritanceCost;
+        };
+        const float cost1 = descentCost(node.child1);
+        const float cost2 = descentCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    // Splice a new parent above the sibling (allocation may grow the pool)
+    const uint32_t sibling = index;
+    const uint32_t oldParent = nodes_[sibling].parent;
+    const uint32_t newParent = allocateNode();
+
+    Node& parentNode = nodes_[newParent];
+    parentNode.parent = oldParent;
+    parentNode.aabb = math::AABB::merge(leafAABB, nodes_[sibling].aabb);
+    internalArea_ += static_cast<double>(parentNode.aabb.surfaceArea());
+    parentNode.height = parentHeight(nodes_[sibling].height, 0);
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+
+    if (oldParent == NullNode) {
+        root_ = newParent;
+    } else if (nodes_[oldParent].child1 == sibling) {
+        nodes_[oldParent].child1 = newParent;
+    } else {
+        nodes_[oldParent].child2 = newParent;
+    }
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    refitAncestors(newParent);
+}
+
+void DynamicAABBTree::removeLeaf(uint32_t leaf) {
+    if (leaf == root_) {
+        root_ = NullNode;
+        return;
+    }
+
+    const uint32_t parent = nodes_[leaf].parent;
+    const uint32_t grandParent = nodes_[parent].parent;
+    const uint32_t sibling =
+        nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    // The sibling takes the parent's place
+    if (grandParent == NullNode) {
+        root_ = sibling;
+    } else if (nodes_[grandParent].child1 == parent) {
+        nodes_[grandParent].child1 = sibling;
+    } else {
+        nodes_[grandParent].child2 = sibling;
+    }
+    nodes_[sibling].parent = grandParent;
+    nodes_[leaf].parent = NullNode;
+    internalArea_ -= static_cast<double>(nodes_[parent].aabb.surfaceArea());
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+void DynamicAABBTree::refitAncestors(uint32_t index) noexcept {
+    while (index != NullNode) {
+        index = balance(index);
+
+        Node& node = nodes_[index];
+        const Node& child1 = nodes_[node.child1];
+        const Node& child2 = nodes_[node.child2];
+        node.height = parentHeight(child1.height, child2.height);
+        setInternalAABB(node, math::AABB::merge(child1.aabb, child2.aabb));
+
+        index = node.parent;
+    }
+}
+
+uint32_t DynamicAABBTree::balance(uint32_t indexA) noexcept {
+    // A has children B and C; C has children F and G (or B has D and E).
+    //
+    // If one child of A is more than one level taller than the other, the
+    // taller child is rotated up into A's place and A adopts the shorter of
+    // its grandchildren. Returns the node now at A's position.
+    Node& a = nodes_[indexA];
+    if (a.isLeaf() || a.height < 2) {
+        return indexA;
+    }
+
+    const uint32_t indexB = a.child1;
+    const uint32_t indexC = a.child2;
+    Node& b = nodes_[indexB];
+    Node& c = nodes_[indexC];
+    const int32_t heightDifference = c.height - b.height;
+
+    auto replaceInParent = [&](uint32_t parent, uint32_t oldChild, uint32_t newChild) {
+        if (parent == NullNode) {
+            root_ = newChild;
+        } else if (nodes_[parent].child1 == oldChild) {
+            nodes_[parent].child1 = newChild;
+        } else {
+            nodes_[parent].child2 = newChild;
+        }
+    };
+
+    if (heightDifference > 1) {
+        // Rotate C up
+        const uint32_t indexF = c.child1;
+        const uint32_t indexG = c.child2;
+        Node& f = nodes_[indexF];
+        Node& g = nodes_[indexG];
+
+        c.child1 = indexA;
+        c.parent = a.parent;
+        a.parent = indexC;
+        replaceInParent(c.parent, indexA, indexC);
+
+        if (f.height > g.height) {
+            c.child2 = indexF;
+            a.child2 = indexG;
+            g.parent = indexA;
+            setInternalAABB(a, math::AABB::merge(b.aabb, g.aabb));
+            setInternalAABB(c, math::AABB::merge(a.aabb, f.aabb));
+            a.height = parentHeight(b.height, g.height);
+            c.height = parentHeight(a.height, f.height);
+        } else {
+            c.child2 = indexG;
+            a.child2 = indexF;
+            f.parent = indexA;
+            setInternalAABB(a, math::AABB::merge(b.aabb, f.aabb));
+            setInternalAABB(c, math::AABB::merge(a.aabb, g.aabb));
+            a.height = parentHeight(b.height, f.height);
+            c.height = parentHeight(a.height, g.height);
+        }
+        return indexC;
+    }
+
+    if (heightDifference < -1) {
+        // Rotate B up
+        const uint32_t indexD = b.child1;
+        const uint32_t indexE = b.child2;
+        Node& d = nodes_[indexD];
+        Node& e = nodes_[indexE];
+
+        b.child1 = indexA;
+        b.parent = a.parent;
+        a.parent = indexB;
+        replaceInParent(b.parent, indexA, indexB);
+
+        if (d.height > e.height) {
+            b.child2 = indexD;
+            a.child1 = indexE;
+            e.parent = indexA;
+            setInternalAABB(a, math::AABB::merge(c.aabb, e.aabb));
+            setInternalAABB(b, math::AABB::merge(a.aabb, d.aabb));
+            a.height = parentHeight(c.height, e.height);
+            b.height = parentHeight(a.height, d.height);
+        } else {
+            b.child2 = indexE;
+            a.child1 = indexD;
+            d.parent = indexA;
+            setInternalAABB(a, math::AABB::merge(c.aabb, d.aabb));
+            setInternalAABB(b, math::AABB::merge(a.aabb, e.aabb));
+            a.height = parentHeight(c.height, d.height);
+            b.height = parentHeight(a.height, e.height);
+        }
+        return indexB;
+    }
+
+    return indexA;
+}
+
+void DynamicAABBTree::setInternalAABB(Node& node, const math::AABB& aabb) noexcept {
+    internalArea_ +=
+        static_cast<double>(aabb.surfaceArea()) - static_cast<double>(node.aabb.surfaceArea());
+    node.aabb = aabb;
+}
+
+//=============================================================================
+// Rebuilds
+//=============================================================================
+
+bool DynamicAABBTree::isRebuilding() const noexcept {
+    return rebuild_ != nullptr && rebuild_->active;
+}
+
+bool DynamicAABBTree::updateRebuild(core::JobSystem* jobSystem) {
+    if (!isRebuilding()) {
+        const bool degraded =
+            rebuildCount_ == 0 || getSahCost() > config_.rebuildCostRatio * rebuiltCost_;
+        if (config_.rebuildCostRatio > 0.0f && degraded &&
+            proxyCount_ >= std::max(config_.rebuildMinProxies, 2u)) {
+            beginRebuild(jobSystem);
+        }
+        return false;
+    }
+
+    Rebuild& rebuild = *rebuild_;
+    if (--rebuild.stepsLeft > 0) {
+        if (rebuild.jobSystem == nullptr) {
+            rebuild.advance(rebuild.budget);
+        }
+        return false;
+    }
+    installRebuild();
+    return true;
+}
+
+void DynamicAABBTree::rebuild() {
+    if (isRebuilding()) {
+        installRebuild();
+    }
+    if (proxyCount_ >= 2) {
+        beginRebuild(nullptr);
+        installRebuild();
+    }
+}
+
+void DynamicAABBTree::beginRebuild(core::JobSystem* jobSystem) {
+    AXIOM_PROFILE_SCOPE("DynamicAABBTree::beginRebuild");
+    AXIOM_PROFILE_ELEMENTS(proxyCount_);
+
+    if (rebuild_ == nullptr) {
+        rebuild_ = std::make_unique<Rebuild>();
+    }
+    Rebuild& rebuild = *rebuild_;
+    rebuild.leaves.clear();
+    rebuild.ids.clear();
+    for (uint32_t index = 0; index < nodes_.size(); ++index) {
+        const Node& node = nodes_[index];
+        if (node.height == 0) {
+            const auto rank = static_cast<uint32_t>(rebuild.ids.size());
+            rebuild.leaves.push_back({node.aabb, node.aabb.center(), index, rank});
+            rebuild.ids.push_back(index);
+        }
+    }
+    const auto leafCount = static_cast<uint32_t>(rebuild.leaves.size());
+    AXIOM_ASSERT(nodes_.size() < RebuildLeafBit, "Too many nodes to rebuild");
+    rebuild.nodes.assign(1, {});
+    rebuild.nodes.reserve(leafCount - 1);
+    rebuild.tasks.assign(1, {0, leafCount, 0});
+    rebuild.dirty.assign(nodes_.size(), 0);
+    rebuild.deltas.clear();
+    rebuild.active = true;
+    rebuild.stepsLeft = config_.rebuildSteps;
+
+    // Each level of the build visits every leaf once; the steps between this
+    // one and the install share the levels
+    const auto levels = static_cast<size_t>(std::bit_width(leafCount));
+    rebuild.budget = leafCount * levels / std::max(config_.rebuildSteps - 1, 1u) + 1;
+
+    rebuild.jobSystem = jobSystem;
+    if (jobSystem != nullptr) {
+        Rebuild* build = &rebuild;
+        jobSystem->run(rebuild.counter, [build] { build->advance(SIZE_MAX); });
+    }
+}
+
+void DynamicAABBTree::installRebuild() {
+    AXIOM_PROFILE_SCOPE("DynamicAABBTree::installRebuild");
+
+    Rebuild& rebuild = *rebuild_;
+    if (rebuild.jobSystem != nullptr) {
+        rebuild.jobSystem->wait(rebuild.counter);
+        rebuild.jobSystem = nullptr;
+    } else {
+        rebuild.advance(SIZE_MAX);
+    }
+
+    // The old internal nodes are reused in pool order; the leaves stay where they are
+    rebuild.internals.clear();
+    for (uint32_t index = 0; index < nodes_.size(); ++index) {
+        if (nodes_[index].height > 0) {
+            rebuild.internals.push_back(index);
+        }
+    }
+    size_t reused = 0;
+    internalArea_ = 0.0;
+
+    // Link the built nodes bottom-up (children come after their parent),
+    // leaving out the leaves that changed since the snapshot. A link is a
+    // node index, a snapshot leaf or NullNode. Leaf bounds are read from the
+    // snapshot and leaf parents written afterwards in id order, so linking
+    // never jumps around the pool to reach a leaf.
+    const auto isLeaf = [](uint32_t link) { return (link & RebuildLeafBit) != 0; };
+    const auto leafOf = [&](uint32_t link) -> const Rebuild::Leaf& {
+        return rebuild.leaves[link & ~RebuildLeafBit];
+    };
+    const auto resolve = [&](uint32_t child) {
+        if (!isLeaf(child)) {
+            return rebuild.linked[child];
+        }
+        return rebuild.dirty[leafOf(child).id] != 0 ? NullNode : child;
+    };
+    const auto attach = [&](uint32_t link, uint32_t parent, math::AABB& bounds) {
+        if (isLeaf(link)) {
+            const Rebuild::Leaf& leaf = leafOf(link);
+            rebuild.leafParents[leaf.rank] = parent;
+            bounds.merge(leaf.aabb);
+            return std::pair<uint32_t, int16_t>(leaf.id, 0);
+        }
+        Node& child = nodes_[link];
+        child.parent = parent;
+        bounds.merge(child.aabb);
+        return std::pair<uint32_t, int16_t>(link, child.height);
+    };
+
+    rebuild.linked.resize(rebuild.nodes.size());
+    rebuild.leafParents.assign(rebuild.ids.size(), NullNode);
+    for (size_t built = rebuild.nodes.size(); built-- > 0;) {
+        const uint32_t link1 = resolve(rebuild.nodes[built].child1);
+        const uint32_t link2 = resolve(rebuild.nodes[built].child2);
+        if (link1 == NullNode || link2 == NullNode) {
+            rebuild.linked[built] = link1 == NullNode ? link2 : link1;
+            continue;
+        }
+
+        const uint32_t index =
+            reused < rebuild.internals.size() ? rebuild.internals[reused++] : allocateNode();
+        math::AABB bounds;
+        const auto [child1, height1] = attach(link1, index, bounds);
+        const auto [child2, height2] = attach(link2, index, bounds);
+        Node& node = nodes_[index];
+        node.child1 = child1;
+        node.child2 = child2;
+        node.height = parentHeight(height1, height2);
+        node.aabb = bounds;
+        internalArea_ += static_cast<double>(bounds.surfaceArea());
+        rebuild.linked[built] = index;
+    }
+    for (size_t unused = reused; unused < rebuild.internals.size(); ++unused) {
+        freeNode(rebuild.internals[unused]);
+    }
+    for (size_t rank = 0; rank < rebuild.ids.size(); ++rank) {
+        if (rebuild.leafParents[rank] != NullNode) {
+            nodes_[rebuild.ids[rank]].parent = rebuild.leafParents[rank];
+        }
+    }
+
+    const uint32_t rootLink = rebuild.linked[0];
+    root_ = rootLink != NullNode && isLeaf(rootLink) ? leafOf(rootLink).id : rootLink;
+    if (root_ != NullNode) {
+        nodes_[root_].parent = NullNode;
+    }
+
+    // Replay the proxies that were created or re-inserted meanwhile
+    for (const uint32_t id : rebuild.deltas) {
+        if (nodes_[id].height == 0) {
+            insertLeaf(id);
+        }
+        rebuild.dirty[id] = 0;
+    }
+    rebuild.deltas.clear();
+    rebuild.active = false;
+
+    rebuiltCost_ = getSahCost();
+    ++rebuildCount_;
+}
+
+void DynamicAABBTree::recordRebuildDelta(uint32_t index) {
+    if (!isRebuilding()) {
+        return;
+    }
+    Rebuild& rebuild = *rebuild_;
+    if (index >= rebuild.dirty.size()) {
+        rebuild.dirty.resize(nodes_.size(), 0);
+    }
+    if (rebuild.dirty[index] == 0) {
+        rebuild.dirty[index] = 1;
+        rebuild.deltas.push_back(index);
+    }
+}
+
+//=============================================================================
+// Fat bounds
+//=============================================================================
+
+math::AABB DynamicAABBTree::computeFatAABB(const math::AABB& aabb,
+                                           const math::Vec3& displacement) const noexcept {
+    math::AABB fatAABB = aabb;
+    fatAABB.expand(config_.fatMargin);
+
+    // Stretch along the predicted motion only, so the proxy stays tight behind the body
+    const math::Vec3 prediction = displacement * config_.displacementMultiplier;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        if (prediction[axis] < 0.0f) {
+            fatAABB.min[axis] += prediction[axis];
+        } else {
+            fatAABB.max[axis] += prediction[axis];
+        }
+    }
+    return fatAABB;
+}
+
+bool DynamicAABBTree::needsReinsert(uint32_t index, const math::AABB& aabb,
+                                    const math::AABB& fatAABB,
+                                    const math::Vec3& displacement) const noexcept {
+    const math::AABB& treeAABB = nodes_[index].aabb;
+    if (!treeAABB.contains(aabb)) {
+        return true;
+    }
+
+    // Still enclosed, but refresh proxies that are far larger than needed (a
+    // fast body that came to rest) to avoid false-positive pairs. The slack
+    // includes the predicted motion on both sides, so a body moving at constant
+    // velocity keeps its proxy until it actually escapes.
+    math::AABB hugeAABB = fatAABB;
+    hugeAABB.expand(4.0f * config_.fatMargin);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float slack = std::abs(displacement[axis]) * config_.displacementMultiplier;
+        hugeAABB.min[axis] -= slack;
+        hugeAABB.max[axis] += slack;
+    }
+    return !hugeAABB.contains(treeAABB);
+}
+
+void DynamicAABBTree::markMoved(uint32_t index) {
+    Node& node = nodes_[index];
+    if (!node.moved) {
+        node.moved = true;
+        if (index >= movedIndex_.size()) {
+            movedIndex_.resize(nodes_.size());
+        }
+        movedIndex_[index] = static_cast<uint32_t>(movedBuffer_.size());
+        movedBuffer_.push_back(static_cast<ProxyId>(index));
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,776 @@
+#include "axiom/collision/gjk.hpp"
+
+#include "axiom/core/assert.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::Vec3;
+
+constexpr uint32_t MaxGjkIterations = 32;
+
+/// GJK stops once the squared distance estimate improves by less than this
+/// fraction of itself
+constexpr float GjkRelativeTolerance = 1.0e-6f;
+
+/// Cores closer than this are treated as overlapping
+constexpr float GjkOverlapDistance = 1.0e-5f;
+
+constexpr uint32_t MaxEpaIterations = 64;
+constexpr uint32_t MaxEpaVertices = 68;
+constexpr uint32_t MaxEpaFaces = 128;
+constexpr uint32_t MaxEpaEdges = 192;
+
+/// EPA stops once a support point gains less than this over the closest face
+constexpr float EpaTolerance = 1.0e-4f;
+
+/// Conservative advancement gives up (and reports a miss) after this many steps
+constexpr uint32_t MaxCastIterations = 32;
+
+/// Shape with its placement
+struct PlacedShape : ShapeFrame {
+    const ConvexShape& shape;
+
+    PlacedShape(const ConvexShape& s, const math::Transform& transform) noexcept
+        : ShapeFrame(transform), shape(s) {}
+};
+
+/// Point of the Minkowski difference A - B, with the core points that made it
+struct SupportPoint {
+    Vec3 w;       ///< pointA - pointB
+    Vec3 pointA;  ///< World space
+    Vec3 pointB;  ///< World space
+    Vec3 localA;
+    Vec3 localB;
+};
+
+SupportPoint makePoint(const PlacedShape& a, const PlacedShape& b, const Vec3& localA,
+                       const Vec3& localB) noexcept {
+    SupportPoint point;
+    point.localA = localA;
+    point.localB = localB;
+    point.pointA = a.toWorld(localA);
+    point.pointB = b.toWorld(localB);
+    point.w = point.pointA - point.pointB;
+    return point;
+}
+
+/// Support point of A - B in a world direction
+SupportPoint support(const PlacedShape& a, const PlacedShape& b, const Vec3& direction) noexcept {
+    return makePoint(a, b, a.shape.supportCore(a.unrotate(direction)),
+                     b.shape.supportCore(b.unrotate(-direction)));
+}
+
+//=============================================================================
+// Simplex
+//=============================================================================
+
+/// GJK simplex: up to four points of A - B and the barycentric coordinates of
+/// the point closest to the origin
+struct Simplex {
+    std::array<SupportPoint, 4> points;
+    std::array<float, 4> lambda{};
+    uint32_t count = 0;
+
+    Vec3 closest() const noexcept {
+        Vec3 result = Vec3::zero();
+        for (uint32_t i = 0; i < count; ++i) {
+            result += points[i].w * lambda[i];
+        }
+        return result;
+    }
+
+    void witnesses(Vec3& pointA, Vec3& pointB) const noexcept {
+        pointA = Vec3::zero();
+        pointB = Vec3::zero();
+        for (uint32_t i = 0; i < count; ++i) {
+            pointA += points[i].pointA * lambda[i];
+            pointB += points[i].pointB * lambda[i];
+        }
+    }
+
+    /// Keep only the listed points, with their coordinates
+    void keep(std::initializer_list<std::pair<uint32_t, float>> kept) noexcept {
+        std::array<SupportPoint, 4> old = points;
+        count = 0;
+        for (const auto& [index, weight] : kept) {
+            points[count] = old[index];
+            lambda[count] = weight;
+            ++count;
+        }
+    }
+};
+
+void solveSegment(Simplex& simplex) noexcept {
+    const Vec3 a = simplex.points[0].w;
+    const Vec3 ab = simplex.points[1].w - a;
+    const float t = -a.dot(ab);
+    const float length = ab.lengthSquared();
+    if (t <= 0.0f) {
+        simplex.keep({{0, 1.0f}});
+    } else if (t >= length) {
+        simplex.keep({{1, 1.0f}});
+    } else {
+        const float v = t / length;
+        simplex.keep({{0, 1.0f - v}, {1, v}});
+    }
+}
+
+/// Closest point of triangle (i0, i1, i2) to the origin, by Voronoi regions
+/// (Ericson, Real-Time Collision Detection 5.1.5). Returns the squared distance.
+float solveTriangle(Simplex& simplex, uint32_t i0, uint32_t i1, uint32_t i2) noexcept {
+    const Vec3 a = simplex.points[i0].w;
+    const Vec3 b = simplex.points[i1].w;
+    const Vec3 c = simplex.points[i2].w;
+    const Vec3 ab = b - a;
+    const Vec3 ac = c - a;
+
+    const float d1 = -ab.dot(a);
+    const float d2 = -ac.dot(a);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        simplex.keep({{i0, 1.0f}});
+        return a.lengthSquared();
+    }
+
+    const float d3 = -ab.dot(b);
+    const float d4 = -ac.dot(b);
+    if (d3 >= 0.0f && d4 <= d3) {
+        simplex.keep({{i1, 1.0f}});
+        return b.lengthSquared();
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        const float v = d1 / (d1 - d3);
+        simplex.keep({{i0, 1.0f - v}, {i1, v}});
+        return (a + ab * v).lengthSquared();
+    }
+
+    const float d5 = -ab.dot(c);
+    const float d6 = -ac.dot(c);
+    if (d6 >= 0.0f && d5 <= d6) {
+        simplex.keep({{i2, 1.0f}});
+        return c.lengthSquared();
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        const float w = d2 / (d2 - d6);
+        simplex.keep({{i0, 1.0f - w}, {i2, w}});
+        return (a + ac * w).lengthSquared();
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        simplex.keep({{i1, 1.0f - w}, {i2, w}});
+        return (b + (c - b) * w).lengthSquared();
+    }
+
+    const float sum = va + vb + vc;
+    if (sum <= 0.0f) {
+        // Degenerate (collinear) triangle: fall back to its longest edge
+        const float lengthAB = ab.lengthSquared();
+        const float lengthAC = ac.lengthSquared();
+        const float lengthBC = (c - b).lengthSquared();
+        if (lengthAB >= lengthAC && lengthAB >= lengthBC) {
+            simplex.keep({{i0, 1.0f}, {i1, 0.0f}});
+        } else if (lengthAC >= lengthBC) {
+            simplex.keep({{i0, 1.0f}, {i2, 0.0f}});
+        } else {
+            simplex.keep({{i1, 1.0f}, {i2, 0.0f}});
+        }
+        solveSegment(simplex);
+        return simplex.closest().lengthSquared();
+    }
+
+    const float v = vb / sum;
+    const float w = vc / sum;
+    simplex.keep({{i0, 1.0f - v - w}, {i1, v}, {i2, w}});
+    return (a + ab * v + ac * w).lengthSquared();
+}
+
+/// Returns false when the origin is inside the tetrahedron
+///
+/// Containment uses the signed-volume barycentric coordinates of the origin. A
+/// tetrahedron whose volume is rounding noise relative to its edges has no
+/// reliable inside, so it falls back to its closest face.
+bool solveTetrahedron(Simplex& simplex) noexcept {
+    // Faces as (i0, i1, i2, opposite vertex)
+    constexpr std::array<std::array<uint32_t, 4>, 4> Faces = {{
+        {0, 1, 2, 3},
+        {0, 2, 3, 1},
+        {0, 3, 1, 2},
+        {1, 3, 2, 0},
+    }};
+    // Volume below this fraction of the product of the edge lengths is flat
+    constexpr float FlatVolume = 1.0e-4f;
+
+    const Vec3 a = simplex.points[0].w;
+    const Vec3 ab = simplex.points[1].w - a;
+    const Vec3 ac = simplex.points[2].w - a;
+    const Vec3 ad = simplex.points[3].w - a;
+    const float volume = ab.dot(ac.cross(ad));
+
+    // Volumes with each vertex replaced by the origin: the barycentric
+    // coordinates of the origin, scaled by the volume
+    const std::array<float, 4> weights = {
+        simplex.points[1].w.dot(simplex.points[2].w.cross(simplex.points[3].w)),
+        -a.dot(ac.cross(ad)),
+        ab.dot((-a).cross(ad)),
+        ab.dot(ac.cross(-a)),
+    };
+
+    const float edges = std::sqrt(ab.lengthSquared() * ac.lengthSquared() * ad.lengthSquared());
+    const bool flat = std::abs(volume) <= FlatVolume * edges;
+    if (!flat && std::all_of(weights.begin(), weights.end(),
+                             [volume](float weight) { return weight * volume >= 0.0f; })) {
+        return false;
+    }
+
+    // The closest point lies on a face that sees the origin (any face when flat)
+    float best = std::numeric_limits<float>::infinity();
+    Simplex bestSimplex;
+    for (const auto& face : Faces) {
+        if (!flat && weights[face[3]] * volume >= 0.0f) {
+            continue;
+        }
+        Simplex candidate = simplex;
+        const float distance = solveTriangle(candidate, face[0], face[1], face[2]);
+        if (distance < best) {
+            best = distance;
+            bestSimplex = candidate;
+        }
+    }
+    simplex = bestSimplex;
+    return true;
+}
+
+/// Reduce the simplex to the smallest subset supporting the point closest to
+/// the origin. Returns false when the origin is inside it.
+bool solveSimplex(Simplex& simplex) noexcept {
+    switch (simplex.count) {
+        case 1:
+            simplex.lambda[0] = 1.0f;
+            return true;
+        case 2:
+            solveSegment(simplex);
+            return true;
+        case 3:
+            solveTriangle(simplex, 0, 1, 2);
+            return true;
+        default:
+            return solveTetrahedron(simplex);
+    }
+}
+
+//=============================================================================
+// GJK
+//=============================================================================
+
+struct GjkOutput {
+    Vec3 closest;  ///< Point of A - B closest to the origin
+    Vec3 pointA;   ///< Witness point on core A
+    Vec3 pointB;   ///< Witness point on core B
+    float lowerBound = 0.0f;
+    uint32_t iterations = 0;
+    bool overlap = false;    ///< The cores overlap (or touch)
+    bool separated = false;  ///< Stopped early: the distance exceeds the limit
+};
+
+/// Distance between the cores, starting from the given simplex. Stops early
+/// once the distance is known to exceed separationLimit.
+GjkOutput runGjk(const PlacedShape& a, const PlacedShape& b, Simplex& simplex,
+                 float separationLimit) noexcept {
+    GjkOutput output;
+
+    if (simplex.count == 0) {
+        Vec3 direction = b.position - a.position;
+        if (direction.lengthSquared() < 1.0e-12f) {
+            direction = Vec3::unitX();
+        }
+        simplex.points[0] = support(a, b, direction);
+        simplex.count = 1;
+    }
+    if (!solveSimplex(simplex)) {
+        output.overlap = true;
+        return output;
+    }
+
+    Vec3 closest = simplex.closest();
+    float distanceSquared = closest.lengthSquared();
+    // Clamped so that an "unlimited" FLT_MAX query keeps the bound finite
+    const float limit = std::min(separationLimit, 1.0e18f);
+    const float limitSquared = limit * limit;
+
+    while (output.iterations < MaxGjkIterations) {
+        if (distanceSquared <= GjkOverlapDistance * GjkOverlapDistance) {
+            output.overlap = true;
+            break;
+        }
+
+        ++output.iterations;
+        const SupportPoint point = support(a, b, -closest);
+        const float projection = closest.dot(point.w);
+
+        // The support plane bounds the distance from below
+        if (projection > 0.0f && projection * projection > distanceSquared * limitSquared) {
+            output.lowerBound = projection / std::sqrt(distanceSquared);
+            output.separated = true;
+            break;
+        }
+
+        if (distanceSquared - projection <= GjkRelativeTolerance * distanceSquared) {
+            break;
+        }
+
+        bool duplicate = false;
+        for (uint32_t i = 0; i < simplex.count; ++i) {
+            duplicate |= (simplex.points[i].w - point.w).lengthSquared() < 1.0e-12f;
+        }
+        if (duplicate) {
+            break;
+        }
+
+        const Simplex previous = simplex;
+        simplex.points[simplex.count++] = point;
+        if (!solveSimplex(simplex)) {
+            // Only trust containment when the support plane through the new
+            // point no longer puts the cores apart by more than the tolerance
+            if (projection > GjkOverlapDistance * std::sqrt(distanceSquared)) {
+                simplex = previous;
+                break;
+            }
+            output.overlap = true;
+            break;
+        }
+
+        const Vec3 next = simplex.closest();
+        const float nextSquared = next.lengthSquared();
+        if (nextSquared >= distanceSquared) {
+            // No progress: numerical noise, keep the previous answer
+            simplex = previous;
+            break;
+        }
+        closest = next;
+        distanceSquared = nextSquared;
+    }
+
+    output.closest = closest;
+    simplex.witnesses(output.pointA, output.pointB);
+    return output;
+}
+
+//=============================================================================
+// EPA
+//=============================================================================
+
+struct EpaFace {
+    std::array<uint32_t, 3> index;
+    Vec3 normal;
+    float distance;
+};
+
+struct EpaOutput {
+    Vec3 normal;  ///< From A to B
+    Vec3 pointA;
+    Vec3 pointB;
+    float depth = 0.0f;
+    uint32_t iterations = 0;
+    bool valid = false;
+};
+
+/// Grow a simplex that touches the origin into a tetrahedron enclosing it
+bool expandToTetrahedron(const PlacedShape& a, const PlacedShape& b, Simplex& simplex) noexcept {
+    constexpr float MinExtent = 1.0e-6f;
+    constexpr std::array<Vec3, 3> Axes = {Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1)};
+
+    if (simplex.count == 1) {
+        for (const Vec3& axis : Axes) {
+            for (const float sign : {1.0f, -1.0f}) {
+                const SupportPoint point = support(a, b, axis * sign);
+                if ((point.w - simplex.points[0].w).lengthSquared() > MinExtent * MinExtent) {
+                    simplex.points[simplex.count++] = point;
+                    break;
+                }
+            }
+            if (simplex.count == 2) {
+                break;
+            }
+        }
+        if (simplex.count < 2) {
+            return false;
+        }
+    }
+
+    if (simplex.count == 2) {
+        const Vec3 segment = (simplex.points[1].w - simplex.points[0].w).normalized();
+        // Any axis not parallel to the segment gives a perpendicular
+        const Vec3& axis = std::abs(segment.x) < 0.57f   ? Axes[0]
+                           : std::abs(segment.y) < 0.57f ? Axes[1]
+                                                         : Axes[2];
+        const Vec3 first = segment.cross(axis).normalized();
+        const Vec3 second = segment.cross(first);
+        for (const Vec3& direction : {first, -first, second, -second}) {
+            const SupportPoint point = support(a, b, direction);
+            const Vec3 offset = point.w - simplex.points[0].w;
+            if ((offset - segment * offset.dot(segment)).lengthSquared() >
+                MinExtent * MinExtent) {
+                simplex.points[simplex.count++] = point;
+                break;
+            }
+        }
+        if (simplex.count < 3) {
+            return false;
+        }
+    }
+
+    if (simplex.count == 3) {
+        const Vec3 normal = (simplex.points[1].w - simplex.points[0].w)
+                                .cross(simplex.points[2].w - simplex.points[0].w)
+                                .normalized();
+        for (const Vec3& direction : {normal, -normal}) {
+            const SupportPoint point = support(a, b, direction);
+            if (std::abs((point.w - simplex.points[0].w).dot(normal)) > MinExtent) {
+                simplex.points[simplex.count++] = point;
+                break;
+            }
+        }
+        if (simplex.count < 4) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool makeFace(const std::array<SupportPoint, MaxEpaVertices>& vertices, uint32_t i0, uint32_t i1,
+              uint32_t i2, EpaFace& face) noexcept {
+    const Vec3 normal =
+        (vertices[i1].w - vertices[i0].w).cross(vertices[i2].w - vertices[i0].w);
+    const float length = normal.length();
+    if (length < 1.0e-12f) {
+        return false;
+    }
+    face.index = {i0, i1, i2};
+    face.normal = normal / length;
+    face.distance = face.normal.dot(vertices[i0].w);
+    return true;
+}
+
+void toggleEdge(std::array<std::pair<uint32_t, uint32_t>, MaxEpaEdges>& edges, uint32_t& edgeCount,
+                uint32_t from, uint32_t to) noexcept {
+    // An edge shared by two removed faces is interior to the hole
+    for (uint32_t i = 0; i < edgeCount; ++i) {
+        if (edges[i].first == to && edges[i].second == from) {
+            edges[i] = edges[--edgeCount];
+            return;
+        }
+    }
+    if (edgeCount < MaxEpaEdges) {
+        edges[edgeCount++] = {from, to};
+    }
+}
+
+/// Penetration of the cores, from a GJK simplex that encloses or touches the origin
+EpaOutput runEpa(const PlacedShape& a, const PlacedShape& b, Simplex simplex) noexcept {
+    EpaOutput output;
+    if (!expandToTetrahedron(a, b, simplex)) {
+        return output;
+    }
+
+    std::array<SupportPoint, MaxEpaVertices> vertices;
+    std::array<EpaFace, MaxEpaFaces> faces;
+    std::array<std::pair<uint32_t, uint32_t>, MaxEpaEdges> edges;
+    uint32_t vertexCount = 4;
+    uint32_t faceCount = 0;
+    std::copy(simplex.points.begin(), simplex.points.end(), vertices.begin());
+
+    // Wind the tetrahedron faces outward
+    const Vec3 d = vertices[3].w - vertices[0].w;
+    if ((vertices[1].w - vertices[0].w).cross(vertices[2].w - vertices[0].w).dot(d) > 0.0f) {
+        std::swap(vertices[1], vertices[2]);
+    }
+    constexpr std::array<std::array<uint32_t, 3>, 4> Tetrahedron = {{
+        {0, 1, 2},
+        {0, 3, 1},
+        {0, 2, 3},
+        {1, 3, 2},
+    }};
+    for (const auto& face : Tetrahedron) {
+        if (!makeFace(vertices, face[0], face[1], face[2], faces[faceCount])) {
+            return output;
+        }
+        ++faceCount;
+    }
+
+    uint32_t closest = 0;
+    while (true) {
+        closest = 0;
+        for (uint32_t i = 1; i < faceCount; ++i) {
+            if (faces[i].distance < faces[closest].distance) {
+                closest = i;
+            }
+        }
+        const EpaFace face = faces[closest];
+
+        if (output.iterations == MaxEpaIterations || vertexCount == MaxEpaVertices) {
+            break;
+        }
+        ++output.iterations;
+
+        const SupportPoint point = support(a, b, face.normal);
+        if (point.w.dot(face.normal) - face.distance < EpaTolerance) {
+            break;
+        }
+
+        // Remove every face the new point sees and patch the hole
+        const uint32_t newIndex = vertexCount;
+        vertices[vertexCount++] = point;
+        uint32_t edgeCount = 0;
+        for (uint32_t i = faceCount; i-- > 0;) {
+            if (faces[i].normal.dot(point.w - vertices[faces[i].index[0]].w) > 0.0f) {
+                toggleEdge(edges, edgeCount, faces[i].index[0], faces[i].index[1]);
+                toggleEdge(edges, edgeCount, faces[i].index[1], faces[i].index[2]);
+                toggleEdge(edges, edgeCount, faces[i].index[2], faces[i].index[0]);
+                faces[i] = faces[--faceCount];
+            }
+        }
+
+        bool full = false;
+        for (uint32_t i = 0; i < edgeCount; ++i) {
+            if (faceCount == MaxEpaFaces) {
+                full = true;
+                break;
+            }
+            if (makeFace(vertices, edges[i].first, edges[i].second, newIndex, faces[faceCount])) {
+                ++faceCount;
+            }
+        }
+        if (full || faceCount == 0) {
+            faces[0] = face;
+            faceCount = 1;
+            break;
+        }
+    }
+
+    closest = 0;
+    for (uint32_t i = 1; i < faceCount; ++i) {
+        if (faces[i].distance < faces[closest].distance) {
+            closest = i;
+        }
+    }
+    const EpaFace& face = faces[closest];
+
+    // Barycentric coordinates of the origin's projection on the closest face
+    const SupportPoint& p0 = vertices[face.index[0]];
+    const SupportPoint& p1 = vertices[face.index[1]];
+    const SupportPoint& p2 = vertices[face.index[2]];
+    const Vec3 projection = face.normal * face.distance;
+    const Vec3 e0 = p1.w - p0.w;
+    const Vec3 e1 = p2.w - p0.w;
+    const Vec3 e2 = projection - p0.w;
+    const float d00 = e0.dot(e0);
+    const float d01 = e0.dot(e1);
+    const float d11 = e1.dot(e1);
+    const float d20 = e2.dot(e0);
+    const float d21 = e2.dot(e1);
+    const float denominator = d00 * d11 - d01 * d01;
+    float v = 0.0f;
+    float w = 0.0f;
+    if (denominator > 0.0f) {
+        v = std::clamp((d11 * d20 - d01 * d21) / denominator, 0.0f, 1.0f);
+        w = std::clamp((d00 * d21 - d01 * d20) / denominator, 0.0f, 1.0f - v);
+    }
+    const float u = 1.0f - v - w;
+
+    output.normal = face.normal;
+    output.depth = std::max(face.distance, 0.0f);
+    output.pointA = p0.pointA * u + p1.pointA * v + p2.pointA * w;
+    output.pointB = p0.pointB * u + p1.pointB * v + p2.pointB * w;
+    output.valid = true;
+    return output;
+}
+
+//=============================================================================
+// Cache
+//=============================================================================
+
+void loadSimplex(const PlacedShape& a, const PlacedShape& b, const SimplexCache* cache,
+                 Simplex& simplex) noexcept {
+    simplex.count = 0;
+    if (cache == nullptr) {
+        return;
+    }
+    for (uint32_t i = 0; i < cache->count; ++i) {
+        simplex.points[i] = makePoint(a, b, cache->localA[i], cache->localB[i]);
+    }
+    simplex.count = cache->count;
+}
+
+void storeSimplex(const Simplex& simplex, SimplexCache& cache) noexcept {
+    for (uint32_t i = 0; i < simplex.count; ++i) {
+        cache.localA[i] = simplex.points[i].localA;
+        cache.localB[i] = simplex.points[i].localB;
+    }
+    cache.count = simplex.count;
+}
+
+/// Separation of the shapes along the cached axis, or -infinity without one
+float cachedAxisSeparation(const PlacedShape& a, const PlacedShape& b,
+                           const SimplexCache* cache) noexcept {
+    if (cache == nullptr || cache->separatingAxis.lengthSquared() == 0.0f) {
+        return -std::numeric_limits<float>::infinity();
+    }
+    const Vec3 axis = a.rotate(cache->separatingAxis);
+    const Vec3 pointA = a.toWorld(a.shape.supportCore(cache->separatingAxis));
+    const Vec3 pointB = b.toWorld(b.shape.supportCore(b.unrotate(-axis)));
+    return axis.dot(pointB - pointA) - a.shape.radius - b.shape.radius;
+}
+
+[[maybe_unused]] bool isBounded(const ConvexShape& shape) noexcept {
+    return shape.type == ShapeType::Sphere || shape.type == ShapeType::Box ||
+           shape.type == ShapeType::Capsule || shape.type == ShapeType::Convex;
+}
+
+}  // namespace
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+ConvexContact collideConvex(const ConvexShape& shapeA, const math::Transform& transformA,
+                            const ConvexShape& shapeB, const math::Transform& transformB,
+                            float maxDistance, SimplexCache* cache) noexcept {
+    AXIOM_ASSERT(isBounded(shapeA) && isBounded(shapeB),
+                 "Planes and meshes need the analytic contact kernels");
+    const PlacedShape a(shapeA, transformA);
+    const PlacedShape b(shapeB, transformB);
+    const float radii = shapeA.radius + shapeB.radius;
+    ConvexContact contact;
+
+    const float cachedSeparation = cachedAxisSeparation(a, b, cache);
+    if (cachedSeparation > maxDistance) {
+        contact.normal = a.rotate(cache->separatingAxis);
+        contact.distance = cachedSeparation;
+        contact.separatedByCache = true;
+        return contact;
+    }
+
+    Simplex simplex;
+    loadSimplex(a, b, cache, simplex);
+    const GjkOutput gjk = runGjk(a, b, simplex, radii + maxDistance);
+    contact.gjkIterations = gjk.iterations;
+    if (cache != nullptr) {
+        storeSimplex(simplex, *cache);
+        cache->separatingAxis = Vec3::zero();
+    }
+
+    if (!gjk.overlap) {
+        const float coreDistance = gjk.closest.length();
+        contact.normal = gjk.closest / -coreDistance;
+        if (gjk.separated) {
+            contact.distance = gjk.lowerBound - radii;
+        } else {
+            contact.distance = coreDistance - radii;
+            contact.pointA = gjk.pointA + contact.normal * shapeA.radius;
+            contact.pointB = gjk.pointB - contact.normal * shapeB.radius;
+        }
+        contact.touching = contact.distance <= maxDistance;
+        if (!contact.touching && cache != nullptr) {
+            cache->separatingAxis = a.unrotate(contact.normal);
+        }
+        return contact;
+    }
+
+    const EpaOutput epa = runEpa(a, b, simplex);
+    contact.epaIterations = epa.iterations;
+    contact.touching = true;
+    if (!epa.valid) {
+        // Flat cores touching: no volume to expand, so the contact is exact
+        // at zero core depth
+        Vec3 normal = b.position - a.position;
+        contact.normal = normal.lengthSquared() > 0.0f ? normal.normalized() : Vec3::unitY();
+        simplex.witnesses(contact.pointA, contact.pointB);
+        contact.distance = -radii;
+    } else {
+        contact.normal = epa.normal;
+        contact.distance = -epa.depth - radii;
+        contact.pointA = epa.pointA;
+        contact.pointB = epa.pointB;
+    }
+    contact.pointA += contact.normal * shapeA.radius;
+    contact.pointB -= contact.normal * shapeB.radius;
+    return contact;
+}
+
+bool overlapConvex(const ConvexShape& shapeA, const math::Transform& transformA,
+                   const ConvexShape& shapeB, const math::Transform& transformB,
+                   SimplexCache* cache) noexcept {
+    AXIOM_ASSERT(isBounded(shapeA) && isBounded(shapeB),
+                 "Planes and meshes need the analytic contact kernels");
+    const PlacedShape a(shapeA, transformA);
+    const PlacedShape b(shapeB, transformB);
+    const float radii = shapeA.radius + shapeB.radius;
+
+    if (cachedAxisSeparation(a, b, cache) > 0.0f) {
+        return false;
+    }
+
+    Simplex simplex;
+    loadSimplex(a, b, cache, simplex);
+    const GjkOutput gjk = runGjk(a, b, simplex, radii);
+    const bool overlap =
+        gjk.overlap || (!gjk.separated && gjk.closest.lengthSquared() <= radii * radii);
+    if (cache != nullptr) {
+        storeSimplex(simplex, *cache);
+        cache->separatingAxis =
+            overlap ? Vec3::zero() : a.unrotate(gjk.closest / -gjk.closest.length());
+    }
+    return overlap;
+}
+
+ConvexCast castConvex(const ConvexShape& shapeA, const math::Transform& transformA,
+                      const math::Vec3& direction, float maxDistance, const ConvexShape& shapeB,
+                      const math::Transform& transformB, float tolerance) noexcept {
+    AXIOM_ASSERT(isBounded(shapeA) && isBounded(shapeB),
+                 "Planes and meshes need the analytic contact kernels");
+    ConvexCast cast;
+    SimplexCache cache;
+    math::Transform moved = transformA;
+    float travelled = 0.0f;
+    while (cast.iterations < MaxCastIterations) {
+        ++cast.iterations;
+        moved.position = transformA.position + direction * travelled;
+        const ConvexContact contact = collideConvex(shapeA, moved, shapeB, transformB,
+                                                    std::numeric_limits<float>::max(), &cache);
+        if (contact.distance <= tolerance) {
+            cast.hit = true;
+            cast.distance = travelled;
+            cast.normal = -contact.normal;
+            cast.point = contact.pointB;
+            return cast;
+        }
+
+        // Closing speed along the normal; A cannot reach B sooner than distance / speed
+        const float approach = direction.dot(contact.normal);
+        if (approach <= 1.0e-6f) {
+            return cast;
+        }
+        travelled += contact.distance / approach;
+        if (travelled > maxDistance) {
+            return cast;
+        }
+    }
+    return cast;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,333 @@
+#include "axiom/collision/height_field.hpp"
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <limits>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Vec3;
+
+constexpr float QuantizationSteps = 65535.0f;
+
+/// Triangle indices must fit in 32 bits
+constexpr uint64_t MaxCells = UINT32_MAX / 2;
+
+}  // namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+core::Result<HeightField> HeightField::create(std::span<const float> heights,
+                                              uint32_t sampleCountX, uint32_t sampleCountZ,
+                                              float cellSize, std::span<const uint8_t> materials) {
+    AXIOM_PROFILE_FUNCTION();
+
+    if (sampleCountX < 2 || sampleCountZ < 2) {
+        return core::Result<HeightField>::failure(core::ErrorCode::InvalidShape,
+                                                  "Height field needs at least 2x2 samples");
+    }
+    const uint64_t cellCount = uint64_t{sampleCountX - 1} * (sampleCountZ - 1);
+    if (cellCount > MaxCells) {
+        return core::Result<HeightField>::failure(core::ErrorCode::InvalidShape, "Too many cells");
+    }
+    if (heights.size() != uint64_t{sampleCountX} * sampleCountZ) {
+        return core::Result<HeightField>::failure(
+            core::ErrorCode::InvalidShape, "Height count must be sampleCountX * sampleCountZ");
+    }
+    if (!materials.empty() && materials.size() != cellCount) {
+        return core::Result<HeightField>::failure(core::ErrorCode::InvalidShape,
+                                                  "Material count must match the cell count");
+    }
+    if (!(cellSize > 0.0f) || !std::isfinite(cellSize)) {
+        return core::Result<HeightField>::failure(core::ErrorCode::InvalidShape,
+                                                  "Cell size must be positive");
+    }
+    float lowest = std::numeric_limits<float>::max();
+    float highest = std::numeric_limits<float>::lowest();
+    for (const float height : heights) {
+        if (!std::isfinite(height)) {
+            return core::Result<HeightField>::failure(core::ErrorCode::InvalidShape,
+                                                      "Heights must be finite");
+        }
+        lowest = std::min(lowest, height);
+        highest = std::max(highest, height);
+    }
+
+    HeightField field;
+    field.sampleCountX_ = sampleCountX;
+    field.sampleCountZ_ = sampleCountZ;
+    field.cellSize_ = cellSize;
+    field.inverseCellSize_ = 1.0f / cellSize;
+    field.heightOffset_ = lowest;
+    field.heightStep_ = (highest - lowest) / QuantizationSteps;
+    field.inverseHeightStep_ = field.heightStep_ > 0.0f ? 1.0f / field.heightStep_ : 0.0f;
+
+    // Round to nearest: the dequantized height is within half a step
+    field.heights_.reserve(heights.size());
+    for (const float height : heights) {
+        const float steps = std::round((height - lowest) * field.inverseHeightStep_);
+        field.heights_.push_back(static_cast<uint16_t>(std::clamp(steps, 0.0f, QuantizationSteps)));
+    }
+    field.materials_.assign(materials.begin(), materials.end());
+
+    const auto cellsX = sampleCountX - 1;
+    const auto cellsZ = sampleCountZ - 1;
+    field.bounds_ = AABB(Vec3(0.0f, lowest, 0.0f),
+                         Vec3(static_cast<float>(cellsX) * cellSize,
+                              lowest + field.heightStep_ * QuantizationSteps,
+                              static_cast<float>(cellsZ) * cellSize));
+
+    // Level 0: height range of the samples around each block of cells
+    Level level{(cellsX + BlockSize - 1) / BlockSize, (cellsZ + BlockSize - 1) / BlockSize, 0,
+                BlockSize};
+    field.levels_.push_back(level);
+    for (uint32_t blockZ = 0; blockZ < level.blocksZ; ++blockZ) {
+        for (uint32_t blockX = 0; blockX < level.blocksX; ++blockX) {
+            Range range{UINT16_MAX, 0};
+            const uint32_t endZ = std::min((blockZ + 1) * BlockSize, cellsZ);
+            const uint32_t endX = std::min((blockX + 1) * BlockSize, cellsX);
+            for (uint32_t z = blockZ * BlockSize; z <= endZ; ++z) {
+                for (uint32_t x = blockX * BlockSize; x <= endX; ++x) {
+                    const uint16_t height = field.heights_[z * sampleCountX + x];
+                    range.min = std::min(range.min, height);
+                    range.max = std::max(range.max, height);
+                }
+            }
+            field.ranges_.push_back(range);
+        }
+    }
+
+    // Each level above merges 2x2 blocks of the one below, up to a single root
+    while (level.blocksX > 1 || level.blocksZ > 1) {
+        const Level below = level;
+        level = {(below.blocksX + 1) / 2, (below.blocksZ + 1) / 2,
+                 static_cast<uint32_t>(field.ranges_.size()), below.blockCells * 2};
+        field.levels_.push_back(level);
+        for (uint32_t blockZ = 0; blockZ < level.blocksZ; ++blockZ) {
+            for (uint32_t blockX = 0; blockX < level.blocksX; ++blockX) {
+                Range range{UINT16_MAX, 0};
+                for (uint32_t child = 0; child < 4; ++child) {
+                    const uint32_t childX = 2 * blockX + (child & 1);
+                    const uint32_t childZ = 2 * blockZ + (child >> 1);
+                    if (childX < below.blocksX && childZ < below.blocksZ) {
+                        const Range& source =
+                            field.ranges_[below.first + childZ * below.blocksX + childX];
+                        range.min = std::min(range.min, source.min);
+                        range.max = std::max(range.max, source.max);
+                    }
+                }
+                field.ranges_.push_back(range);
+            }
+        }
+    }
+
+    return core::Result<HeightField>::success(std::move(field));
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+uint16_t HeightField::quantize(float height, bool roundUp) const noexcept {
+    const float steps = (height - heightOffset_) * inverseHeightStep_;
+    const float rounded = roundUp ? std::ceil(steps) : std::floor(steps);
+    return static_cast<uint16_t>(std::clamp(rounded, 0.0f, QuantizationSteps));
+}
+
+bool HeightField::raycast(const math::Vec3& origin, const math::Vec3& direction,
+                          float maxDistance, HeightFieldRayHit& hit) const noexcept {
+    if (levels_.empty()) {
+        return false;
+    }
+
+    const Vec3 inverse(detail::safeInverse(direction.x), detail::safeInverse(direction.y),
+                       detail::safeInverse(direction.z));
+
+    // Slab test against a block's columns, between its lowest and highest sample
+    const auto intersectBlock = [&](uint32_t level, uint32_t x, uint32_t z,
+                                    PendingBlock& block) {
+        const Range& range = getRange(level, x, z);
+        const float size = static_cast<float>(levels_[level].blockCells) * cellSize_;
+        const float x0 = (static_cast<float>(x) * size - origin.x) * inverse.x;
+        const float x1 =
+            (std::min(static_cast<float>(x + 1) * size, bounds_.max.x) - origin.x) * inverse.x;
+        const float z0 = (static_cast<float>(z) * size - origin.z) * inverse.z;
+        const float z1 =
+            (std::min(static_cast<float>(z + 1) * size, bounds_.max.z) - origin.z) * inverse.z;
+        const float y0 =
+            (heightOffset_ + heightStep_ * static_cast<float>(range.min) - origin.y) * inverse.y;
+        const float y1 =
+            (heightOffset_ + heightStep_ * static_cast<float>(range.max) - origin.y) * inverse.y;
+        block = {level, x, z,
+                 std::max(std::max(std::min(x0, x1), std::min(y0, y1)),
+                          std::max(std::min(z0, z1), 0.0f)),
+                 std::min(std::min(std::max(x0, x1), std::max(y0, y1)),
+                          std::min(std::max(z0, z1), maxDistance))};
+        return block.enter <= block.exit;
+    };
+
+    std::array<PendingBlock, StackSize> stack;
+    if (!intersectBlock(static_cast<uint32_t>(levels_.size() - 1), 0, 0, stack[0])) {
+        return false;
+    }
+    uint32_t stackSize = 1;
+    while (stackSize > 0) {
+        const PendingBlock block = stack[--stackSize];
+        if (block.level == 0) {
+            // Blocks are visited front to back, so the first one hit holds the closest hit;
+            // the walk goes a little past the block's height range for rounding
+            const float walkEnd = std::min(block.exit + 1.0e-5f * (1.0f + block.exit), maxDistance);
+            if (raycastBlock(block.x, block.z, origin, direction, block.enter, walkEnd,
+                             maxDistance, hit)) {
+                return true;
+            }
+            continue;
+        }
+
+        // Children the ray hits, pushed far to near so the nearest is on top of the stack
+        const Level& below = levels_[block.level - 1];
+        std::array<PendingBlock, 4> children;
+        uint32_t childCount = 0;
+        for (uint32_t child = 0; child < 4; ++child) {
+            const uint32_t childX = 2 * block.x + (child & 1);
+            const uint32_t childZ = 2 * block.z + (child >> 1);
+            PendingBlock candidate;
+            if (childX >= below.blocksX || childZ >= below.blocksZ ||
+                !intersectBlock(block.level - 1, childX, childZ, candidate)) {
+                continue;
+            }
+            uint32_t slot = childCount++;
+            while (slot > 0 && children[slot - 1].enter < candidate.enter) {
+                children[slot] = children[slot - 1];
+                --slot;
+            }
+            children[slot] = candidate;
+        }
+        for (uint32_t i = 0; i < childCount; ++i) {
+            AXIOM_ASSERT(stackSize < StackSize, "Height field traversal stack overflow");
+            stack[stackSize++] = children[i];
+        }
+    }
+    return false;
+}
+
+bool HeightField::raycastBlock(uint32_t blockX, uint32_t blockZ, const math::Vec3& origin,
+                               const math::Vec3& direction, float tEnter, float tExit,
+                               float maxDistance, HeightFieldRayHit& hit) const noexcept {
+    const uint32_t beginX = blockX * BlockSize;
+    const uint32_t beginZ = blockZ * BlockSize;
+    const uint32_t endX = std::min(beginX + BlockSize, getCellsX()) - 1;
+    const uint32_t endZ = std::min(beginZ + BlockSize, getCellsZ()) - 1;
+
+    // Cell under the entry point
+    const Vec3 entry = origin + direction * tEnter;
+    const auto toCell = [&](float coordinate, uint32_t first, uint32_t last) {
+        const float cell = std::floor(coordinate * inverseCellSize_);
+        return static_cast<uint32_t>(
+            std::clamp(cell, static_cast<float>(first), static_cast<float>(last)));
+    };
+    uint32_t x = toCell(entry.x, beginX, endX);
+    uint32_t z = toCell(entry.z, beginZ, endZ);
+
+    // Distances to the next cell boundary along X and Z, and between boundaries
+    const float infinity = std::numeric_limits<float>::infinity();
+    const bool alongX = std::abs(direction.x) > 1.0e-20f;
+    const bool alongZ = std::abs(direction.z) > 1.0e-20f;
+    const float boundaryX = static_cast<float>(direction.x > 0.0f ? x + 1 : x) * cellSize_;
+    const float boundaryZ = static_cast<float>(direction.z > 0.0f ? z + 1 : z) * cellSize_;
+    float nextX = alongX ? (boundaryX - origin.x) / direction.x : infinity;
+    float nextZ = alongZ ? (boundaryZ - origin.z) / direction.z : infinity;
+    const float deltaX = alongX ? cellSize_ / std::abs(direction.x) : infinity;
+    const float deltaZ = alongZ ? cellSize_ / std::abs(direction.z) : infinity;
+
+    // Quantized heights are exact, so half a step covers rounding in the ray heights
+    const float margin = heightStep_ * 0.5f + 1.0e-5f;
+    float cellEnter = tEnter;
+    while (cellEnter <= tExit) {
+        const float cellExit = std::min(std::min(nextX, nextZ), tExit);
+        const uint32_t cell = z * getCellsX() + x;
+        if (!isHole(cell)) {
+            const uint16_t h00 = heights_[z * sampleCountX_ + x];
+            const uint16_t h10 = heights_[z * sampleCountX_ + x + 1];
+            const uint16_t h01 = heights_[(z + 1) * sampleCountX_ + x];
+            const uint16_t h11 = heights_[(z + 1) * sampleCountX_ + x + 1];
+            const float low =
+                heightOffset_ + heightStep_ * static_cast<float>(std::min({h00, h10, h01, h11}));
+            const float high =
+                heightOffset_ + heightStep_ * static_cast<float>(std::max({h00, h10, h01, h11}));
+            const float rayEnter = origin.y + direction.y * cellEnter;
+            const float rayExit = origin.y + direction.y * cellExit;
+            if (std::min(rayEnter, rayExit) <= high + margin &&
+                std::max(rayEnter, rayExit) >= low - margin) {
+                float closest = std::numeric_limits<float>::max();
+                uint32_t closestTriangle = UINT32_MAX;
+                for (uint32_t triangle = 2 * cell; triangle < 2 * cell + 2; ++triangle) {
+                    const float distance =
+                        detail::intersectTriangle(origin, direction, getTriangle(triangle));
+                    if (distance >= 0.0f && distance <= maxDistance && distance < closest) {
+                        closest = distance;
+                        closestTriangle = triangle;
+                    }
+                }
+                if (closestTriangle != UINT32_MAX) {
+                    const std::array<Vec3, 3> vertices = getTriangle(closestTriangle);
+                    Vec3 normal =
+                        (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]).normalized();
+                    if (normal.dot(direction) > 0.0f) {
+                        normal = -normal;
+                    }
+                    hit.distance = closest;
+                    hit.point = origin + direction * closest;
+                    hit.normal = normal;
+                    hit.triangle = closestTriangle;
+                    hit.material = getMaterial(closestTriangle);
+                    return true;
+                }
+            }
+        }
+
+        // Step into the next cell of the block
+        if (nextX < nextZ) {
+            if (direction.x > 0.0f ? x == endX : x == beginX) {
+                break;
+            }
+            x = direction.x > 0.0f ? x + 1 : x - 1;
+            cellEnter = nextX;
+            nextX += deltaX;
+        } else {
+            if (!alongZ || (direction.z > 0.0f ? z == endZ : z == beginZ)) {
+                break;
+            }
+            z = direction.z > 0.0f ? z + 1 : z - 1;
+            cellEnter = nextZ;
+            nextZ += deltaZ;
+        }
+    }
+    return false;
+}
+
+//=============================================================================
+// Properties
+//=============================================================================
+
+HeightFieldStats HeightField::getStats() const noexcept {
+    HeightFieldStats stats;
+    if (levels_.empty()) {
+        return stats;
+    }
+    stats.cellCount = getCellsX() * getCellsZ();
+    stats.levelCount = static_cast<uint32_t>(levels_.size());
+    stats.memoryBytes = sizeof(HeightField) + heights_.size() * sizeof(uint16_t) +
+                        materials_.size() + levels_.size() * sizeof(Level) +
+                        ranges_.size() * sizeof(Range);
+    return stats;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,221 @@
+#include "axiom/collision/narrowphase.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+#include "axiom/memory/linear_allocator.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace axiom::collision {
+
+namespace {
+
+uint64_t getPairKey(const OverlappingPair& pair) noexcept {
+    return (static_cast<uint64_t>(pair.a) << 32) | pair.b;
+}
+
+}  // namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+Narrowphase::Narrowphase(const NarrowphaseConfig& config)
+    : config_(config), scratch_(std::make_unique<memory::FrameAllocator>(config.scratchBytes)) {
+    AXIOM_ASSERT(config_.batchSize > 0, "Batch size must be positive");
+}
+
+Narrowphase::~Narrowphase() = default;
+
+//=============================================================================
+// Update
+//=============================================================================
+
+void Narrowphase::update(OverlappingPairCache& cache, std::span<const SceneObject> objects,
+                         core::JobSystem* jobSystem) {
+    AXIOM_PROFILE_SCOPE("Narrowphase::update");
+
+    stats_ = {};
+    scratch_->flip();
+    updateOrder(cache);
+
+    const auto pairCount = static_cast<uint32_t>(order_.size());
+    const uint32_t batchCount = (pairCount + config_.batchSize - 1) / config_.batchSize;
+    AXIOM_PROFILE_ELEMENTS(pairCount);
+
+    // One stream per worker, then the one of any other thread (the last)
+    const uint32_t workerCount = jobSystem != nullptr ? jobSystem->getWorkerCount() : 0;
+    if (streams_.size() != workerCount + 1) {
+        streams_ = std::vector<Stream>(workerCount + 1);
+    }
+    for (Stream& stream : streams_) {
+        stream.overflow.clear();
+        stream.stats = {};
+    }
+    batches_.resize(batchCount);
+
+    const auto runBatches = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t batch = begin; batch < end; ++batch) {
+            runBatch(batch, cache, objects, jobSystem);
+        }
+    };
+    if (jobSystem != nullptr && batchCount > 1) {
+        jobSystem->parallelFor(batchCount, 1, runBatches);
+    } else {
+        runBatches(0, batchCount);
+    }
+
+    // Merge: the batches are consecutive runs of the key order
+    uint32_t touching = 0;
+    for (const BatchOutput& output : batches_) {
+        touching += output.count;
+    }
+    contacts_.resize(touching);
+    uint32_t next = 0;
+    for (const BatchOutput& output : batches_) {
+        const NarrowphaseContact* contacts =
+            output.contacts != nullptr ? output.contacts
+                                       : streams_[output.stream].overflow.data() + output.offset;
+        std::copy_n(contacts, output.count, contacts_.begin() + next);
+        next += output.count;
+    }
+
+    for (const Stream& stream : streams_) {
+        stats_.touchingCount += stream.stats.touchingCount;
+        stats_.pointCount += stream.stats.pointCount;
+        stats_.genericCount += stream.stats.genericCount;
+        stats_.overflowCount += stream.stats.overflowCount;
+    }
+    stats_.pairCount = pairCount;
+    stats_.batchCount = batchCount;
+}
+
+void Narrowphase::updateOrder(const OverlappingPairCache& cache) {
+    if (orderCache_ != &cache) {
+        order_.clear();
+        orderCache_ = &cache;
+        orderUpdate_ = 0;
+    }
+    const uint32_t update = cache.getUpdateCount();
+    bool rebuild = update != orderUpdate_ && update != orderUpdate_ + 1;
+    if (update == orderUpdate_ + 1) {
+        // Drop the removed pairs; their ids are not reused before the next update
+        const std::span<const PairId> removed = cache.getRemovedPairs();
+        if (!removed.empty()) {
+            removed_.resize(cache.getPairCapacity(), 0);
+            for (PairId id : removed) {
+                removed_[id] = 1;
+            }
+            std::erase_if(order_, [&](const SortedPair& pair) { return removed_[pair.id] != 0; });
+            for (PairId id : removed) {
+                removed_[id] = 0;
+            }
+        }
+
+        // Merge in the added pairs, which the cache lists in key order
+        const std::span<const PairId> added = cache.getAddedPairs();
+        if (!added.empty()) {
+            merged_.clear();
+            merged_.reserve(order_.size() + added.size());
+            size_t next = 0;
+            for (PairId id : added) {
+                const uint64_t key = getPairKey(cache.getPair(id));
+                while (next < order_.size() && order_[next].key < key) {
+                    merged_.push_back(order_[next++]);
+                }
+                merged_.push_back({key, id});
+            }
+            merged_.insert(merged_.end(), order_.begin() + static_cast<ptrdiff_t>(next),
+                           order_.end());
+            order_.swap(merged_);
+        }
+    }
+    orderUpdate_ = update;
+
+    // Missed updates, or pairs removed by removePairsContaining() since: sort from scratch
+    if (rebuild || order_.size() != cache.getPairCount()) {
+        order_.clear();
+        cache.forEachPair([&](PairId id, const OverlappingPair& pair) {
+            order_.push_back({getPairKey(pair), id});
+        });
+        std::sort(order_.begin(), order_.end(),
+                  [](const SortedPair& a, const SortedPair& b) { return a.key < b.key; });
+        stats_.reordered = true;
+    }
+}
+
+void Narrowphase::runBatch(uint32_t batch, OverlappingPairCache& cache,
+                           std::span<const SceneObject> objects, core::JobSystem* jobSystem) {
+    const uint32_t worker = jobSystem != nullptr ? jobSystem->getCurrentWorkerIndex()
+                                                 : core::JobSystem::InvalidWorkerIndex;
+    const bool isWorker = worker != core::JobSystem::InvalidWorkerIndex;
+    const auto streamIndex = isWorker ? worker : static_cast<uint32_t>(streams_.size() - 1);
+    Stream& stream = streams_[streamIndex];
+    memory::FrameAllocator& scratch = isWorker ? jobSystem->getScratchAllocator() : *scratch_;
+
+    const uint32_t begin = batch * config_.batchSize;
+    const uint32_t end = std::min(begin + config_.batchSize, static_cast<uint32_t>(order_.size()));
+    stream.ids.clear();
+    stream.pairs.clear();
+    for (uint32_t i = begin; i < end; ++i) {
+        const PairId id = order_[i].id;
+        const OverlappingPair& pair = cache.getPair(id);
+        AXIOM_ASSERT(pair.a < objects.size() && pair.b < objects.size(),
+                     "Every proxy of the cache needs an object");
+        const SceneObject& a = objects[pair.a];
+        const SceneObject& b = objects[pair.b];
+        if (a.shape == nullptr || b.shape == nullptr) {
+            cache.getManifold(id).clear();
+            continue;
+        }
+        stream.ids.push_back(id);
+        stream.pairs.push_back(
+            {a.shape, &a.transform, b.shape, &b.transform, &cache.getSimplexCache(id)});
+    }
+    stream.manifolds.resize(stream.pairs.size());
+    stream.dispatcher.generate(stream.pairs, config_.maxDistance, stream.manifolds);
+
+    // Per-pair state belongs to this batch alone
+    const ContactDispatcherStats& dispatched = stream.dispatcher.getStats();
+    for (size_t k = 0; k < stream.pairs.size(); ++k) {
+        cache.getManifold(stream.ids[k])
+            .update(stream.manifolds[k], *stream.pairs[k].transformA, *stream.pairs[k].transformB,
+                    config_.manifold);
+    }
+    stream.stats.touchingCount += dispatched.touchingCount;
+    stream.stats.pointCount += dispatched.pointCount;
+    stream.stats.genericCount += dispatched.genericCount;
+
+    // Append the touching pairs to the stream: a scratch block, or the heap if it is full
+    BatchOutput& output = batches_[batch];
+    output = {nullptr, streamIndex, 0, dispatched.touchingCount};
+    if (output.count == 0) {
+        return;
+    }
+    void* block = scratch.allocate(output.count * sizeof(NarrowphaseContact),
+                                   alignof(NarrowphaseContact));
+    auto* contacts = static_cast<NarrowphaseContact*>(block);
+    if (block == nullptr) {
+        output.offset = static_cast<uint32_t>(stream.overflow.size());
+        ++stream.stats.overflowCount;
+    }
+    uint32_t written = 0;
+    for (size_t k = 0; k < stream.pairs.size(); ++k) {
+        if (stream.manifolds[k].pointCount == 0) {
+            continue;
+        }
+        const OverlappingPair& pair = cache.getPair(stream.ids[k]);
+        const NarrowphaseContact contact{stream.ids[k], pair.a, pair.b, stream.manifolds[k]};
+        if (contacts != nullptr) {
+            new (contacts + written) NarrowphaseContact(contact);
+        } else {
+            stream.overflow.push_back(contact);
+        }
+        ++written;
+    }
+    output.contacts = contacts;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,294 @@
+#include "axiom/collision/overlapping_pair_cache.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+constexpr uint32_t MinSlots = 16;
+constexpr uint32_t MaxSlotBits = 31;
+
+/// Load limit while addPair() may run on several threads; above it, new
+/// pairs are deferred to endUpdate(). Linear probing degrades quickly past 3/4.
+constexpr uint32_t MaxLoadNumerator = 3;
+constexpr uint32_t MaxLoadDenominator = 4;
+
+}  // namespace
+
+OverlappingPairCache::OverlappingPairCache(const OverlappingPairCacheConfig& config)
+    : config_(config) {
+    pairs_.reserve(config_.initialCapacity);
+    rehash(std::bit_ceil(std::max(2 * config_.initialCapacity, MinSlots)));
+}
+
+//=============================================================================
+// Hash table
+//=============================================================================
+
+uint64_t OverlappingPairCache::makeKey(ProxyId a, ProxyId b) noexcept {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+uint32_t OverlappingPairCache::slotOf(uint64_t key) const noexcept {
+    // Fibonacci hashing: the top bits of the product are well mixed
+    return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - slotBits_));
+}
+
+uint32_t OverlappingPairCache::findSlot(uint64_t key) const noexcept {
+    for (uint32_t index = slotOf(key);; index = (index + 1) & slotMask_) {
+        const uint64_t current = slots_[index].key;
+        if (current == key) {
+            return index;
+        }
+        if (current == EmptyKey) {
+            return UINT32_MAX;
+        }
+    }
+}
+
+bool OverlappingPairCache::insertSerial(uint64_t key) noexcept {
+    for (uint32_t index = slotOf(key);; index = (index + 1) & slotMask_) {
+        Slot& slot = slots_[index];
+        if (slot.key == key) {
+            slot.lastSeen = frame_;
+            return false;
+        }
+        if (slot.key == EmptyKey) {
+            slot = {key, InvalidPairId, frame_};
+            ++occupiedSlots_;
+            return true;
+        }
+    }
+}
+
+void OverlappingPairCache::eraseSlot(uint32_t index) noexcept {
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole unless that would move them before their home slot
+    uint32_t hole = index;
+    for (uint32_t next = (hole + 1) & slotMask_; slots_[next].key != EmptyKey;
+         next = (next + 1) & slotMask_) {
+        const uint32_t home = slotOf(slots_[next].key);
+        if (((next - home) & slotMask_) >= ((next - hole) & slotMask_)) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+    }
+    slots_[hole] = Slot{};
+    --occupiedSlots_;
+}
+
+void OverlappingPairCache::rehash(uint32_t slotCount) {
+    const auto bits = static_cast<uint32_t>(std::countr_zero(slotCount));
+    AXIOM_ASSERT(bits <= MaxSlotBits, "OverlappingPairCache table too large");
+
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(slotCount, Slot{});
+    slotBits_ = bits;
+    slotMask_ = slotCount - 1;
+
+    for (const Slot& slot : old) {
+        if (slot.key == EmptyKey) {
+            continue;
+        }
+        uint32_t index = slotOf(slot.key);
+        while (slots_[index].key != EmptyKey) {
+            index = (index + 1) & slotMask_;
+        }
+        slots_[index] = slot;
+    }
+    stats_.slotCount = slotCount;
+}
+
+void OverlappingPairCache::reserveSlots(size_t pairCount) {
+    // Target load 1/2; shrink only once the table is under 1/8 full
+    const size_t wanted = std::bit_ceil(
+        std::max<size_t>(2 * std::max<size_t>(pairCount, config_.initialCapacity), MinSlots));
+    if (wanted > slots_.size() || 4 * wanted < slots_.size()) {
+        rehash(static_cast<uint32_t>(wanted));
+    }
+}
+
+//=============================================================================
+// Update
+//=============================================================================
+
+void OverlappingPairCache::beginUpdate() {
+    AXIOM_ASSERT(!updating_, "beginUpdate() called twice without endUpdate()");
+
+    // Ids of the pairs removed last update could still be read until now
+    for (const PairId id : removed_) {
+        pairs_[id] = OverlappingPair{};
+        freePairs_.push_back(id);
+    }
+    removed_.clear();
+    added_.clear();
+
+    ++frame_;
+    reserveSlots(pairCount_);
+    maxOccupiedSlots_ =
+        static_cast<uint32_t>(slots_.size() / MaxLoadDenominator * MaxLoadNumerator);
+
+    // Every claimed slot holds a reservation below the load limit, so this many
+    // new keys can never overflow the list
+    const size_t maxNewKeys = maxOccupiedSlots_ - occupiedSlots_;
+    if (newKeys_.size() < maxNewKeys) {
+        newKeys_.resize(maxNewKeys);
+    }
+    newKeyCount_ = 0;
+    overflowKeys_.clear();
+    updating_ = true;
+}
+
+void OverlappingPairCache::addPair(ProxyId a, ProxyId b) noexcept {
+    AXIOM_ASSERT(updating_, "addPair() called outside beginUpdate()/endUpdate()");
+    AXIOM_ASSERT(a != b, "A proxy cannot overlap itself");
+
+    const uint64_t key = makeKey(a, b);
+    for (uint32_t index = slotOf(key);; index = (index + 1) & slotMask_) {
+        Slot& slot = slots_[index];
+        std::atomic_ref<uint64_t> slotKey(slot.key);
+        uint64_t current = slotKey.load(std::memory_order_acquire);
+
+        if (current == EmptyKey) {
+            // Reserve room under the load limit before claiming the slot
+            std::atomic_ref<uint32_t> occupied(occupiedSlots_);
+            if (occupied.fetch_add(1, std::memory_order_relaxed) >= maxOccupiedSlots_) {
+                occupied.fetch_sub(1, std::memory_order_relaxed);
+                std::lock_guard<core::SpinMutex> lock(overflowMutex_);
+                overflowKeys_.push_back(key);
+                return;
+            }
+
+            if (slotKey.compare_exchange_strong(current, key, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                std::atomic_ref<uint32_t>(slot.lastSeen).store(frame_, std::memory_order_relaxed);
+                const uint32_t keyIndex =
+                    std::atomic_ref<uint32_t>(newKeyCount_).fetch_add(1, std::memory_order_relaxed);
+                newKeys_[keyIndex] = key;
+                return;
+            }
+
+            // Another thread claimed the slot first; current now holds its key
+            occupied.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        if (current == key) {
+            std::atomic_ref<uint32_t>(slot.lastSeen).store(frame_, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void OverlappingPairCache::endUpdate() {
+    AXIOM_PROFILE_SCOPE("OverlappingPairCache::endUpdate");
+    AXIOM_ASSERT(updating_, "endUpdate() called without beginUpdate()");
+    updating_ = false;
+
+    addedKeys_.assign(newKeys_.begin(), newKeys_.begin() + newKeyCount_);
+    stats_.overflowCount = static_cast<uint32_t>(overflowKeys_.size());
+    if (!overflowKeys_.empty()) {
+        reserveSlots(occupiedSlots_ + overflowKeys_.size());
+        for (const uint64_t key : overflowKeys_) {
+            // The same pair may have been deferred twice or claimed by another thread
+            if (insertSerial(key)) {
+                addedKeys_.push_back(key);
+            }
+        }
+    }
+
+    // Key order makes the ids independent of which thread inserted first
+    std::sort(addedKeys_.begin(), addedKeys_.end());
+    for (const uint64_t key : addedKeys_) {
+        const PairId id = allocatePair(key);
+        slots_[findSlot(key)].pair = id;
+        added_.push_back(id);
+    }
+
+    staleKeys_.clear();
+    for (const Slot& slot : slots_) {
+        if (slot.key != EmptyKey && slot.lastSeen != frame_) {
+            staleKeys_.push_back(slot.key);
+        }
+    }
+    removeStaleKeys(removed_);
+
+    removed_.insert(removed_.end(), pendingRemoved_.begin(), pendingRemoved_.end());
+    pendingRemoved_.clear();
+
+    stats_.pairCount = pairCount_;
+    stats_.addedCount = static_cast<uint32_t>(added_.size());
+    stats_.removedCount = static_cast<uint32_t>(removed_.size());
+    AXIOM_PROFILE_ELEMENTS(pairCount_);
+}
+
+//=============================================================================
+// Pairs
+//=============================================================================
+
+PairId OverlappingPairCache::allocatePair(uint64_t key) {
+    PairId id;
+    if (!freePairs_.empty()) {
+        id = freePairs_.back();
+        freePairs_.pop_back();
+    } else {
+        id = static_cast<PairId>(pairs_.size());
+        AXIOM_ASSERT(id != InvalidPairId, "OverlappingPairCache pair pool exhausted");
+        pairs_.emplace_back();
+    }
+
+    pairs_[id] = {static_cast<ProxyId>(key >> 32), static_cast<ProxyId>(key), 0, {}, {}};
+    ++pairCount_;
+    return id;
+}
+
+void OverlappingPairCache::removeStaleKeys(std::vector<PairId>& removed) {
+    // Slot positions depend on insertion order; key order does not
+    std::sort(staleKeys_.begin(), staleKeys_.end());
+    for (const uint64_t key : staleKeys_) {
+        const uint32_t index = findSlot(key);
+        removed.push_back(slots_[index].pair);
+        eraseSlot(index);
+    }
+    pairCount_ -= static_cast<uint32_t>(staleKeys_.size());
+}
+
+void OverlappingPairCache::removePairsContaining(ProxyId proxy) {
+    AXIOM_ASSERT(!updating_, "removePairsContaining() called during an update");
+
+    staleKeys_.clear();
+    for (const Slot& slot : slots_) {
+        if (slot.key == EmptyKey) {
+            continue;
+        }
+        if (static_cast<ProxyId>(slot.key >> 32) == proxy ||
+            static_cast<ProxyId>(slot.key) == proxy) {
+            staleKeys_.push_back(slot.key);
+        }
+    }
+    removeStaleKeys(pendingRemoved_);
+}
+
+PairId OverlappingPairCache::findPair(ProxyId a, ProxyId b) const noexcept {
+    const uint32_t index = findSlot(makeKey(a, b));
+    return index == UINT32_MAX ? InvalidPairId : slots_[index].pair;
+}
+
+uint32_t OverlappingPairCache::getContactPointCount() const noexcept {
+    uint32_t count = 0;
+    forEachPair(
+        [&](PairId, const OverlappingPair& pair) { count += pair.manifold.getPointCount(); });
+    return count;
+}
+
+}  // namespace axiom::collision
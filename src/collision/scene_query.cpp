@@ -0,0 +1,685 @@
+#include "axiom/collision/scene_query.hpp"
+
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Vec3;
+
+constexpr float Infinity = std::numeric_limits<float>::infinity();
+
+/// castConvex() tolerance for rays: tighter than for shape casts, since a
+/// grazing ray stops tolerance / cos(angle) short of the surface
+constexpr float RayCastTolerance = 1.0e-4f;
+
+/// Hit of one lane of a packet against one object
+struct LaneHit {
+    float distance = 0.0f;
+    Vec3 point;
+    Vec3 normal;
+    uint32_t triangle = UINT32_MAX;
+};
+
+using LaneHits = std::array<LaneHit, RayPacket::Width>;
+
+//=============================================================================
+// Ray ordering
+//=============================================================================
+
+/// Sort key of a ray: its direction octant, then the Morton code of its origin
+uint32_t computeSortKey(const Ray& ray, const AABB& bounds, const Vec3& scale) noexcept {
+    const uint32_t octant = static_cast<uint32_t>(ray.direction.x < 0.0f) |
+                            static_cast<uint32_t>(ray.direction.y < 0.0f) << 1 |
+                            static_cast<uint32_t>(ray.direction.z < 0.0f) << 2;
+    const Vec3 cell = (ray.origin - bounds.min) * scale;
+    const auto quantize = [](float value) {
+        return static_cast<uint32_t>(std::clamp(value, 0.0f, 1023.0f));
+    };
+    const uint32_t morton = detail::spreadBits(quantize(cell.x)) |
+                            detail::spreadBits(quantize(cell.y)) << 1 |
+                            detail::spreadBits(quantize(cell.z)) << 2;
+    return octant << 30 | morton;
+}
+
+//=============================================================================
+// Ray packet against one object
+//=============================================================================
+
+/// Sphere: solid, so a ray starting inside hits at distance 0
+uint32_t intersectSphere(const ConvexShape& shape, const ShapeFrame& frame,
+                         const RayPacket& packet, LaneHits& hits) noexcept {
+    const float radiusSquared = shape.radius * shape.radius;
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        const Vec3 origin = packet.getOrigin(lane);
+        const Vec3 direction = packet.getDirection(lane);
+        const Vec3 offset = origin - frame.position;
+        const float b = offset.dot(direction);
+        const float c = offset.dot(offset) - radiusSquared;
+        const float discriminant = b * b - c;
+        const float t = c <= 0.0f ? 0.0f : -b - std::sqrt(std::max(discriminant, 0.0f));
+        const bool hit = (discriminant >= 0.0f) & (t >= 0.0f) & (t <= packet.length[lane]);
+        if (hit) {
+            hits[lane].distance = t;
+            hits[lane].point = origin + direction * t;
+            hits[lane].normal =
+                c <= 0.0f ? -direction : (hits[lane].point - frame.position) / shape.radius;
+        }
+        mask |= static_cast<uint32_t>(hit) << lane;
+    }
+    return mask & packet.activeMask;
+}
+
+/// Box without rounding: slab test in the box frame
+uint32_t intersectBox(const ConvexShape& shape, const ShapeFrame& frame, const RayPacket& packet,
+                      LaneHits& hits) noexcept {
+    const RayPacket local = packet.toLocal(frame);
+    const std::array<const std::array<float, RayPacket::Width>*, 3> origin = {
+        &local.originX, &local.originY, &local.originZ};
+    const std::array<const std::array<float, RayPacket::Width>*, 3> inverse = {
+        &local.inverseX, &local.inverseY, &local.inverseZ};
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        float entry = 0.0f;
+        float leave = packet.length[lane];
+        uint32_t entryAxis = 3;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            const float start = (*origin[axis])[lane];
+            const float scale = (*inverse[axis])[lane];
+            const float t0 = (-shape.halfExtents[axis] - start) * scale;
+            const float t1 = (shape.halfExtents[axis] - start) * scale;
+            const float axisEntry = std::min(t0, t1);
+            if (axisEntry > entry) {
+                entry = axisEntry;
+                entryAxis = axis;
+            }
+            leave = std::min(leave, std::max(t0, t1));
+        }
+        if (entry > leave) {
+            continue;
+        }
+        const Vec3 direction = packet.getDirection(lane);
+        Vec3 normal = -direction;
+        if (entryAxis < 3) {
+            Vec3 localNormal = Vec3::zero();
+            localNormal[entryAxis] = (*inverse[entryAxis])[lane] < 0.0f ? 1.0f : -1.0f;
+            normal = frame.rotate(localNormal);
+        }
+        hits[lane].distance = entry;
+        hits[lane].point = packet.getOrigin(lane) + direction * entry;
+        hits[lane].normal = normal;
+        mask |= 1u << lane;
+    }
+    return mask & packet.activeMask;
+}
+
+/// Plane: the solid half-space below it
+uint32_t intersectPlane(const ShapeFrame& frame, const RayPacket& packet,
+                        LaneHits& hits) noexcept {
+    const Vec3 normal = frame.axes[1];
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        const Vec3 origin = packet.getOrigin(lane);
+        const Vec3 direction = packet.getDirection(lane);
+        const float height = normal.dot(origin - frame.position);
+        const float approach = -normal.dot(direction);
+        float t = 0.0f;
+        if (height > 0.0f) {
+            if (approach <= 1.0e-12f) {
+                continue;
+            }
+            t = height / approach;
+        }
+        if (t > packet.length[lane]) {
+            continue;
+        }
+        hits[lane].distance = t;
+        hits[lane].point = origin + direction * t;
+        hits[lane].normal = normal;
+        mask |= 1u << lane;
+    }
+    return mask & packet.activeMask;
+}
+
+/// Mesh: packet traversal of its BVH in mesh space
+uint32_t intersectMesh(const TriangleMesh& mesh, const ShapeFrame& frame, const RayPacket& packet,
+                       LaneHits& hits, bool anyHit) noexcept {
+    RayPacket local = packet.toLocal(frame);
+    std::array<MeshRayHit, RayPacket::Width> meshHits;
+    const uint32_t mask = mesh.raycast(local, meshHits, anyHit);
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        if ((mask & (1u << lane)) != 0) {
+            hits[lane].distance = meshHits[lane].distance;
+            hits[lane].point = frame.toWorld(meshHits[lane].point);
+            hits[lane].normal = frame.rotate(meshHits[lane].normal);
+            hits[lane].triangle = meshHits[lane].triangle;
+        }
+    }
+    return mask;
+}
+
+/// Height field: its grid walk in height field space, one lane at a time
+uint32_t intersectHeightField(const HeightField& terrain, const ShapeFrame& frame,
+                              const RayPacket& packet, LaneHits& hits) noexcept {
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        if ((packet.activeMask & (1u << lane)) == 0) {
+            continue;
+        }
+        HeightFieldRayHit local;
+        if (terrain.raycast(frame.toLocal(packet.getOrigin(lane)),
+                            frame.unrotate(packet.getDirection(lane)), packet.length[lane],
+                            local)) {
+            hits[lane].distance = local.distance;
+            hits[lane].point = frame.toWorld(local.point);
+            hits[lane].normal = frame.rotate(local.normal);
+            hits[lane].triangle = local.triangle;
+            mask |= 1u << lane;
+        }
+    }
+    return mask;
+}
+
+/// Distance field: sphere tracing in field space, one lane at a time
+uint32_t intersectDistanceField(const SignedDistanceField& field, const ShapeFrame& frame,
+                                const RayPacket& packet, LaneHits& hits) noexcept {
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        if ((packet.activeMask & (1u << lane)) == 0) {
+            continue;
+        }
+        DistanceFieldRayHit local;
+        if (field.raycast(frame.toLocal(packet.getOrigin(lane)),
+                          frame.unrotate(packet.getDirection(lane)), packet.length[lane],
+                          local)) {
+            hits[lane].distance = local.distance;
+            hits[lane].point = frame.toWorld(local.point);
+            hits[lane].normal = frame.rotate(local.normal);
+            mask |= 1u << lane;
+        }
+    }
+    return mask;
+}
+
+/// Any other shape: cast a point at it, one lane at a time
+uint32_t intersectConvex(const SceneObject& object, const RayPacket& packet,
+                         LaneHits& hits) noexcept {
+    const ConvexShape point = ConvexShape::sphere(0.0f);
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        if ((packet.activeMask & (1u << lane)) == 0) {
+            continue;
+        }
+        math::Transform start;
+        start.position = packet.getOrigin(lane);
+        const Vec3 direction = packet.getDirection(lane);
+        const ConvexCast cast = castConvex(point, start, direction, packet.length[lane],
+                                           *object.shape, object.transform, RayCastTolerance);
+        if (cast.hit) {
+            hits[lane].distance = cast.distance;
+            hits[lane].point = start.position + direction * cast.distance;
+            hits[lane].normal = cast.normal;
+            mask |= 1u << lane;
+        }
+    }
+    return mask;
+}
+
+uint32_t intersectObject(const SceneObject& object, const RayPacket& packet, LaneHits& hits,
+                         bool anyHit) noexcept;
+
+/// Compound: the children the packet reaches through the compound's BVH,
+/// shortening the lanes to the nearest hit so far
+uint32_t intersectCompound(const SceneObject& object, const ShapeFrame& frame,
+                           const RayPacket& packet, LaneHits& hits, bool anyHit) noexcept {
+    const CompoundShape& compound = *object.shape->compound;
+    RayPacket remaining = packet;
+    RayPacket local = packet.toLocal(frame);
+    uint32_t mask = 0;
+    compound.query(
+        [&](const AABB& bounds) {
+            float entry = 0.0f;
+            return local.intersect(bounds, entry) != 0;
+        },
+        [&](uint32_t child) {
+            const SceneObject part{&compound.getChild(child).shape,
+                                   compound.placeChild(child, object.transform)};
+            LaneHits childHits;
+            const uint32_t childMask = intersectObject(part, remaining, childHits, anyHit);
+            for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+                if ((childMask & (1u << lane)) != 0) {
+                    hits[lane] = childHits[lane];
+                    remaining.length[lane] = childHits[lane].distance;
+                    local.length[lane] = childHits[lane].distance;
+                }
+            }
+            mask |= childMask;
+            if (anyHit) {
+                remaining.activeMask &= ~childMask;
+                local.activeMask = remaining.activeMask;
+            }
+            return remaining.activeMask != 0;
+        });
+    return mask;
+}
+
+/// Intersect the active lanes of a packet with an object
+/// @return Lanes that hit the object within their current length
+uint32_t intersectObject(const SceneObject& object, const RayPacket& packet, LaneHits& hits,
+                         bool anyHit) noexcept {
+    const ConvexShape& shape = *object.shape;
+    const ShapeFrame frame(object.transform);
+    for (LaneHit& hit : hits) {
+        hit.triangle = UINT32_MAX;
+    }
+    switch (shape.type) {
+        case ShapeType::Sphere:
+            return intersectSphere(shape, frame, packet, hits);
+        case ShapeType::Box:
+            return shape.radius == 0.0f ? intersectBox(shape, frame, packet, hits)
+                                        : intersectConvex(object, packet, hits);
+        case ShapeType::Plane:
+            return intersectPlane(frame, packet, hits);
+        case ShapeType::Mesh:
+            return intersectMesh(*shape.mesh, frame, packet, hits, anyHit);
+        case ShapeType::HeightField:
+            return intersectHeightField(*shape.terrain, frame, packet, hits);
+        case ShapeType::DistanceField:
+            return intersectDistanceField(*shape.sdf, frame, packet, hits);
+        case ShapeType::Compound:
+            return intersectCompound(object, frame, packet, hits, anyHit);
+        case ShapeType::Capsule:
+        case ShapeType::Convex:
+        default:
+            return intersectConvex(object, packet, hits);
+    }
+}
+
+//=============================================================================
+// Shape casts
+//=============================================================================
+
+/// Entry distance of a ray into a box, or infinity if it misses within length
+float intersectSlabs(const Vec3& origin, const Vec3& inverse, float length,
+                     const AABB& box) noexcept {
+    float entry = 0.0f;
+    float leave = length;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        const float t0 = (box.min[axis] - origin[axis]) * inverse[axis];
+        const float t1 = (box.max[axis] - origin[axis]) * inverse[axis];
+        entry = std::max(entry, std::min(t0, t1));
+        leave = std::min(leave, std::max(t0, t1));
+    }
+    return entry <= leave ? entry : Infinity;
+}
+
+/// Sweep a shape against a plane: its lowest point travels until it reaches the plane
+bool castAgainstPlane(const ShapeCast& cast, float maxDistance, const ShapeFrame& plane,
+                      SceneHit& hit) noexcept {
+    const Vec3 normal = plane.axes[1];
+    const ShapeFrame frame(cast.transform);
+    const Vec3 lowest = frame.toWorld(cast.shape->supportCore(frame.unrotate(-normal))) -
+                        normal * cast.shape->radius;
+    const float height = normal.dot(lowest - plane.position);
+    float t = 0.0f;
+    if (height > 0.0f) {
+        const float approach = -normal.dot(cast.direction);
+        if (approach <= 1.0e-12f) {
+            return false;
+        }
+        t = height / approach;
+    }
+    if (t > maxDistance) {
+        return false;
+    }
+    hit.distance = t;
+    hit.point = lowest + cast.direction * t;
+    hit.normal = normal;
+    return true;
+}
+
+/// Bounds of a cast's sweep in the local space of a frame
+AABB getLocalSweptBounds(const ShapeCast& cast, float maxDistance,
+                         const ShapeFrame& frame) noexcept {
+    AABB swept = cast.shape->computeAABB(cast.transform);
+    swept.merge(AABB(swept.min + cast.direction * maxDistance,
+                     swept.max + cast.direction * maxDistance));
+    AABB local;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        local.expand(frame.toLocal(Vec3((corner & 1) != 0 ? swept.max.x : swept.min.x,
+                                        (corner & 2) != 0 ? swept.max.y : swept.min.y,
+                                        (corner & 4) != 0 ? swept.max.z : swept.min.z)));
+    }
+    return local;
+}
+
+/// Sweep a shape against the triangles of a mesh or height field under its swept bounds
+/// @param query Calls queryAABB(localBounds, callback) on the mesh or height field
+template <typename Query>
+bool castAgainstTriangles(const ShapeCast& cast, float maxDistance, const ShapeFrame& frame,
+                          bool anyHit, SceneHit& hit, Query&& query) noexcept {
+    bool found = false;
+    const math::Transform identity;
+    query(getLocalSweptBounds(cast, maxDistance, frame),
+          [&](uint32_t triangle, const std::array<Vec3, 3>& vertices) {
+        const std::array<Vec3, 3> world = {frame.toWorld(vertices[0]), frame.toWorld(vertices[1]),
+                                           frame.toWorld(vertices[2])};
+        const ConvexCast result =
+            castConvex(*cast.shape, cast.transform, cast.direction, maxDistance,
+                       ConvexShape::convex(world), identity);
+        if (result.hit && result.distance <= maxDistance) {
+            maxDistance = result.distance;
+            hit.distance = result.distance;
+            hit.point = result.point;
+            hit.normal = result.normal;
+            hit.triangle = triangle;
+            found = true;
+        }
+        return !(found && anyHit);
+    });
+    return found;
+}
+
+/// Sweep a shape against a distance field: conservative advancement of the
+/// shape's core points (those the contact kernel samples) through the field
+bool castAgainstDistanceField(const ShapeCast& cast, float maxDistance,
+                              const SignedDistanceField& field, const ShapeFrame& frame,
+                              SceneHit& hit) noexcept {
+    constexpr uint32_t MaxSteps = 256;
+
+    const ShapeFrame start(cast.transform);
+    const Vec3 direction = frame.unrotate(cast.direction);
+    const float tolerance = 1.0e-3f * field.getCellSize();
+    const float minStep = 0.1f * field.getCellSize();
+    const float radius = cast.shape->radius;
+    float t = 0.0f;
+    for (uint32_t step = 0; step < MaxSteps && t <= maxDistance; ++step) {
+        // Core point nearest the surface at this distance
+        float closest = Infinity;
+        Vec3 closestPoint;
+        Vec3 gradient;
+        cast.shape->forEachCorePoint([&](uint32_t, const Vec3& core) {
+            const Vec3 point = frame.toLocal(start.toWorld(core)) + direction * t;
+            Vec3 pointGradient;
+            const float distance = field.sampleGradient(point, pointGradient) - radius;
+            if (distance < closest) {
+                closest = distance;
+                closestPoint = point;
+                gradient = pointGradient;
+            }
+        });
+        if (closest <= tolerance) {
+            const float length = gradient.length();
+            const Vec3 normal = length > 0.0f ? gradient / length : -direction;
+            hit.distance = t;
+            hit.point = frame.toWorld(closestPoint - normal * (closest + radius));
+            hit.normal = frame.rotate(normal);
+            hit.triangle = UINT32_MAX;
+            return true;
+        }
+        t += std::max(closest, minStep);
+    }
+    return false;
+}
+
+bool castAgainstObject(const ShapeCast& cast, float maxDistance, const SceneObject& object,
+                       bool anyHit, SceneHit& hit) noexcept;
+
+/// Sweep a shape against the children of a compound under its swept bounds
+bool castAgainstCompound(const ShapeCast& cast, float maxDistance, const SceneObject& object,
+                         const ShapeFrame& frame, bool anyHit, SceneHit& hit) noexcept {
+    const CompoundShape& compound = *object.shape->compound;
+    bool found = false;
+    compound.queryAABB(getLocalSweptBounds(cast, maxDistance, frame), [&](uint32_t child) {
+        const SceneObject part{&compound.getChild(child).shape,
+                               compound.placeChild(child, object.transform)};
+        SceneHit childHit;
+        if (castAgainstObject(cast, maxDistance, part, anyHit, childHit) &&
+            childHit.distance <= maxDistance) {
+            maxDistance = childHit.distance;
+            hit = childHit;
+            found = true;
+        }
+        return !(found && anyHit);
+    });
+    return found;
+}
+
+/// Sweep a shape against one object
+bool castAgainstObject(const ShapeCast& cast, float maxDistance, const SceneObject& object,
+                       bool anyHit, SceneHit& hit) noexcept {
+    const ShapeFrame frame(object.transform);
+    switch (object.shape->type) {
+        case ShapeType::Plane:
+            return castAgainstPlane(cast, maxDistance, frame, hit);
+        case ShapeType::Mesh:
+            return castAgainstTriangles(cast, maxDistance, frame, anyHit, hit,
+                                        [&](const AABB& local, const auto& callback) {
+                                            object.shape->mesh->queryAABB(local, callback);
+                                        });
+        case ShapeType::HeightField:
+            return castAgainstTriangles(cast, maxDistance, frame, anyHit, hit,
+                                        [&](const AABB& local, const auto& callback) {
+                                            object.shape->terrain->queryAABB(local, callback);
+                                        });
+        case ShapeType::DistanceField:
+            return castAgainstDistanceField(cast, maxDistance, *object.shape->sdf, frame, hit);
+        case ShapeType::Compound:
+            return castAgainstCompound(cast, maxDistance, object, frame, anyHit, hit);
+        default: {
+            const ConvexCast result = castConvex(*cast.shape, cast.transform, cast.direction,
+                                                 maxDistance, *object.shape, object.transform);
+            if (!result.hit) {
+                return false;
+            }
+            hit.distance = result.distance;
+            hit.point = result.point;
+            hit.normal = result.normal;
+            hit.triangle = UINT32_MAX;
+            return true;
+        }
+    }
+}
+
+uint32_t countHits(std::span<const SceneHit> hits) noexcept {
+    return static_cast<uint32_t>(
+        std::count_if(hits.begin(), hits.end(), [](const SceneHit& hit) { return hit.hasHit(); }));
+}
+
+}  // namespace
+
+//=============================================================================
+// SceneQuery
+//=============================================================================
+
+uint32_t SceneQuery::raycast(std::span<const Ray> rays, std::span<SceneHit> hits,
+                             const SceneQueryOptions& options) const {
+    AXIOM_PROFILE_SCOPE("SceneQuery::raycast");
+    AXIOM_PROFILE_ELEMENTS(rays.size());
+    AXIOM_ASSERT(hits.size() >= rays.size(), "One hit is needed per ray");
+
+    // Group rays that will walk the same nodes: same octant, nearby origins
+    const auto count = static_cast<uint32_t>(rays.size());
+    std::vector<uint32_t> order(count);
+    if (count > PacketWidth) {
+        AABB bounds;
+        for (const Ray& ray : rays) {
+            bounds.expand(ray.origin);
+        }
+        const Vec3 size = bounds.size();
+        const Vec3 scale(1023.0f / std::max(size.x, 1.0e-6f), 1023.0f / std::max(size.y, 1.0e-6f),
+                         1023.0f / std::max(size.z, 1.0e-6f));
+        std::vector<uint64_t> keys(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            keys[i] = static_cast<uint64_t>(computeSortKey(rays[i], bounds, scale)) << 32 | i;
+        }
+        std::sort(keys.begin(), keys.end());
+        for (uint32_t i = 0; i < count; ++i) {
+            order[i] = static_cast<uint32_t>(keys[i]);
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+    }
+
+    const uint32_t packetCount = (count + PacketWidth - 1) / PacketWidth;
+    const auto tracePackets = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t packet = begin; packet < end; ++packet) {
+            const uint32_t first = packet * PacketWidth;
+            const uint32_t size = std::min(PacketWidth, count - first);
+            tracePacket(rays, std::span<const uint32_t>(order).subspan(first, size), hits,
+                        options);
+        }
+    };
+    if (options.jobSystem != nullptr && packetCount > 1) {
+        options.jobSystem->parallelFor(packetCount, 0, tracePackets);
+    } else {
+        tracePackets(0, packetCount);
+    }
+    return countHits(hits.first(count));
+}
+
+uint32_t SceneQuery::shapeCast(std::span<const ShapeCast> casts, std::span<SceneHit> hits,
+                               const SceneQueryOptions& options) const {
+    AXIOM_PROFILE_SCOPE("SceneQuery::shapeCast");
+    AXIOM_PROFILE_ELEMENTS(casts.size());
+    AXIOM_ASSERT(hits.size() >= casts.size(), "One hit is needed per cast");
+
+    const auto count = static_cast<uint32_t>(casts.size());
+    const auto traceCasts = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            hits[i] = traceCast(casts[i], options);
+        }
+    };
+    if (options.jobSystem != nullptr && count > 1) {
+        options.jobSystem->parallelFor(count, 0, traceCasts);
+    } else {
+        traceCasts(0, count);
+    }
+    return countHits(hits.first(count));
+}
+
+void SceneQuery::tracePacket(std::span<const Ray> rays, std::span<const uint32_t> order,
+                             std::span<SceneHit> hits, const SceneQueryOptions& options) const {
+    RayPacket packet;
+    for (uint32_t lane = 0; lane < order.size(); ++lane) {
+        const Ray& ray = rays[order[lane]];
+        packet.setRay(lane, ray.origin, ray.direction, ray.maxDistance);
+        hits[order[lane]] = SceneHit{};
+    }
+
+    AABB bounds;
+    for (uint32_t lane = 0; lane < order.size(); ++lane) {
+        const Ray& ray = rays[order[lane]];
+        bounds.expand(ray.origin);
+        bounds.expand(ray.origin + ray.direction * ray.maxDistance);
+    }
+
+    const bool anyHit = options.mode == SceneQueryMode::AnyHit;
+    LaneHits laneHits;
+    broadphase_.queryOrdered(
+        bounds, packet.getMaxLength(), options.layerMask,
+        [&](const AABB& box) {
+            float entry = 0.0f;
+            return packet.intersect(box, entry) != 0 ? entry : Infinity;
+        },
+        [&](ProxyId id) {
+            if (const SceneObject* object = getObject(id, options)) {
+                const uint32_t mask = intersectObject(*object, packet, laneHits, anyHit);
+                for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+                    if ((mask & (1u << lane)) == 0) {
+                        continue;
+                    }
+                    const LaneHit& laneHit = laneHits[lane];
+                    SceneHit& hit = hits[order[lane]];
+                    hit.proxy = id;
+                    hit.distance = laneHit.distance;
+                    hit.point = laneHit.point;
+                    hit.normal = laneHit.normal;
+                    hit.triangle = laneHit.triangle;
+                    packet.length[lane] = laneHit.distance;
+                }
+                if (anyHit) {
+                    packet.activeMask &= ~mask;
+                }
+            }
+            return packet.activeMask == 0 ? -1.0f : packet.getMaxLength();
+        });
+}
+
+SceneHit SceneQuery::traceCast(const ShapeCast& cast, const SceneQueryOptions& options) const {
+    AXIOM_ASSERT(cast.shape != nullptr, "Shape cast without a shape");
+    AXIOM_ASSERT(cast.shape->type != ShapeType::Plane && cast.shape->type != ShapeType::Mesh &&
+                     cast.shape->type != ShapeType::HeightField &&
+                     cast.shape->type != ShapeType::DistanceField &&
+                     cast.shape->type != ShapeType::Compound,
+                 "Only bounded convex shapes can be cast");
+
+    // The swept shape is a ray from the center of its bounds against boxes
+    // grown by their extents
+    const AABB start = cast.shape->computeAABB(cast.transform);
+    const Vec3 center = start.center();
+    const Vec3 extents = start.extents();
+    const Vec3 inverse(detail::safeInverse(cast.direction.x),
+                       detail::safeInverse(cast.direction.y),
+                       detail::safeInverse(cast.direction.z));
+
+    AABB swept = start;
+    swept.merge(AABB(start.min + cast.direction * cast.maxDistance,
+                     start.max + cast.direction * cast.maxDistance));
+
+    const bool anyHit = options.mode == SceneQueryMode::AnyHit;
+    SceneHit best;
+    float limit = cast.maxDistance;
+    broadphase_.queryOrdered(
+        swept, limit, options.layerMask,
+        [&](const AABB& bounds) {
+            return intersectSlabs(center, inverse, cast.maxDistance,
+                                  AABB(bounds.min - extents, bounds.max + extents));
+        },
+        [&](ProxyId id) {
+            const SceneObject* object = getObject(id, options);
+            SceneHit hit;
+            if (object != nullptr && castAgainstObject(cast, limit, *object, anyHit, hit)) {
+                hit.proxy = id;
+                best = hit;
+                limit = hit.distance;
+                if (anyHit) {
+                    return -1.0f;
+                }
+            }
+            return limit;
+        });
+    return best;
+}
+
+const SceneObject* SceneQuery::getObject(ProxyId id, const SceneQueryOptions& options) const
+    noexcept {
+    if ((broadphase_.getFilter(id).categoryBits & options.categoryMask) == 0) {
+        return nullptr;
+    }
+    const uint64_t index = broadphase_.getUserData(id);
+    AXIOM_ASSERT(index < objects_.size(), "Proxy user data is not a scene object index");
+    const SceneObject& object = objects_[index];
+    return object.shape != nullptr ? &object : nullptr;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,210 @@
+#include "axiom/collision/shape.hpp"
+
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/convex_hull.hpp"
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace axiom::collision {
+
+namespace {
+
+/// Local bounds of a mesh, height field or distance field
+const math::AABB& getStaticBounds(const ConvexShape& shape) noexcept {
+    switch (shape.type) {
+        case ShapeType::HeightField:
+            return shape.terrain->getBounds();
+        case ShapeType::DistanceField:
+            return shape.sdf->getBounds();
+        case ShapeType::Mesh:
+        default:
+            return shape.mesh->getBounds();
+    }
+}
+
+}  // namespace
+
+ConvexShape ConvexShape::sphere(float radius) noexcept {
+    AXIOM_ASSERT(radius >= 0.0f, "Sphere radius must not be negative");
+    ConvexShape shape;
+    shape.type = ShapeType::Sphere;
+    shape.radius = radius;
+    return shape;
+}
+
+ConvexShape ConvexShape::box(const math::Vec3& halfExtents, float radius) noexcept {
+    AXIOM_ASSERT(halfExtents.x >= 0.0f && halfExtents.y >= 0.0f && halfExtents.z >= 0.0f,
+                 "Box half extents must not be negative");
+    ConvexShape shape;
+    shape.type = ShapeType::Box;
+    shape.radius = radius;
+    shape.halfExtents = halfExtents;
+    return shape;
+}
+
+ConvexShape ConvexShape::capsule(float radius, float height) noexcept {
+    AXIOM_ASSERT(radius >= 0.0f && height >= 0.0f, "Capsule dimensions must not be negative");
+    ConvexShape shape;
+    shape.type = ShapeType::Capsule;
+    shape.radius = radius;
+    shape.halfHeight = 0.5f * height;
+    return shape;
+}
+
+ConvexShape ConvexShape::plane() noexcept {
+    ConvexShape shape;
+    shape.type = ShapeType::Plane;
+    return shape;
+}
+
+ConvexShape ConvexShape::convex(std::span<const math::Vec3> points, float radius) noexcept {
+    AXIOM_ASSERT(!points.empty(), "Convex hull needs at least one point");
+    ConvexShape shape;
+    shape.type = ShapeType::Convex;
+    shape.radius = radius;
+    shape.vertices = points.data();
+    shape.vertexCount = static_cast<uint32_t>(points.size());
+    return shape;
+}
+
+ConvexShape ConvexShape::convexHull(const ConvexHull& hull, float radius) noexcept {
+    ConvexShape shape = convex(hull.getVertices(), radius);
+    shape.hull = &hull;
+    return shape;
+}
+
+ConvexShape ConvexShape::triangleMesh(const TriangleMesh& mesh) noexcept {
+    ConvexShape shape;
+    shape.type = ShapeType::Mesh;
+    shape.mesh = &mesh;
+    return shape;
+}
+
+ConvexShape ConvexShape::heightField(const HeightField& terrain) noexcept {
+    ConvexShape shape;
+    shape.type = ShapeType::HeightField;
+    shape.terrain = &terrain;
+    return shape;
+}
+
+ConvexShape ConvexShape::signedDistanceField(const SignedDistanceField& sdf) noexcept {
+    ConvexShape shape;
+    shape.type = ShapeType::DistanceField;
+    shape.sdf = &sdf;
+    return shape;
+}
+
+ConvexShape ConvexShape::compoundShape(const CompoundShape& compound) noexcept {
+    ConvexShape shape;
+    shape.type = ShapeType::Compound;
+    shape.compound = &compound;
+    return shape;
+}
+
+math::Vec3 ConvexShape::supportHull(const math::Vec3& direction) const noexcept {
+    AXIOM_ASSERT(vertices != nullptr && vertexCount > 0, "Convex shape has no vertices");
+
+    if (hull != nullptr && vertexCount > HillClimbThreshold) {
+        return hull->support(direction);
+    }
+
+    // Linear scan: faster than hill-climbing on small hulls, and the only
+    // option without adjacency
+    uint32_t best = 0;
+    float bestDot = vertices[0].dot(direction);
+    for (uint32_t i = 1; i < vertexCount; ++i) {
+        const float d = vertices[i].dot(direction);
+        if (d > bestDot) {
+            bestDot = d;
+            best = i;
+        }
+    }
+    return vertices[best];
+}
+
+math::AABB ConvexShape::computeAABB(const math::Transform& transform) const noexcept {
+    if (type == ShapeType::Plane) {
+        constexpr float Huge = std::numeric_limits<float>::max();
+        return math::AABB(math::Vec3(-Huge), math::Vec3(Huge));
+    }
+    if (type == ShapeType::Mesh || type == ShapeType::HeightField ||
+        type == ShapeType::DistanceField) {
+        // Rotated box of the local bounds
+        const ShapeFrame frame(transform);
+        const math::AABB& local = getStaticBounds(*this);
+        const math::Vec3 center = frame.toWorld(local.center());
+        const math::Vec3 extents = local.extents();
+        math::Vec3 worldExtents;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            worldExtents[axis] = std::abs(frame.axes[0][axis]) * extents.x +
+                                 std::abs(frame.axes[1][axis]) * extents.y +
+                                 std::abs(frame.axes[2][axis]) * extents.z;
+        }
+        return math::AABB(center - worldExtents, center + worldExtents);
+    }
+    if (type == ShapeType::Compound) {
+        // Union of the children's world bounds
+        math::AABB bounds;
+        for (uint32_t child = 0; child < compound->getChildCount(); ++child) {
+            bounds.merge(compound->getChild(child).shape.computeAABB(
+                compound->placeChild(child, transform)));
+        }
+        return bounds;
+    }
+
+    const math::Quat inverse = transform.rotation.conjugate();
+    math::AABB bounds;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        math::Vec3 direction = math::Vec3::zero();
+        direction[axis] = 1.0f;
+
+        // Extent of the core along a world axis, from the support points both ways
+        const math::Vec3 localDirection = inverse * direction;
+        const math::Vec3 high = transform.rotation * supportCore(localDirection);
+        const math::Vec3 low = transform.rotation * supportCore(-localDirection);
+        bounds.max[axis] = transform.position[axis] + high[axis] + radius;
+        bounds.min[axis] = transform.position[axis] + low[axis] - radius;
+    }
+    return bounds;
+}
+
+float ConvexShape::computeBoundingRadius() const noexcept {
+    switch (type) {
+        case ShapeType::Box:
+            return halfExtents.length() + radius;
+        case ShapeType::Capsule:
+            return halfHeight + radius;
+        case ShapeType::Convex: {
+            float farthestSquared = 0.0f;
+            for (uint32_t i = 0; i < vertexCount; ++i) {
+                farthestSquared = std::max(farthestSquared, vertices[i].lengthSquared());
+            }
+            return std::sqrt(farthestSquared) + radius;
+        }
+        case ShapeType::Mesh:
+        case ShapeType::HeightField:
+        case ShapeType::DistanceField: {
+            const math::AABB& bounds = getStaticBounds(*this);
+            const math::Vec3 farthest(std::max(-bounds.min.x, bounds.max.x),
+                                      std::max(-bounds.min.y, bounds.max.y),
+                                      std::max(-bounds.min.z, bounds.max.z));
+            return farthest.length();
+        }
+        case ShapeType::Compound:
+            return compound->getBoundingRadius();
+        case ShapeType::Plane:
+            return 0.0f;
+        case ShapeType::Sphere:
+        default:
+            return radius;
+    }
+}
+
+}  // namespace axiom::collision
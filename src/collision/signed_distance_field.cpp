@@ -0,0 +1,438 @@
+#include "axiom/collision/signed_distance_field.hpp"
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/collision/shape.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Vec3;
+
+constexpr float QuantizationSteps = 32767.0f;
+constexpr uint32_t BrickSize = SignedDistanceField::BrickSize;
+constexpr uint32_t BrickSampleCount = BrickSize * BrickSize * BrickSize;
+
+/// Brick slot marker used while building: the narrow band passes through the brick
+constexpr uint32_t PendingBrick = 0;
+
+/// Barycentric coordinates below this put the closest point on an edge or vertex
+constexpr float FeatureEpsilon = 1.0e-4f;
+
+/// Angle-weighted pseudonormals of a closed mesh: the sign of (p - q) . n for
+/// the pseudonormal n of the feature holding the closest point q is the sign
+/// of the distance, on faces, edges and vertices alike
+class PseudoNormals {
+public:
+    PseudoNormals(std::span<const Vec3> vertices, std::span<const uint32_t> indices)
+        : vertices_(vertices), indices_(indices) {
+        const size_t triangleCount = indices.size() / 3;
+        faceNormals_.reserve(triangleCount);
+        vertexNormals_.assign(vertices.size(), Vec3::zero());
+        edgeNormals_.reserve(triangleCount * 2);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const std::array<Vec3, 3> corners = getTriangle(static_cast<uint32_t>(t));
+            const Vec3 cross = (corners[1] - corners[0]).cross(corners[2] - corners[0]);
+            const float length = cross.length();
+            const Vec3 normal = length > 0.0f ? cross / length : Vec3::zero();
+            faceNormals_.push_back(normal);
+            for (uint32_t k = 0; k < 3; ++k) {
+                // Each vertex weighted by the angle of the face at it
+                const Vec3 toNext = corners[(k + 1) % 3] - corners[k];
+                const Vec3 toPrevious = corners[(k + 2) % 3] - corners[k];
+                const float cosine = toNext.dot(toPrevious) /
+                                     std::max(toNext.length() * toPrevious.length(), 1.0e-30f);
+                const float angle = std::acos(std::clamp(cosine, -1.0f, 1.0f));
+                vertexNormals_[indices[3 * t + k]] += normal * angle;
+                edgeNormals_[getEdgeKey(indices[3 * t + k], indices[3 * t + (k + 1) % 3])] +=
+                    normal;
+            }
+        }
+    }
+
+    /// Signed distance from a point to its closest point on the mesh
+    float getSignedDistance(const Vec3& point, const MeshClosestPoint& closest) const {
+        const uint32_t triangle = closest.triangle;
+        const std::array<Vec3, 3> corners = getTriangle(triangle);
+
+        // Barycentric coordinates of the closest point
+        const Vec3 edge1 = corners[1] - corners[0];
+        const Vec3 edge2 = corners[2] - corners[0];
+        const Vec3 offset = closest.point - corners[0];
+        const float d11 = edge1.dot(edge1);
+        const float d12 = edge1.dot(edge2);
+        const float d22 = edge2.dot(edge2);
+        const float denominator = d11 * d22 - d12 * d12;
+        Vec3 normal = faceNormals_[triangle];
+        if (denominator > 0.0f) {
+            const float v = (d22 * offset.dot(edge1) - d12 * offset.dot(edge2)) / denominator;
+            const float w = (d11 * offset.dot(edge2) - d12 * offset.dot(edge1)) / denominator;
+            const std::array<float, 3> weights = {1.0f - v - w, v, w};
+            uint32_t onEdges = 0;
+            uint32_t zero = 0;
+            uint32_t largest = 0;
+            for (uint32_t k = 0; k < 3; ++k) {
+                if (weights[k] < FeatureEpsilon) {
+                    ++onEdges;
+                    zero = k;
+                }
+                largest = weights[k] > weights[largest] ? k : largest;
+            }
+            const uint32_t first = 3 * triangle;
+            if (onEdges >= 2) {
+                normal = vertexNormals_[indices_[first + largest]];
+            } else if (onEdges == 1) {
+                // The edge opposite the zero weight
+                const auto found = edgeNormals_.find(getEdgeKey(
+                    indices_[first + (zero + 1) % 3], indices_[first + (zero + 2) % 3]));
+                normal = found != edgeNormals_.end() ? found->second : normal;
+            }
+        }
+        return normal.dot(point - closest.point) < 0.0f ? -closest.distance : closest.distance;
+    }
+
+private:
+    std::array<Vec3, 3> getTriangle(uint32_t triangle) const {
+        return {vertices_[indices_[3 * triangle]], vertices_[indices_[3 * triangle + 1]],
+                vertices_[indices_[3 * triangle + 2]]};
+    }
+
+    static uint64_t getEdgeKey(uint32_t a, uint32_t b) noexcept {
+        return (uint64_t{std::min(a, b)} << 32) | std::max(a, b);
+    }
+
+    std::span<const Vec3> vertices_;
+    std::span<const uint32_t> indices_;
+    std::vector<Vec3> faceNormals_;
+    std::vector<Vec3> vertexNormals_;
+    std::unordered_map<uint64_t, Vec3> edgeNormals_;
+};
+
+/// Run fn over [0, count), in parallel if a job system is given
+template <typename Fn>
+void forEachChunk(core::JobSystem* jobs, uint32_t count, Fn&& fn) {
+    if (jobs != nullptr) {
+        jobs->parallelFor(count, 0, fn);
+    } else {
+        fn(0u, count);
+    }
+}
+
+}  // namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+core::Result<SignedDistanceField> SignedDistanceField::create(
+    std::span<const math::Vec3> vertices, std::span<const uint32_t> indices,
+    const SignedDistanceFieldConfig& config) {
+    AXIOM_PROFILE_FUNCTION();
+
+    if (!(config.cellSize > 0.0f) || !std::isfinite(config.cellSize)) {
+        return core::Result<SignedDistanceField>::failure(core::ErrorCode::InvalidShape,
+                                                          "Cell size must be positive");
+    }
+    if (!(config.narrowBand >= config.cellSize) || !std::isfinite(config.narrowBand)) {
+        return core::Result<SignedDistanceField>::failure(
+            core::ErrorCode::InvalidShape, "Narrow band must be at least one cell wide");
+    }
+    TriangleMeshConfig meshConfig;
+    meshConfig.jobSystem = config.jobSystem;
+    auto meshResult = TriangleMesh::create(vertices, indices, meshConfig);
+    if (!meshResult.isSuccess()) {
+        return core::Result<SignedDistanceField>::failure(meshResult.errorCode(),
+                                                          meshResult.errorMessage());
+    }
+    const TriangleMesh& mesh = meshResult.value();
+
+    // Grid around the mesh with room for the band on every side
+    SignedDistanceField field;
+    field.bounds_ = mesh.getBounds();
+    field.cellSize_ = config.cellSize;
+    field.inverseCellSize_ = 1.0f / config.cellSize;
+    field.narrowBand_ = config.narrowBand;
+    const float padding = config.narrowBand + config.cellSize;
+    field.origin_ = field.bounds_.min - Vec3(padding);
+    const Vec3 size = field.bounds_.max - field.bounds_.min + Vec3(2.0f * padding);
+    uint64_t slotCount = 1;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const double cells = std::ceil(static_cast<double>(size[axis] * field.inverseCellSize_));
+        const double bricks = std::max(1.0, std::ceil(cells / BrickCells));
+        if (bricks > MaxBrickSlots) {
+            slotCount = uint64_t{MaxBrickSlots} + 1;
+            break;
+        }
+        field.brickCounts_[axis] = static_cast<uint32_t>(bricks);
+        slotCount *= field.brickCounts_[axis];
+    }
+    if (slotCount > MaxBrickSlots) {
+        return core::Result<SignedDistanceField>::failure(
+            core::ErrorCode::InvalidShape, "Grid needs too many bricks; use larger cells");
+    }
+
+    const PseudoNormals normals(vertices, indices);
+    const auto [countX, countY, countZ] = field.brickCounts_;
+    const float brickExtent = static_cast<float>(BrickCells) * config.cellSize;
+    const float halfDiagonal = 0.5f * brickExtent * std::sqrt(3.0f);
+    const auto getSamplePosition = [&](uint32_t slot, uint32_t x, uint32_t y, uint32_t z) {
+        const uint32_t brickX = slot % countX;
+        const uint32_t brickY = (slot / countX) % countY;
+        const uint32_t brickZ = slot / (countX * countY);
+        return field.origin_ + Vec3(static_cast<float>(brickX * BrickCells + x),
+                                    static_cast<float>(brickY * BrickCells + y),
+                                    static_cast<float>(brickZ * BrickCells + z)) *
+                                   config.cellSize;
+    };
+
+    // Keep the bricks the narrow band passes through; sign the others as a whole
+    const auto slots = static_cast<uint32_t>(slotCount);
+    field.brickSlots_.assign(slots, OutsideBrick);
+    forEachChunk(config.jobSystem, slots, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t slot = begin; slot < end; ++slot) {
+            const Vec3 center = getSamplePosition(slot, 0, 0, 0) + Vec3(0.5f * brickExtent);
+            MeshClosestPoint closest;
+            if (mesh.closestPoint(center, halfDiagonal + config.narrowBand, closest)) {
+                field.brickSlots_[slot] = PendingBrick;
+            } else if (mesh.closestPoint(center, std::numeric_limits<float>::max(), closest)) {
+                field.brickSlots_[slot] =
+                    normals.getSignedDistance(center, closest) < 0.0f ? InsideBrick : OutsideBrick;
+            }
+        }
+    });
+
+    // Number the kept bricks in slot order, so the layout does not depend on threads
+    std::vector<uint32_t> keptSlots;
+    for (uint32_t slot = 0; slot < slots; ++slot) {
+        if (field.brickSlots_[slot] == PendingBrick) {
+            field.brickSlots_[slot] = static_cast<uint32_t>(keptSlots.size());
+            keptSlots.push_back(slot);
+        }
+    }
+
+    // Every sample of a kept brick is within its diagonal plus the band of the
+    // surface. Samples are stored a cell diagonal beyond the band, so that
+    // the interpolation is exact up to the band rather than flattening before it.
+    field.samples_.assign(keptSlots.size() * BrickSampleCount, 0);
+    const float searchDistance = 2.0f * halfDiagonal + config.narrowBand;
+    const float range = config.narrowBand + config.cellSize * std::sqrt(3.0f);
+    field.sampleStep_ = range / QuantizationSteps;
+    const float scale = QuantizationSteps / range;
+    forEachChunk(config.jobSystem, static_cast<uint32_t>(keptSlots.size()),
+                 [&](uint32_t begin, uint32_t end) {
+        for (uint32_t brick = begin; brick < end; ++brick) {
+            int16_t* samples = field.samples_.data() + size_t{brick} * BrickSampleCount;
+            for (uint32_t i = 0; i < BrickSampleCount; ++i) {
+                const Vec3 point = getSamplePosition(keptSlots[brick], i % BrickSize,
+                                                     (i / BrickSize) % BrickSize,
+                                                     i / (BrickSize * BrickSize));
+                MeshClosestPoint closest;
+                if (!mesh.closestPoint(point, searchDistance, closest)) {
+                    mesh.closestPoint(point, std::numeric_limits<float>::max(), closest);
+                }
+                const float distance = normals.getSignedDistance(point, closest);
+                samples[i] = static_cast<int16_t>(
+                    std::clamp(std::round(distance * scale), -QuantizationSteps,
+                               QuantizationSteps));
+            }
+        }
+    });
+
+    return core::Result<SignedDistanceField>::success(std::move(field));
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+float SignedDistanceField::interpolate(const math::Vec3& point,
+                                       math::Vec3* gradient) const noexcept {
+    // Sample coordinates, clamped to the grid
+    const Vec3 coordinates = (point - origin_) * inverseCellSize_;
+    Vec3 clamped;
+    std::array<uint32_t, 3> cell{};
+    Vec3 fraction;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float cells = static_cast<float>(brickCounts_[axis] * BrickCells);
+        clamped[axis] = std::clamp(coordinates[axis], 0.0f, cells);
+        const float index = std::min(std::floor(clamped[axis]), cells - 1.0f);
+        cell[axis] = static_cast<uint32_t>(index);
+        fraction[axis] = clamped[axis] - index;
+    }
+    const Vec3 outside = (coordinates - clamped) * cellSize_;
+    const float outsideDistance = outside.length();
+
+    const std::array<uint32_t, 3> brick = {cell[0] / BrickCells, cell[1] / BrickCells,
+                                           cell[2] / BrickCells};
+    const uint32_t slot =
+        brick[0] + brickCounts_[0] * (brick[1] + brickCounts_[1] * brick[2]);
+    const uint32_t index = brickSlots_[slot];
+    float distance = 0.0f;
+    Vec3 slope = Vec3::zero();
+    if (index == OutsideBrick || index == InsideBrick) {
+        distance = index == OutsideBrick ? narrowBand_ : -narrowBand_;
+    } else {
+        const int16_t* samples =
+            samples_.data() + size_t{index} * BrickSampleCount +
+            (cell[0] - brick[0] * BrickCells) +
+            BrickSize * ((cell[1] - brick[1] * BrickCells) +
+                         BrickSize * (cell[2] - brick[2] * BrickCells));
+        const auto at = [&](uint32_t x, uint32_t y, uint32_t z) {
+            return static_cast<float>(samples[x + BrickSize * (y + BrickSize * z)]);
+        };
+        const auto lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+        const float x00 = lerp(at(0, 0, 0), at(1, 0, 0), fraction.x);
+        const float x10 = lerp(at(0, 1, 0), at(1, 1, 0), fraction.x);
+        const float x01 = lerp(at(0, 0, 1), at(1, 0, 1), fraction.x);
+        const float x11 = lerp(at(0, 1, 1), at(1, 1, 1), fraction.x);
+        const float y0 = lerp(x00, x10, fraction.y);
+        const float y1 = lerp(x01, x11, fraction.y);
+        distance = lerp(y0, y1, fraction.z) * sampleStep_;
+        if (std::abs(distance) >= narrowBand_) {
+            distance = std::copysign(narrowBand_, distance);
+        } else if (gradient != nullptr) {
+            const float dx =
+                lerp(lerp(at(1, 0, 0) - at(0, 0, 0), at(1, 1, 0) - at(0, 1, 0), fraction.y),
+                     lerp(at(1, 0, 1) - at(0, 0, 1), at(1, 1, 1) - at(0, 1, 1), fraction.y),
+                     fraction.z);
+            const float dy = lerp(x10 - x00, x11 - x01, fraction.z);
+            const float dz = y1 - y0;
+            slope = Vec3(dx, dy, dz) * (sampleStep_ * inverseCellSize_);
+        }
+    }
+
+    // Beyond the grid the distance grows at least as fast as the distance to it
+    if (outsideDistance > 0.0f) {
+        distance += outsideDistance;
+        slope = outside / outsideDistance;
+    }
+    if (gradient != nullptr) {
+        *gradient = slope;
+    }
+    return distance;
+}
+
+float SignedDistanceField::sample(const math::Vec3& point) const noexcept {
+    return brickSlots_.empty() ? std::numeric_limits<float>::max() : interpolate(point, nullptr);
+}
+
+float SignedDistanceField::sampleGradient(const math::Vec3& point,
+                                          math::Vec3& gradient) const noexcept {
+    if (brickSlots_.empty()) {
+        gradient = Vec3::zero();
+        return std::numeric_limits<float>::max();
+    }
+    return interpolate(point, &gradient);
+}
+
+bool SignedDistanceField::raycast(const math::Vec3& origin, const math::Vec3& direction,
+                                  float maxDistance, DistanceFieldRayHit& hit) const noexcept {
+    if (brickSlots_.empty()) {
+        return false;
+    }
+
+    // Only the mesh bounds, grown by a cell, can hold the surface
+    float enter = 0.0f;
+    float leave = maxDistance;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float inverse = detail::safeInverse(direction[axis]);
+        const float t0 = (bounds_.min[axis] - cellSize_ - origin[axis]) * inverse;
+        const float t1 = (bounds_.max[axis] + cellSize_ - origin[axis]) * inverse;
+        enter = std::max(enter, std::min(t0, t1));
+        leave = std::min(leave, std::max(t0, t1));
+    }
+    if (enter > leave) {
+        return false;
+    }
+
+    // Sphere tracing: the field never exceeds the distance to the surface, so
+    // stepping by it cannot pass the surface; a minimum step keeps grazing
+    // rays moving, and a sign change over such a step is interpolated
+    constexpr uint32_t MaxSteps = 512;
+    const float tolerance = 1.0e-3f * cellSize_;
+    const float minStep = 0.1f * cellSize_;
+    float t = enter;
+    float previousT = enter;
+    float previousDistance = 0.0f;
+    for (uint32_t step = 0; step < MaxSteps; ++step) {
+        const float distance = sample(origin + direction * t);
+        if (distance <= tolerance) {
+            if (distance < 0.0f && step > 0) {
+                t = previousT + (t - previousT) * previousDistance / (previousDistance - distance);
+            }
+            hit.distance = t;
+            hit.point = origin + direction * t;
+            Vec3 gradient;
+            sampleGradient(hit.point, gradient);
+            const float length = gradient.length();
+            hit.normal = length > 1.0e-6f ? gradient / length : -direction;
+            return true;
+        }
+        previousT = t;
+        previousDistance = distance;
+        t += std::max(distance, minStep);
+        if (t > leave) {
+            return false;
+        }
+    }
+    return false;
+}
+
+uint32_t SignedDistanceField::collideParticles(const math::Transform& transform,
+                                               std::span<const math::Vec3> positions,
+                                               float radius, float maxDistance,
+                                               std::span<DistanceFieldContact> contacts) const
+    noexcept {
+    AXIOM_ASSERT(contacts.size() >= positions.size(), "One contact per particle is required");
+    if (brickSlots_.empty()) {
+        return 0;
+    }
+
+    const ShapeFrame frame(transform);
+    AABB reach = bounds_;
+    reach.expand(radius + maxDistance);
+    uint32_t count = 0;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const Vec3 local = frame.toLocal(positions[i]);
+        if (!reach.contains(local)) {
+            continue;
+        }
+        Vec3 gradient;
+        const float distance = interpolate(local, &gradient);
+        const float length = gradient.length();
+        if (distance - radius > maxDistance || length < 1.0e-6f) {
+            continue;
+        }
+        const Vec3 normal = gradient / length;
+        contacts[count++] = {static_cast<uint32_t>(i), distance - radius, frame.rotate(normal),
+                             frame.toWorld(local - normal * distance)};
+    }
+    return count;
+}
+
+//=============================================================================
+// Properties
+//=============================================================================
+
+DistanceFieldStats SignedDistanceField::getStats() const noexcept {
+    DistanceFieldStats stats;
+    stats.brickCount = static_cast<uint32_t>(samples_.size() / BrickSampleCount);
+    stats.brickSlotCount = static_cast<uint32_t>(brickSlots_.size());
+    stats.memoryBytes = sizeof(SignedDistanceField) + samples_.size() * sizeof(int16_t) +
+                        brickSlots_.size() * sizeof(uint32_t);
+    return stats;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,513 @@
+#include "axiom/collision/sweep_and_prune.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+namespace axiom::collision {
+
+namespace {
+
+/// Below this many entries the radix sort runs on the calling thread
+constexpr size_t ParallelRadixThreshold = 16384;
+
+/// Upper bound on the chunks of the parallel radix sort
+constexpr uint32_t MaxRadixChunks = 64;
+
+/// Skip the insertion sort when more than 1/UnsortedFraction of the keys are out of order
+constexpr size_t UnsortedFraction = 4;
+
+/// A new axis must spread the proxies this much more than the current one
+constexpr double AxisSwitchRatio = 1.5;
+
+/// The band width is kept while within this factor of its target
+constexpr float BandWidthTolerance = 2.0f;
+
+/// Bands are clamped to +-MaxBand so keys cannot overflow
+constexpr int32_t MaxBand = 1 << 30;
+
+constexpr uint32_t RadixBits = 8;
+constexpr uint32_t RadixBuckets = 1u << RadixBits;
+constexpr uint32_t RadixPasses = 64 / RadixBits;
+
+/// Map a float to an unsigned integer with the same ordering
+uint32_t toSortableBits(float value) noexcept {
+    const auto bits = std::bit_cast<uint32_t>(value);
+    return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+}
+
+}  // namespace
+
+SweepAndPrune::SweepAndPrune(const SweepAndPruneConfig& config) : config_(config) {
+    proxies_.reserve(config_.initialCapacity);
+    entries_.reserve(config_.initialCapacity);
+    keys_.reserve(config_.initialCapacity);
+}
+
+//=============================================================================
+// Proxies
+//=============================================================================
+
+ProxyId SweepAndPrune::createProxy(const math::AABB& aabb, uint64_t userData) {
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    uint32_t index;
+    if (freeList_ != NullProxy) {
+        index = freeList_;
+        freeList_ = proxies_[index].nextFree;
+    } else {
+        index = static_cast<uint32_t>(proxies_.size());
+        AXIOM_ASSERT(index != NullProxy, "SweepAndPrune proxy pool exhausted");
+        proxies_.emplace_back();
+    }
+
+    // A recycled id keeps the bands of its old entries; the next update
+    // reconciles them with the new bounds
+    Proxy& proxy = proxies_[index];
+    proxy.aabb = aabb;
+    proxy.userData = userData;
+    proxy.nextFree = NullProxy;
+    proxy.alive = true;
+
+    ++proxyCount_;
+    return static_cast<ProxyId>(index);
+}
+
+void SweepAndPrune::destroyProxy(ProxyId id) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+
+    Proxy& proxy = proxies_[id];
+    proxy.alive = false;
+    proxy.nextFree = freeList_;
+    freeList_ = id;
+    --proxyCount_;
+}
+
+void SweepAndPrune::moveProxy(ProxyId id, const math::AABB& aabb) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+    proxies_[id].aabb = aabb;
+}
+
+void SweepAndPrune::moveProxies(std::span<const ProxyMove> moves) {
+    for (const ProxyMove& move : moves) {
+        moveProxy(move.id, move.aabb);
+    }
+}
+
+//=============================================================================
+// Keys
+//=============================================================================
+
+int32_t SweepAndPrune::bandOf(float value) const noexcept {
+    if (layout_.bandWidth <= 0.0f) {
+        return 0;
+    }
+    constexpr auto Limit = static_cast<float>(MaxBand);
+    return static_cast<int32_t>(std::clamp(std::floor(value / layout_.bandWidth), -Limit, Limit));
+}
+
+uint32_t SweepAndPrune::biasBand(int32_t band) noexcept {
+    return static_cast<uint32_t>(band + MaxBand);
+}
+
+uint64_t SweepAndPrune::makeKey(uint32_t biasedBand, float sweepMin) noexcept {
+    return (static_cast<uint64_t>(biasedBand) << 32) | toSortableBits(sweepMin);
+}
+
+//=============================================================================
+// Update
+//=============================================================================
+
+void SweepAndPrune::update() {
+    AXIOM_PROFILE_SCOPE("SweepAndPrune::update");
+    AXIOM_PROFILE_ELEMENTS(proxyCount_);
+
+    stats_ = {};
+    rebuildEntries();
+    refreshKeys();
+
+    // Mostly unsorted keys go straight to the radix sort; otherwise try the
+    // insertion sort and fall back once it exceeds its budget. Entries for
+    // bands proxies just entered are sorted separately and merged in.
+    const size_t keptCount = keys_.size();
+    const auto maxShifts =
+        static_cast<uint64_t>(static_cast<float>(keptCount) * config_.maxShiftsPerEntry);
+    if (added_.size() > keptCount / UnsortedFraction ||
+        stats_.outOfOrder > keptCount / UnsortedFraction || !insertionSort(maxShifts)) {
+        for (const auto& [key, id] : added_) {
+            keys_.push_back(key);
+            entries_.push_back(id);
+        }
+        radixSort();
+    } else {
+        mergeAdded();
+    }
+    added_.clear();
+    const size_t count = keys_.size();
+
+    gather();
+
+    stats_.sweepAxis = layout_.sweepAxis;
+    stats_.bandAxis = layout_.bandAxis;
+    stats_.bandWidth = layout_.bandWidth;
+    stats_.entryCount = static_cast<uint32_t>(count);
+
+    chooseLayout();
+}
+
+void SweepAndPrune::rebuildEntries() {
+    // A new layout invalidates every band: start over
+    if (!(nextLayout_ == layout_)) {
+        layout_ = nextLayout_;
+        keys_.clear();
+        entries_.clear();
+        for (Proxy& proxy : proxies_) {
+            proxy.bandLo = 0;
+            proxy.bandHi = -1;
+        }
+    }
+
+    // Drop entries of destroyed proxies and of bands a proxy left, keeping the
+    // order of the rest
+    const uint32_t bandAxis = layout_.bandAxis;
+    size_t kept = 0;
+    for (size_t k = 0; k < keys_.size(); ++k) {
+        const ProxyId id = entries_[k];
+        const Proxy& proxy = proxies_[id];
+        const uint32_t band = static_cast<uint32_t>(keys_[k] >> 32);
+        if (proxy.alive && band >= biasBand(bandOf(proxy.aabb.min[bandAxis])) &&
+            band <= biasBand(bandOf(proxy.aabb.max[bandAxis]))) {
+            keys_[kept] = keys_[k];
+            entries_[kept] = id;
+            ++kept;
+        }
+    }
+    keys_.resize(kept);
+    entries_.resize(kept);
+
+    // Collect entries for bands a proxy entered (all of them for new proxies)
+    for (size_t index = 0; index < proxies_.size(); ++index) {
+        Proxy& proxy = proxies_[index];
+        if (!proxy.alive) {
+            proxy.bandLo = 0;
+            proxy.bandHi = -1;
+            continue;
+        }
+
+        const int32_t lo = bandOf(proxy.aabb.min[bandAxis]);
+        const int32_t hi = bandOf(proxy.aabb.max[bandAxis]);
+        if (lo == proxy.bandLo && hi == proxy.bandHi) {
+            continue;
+        }
+        const uint32_t sweepKey = toSortableBits(proxy.aabb.min[layout_.sweepAxis]);
+        for (int32_t band = lo; band <= hi; ++band) {
+            if (band < proxy.bandLo || band > proxy.bandHi) {
+                const uint64_t key = (static_cast<uint64_t>(biasBand(band)) << 32) | sweepKey;
+                added_.emplace_back(key, static_cast<ProxyId>(index));
+            }
+        }
+        proxy.bandLo = lo;
+        proxy.bandHi = hi;
+    }
+}
+
+void SweepAndPrune::refreshKeys() {
+    const uint32_t sweepAxis = layout_.sweepAxis;
+    uint32_t outOfOrder = 0;
+    uint64_t previous = 0;
+    for (size_t k = 0; k < keys_.size(); ++k) {
+        const uint64_t band = keys_[k] & 0xFFFFFFFF00000000ull;
+        const uint64_t key = band | toSortableBits(proxies_[entries_[k]].aabb.min[sweepAxis]);
+        keys_[k] = key;
+        outOfOrder += key < previous ? 1u : 0u;
+        previous = key;
+    }
+    stats_.outOfOrder = outOfOrder;
+}
+
+bool SweepAndPrune::insertionSort(uint64_t maxShifts) noexcept {
+    const size_t count = keys_.size();
+    uint64_t shifts = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (shifts > maxShifts) {
+            // keys_ and entries_ are still a consistent permutation
+            stats_.insertionShifts = shifts;
+            return false;
+        }
+
+        const uint64_t key = keys_[i];
+        if (key >= keys_[i - 1]) {
+            continue;
+        }
+
+        const ProxyId id = entries_[i];
+        size_t j = i;
+        do {
+            keys_[j] = keys_[j - 1];
+            entries_[j] = entries_[j - 1];
+            --j;
+        } while (j > 0 && keys_[j - 1] > key);
+        keys_[j] = key;
+        entries_[j] = id;
+        shifts += i - j;
+    }
+    stats_.insertionShifts = shifts;
+    return true;
+}
+
+void SweepAndPrune::mergeAdded() {
+    if (added_.empty()) {
+        return;
+    }
+    std::sort(added_.begin(), added_.end());
+
+    // Merge from the back so only entries after the first insertion point move
+    size_t kept = keys_.size();
+    size_t added = added_.size();
+    size_t write = kept + added;
+    keys_.resize(write);
+    entries_.resize(write);
+    while (added > 0) {
+        --write;
+        if (kept > 0 && keys_[kept - 1] > added_[added - 1].first) {
+            --kept;
+            keys_[write] = keys_[kept];
+            entries_[write] = entries_[kept];
+        } else {
+            --added;
+            keys_[write] = added_[added].first;
+            entries_[write] = added_[added].second;
+        }
+    }
+}
+
+void SweepAndPrune::radixSort() {
+    AXIOM_PROFILE_SCOPE("SweepAndPrune::radixSort");
+    stats_.usedRadixSort = true;
+
+    const size_t count = keys_.size();
+    radixKeysTemp_.resize(count);
+    radixEntriesTemp_.resize(count);
+
+    // Least-significant-digit radix sort. Each chunk histograms and scatters
+    // its own range, so chunks run in parallel and the sort stays stable.
+    core::JobSystem* jobs = count >= ParallelRadixThreshold ? config_.jobSystem : nullptr;
+    const uint32_t chunkCount =
+        jobs != nullptr ? std::min(MaxRadixChunks, 4 * std::max(jobs->getWorkerCount(), 1u)) : 1;
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    std::vector<std::array<uint32_t, RadixBuckets>> histograms(chunkCount);
+
+    auto forEachChunk = [&](auto&& fn) {
+        if (jobs == nullptr) {
+            fn(0u);
+            return;
+        }
+        jobs->parallelFor(chunkCount, 1, [&fn](uint32_t begin, uint32_t end) {
+            for (uint32_t chunk = begin; chunk < end; ++chunk) {
+                fn(chunk);
+            }
+        });
+    };
+
+    for (uint32_t pass = 0; pass < RadixPasses; ++pass) {
+        const uint32_t shift = pass * RadixBits;
+
+        forEachChunk([&](uint32_t chunk) {
+            auto& histogram = histograms[chunk];
+            histogram.fill(0);
+            const size_t begin = chunk * chunkSize;
+            const size_t end = std::min(count, begin + chunkSize);
+            for (size_t k = begin; k < end; ++k) {
+                ++histogram[(keys_[k] >> shift) & (RadixBuckets - 1)];
+            }
+        });
+
+        // Exclusive prefix sum, bucket-major then chunk-major; skip passes where
+        // every key has the same digit (most band digits)
+        bool trivialPass = false;
+        uint32_t running = 0;
+        for (uint32_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+            uint32_t bucketTotal = 0;
+            for (auto& histogram : histograms) {
+                const uint32_t bucketCount = histogram[bucket];
+                histogram[bucket] = running;
+                running += bucketCount;
+                bucketTotal += bucketCount;
+            }
+            trivialPass = trivialPass || bucketTotal == count;
+        }
+        if (trivialPass) {
+            continue;
+        }
+
+        forEachChunk([&](uint32_t chunk) {
+            auto& offsets = histograms[chunk];
+            const size_t begin = chunk * chunkSize;
+            const size_t end = std::min(count, begin + chunkSize);
+            for (size_t k = begin; k < end; ++k) {
+                const uint64_t key = keys_[k];
+                const uint32_t slot = offsets[(key >> shift) & (RadixBuckets - 1)]++;
+                radixKeysTemp_[slot] = key;
+                radixEntriesTemp_[slot] = entries_[k];
+            }
+        });
+
+        keys_.swap(radixKeysTemp_);
+        entries_.swap(radixEntriesTemp_);
+    }
+}
+
+void SweepAndPrune::gather() {
+    const size_t count = keys_.size();
+    const uint32_t axes[3] = {layout_.sweepAxis, layout_.bandAxis, layout_.thirdAxis};
+    for (size_t a = 0; a < 3; ++a) {
+        sweep_.min[a].resize(count);
+        sweep_.max[a].resize(count);
+    }
+    sweep_.band.resize(count);
+    sweep_.bandLo.resize(count);
+    sweep_.ids.resize(count);
+    mask_.resize(count);
+
+    float maxExtent = 0.0f;
+    for (size_t k = 0; k < count; ++k) {
+        const ProxyId id = entries_[k];
+        const Proxy& proxy = proxies_[id];
+        sweep_.ids[k] = id;
+        sweep_.band[k] = static_cast<uint32_t>(keys_[k] >> 32);
+        sweep_.bandLo[k] = biasBand(proxy.bandLo);
+        for (size_t a = 0; a < 3; ++a) {
+            sweep_.min[a][k] = proxy.aabb.min[axes[a]];
+            sweep_.max[a][k] = proxy.aabb.max[axes[a]];
+        }
+        maxExtent = std::max(maxExtent, sweep_.max[0][k] - sweep_.min[0][k]);
+    }
+    maxSweepExtent_ = maxExtent;
+}
+
+void SweepAndPrune::chooseLayout() {
+    if (proxyCount_ < 2) {
+        return;
+    }
+
+    // Spread of the centers and mean size, per axis
+    double sum[3] = {0.0, 0.0, 0.0};
+    double sumSquares[3] = {0.0, 0.0, 0.0};
+    double sumExtents[3] = {0.0, 0.0, 0.0};
+    for (const Proxy& proxy : proxies_) {
+        if (!proxy.alive) {
+            continue;
+        }
+        for (size_t a = 0; a < 3; ++a) {
+            const auto center = static_cast<double>(proxy.aabb.min[a] + proxy.aabb.max[a]) * 0.5;
+            sum[a] += center;
+            sumSquares[a] += center * center;
+            sumExtents[a] += static_cast<double>(proxy.aabb.max[a] - proxy.aabb.min[a]);
+        }
+    }
+    const auto count = static_cast<double>(proxyCount_);
+    double variance[3];
+    for (size_t a = 0; a < 3; ++a) {
+        const double mean = sum[a] / count;
+        variance[a] = std::max(sumSquares[a] / count - mean * mean, 0.0);
+    }
+
+    // Sweep on the widest axis and cut bands along the next one; only switch
+    // for a clear improvement so the entries are not re-sorted back and forth
+    Layout layout = nextLayout_;
+    auto widest = [&variance](uint32_t a, uint32_t b) {
+        return variance[a] >= variance[b] ? a : b;
+    };
+    const uint32_t bestSweep = widest(widest(0, 1), 2);
+    if (bestSweep != layout.sweepAxis &&
+        variance[bestSweep] > AxisSwitchRatio * variance[layout.sweepAxis]) {
+        layout.sweepAxis = bestSweep;
+    }
+    const uint32_t other1 = (layout.sweepAxis + 1) % 3;
+    const uint32_t other2 = (layout.sweepAxis + 2) % 3;
+    const uint32_t bestBand = widest(other1, other2);
+    if (layout.bandAxis == layout.sweepAxis ||
+        (bestBand != layout.bandAxis &&
+         variance[bestBand] > AxisSwitchRatio * variance[layout.bandAxis])) {
+        layout.bandAxis = bestBand;
+    }
+    layout.thirdAxis = 3 - layout.sweepAxis - layout.bandAxis;
+
+    // Band width proportional to the mean proxy size; keep the current width
+    // while it is close enough
+    float target = 0.0f;
+    if (proxyCount_ >= config_.minBandedProxies) {
+        const auto meanExtent = static_cast<float>(sumExtents[layout.bandAxis] / count);
+        const auto spread = static_cast<float>(std::sqrt(variance[layout.bandAxis]));
+        target = std::max(config_.bandWidthScale * meanExtent,
+                          spread * 8.0f / static_cast<float>(MaxBand));
+    }
+    if (target <= 0.0f) {
+        layout.bandWidth = 0.0f;
+    } else if (layout.bandWidth * BandWidthTolerance < target ||
+               layout.bandWidth > target * BandWidthTolerance) {
+        layout.bandWidth = target;
+    }
+
+    nextLayout_ = layout;
+}
+
+size_t SweepAndPrune::runEnd(size_t i) const noexcept {
+    // The run ends at the first key above (band, upper bound of i). Runs are
+    // short compared to the band, so gallop forward before bisecting.
+    const uint64_t limit = makeKey(sweep_.band[i], sweep_.max[0][i]);
+    const size_t count = keys_.size();
+    size_t first = i + 1;
+    size_t last = i + 1;
+    for (size_t step = 1; last < count && keys_[last] <= limit; step *= 2) {
+        first = last + 1;
+        last += step;
+    }
+    last = std::min(last, count);
+    while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        if (keys_[mid] <= limit) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+size_t SweepAndPrune::testRun(size_t i, size_t end) noexcept {
+    const size_t runBegin = i + 1;
+    const size_t runLength = end - runBegin;
+    const float* min1 = sweep_.min[1].data() + runBegin;
+    const float* max1 = sweep_.max[1].data() + runBegin;
+    const float* min2 = sweep_.min[2].data() + runBegin;
+    const float* max2 = sweep_.max[2].data() + runBegin;
+    const uint32_t* bandLo = sweep_.bandLo.data() + runBegin;
+    const float lower1 = sweep_.min[1][i];
+    const float upper1 = sweep_.max[1][i];
+    const float lower2 = sweep_.min[2][i];
+    const float upper2 = sweep_.max[2][i];
+    const uint32_t band = sweep_.band[i];
+    const bool firstBandOfI = sweep_.bandLo[i] == band;
+    uint8_t* mask = mask_.data();
+
+    // A pair is reported in the first band both proxies share: the band where
+    // one of them starts. Branch-free so the loop vectorizes.
+    size_t hits = 0;
+    for (size_t k = 0; k < runLength; ++k) {
+        const bool pair = (min1[k] <= upper1) & (max1[k] >= lower1) & (min2[k] <= upper2) &
+                          (max2[k] >= lower2) & (firstBandOfI | (bandLo[k] == band));
+        mask[k] = static_cast<uint8_t>(pair);
+        hits += pair ? 1u : 0u;
+    }
+    return hits;
+}
+
+}  // namespace axiom::collision
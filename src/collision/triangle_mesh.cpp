@@ -0,0 +1,766 @@
+#include "axiom/collision/triangle_mesh.hpp"
+
+#include "axiom/collision/geometry_utils.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <limits>
+#include <utility>
+
+namespace axiom::collision {
+
+namespace {
+
+using math::AABB;
+using math::Vec3;
+
+constexpr uint32_t NullNode = UINT32_MAX;
+constexpr uint32_t DeferredNode = UINT32_MAX - 1;
+constexpr uint32_t MaxBins = 64;
+constexpr float QuantizationSteps = 65535.0f;
+
+/// Relative cost of visiting a node, with testing a triangle costing 1: a
+/// 4-wide node tests four boxes, about as much work as two triangles
+constexpr float TraversalCost = 2.0f;
+
+/// Subtrees of at most this many triangles are built as one parallel task
+constexpr uint32_t ParallelThreshold = 4096;
+
+/// Binary node of the intermediate SAH tree
+struct BuildNode {
+    AABB bounds;
+    uint32_t first = 0;         ///< Leaf: first triangle in the build order
+    uint32_t count = 0;         ///< Leaf: number of triangles
+    uint32_t left = NullNode;   ///< NullNode for a leaf, DeferredNode for a pending subtree
+    uint32_t right = NullNode;
+
+    bool isLeaf() const noexcept { return left == NullNode; }
+};
+
+/// Subtree left for a parallel task
+struct SubtreeTask {
+    uint32_t node;  ///< Placeholder node in the top tree
+    uint32_t begin;
+    uint32_t end;
+    std::vector<BuildNode> nodes;
+};
+
+/// Binned SAH builder over a permutation of the triangles
+class SahBuilder {
+public:
+    SahBuilder(std::span<const AABB> bounds, std::span<const Vec3> centroids,
+               std::span<uint32_t> order, const TriangleMeshConfig& config) noexcept
+        : bounds_(bounds), centroids_(centroids), order_(order), config_(config) {}
+
+    /// Build the subtree of order[begin, end) into nodes
+    /// @param tasks If set, ranges of at most deferThreshold triangles become
+    ///              DeferredNode placeholders recorded here instead of being built
+    uint32_t build(std::vector<BuildNode>& nodes, uint32_t begin, uint32_t end,
+                   std::vector<SubtreeTask>* tasks, uint32_t deferThreshold) {
+        const auto index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+
+        AABB bounds;
+        AABB centroidBounds;
+        for (uint32_t i = begin; i < end; ++i) {
+            bounds.merge(bounds_[order_[i]]);
+            centroidBounds.expand(centroids_[order_[i]]);
+        }
+        nodes[index].bounds = bounds;
+        nodes[index].first = begin;
+        nodes[index].count = end - begin;
+
+        const uint32_t count = end - begin;
+        if (tasks != nullptr && count <= deferThreshold) {
+            nodes[index].left = DeferredNode;
+            tasks->push_back({index, begin, end, {}});
+            return index;
+        }
+
+        uint32_t mid = findSplit(bounds, centroidBounds, begin, end);
+        if (mid == begin) {
+            return index;  // Leaf
+        }
+        if (mid == end) {
+            mid = begin + count / 2;  // Coincident centroids: split in the middle
+        }
+
+        const uint32_t left = build(nodes, begin, mid, tasks, deferThreshold);
+        const uint32_t right = build(nodes, mid, end, tasks, deferThreshold);
+        nodes[index].left = left;
+        nodes[index].right = right;
+        nodes[index].count = 0;
+        return index;
+    }
+
+private:
+    struct Bin {
+        AABB bounds;
+        uint32_t count = 0;
+    };
+
+    /// Partition order[begin, end) along the cheapest SAH split
+    /// @return The split point; begin to make a leaf, end if the centroids
+    ///         cannot be separated
+    uint32_t findSplit(const AABB& bounds, const AABB& centroidBounds, uint32_t begin,
+                       uint32_t end) {
+        const uint32_t count = end - begin;
+        const uint32_t binCount = std::clamp(config_.binCount, 2u, MaxBins);
+        const Vec3 extent = centroidBounds.size();
+
+        // Bin along all three axes in one pass over the triangles
+        std::array<float, 3> binScale{};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (extent[axis] > 0.0f) {
+                binScale[axis] = static_cast<float>(binCount) / extent[axis];
+            }
+            std::fill_n(bins_[axis].begin(), binCount, Bin{});
+        }
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t triangle = order_[i];
+            for (size_t axis = 0; axis < 3; ++axis) {
+                Bin& bin = bins_[axis][binOf(centroids_[triangle][axis], centroidBounds.min[axis],
+                                             binScale[axis], binCount)];
+                bin.bounds.merge(bounds_[triangle]);
+                ++bin.count;
+            }
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        size_t bestAxis = 0;
+        uint32_t bestBin = 0;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            if (extent[axis] <= 0.0f) {
+                continue;
+            }
+            const std::array<Bin, MaxBins>& bins = bins_[axis];
+
+            // Sweep from the right to get the cost of every right side
+            std::array<float, MaxBins> rightCost{};
+            AABB right;
+            uint32_t rightCount = 0;
+            for (uint32_t bin = binCount - 1; bin > 0; --bin) {
+                right.merge(bins[bin].bounds);
+                rightCount += bins[bin].count;
+                if (rightCount > 0) {
+                    rightCost[bin] = right.surfaceArea() * static_cast<float>(rightCount);
+                }
+            }
+            AABB left;
+            uint32_t leftCount = 0;
+            for (uint32_t bin = 0; bin + 1 < binCount; ++bin) {
+                left.merge(bins[bin].bounds);
+                leftCount += bins[bin].count;
+                if (leftCount == 0 || leftCount == count) {
+                    continue;
+                }
+                const float cost =
+                    left.surfaceArea() * static_cast<float>(leftCount) + rightCost[bin + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        const float leafCost = bounds.surfaceArea() * static_cast<float>(count);
+        const bool mustSplit = count > config_.maxLeafTriangles;
+        if (bestCost == std::numeric_limits<float>::max()) {
+            return mustSplit ? end : begin;
+        }
+        if (!mustSplit && bestCost + TraversalCost * bounds.surfaceArea() >= leafCost) {
+            return begin;
+        }
+
+        const float scale = binScale[bestAxis];
+        const float minimum = centroidBounds.min[bestAxis];
+        const auto first = order_.begin() + begin;
+        const auto split = std::partition(first, order_.begin() + end, [&](uint32_t triangle) {
+            return binOf(centroids_[triangle][bestAxis], minimum, scale, binCount) <= bestBin;
+        });
+        return begin + static_cast<uint32_t>(split - first);
+    }
+
+    static uint32_t binOf(float value, float minimum, float binScale, uint32_t binCount) noexcept {
+        const auto bin = static_cast<uint32_t>(std::max((value - minimum) * binScale, 0.0f));
+        return std::min(bin, binCount - 1);
+    }
+
+    std::span<const AABB> bounds_;
+    std::span<const Vec3> centroids_;
+    std::span<uint32_t> order_;
+    const TriangleMeshConfig& config_;
+    std::array<std::array<Bin, MaxBins>, 3> bins_;  ///< Scratch of findSplit()
+};
+
+/// Two-sided Moller-Trumbore against every lane of a packet at once, with the
+/// distance taken from the triangle plane like detail::intersectTriangle()
+/// @param distance Receives the distance along each lane's ray
+/// @return The lanes of mask whose rays hit the triangle within their length
+uint32_t intersectTriangle(const RayPacket& packet, uint32_t mask,
+                           const std::array<Vec3, 3>& vertices,
+                           std::array<float, RayPacket::Width>& distance) noexcept {
+    const Vec3 edge1 = vertices[1] - vertices[0];
+    const Vec3 edge2 = vertices[2] - vertices[0];
+    const Vec3 normal = edge1.cross(edge2);
+    uint32_t hits = 0;
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        const float dx = packet.directionX[lane];
+        const float dy = packet.directionY[lane];
+        const float dz = packet.directionZ[lane];
+        const float px = dy * edge2.z - dz * edge2.y;
+        const float py = dz * edge2.x - dx * edge2.z;
+        const float pz = dx * edge2.y - dy * edge2.x;
+        const float determinant = edge1.x * px + edge1.y * py + edge1.z * pz;
+        const float inverse = 1.0f / determinant;
+        const float sx = packet.originX[lane] - vertices[0].x;
+        const float sy = packet.originY[lane] - vertices[0].y;
+        const float sz = packet.originZ[lane] - vertices[0].z;
+        const float u = (sx * px + sy * py + sz * pz) * inverse;
+        const float qx = sy * edge1.z - sz * edge1.y;
+        const float qy = sz * edge1.x - sx * edge1.z;
+        const float qz = sx * edge1.y - sy * edge1.x;
+        const float v = (dx * qx + dy * qy + dz * qz) * inverse;
+        const float t = -(sx * normal.x + sy * normal.y + sz * normal.z) /
+                        (dx * normal.x + dy * normal.y + dz * normal.z);
+        const bool hit = (std::abs(determinant) >= 1.0e-12f) & (u >= 0.0f) & (v >= 0.0f) &
+                         (u + v <= 1.0f) & (t >= 0.0f) & (t <= packet.length[lane]);
+        distance[lane] = t;
+        hits |= static_cast<uint32_t>(hit) << lane;
+    }
+    return hits & mask;
+}
+
+/// Traversal stack entry ordered by a distance
+struct OrderedEntry {
+    uint32_t node;
+    float distance;
+};
+
+/// Sort up to four entries by decreasing distance, so the nearest is pushed last
+void sortFarToNear(std::array<OrderedEntry, 4>& entries, uint32_t count) noexcept {
+    for (uint32_t i = 1; i < count; ++i) {
+        const OrderedEntry entry = entries[i];
+        uint32_t j = i;
+        while (j > 0 && entries[j - 1].distance < entry.distance) {
+            entries[j] = entries[j - 1];
+            --j;
+        }
+        entries[j] = entry;
+    }
+}
+
+}  // namespace
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+core::Result<TriangleMesh> TriangleMesh::create(std::span<const math::Vec3> vertices,
+                                                std::span<const uint32_t> indices,
+                                                const TriangleMeshConfig& config) {
+    AXIOM_PROFILE_FUNCTION();
+
+    if (indices.empty() || indices.size() % 3 != 0) {
+        return core::Result<TriangleMesh>::failure(core::ErrorCode::InvalidShape,
+                                                   "Index count must be a positive multiple of 3");
+    }
+    if (indices.size() / 3 > MaxTriangles) {
+        return core::Result<TriangleMesh>::failure(core::ErrorCode::InvalidShape,
+                                                   "Too many triangles");
+    }
+    for (const uint32_t index : indices) {
+        if (index >= vertices.size()) {
+            return core::Result<TriangleMesh>::failure(core::ErrorCode::InvalidShape,
+                                                       "Vertex index out of range");
+        }
+    }
+    AXIOM_ASSERT(config.maxLeafTriangles >= 1 && config.maxLeafTriangles <= 8,
+                 "maxLeafTriangles must be in [1, 8]");
+
+    const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    std::vector<AABB> triangleBounds(triangleCount);
+    std::vector<Vec3> centroids(triangleCount);
+    std::vector<uint32_t> order(triangleCount);
+    TriangleMesh mesh;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        AABB bounds(vertices[indices[3 * t]]);
+        bounds.expand(vertices[indices[3 * t + 1]]);
+        bounds.expand(vertices[indices[3 * t + 2]]);
+        triangleBounds[t] = bounds;
+        centroids[t] = bounds.center();
+        order[t] = t;
+        mesh.bounds_.merge(bounds);
+    }
+
+    // Quantization grid over the mesh bounds; flat axes get a nominal extent
+    const Vec3 extent = mesh.bounds_.size();
+    mesh.origin_ = mesh.bounds_.min;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        mesh.scale_[axis] = std::max(extent[axis], 1.0e-6f) / QuantizationSteps;
+        mesh.inverseScale_[axis] = 1.0f / mesh.scale_[axis];
+    }
+
+    // Binary SAH tree: the top levels serially, then the subtrees in parallel
+    SahBuilder builder(triangleBounds, centroids, order, config);
+    std::vector<BuildNode> nodes;
+    nodes.reserve(2 * static_cast<size_t>(triangleCount) / config.maxLeafTriangles + 1);
+    core::JobSystem* jobs = config.jobSystem;
+    if (jobs == nullptr || triangleCount <= ParallelThreshold) {
+        builder.build(nodes, 0, triangleCount, nullptr, 0);
+    } else {
+        const uint32_t taskTarget = 4 * std::max(jobs->getWorkerCount(), 1u);
+        const uint32_t threshold = std::max(ParallelThreshold, triangleCount / taskTarget);
+        std::vector<SubtreeTask> tasks;
+        builder.build(nodes, 0, triangleCount, &tasks, threshold);
+        const auto taskCount = static_cast<uint32_t>(tasks.size());
+        jobs->parallelFor(taskCount, 1, [&](uint32_t begin, uint32_t end) {
+            SahBuilder taskBuilder(triangleBounds, centroids, order, config);
+            for (uint32_t i = begin; i < end; ++i) {
+                taskBuilder.build(tasks[i].nodes, tasks[i].begin, tasks[i].end, nullptr, 0);
+            }
+        });
+
+        // Splice the subtrees in, in task order so the layout is deterministic
+        for (SubtreeTask& task : tasks) {
+            const auto offset = static_cast<uint32_t>(nodes.size());
+            for (BuildNode node : task.nodes) {
+                if (!node.isLeaf()) {
+                    node.left += offset;
+                    node.right += offset;
+                }
+                nodes.push_back(node);
+            }
+            nodes[task.node] = nodes[offset];
+        }
+    }
+
+    // Height of every binary subtree; children always follow their parent
+    std::vector<uint32_t> heights(nodes.size(), 0);
+    for (size_t i = nodes.size(); i-- > 0;) {
+        if (!nodes[i].isLeaf()) {
+            heights[i] = std::max(heights[nodes[i].left], heights[nodes[i].right]) + 1;
+        }
+    }
+
+    // Collapse into 4-wide quantized nodes, depth first so siblings are adjacent
+    mesh.nodes_.reserve(nodes.size() / 3 + 1);
+    const auto quantizeBounds = [&mesh](const AABB& bounds, Node& node, uint32_t slot) {
+        std::array<uint16_t, 3> low;
+        std::array<uint16_t, 3> high;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const float lower = (bounds.min[axis] - mesh.origin_[axis]) * mesh.inverseScale_[axis];
+            const float upper = (bounds.max[axis] - mesh.origin_[axis]) * mesh.inverseScale_[axis];
+            // One extra step outward absorbs rounding in the dequantized bounds
+            low[axis] = static_cast<uint16_t>(
+                std::clamp(std::floor(lower) - 1.0f, 0.0f, QuantizationSteps));
+            high[axis] = static_cast<uint16_t>(
+                std::clamp(std::ceil(upper) + 1.0f, 0.0f, QuantizationSteps));
+        }
+        node.minX[slot] = low[0];
+        node.minY[slot] = low[1];
+        node.minZ[slot] = low[2];
+        node.maxX[slot] = high[0];
+        node.maxY[slot] = high[1];
+        node.maxZ[slot] = high[2];
+    };
+    const auto collapse = [&](auto& self, uint32_t binaryIndex) -> uint32_t {
+        const auto wideIndex = static_cast<uint32_t>(mesh.nodes_.size());
+        mesh.nodes_.emplace_back();
+
+        // Open the largest child of odd height until there are four. A wide node
+        // spans two binary levels, so keeping its children at even heights lets
+        // the nodes below fill all four slots down to the leaves.
+        std::array<uint32_t, 4> slots{};
+        uint32_t slotCount = 0;
+        if (nodes[binaryIndex].isLeaf()) {
+            slots[slotCount++] = binaryIndex;
+        } else {
+            slots[slotCount++] = nodes[binaryIndex].left;
+            slots[slotCount++] = nodes[binaryIndex].right;
+        }
+        while (slotCount < 4) {
+            uint32_t largest = slotCount;
+            float largestArea = -1.0f;
+            for (uint32_t i = 0; i < slotCount; ++i) {
+                const BuildNode& candidate = nodes[slots[i]];
+                if (heights[slots[i]] % 2 == 1 && candidate.bounds.surfaceArea() > largestArea) {
+                    largestArea = candidate.bounds.surfaceArea();
+                    largest = i;
+                }
+            }
+            if (largest == slotCount) {
+                break;
+            }
+            const BuildNode& opened = nodes[slots[largest]];
+            slots[largest] = opened.left;
+            slots[slotCount++] = opened.right;
+        }
+
+        Node node;
+        node.minX.fill(UINT16_MAX);
+        node.minY.fill(UINT16_MAX);
+        node.minZ.fill(UINT16_MAX);
+        node.maxX.fill(0);
+        node.maxY.fill(0);
+        node.maxZ.fill(0);
+        node.children.fill(EmptyChild);
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            const BuildNode& child = nodes[slots[i]];
+            quantizeBounds(child.bounds, node, i);
+            if (child.isLeaf()) {
+                node.children[i] = LeafFlag | ((child.count - 1) << LeafCountShift) | child.first;
+            } else {
+                node.children[i] = self(self, slots[i]);
+            }
+        }
+        mesh.nodes_[wideIndex] = node;
+        return wideIndex;
+    };
+    collapse(collapse, 0);
+
+    // Store the triangles in build order, renumbering the vertices by first use
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<std::array<uint32_t, 3>> triangles(triangleCount);
+    mesh.ids_.resize(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        const uint32_t input = order[i];
+        mesh.ids_[i] = input;
+        for (uint32_t k = 0; k < 3; ++k) {
+            uint32_t& mapped = remap[indices[3 * input + k]];
+            if (mapped == UINT32_MAX) {
+                mapped = static_cast<uint32_t>(mesh.vertices_.size());
+                mesh.vertices_.push_back(vertices[indices[3 * input + k]]);
+            }
+            triangles[i][k] = mapped;
+        }
+    }
+
+    const auto fitsDelta = [](uint32_t from, uint32_t to) {
+        const int64_t delta = static_cast<int64_t>(to) - static_cast<int64_t>(from);
+        return delta >= INT16_MIN && delta <= INT16_MAX;
+    };
+    mesh.compressed_ = std::all_of(triangles.begin(), triangles.end(), [&](const auto& t) {
+        return fitsDelta(t[0], t[1]) && fitsDelta(t[0], t[2]);
+    });
+    if (mesh.compressed_) {
+        mesh.packed_.resize(triangleCount);
+        for (uint32_t i = 0; i < triangleCount; ++i) {
+            const std::array<uint32_t, 3>& t = triangles[i];
+            mesh.packed_[i] = {t[0],
+                               static_cast<int16_t>(static_cast<int64_t>(t[1]) - t[0]),
+                               static_cast<int16_t>(static_cast<int64_t>(t[2]) - t[0])};
+        }
+    } else {
+        mesh.wide_ = std::move(triangles);
+    }
+
+    return core::Result<TriangleMesh>::success(std::move(mesh));
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+math::AABB TriangleMesh::getChildBounds(const Node& node, uint32_t slot) const noexcept {
+    const Vec3 low(static_cast<float>(node.minX[slot]), static_cast<float>(node.minY[slot]),
+                   static_cast<float>(node.minZ[slot]));
+    const Vec3 high(static_cast<float>(node.maxX[slot]), static_cast<float>(node.maxY[slot]),
+                    static_cast<float>(node.maxZ[slot]));
+    return math::AABB(origin_ + low * scale_, origin_ + high * scale_);
+}
+
+bool TriangleMesh::quantize(const math::AABB& aabb, QuantizedBox& box) const noexcept {
+    if (!aabb.intersects(bounds_)) {
+        return false;
+    }
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float lower = (aabb.min[axis] - origin_[axis]) * inverseScale_[axis];
+        const float upper = (aabb.max[axis] - origin_[axis]) * inverseScale_[axis];
+        box.min[axis] =
+            static_cast<uint16_t>(std::clamp(std::floor(lower), 0.0f, QuantizationSteps));
+        box.max[axis] =
+            static_cast<uint16_t>(std::clamp(std::ceil(upper), 0.0f, QuantizationSteps));
+    }
+    return true;
+}
+
+bool TriangleMesh::raycast(const math::Vec3& origin, const math::Vec3& direction,
+                           float maxDistance, MeshRayHit& hit) const noexcept {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    // Slab distances straight from the quantized bounds: t = q * slope + offset
+    Vec3 slope;
+    Vec3 offset;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float inverse = detail::safeInverse(direction[axis]);
+        slope[axis] = scale_[axis] * inverse;
+        offset[axis] = (origin_[axis] - origin[axis]) * inverse;
+    }
+
+    float closest = maxDistance;
+    uint32_t closestIndex = UINT32_MAX;
+    std::array<OrderedEntry, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = {0, 0.0f};
+    while (stackSize > 0) {
+        const OrderedEntry entry = stack[--stackSize];
+        if (entry.distance > closest) {
+            continue;
+        }
+        const Node& node = nodes_[entry.node];
+
+        std::array<float, 4> entryDistance;
+        std::array<float, 4> exitDistance;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const float x0 = static_cast<float>(node.minX[i]) * slope.x + offset.x;
+            const float x1 = static_cast<float>(node.maxX[i]) * slope.x + offset.x;
+            const float y0 = static_cast<float>(node.minY[i]) * slope.y + offset.y;
+            const float y1 = static_cast<float>(node.maxY[i]) * slope.y + offset.y;
+            const float z0 = static_cast<float>(node.minZ[i]) * slope.z + offset.z;
+            const float z1 = static_cast<float>(node.maxZ[i]) * slope.z + offset.z;
+            entryDistance[i] = std::max(std::max(std::min(x0, x1), std::min(y0, y1)),
+                                        std::max(std::min(z0, z1), 0.0f));
+            exitDistance[i] = std::min(std::min(std::max(x0, x1), std::max(y0, y1)),
+                                       std::min(std::max(z0, z1), closest));
+        }
+
+        std::array<OrderedEntry, 4> hits;
+        uint32_t hitCount = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const uint32_t child = node.children[i];
+            if (child == EmptyChild || entryDistance[i] > exitDistance[i]) {
+                continue;
+            }
+            if (!isLeaf(child)) {
+                hits[hitCount++] = {child, entryDistance[i]};
+                continue;
+            }
+            const uint32_t end = leafFirst(child) + leafCount(child);
+            for (uint32_t index = leafFirst(child); index < end; ++index) {
+                const float distance =
+                    detail::intersectTriangle(origin, direction, getVertices(index));
+                if (distance >= 0.0f && distance <= closest) {
+                    closest = distance;
+                    closestIndex = index;
+                }
+            }
+        }
+
+        // Nearest child on top of the stack
+        sortFarToNear(hits, hitCount);
+        for (uint32_t i = 0; i < hitCount; ++i) {
+            AXIOM_ASSERT(stackSize < StackSize, "Mesh traversal stack overflow");
+            stack[stackSize++] = hits[i];
+        }
+    }
+
+    if (closestIndex == UINT32_MAX) {
+        return false;
+    }
+    const std::array<Vec3, 3> vertices = getVertices(closestIndex);
+    Vec3 normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]).normalized();
+    if (normal.dot(direction) > 0.0f) {
+        normal = -normal;
+    }
+    hit.distance = closest;
+    hit.point = origin + direction * closest;
+    hit.normal = normal;
+    hit.triangle = ids_[closestIndex];
+    return true;
+}
+
+uint32_t TriangleMesh::raycast(RayPacket& packet, std::array<MeshRayHit, RayPacket::Width>& hits,
+                               bool anyHit) const noexcept {
+    if (nodes_.empty() || packet.activeMask == 0) {
+        return 0;
+    }
+
+    std::array<uint32_t, RayPacket::Width> hitIndex{};
+    std::array<float, RayPacket::Width> distance{};
+    uint32_t hitMask = 0;
+    std::array<OrderedEntry, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = {0, 0.0f};
+    while (stackSize > 0 && packet.activeMask != 0) {
+        const OrderedEntry entry = stack[--stackSize];
+        if (entry.distance > packet.getMaxLength()) {
+            continue;
+        }
+        const Node& node = nodes_[entry.node];
+
+        std::array<OrderedEntry, 4> candidates;
+        uint32_t candidateCount = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const uint32_t child = node.children[i];
+            if (child == EmptyChild) {
+                continue;
+            }
+            float entryDistance = 0.0f;
+            const uint32_t lanes = packet.intersect(getChildBounds(node, i), entryDistance);
+            if (lanes == 0) {
+                continue;
+            }
+            if (!isLeaf(child)) {
+                candidates[candidateCount++] = {child, entryDistance};
+                continue;
+            }
+            const uint32_t end = leafFirst(child) + leafCount(child);
+            for (uint32_t index = leafFirst(child); index < end; ++index) {
+                const uint32_t laneHits = intersectTriangle(packet, lanes & packet.activeMask,
+                                                            getVertices(index), distance);
+                for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+                    if ((laneHits & (1u << lane)) != 0) {
+                        packet.length[lane] = distance[lane];
+                        hitIndex[lane] = index;
+                    }
+                }
+                hitMask |= laneHits;
+                if (anyHit) {
+                    packet.activeMask &= ~laneHits;
+                }
+            }
+        }
+
+        sortFarToNear(candidates, candidateCount);
+        for (uint32_t i = 0; i < candidateCount; ++i) {
+            AXIOM_ASSERT(stackSize < StackSize, "Mesh traversal stack overflow");
+            stack[stackSize++] = candidates[i];
+        }
+    }
+
+    for (uint32_t lane = 0; lane < RayPacket::Width; ++lane) {
+        if ((hitMask & (1u << lane)) == 0) {
+            continue;
+        }
+        const std::array<Vec3, 3> vertices = getVertices(hitIndex[lane]);
+        const Vec3 direction = packet.getDirection(lane);
+        Vec3 normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]).normalized();
+        if (normal.dot(direction) > 0.0f) {
+            normal = -normal;
+        }
+        hits[lane].distance = packet.length[lane];
+        hits[lane].point = packet.getOrigin(lane) + direction * packet.length[lane];
+        hits[lane].normal = normal;
+        hits[lane].triangle = ids_[hitIndex[lane]];
+    }
+    return hitMask;
+}
+
+bool TriangleMesh::closestPoint(const math::Vec3& point, float maxDistance,
+                                MeshClosestPoint& result) const noexcept {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    float bestSquared = maxDistance * maxDistance;
+    uint32_t bestIndex = UINT32_MAX;
+    Vec3 bestPoint;
+    std::array<OrderedEntry, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = {0, 0.0f};
+    while (stackSize > 0) {
+        const OrderedEntry entry = stack[--stackSize];
+        if (entry.distance > bestSquared) {
+            continue;
+        }
+        const Node& node = nodes_[entry.node];
+
+        // Squared distance from the point to the four child boxes
+        std::array<float, 4> distanceSquared;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const auto gap = [&](uint16_t low, uint16_t high, size_t axis) {
+                const float lower = origin_[axis] + static_cast<float>(low) * scale_[axis];
+                const float upper = origin_[axis] + static_cast<float>(high) * scale_[axis];
+                return std::max(std::max(lower - point[axis], point[axis] - upper), 0.0f);
+            };
+            const float dx = gap(node.minX[i], node.maxX[i], 0);
+            const float dy = gap(node.minY[i], node.maxY[i], 1);
+            const float dz = gap(node.minZ[i], node.maxZ[i], 2);
+            distanceSquared[i] = dx * dx + dy * dy + dz * dz;
+        }
+
+        std::array<OrderedEntry, 4> candidates;
+        uint32_t candidateCount = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            const uint32_t child = node.children[i];
+            if (child == EmptyChild || distanceSquared[i] > bestSquared) {
+                continue;
+            }
+            if (!isLeaf(child)) {
+                candidates[candidateCount++] = {child, distanceSquared[i]};
+                continue;
+            }
+            const uint32_t end = leafFirst(child) + leafCount(child);
+            for (uint32_t index = leafFirst(child); index < end; ++index) {
+                const std::array<Vec3, 3> vertices = getVertices(index);
+                const Vec3 candidate =
+                    detail::closestPointOnTriangle(point, vertices[0], vertices[1], vertices[2]);
+                const float candidateSquared = (candidate - point).lengthSquared();
+                if (candidateSquared <= bestSquared) {
+                    bestSquared = candidateSquared;
+                    bestIndex = index;
+                    bestPoint = candidate;
+                }
+            }
+        }
+
+        sortFarToNear(candidates, candidateCount);
+        for (uint32_t i = 0; i < candidateCount; ++i) {
+            AXIOM_ASSERT(stackSize < StackSize, "Mesh traversal stack overflow");
+            stack[stackSize++] = candidates[i];
+        }
+    }
+
+    if (bestIndex == UINT32_MAX) {
+        return false;
+    }
+    result.point = bestPoint;
+    result.distance = std::sqrt(bestSquared);
+    result.triangle = ids_[bestIndex];
+    return true;
+}
+
+//=============================================================================
+// Statistics
+//=============================================================================
+
+TriangleMeshStats TriangleMesh::getStats() const noexcept {
+    TriangleMeshStats stats;
+    stats.triangleCount = getTriangleCount();
+    stats.vertexCount = static_cast<uint32_t>(vertices_.size());
+    stats.nodeCount = static_cast<uint32_t>(nodes_.size());
+    stats.compressedIndices = compressed_;
+    stats.memoryBytes = nodes_.size() * sizeof(Node) + vertices_.size() * sizeof(Vec3) +
+                        packed_.size() * sizeof(PackedTriangle) +
+                        wide_.size() * sizeof(std::array<uint32_t, 3>) +
+                        ids_.size() * sizeof(uint32_t);
+    if (nodes_.empty()) {
+        return stats;
+    }
+
+    // Depth and leaf count by walking the tree
+    std::array<std::pair<uint32_t, uint32_t>, StackSize> stack;
+    uint32_t stackSize = 0;
+    stack[stackSize++] = {0, 1};
+    while (stackSize > 0) {
+        const auto [index, depth] = stack[--stackSize];
+        stats.depth = std::max(stats.depth, depth);
+        for (const uint32_t child : nodes_[index].children) {
+            if (child == EmptyChild) {
+                continue;
+            }
+            if (isLeaf(child)) {
+                ++stats.leafCount;
+            } else {
+                stack[stackSize++] = {child, depth + 1};
+            }
+        }
+    }
+    return stats;
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,456 @@
+#include "axiom/collision/uniform_grid.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/job_system.hpp"
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <atomic>
+#include <cmath>
+
+namespace axiom::collision {
+
+namespace {
+
+/// Below this many elements a pass runs on the calling thread
+constexpr size_t ParallelThreshold = 16384;
+
+/// Upper bound on the chunks of a parallel pass
+constexpr uint32_t MaxChunks = 64;
+
+/// Proxies sampled to estimate the median size
+constexpr size_t MaxSizeSamples = 1024;
+
+/// Cell coordinates are clamped to +-MaxCell so three fit in 63 bits
+constexpr int32_t MaxCell = (1 << 20) - 1;
+constexpr int32_t CellBias = 1 << 20;
+constexpr uint64_t CellMask = (1u << 21) - 1;
+
+constexpr uint32_t MaxBucketBits = 30;
+
+/// Number of chunks to split count elements into
+uint32_t chunkCountFor(const core::JobSystem* jobs, size_t count) noexcept {
+    if (jobs == nullptr || count < ParallelThreshold) {
+        return 1;
+    }
+    return std::min(MaxChunks, 4 * std::max(jobs->getWorkerCount(), 1u));
+}
+
+/// Run fn(chunk) for every chunk in [0, chunkCount), on the job system if there is one
+template <typename Fn>
+void forEachChunk(core::JobSystem* jobs, uint32_t chunkCount, Fn&& fn) {
+    if (jobs == nullptr || chunkCount == 1) {
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            fn(chunk);
+        }
+        return;
+    }
+    jobs->parallelFor(chunkCount, 1, [&fn](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            fn(chunk);
+        }
+    });
+}
+
+int32_t toCell(float value, float inverseCellSize) noexcept {
+    constexpr auto Limit = static_cast<float>(MaxCell);
+    return static_cast<int32_t>(std::clamp(std::floor(value * inverseCellSize), -Limit, Limit));
+}
+
+}  // namespace
+
+UniformGrid::UniformGrid(const UniformGridConfig& config) : config_(config) {
+    proxies_.reserve(config_.initialCapacity);
+    if (config_.cellSize > 0.0f) {
+        cellSize_ = config_.cellSize;
+        inverseCellSize_ = 1.0f / cellSize_;
+    }
+}
+
+//=============================================================================
+// Proxies
+//=============================================================================
+
+ProxyId UniformGrid::createProxy(const math::AABB& aabb, uint64_t userData) {
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+
+    uint32_t index;
+    if (freeList_ != NullProxy) {
+        index = freeList_;
+        freeList_ = proxies_[index].nextFree;
+    } else {
+        index = static_cast<uint32_t>(proxies_.size());
+        AXIOM_ASSERT(index != NullProxy, "UniformGrid proxy pool exhausted");
+        proxies_.emplace_back();
+    }
+
+    Proxy& proxy = proxies_[index];
+    proxy.aabb = aabb;
+    proxy.userData = userData;
+    proxy.nextFree = NullProxy;
+    proxy.alive = true;
+
+    ++proxyCount_;
+    return static_cast<ProxyId>(index);
+}
+
+void UniformGrid::destroyProxy(ProxyId id) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+
+    Proxy& proxy = proxies_[id];
+    proxy.alive = false;
+    proxy.nextFree = freeList_;
+    freeList_ = id;
+    --proxyCount_;
+}
+
+void UniformGrid::moveProxy(ProxyId id, const math::AABB& aabb) {
+    AXIOM_ASSERT(id < proxies_.size() && proxies_[id].alive, "Invalid proxy id");
+    AXIOM_ASSERT(aabb.isValid(), "Proxy bounds must be valid");
+    proxies_[id].aabb = aabb;
+}
+
+void UniformGrid::moveProxies(std::span<const ProxyMove> moves) {
+    for (const ProxyMove& move : moves) {
+        moveProxy(move.id, move.aabb);
+    }
+}
+
+//=============================================================================
+// Cells
+//=============================================================================
+
+UniformGrid::CellRange UniformGrid::cellRange(const math::AABB& aabb) const noexcept {
+    CellRange range;
+    for (size_t a = 0; a < 3; ++a) {
+        range.lo[a] = toCell(aabb.min[a], inverseCellSize_);
+        range.hi[a] = toCell(aabb.max[a], inverseCellSize_);
+    }
+    return range;
+}
+
+uint32_t UniformGrid::bucketOf(uint64_t cell) const noexcept {
+    // Fibonacci hashing: the top bits of the product are well mixed
+    return static_cast<uint32_t>((cell * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits_));
+}
+
+uint64_t UniformGrid::packCell(int32_t x, int32_t y, int32_t z) noexcept {
+    return (static_cast<uint64_t>(x + CellBias) << 42) |
+           (static_cast<uint64_t>(y + CellBias) << 21) | static_cast<uint64_t>(z + CellBias);
+}
+
+std::array<int32_t, 3> UniformGrid::unpackCell(uint64_t cell) noexcept {
+    return {static_cast<int32_t>(cell >> 42) - CellBias,
+            static_cast<int32_t>((cell >> 21) & CellMask) - CellBias,
+            static_cast<int32_t>(cell & CellMask) - CellBias};
+}
+
+std::pair<uint32_t, uint32_t> UniformGrid::findCell(uint64_t cell) const noexcept {
+    if (bucketStarts_.empty()) {
+        return {0, 0};
+    }
+
+    // Cells sharing a bucket are stored one after the other
+    const uint32_t bucket = bucketOf(cell);
+    uint32_t begin = bucketStarts_[bucket];
+    const uint32_t bucketEnd = bucketStarts_[bucket + 1];
+    while (begin < bucketEnd && entries_[begin].cell != cell) {
+        ++begin;
+    }
+    uint32_t end = begin;
+    while (end < bucketEnd && entries_[end].cell == cell) {
+        ++end;
+    }
+    return {begin, end};
+}
+
+bool UniformGrid::overlaps(const CellEntry& entry, const math::AABB& aabb) noexcept {
+    return entry.bounds.intersects(aabb);
+}
+
+//=============================================================================
+// Update
+//=============================================================================
+
+void UniformGrid::update() {
+    AXIOM_PROFILE_SCOPE("UniformGrid::update");
+    AXIOM_PROFILE_ELEMENTS(proxyCount_);
+
+    stats_ = {};
+    chooseCellSize();
+    countEntries();
+    scatterEntries();
+    sortBuckets();
+
+    stats_.cellSize = cellSize_;
+    stats_.entryCount = static_cast<uint32_t>(entries_.size());
+    stats_.bucketCount = 1u << bucketBits_;
+    stats_.oversizedCount = static_cast<uint32_t>(oversized_.size());
+}
+
+void UniformGrid::chooseCellSize() {
+    if (config_.cellSize > 0.0f || proxyCount_ == 0) {
+        return;
+    }
+
+    // The median of an evenly strided sample is close enough and costs O(1)
+    sizeSamples_.clear();
+    const size_t stride = std::max<size_t>(1, proxies_.size() / MaxSizeSamples);
+    for (size_t index = 0; index < proxies_.size(); index += stride) {
+        const Proxy& proxy = proxies_[index];
+        if (proxy.alive) {
+            const math::Vec3 size = proxy.aabb.size();
+            sizeSamples_.push_back(std::max({size.x, size.y, size.z}));
+        }
+    }
+    if (sizeSamples_.empty()) {
+        return;
+    }
+
+    const auto median = sizeSamples_.begin() + static_cast<ptrdiff_t>(sizeSamples_.size() / 2);
+    std::nth_element(sizeSamples_.begin(), median, sizeSamples_.end());
+    const float cellSize = *median * config_.cellSizeScale;
+    if (cellSize > 0.0f) {
+        cellSize_ = cellSize;
+        inverseCellSize_ = 1.0f / cellSize;
+    }
+}
+
+void UniformGrid::countEntries() {
+    AXIOM_PROFILE_SCOPE("UniformGrid::countEntries");
+
+    // About two buckets per proxy keeps the average bucket to one cell or less
+    const size_t proxyTotal = proxies_.size();
+    const auto bucketCount = std::bit_ceil(std::max<uint32_t>(2 * proxyCount_, 16));
+    bucketBits_ = std::min(MaxBucketBits, static_cast<uint32_t>(std::countr_zero(bucketCount)));
+    bucketStarts_.assign((size_t{1} << bucketBits_) + 1, 0);
+    ranges_.resize(proxyTotal);
+
+    core::JobSystem* jobs = config_.jobSystem;
+    const uint32_t chunkCount = chunkCountFor(jobs, proxyTotal);
+    const size_t chunkSize = (proxyTotal + chunkCount - 1) / chunkCount;
+    parallelBuild_ = chunkCount > 1;
+
+    // Cell ranges, and the number of entries per bucket
+    forEachChunk(jobs, chunkCount, [&](uint32_t chunk) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = std::min(proxyTotal, begin + chunkSize);
+        for (size_t index = begin; index < end; ++index) {
+            const Proxy& proxy = proxies_[index];
+            CellRange& range = ranges_[index];
+            if (!proxy.alive) {
+                range.cellCount = 0;
+                range.oversized = false;
+                continue;
+            }
+
+            range = cellRange(proxy.aabb);
+            const auto cellCount = static_cast<uint64_t>(range.hi[0] - range.lo[0] + 1) *
+                                   static_cast<uint64_t>(range.hi[1] - range.lo[1] + 1) *
+                                   static_cast<uint64_t>(range.hi[2] - range.lo[2] + 1);
+            range.oversized = cellCount > config_.maxCellsPerProxy;
+            range.cellCount = range.oversized ? 0 : static_cast<uint32_t>(cellCount);
+            if (range.oversized) {
+                continue;
+            }
+
+            for (int32_t x = range.lo[0]; x <= range.hi[0]; ++x) {
+                for (int32_t y = range.lo[1]; y <= range.hi[1]; ++y) {
+                    for (int32_t z = range.lo[2]; z <= range.hi[2]; ++z) {
+                        uint32_t& counter = bucketStarts_[bucketOf(packCell(x, y, z))];
+                        if (parallelBuild_) {
+                            std::atomic_ref<uint32_t>(counter).fetch_add(
+                                1, std::memory_order_relaxed);
+                        } else {
+                            ++counter;
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // Exclusive prefix sum: the counts become the first entry of each bucket
+    uint32_t running = 0;
+    for (uint32_t& start : bucketStarts_) {
+        const uint32_t bucketSize = start;
+        start = running;
+        running += bucketSize;
+    }
+
+    oversized_.clear();
+    for (size_t index = 0; index < proxyTotal; ++index) {
+        if (ranges_[index].oversized) {
+            oversized_.push_back(static_cast<ProxyId>(index));
+        }
+    }
+}
+
+void UniformGrid::scatterEntries() {
+    AXIOM_PROFILE_SCOPE("UniformGrid::scatterEntries");
+
+    const size_t proxyTotal = proxies_.size();
+    entries_.resize(bucketStarts_.back());
+    bucketCursors_.assign(bucketStarts_.begin(), bucketStarts_.end() - 1);
+
+    // Each proxy writes its entries, bounds included, straight to their
+    // bucket; the build never reads proxies in bucket order
+    core::JobSystem* jobs = config_.jobSystem;
+    const uint32_t chunkCount = parallelBuild_ ? chunkCountFor(jobs, proxyTotal) : 1;
+    const size_t chunkSize = (proxyTotal + chunkCount - 1) / chunkCount;
+    forEachChunk(jobs, chunkCount, [&](uint32_t chunk) {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = std::min(proxyTotal, begin + chunkSize);
+        for (size_t index = begin; index < end; ++index) {
+            const CellRange& range = ranges_[index];
+            if (range.cellCount == 0) {
+                continue;
+            }
+
+            CellEntry entry;
+            entry.bounds = proxies_[index].aabb;
+            entry.firstCell = range.lo;
+            entry.id = static_cast<ProxyId>(index);
+            for (int32_t x = range.lo[0]; x <= range.hi[0]; ++x) {
+                for (int32_t y = range.lo[1]; y <= range.hi[1]; ++y) {
+                    for (int32_t z = range.lo[2]; z <= range.hi[2]; ++z) {
+                        entry.cell = packCell(x, y, z);
+                        uint32_t& cursor = bucketCursors_[bucketOf(entry.cell)];
+                        const uint32_t slot =
+                            parallelBuild_ ? std::atomic_ref<uint32_t>(cursor).fetch_add(
+                                                 1, std::memory_order_relaxed)
+                                           : cursor++;
+                        entries_[slot] = entry;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void UniformGrid::sortBuckets() {
+    AXIOM_PROFILE_SCOPE("UniformGrid::sortBuckets");
+
+    // Order each bucket by (cell, proxy). This groups cells that share a
+    // bucket and makes the order independent of how parallel chunks
+    // interleaved. Buckets are small, and a serial build is already in proxy
+    // order, so an insertion sort does little work.
+    const auto bucketCount = static_cast<uint32_t>(bucketStarts_.size() - 1);
+    core::JobSystem* jobs = config_.jobSystem;
+    const uint32_t chunkCount = chunkCountFor(jobs, entries_.size());
+    const uint32_t bucketsPerChunk = (bucketCount + chunkCount - 1) / chunkCount;
+    forEachChunk(jobs, chunkCount, [&](uint32_t chunk) {
+        const uint32_t firstBucket = std::min(bucketCount, chunk * bucketsPerChunk);
+        const uint32_t lastBucket = std::min(bucketCount, firstBucket + bucketsPerChunk);
+        for (uint32_t bucket = firstBucket; bucket < lastBucket; ++bucket) {
+            const uint32_t bucketBegin = bucketStarts_[bucket];
+            const uint32_t bucketEnd = bucketStarts_[bucket + 1];
+            auto before = [](const CellEntry& a, const CellEntry& b) {
+                return a.cell < b.cell || (a.cell == b.cell && a.id < b.id);
+            };
+            for (uint32_t i = bucketBegin + 1; i < bucketEnd; ++i) {
+                if (!before(entries_[i], entries_[i - 1])) {
+                    continue;
+                }
+                const CellEntry entry = entries_[i];
+                uint32_t j = i;
+                do {
+                    entries_[j] = entries_[j - 1];
+                    --j;
+                } while (j > bucketBegin && before(entry, entries_[j - 1]));
+                entries_[j] = entry;
+            }
+        }
+    });
+
+    // Cell runs
+    const auto count = static_cast<uint32_t>(entries_.size());
+    cellStarts_.clear();
+    uint32_t maxOccupancy = 0;
+    for (uint32_t k = 0; k < count; ++k) {
+        if (k == 0 || entries_[k].cell != entries_[k - 1].cell) {
+            if (!cellStarts_.empty()) {
+                maxOccupancy = std::max(maxOccupancy, k - cellStarts_.back());
+            }
+            cellStarts_.push_back(k);
+        }
+    }
+    if (!cellStarts_.empty()) {
+        maxOccupancy = std::max(maxOccupancy, count - cellStarts_.back());
+    }
+    stats_.cellCount = static_cast<uint32_t>(cellStarts_.size());
+    stats_.maxOccupancy = maxOccupancy;
+    cellStarts_.push_back(count);
+}
+
+//=============================================================================
+// Pairs
+//=============================================================================
+
+void UniformGrid::findPairs() {
+    AXIOM_PROFILE_SCOPE("UniformGrid::findPairs");
+
+    // Chunks of cells, plus one for the oversized proxies
+    const auto cellCount = static_cast<uint32_t>(cellStarts_.size() - 1);
+    core::JobSystem* jobs = config_.jobSystem;
+    const uint32_t chunkCount = chunkCountFor(jobs, entries_.size());
+    const uint32_t cellsPerChunk = (cellCount + chunkCount - 1) / chunkCount;
+    pairChunks_.resize(chunkCount + 1);
+    for (auto& chunk : pairChunks_) {
+        chunk.clear();
+    }
+
+    forEachChunk(jobs, chunkCount, [&](uint32_t chunk) {
+        auto& pairs = pairChunks_[chunk];
+        const uint32_t firstCell = std::min(cellCount, chunk * cellsPerChunk);
+        const uint32_t lastCell = std::min(cellCount, firstCell + cellsPerChunk);
+        for (uint32_t c = firstCell; c < lastCell; ++c) {
+            const uint32_t begin = cellStarts_[c];
+            const uint32_t end = cellStarts_[c + 1];
+            if (end - begin < 2) {
+                continue;
+            }
+
+            // A pair is reported from the cell holding the lower corner of
+            // the overlap: the highest of the two first cells on each axis
+            const std::array<int32_t, 3> cell = unpackCell(entries_[begin].cell);
+            for (uint32_t i = begin; i + 1 < end; ++i) {
+                const CellEntry& a = entries_[i];
+                for (uint32_t j = i + 1; j < end; ++j) {
+                    const CellEntry& b = entries_[j];
+                    const bool pair = (std::max(a.firstCell[0], b.firstCell[0]) == cell[0]) &
+                                      (std::max(a.firstCell[1], b.firstCell[1]) == cell[1]) &
+                                      (std::max(a.firstCell[2], b.firstCell[2]) == cell[2]) &
+                                      (a.bounds.min.x <= b.bounds.max.x) &
+                                      (a.bounds.max.x >= b.bounds.min.x) &
+                                      (a.bounds.min.y <= b.bounds.max.y) &
+                                      (a.bounds.max.y >= b.bounds.min.y) &
+                                      (a.bounds.min.z <= b.bounds.max.z) &
+                                      (a.bounds.max.z >= b.bounds.min.z);
+                    if (pair) {
+                        pairs.emplace_back(std::minmax(a.id, b.id));
+                    }
+                }
+            }
+        }
+    });
+
+    // Oversized proxies against everything; among themselves, each pair once
+    auto& pairs = pairChunks_[chunkCount];
+    for (const ProxyId big : oversized_) {
+        const math::AABB& aabb = proxies_[big].aabb;
+        for (size_t index = 0; index < proxies_.size(); ++index) {
+            const auto other = static_cast<ProxyId>(index);
+            const Proxy& proxy = proxies_[index];
+            if (!proxy.alive || other == big || (ranges_[index].oversized && other < big)) {
+                continue;
+            }
+            if (proxy.aabb.intersects(aabb)) {
+                pairs.emplace_back(std::minmax(big, other));
+            }
+        }
+    }
+}
+
+}  // namespace axiom::collision
@@ -0,0 +1,346 @@
+#include "axiom/core/coroutine.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/profiler.hpp"
+#include "axiom/memory/pool_allocator.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <new>
+
+namespace axiom::core {
+
+namespace {
+
+thread_local const TaskExecutor* tlsExecutor = nullptr;
+
+//=============================================================================
+// Coroutine frame pools
+//=============================================================================
+
+constexpr size_t FrameAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr size_t FramesPerChunk = 64;
+
+template <size_t BlockSize>
+struct FrameSizeClass {
+    std::mutex mutex;
+    memory::PoolAllocator<BlockSize, FrameAlignment> pool{FramesPerChunk};
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pool.allocate(BlockSize, FrameAlignment);
+    }
+
+    void deallocate(void* ptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pool.deallocate(ptr, BlockSize);
+    }
+};
+
+/// Power-of-two size classes from 128 bytes to MaxPooledCoroutineFrame
+///
+/// Coroutine frames are created and destroyed at a high rate with only a few
+/// distinct sizes per program, which is exactly what fixed-size pools are good at.
+class CoroutineFramePools {
+public:
+    static CoroutineFramePools& getInstance() {
+        static CoroutineFramePools instance;
+        return instance;
+    }
+
+    void* allocate(size_t size) {
+        if (size <= 128) {
+            return size128_.allocate();
+        } else if (size <= 256) {
+            return size256_.allocate();
+        } else if (size <= 512) {
+            return size512_.allocate();
+        } else if (size <= 1024) {
+            return size1024_.allocate();
+        } else if (size <= 2048) {
+            return size2048_.allocate();
+        }
+        return size4096_.allocate();
+    }
+
+    void deallocate(void* ptr, size_t size) {
+        if (size <= 128) {
+            size128_.deallocate(ptr);
+        } else if (size <= 256) {
+            size256_.deallocate(ptr);
+        } else if (size <= 512) {
+            size512_.deallocate(ptr);
+        } else if (size <= 1024) {
+            size1024_.deallocate(ptr);
+        } else if (size <= 2048) {
+            size2048_.deallocate(ptr);
+        } else {
+            size4096_.deallocate(ptr);
+        }
+    }
+
+    std::atomic<uint64_t> pooledAllocations{0};
+    std::atomic<uint64_t> heapAllocations{0};
+    std::atomic<uint64_t> liveFrames{0};
+
+private:
+    static_assert(detail::MaxPooledCoroutineFrame == 4096,
+                  "Size classes must cover the pooled range");
+
+    FrameSizeClass<128> size128_;
+    FrameSizeClass<256> size256_;
+    FrameSizeClass<512> size512_;
+    FrameSizeClass<1024> size1024_;
+    FrameSizeClass<2048> size2048_;
+    FrameSizeClass<4096> size4096_;
+};
+
+}  // namespace
+
+CoroutineFrameStats getCoroutineFrameStats() noexcept {
+    auto& pools = CoroutineFramePools::getInstance();
+    CoroutineFrameStats stats;
+    stats.pooledAllocations = pools.pooledAllocations.load(std::memory_order_relaxed);
+    stats.heapAllocations = pools.heapAllocations.load(std::memory_order_relaxed);
+    stats.liveFrames = pools.liveFrames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+namespace detail {
+
+void* allocateCoroutineFrame(size_t size) {
+    auto& pools = CoroutineFramePools::getInstance();
+    pools.liveFrames.fetch_add(1, std::memory_order_relaxed);
+
+    if (size > MaxPooledCoroutineFrame) {
+        pools.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    void* ptr = pools.allocate(size);
+    AXIOM_VERIFY(ptr != nullptr, "Out of memory allocating a coroutine frame");
+    pools.pooledAllocations.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void deallocateCoroutineFrame(void* ptr, size_t size) noexcept {
+    auto& pools = CoroutineFramePools::getInstance();
+    pools.liveFrames.fetch_sub(1, std::memory_order_relaxed);
+
+    if (size > MaxPooledCoroutineFrame) {
+        ::operator delete(ptr, size);
+        return;
+    }
+    pools.deallocate(ptr, size);
+}
+
+}  // namespace detail
+
+//=============================================================================
+// TaskExecutor
+//=============================================================================
+
+TaskExecutor::TaskExecutor(const TaskExecutorConfig& config)
+    : pollInterval_(config.pollInterval) {
+    const uint32_t threadCount = std::max(1u, config.threadCount);
+    threads_.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this] { resumeThreadMain(); });
+    }
+    pollThread_ = std::thread([this] { pollThreadMain(); });
+    ioThread_ = std::thread([this] { ioThreadMain(); });
+}
+
+TaskExecutor::~TaskExecutor() {
+    stopping_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+    }
+    readyCondition_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(pollMutex_);
+    }
+    pollCondition_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(ioMutex_);
+    }
+    ioCondition_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    pollThread_.join();
+    ioThread_.join();
+}
+
+bool TaskExecutor::isExecutorThread() const noexcept {
+    return tlsExecutor == this;
+}
+
+void TaskExecutor::spawn(Task<void> task) {
+    pendingTasks_.fetch_add(1, std::memory_order_relaxed);
+    runDetached(this, std::move(task));
+}
+
+detail::DetachedTask TaskExecutor::runDetached(TaskExecutor* executor, Task<void> task) {
+    co_await executor->schedule();
+    co_await std::move(task);
+    executor->onTaskFinished();
+}
+
+void TaskExecutor::onTaskFinished() {
+    // Decrement under the lock so waitIdle() cannot return (and the executor be
+    // destroyed) between the decrement and the notification
+    std::lock_guard<std::mutex> lock(idleMutex_);
+    if (pendingTasks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        idleCondition_.notify_all();
+    }
+}
+
+void TaskExecutor::waitIdle() {
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    idleCondition_.wait(lock,
+                        [this] { return pendingTasks_.load(std::memory_order_acquire) == 0; });
+}
+
+void TaskExecutor::enqueue(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(readyMutex_);
+        ready_.push_back(handle);
+    }
+    readyCondition_.notify_one();
+}
+
+void TaskExecutor::addPoll(detail::PollNode* node) {
+    {
+        std::lock_guard<std::mutex> lock(pollMutex_);
+        newPolls_.push_back(node);
+    }
+    pollCondition_.notify_one();
+}
+
+void TaskExecutor::submitIo(detail::IoNode* node) {
+    {
+        std::lock_guard<std::mutex> lock(ioMutex_);
+        ioQueue_.push_back(node);
+    }
+    ioCondition_.notify_one();
+}
+
+//=============================================================================
+// Threads
+//=============================================================================
+
+void TaskExecutor::resumeThreadMain() {
+    tlsExecutor = this;
+    AXIOM_PROFILE_THREAD_NAME("Axiom Task Executor");
+
+    for (;;) {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock<std::mutex> lock(readyMutex_);
+            readyCondition_.wait(lock, [this] {
+                return !ready_.empty() || stopping_.load(std::memory_order_acquire);
+            });
+            if (ready_.empty()) {
+                return;
+            }
+            handle = ready_.front();
+            ready_.pop_front();
+        }
+
+        AXIOM_PROFILE_SCOPE("Resume coroutine");
+        handle.resume();
+    }
+}
+
+void TaskExecutor::pollThreadMain() {
+    AXIOM_PROFILE_THREAD_NAME("Axiom Task Poller");
+
+    std::vector<detail::PollNode*> pending;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pollMutex_);
+            auto wakeUp = [this] {
+                return !newPolls_.empty() || stopping_.load(std::memory_order_acquire);
+            };
+            if (pending.empty()) {
+                pollCondition_.wait(lock, wakeUp);
+            } else {
+                pollCondition_.wait_for(lock, pollInterval_, wakeUp);
+            }
+            if (stopping_.load(std::memory_order_acquire)) {
+                return;
+            }
+            pending.insert(pending.end(), newPolls_.begin(), newPolls_.end());
+            newPolls_.clear();
+        }
+
+        for (size_t i = 0; i < pending.size();) {
+            detail::PollNode* node = pending[i];
+            if (!node->poll(*node)) {
+                ++i;
+                continue;
+            }
+            // The node lives in the coroutine frame: read the handle before resuming
+            const std::coroutine_handle<> handle = node->handle;
+            pending[i] = pending.back();
+            pending.pop_back();
+            enqueue(handle);
+        }
+    }
+}
+
+void TaskExecutor::ioThreadMain() {
+    AXIOM_PROFILE_THREAD_NAME("Axiom Task I/O");
+
+    for (;;) {
+        detail::IoNode* node = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(ioMutex_);
+            ioCondition_.wait(lock, [this] {
+                return !ioQueue_.empty() || stopping_.load(std::memory_order_acquire);
+            });
+            if (ioQueue_.empty()) {
+                return;
+            }
+            node = ioQueue_.front();
+            ioQueue_.pop_front();
+        }
+
+        const std::coroutine_handle<> handle = node->handle;
+        {
+            AXIOM_PROFILE_SCOPE("Async I/O");
+            node->execute(*node);
+        }
+        enqueue(handle);
+    }
+}
+
+//=============================================================================
+// File I/O
+//=============================================================================
+
+Result<std::vector<uint8_t>> TaskExecutor::readFileBlocking(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return Result<std::vector<uint8_t>>::failure(ErrorCode::FileNotFound,
+                                                     "Failed to open file");
+    }
+
+    const std::streamoff size = file.tellg();
+    if (size < 0) {
+        return Result<std::vector<uint8_t>>::failure(ErrorCode::FileReadFailed,
+                                                     "Failed to determine file size");
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0 && !file.read(reinterpret_cast<char*>(data.data()), size)) {
+        return Result<std::vector<uint8_t>>::failure(ErrorCode::FileReadFailed,
+                                                     "Failed to read file");
+    }
+    return Result<std::vector<uint8_t>>::success(std::move(data));
+}
+
+}  // namespace axiom::core
@@ -59,6 +59,12 @@ const char* errorCodeToString(ErrorCode code) noexcept {
     case ErrorCode::OutOfRange:
         return "Value out of range";
 
+    // IO errors (700-799)
+    case ErrorCode::FileNotFound:
+        return "File not found";
+    case ErrorCode::FileReadFailed:
+        return "File read failed";
+
     default:
         return "Unknown error";
     }
@@ -81,6 +87,8 @@ ErrorCategory getErrorCategory(ErrorCode code) noexcept {
         return ErrorCategory::GPU;
     } else if (codeValue >= 600 && codeValue < 700) {
         return ErrorCategory::Validation;
+    } else if (codeValue >= 700 && codeValue < 800) {
+        return ErrorCategory::IO;
     } else {
         return ErrorCategory::None;
     }
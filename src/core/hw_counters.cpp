@@ -0,0 +1,393 @@
+#include "axiom/core/hw_counters.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/cache_line.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace axiom::core {
+
+namespace {
+
+static_assert(HwEventCount <= 32, "HwCounterValues::validMask has one bit per HwEvent");
+
+//=============================================================================
+// Per-thread counter group
+//=============================================================================
+
+#if defined(__linux__)
+
+/// perf_event configuration of each HwEvent
+struct EventConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheMissConfig(uint64_t cache) noexcept {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr std::array<EventConfig, HwEventCount> EventConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+/// Counters of one thread, opened as a single perf_event group
+///
+/// A group is scheduled onto the PMU all-or-nothing, so all events of a
+/// reading cover the same instructions. Events the CPU (or hypervisor) does
+/// not support are left out of the group; if the leader cannot be opened at
+/// all, the thread runs without counters.
+class ThreadCounters {
+public:
+    ThreadCounters() {
+        int leader = -1;
+        for (size_t e = 0; e < HwEventCount; ++e) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = EventConfigs[e].type;
+            attr.config = EventConfigs[e].config;
+            if (leader < 0) {
+                attr.disabled = 1;  // The leader enables the whole group once it is complete
+            }
+            attr.exclude_kernel = 1;  // Allowed with the default perf_event_paranoid = 2
+            attr.exclude_hv = 1;
+            attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            // pid = 0, cpu = -1: the calling thread, on whichever CPU it runs
+            const auto fd =
+                static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0UL));
+            if (fd < 0) {
+                continue;
+            }
+            if (leader < 0) {
+                leader = fd;
+            }
+            fds_[groupSize_] = fd;
+            groupEvents_[groupSize_] = static_cast<uint8_t>(e);
+            ++groupSize_;
+            validMask_ |= 1u << e;
+        }
+
+        if (leader >= 0) {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    ~ThreadCounters() {
+        for (uint32_t i = 0; i < groupSize_; ++i) {
+            close(fds_[i]);
+        }
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    uint32_t getValidMask() const noexcept { return validMask_; }
+
+    HwCounterValues read() const noexcept {
+        HwCounterValues result;
+        if (groupSize_ == 0) {
+            return result;
+        }
+
+        // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+        uint64_t buffer[3 + HwEventCount] = {};
+        const ssize_t bytes = ::read(fds_[0], buffer, sizeof(buffer));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buffer[0] != groupSize_) {
+            return result;
+        }
+
+        // Scale for multiplexing: if other groups compete for the PMU, ours only
+        // ran for part of the time it was enabled
+        const uint64_t enabled = buffer[1];
+        const uint64_t running = buffer[2];
+        const double scale = (running > 0 && running < enabled)
+                                 ? static_cast<double>(enabled) / static_cast<double>(running)
+                                 : 1.0;
+
+        for (uint32_t i = 0; i < groupSize_; ++i) {
+            result.values[groupEvents_[i]] =
+                static_cast<uint64_t>(static_cast<double>(buffer[3 + i]) * scale);
+        }
+        result.validMask = validMask_;
+        return result;
+    }
+
+private:
+    std::array<int, HwEventCount> fds_{};             ///< fds_[0] is the group leader
+    std::array<uint8_t, HwEventCount> groupEvents_{};  ///< HwEvent of each group member
+    uint32_t groupSize_ = 0;
+    uint32_t validMask_ = 0;
+};
+
+#else  // !__linux__
+
+/// Hardware counters are only implemented on Linux: timing only elsewhere
+class ThreadCounters {
+public:
+    uint32_t getValidMask() const noexcept { return 0; }
+    HwCounterValues read() const noexcept { return {}; }
+};
+
+#endif
+
+ThreadCounters& localCounters() noexcept {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+thread_local HwCounterScope* tlsInnermostScope = nullptr;
+
+uint64_t elapsedNanoseconds(std::chrono::steady_clock::time_point start) noexcept {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+}  // namespace
+
+const char* hwEventToString(HwEvent event) noexcept {
+    switch (event) {
+    case HwEvent::Cycles:
+        return "Cycles";
+    case HwEvent::Instructions:
+        return "Instructions";
+    case HwEvent::L1DataMisses:
+        return "L1DataMisses";
+    case HwEvent::LastLevelCacheMisses:
+        return "LastLevelCacheMisses";
+    case HwEvent::BranchMisses:
+        return "BranchMisses";
+    case HwEvent::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+bool isHwEventAvailable(HwEvent event) noexcept {
+    return (localCounters().getValidMask() & (1u << static_cast<uint32_t>(event))) != 0;
+}
+
+HwCounterValues readThreadHwCounters() noexcept {
+    return localCounters().read();
+}
+
+//=============================================================================
+// HwZoneStats
+//=============================================================================
+
+double HwZoneStats::getIpc() const noexcept {
+    const uint64_t cycles = counters.get(HwEvent::Cycles);
+    if (!counters.has(HwEvent::Cycles) || !counters.has(HwEvent::Instructions) || cycles == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(counters.get(HwEvent::Instructions)) / static_cast<double>(cycles);
+}
+
+double HwZoneStats::getPerElement(HwEvent event) const noexcept {
+    const uint64_t divisor = elements > 0 ? elements : calls;
+    if (!counters.has(event) || divisor == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(counters.get(event)) / static_cast<double>(divisor);
+}
+
+//=============================================================================
+// HwCounterRegistry
+//=============================================================================
+
+/// Accumulators of one zone, updated with relaxed atomics by any thread
+struct alignas(CacheLineSize) HwCounterRegistry::Zone {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> elements{0};
+    std::atomic<uint64_t> nanoseconds{0};
+    std::atomic<uint32_t> validMask{0};
+    std::array<std::atomic<uint64_t>, HwEventCount> counters{};
+};
+
+HwCounterRegistry::HwCounterRegistry() : zones_(std::make_unique<Zone[]>(MaxZones)) {
+    names_.reserve(MaxZones);
+}
+
+HwCounterRegistry::~HwCounterRegistry() = default;
+
+HwCounterRegistry& HwCounterRegistry::getInstance() noexcept {
+    static HwCounterRegistry instance;
+    return instance;
+}
+
+HwZoneId HwCounterRegistry::registerZone(const char* name) {
+    if (!name) {
+        return InvalidHwZoneId;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (names_[i] == name) {
+            return static_cast<HwZoneId>(i);
+        }
+    }
+
+    if (names_.size() >= MaxZones) {
+        return InvalidHwZoneId;
+    }
+
+    names_.emplace_back(name);
+    const auto id = static_cast<HwZoneId>(names_.size() - 1);
+    zoneCount_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+void HwCounterRegistry::record(HwZoneId id, const HwCounterValues& delta, uint64_t nanoseconds,
+                               uint64_t elements) noexcept {
+    if (id >= MaxZones) {
+        return;
+    }
+
+    Zone& zone = zones_[id];
+    zone.calls.fetch_add(1, std::memory_order_relaxed);
+    zone.elements.fetch_add(elements, std::memory_order_relaxed);
+    zone.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    if (delta.validMask == 0) {
+        return;
+    }
+    zone.validMask.fetch_or(delta.validMask, std::memory_order_relaxed);
+    for (size_t e = 0; e < HwEventCount; ++e) {
+        if (delta.validMask & (1u << e)) {
+            zone.counters[e].fetch_add(delta.values[e], std::memory_order_relaxed);
+        }
+    }
+}
+
+std::vector<HwZoneStats> HwCounterRegistry::snapshot() const {
+    std::vector<HwZoneStats> result;
+    const uint32_t count = zoneCount_.load(std::memory_order_acquire);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t id = 0; id < count; ++id) {
+        const Zone& zone = zones_[id];
+        const uint64_t calls = zone.calls.load(std::memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+
+        HwZoneStats stats;
+        stats.name = names_[id];
+        stats.calls = calls;
+        stats.elements = zone.elements.load(std::memory_order_relaxed);
+        stats.nanoseconds = zone.nanoseconds.load(std::memory_order_relaxed);
+        stats.counters.validMask = zone.validMask.load(std::memory_order_relaxed);
+        for (size_t e = 0; e < HwEventCount; ++e) {
+            stats.counters.values[e] = zone.counters[e].load(std::memory_order_relaxed);
+        }
+        result.push_back(std::move(stats));
+    }
+
+    std::sort(result.begin(), result.end(), [](const HwZoneStats& a, const HwZoneStats& b) {
+        return a.nanoseconds > b.nanoseconds;
+    });
+    return result;
+}
+
+void HwCounterRegistry::writeText(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    for (const HwZoneStats& zone : snapshot()) {
+        out << zone.name << " calls=" << zone.calls << " ms=" << zone.getMilliseconds();
+        if (zone.elements > 0) {
+            out << " elements=" << zone.elements;
+        }
+        if (zone.counters.validMask == 0) {
+            out << " (no hardware counters)\n";
+            continue;
+        }
+
+        const char* per = zone.elements > 0 ? "/elem" : "/call";
+        if (zone.counters.has(HwEvent::Cycles) && zone.counters.has(HwEvent::Instructions)) {
+            out << " IPC=" << zone.getIpc();
+        }
+        if (zone.counters.has(HwEvent::Cycles)) {
+            out << " cycles" << per << "=" << zone.getPerElement(HwEvent::Cycles);
+        }
+        if (zone.counters.has(HwEvent::L1DataMisses)) {
+            out << " L1D" << per << "=" << zone.getPerElement(HwEvent::L1DataMisses);
+        }
+        if (zone.counters.has(HwEvent::LastLevelCacheMisses)) {
+            out << " LLC" << per << "=" << zone.getPerElement(HwEvent::LastLevelCacheMisses);
+        }
+        if (zone.counters.has(HwEvent::BranchMisses)) {
+            out << " branchMiss" << per << "=" << zone.getPerElement(HwEvent::BranchMisses);
+        }
+        out << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void HwCounterRegistry::reset() noexcept {
+    for (size_t id = 0; id < MaxZones; ++id) {
+        Zone& zone = zones_[id];
+        zone.calls.store(0, std::memory_order_relaxed);
+        zone.elements.store(0, std::memory_order_relaxed);
+        zone.nanoseconds.store(0, std::memory_order_relaxed);
+        zone.validMask.store(0, std::memory_order_relaxed);
+        for (auto& counter : zone.counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+//=============================================================================
+// HwCounterScope
+//=============================================================================
+
+HwCounterScope::HwCounterScope(HwZoneId id) noexcept
+    : id_(id),
+      parent_(tlsInnermostScope),
+      start_(readThreadHwCounters()),
+      startTime_(std::chrono::steady_clock::now()) {
+    tlsInnermostScope = this;
+}
+
+HwCounterScope::~HwCounterScope() {
+    const uint64_t nanoseconds = elapsedNanoseconds(startTime_);
+    const HwCounterValues end = readThreadHwCounters();
+
+    AXIOM_ASSERT(tlsInnermostScope == this, "HwCounterScopes must be destroyed in LIFO order");
+    tlsInnermostScope = parent_;
+
+    HwCounterValues delta;
+    delta.validMask = start_.validMask & end.validMask;
+    for (size_t e = 0; e < HwEventCount; ++e) {
+        // Multiplex scaling can make a reading dip slightly below the previous one
+        delta.values[e] = end.values[e] > start_.values[e] ? end.values[e] - start_.values[e] : 0;
+    }
+    HwCounterRegistry::getInstance().record(id_, delta, nanoseconds, elements_);
+}
+
+void HwCounterScope::addElements(uint64_t count) noexcept {
+    if (tlsInnermostScope) {
+        tlsInnermostScope->elements_ += count;
+    }
+}
+
+}  // namespace axiom::core
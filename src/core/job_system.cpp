@@ -0,0 +1,339 @@
+#include "axiom/core/job_system.hpp"
+
+#include "axiom/core/assert.hpp"
+#include "axiom/core/metrics.hpp"
+#include "axiom/core/profiler.hpp"
+#include "axiom/memory/linear_allocator.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace axiom::core {
+
+namespace {
+
+/// Owner index of jobs allocated by threads that are not workers
+constexpr uint32_t ExternalOwner = JobSystem::InvalidWorkerIndex;
+
+/// Failed polls before an idle worker goes to sleep / a waiter starts yielding
+constexpr uint32_t SpinLimit = 64;
+
+thread_local const JobSystem* tlsJobSystem = nullptr;
+thread_local uint32_t tlsWorkerIndex = JobSystem::InvalidWorkerIndex;
+
+uint32_t nextRandom(uint64_t& state) noexcept {
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<uint32_t>((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+}  // namespace
+
+//=============================================================================
+// Internal types
+//=============================================================================
+
+/// Job storage pool
+///
+/// The owning thread allocates from and frees to a plain free list. Jobs
+/// finished on other threads are pushed onto a lock-free remote list which the
+/// owner takes over in one exchange when its local list runs dry.
+struct JobSystem::JobPool {
+    static constexpr size_t ChunkSize = 256;
+
+    detail::Job* acquire(uint32_t owner) {
+        if (freeList == nullptr) {
+            freeList = remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (freeList == nullptr) {
+            grow(owner);
+        }
+        detail::Job* job = freeList;
+        freeList = job->next;
+        job->next = nullptr;
+        return job;
+    }
+
+    void releaseLocal(detail::Job* job) noexcept {
+        job->next = freeList;
+        freeList = job;
+    }
+
+    void releaseRemote(detail::Job* job) noexcept {
+        detail::Job* head = remoteFreeList.load(std::memory_order_relaxed);
+        do {
+            job->next = head;
+        } while (!remoteFreeList.compare_exchange_weak(head, job, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+    }
+
+    void grow(uint32_t owner) {
+        chunks.push_back(std::make_unique<detail::Job[]>(ChunkSize));
+        detail::Job* chunk = chunks.back().get();
+        for (size_t i = 0; i < ChunkSize; ++i) {
+            chunk[i].owner = owner;
+            chunk[i].next = (i + 1 < ChunkSize) ? &chunk[i + 1] : freeList;
+        }
+        freeList = chunk;
+    }
+
+    detail::Job* freeList = nullptr;  ///< Owner-only free list
+    /// Jobs freed by other threads
+    alignas(CacheLineSize) std::atomic<detail::Job*> remoteFreeList{nullptr};
+    std::vector<std::unique_ptr<detail::Job[]>> chunks;  ///< Backing storage (owner only)
+};
+
+/// Per-worker state
+struct JobSystem::Worker {
+    explicit Worker(size_t scratchBytes)
+        : scratch(std::make_unique<memory::FrameAllocator>(scratchBytes)) {}
+
+    WorkStealingDeque<detail::Job*> deque;
+    JobPool pool;
+    std::unique_ptr<memory::FrameAllocator> scratch;
+    std::thread thread;
+    std::string name;
+    uint64_t rngState = 0;
+};
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+JobSystem::JobSystem(const JobSystemConfig& config) : externalPool_(std::make_unique<JobPool>()) {
+    uint32_t workerCount = config.workerCount;
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    firstThreadWorker_ = config.mainThreadParticipates ? 1u : 0u;
+
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>(config.scratchBytesPerWorker);
+        worker->name =
+            (i < firstThreadWorker_) ? "Axiom Main" : "Axiom Worker " + std::to_string(i);
+        worker->rngState = 0x9E3779B97F4A7C15ULL * (i + 1);
+        workers_.push_back(std::move(worker));
+    }
+
+    if (config.mainThreadParticipates) {
+        tlsJobSystem = this;
+        tlsWorkerIndex = 0;
+    }
+
+    for (uint32_t i = firstThreadWorker_; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread([this, i] { workerMain(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_.store(true, std::memory_order_seq_cst);
+    }
+    sleepCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    if (tlsJobSystem == this) {
+        tlsJobSystem = nullptr;
+        tlsWorkerIndex = InvalidWorkerIndex;
+    }
+}
+
+uint32_t JobSystem::getCurrentWorkerIndex() const noexcept {
+    return tlsJobSystem == this ? tlsWorkerIndex : InvalidWorkerIndex;
+}
+
+//=============================================================================
+// Job lifetime
+//=============================================================================
+
+detail::Job* JobSystem::allocateJob() {
+    const uint32_t index = getCurrentWorkerIndex();
+    if (index != InvalidWorkerIndex) {
+        return workers_[index]->pool.acquire(index);
+    }
+
+    std::lock_guard<std::mutex> lock(externalMutex_);
+    return externalPool_->acquire(ExternalOwner);
+}
+
+void JobSystem::releaseJob(detail::Job* job) {
+    const uint32_t owner = job->owner;
+    if (owner == ExternalOwner) {
+        externalPool_->releaseRemote(job);
+    } else if (owner == getCurrentWorkerIndex()) {
+        workers_[owner]->pool.releaseLocal(job);
+    } else {
+        workers_[owner]->pool.releaseRemote(job);
+    }
+}
+
+void JobSystem::submit(detail::Job* job) {
+    const uint32_t index = getCurrentWorkerIndex();
+    if (index != InvalidWorkerIndex) {
+        workers_[index]->deque.push(job);
+    } else {
+        std::lock_guard<std::mutex> lock(externalMutex_);
+        injected_.push_back(job);
+        injectedCount_.fetch_add(1, std::memory_order_release);
+    }
+
+    queuedJobs_.fetch_add(1, std::memory_order_seq_cst);
+    wakeWorkers();
+}
+
+void JobSystem::execute(detail::Job* job) {
+    {
+        AXIOM_PROFILE_SCOPE("Job");
+        job->invoke(*job);
+    }
+
+    // The counter may live on the waiter's stack: decrementing it must be the last access
+    JobCounter* counter = job->counter;
+    releaseJob(job);
+    counter->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+//=============================================================================
+// Scheduling
+//=============================================================================
+
+bool JobSystem::tryRunOne(uint32_t workerIndex) {
+    detail::Job* job = nullptr;
+    if (!workers_[workerIndex]->deque.pop(job) && !tryPopInjected(job) &&
+        !trySteal(workerIndex, job)) {
+        return false;
+    }
+
+    queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+bool JobSystem::tryPopInjected(detail::Job*& out) {
+    if (injectedCount_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(externalMutex_);
+    if (injected_.empty()) {
+        return false;
+    }
+    out = injected_.front();
+    injected_.pop_front();
+    injectedCount_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::trySteal(uint32_t workerIndex, detail::Job*& out) {
+    const uint32_t count = getWorkerCount();
+    if (count <= 1) {
+        return false;
+    }
+
+    // Start at a random victim so thieves spread out instead of all hitting worker 0
+    const uint32_t start = nextRandom(workers_[workerIndex]->rngState) % count;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t victim = (start + i) % count;
+        if (victim != workerIndex && workers_[victim]->deque.steal(out)) {
+            AXIOM_METRIC_COUNTER("JobSystem.Steals", 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    const uint32_t index = getCurrentWorkerIndex();
+    uint32_t spins = 0;
+
+    while (!counter.isDone()) {
+        if (index != InvalidWorkerIndex && tryRunOne(index)) {
+            spins = 0;
+            continue;
+        }
+        if (++spins < SpinLimit) {
+            cpuRelax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerMain(uint32_t workerIndex) {
+    tlsJobSystem = this;
+    tlsWorkerIndex = workerIndex;
+    AXIOM_PROFILE_THREAD_NAME(workers_[workerIndex]->name.c_str());
+
+    uint32_t spins = 0;
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (tryRunOne(workerIndex)) {
+            spins = 0;
+            continue;
+        }
+        if (++spins < SpinLimit) {
+            cpuRelax();
+            continue;
+        }
+        sleepUntilWork();
+        spins = 0;
+    }
+}
+
+void JobSystem::sleepUntilWork() {
+    // Registering as a sleeper before re-checking queuedJobs_ pairs with submit(),
+    // which bumps queuedJobs_ before reading sleepingWorkers_ (both seq_cst), so at
+    // least one side observes the other and no wake-up is lost.
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepingWorkers_.fetch_add(1, std::memory_order_seq_cst);
+    sleepCondition_.wait(lock, [this] {
+        return stopping_.load(std::memory_order_relaxed) ||
+               queuedJobs_.load(std::memory_order_seq_cst) > 0;
+    });
+    sleepingWorkers_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void JobSystem::wakeWorkers() {
+    if (sleepingWorkers_.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCondition_.notify_one();
+}
+
+//=============================================================================
+// Scratch memory and chunking
+//=============================================================================
+
+memory::FrameAllocator& JobSystem::getScratchAllocator() {
+    const uint32_t index = getCurrentWorkerIndex();
+    AXIOM_ASSERT(index != InvalidWorkerIndex,
+                 "getScratchAllocator() must be called from a job system worker");
+    return *workers_[index]->scratch;
+}
+
+void JobSystem::flipScratchAllocators() {
+    for (auto& worker : workers_) {
+        worker->scratch->flip();
+    }
+}
+
+uint32_t JobSystem::getAutoGrainSize(uint32_t count) const noexcept {
+    // ~8 chunks per worker leaves room for stealing to even out imbalance
+    const uint32_t targetChunks = getWorkerCount() * 8u;
+    return std::max(1u, count / targetChunks);
+}
+
+}  // namespace axiom::core
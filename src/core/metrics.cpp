@@ -0,0 +1,503 @@
+#include "axiom/core/metrics.hpp"
+
+#include "axiom/core/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace axiom::core {
+
+namespace {
+
+/// Owner-only increment: shards have a single writer, so a relaxed load/store
+/// pair is enough and avoids a locked read-modify-write on the hot path
+inline void ownerAdd(std::atomic<uint64_t>& value, uint64_t delta) noexcept {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+/// Write a JSON string literal with the required escapes
+void writeJsonString(std::ostream& out, const std::string& str) {
+    out << '"';
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+                    << static_cast<int>(c) << std::dec << std::setfill(' ');
+            } else {
+                out << c;
+            }
+            break;
+        }
+    }
+    out << '"';
+}
+
+/// Write a JSON number (non-finite values become null)
+void writeJsonNumber(std::ostream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+}  // anonymous namespace
+
+//=============================================================================
+// MetricKind Utilities
+//=============================================================================
+
+const char* metricKindToString(MetricKind kind) noexcept {
+    switch (kind) {
+    case MetricKind::Counter:
+        return "counter";
+    case MetricKind::Gauge:
+        return "gauge";
+    case MetricKind::Histogram:
+        return "histogram";
+    default:
+        return "unknown";
+    }
+}
+
+//=============================================================================
+// HistogramSnapshot
+//=============================================================================
+
+size_t HistogramSnapshot::bucketIndex(double value) noexcept {
+    // Written as a negated comparison so NaN also lands in bucket 0
+    if (!(value >= std::ldexp(0.5, MinExponent))) {
+        return 0;
+    }
+
+    int exponent = 0;
+    const double mantissa = std::frexp(value, &exponent);  // value = mantissa * 2^exponent
+    if (exponent > MaxExponent) {
+        return BucketCount - 1;
+    }
+
+    // mantissa is in [0.5, 1): split that octave into SubBuckets linear slots
+    auto sub = static_cast<size_t>((mantissa - 0.5) * 2.0 * static_cast<double>(SubBuckets));
+    sub = std::min(sub, SubBuckets - 1);
+    return static_cast<size_t>(exponent - MinExponent) * SubBuckets + sub;
+}
+
+double HistogramSnapshot::bucketValue(size_t index) noexcept {
+    const int exponent = MinExponent + static_cast<int>(index / SubBuckets);
+    const double sub = static_cast<double>(index % SubBuckets);
+    const double step = 0.5 / static_cast<double>(SubBuckets);
+    return std::ldexp(0.5 + (sub + 0.5) * step, exponent);
+}
+
+double HistogramSnapshot::mean() const noexcept {
+    return count > 0 ? sum / static_cast<double>(count) : 0.0;
+}
+
+double HistogramSnapshot::percentile(double p) const noexcept {
+    if (count == 0 || buckets.empty()) {
+        return 0.0;
+    }
+    if (p <= 0.0) {
+        return min;
+    }
+    if (p >= 1.0) {
+        return max;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(count))));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= rank) {
+            return std::clamp(bucketValue(i), min, max);
+        }
+    }
+    return max;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) {
+    if (other.count == 0) {
+        return;
+    }
+
+    if (count == 0) {
+        min = other.min;
+        max = other.max;
+    } else {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+    count += other.count;
+    sum += other.sum;
+
+    if (buckets.empty()) {
+        buckets.assign(BucketCount, 0);
+    }
+    const size_t n = std::min(buckets.size(), other.buckets.size());
+    for (size_t i = 0; i < n; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+//=============================================================================
+// MetricsSnapshot
+//=============================================================================
+
+const MetricSample* MetricsSnapshot::find(const char* name) const noexcept {
+    if (!name) {
+        return nullptr;
+    }
+    for (const auto& sample : metrics_) {
+        if (sample.name == name) {
+            return &sample;
+        }
+    }
+    return nullptr;
+}
+
+const HistogramSnapshot* MetricsSnapshot::findHistogram(const char* name) const noexcept {
+    const MetricSample* sample = find(name);
+    if (!sample || sample->kind != MetricKind::Histogram) {
+        return nullptr;
+    }
+    return &sample->histogram;
+}
+
+void MetricsSnapshot::writeText(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    for (const auto& sample : metrics_) {
+        out << sample.name << " [" << metricKindToString(sample.kind) << "] ";
+        switch (sample.kind) {
+        case MetricKind::Counter:
+            out << sample.counter;
+            break;
+        case MetricKind::Gauge:
+            out << sample.gauge;
+            break;
+        case MetricKind::Histogram: {
+            const HistogramSnapshot& h = sample.histogram;
+            out << "count=" << h.count << " mean=" << h.mean() << " min=" << h.min
+                << " p50=" << h.p50() << " p95=" << h.p95() << " p99=" << h.p99()
+                << " max=" << h.max;
+            break;
+        }
+        }
+        out << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void MetricsSnapshot::writeJson(std::ostream& out) const {
+    const auto precision = out.precision();
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    out << "{";
+    for (size_t i = 0; i < metrics_.size(); ++i) {
+        const MetricSample& sample = metrics_[i];
+        out << (i == 0 ? "\n  " : ",\n  ");
+        writeJsonString(out, sample.name);
+        out << ": {\"kind\": \"" << metricKindToString(sample.kind) << "\"";
+        switch (sample.kind) {
+        case MetricKind::Counter:
+            out << ", \"value\": " << sample.counter;
+            break;
+        case MetricKind::Gauge:
+            out << ", \"value\": ";
+            writeJsonNumber(out, sample.gauge);
+            break;
+        case MetricKind::Histogram: {
+            const HistogramSnapshot& h = sample.histogram;
+            out << ", \"count\": " << h.count << ", \"sum\": ";
+            writeJsonNumber(out, h.sum);
+            out << ", \"min\": ";
+            writeJsonNumber(out, h.min);
+            out << ", \"mean\": ";
+            writeJsonNumber(out, h.mean());
+            out << ", \"p50\": ";
+            writeJsonNumber(out, h.p50());
+            out << ", \"p95\": ";
+            writeJsonNumber(out, h.p95());
+            out << ", \"p99\": ";
+            writeJsonNumber(out, h.p99());
+            out << ", \"max\": ";
+            writeJsonNumber(out, h.max);
+            break;
+        }
+        }
+        out << "}";
+    }
+    out << (metrics_.empty() ? "}" : "\n}") << "\n";
+
+    out.precision(precision);
+}
+
+//=============================================================================
+// MetricsRegistry - shards
+//=============================================================================
+
+/// Per-thread histogram storage (allocated on first record from that thread)
+struct MetricsRegistry::HistogramShard {
+    std::atomic<uint64_t> count{0};
+    std::atomic<double> sum{0.0};
+    std::atomic<double> min{std::numeric_limits<double>::infinity()};
+    std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+    std::atomic<uint64_t> buckets[HistogramSnapshot::BucketCount] = {};
+
+    void clear() noexcept {
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0.0, std::memory_order_relaxed);
+        min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/// Per-thread metric storage, written only by the thread currently leasing it
+struct alignas(64) MetricsRegistry::Shard {
+    std::atomic<uint64_t> counters[MaxMetrics] = {};
+    std::atomic<HistogramShard*> histograms[MaxMetrics] = {};
+    bool leased = false;  ///< Guarded by MetricsRegistry::mutex_
+
+    ~Shard() {
+        for (auto& histogram : histograms) {
+            delete histogram.load(std::memory_order_relaxed);
+        }
+    }
+};
+
+/// Thread-local lease that returns the shard to the registry on thread exit
+struct MetricsRegistry::ShardLease {
+    MetricsRegistry* registry = nullptr;
+    Shard* shard = nullptr;
+
+    ~ShardLease() {
+        if (registry && shard) {
+            registry->releaseShard(shard);
+        }
+    }
+};
+
+MetricsRegistry::MetricsRegistry()
+    : gauges_(std::make_unique<std::atomic<double>[]>(MaxMetrics)) {
+    // Reserve up front so kinds_ never reallocates under lock-free readers
+    names_.reserve(MaxMetrics);
+    kinds_.reserve(MaxMetrics);
+}
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry& MetricsRegistry::getInstance() noexcept {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::Shard& MetricsRegistry::localShard() noexcept {
+    thread_local ShardLease lease;
+    if (!lease.shard) {
+        lease.registry = this;
+        lease.shard = acquireShard();
+    }
+    return *lease.shard;
+}
+
+MetricsRegistry::Shard* MetricsRegistry::acquireShard() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Reuse a shard left behind by an exited thread
+    for (auto& shard : shards_) {
+        if (!shard->leased) {
+            shard->leased = true;
+            return shard.get();
+        }
+    }
+
+    shards_.push_back(std::make_unique<Shard>());
+    shards_.back()->leased = true;
+    return shards_.back().get();
+}
+
+void MetricsRegistry::releaseShard(Shard* shard) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shard->leased = false;
+}
+
+MetricsRegistry::HistogramShard& MetricsRegistry::localHistogram(Shard& shard,
+                                                                 MetricId id) noexcept {
+    HistogramShard* histogram = shard.histograms[id].load(std::memory_order_relaxed);
+    if (!histogram) {
+        // Published with release so snapshot() sees a fully constructed object
+        histogram = new HistogramShard();
+        shard.histograms[id].store(histogram, std::memory_order_release);
+    }
+    return *histogram;
+}
+
+//=============================================================================
+// MetricsRegistry - registration and updates
+//=============================================================================
+
+MetricId MetricsRegistry::registerMetric(const char* name, MetricKind kind) {
+    if (!name) {
+        return InvalidMetricId;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (names_[i] == name) {
+            AXIOM_ASSERT(kinds_[i] == kind, "Metric re-registered with a different kind");
+            return kinds_[i] == kind ? static_cast<MetricId>(i) : InvalidMetricId;
+        }
+    }
+
+    if (names_.size() >= MaxMetrics) {
+        return InvalidMetricId;
+    }
+
+    names_.emplace_back(name);
+    kinds_.push_back(kind);
+    const auto id = static_cast<MetricId>(names_.size() - 1);
+    metricCount_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+size_t MetricsRegistry::getMetricCount() const noexcept {
+    return metricCount_.load(std::memory_order_acquire);
+}
+
+void MetricsRegistry::add(MetricId id, uint64_t delta) noexcept {
+    if (id >= MaxMetrics) {
+        return;
+    }
+    AXIOM_ASSERT(id < getMetricCount() && kinds_[id] == MetricKind::Counter,
+                 "Metric is not a registered counter");
+    ownerAdd(localShard().counters[id], delta);
+}
+
+void MetricsRegistry::set(MetricId id, double value) noexcept {
+    if (id >= MaxMetrics) {
+        return;
+    }
+    AXIOM_ASSERT(id < getMetricCount() && kinds_[id] == MetricKind::Gauge,
+                 "Metric is not a registered gauge");
+    gauges_[id].store(value, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::record(MetricId id, double value) noexcept {
+    if (id >= MaxMetrics) {
+        return;
+    }
+    AXIOM_ASSERT(id < getMetricCount() && kinds_[id] == MetricKind::Histogram,
+                 "Metric is not a registered histogram");
+
+    HistogramShard& h = localHistogram(localShard(), id);
+    ownerAdd(h.buckets[HistogramSnapshot::bucketIndex(value)], 1);
+    h.sum.store(h.sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value < h.min.load(std::memory_order_relaxed)) {
+        h.min.store(value, std::memory_order_relaxed);
+    }
+    if (value > h.max.load(std::memory_order_relaxed)) {
+        h.max.store(value, std::memory_order_relaxed);
+    }
+    ownerAdd(h.count, 1);
+}
+
+//=============================================================================
+// MetricsRegistry - snapshot and reset
+//=============================================================================
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    MetricsSnapshot result;
+    result.metrics_.resize(names_.size());
+
+    for (size_t id = 0; id < names_.size(); ++id) {
+        MetricSample& sample = result.metrics_[id];
+        sample.name = names_[id];
+        sample.kind = kinds_[id];
+
+        switch (sample.kind) {
+        case MetricKind::Counter:
+            for (const auto& shard : shards_) {
+                sample.counter += shard->counters[id].load(std::memory_order_relaxed);
+            }
+            break;
+
+        case MetricKind::Gauge:
+            sample.gauge = gauges_[id].load(std::memory_order_relaxed);
+            break;
+
+        case MetricKind::Histogram:
+            for (const auto& shard : shards_) {
+                const HistogramShard* h = shard->histograms[id].load(std::memory_order_acquire);
+                if (!h) {
+                    continue;
+                }
+                const uint64_t count = h->count.load(std::memory_order_relaxed);
+                if (count == 0) {
+                    continue;
+                }
+
+                HistogramSnapshot part;
+                part.count = count;
+                part.sum = h->sum.load(std::memory_order_relaxed);
+                part.min = h->min.load(std::memory_order_relaxed);
+                part.max = h->max.load(std::memory_order_relaxed);
+                part.buckets.resize(HistogramSnapshot::BucketCount);
+                for (size_t b = 0; b < HistogramSnapshot::BucketCount; ++b) {
+                    part.buckets[b] = h->buckets[b].load(std::memory_order_relaxed);
+                }
+                sample.histogram.merge(part);
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+void MetricsRegistry::reset() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t id = 0; id < MaxMetrics; ++id) {
+        gauges_[id].store(0.0, std::memory_order_relaxed);
+    }
+
+    for (auto& shard : shards_) {
+        for (auto& counter : shard->counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto& histogram : shard->histograms) {
+            if (HistogramShard* h = histogram.load(std::memory_order_acquire)) {
+                h->clear();
+            }
+        }
+    }
+}
+
+}  // namespace axiom::core
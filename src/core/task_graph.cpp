@@ -0,0 +1,337 @@
+#include "axiom/core/task_graph.hpp"
+
+#include "axiom/core/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace axiom::core {
+
+namespace {
+
+constexpr size_t StageCount = static_cast<size_t>(TaskStage::Count);
+
+/// Histogram each stage's per-frame time is recorded into
+const char* stageMetricName(TaskStage stage) noexcept {
+    switch (stage) {
+    case TaskStage::Broadphase:
+        return metric_names::BroadphaseTime;
+    case TaskStage::Narrowphase:
+        return metric_names::NarrowphaseTime;
+    case TaskStage::Solver:
+        return metric_names::SolverTime;
+    case TaskStage::Integration:
+        return metric_names::IntegrationTime;
+    case TaskStage::None:
+    case TaskStage::Count:
+        break;
+    }
+    return nullptr;
+}
+
+float nanosecondsToMs(uint64_t ns) noexcept {
+    return static_cast<float>(static_cast<double>(ns) * 1e-6);
+}
+
+}  // namespace
+
+const char* taskStageToString(TaskStage stage) noexcept {
+    switch (stage) {
+    case TaskStage::None:
+        return "None";
+    case TaskStage::Broadphase:
+        return "Broadphase";
+    case TaskStage::Narrowphase:
+        return "Narrowphase";
+    case TaskStage::Solver:
+        return "Solver";
+    case TaskStage::Integration:
+        return "Integration";
+    case TaskStage::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+//=============================================================================
+// TaskContext / TaskNodeBuilder
+//=============================================================================
+
+void* TaskContext::lookup(uint32_t resource, bool write) const {
+    bool declared = false;
+    for (const auto& access : graph_->nodes_[node_]->accesses) {
+        if (access.resource == resource) {
+            declared = !write || access.write;
+            break;
+        }
+    }
+    AXIOM_ASSERT(declared,
+                 "Task accessed a resource it did not declare (or wrote a read-only one)");
+    (void)declared;
+    return graph_->resources_[resource].data;
+}
+
+TaskNodeBuilder& TaskNodeBuilder::stage(TaskStage stage) {
+    AXIOM_ASSERT(stage != TaskStage::Count, "TaskStage::Count is not a valid stage");
+    graph_->nodes_[node_]->stage = stage;
+    return *this;
+}
+
+TaskNodeBuilder& TaskNodeBuilder::overlapsNextFrame() {
+    graph_->nodes_[node_]->tail = true;
+    return *this;
+}
+
+void TaskNodeBuilder::addAccess(uint32_t resource, bool write) {
+    AXIOM_ASSERT(!graph_->compiled_, "Accesses must be declared before compile()");
+    AXIOM_ASSERT(resource < graph_->resources_.size(), "Invalid task resource");
+
+    auto& accesses = graph_->nodes_[node_]->accesses;
+    for (auto& access : accesses) {
+        if (access.resource == resource) {
+            access.write = access.write || write;
+            return;
+        }
+    }
+    accesses.push_back({resource, write});
+}
+
+//=============================================================================
+// Graph construction
+//=============================================================================
+
+TaskGraph::TaskGraph() = default;
+
+TaskGraph::~TaskGraph() {
+    AXIOM_ASSERT(jobs_.isDone(), "TaskGraph destroyed while nodes are running - call waitIdle()");
+}
+
+TaskNodeBuilder TaskGraph::addNode(const char* name, TaskFunction fn) {
+    AXIOM_ASSERT(!compiled_, "Nodes must be added before compile()");
+    auto node = std::make_unique<Node>();
+    node->name = name;
+    node->fn = std::move(fn);
+    nodes_.push_back(std::move(node));
+    return TaskNodeBuilder(*this, static_cast<uint32_t>(nodes_.size() - 1));
+}
+
+bool TaskGraph::conflicts(const Node& a, const Node& b) noexcept {
+    for (const auto& x : a.accesses) {
+        for (const auto& y : b.accesses) {
+            if (x.resource == y.resource && (x.write || y.write)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TaskGraph::addEdge(std::vector<uint32_t>& edges, uint32_t to) {
+    if (std::find(edges.begin(), edges.end(), to) == edges.end()) {
+        edges.push_back(to);
+    }
+}
+
+Result<void> TaskGraph::compile() {
+    AXIOM_ASSERT(!compiled_, "TaskGraph is already compiled");
+
+    for (auto& node : nodes_) {
+        node->successors.clear();
+        node->nextFrameSuccessors.clear();
+        node->predecessorCount = 0;
+        node->previousFramePredecessorCount = 0;
+    }
+
+    // Same-frame edges, derived in declaration order
+    std::vector<int64_t> lastWriter(resources_.size(), -1);
+    std::vector<std::vector<uint32_t>> readersSinceWrite(resources_.size());
+
+    for (uint32_t n = 0; n < nodes_.size(); ++n) {
+        for (const auto& access : nodes_[n]->accesses) {
+            const int64_t writer = lastWriter[access.resource];
+            auto& readers = readersSinceWrite[access.resource];
+
+            if (!access.write) {
+                // Read after write
+                if (writer >= 0) {
+                    addEdge(nodes_[static_cast<size_t>(writer)]->successors, n);
+                }
+                readers.push_back(n);
+                continue;
+            }
+
+            if (!readers.empty()) {
+                // Write after read (the readers already follow the previous writer)
+                for (uint32_t reader : readers) {
+                    addEdge(nodes_[reader]->successors, n);
+                }
+            } else if (writer >= 0) {
+                // Write after write
+                addEdge(nodes_[static_cast<size_t>(writer)]->successors, n);
+            }
+            lastWriter[access.resource] = n;
+            readers.clear();
+        }
+    }
+
+    for (const auto& node : nodes_) {
+        for (uint32_t successor : node->successors) {
+            if (node->tail && !nodes_[successor]->tail) {
+                return Result<void>::failure(ErrorCode::InvalidParameter,
+                                             "Frame-head task depends on an overlapping task");
+            }
+            ++nodes_[successor]->predecessorCount;
+        }
+    }
+
+    // Cross-frame edges: next-frame nodes wait for conflicting tail nodes (and a tail
+    // node for its own previous instance)
+    headNodeCount_ = 0;
+    tailNodeCount_ = 0;
+    for (uint32_t t = 0; t < nodes_.size(); ++t) {
+        Node& tail = *nodes_[t];
+        if (!tail.tail) {
+            ++headNodeCount_;
+            continue;
+        }
+        ++tailNodeCount_;
+        for (uint32_t n = 0; n < nodes_.size(); ++n) {
+            if (n == t || conflicts(tail, *nodes_[n])) {
+                tail.nextFrameSuccessors.push_back(n);
+                ++nodes_[n]->previousFramePredecessorCount;
+            }
+        }
+    }
+
+#ifdef AXIOM_ENABLE_METRICS
+    auto& registry = MetricsRegistry::getInstance();
+    stepMetric_ = registry.registerHistogram(metric_names::StepTime);
+    for (size_t s = 0; s < StageCount; ++s) {
+        const char* metricName = stageMetricName(static_cast<TaskStage>(s));
+        stageMetrics_[s] = metricName ? registry.registerHistogram(metricName) : InvalidMetricId;
+    }
+#else
+    stageMetrics_.fill(InvalidMetricId);
+#endif
+
+    compiled_ = true;
+    return Result<void>::success();
+}
+
+//=============================================================================
+// Execution
+//=============================================================================
+
+void TaskGraph::execute(JobSystem& jobs) {
+    AXIOM_PROFILE_SCOPE("TaskGraph::execute");
+    AXIOM_ASSERT(compiled_, "TaskGraph::execute() called before a successful compile()");
+    AXIOM_ASSERT(jobSystem_ == nullptr || jobSystem_ == &jobs,
+                 "TaskGraph must run on the same JobSystem every frame");
+    if (jobSystem_ == nullptr) {
+        jobSystem_ = &jobs;
+    }
+
+    const uint64_t frame = frameCount_;
+    FrameSlot& slot = slots_[frame % FrameSlots];
+
+    // This frame's tail decrements the counters of frame N+1, whose slot is shared
+    // with frame N-2: the tail of frame N-2 must be done before frame N starts
+    if (frame >= FrameSlots - 1) {
+        jobs.wait(slots_[(frame + 1) % FrameSlots].tail);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (auto& stageNs : slot.stageNs) {
+        stageNs.store(0, std::memory_order_relaxed);
+    }
+    slot.head.add(headNodeCount_);
+    slot.tail.add(tailNodeCount_);
+
+    // Prime the dependency counters. Counters are only ever added to or subtracted
+    // from, and whoever brings one to zero launches the node - so predecessors that
+    // finish while priming is still in progress are handled without locks.
+    const bool hasPreviousFrame = frame > 0;
+    for (uint32_t n = 0; n < nodes_.size(); ++n) {
+        Node& node = *nodes_[n];
+        const int32_t dependencies =
+            node.predecessorCount + (hasPreviousFrame ? node.previousFramePredecessorCount : 0);
+        auto& remaining = node.remaining[frame % FrameSlots];
+        if (remaining.fetch_add(dependencies, std::memory_order_acq_rel) + dependencies == 0) {
+            launch(n, frame);
+        }
+    }
+
+    jobs.wait(slot.head);
+
+    const auto end = std::chrono::steady_clock::now();
+
+    TaskGraphTimings timings;
+    timings.frame = frame;
+    timings.totalMs = std::chrono::duration<float, std::milli>(end - start).count();
+    for (size_t s = 0; s < StageCount; ++s) {
+        timings.stageMs[s] = nanosecondsToMs(slot.stageNs[s].load(std::memory_order_relaxed));
+    }
+    lastTimings_ = timings;
+
+    auto& registry = MetricsRegistry::getInstance();
+    registry.record(stepMetric_, static_cast<double>(timings.totalMs));
+    for (size_t s = 0; s < StageCount; ++s) {
+        registry.record(stageMetrics_[s], static_cast<double>(timings.stageMs[s]));
+    }
+
+    ++frameCount_;
+}
+
+void TaskGraph::waitIdle(JobSystem& jobs) {
+    jobs.wait(jobs_);
+}
+
+void TaskGraph::launch(uint32_t node, uint64_t frame) {
+    jobSystem_->run(jobs_, [this, node, frame] { runNode(node, frame); });
+}
+
+void TaskGraph::runNode(uint32_t index, uint64_t frame) {
+    Node& node = *nodes_[index];
+    FrameSlot& slot = slots_[frame % FrameSlots];
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        AXIOM_PROFILE_SCOPE("TaskGraph node");
+        AXIOM_PROFILE_TAG("Task", node.name);
+        TaskContext context(*this, index, *jobSystem_, frame);
+        node.fn(context);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto elapsedNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    node.lastTimeMs.store(nanosecondsToMs(elapsedNs), std::memory_order_relaxed);
+    if (!node.tail && node.stage != TaskStage::None) {
+        slot.stageNs[static_cast<size_t>(node.stage)].fetch_add(elapsedNs,
+                                                               std::memory_order_relaxed);
+    }
+
+    for (uint32_t successor : node.successors) {
+        auto& remaining = nodes_[successor]->remaining[frame % FrameSlots];
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launch(successor, frame);
+        }
+    }
+    for (uint32_t successor : node.nextFrameSuccessors) {
+        auto& remaining = nodes_[successor]->remaining[(frame + 1) % FrameSlots];
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launch(successor, frame + 1);
+        }
+    }
+
+    // Publishes stageNs to execute(), which acquires through JobSystem::wait()
+    if (node.tail) {
+        slot.tail.release();
+    } else {
+        slot.head.release();
+    }
+}
+
+}  // namespace axiom::core
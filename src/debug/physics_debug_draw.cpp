@@ -1,12 +1,36 @@
 #include "axiom/debug/physics_debug_draw.hpp"
 
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/shape.hpp"
 #include "axiom/math/constants.hpp"
 #include "axiom/math/quat.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 namespace axiom::debug {
 
+namespace {
+
+constexpr bool matches(ShapeType debugType, collision::ShapeType collisionType) {
+    return static_cast<uint32_t>(debugType) == static_cast<uint32_t>(collisionType);
+}
+
+// debug::ShapeType mirrors collision::ShapeType value for value
+static_assert(matches(ShapeType::Sphere, collision::ShapeType::Sphere));
+static_assert(matches(ShapeType::Box, collision::ShapeType::Box));
+static_assert(matches(ShapeType::Capsule, collision::ShapeType::Capsule));
+static_assert(matches(ShapeType::Plane, collision::ShapeType::Plane));
+static_assert(matches(ShapeType::Convex, collision::ShapeType::Convex));
+static_assert(matches(ShapeType::Mesh, collision::ShapeType::Mesh));
+static_assert(matches(ShapeType::HeightField, collision::ShapeType::HeightField));
+static_assert(matches(ShapeType::DistanceField, collision::ShapeType::DistanceField));
+static_assert(matches(ShapeType::Compound, collision::ShapeType::Compound));
+static_assert(static_cast<uint32_t>(ShapeType::Compound) + 1 == collision::ShapeTypeCount,
+              "debug::ShapeType is missing a collision shape type");
+
+}  // namespace
+
 PhysicsDebugDraw::PhysicsDebugDraw(DebugDraw* debugDraw, const PhysicsDebugDrawConfig& config)
     : debugDraw_(debugDraw), config_(config) {}
 
@@ -77,10 +101,14 @@ void PhysicsDebugDraw::drawCollisionShape(const DebugShape& shape, const math::V
         drawPlane(shape, color);
         break;
     case ShapeType::Convex:
+    case ShapeType::Mesh:
+    case ShapeType::HeightField:
+    case ShapeType::DistanceField:
+        // All are drawn as the edges of their triangles
         drawConvexHull(shape, color);
         break;
-    case ShapeType::Mesh:
-        // Mesh rendering not yet implemented (would need triangle edges)
+    case ShapeType::Compound:
+        // Nothing of its own: the children are passed as separate shapes
         break;
     }
 }
@@ -115,6 +143,16 @@ void PhysicsDebugDraw::drawContactPoint(const DebugContactPoint& contact) {
     }
 }
 
+void PhysicsDebugDraw::drawContactManifold(const collision::PersistentManifold& manifold) {
+    for (const collision::ManifoldPoint& point : manifold.getPoints()) {
+        DebugContactPoint contact;
+        contact.position = point.pointB;
+        contact.normal = manifold.getNormal();
+        contact.penetrationDepth = std::max(-point.separation, 0.0f);
+        drawContactPoint(contact);
+    }
+}
+
 void PhysicsDebugDraw::drawConstraint(const DebugConstraint& constraint) {
     if (!hasFlag(config_.flags, PhysicsDebugFlags::Constraints)) {
         return;
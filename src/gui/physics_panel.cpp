@@ -23,6 +23,38 @@ void toggleDebugFlag(debug::PhysicsDebugFlags& flags, debug::PhysicsDebugFlags f
 
 }  // namespace
 
+// Fill distribution fields from the metrics registry
+void applyMetrics(const core::MetricsSnapshot& snapshot, PhysicsWorldStats& stats) {
+    const core::HistogramSnapshot* step = snapshot.findHistogram(core::metric_names::StepTime);
+    if (step != nullptr && step->count > 0) {
+        stats.stepSampleCount = step->count;
+        stats.stepTimeP50 = static_cast<float>(step->p50());
+        stats.stepTimeP95 = static_cast<float>(step->p95());
+        stats.stepTimeP99 = static_cast<float>(step->p99());
+        stats.stepTimeMax = static_cast<float>(step->max);
+    }
+
+    const core::HistogramSnapshot* pairs =
+        snapshot.findHistogram(core::metric_names::BroadphasePairs);
+    if (pairs != nullptr && pairs->count > 0) {
+        stats.broadphasePairsP50 = static_cast<uint32_t>(pairs->p50());
+        stats.broadphasePairsP99 = static_cast<uint32_t>(pairs->p99());
+        stats.broadphasePairsMax = static_cast<uint32_t>(pairs->max);
+    }
+}
+
+void applyTaskGraphTimings(const core::TaskGraphTimings& timings, PhysicsWorldStats& stats) {
+    stats.totalStepTime = timings.totalMs;
+    stats.broadphaseTime = timings.getStageMs(core::TaskStage::Broadphase);
+    stats.narrowphaseTime = timings.getStageMs(core::TaskStage::Narrowphase);
+    stats.solverTime = timings.getStageMs(core::TaskStage::Solver);
+    stats.integrationTime = timings.getStageMs(core::TaskStage::Integration);
+}
+
+void applyContactManifolds(const collision::OverlappingPairCache& pairs, PhysicsWorldStats& stats) {
+    stats.contactPointCount = pairs.getContactPointCount();
+}
+
 // Constructor
 PhysicsDebugPanel::PhysicsDebugPanel() = default;
 
@@ -347,6 +379,22 @@ void PhysicsDebugPanel::renderPerformanceSection(const PhysicsWorldStats& stats)
         ImGui::Text("Integration (%.1f%%)", static_cast<double>(integrationPercent * 100.0f));
     }
 
+    // Long-running distributions from the metrics registry
+    if (stats.stepSampleCount > 0) {
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Text("Step Time (%llu steps):",
+                    static_cast<unsigned long long>(stats.stepSampleCount));
+        ImGui::Indent();
+        ImGui::Text("p50: %.2f ms", static_cast<double>(stats.stepTimeP50));
+        ImGui::Text("p95: %.2f ms", static_cast<double>(stats.stepTimeP95));
+        ImGui::Text("p99: %.2f ms", static_cast<double>(stats.stepTimeP99));
+        ImGui::Text("max: %.2f ms", static_cast<double>(stats.stepTimeMax));
+        ImGui::Unindent();
+        ImGui::Text("Broadphase Pairs: p50 %u / p99 %u / max %u", stats.broadphasePairsP50,
+                    stats.broadphasePairsP99, stats.broadphasePairsMax);
+    }
+
     ImGui::Unindent();
 }
 
@@ -0,0 +1,587 @@
+#include "axiom/collision/collision_layers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+using PairSet = std::set<std::pair<ProxyId, ProxyId>>;
+
+AABB boxAt(const Vec3& center, float halfExtent = 0.5f) {
+    return AABB::fromCenterExtents(center, Vec3(halfExtent));
+}
+
+CollisionFilter makeFilter(uint32_t category, uint32_t mask, int16_t group = 0) {
+    CollisionFilter filter;
+    filter.categoryBits = category;
+    filter.maskBits = mask;
+    filter.groupIndex = group;
+    return filter;
+}
+
+PairSet collectPairs(LayeredBroadphase& broadphase) {
+    PairSet pairs;
+    const size_t reported = broadphase.updatePairs([&](ProxyId a, ProxyId b) {
+        EXPECT_LT(a, b);
+        EXPECT_TRUE(pairs.emplace(a, b).second) << "Duplicate pair " << a << ", " << b;
+    });
+    EXPECT_EQ(reported, pairs.size());
+    return pairs;
+}
+
+/// Every overlapping pair the layer pairs and filters allow, as (a, b) with
+/// a < b; or, with triggers set, only those involving a trigger, as (trigger, other)
+PairSet bruteForcePairs(const LayeredBroadphase& broadphase, const std::vector<ProxyId>& ids,
+                        bool triggers = false) {
+    PairSet pairs;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            ProxyId a = std::min(ids[i], ids[j]);
+            ProxyId b = std::max(ids[i], ids[j]);
+            const bool triggerA = broadphase.getLayer(a) == CollisionLayer::Trigger;
+            const bool triggerB = broadphase.getLayer(b) == CollisionLayer::Trigger;
+            if ((triggerA || triggerB) != triggers ||
+                !broadphase.getLayerPairs().isEnabled(broadphase.getLayer(a),
+                                                      broadphase.getLayer(b)) ||
+                !shouldCollide(broadphase.getFilter(a), broadphase.getFilter(b)) ||
+                !broadphase.getAABB(a).intersects(broadphase.getAABB(b))) {
+                continue;
+            }
+            if (triggers && !triggerA) {
+                std::swap(a, b);
+            }
+            pairs.emplace(a, b);
+        }
+    }
+    return pairs;
+}
+
+/// Apply the trigger events of the last update to a set of (trigger, other) overlaps
+void applyTriggerEvents(const LayeredBroadphase& broadphase, PairSet& overlaps) {
+    for (const TriggerEvent& event : broadphase.getTriggerEvents()) {
+        if (event.type == TriggerEventType::Enter) {
+            EXPECT_TRUE(overlaps.emplace(event.trigger, event.other).second)
+                << "Enter twice " << event.trigger << ", " << event.other;
+        } else {
+            EXPECT_EQ(overlaps.erase({event.trigger, event.other}), 1u)
+                << "Exit without enter " << event.trigger << ", " << event.other;
+        }
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Filters and layer pairs
+// ============================================================================
+
+TEST(CollisionLayersTest, ShouldCollideFollowsFilterRules) {
+    const CollisionFilter defaults;
+    EXPECT_TRUE(shouldCollide(defaults, defaults));
+
+    // Category must be in the other's mask, both ways
+    EXPECT_FALSE(shouldCollide(makeFilter(0x1, 0x2), makeFilter(0x2, 0x2)));
+    EXPECT_TRUE(shouldCollide(makeFilter(0x1, 0x2), makeFilter(0x2, 0x1)));
+
+    // A shared group overrides the masks
+    EXPECT_TRUE(shouldCollide(makeFilter(0x1, 0x0, 3), makeFilter(0x1, 0x0, 3)));
+    EXPECT_FALSE(shouldCollide(makeFilter(0x1, 0xFFFF, -3), makeFilter(0x1, 0xFFFF, -3)));
+    EXPECT_TRUE(shouldCollide(makeFilter(0x1, 0xFFFF, -3), makeFilter(0x1, 0xFFFF, -4)));
+}
+
+TEST(CollisionLayersTest, DefaultLayerPairs) {
+    using enum CollisionLayer;
+    constexpr LayerPairMatrix matrix = LayerPairMatrix::defaults();
+
+    static_assert(!matrix.isEnabled(Static, Static));
+    static_assert(!matrix.isEnabled(Debris, Debris));
+    static_assert(matrix.isEnabled(Dynamic, Dynamic));
+    static_assert(matrix.isEnabled(Debris, Static) && matrix.isEnabled(Static, Debris));
+    EXPECT_EQ(matrix.getMask(Debris), layerBit(Static) | layerBit(Dynamic));
+
+    LayerPairMatrix custom = matrix;
+    custom.enable(Static, Static);
+    custom.enable(Debris, Debris);
+    custom.enable(Dynamic, Trigger, false);
+    EXPECT_FALSE(custom.isEnabled(Static, Static));
+    EXPECT_TRUE(custom.isEnabled(Debris, Debris));
+    EXPECT_FALSE(custom.isEnabled(Trigger, Dynamic));
+}
+
+// ============================================================================
+// Pairs
+// ============================================================================
+
+TEST(CollisionLayersTest, PairsMatchFilteredBruteForce) {
+    constexpr std::array<BroadphaseKind, 3> Kinds = {BroadphaseKind::DynamicAABBTree,
+                                                      BroadphaseKind::SweepAndPrune,
+                                                      BroadphaseKind::UniformGrid};
+
+    for (const BroadphaseKind kind : Kinds) {
+        LayeredBroadphaseConfig config;
+        config.structures.fill(kind);
+        config.layerPairs.enable(CollisionLayer::Projectile, CollisionLayer::Projectile);
+        config.layerPairs.enable(CollisionLayer::Trigger, CollisionLayer::Trigger);
+        LayeredBroadphase broadphase(config);
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> size(0.2f, 1.5f);
+        std::uniform_int_distribution<uint32_t> layer(0, CollisionLayerCount - 1);
+        std::uniform_int_distribution<uint32_t> bits(1, 15);
+        std::uniform_int_distribution<int> group(-2, 2);
+
+        std::vector<ProxyId> ids;
+        for (uint64_t i = 0; i < 800; ++i) {
+            const Vec3 center(position(rng), position(rng), position(rng));
+            const CollisionFilter filter =
+                makeFilter(bits(rng), bits(rng), static_cast<int16_t>(group(rng)));
+            ids.push_back(broadphase.createProxy(static_cast<CollisionLayer>(layer(rng)),
+                                                 boxAt(center, size(rng)), filter, i));
+        }
+
+        const PairSet pairs = collectPairs(broadphase);
+        EXPECT_FALSE(pairs.empty());
+        EXPECT_EQ(pairs, bruteForcePairs(broadphase, ids)) << "kind " << static_cast<int>(kind);
+        EXPECT_GE(broadphase.getStats().candidatePairs, pairs.size());
+
+        PairSet overlaps;
+        applyTriggerEvents(broadphase, overlaps);
+        EXPECT_FALSE(overlaps.empty());
+        EXPECT_EQ(overlaps, bruteForcePairs(broadphase, ids, true));
+    }
+}
+
+TEST(CollisionLayersTest, StaticGeometryIsNeverTestedAgainstItself) {
+    LayeredBroadphase broadphase;
+    std::vector<ProxyId> ids;
+
+    // A floor of heavily overlapping tiles with one body resting on it
+    for (int x = 0; x < 20; ++x) {
+        for (int z = 0; z < 20; ++z) {
+            const Vec3 center(static_cast<float>(x), 0.0f, static_cast<float>(z));
+            ids.push_back(broadphase.createProxy(CollisionLayer::Static, boxAt(center, 0.8f),
+                                                 {}, 0));
+        }
+    }
+    const ProxyId body =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(5, 1, 5)), {}, 0);
+
+    const PairSet pairs = collectPairs(broadphase);
+    EXPECT_EQ(pairs.size(), 9u);  // The 3 x 3 tiles under the body
+    for (const auto& [a, b] : pairs) {
+        EXPECT_TRUE(a == body || b == body);
+    }
+    EXPECT_EQ(broadphase.getStats().candidatePairs, 9u);
+}
+
+TEST(CollisionLayersTest, MaskedLayersAreNotQueried) {
+    LayeredBroadphase broadphase;
+    const CollisionFilter world = makeFilter(0x1, 0xFFFF);
+    const CollisionFilter ghost = makeFilter(0x2, 0x2);  // Ignores the world
+
+    broadphase.createProxy(CollisionLayer::Static, boxAt(Vec3::zero(), 10.0f), world, 0);
+    const ProxyId a =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3::zero()), ghost, 1);
+    const ProxyId b =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(0.5f, 0, 0)), ghost, 2);
+
+    EXPECT_EQ(collectPairs(broadphase), (PairSet{{a, b}}));
+    EXPECT_EQ(broadphase.getStats().skippedQueries, 2u);
+
+    // A positive group shared with the world overrides the masks
+    broadphase.setFilter(a, makeFilter(0x2, 0x2, 1));
+    const ProxyId ground = broadphase.createProxy(CollisionLayer::Static, boxAt(Vec3(0, -1, 0)),
+                                                  makeFilter(0x1, 0x1, 1), 3);
+    const PairSet pairs = collectPairs(broadphase);
+    EXPECT_TRUE(pairs.contains({std::min(a, ground), std::max(a, ground)}));
+    EXPECT_EQ(broadphase.getStats().skippedQueries, 1u);  // b still skips
+}
+
+TEST(CollisionLayersTest, MovesFiltersAndDestroys) {
+    LayeredBroadphase broadphase;
+    const ProxyId floor =
+        broadphase.createProxy(CollisionLayer::Static, AABB(Vec3(-10, -1, -10), Vec3(10, 0, 10)),
+                               {}, 0);
+    const ProxyId crate =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(0, 0.4f, 0)), {}, 1);
+    const ProxyId pebble =
+        broadphase.createProxy(CollisionLayer::Debris, boxAt(Vec3(0.5f, 0.1f, 0), 0.2f), {}, 2);
+    EXPECT_EQ(broadphase.getProxyCount(), 3u);
+    EXPECT_EQ(broadphase.getProxyCount(CollisionLayer::Debris), 1u);
+
+    EXPECT_EQ(collectPairs(broadphase),
+              (PairSet{{floor, crate}, {floor, pebble}, {crate, pebble}}));
+
+    // Lifted out of reach: the fat tree bounds must not leak through
+    broadphase.moveProxy(crate, boxAt(Vec3(0, 0.55f, 0)), Vec3(0, 0.15f, 0));
+    broadphase.moveProxy(pebble, boxAt(Vec3(3, 0.1f, 0), 0.2f), Vec3(2.5f, 0, 0));
+    EXPECT_EQ(collectPairs(broadphase), (PairSet{{floor, pebble}}));
+
+    broadphase.setFilter(pebble, makeFilter(0x4, 0x2));
+    EXPECT_TRUE(collectPairs(broadphase).empty());
+
+    broadphase.destroyProxy(floor);
+    const ProxyId trigger =
+        broadphase.createProxy(CollisionLayer::Trigger, boxAt(Vec3(0, 1, 0), 2.0f), {}, 3);
+    EXPECT_EQ(trigger, floor);
+    EXPECT_EQ(broadphase.getLayer(trigger), CollisionLayer::Trigger);
+
+    // The trigger overlap is an event, never a pair
+    EXPECT_TRUE(collectPairs(broadphase).empty());
+    ASSERT_EQ(broadphase.getTriggerEvents().size(), 1u);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].trigger, trigger);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].other, crate);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].type, TriggerEventType::Enter);
+}
+
+TEST(CollisionLayersTest, TreeLayersAreRebuiltWithoutChangingPairs) {
+    // A scattered static level and a few bodies on it; the default tree
+    // rebuild spans four steps
+    LayeredBroadphase broadphase;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 400; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(broadphase.createProxy(CollisionLayer::Static, boxAt(center, 1.0f), {},
+                                             static_cast<uint64_t>(i)));
+    }
+    for (int i = 0; i < 40; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(broadphase.createProxy(CollisionLayer::Dynamic, boxAt(center), {},
+                                             static_cast<uint64_t>(i)));
+    }
+
+    uint32_t rebuilds = 0;
+    for (int step = 0; step < 6; ++step) {
+        EXPECT_EQ(collectPairs(broadphase), bruteForcePairs(broadphase, ids));
+        rebuilds += broadphase.getStats().treeRebuilds;
+    }
+    EXPECT_EQ(rebuilds, 1u);
+}
+
+TEST(CollisionLayersTest, MortonReorderKeepsHandlesAndPairs) {
+    // Proxies created in random order: neighbours in space land far apart in storage
+    LayeredBroadphaseConfig config;
+    config.reorderShardSize = 300;
+    LayeredBroadphase broadphase(config);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 1500; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const auto layer = i % 3 == 0 ? CollisionLayer::Static : CollisionLayer::Dynamic;
+        ids.push_back(broadphase.createProxy(layer, boxAt(center, 1.0f),
+                                             makeFilter(1u << (i % 4), 0xFFFF),
+                                             static_cast<uint64_t>(i) * 7));
+    }
+    std::vector<AABB> bounds;
+    for (const ProxyId id : ids) {
+        bounds.push_back(broadphase.getAABB(id));
+    }
+
+    EXPECT_EQ(collectPairs(broadphase), bruteForcePairs(broadphase, ids));
+    const uint32_t distantBefore = broadphase.getStats().distantPairs;
+    EXPECT_GT(distantBefore, broadphase.getStats().pairCount / 2);
+    ASSERT_TRUE(broadphase.isReordering());
+
+    // Five shards place every proxy; handles never change meanwhile
+    uint32_t reordered = 0;
+    for (int step = 0; step < 5; ++step) {
+        EXPECT_EQ(collectPairs(broadphase), bruteForcePairs(broadphase, ids));
+        EXPECT_LE(broadphase.getStats().reorderedProxies, config.reorderShardSize);
+        reordered += broadphase.getStats().reorderedProxies;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(broadphase.getUserData(ids[i]), static_cast<uint64_t>(i) * 7);
+            EXPECT_EQ(broadphase.getFilter(ids[i]).categoryBits, 1u << (i % 4));
+            EXPECT_EQ(broadphase.getAABB(ids[i]).min, bounds[i].min);
+        }
+    }
+    EXPECT_FALSE(broadphase.isReordering());
+    EXPECT_EQ(reordered, broadphase.getProxyCount());
+    EXPECT_LT(broadphase.getStats().distantPairs, distantBefore / 2);
+
+    // A settled scene does not start another reorder
+    collectPairs(broadphase);
+    EXPECT_FALSE(broadphase.isReordering());
+
+    // Queries report the same handles
+    std::vector<ProxyId> found;
+    broadphase.query(bounds[42], AllLayers, [&](ProxyId id) {
+        found.push_back(id);
+        return true;
+    });
+    EXPECT_NE(std::find(found.begin(), found.end(), ids[42]), found.end());
+}
+
+TEST(CollisionLayersTest, MortonReorderSurvivesDestroyAndCreate) {
+    LayeredBroadphaseConfig config;
+    config.reorderShardSize = 100;
+    LayeredBroadphase broadphase(config);
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+    std::vector<ProxyId> ids;
+    const auto create = [&] {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(broadphase.createProxy(CollisionLayer::Dynamic, boxAt(center, 1.0f), {},
+                                             ids.size()));
+    };
+    for (int i = 0; i < 800; ++i) {
+        create();
+    }
+    collectPairs(broadphase);
+    ASSERT_TRUE(broadphase.isReordering());
+
+    // Churn between shards: destroyed proxies are skipped, new ones stay at the end
+    for (int step = 0; step < 12; ++step) {
+        for (int i = 0; i < 20; ++i) {
+            const size_t victim = rng() % ids.size();
+            broadphase.destroyProxy(ids[victim]);
+            ids[victim] = ids.back();
+            ids.pop_back();
+        }
+        for (int i = 0; i < 15; ++i) {
+            create();
+        }
+        EXPECT_EQ(collectPairs(broadphase), bruteForcePairs(broadphase, ids));
+    }
+    EXPECT_FALSE(broadphase.isReordering());
+    EXPECT_EQ(broadphase.getProxyCount(), ids.size());
+
+    std::vector<bool> slotUsed(ids.size(), false);
+    for (const ProxyId id : ids) {
+        ASSERT_LT(broadphase.getSlot(id), slotUsed.size());
+        EXPECT_FALSE(slotUsed[broadphase.getSlot(id)]);
+        slotUsed[broadphase.getSlot(id)] = true;
+    }
+}
+
+TEST(CollisionLayersTest, MortonReorderIsDeterministic) {
+    const auto run = [] {
+        LayeredBroadphaseConfig config;
+        config.reorderShardSize = 128;
+        LayeredBroadphase broadphase(config);
+        std::mt19937 rng(13);
+        std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+        for (int i = 0; i < 1000; ++i) {
+            const Vec3 center(position(rng), position(rng), position(rng));
+            broadphase.createProxy(CollisionLayer::Dynamic, boxAt(center, 1.0f), {}, 0);
+        }
+        std::vector<std::pair<ProxyId, ProxyId>> pairs;
+        uint32_t reordered = 0;
+        for (int step = 0; step < 10; ++step) {
+            broadphase.updatePairs([&](ProxyId a, ProxyId b) { pairs.emplace_back(a, b); });
+            reordered += broadphase.getStats().reorderedProxies;
+        }
+        EXPECT_EQ(reordered, 1000u);
+        return pairs;
+    };
+    EXPECT_EQ(run(), run());
+}
+
+// ============================================================================
+// Triggers
+// ============================================================================
+
+TEST(CollisionLayersTest, TriggerEventsFollowMotion) {
+    LayeredBroadphase broadphase;
+    const ProxyId zone =
+        broadphase.createProxy(CollisionLayer::Trigger, boxAt(Vec3::zero(), 2.0f), {}, 0);
+    const ProxyId crate =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(-5, 0, 0)), {}, 1);
+    const ProxyId wall =
+        broadphase.createProxy(CollisionLayer::Static, boxAt(Vec3(0, 1, 0), 3.0f), {}, 2);
+
+    // Static geometry is not paired with triggers
+    collectPairs(broadphase);
+    EXPECT_TRUE(broadphase.getTriggerEvents().empty());
+    EXPECT_EQ(broadphase.getTriggerOverlapCount(wall), 0u);
+
+    // Walk the crate through the zone: one enter, one exit, nothing in between
+    std::vector<std::pair<int, TriggerEventType>> events;
+    for (int step = 1; step <= 10; ++step) {
+        const Vec3 center(-5.0f + static_cast<float>(step), 0, 0);
+        broadphase.moveProxy(crate, boxAt(center), Vec3(1, 0, 0));
+        collectPairs(broadphase);
+        for (const TriggerEvent& event : broadphase.getTriggerEvents()) {
+            EXPECT_EQ(event.trigger, zone);
+            EXPECT_EQ(event.other, crate);
+            events.emplace_back(step, event.type);
+        }
+        const bool inside = std::abs(center.x) <= 2.5f;
+        EXPECT_EQ(broadphase.getTriggerOverlapCount(zone), inside ? 1u : 0u);
+        EXPECT_EQ(broadphase.getTriggerOverlapCount(crate), inside ? 1u : 0u);
+    }
+    EXPECT_EQ(events, (std::vector<std::pair<int, TriggerEventType>>{
+                          {3, TriggerEventType::Enter}, {8, TriggerEventType::Exit}}));
+}
+
+TEST(CollisionLayersTest, RestingProxiesAreNotQueriedForTriggers) {
+    LayeredBroadphase broadphase;
+    std::vector<ProxyId> crates;
+    for (int i = 0; i < 50; ++i) {
+        const Vec3 center(static_cast<float>(i) * 4.0f, 0, 0);
+        broadphase.createProxy(CollisionLayer::Trigger, boxAt(center, 0.8f), {}, 0);
+        crates.push_back(broadphase.createProxy(CollisionLayer::Dynamic,
+                                                boxAt(center + Vec3(0, 1, 0)), {}, 0));
+    }
+    collectPairs(broadphase);
+    EXPECT_EQ(broadphase.getTriggerEvents().size(), 50u);
+    EXPECT_EQ(broadphase.getStats().triggerOverlaps, 50u);
+
+    // Nothing moved: the overlaps carry over without a single query
+    collectPairs(broadphase);
+    EXPECT_TRUE(broadphase.getTriggerEvents().empty());
+    EXPECT_EQ(broadphase.getStats().triggerQueries, 0u);
+    EXPECT_EQ(broadphase.getStats().triggerOverlaps, 50u);
+
+    // One crate moves: one query, and its overlap ends
+    broadphase.moveProxy(crates[7], boxAt(Vec3(28, 5, 0)), Vec3(0, 4, 0));
+    collectPairs(broadphase);
+    EXPECT_EQ(broadphase.getStats().triggerQueries, 1u);
+    ASSERT_EQ(broadphase.getTriggerEvents().size(), 1u);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].other, crates[7]);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].type, TriggerEventType::Exit);
+    EXPECT_EQ(broadphase.getStats().triggerOverlaps, 49u);
+}
+
+TEST(CollisionLayersTest, DestroyedProxiesExitBeforeTheirIdIsReused) {
+    LayeredBroadphase broadphase;
+    const ProxyId zone =
+        broadphase.createProxy(CollisionLayer::Trigger, boxAt(Vec3::zero(), 2.0f), {}, 0);
+    const ProxyId crate =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3::zero()), {}, 1);
+    collectPairs(broadphase);
+    EXPECT_EQ(broadphase.getTriggerEvents().size(), 1u);
+
+    // The id stays reserved until the update has reported the exit
+    broadphase.destroyProxy(crate);
+    const ProxyId barrel =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(1, 0, 0)), {}, 2);
+    EXPECT_NE(barrel, crate);
+    collectPairs(broadphase);
+
+    const auto events = broadphase.getTriggerEvents();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].other, crate);
+    EXPECT_EQ(events[0].type, TriggerEventType::Exit);
+    EXPECT_EQ(events[1].other, barrel);
+    EXPECT_EQ(events[1].type, TriggerEventType::Enter);
+    EXPECT_EQ(broadphase.getTriggerOverlapCount(zone), 1u);
+    EXPECT_EQ(broadphase.createProxy(CollisionLayer::Debris, boxAt(Vec3(9, 0, 0)), {}, 3), crate);
+
+    // Mass destroys all exit in the next update
+    std::vector<ProxyId> crates;
+    for (int i = 0; i < 100; ++i) {
+        crates.push_back(broadphase.createProxy(CollisionLayer::Dynamic,
+                                                boxAt(Vec3(0, static_cast<float>(i) * 0.01f, 0)),
+                                                {}, 4));
+    }
+    collectPairs(broadphase);
+    EXPECT_EQ(broadphase.getTriggerOverlapCount(zone), 101u);
+    for (const ProxyId id : crates) {
+        broadphase.destroyProxy(id);
+    }
+    collectPairs(broadphase);
+    EXPECT_EQ(broadphase.getTriggerEvents().size(), 100u);
+    EXPECT_EQ(broadphase.getTriggerOverlapCount(zone), 1u);
+
+    broadphase.destroyProxy(zone);
+    collectPairs(broadphase);
+    ASSERT_EQ(broadphase.getTriggerEvents().size(), 1u);
+    EXPECT_EQ(broadphase.getTriggerEvents()[0].type, TriggerEventType::Exit);
+    EXPECT_EQ(broadphase.getTriggerOverlapCount(barrel), 0u);
+}
+
+TEST(CollisionLayersTest, TriggerEventsMatchBruteForceUnderChurn) {
+    // Moving triggers and bodies, filters changing, proxies destroyed and
+    // created, and a Morton reorder running: the overlaps rebuilt from the
+    // events must always match brute force
+    LayeredBroadphaseConfig config;
+    config.reorderShardSize = 64;
+    config.layerPairs.enable(CollisionLayer::Trigger, CollisionLayer::Trigger);
+    LayeredBroadphase broadphase(config);
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    std::uniform_real_distribution<float> step(-0.6f, 0.6f);
+    std::uniform_int_distribution<uint32_t> layer(0, CollisionLayerCount - 1);
+    std::uniform_int_distribution<uint32_t> bits(1, 7);
+    std::vector<ProxyId> ids;
+    const auto create = [&] {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const auto proxyLayer = static_cast<CollisionLayer>(layer(rng));
+        const float halfExtent = proxyLayer == CollisionLayer::Trigger ? 2.0f : 0.7f;
+        ids.push_back(broadphase.createProxy(proxyLayer, boxAt(center, halfExtent),
+                                             makeFilter(bits(rng), bits(rng)), 0));
+    };
+    for (int i = 0; i < 600; ++i) {
+        create();
+    }
+
+    PairSet overlaps;
+    uint32_t events = 0;
+    for (int frame = 0; frame < 20; ++frame) {
+        for (const ProxyId id : ids) {
+            if (broadphase.getLayer(id) != CollisionLayer::Static && rng() % 3 == 0) {
+                const Vec3 displacement(step(rng), step(rng), step(rng));
+                const AABB bounds = broadphase.getAABB(id);
+                broadphase.moveProxy(id, AABB(bounds.min + displacement, bounds.max + displacement),
+                                     displacement);
+            }
+        }
+        for (int i = 0; i < 5; ++i) {
+            const size_t victim = rng() % ids.size();
+            broadphase.destroyProxy(ids[victim]);
+            ids[victim] = ids.back();
+            ids.pop_back();
+            create();
+        }
+        broadphase.setFilter(ids[rng() % ids.size()], makeFilter(bits(rng), bits(rng)));
+
+        EXPECT_EQ(collectPairs(broadphase), bruteForcePairs(broadphase, ids));
+        applyTriggerEvents(broadphase, overlaps);
+        events += static_cast<uint32_t>(broadphase.getTriggerEvents().size());
+        ASSERT_EQ(overlaps, bruteForcePairs(broadphase, ids, true)) << "frame " << frame;
+        EXPECT_EQ(broadphase.getStats().triggerOverlaps, overlaps.size());
+    }
+    EXPECT_GT(events, overlaps.size());
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+TEST(CollisionLayersTest, QuerySearchesSelectedLayers) {
+    LayeredBroadphase broadphase;
+    const ProxyId wall = broadphase.createProxy(CollisionLayer::Static, boxAt(Vec3::zero()), {}, 0);
+    const ProxyId crate =
+        broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(0.6f, 0, 0)), {}, 1);
+    broadphase.createProxy(CollisionLayer::Dynamic, boxAt(Vec3(5, 0, 0)), {}, 2);
+    collectPairs(broadphase);
+
+    const auto hits = [&](uint32_t layerMask) {
+        std::vector<ProxyId> found;
+        broadphase.query(boxAt(Vec3(0.3f, 0, 0), 0.1f), layerMask, [&](ProxyId id) {
+            found.push_back(id);
+            return true;
+        });
+        std::sort(found.begin(), found.end());
+        return found;
+    };
+    EXPECT_EQ(hits(AllLayers), (std::vector<ProxyId>{wall, crate}));
+    EXPECT_EQ(hits(layerBit(CollisionLayer::Dynamic)), std::vector<ProxyId>{crate});
+    EXPECT_TRUE(hits(layerBit(CollisionLayer::Debris)).empty());
+}
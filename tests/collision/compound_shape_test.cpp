@@ -0,0 +1,252 @@
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/continuous_collision.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr std::array<Vec3, 4> TetrahedronPoints = {
+    Vec3(0.0f, 0.8f, 0.0f), Vec3(-0.7f, -0.4f, 0.5f), Vec3(0.7f, -0.4f, 0.5f),
+    Vec3(0.0f, -0.4f, -0.8f)};
+
+/// Random children of every bounded type scattered over a 10 m cube
+std::vector<CompoundChild> makeChildren(uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-5.0f, 5.0f);
+    std::uniform_real_distribution<float> size(0.1f, 0.6f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    std::vector<CompoundChild> children;
+    for (uint32_t i = 0; i < count; ++i) {
+        ConvexShape shape;
+        switch (i % 4) {
+            case 0:
+                shape = ConvexShape::sphere(size(rng));
+                break;
+            case 1:
+                shape = ConvexShape::box(Vec3(size(rng), size(rng), size(rng)));
+                break;
+            case 2:
+                shape = ConvexShape::capsule(size(rng), 2.0f * size(rng));
+                break;
+            default:
+                shape = ConvexShape::convex(TetrahedronPoints, 0.05f);
+                break;
+        }
+        const Vec3 offset(position(rng), position(rng), position(rng));
+        children.push_back(
+            {shape, Transform(offset, Quat::fromAxisAngle(Vec3::unitZ(), angle(rng)))});
+    }
+    return children;
+}
+
+/// Two boxes side by side along X with a sphere on top: a small "cart"
+CompoundShape makeCart() {
+    const std::array<CompoundChild, 3> parts = {
+        CompoundChild{ConvexShape::box(Vec3(0.5f)), Transform(Vec3(-1.0f, 0.0f, 0.0f))},
+        CompoundChild{ConvexShape::box(Vec3(0.5f)), Transform(Vec3(1.0f, 0.0f, 0.0f))},
+        CompoundChild{ConvexShape::sphere(0.5f), Transform(Vec3(0.0f, 1.0f, 0.0f))}};
+    return CompoundShape::create(parts).value();
+}
+
+}  // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(CompoundShapeTest, CreateRejectsInvalidInput) {
+    EXPECT_FALSE(CompoundShape::create({}).isSuccess());
+
+    const std::array<CompoundChild, 2> withPlane = {
+        CompoundChild{ConvexShape::sphere(1.0f), Transform()},
+        CompoundChild{ConvexShape::plane(), Transform()}};
+    const auto result = CompoundShape::create(withPlane);
+    ASSERT_FALSE(result.isSuccess());
+    EXPECT_EQ(result.errorCode(), axiom::core::ErrorCode::InvalidShape);
+
+    // Compounds do not nest
+    const CompoundShape cart = makeCart();
+    const std::array<CompoundChild, 1> nested = {
+        CompoundChild{ConvexShape::compoundShape(cart), Transform()}};
+    EXPECT_FALSE(CompoundShape::create(nested).isSuccess());
+}
+
+TEST(CompoundShapeTest, QueryAABBMatchesBruteForce) {
+    const std::vector<CompoundChild> children = makeChildren(40, 1);
+    const CompoundShape compound = CompoundShape::create(children).value();
+
+    const CompoundShapeStats stats = compound.getStats();
+    EXPECT_EQ(stats.childCount, 40u);
+    EXPECT_GE(stats.nodeCount, 2 * (40 / CompoundShape::MaxLeafChildren) - 1);
+    EXPECT_LT(stats.nodeCount, 2 * 40u);
+    EXPECT_LE(stats.depth, 6u);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> position(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    for (int i = 0; i < 200; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const Vec3 half(size(rng), size(rng), size(rng));
+        const AABB box(center - half, center + half);
+
+        std::set<uint32_t> expected;
+        for (uint32_t child = 0; child < compound.getChildCount(); ++child) {
+            if (compound.getChildBounds(child).intersects(box)) {
+                expected.insert(child);
+            }
+        }
+        std::set<uint32_t> found;
+        compound.queryAABB(box, [&](uint32_t child) {
+            EXPECT_TRUE(found.insert(child).second);
+            return true;
+        });
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST(CompoundShapeTest, BoundsAreTheUnionOfTheChildren) {
+    const std::vector<CompoundChild> children = makeChildren(12, 3);
+    const CompoundShape compound = CompoundShape::create(children).value();
+    const ConvexShape shape = ConvexShape::compoundShape(compound);
+    const Transform transform(Vec3(3.0f, -1.0f, 2.0f),
+                              Quat::fromAxisAngle(Vec3(1.0f, 1.0f, 0.0f).normalized(), 0.7f));
+
+    AABB expected;
+    for (uint32_t child = 0; child < compound.getChildCount(); ++child) {
+        const Transform& local = children[child].transform;
+        const Transform placed(transform.position + transform.rotation * local.position,
+                               transform.rotation * local.rotation);
+        EXPECT_EQ(compound.placeChild(child, transform).position, placed.position);
+        expected.merge(children[child].shape.computeAABB(placed));
+        // The bounding radius covers every child wherever the body turns
+        EXPECT_LE((placed.position - transform.position).length() +
+                      children[child].shape.computeBoundingRadius(),
+                  shape.computeBoundingRadius() + 1.0e-4f);
+    }
+    const AABB bounds = shape.computeAABB(transform);
+    EXPECT_NEAR(bounds.min.x, expected.min.x, 1.0e-4f);
+    EXPECT_NEAR(bounds.min.y, expected.min.y, 1.0e-4f);
+    EXPECT_NEAR(bounds.max.z, expected.max.z, 1.0e-4f);
+
+    // The cache answers a body at rest without recomputing, and follows it once it moves
+    CompoundBoundsCache cache;
+    EXPECT_NEAR(compound.updateBounds(transform, cache).max.x, bounds.max.x, 1.0e-5f);
+    cache.bounds = AABB(Vec3(-1.0f), Vec3(1.0f));
+    EXPECT_EQ(compound.updateBounds(transform, cache).max.x, 1.0f);
+    const Transform moved(transform.position + Vec3(0.5f, 0.0f, 0.0f), transform.rotation);
+    EXPECT_NEAR(compound.updateBounds(moved, cache).max.x, bounds.max.x + 0.5f, 1.0e-4f);
+}
+
+// ============================================================================
+// Contacts
+// ============================================================================
+
+TEST(CompoundShapeTest, CartRestsOnPlaneAndBox) {
+    using enum ShapeType;
+    static_assert(getContactKernel(Compound, Box) == &collideCompound);
+    static_assert(getContactKernel(Plane, Compound) == &collideFlipped<collideCompound>);
+    static_assert(getContactKernel(Compound, Compound) == &collideCompound);
+    static_assert(getContactKernel(Compound, Mesh) == &collideCompound);
+
+    const CompoundShape cart = makeCart();
+    const ConvexShape shape = ConvexShape::compoundShape(cart);
+    const Transform cartTransform(Vec3(0.0f, 0.49f, 0.0f));
+
+    // On a plane, both boxes touch and the sphere on top does not
+    const ConvexShape ground = ConvexShape::plane();
+    const Transform groundTransform;
+    ContactManifold manifold;
+    getContactKernel(Compound, Plane)(
+        {&shape, &cartTransform, &ground, &groundTransform, nullptr}, 0.02f, manifold);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, -1.0f, 1.0e-4f);
+    std::set<uint32_t> features;
+    bool left = false;
+    bool right = false;
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        const ContactPoint& point = manifold.points[i];
+        EXPECT_NEAR(point.separation, -0.01f, 1.0e-4f);
+        EXPECT_TRUE(features.insert(point.featureId).second);
+        left = left || point.pointA.x < 0.0f;
+        right = right || point.pointA.x > 0.0f;
+    }
+    EXPECT_TRUE(left);
+    EXPECT_TRUE(right);
+
+    // A narrow post under the right box touches that box only
+    const ConvexShape post = ConvexShape::box(Vec3(0.2f, 1.0f, 0.2f));
+    const Transform postTransform(Vec3(1.0f, -1.0f, 0.0f));
+    ContactManifold onPost;
+    getContactKernel(Box, Compound)({&post, &postTransform, &shape, &cartTransform, nullptr},
+                                    0.02f, onPost);
+    ASSERT_GT(onPost.pointCount, 0u);
+    EXPECT_NEAR(onPost.normal.y, 1.0f, 1.0e-3f);
+    for (uint32_t i = 0; i < onPost.pointCount; ++i) {
+        EXPECT_GT(onPost.points[i].pointB.x, 0.75f);
+        EXPECT_NEAR(onPost.points[i].separation, -0.01f, 1.0e-3f);
+    }
+}
+
+TEST(CompoundShapeTest, CompoundsCollideChildByChild) {
+    const CompoundShape cart = makeCart();
+    const ConvexShape shape = ConvexShape::compoundShape(cart);
+    const Transform lower;
+    // A second cart dropped so only its left box lands on the first one's right box
+    const Transform upper(Vec3(2.0f, 0.99f, 0.0f));
+
+    ContactManifold manifold;
+    collideCompound({&shape, &lower, &shape, &upper, nullptr}, 0.02f, manifold);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, 1.0e-3f);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_NEAR(manifold.points[i].separation, -0.01f, 1.0e-3f);
+        EXPECT_GT(manifold.points[i].pointA.x, 0.49f);
+        EXPECT_LT(manifold.points[i].pointB.x, 1.51f);
+    }
+
+    // Apart, nothing
+    const Transform far(Vec3(10.0f, 0.0f, 0.0f));
+    ContactManifold none;
+    collideCompound({&shape, &lower, &shape, &far, nullptr}, 0.02f, none);
+    EXPECT_EQ(none.pointCount, 0u);
+}
+
+// ============================================================================
+// Continuous collision
+// ============================================================================
+
+TEST(CompoundShapeTest, BulletCompoundStopsAtItsNearestChild) {
+    const CompoundShape cart = makeCart();
+    const ConvexShape shape = ConvexShape::compoundShape(cart);
+    const ConvexShape ground = ConvexShape::plane();
+    constexpr float Dt = 1.0f / 60.0f;
+
+    BodyMotion falling;
+    falling.shape = &shape;
+    falling.transform = Transform(Vec3(0.0f, 3.5f, 0.0f));
+    falling.linearVelocity = Vec3(0.0f, -300.0f, 0.0f);
+    falling.mode = CcdMode::Bullet;
+    BodyMotion floor;
+    floor.shape = &ground;
+
+    const CcdSettings settings;
+    const TimeOfImpact impact = computeTimeOfImpact(falling, floor, Dt, settings);
+    ASSERT_TRUE(impact.hit);
+    // The boxes' bottoms, 0.5 m below the origin, reach the plane after 3 m of the 5 m step
+    EXPECT_NEAR(impact.fraction, (3.0f - settings.toiSeparation) / 5.0f, 1.0e-3f);
+    EXPECT_NEAR(impact.normal.y, -1.0f, 1.0e-3f);
+    EXPECT_NEAR(impact.pointA.y, impact.pointB.y + settings.toiSeparation, 1.0e-3f);
+}
@@ -0,0 +1,291 @@
+#include "axiom/collision/contact_kernels.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float Tolerance = 1.0e-3f;
+
+ContactManifold collide(const ConvexShape& a, const Transform& transformA, const ConvexShape& b,
+                        const Transform& transformB, float maxDistance = 0.0f) {
+    ContactManifold manifold;
+    generateContacts({&a, &transformA, &b, &transformB, nullptr}, maxDistance, manifold);
+    return manifold;
+}
+
+float deepest(const ContactManifold& manifold) {
+    float separation = std::numeric_limits<float>::infinity();
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        separation = std::min(separation, manifold.points[i].separation);
+    }
+    return separation;
+}
+
+Quat randomRotation(std::mt19937& rng) {
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    Vec3 axis(component(rng), component(rng), component(rng));
+    if (axis.lengthSquared() < 1.0e-3f) {
+        axis = Vec3::unitY();
+    }
+    return Quat::fromAxisAngle(axis.normalized(), angle(rng));
+}
+
+/// Every point must be consistent with the normal and its separation
+void expectConsistent(const ContactManifold& manifold) {
+    EXPECT_NEAR(manifold.normal.length(), 1.0f, Tolerance);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        const ContactPoint& point = manifold.points[i];
+        EXPECT_NEAR((point.pointB - point.pointA).dot(manifold.normal), point.separation,
+                    Tolerance);
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+TEST(ContactKernelsTest, DispatchTableIsResolvedAtCompileTime) {
+    using enum ShapeType;
+    static_assert(getContactKernel(Sphere, Plane) == &collideSpherePlane);
+    static_assert(getContactKernel(Plane, Sphere) == &collideFlipped<collideSpherePlane>);
+    static_assert(getContactKernel(Box, Box) == &collideBoxBox);
+    static_assert(getContactKernel(Capsule, Box) == &collideConvexGeneric);
+    static_assert(getContactKernel(Convex, Sphere) == &collideConvexGeneric);
+    static_assert(getContactKernel(Plane, Plane) == &collideNothing);
+    static_assert(getContactKernel(Mesh, Box) == &collideMeshConvex);
+    static_assert(getContactKernel(Box, Mesh) == &collideFlipped<collideMeshConvex>);
+    static_assert(getContactKernel(Mesh, Mesh) == &collideNothing);
+    SUCCEED();
+}
+
+TEST(ContactKernelsTest, FlippedPairsMirrorTheResult) {
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f));
+    const ConvexShape plane = ConvexShape::plane();
+    const Transform boxTransform(Vec3(0, 0.45f, 0));
+    const Transform planeTransform(Vec3::zero());
+
+    const ContactManifold boxFirst = collide(box, boxTransform, plane, planeTransform);
+    const ContactManifold planeFirst = collide(plane, planeTransform, box, boxTransform);
+    ASSERT_EQ(boxFirst.pointCount, 4u);
+    ASSERT_EQ(planeFirst.pointCount, 4u);
+    EXPECT_NEAR(boxFirst.normal.y, -1.0f, Tolerance);
+    EXPECT_NEAR(planeFirst.normal.y, 1.0f, Tolerance);
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(boxFirst.points[i].separation, -0.05f, Tolerance);
+        EXPECT_NEAR(planeFirst.points[i].pointA.y, 0.0f, Tolerance);
+        EXPECT_NEAR(planeFirst.points[i].pointB.y, -0.05f, Tolerance);
+    }
+}
+
+// ============================================================================
+// Primitive kernels
+// ============================================================================
+
+TEST(ContactKernelsTest, SphereKernels) {
+    const ConvexShape sphere = ConvexShape::sphere(0.5f);
+
+    const ContactManifold spheres =
+        collide(sphere, Transform(Vec3::zero()), sphere, Transform(Vec3(0.8f, 0, 0)));
+    ASSERT_EQ(spheres.pointCount, 1u);
+    EXPECT_NEAR(spheres.points[0].separation, -0.2f, Tolerance);
+    EXPECT_NEAR(spheres.normal.x, 1.0f, Tolerance);
+
+    // Tilted plane through the origin
+    const Quat tilt = Quat::fromAxisAngle(Vec3::unitZ(), 0.5f);
+    const Transform planeTransform(Vec3::zero(), tilt);
+    const Vec3 up = tilt * Vec3::unitY();
+    const ContactManifold onPlane =
+        collide(sphere, Transform(up * 0.4f), ConvexShape::plane(), planeTransform);
+    ASSERT_EQ(onPlane.pointCount, 1u);
+    EXPECT_NEAR(onPlane.points[0].separation, -0.1f, Tolerance);
+    EXPECT_NEAR(onPlane.normal.dot(up), -1.0f, Tolerance);
+    expectConsistent(onPlane);
+
+    // Capsule standing on its end under the sphere
+    const ContactManifold onCapsule = collide(sphere, Transform(Vec3(0, 1.9f, 0)),
+                                              ConvexShape::capsule(0.5f, 2.0f),
+                                              Transform(Vec3::zero()));
+    ASSERT_EQ(onCapsule.pointCount, 1u);
+    EXPECT_NEAR(onCapsule.points[0].separation, -0.1f, Tolerance);
+    EXPECT_NEAR(onCapsule.normal.y, -1.0f, Tolerance);
+
+    // Center inside the box: pushed out through the nearest face
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f, 1.0f, 1.0f));
+    const ContactManifold inside =
+        collide(sphere, Transform(Vec3(0, 0, 0.8f)), box, Transform(Vec3::zero()));
+    ASSERT_EQ(inside.pointCount, 1u);
+    EXPECT_NEAR(inside.points[0].separation, -0.7f, Tolerance);
+    EXPECT_NEAR(inside.normal.z, -1.0f, Tolerance);
+    expectConsistent(inside);
+
+    EXPECT_EQ(collide(sphere, Transform(Vec3(0, 0, 1.6f)), box, Transform(Vec3::zero()))
+                  .pointCount,
+              0u);
+    EXPECT_EQ(collide(sphere, Transform(Vec3(0, 0, 1.6f)), box, Transform(Vec3::zero()), 0.2f)
+                  .pointCount,
+              1u);
+}
+
+TEST(ContactKernelsTest, BoxStackedOnBoxHasFourPoints) {
+    const ConvexShape base = ConvexShape::box(Vec3(1.0f, 0.5f, 1.0f));
+    const ConvexShape crate = ConvexShape::box(Vec3(0.5f));
+    const Transform crateTransform(Vec3(0.8f, 0.99f, 0.0f),
+                                   Quat::fromAxisAngle(Vec3::unitY(), 0.3f));
+
+    const ContactManifold manifold = collide(base, Transform(Vec3::zero()), crate, crateTransform);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, Tolerance);
+    expectConsistent(manifold);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        // The crate hangs over the edge: its points are clipped to the base
+        EXPECT_NEAR(manifold.points[i].separation, -0.01f, Tolerance);
+        EXPECT_LE(manifold.points[i].pointA.x, 1.0f + Tolerance);
+    }
+}
+
+TEST(ContactKernelsTest, CapsulesLyingSideBySideHaveTwoPoints) {
+    const ConvexShape capsule = ConvexShape::capsule(0.5f, 2.0f);
+    const Quat lying = Quat::fromAxisAngle(Vec3::unitZ(), 1.5707963f);
+
+    const ContactManifold manifold = collide(capsule, Transform(Vec3::zero(), lying), capsule,
+                                             Transform(Vec3(0.5f, 0.95f, 0.0f), lying));
+    ASSERT_EQ(manifold.pointCount, 2u);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, Tolerance);
+    EXPECT_NEAR(manifold.points[0].separation, -0.05f, Tolerance);
+    EXPECT_NEAR(manifold.points[1].separation, -0.05f, Tolerance);
+    EXPECT_NEAR(std::abs(manifold.points[0].pointA.x - manifold.points[1].pointA.x), 1.5f,
+                Tolerance);
+
+    // Crossed capsules touch at one point
+    const ContactManifold crossed = collide(
+        capsule, Transform(Vec3::zero(), lying), capsule,
+        Transform(Vec3(0, 0.95f, 0), Quat::fromAxisAngle(Vec3::unitX(), 1.5707963f)));
+    ASSERT_EQ(crossed.pointCount, 1u);
+    EXPECT_NEAR(crossed.points[0].separation, -0.05f, Tolerance);
+}
+
+TEST(ContactKernelsTest, KernelsAgreeWithGjk) {
+    const std::array<ConvexShape, 3> shapes = {ConvexShape::sphere(0.6f),
+                                               ConvexShape::box(Vec3(0.7f, 0.4f, 0.5f)),
+                                               ConvexShape::capsule(0.3f, 1.2f)};
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> offset(-1.6f, 1.6f);
+    for (const ConvexShape& a : shapes) {
+        for (const ConvexShape& b : shapes) {
+            for (int i = 0; i < 300; ++i) {
+                const Transform transformA(Vec3::zero(), randomRotation(rng));
+                const Transform transformB(Vec3(offset(rng), offset(rng), offset(rng)),
+                                           randomRotation(rng));
+                const ContactManifold manifold = collide(a, transformA, b, transformB, 0.05f);
+                const ConvexContact reference = collideConvex(a, transformA, b, transformB, 0.05f);
+
+                ASSERT_EQ(manifold.pointCount > 0, reference.touching)
+                    << static_cast<int>(a.type) << "-" << static_cast<int>(b.type) << " case "
+                    << i << " distance " << reference.distance;
+                if (manifold.pointCount == 0) {
+                    continue;
+                }
+                expectConsistent(manifold);
+                // Box faces are preferred over slightly shallower axes
+                ASSERT_NEAR(deepest(manifold), reference.distance,
+                            0.02f * std::abs(reference.distance) + 0.002f)
+                    << static_cast<int>(a.type) << "-" << static_cast<int>(b.type) << " case "
+                    << i;
+                if (reference.distance > -0.1f) {
+                    // Deep overlaps can have several near-equal axes
+                    EXPECT_GT(manifold.normal.dot(reference.normal), 0.9f);
+                }
+            }
+        }
+    }
+}
+
+TEST(ContactKernelsTest, ReduceKeepsDeepestPointAndArea) {
+    // A 5 x 5 grid of points with the deepest one inside
+    std::vector<ContactPoint> points;
+    for (int x = 0; x < 5; ++x) {
+        for (int z = 0; z < 5; ++z) {
+            const Vec3 position(static_cast<float>(x), 0.0f, static_cast<float>(z));
+            const float separation = x == 2 && z == 1 ? -0.5f : -0.1f;
+            points.push_back({position, position, separation, static_cast<uint32_t>(x * 5 + z)});
+        }
+    }
+
+    ASSERT_EQ(reduceContactPoints(Vec3::unitY(), points), MaxManifoldPoints);
+    EXPECT_EQ(points[0].featureId, 11u);
+    // The other three span a large part of the grid
+    const Vec3 p0 = points[0].pointB;
+    float area = 0.0f;
+    for (uint32_t i = 1; i + 1 < MaxManifoldPoints; ++i) {
+        area += std::abs((points[i].pointB - p0).cross(points[i + 1].pointB - p0).y) * 0.5f;
+    }
+    EXPECT_GE(area, 8.0f);
+}
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+TEST(ContactKernelsTest, DispatcherMatchesPerPairKernels) {
+    const std::array<Vec3, 6> octahedron = {Vec3(0.5f, 0, 0),  Vec3(-0.5f, 0, 0),
+                                            Vec3(0, 0.5f, 0),  Vec3(0, -0.5f, 0),
+                                            Vec3(0, 0, 0.5f),  Vec3(0, 0, -0.5f)};
+    const std::array<ConvexShape, 5> shapes = {
+        ConvexShape::sphere(0.5f), ConvexShape::box(Vec3(0.5f)), ConvexShape::capsule(0.3f, 1.0f),
+        ConvexShape::plane(), ConvexShape::convex(octahedron)};
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::uniform_int_distribution<size_t> shape(0, shapes.size() - 1);
+    std::vector<Transform> transforms;
+    for (int i = 0; i < 2000; ++i) {
+        transforms.emplace_back(Vec3(position(rng), position(rng), position(rng)),
+                                randomRotation(rng));
+    }
+
+    std::vector<ContactPair> pairs;
+    uint32_t generic = 0;
+    for (size_t i = 0; i + 1 < transforms.size(); i += 2) {
+        const ConvexShape& a = shapes[shape(rng)];
+        const ConvexShape& b = shapes[shape(rng)];
+        pairs.push_back({&a, &transforms[i], &b, &transforms[i + 1], nullptr});
+        generic += getContactKernel(a.type, b.type) == &collideConvexGeneric ? 1u : 0u;
+    }
+
+    ContactDispatcher dispatcher;
+    std::vector<ContactManifold> batched(pairs.size());
+    dispatcher.generate(pairs, 0.1f, batched);
+
+    uint32_t points = 0;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        ContactManifold single;
+        generateContacts(pairs[i], 0.1f, single);
+        ASSERT_EQ(batched[i].pointCount, single.pointCount) << "pair " << i;
+        for (uint32_t k = 0; k < single.pointCount; ++k) {
+            EXPECT_NEAR(batched[i].points[k].separation, single.points[k].separation, 1.0e-5f);
+            EXPECT_EQ(batched[i].points[k].featureId, single.points[k].featureId);
+        }
+        points += single.pointCount;
+    }
+    EXPECT_EQ(dispatcher.getStats().pairCount, pairs.size());
+    EXPECT_EQ(dispatcher.getStats().pointCount, points);
+    EXPECT_EQ(dispatcher.getStats().genericCount, generic);
+    EXPECT_GT(dispatcher.getStats().touchingCount, 100u);
+}
@@ -0,0 +1,186 @@
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/contact_manifold.hpp"
+#include "axiom/collision/overlapping_pair_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <initializer_list>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Points on B at the given positions with a +Y normal
+ContactManifold makeContacts(std::initializer_list<Vec3> positions, float separation = 0.0f) {
+    ContactManifold contacts;
+    contacts.normal = Vec3::unitY();
+    for (const Vec3& position : positions) {
+        const Vec3 pointA = position - contacts.normal * separation;
+        contacts.points[contacts.pointCount++] = {pointA, position, separation, NoFeatureId};
+    }
+    return contacts;
+}
+
+bool hasPointNear(const PersistentManifold& manifold, const Vec3& position) {
+    for (const ManifoldPoint& point : manifold.getPoints()) {
+        if ((point.pointB - position).length() < 1.0e-4f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+// ============================================================================
+// Matching
+// ============================================================================
+
+TEST(PersistentManifoldTest, FeatureIdsCarryImpulsesAcrossFrames) {
+    const ConvexShape crate = ConvexShape::box(Vec3(0.5f));
+    const Transform ground(Vec3::zero());
+    Transform top(Vec3(0.0f, 0.99f, 0.0f), Quat::fromAxisAngle(Vec3::unitY(), 0.3f));
+
+    PersistentManifold manifold;
+    ContactManifold contacts;
+    generateContacts({&crate, &top, &crate, &ground, nullptr}, 0.02f, contacts);
+    manifold.update(contacts, top, ground);
+    ASSERT_EQ(manifold.getPointCount(), 4u);
+    EXPECT_EQ(manifold.getMatchedCount(), 0u);
+
+    // The solver stores its impulses in the points
+    for (ManifoldPoint& point : manifold.getPoints()) {
+        point.normalImpulse = static_cast<float>(point.featureId & 0xFFu) + 1.0f;
+        point.tangentImpulse = {0.5f, -0.5f};
+    }
+
+    // The box settles a little: same features, same impulses
+    top.position.y = 0.985f;
+    generateContacts({&crate, &top, &crate, &ground, nullptr}, 0.02f, contacts);
+    manifold.update(contacts, top, ground);
+    ASSERT_EQ(manifold.getPointCount(), 4u);
+    EXPECT_EQ(manifold.getMatchedCount(), 4u);
+    for (const ManifoldPoint& point : manifold.getPoints()) {
+        EXPECT_FLOAT_EQ(point.normalImpulse, static_cast<float>(point.featureId & 0xFFu) + 1.0f);
+        EXPECT_FLOAT_EQ(point.tangentImpulse[0], 0.5f);
+        EXPECT_FLOAT_EQ(point.tangentImpulse[1], -0.5f);
+        EXPECT_EQ(point.lifetime, 1u);
+        EXPECT_NEAR(point.separation, -0.015f, 1.0e-3f);
+    }
+}
+
+TEST(PersistentManifoldTest, PointsWithoutFeatureIdsMatchByProximity) {
+    const Transform identity(Vec3::zero());
+    PersistentManifold manifold;
+    manifold.update(makeContacts({Vec3(0.0f, 0.0f, 0.0f)}), identity, identity);
+    manifold.getPoints()[0].normalImpulse = 3.0f;
+
+    // Within matchDistance: the same point
+    manifold.update(makeContacts({Vec3(0.01f, 0.0f, 0.0f)}), identity, identity);
+    ASSERT_EQ(manifold.getPointCount(), 1u);
+    EXPECT_EQ(manifold.getMatchedCount(), 1u);
+    EXPECT_FLOAT_EQ(manifold.getPoints()[0].normalImpulse, 3.0f);
+
+    // Further away: a new point, and the old one is kept alongside it
+    manifold.update(makeContacts({Vec3(0.5f, 0.0f, 0.0f)}), identity, identity);
+    EXPECT_EQ(manifold.getMatchedCount(), 0u);
+    ASSERT_EQ(manifold.getPointCount(), 2u);
+    EXPECT_FLOAT_EQ(manifold.getPoints()[0].normalImpulse, 0.0f);
+    EXPECT_FLOAT_EQ(manifold.getPoints()[1].normalImpulse, 3.0f);
+}
+
+TEST(PersistentManifoldTest, SinglePointsBuildUpAReducedManifold) {
+    // One GJK point per frame, walking around a face, builds a manifold
+    const Transform identity(Vec3::zero());
+    PersistentManifold manifold;
+    const Vec3 corners[] = {Vec3(0.5f, 0.0f, 0.5f), Vec3(-0.5f, 0.0f, 0.5f),
+                            Vec3(-0.5f, 0.0f, -0.5f), Vec3(0.5f, 0.0f, -0.5f)};
+    for (const Vec3& corner : corners) {
+        manifold.update(makeContacts({corner}, -0.01f), identity, identity);
+    }
+    ASSERT_EQ(manifold.getPointCount(), 4u);
+
+    // A shallower fifth point inside the quad adds no area and is the one dropped
+    manifold.update(makeContacts({Vec3(0.1f, 0.0f, 0.1f)}), identity, identity);
+    ASSERT_EQ(manifold.getPointCount(), 4u);
+    for (const Vec3& corner : corners) {
+        EXPECT_TRUE(hasPointNear(manifold, corner));
+    }
+
+    // ...unless it is the deepest
+    manifold.update(makeContacts({Vec3(0.1f, 0.0f, 0.1f)}, -0.05f), identity, identity);
+    ASSERT_EQ(manifold.getPointCount(), 4u);
+    EXPECT_TRUE(hasPointNear(manifold, Vec3(0.1f, 0.0f, 0.1f)));
+}
+
+// ============================================================================
+// Pruning
+// ============================================================================
+
+TEST(PersistentManifoldTest, SeparatedPointsArePruned) {
+    const Transform identity(Vec3::zero());
+    PersistentManifold manifold;
+    manifold.update(makeContacts({Vec3(0.5f, 0.0f, 0.0f), Vec3(-0.5f, 0.0f, 0.0f)}), identity,
+                    identity);
+
+    // B lifts one side: that anchor separates beyond breakingDistance
+    const Transform tilted(Vec3::zero(), Quat::fromAxisAngle(Vec3::unitZ(), 0.1f));
+    manifold.refresh(identity, tilted);
+    ASSERT_EQ(manifold.getPointCount(), 1u);
+    EXPECT_LT(manifold.getPoints()[0].pointB.x, 0.0f);
+    EXPECT_EQ(manifold.getPoints()[0].lifetime, 1u);
+
+    // No contacts at all clears the manifold
+    manifold.update(ContactManifold{}, identity, identity);
+    EXPECT_EQ(manifold.getPointCount(), 0u);
+}
+
+TEST(PersistentManifoldTest, DriftingPointsArePruned) {
+    const Transform identity(Vec3::zero());
+    PersistentManifold manifold;
+    manifold.update(makeContacts({Vec3(0.0f, 0.0f, 0.0f)}), identity, identity);
+
+    // Sliding less than driftDistance keeps the point
+    manifold.refresh(identity, Transform(Vec3(0.01f, 0.0f, 0.0f)));
+    EXPECT_EQ(manifold.getPointCount(), 1u);
+
+    // Sliding further does not, even though the separation is unchanged
+    manifold.refresh(identity, Transform(Vec3(0.05f, 0.0f, 0.0f)));
+    EXPECT_EQ(manifold.getPointCount(), 0u);
+}
+
+// ============================================================================
+// Pair cache
+// ============================================================================
+
+TEST(PersistentManifoldTest, PairCacheOwnsTheManifolds) {
+    const Transform identity(Vec3::zero());
+    OverlappingPairCache cache;
+    cache.beginUpdate();
+    cache.addPair(0, 1);
+    cache.addPair(2, 3);
+    cache.endUpdate();
+    EXPECT_EQ(cache.getContactPointCount(), 0u);
+
+    const PairId first = cache.findPair(0, 1);
+    const PairId second = cache.findPair(2, 3);
+    cache.getManifold(first).update(makeContacts({Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f)}),
+                                    identity, identity);
+    cache.getManifold(second).update(makeContacts({Vec3(0.0f, 0.0f, 0.0f)}), identity, identity);
+    EXPECT_EQ(cache.getContactPointCount(), 3u);
+
+    // A pair that stops and starts overlapping again starts from an empty manifold
+    cache.beginUpdate();
+    cache.addPair(2, 3);
+    cache.endUpdate();
+    cache.beginUpdate();
+    cache.addPair(0, 1);
+    cache.addPair(2, 3);
+    cache.endUpdate();
+    EXPECT_EQ(cache.getManifold(cache.findPair(0, 1)).getPointCount(), 0u);
+    EXPECT_EQ(cache.getContactPointCount(), 1u);
+}
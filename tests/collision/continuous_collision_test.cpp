@@ -0,0 +1,291 @@
+#include "axiom/collision/continuous_collision.hpp"
+#include "axiom/collision/collision_layers.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float Dt = 1.0f / 60.0f;
+
+BodyMotion makeMotion(const ConvexShape& shape, const Vec3& position, const Vec3& velocity,
+                      CcdMode mode, const Vec3& angularVelocity = Vec3::zero()) {
+    BodyMotion motion;
+    motion.shape = &shape;
+    motion.transform = Transform(position);
+    motion.linearVelocity = velocity;
+    motion.angularVelocity = angularVelocity;
+    motion.mode = mode;
+    return motion;
+}
+
+bool contains(const AABB& outer, const AABB& inner) {
+    constexpr float Slack = 1.0e-4f;
+    return outer.min.x <= inner.min.x + Slack && outer.min.y <= inner.min.y + Slack &&
+           outer.min.z <= inner.min.z + Slack && outer.max.x >= inner.max.x - Slack &&
+           outer.max.y >= inner.max.y - Slack && outer.max.z >= inner.max.z - Slack;
+}
+
+/// Distance between two bodies at a time of their step
+float distanceAt(const BodyMotion& a, const BodyMotion& b, float time) {
+    return collideConvex(*a.shape, integrateMotion(a, time), *b.shape, integrateMotion(b, time),
+                         std::numeric_limits<float>::max())
+        .distance;
+}
+
+}  // namespace
+
+// ============================================================================
+// Swept bounds
+// ============================================================================
+
+TEST(ContinuousCollisionTest, SweptAABBCoversEveryPoseOfTheStep) {
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f, 0.2f, 0.5f));
+    const BodyMotion motion = makeMotion(box, Vec3(1.0f, 2.0f, 3.0f), Vec3(60.0f, -30.0f, 10.0f),
+                                         CcdMode::Speculative, Vec3(5.0f, 20.0f, -8.0f));
+    const AABB swept = computeSweptAABB(motion, Dt);
+    for (int i = 0; i <= 64; ++i) {
+        const float time = Dt * static_cast<float>(i) / 64.0f;
+        EXPECT_TRUE(contains(swept, box.computeAABB(integrateMotion(motion, time)))) << i;
+    }
+}
+
+TEST(ContinuousCollisionTest, SweptAABBOfTranslationIsTheUnionOfEndBounds) {
+    const ConvexShape sphere = ConvexShape::sphere(0.5f);
+    const BodyMotion motion =
+        makeMotion(sphere, Vec3::zero(), Vec3(120.0f, 0.0f, -60.0f), CcdMode::Bullet);
+    const AABB swept = computeSweptAABB(motion, Dt);
+    const AABB expected = AABB::merge(sphere.computeAABB(motion.transform),
+                                      sphere.computeAABB(integrateMotion(motion, Dt)));
+    EXPECT_NEAR(swept.min.x, expected.min.x, 1.0e-5f);
+    EXPECT_NEAR(swept.max.x, expected.max.x, 1.0e-5f);
+    EXPECT_NEAR(swept.min.z, expected.min.z, 1.0e-5f);
+    EXPECT_NEAR(swept.max.z, expected.max.z, 1.0e-5f);
+
+    // Discrete bodies keep their start bounds
+    const BodyMotion discrete = makeMotion(sphere, Vec3::zero(), Vec3(120.0f, 0.0f, 0.0f),
+                                           CcdMode::None);
+    EXPECT_FLOAT_EQ(computeSweptAABB(discrete, Dt).max.x, 0.5f);
+}
+
+TEST(ContinuousCollisionTest, SweptBoundsPairABulletWithAThinWall) {
+    // A 600 m/s bullet starts 5 m in front of a 2 cm wall and ends 5 m behind it
+    const ConvexShape bullet = ConvexShape::sphere(0.01f);
+    const ConvexShape wall = ConvexShape::box(Vec3(0.01f, 2.0f, 2.0f));
+    const BodyMotion shot = makeMotion(bullet, Vec3(-5.0f, 0.0f, 0.0f), Vec3(600.0f, 0.0f, 0.0f),
+                                       CcdMode::Bullet);
+    const BodyMotion target = makeMotion(wall, Vec3::zero(), Vec3::zero(), CcdMode::None);
+
+    for (const bool swept : {false, true}) {
+        LayeredBroadphase broadphase;
+        const AABB bounds = swept ? computeSweptAABB(shot, Dt) : bullet.computeAABB(shot.transform);
+        broadphase.createProxy(CollisionLayer::Dynamic, bounds, {}, 0);
+        broadphase.createProxy(CollisionLayer::Static, computeSweptAABB(target, Dt), {}, 1);
+        uint32_t pairCount = 0;
+        broadphase.updatePairs([&](ProxyId, ProxyId) { ++pairCount; });
+        EXPECT_EQ(pairCount, swept ? 1u : 0u);
+    }
+}
+
+// ============================================================================
+// Time of impact
+// ============================================================================
+
+TEST(ContinuousCollisionTest, BulletStopsInFrontOfAThinWall) {
+    const ConvexShape bullet = ConvexShape::sphere(0.01f);
+    const ConvexShape wall = ConvexShape::box(Vec3(0.01f, 2.0f, 2.0f));
+    const BodyMotion shot = makeMotion(bullet, Vec3(-5.0f, 0.3f, 0.0f), Vec3(600.0f, 0.0f, 0.0f),
+                                       CcdMode::Bullet);
+    const BodyMotion target = makeMotion(wall, Vec3::zero(), Vec3::zero(), CcdMode::None);
+    const CcdSettings settings;
+
+    // Discretely the bullet is clear of the wall at both ends of the step
+    EXPECT_GT(distanceAt(shot, target, 0.0f), 1.0f);
+    EXPECT_GT(distanceAt(shot, target, Dt), 1.0f);
+
+    const TimeOfImpact impact = computeTimeOfImpact(shot, target, Dt, settings);
+    ASSERT_TRUE(impact.hit);
+    // Contact when the bullet has covered 5 - 0.02 m of its 10 m step
+    EXPECT_NEAR(impact.fraction, (5.0f - 0.02f - settings.toiSeparation) / 10.0f, 1.0e-3f);
+    EXPECT_NEAR(impact.normal.x, 1.0f, 1.0e-3f);
+    const float distance = distanceAt(shot, target, impact.fraction * Dt);
+    EXPECT_GT(distance, 0.0f);
+    EXPECT_LT(distance, 2.0f * settings.toiSeparation);
+}
+
+TEST(ContinuousCollisionTest, SpinningBarImpactsNoLaterThanItsFirstContact) {
+    // A long bar spinning about Z sweeps through a box beside it
+    const ConvexShape bar = ConvexShape::box(Vec3(2.0f, 0.05f, 0.05f));
+    const ConvexShape block = ConvexShape::box(Vec3(0.2f, 0.2f, 0.2f));
+    const BodyMotion spinning = makeMotion(bar, Vec3::zero(), Vec3::zero(), CcdMode::Bullet,
+                                           Vec3(0.0f, 0.0f, 90.0f));
+    const BodyMotion target = makeMotion(block, Vec3(0.0f, 1.5f, 0.0f), Vec3::zero(),
+                                         CcdMode::None);
+
+    const TimeOfImpact impact = computeTimeOfImpact(spinning, target, Dt);
+    ASSERT_TRUE(impact.hit);
+    float firstContact = Dt;
+    for (int i = 0; i <= 1000; ++i) {
+        const float time = Dt * static_cast<float>(i) / 1000.0f;
+        if (distanceAt(spinning, target, time) <= 0.0f) {
+            firstContact = time;
+            break;
+        }
+    }
+    ASSERT_LT(firstContact, Dt);
+    EXPECT_LE(impact.fraction * Dt, firstContact);
+    EXPECT_GT(distanceAt(spinning, target, impact.fraction * Dt), 0.0f);
+}
+
+TEST(ContinuousCollisionTest, MissesAndSeparatingBodiesDoNotImpact) {
+    const ConvexShape sphere = ConvexShape::sphere(0.1f);
+    const ConvexShape wall = ConvexShape::box(Vec3(0.01f, 2.0f, 2.0f));
+    const BodyMotion target = makeMotion(wall, Vec3::zero(), Vec3::zero(), CcdMode::None);
+
+    // Passes above the wall
+    const BodyMotion above = makeMotion(sphere, Vec3(-5.0f, 3.0f, 0.0f),
+                                        Vec3(600.0f, 0.0f, 0.0f), CcdMode::Bullet);
+    EXPECT_FALSE(computeTimeOfImpact(above, target, Dt).hit);
+
+    // Falls short of the wall
+    const BodyMotion slow = makeMotion(sphere, Vec3(-5.0f, 0.0f, 0.0f), Vec3(60.0f, 0.0f, 0.0f),
+                                       CcdMode::Bullet);
+    EXPECT_FALSE(computeTimeOfImpact(slow, target, Dt).hit);
+
+    // Touching the wall and leaving it
+    const BodyMotion leaving = makeMotion(sphere, Vec3(-0.112f, 0.0f, 0.0f),
+                                          Vec3(-60.0f, 0.0f, 0.0f), CcdMode::Bullet);
+    EXPECT_FALSE(computeTimeOfImpact(leaving, target, Dt).hit);
+
+    // Touching the wall and pushing into it
+    const BodyMotion pushing = makeMotion(sphere, Vec3(-0.112f, 0.0f, 0.0f),
+                                          Vec3(60.0f, 0.0f, 0.0f), CcdMode::Bullet);
+    const TimeOfImpact impact = computeTimeOfImpact(pushing, target, Dt);
+    EXPECT_TRUE(impact.hit);
+    EXPECT_FLOAT_EQ(impact.fraction, 0.0f);
+}
+
+TEST(ContinuousCollisionTest, BulletImpactsPlanesAndMeshes) {
+    const ConvexShape bullet = ConvexShape::capsule(0.02f, 0.1f);
+    const std::array<Vec3, 4> vertices = {Vec3(-10.0f, 0.0f, -10.0f), Vec3(10.0f, 0.0f, -10.0f),
+                                          Vec3(10.0f, 0.0f, 10.0f), Vec3(-10.0f, 0.0f, 10.0f)};
+    const std::array<uint32_t, 6> indices = {0, 2, 1, 0, 3, 2};
+    const TriangleMesh mesh = TriangleMesh::create(vertices, indices).value();
+    const ConvexShape ground = ConvexShape::triangleMesh(mesh);
+    const ConvexShape plane = ConvexShape::plane();
+
+    // Fired down at the ground from 4 m, covering 8 m in the step
+    const BodyMotion shot = makeMotion(bullet, Vec3(1.0f, 4.0f, 2.0f),
+                                       Vec3(60.0f, -480.0f, 0.0f), CcdMode::Bullet);
+    const float lowest = 4.0f - 0.05f - 0.02f;
+    for (const ConvexShape* shape : {&ground, &plane}) {
+        const BodyMotion target = makeMotion(*shape, Vec3::zero(), Vec3::zero(), CcdMode::None);
+        const TimeOfImpact impact = computeTimeOfImpact(shot, target, Dt);
+        ASSERT_TRUE(impact.hit);
+        EXPECT_NEAR(impact.fraction, lowest / 8.0f, 1.0e-3f);
+        EXPECT_NEAR(impact.normal.y, -1.0f, 1.0e-3f);
+        EXPECT_NEAR(impact.pointB.y, 0.0f, 1.0e-3f);
+
+        // Same impact with the roles swapped, seen from the other side
+        const TimeOfImpact swapped = computeTimeOfImpact(target, shot, Dt);
+        ASSERT_TRUE(swapped.hit);
+        EXPECT_NEAR(swapped.fraction, impact.fraction, 1.0e-5f);
+        EXPECT_NEAR(swapped.normal.y, 1.0f, 1.0e-3f);
+        EXPECT_NEAR(swapped.pointA.y, 0.0f, 1.0e-3f);
+    }
+}
+
+TEST(ContinuousCollisionTest, BulletImpactsAreOptIn) {
+    const ConvexShape sphere = ConvexShape::sphere(0.05f);
+    const ConvexShape wall = ConvexShape::box(Vec3(0.01f, 2.0f, 2.0f));
+    const std::vector<BodyMotion> bodies = {
+        makeMotion(wall, Vec3::zero(), Vec3::zero(), CcdMode::None),
+        makeMotion(sphere, Vec3(-5.0f, 0.0f, 0.0f), Vec3(600.0f, 0.0f, 0.0f), CcdMode::Bullet),
+        makeMotion(sphere, Vec3(5.0f, 0.5f, 0.0f), Vec3(-300.0f, 0.0f, 0.0f), CcdMode::Bullet),
+        makeMotion(sphere, Vec3(-5.0f, 1.0f, 0.0f), Vec3(600.0f, 0.0f, 0.0f),
+                   CcdMode::Speculative)};
+    const std::vector<std::pair<uint32_t, uint32_t>> pairs = {{0, 1}, {2, 0}, {0, 3}};
+    std::vector<TimeOfImpact> impacts(bodies.size());
+
+    EXPECT_EQ(computeBulletImpacts(bodies, pairs, Dt, impacts), 2u);
+    EXPECT_FALSE(impacts[0].hit);
+    EXPECT_FALSE(impacts[3].hit);
+    ASSERT_TRUE(impacts[1].hit);
+    ASSERT_TRUE(impacts[2].hit);
+    // 0.06 m short of the wall (radius plus half thickness), out of 10 m and 5 m
+    const float stop = 0.06f + CcdSettings{}.toiSeparation;
+    EXPECT_NEAR(impacts[1].fraction, (5.0f - stop) / 10.0f, 1.0e-3f);
+    EXPECT_NEAR(impacts[2].fraction, (5.0f - stop) / 5.0f, 1.0e-3f);
+    // Normals point away from each bullet
+    EXPECT_GT(impacts[1].normal.x, 0.99f);
+    EXPECT_LT(impacts[2].normal.x, -0.99f);
+}
+
+// ============================================================================
+// Speculative contacts
+// ============================================================================
+
+TEST(ContinuousCollisionTest, SpeculativeContactsKeepOnlyApproachingPoints) {
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f, 0.5f, 0.5f));
+    const ConvexShape plane = ConvexShape::plane();
+    const BodyMotion ground = makeMotion(plane, Vec3::zero(), Vec3::zero(), CcdMode::None);
+
+    // 1 m above the ground, falling 1.5 m during the step
+    const BodyMotion falling = makeMotion(box, Vec3(0.0f, 1.5f, 0.0f), Vec3(0.0f, -90.0f, 0.0f),
+                                          CcdMode::Speculative);
+    ContactManifold manifold;
+    generateSpeculativeContacts(falling, ground, Dt, manifold);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, -1.0f, 1.0e-4f);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_NEAR(manifold.points[i].separation, 1.0f, 1.0e-4f);
+    }
+
+    // Same distance, rising: nothing to stop
+    const BodyMotion rising = makeMotion(box, Vec3(0.0f, 1.5f, 0.0f), Vec3(0.0f, 90.0f, 0.0f),
+                                         CcdMode::Speculative);
+    generateSpeculativeContacts(rising, ground, Dt, manifold);
+    EXPECT_EQ(manifold.pointCount, 0u);
+
+    // Falling too slowly to reach the ground this step
+    const BodyMotion slow = makeMotion(box, Vec3(0.0f, 1.5f, 0.0f), Vec3(0.0f, -30.0f, 0.0f),
+                                       CcdMode::Speculative);
+    generateSpeculativeContacts(slow, ground, Dt, manifold);
+    EXPECT_EQ(manifold.pointCount, 0u);
+
+    // Without CCD only the contact margin is queried
+    const BodyMotion discrete = makeMotion(box, Vec3(0.0f, 1.5f, 0.0f), Vec3(0.0f, -90.0f, 0.0f),
+                                           CcdMode::None);
+    generateSpeculativeContacts(discrete, ground, Dt, manifold);
+    EXPECT_EQ(manifold.pointCount, 0u);
+    const BodyMotion resting = makeMotion(box, Vec3(0.0f, 0.51f, 0.0f), Vec3::zero(),
+                                          CcdMode::None);
+    generateSpeculativeContacts(resting, ground, Dt, manifold);
+    EXPECT_EQ(manifold.pointCount, 4u);
+}
+
+TEST(ContinuousCollisionTest, SpeculativeContactsFollowTheVelocityAtEachPoint) {
+    // A tilted bar rotating so that its left end drops and its right end rises
+    const ConvexShape bar = ConvexShape::box(Vec3(1.0f, 0.05f, 0.2f));
+    const ConvexShape plane = ConvexShape::plane();
+    const BodyMotion ground = makeMotion(plane, Vec3::zero(), Vec3::zero(), CcdMode::None);
+    BodyMotion tilting = makeMotion(bar, Vec3(0.0f, 0.2f, 0.0f), Vec3::zero(),
+                                    CcdMode::Speculative, Vec3(0.0f, 0.0f, 12.0f));
+    ContactManifold manifold;
+    generateSpeculativeContacts(tilting, ground, Dt, manifold);
+    ASSERT_GT(manifold.pointCount, 0u);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_LT(manifold.points[i].pointA.x, 0.0f) << i;
+    }
+}
@@ -0,0 +1,255 @@
+#include "axiom/collision/convex_hull.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/shape.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Points on a unit sphere, with interior points mixed in
+std::vector<Vec3> makeBall(size_t surfaceCount, size_t interiorCount, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::vector<Vec3> points;
+    while (points.size() < surfaceCount + interiorCount) {
+        const Vec3 point(component(rng), component(rng), component(rng));
+        const float length = point.length();
+        if (length > 1.0f || length < 0.01f) {
+            continue;
+        }
+        points.push_back(points.size() < surfaceCount ? point / length : point * 0.9f);
+    }
+    return points;
+}
+
+float getSupportBruteForce(std::span<const Vec3> points, const Vec3& direction) {
+    float best = points[0].dot(direction);
+    for (const Vec3& point : points) {
+        best = std::max(best, point.dot(direction));
+    }
+    return best;
+}
+
+/// Closed 2-manifold with outward faces, every point inside every face plane
+void expectValidHull(const ConvexHull& hull, std::span<const Vec3> points, float tolerance) {
+    const uint32_t faceCount = hull.getFaceCount();
+    const std::span<const uint32_t> indices = hull.getIndices();
+    const std::span<const uint32_t> neighbors = hull.getFaceNeighbors();
+    ASSERT_EQ(indices.size(), 3 * size_t{faceCount});
+    ASSERT_EQ(neighbors.size(), 3 * size_t{faceCount});
+
+    // Triangulated sphere: F = 2V - 4
+    EXPECT_EQ(faceCount, 2 * hull.getVertexCount() - 4);
+
+    for (uint32_t face = 0; face < faceCount; ++face) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            // The face across each edge has the same edge the other way
+            const uint32_t from = indices[3 * face + i];
+            const uint32_t to = indices[3 * face + (i + 1) % 3];
+            const uint32_t other = neighbors[3 * face + i];
+            ASSERT_LT(other, faceCount);
+            bool reversed = false;
+            for (uint32_t j = 0; j < 3; ++j) {
+                reversed = reversed || (indices[3 * other + j] == to &&
+                                        indices[3 * other + (j + 1) % 3] == from);
+            }
+            EXPECT_TRUE(reversed) << face << " " << i;
+        }
+    }
+    for (const HullPlane& plane : hull.getPlanes()) {
+        EXPECT_NEAR(plane.normal.length(), 1.0f, 1.0e-5f);
+        for (const Vec3& point : points) {
+            EXPECT_LE(plane.normal.dot(point) - plane.offset, tolerance);
+        }
+    }
+
+    // Each edge twice in the vertex graph, once from each end
+    size_t edgeEnds = 0;
+    for (uint32_t vertex = 0; vertex < hull.getVertexCount(); ++vertex) {
+        const std::span<const uint32_t> adjacent = hull.getVertexNeighbors(vertex);
+        EXPECT_GE(adjacent.size(), 3u);
+        edgeEnds += adjacent.size();
+        const std::set<uint32_t> unique(adjacent.begin(), adjacent.end());
+        EXPECT_EQ(unique.size(), adjacent.size());
+    }
+    EXPECT_EQ(edgeEnds, 3 * size_t{faceCount});
+}
+
+}  // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(ConvexHullTest, CreateRejectsDegenerateInput) {
+    const std::array<Vec3, 3> triangle = {Vec3(0.0f), Vec3(1.0f, 0.0f, 0.0f),
+                                          Vec3(0.0f, 1.0f, 0.0f)};
+    EXPECT_FALSE(ConvexHull::create(triangle).isSuccess());
+
+    const std::array<Vec3, 4> coincident = {Vec3(1.0f), Vec3(1.0f), Vec3(1.0f), Vec3(1.0f)};
+    EXPECT_FALSE(ConvexHull::create(coincident).isSuccess());
+
+    const std::array<Vec3, 5> collinear = {Vec3(0.0f), Vec3(1.0f), Vec3(2.0f), Vec3(-1.0f),
+                                           Vec3(0.5f)};
+    EXPECT_FALSE(ConvexHull::create(collinear).isSuccess());
+
+    std::vector<Vec3> square;
+    for (int i = 0; i < 16; ++i) {
+        square.emplace_back(static_cast<float>(i % 4), 2.0f, static_cast<float>(i / 4));
+    }
+    const auto planar = ConvexHull::create(square);
+    ASSERT_FALSE(planar.isSuccess());
+    EXPECT_EQ(planar.errorCode(), axiom::core::ErrorCode::InvalidShape);
+}
+
+TEST(ConvexHullTest, CubeCloudKeepsOnlyTheCorners) {
+    std::vector<Vec3> points = makeBall(0, 500, 1);
+    for (int corner = 0; corner < 8; ++corner) {
+        points.emplace_back((corner & 1) != 0 ? 1.0f : -1.0f, (corner & 2) != 0 ? 1.0f : -1.0f,
+                            (corner & 4) != 0 ? 1.0f : -1.0f);
+    }
+    // Points in the middle of faces and edges are on the hull, not vertices of it
+    points.emplace_back(0.0f, 1.0f, 0.0f);
+    points.emplace_back(1.0f, 1.0f, 0.0f);
+
+    const auto hull = ConvexHull::create(points);
+    ASSERT_TRUE(hull.isSuccess());
+    EXPECT_EQ(hull.value().getVertexCount(), 8u);
+    EXPECT_EQ(hull.value().getFaceCount(), 12u);
+    expectValidHull(hull.value(), points, 1.0e-4f);
+    EXPECT_FLOAT_EQ(hull.value().getBounds().min.x, -1.0f);
+    EXPECT_FLOAT_EQ(hull.value().getBounds().max.z, 1.0f);
+}
+
+TEST(ConvexHullTest, BallCloudIsAClosedHullAroundEveryPoint) {
+    const std::vector<Vec3> points = makeBall(1000, 1000, 2);
+    ConvexHullConfig config;
+    config.maxVertices = 4096;
+    const auto hull = ConvexHull::create(points, config);
+    ASSERT_TRUE(hull.isSuccess());
+
+    // Every surface point is a vertex; no interior point is
+    EXPECT_EQ(hull.value().getVertexCount(), 1000u);
+    expectValidHull(hull.value(), points, 1.0e-4f);
+}
+
+TEST(ConvexHullTest, MaxVerticesKeepsTheFurthestPoints) {
+    const std::vector<Vec3> points = makeBall(2000, 0, 3);
+    ConvexHullConfig config;
+    config.maxVertices = 64;
+    const auto hull = ConvexHull::create(points, config);
+    ASSERT_TRUE(hull.isSuccess());
+    EXPECT_EQ(hull.value().getVertexCount(), 64u);
+
+    // Still a valid hull of its own vertices, inside the full one and close to it
+    expectValidHull(hull.value(), hull.value().getVertices(), 1.0e-4f);
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    for (int i = 0; i < 200; ++i) {
+        const Vec3 direction = Vec3(component(rng), component(rng), component(rng)).normalized();
+        const float reach = hull.value().support(direction).dot(direction);
+        EXPECT_LE(reach, getSupportBruteForce(points, direction) + 1.0e-6f);
+        EXPECT_GT(reach, 0.85f);
+    }
+}
+
+TEST(ConvexHullTest, FlatCloudsKeepEveryPointInside) {
+    // Thin slabs meet at knife edges, where a point far beyond the hull is
+    // within tolerance of every face plane
+    for (const float thickness : {0.2f, 0.02f, 0.0f}) {
+        for (uint32_t seed = 0; seed < 10; ++seed) {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> component(-0.5f, 0.5f);
+            std::vector<Vec3> points;
+            for (int i = 0; i < 1000; ++i) {
+                // The flat cloud has half its points on one plane, the rest in a slab
+                const float height = thickness == 0.0f && i % 2 == 0 ? 0.02f : thickness;
+                points.emplace_back(200.0f * component(rng), height * component(rng),
+                                    200.0f * component(rng));
+            }
+            ConvexHullConfig config;
+            config.maxVertices = 100000;
+            const auto hull = ConvexHull::create(points, config);
+            ASSERT_TRUE(hull.isSuccess());
+
+            const float tolerance = config.relativeTolerance * 200.0f * std::sqrt(2.0f);
+            expectValidHull(hull.value(), points, tolerance);
+            std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+            for (int i = 0; i < 500; ++i) {
+                const Vec3 axis =
+                    Vec3(direction(rng), direction(rng), direction(rng)).normalized();
+                ASSERT_LE(getSupportBruteForce(points, axis),
+                          hull.value().support(axis).dot(axis) + tolerance)
+                    << "thickness " << thickness << " seed " << seed;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Support
+// ============================================================================
+
+TEST(ConvexHullTest, HillClimbingMatchesALinearScan) {
+    for (const size_t count : {8u, 100u, 2000u}) {
+        const std::vector<Vec3> points = makeBall(count, count, static_cast<uint32_t>(count));
+        ConvexHullConfig config;
+        config.maxVertices = 4096;
+        const auto hull = ConvexHull::create(points, config);
+        ASSERT_TRUE(hull.isSuccess());
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+        for (int i = 0; i < 1000; ++i) {
+            const Vec3 direction(component(rng), component(rng), component(rng));
+            EXPECT_NEAR(hull.value().support(direction).dot(direction),
+                        getSupportBruteForce(points, direction), 1.0e-5f)
+                << count << " " << i;
+        }
+        // Axis directions start at the seeds and tie on flat faces
+        for (const Vec3& axis : {Vec3::unitX(), -Vec3::unitY(), Vec3::unitZ()}) {
+            EXPECT_NEAR(hull.value().support(axis).dot(axis),
+                        getSupportBruteForce(points, axis), 1.0e-6f);
+        }
+    }
+}
+
+TEST(ConvexHullTest, HullShapeCollidesLikeItsPointCloud) {
+    const std::vector<Vec3> points = makeBall(400, 400, 6);
+    ConvexHullConfig config;
+    config.maxVertices = 4096;
+    const auto hull = ConvexHull::create(points, config);
+    ASSERT_TRUE(hull.isSuccess());
+    ASSERT_GT(hull.value().getVertexCount(), ConvexShape::HillClimbThreshold);
+
+    const ConvexShape climbed = ConvexShape::convexHull(hull.value(), 0.05f);
+    const ConvexShape scanned = ConvexShape::convex(points, 0.05f);
+    const ConvexShape box = ConvexShape::box(Vec3(0.3f, 0.4f, 0.5f));
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> component(-2.0f, 2.0f);
+    for (int i = 0; i < 100; ++i) {
+        const Transform transformA(Vec3::zero(),
+                                   Quat::fromAxisAngle(Vec3::unitY(), component(rng)));
+        const Transform transformB(Vec3(component(rng), component(rng), component(rng)),
+                                   Quat::fromAxisAngle(Vec3::unitX(), component(rng)));
+        const ConvexContact expected = collideConvex(scanned, transformA, box, transformB, 10.0f);
+        const ConvexContact actual = collideConvex(climbed, transformA, box, transformB, 10.0f);
+        EXPECT_NEAR(actual.distance, expected.distance, 1.0e-4f) << i;
+        EXPECT_NEAR(climbed.computeAABB(transformA).max.y, scanned.computeAABB(transformA).max.y,
+                    1.0e-6f);
+    }
+}
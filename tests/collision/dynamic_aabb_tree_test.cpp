@@ -0,0 +1,518 @@
+#include "axiom/collision/dynamic_aabb_tree.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+AABB unitBoxAt(const Vec3& center) {
+    return AABB::fromCenterExtents(center, Vec3(0.5f, 0.5f, 0.5f));
+}
+
+std::vector<ProxyId> queryAll(const DynamicAABBTree& tree, const AABB& aabb) {
+    std::vector<ProxyId> hits;
+    tree.query(aabb, [&](ProxyId id) {
+        hits.push_back(id);
+        return true;
+    });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+/// Proxies of a tree scattered over a 100 m cube, with their tight bounds
+struct RebuildScene {
+    DynamicAABBTree tree;
+    std::vector<ProxyId> live;
+    std::vector<Vec3> centers;
+    std::mt19937 rng{7};
+
+    explicit RebuildScene(const DynamicAABBTreeConfig& config, uint32_t count) : tree(config) {
+        for (uint32_t i = 0; i < count; ++i) {
+            create();
+        }
+    }
+
+    void create() {
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        const Vec3 center(position(rng), position(rng), position(rng));
+        const ProxyId id = tree.createProxy(unitBoxAt(center), nextUserData++);
+        centers.resize(std::max<size_t>(centers.size(), id + 1));
+        centers[id] = center;
+        live.push_back(id);
+    }
+
+    /// Create, destroy and move a few proxies, as a step of a game would
+    void step() {
+        std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+        for (int i = 0; i < 8; ++i) {
+            create();
+            const size_t slot = static_cast<size_t>(rng()) % live.size();
+            tree.destroyProxy(live[slot]);
+            live[slot] = live.back();
+            live.pop_back();
+        }
+        for (size_t i = 0; i < live.size(); i += 5) {
+            const ProxyId id = live[i];
+            const Vec3 displacement(offset(rng), offset(rng), offset(rng));
+            centers[id] = centers[id] + displacement;
+            tree.moveProxy(id, unitBoxAt(centers[id]), displacement);
+        }
+    }
+
+    /// Query a few boxes and check against the proxies' fat bounds one by one
+    void expectQueriesMatch() const {
+        std::mt19937 queryRng(11);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        for (int i = 0; i < 20; ++i) {
+            const AABB box = AABB::fromCenterExtents(
+                Vec3(position(queryRng), position(queryRng), position(queryRng)), Vec3(8.0f));
+            std::vector<ProxyId> expected;
+            for (const ProxyId id : live) {
+                EXPECT_TRUE(tree.getFatAABB(id).contains(unitBoxAt(centers[id])));
+                if (tree.getFatAABB(id).intersects(box)) {
+                    expected.push_back(id);
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            EXPECT_EQ(queryAll(tree, box), expected);
+        }
+    }
+
+    uint64_t nextUserData = 0;
+};
+
+}  // namespace
+
+// ============================================================================
+// Proxies
+// ============================================================================
+
+TEST(DynamicAABBTreeTest, EmptyTree) {
+    DynamicAABBTree tree;
+    EXPECT_EQ(tree.getProxyCount(), 0u);
+    EXPECT_EQ(tree.getHeight(), -1);
+    EXPECT_FLOAT_EQ(tree.getAreaRatio(), 0.0f);
+    EXPECT_TRUE(queryAll(tree, unitBoxAt(Vec3::zero())).empty());
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, CreateProxyStoresFatBoundsAndUserData) {
+    DynamicAABBTreeConfig config;
+    config.fatMargin = 0.25f;
+    DynamicAABBTree tree(config);
+
+    const ProxyId id = tree.createProxy(unitBoxAt(Vec3(1, 2, 3)), 42);
+    EXPECT_EQ(tree.getUserData(id), 42u);
+    EXPECT_EQ(tree.getFatAABB(id).min, Vec3(0.25f, 1.25f, 2.25f));
+    EXPECT_EQ(tree.getFatAABB(id).max, Vec3(1.75f, 2.75f, 3.75f));
+    EXPECT_TRUE(tree.wasMoved(id));
+    EXPECT_EQ(tree.getHeight(), 0);
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, DestroyRecyclesNodes) {
+    DynamicAABBTree tree;
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 16; ++i) {
+        ids.push_back(tree.createProxy(unitBoxAt(Vec3(static_cast<float>(i) * 3.0f, 0, 0)), 0));
+    }
+    EXPECT_EQ(tree.getNodeCount(), 31u);
+
+    for (const ProxyId id : ids) {
+        tree.destroyProxy(id);
+        ASSERT_TRUE(tree.validate());
+    }
+    EXPECT_EQ(tree.getProxyCount(), 0u);
+    EXPECT_EQ(tree.getNodeCount(), 0u);
+
+    // Freed nodes are reused before the pool grows
+    const ProxyId reused = tree.createProxy(unitBoxAt(Vec3::zero()), 7);
+    EXPECT_LT(reused, 31u);
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, SmallMoveKeepsProxyInPlace) {
+    DynamicAABBTree tree;
+    const ProxyId id = tree.createProxy(unitBoxAt(Vec3::zero()), 0);
+    tree.clearMoved();
+    const AABB fatBefore = tree.getFatAABB(id);
+
+    // Stays inside the 0.1 margin
+    EXPECT_FALSE(tree.moveProxy(id, unitBoxAt(Vec3(0.05f, 0, 0)), Vec3(0.05f, 0, 0)));
+    EXPECT_EQ(tree.getFatAABB(id), fatBefore);
+    EXPECT_FALSE(tree.wasMoved(id));
+    EXPECT_TRUE(tree.getMovedProxies().empty());
+}
+
+TEST(DynamicAABBTreeTest, EscapingMovePredictsDisplacement) {
+    DynamicAABBTreeConfig config;
+    config.fatMargin = 0.1f;
+    config.displacementMultiplier = 4.0f;
+    DynamicAABBTree tree(config);
+    const ProxyId id = tree.createProxy(unitBoxAt(Vec3::zero()), 0);
+    tree.clearMoved();
+
+    EXPECT_TRUE(tree.moveProxy(id, unitBoxAt(Vec3(1, 0, 0)), Vec3(1, 0, -0.5f)));
+    const AABB& fat = tree.getFatAABB(id);
+
+    // Stretched ahead of the motion only
+    EXPECT_FLOAT_EQ(fat.max.x, 1.5f + 0.1f + 4.0f);
+    EXPECT_FLOAT_EQ(fat.min.x, 0.5f - 0.1f);
+    EXPECT_FLOAT_EQ(fat.min.z, -0.5f - 0.1f - 2.0f);
+    EXPECT_FLOAT_EQ(fat.max.z, 0.5f + 0.1f);
+    EXPECT_TRUE(tree.wasMoved(id));
+
+    // Constant velocity: the next steps stay inside the predicted bounds
+    tree.clearMoved();
+    EXPECT_FALSE(tree.moveProxy(id, unitBoxAt(Vec3(2, 0, -0.5f)), Vec3(1, 0, -0.5f)));
+    EXPECT_FALSE(tree.moveProxy(id, unitBoxAt(Vec3(3, 0, -1.0f)), Vec3(1, 0, -0.5f)));
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAABBTreeTest, BodyComingToRestShrinksProxy) {
+    DynamicAABBTree tree;
+    const ProxyId id = tree.createProxy(unitBoxAt(Vec3::zero()), 0);
+    tree.moveProxy(id, unitBoxAt(Vec3(1, 0, 0)), Vec3(10, 0, 0));
+    EXPECT_GT(tree.getFatAABB(id).max.x, 40.0f);
+
+    // Still contained, but the stretched bounds are now far too large
+    EXPECT_TRUE(tree.moveProxy(id, unitBoxAt(Vec3(1, 0, 0)), Vec3::zero()));
+    EXPECT_FLOAT_EQ(tree.getFatAABB(id).max.x, 1.6f);
+}
+
+// ============================================================================
+// Queries and pairs
+// ============================================================================
+
+TEST(DynamicAABBTreeTest, QueryMatchesBruteForce) {
+    DynamicAABBTree tree;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 500; ++i) {
+        ids.push_back(tree.createProxy(unitBoxAt(Vec3(position(rng), position(rng), position(rng))),
+                                       static_cast<uint64_t>(i)));
+    }
+
+    for (int q = 0; q < 50; ++q) {
+        const AABB region =
+            AABB::fromCenterExtents(Vec3(position(rng), position(rng), position(rng)), Vec3(8.0f));
+        std::vector<ProxyId> expected;
+        for (const ProxyId id : ids) {
+            if (tree.getFatAABB(id).intersects(region)) {
+                expected.push_back(id);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(queryAll(tree, region), expected);
+    }
+}
+
+TEST(DynamicAABBTreeTest, QueryStopsWhenCallbackReturnsFalse) {
+    DynamicAABBTree tree;
+    for (int i = 0; i < 10; ++i) {
+        tree.createProxy(unitBoxAt(Vec3::zero()), 0);
+    }
+
+    int visited = 0;
+    tree.query(unitBoxAt(Vec3::zero()), [&](ProxyId) { return ++visited < 3; });
+    EXPECT_EQ(visited, 3);
+}
+
+TEST(DynamicAABBTreeTest, UpdatePairsReportsEachPairOnce) {
+    DynamicAABBTree tree;
+    const ProxyId a = tree.createProxy(unitBoxAt(Vec3(0, 0, 0)), 0);
+    const ProxyId b = tree.createProxy(unitBoxAt(Vec3(0.8f, 0, 0)), 1);
+    const ProxyId c = tree.createProxy(unitBoxAt(Vec3(1.6f, 0, 0)), 2);
+    tree.createProxy(unitBoxAt(Vec3(20, 0, 0)), 3);
+
+    std::set<std::pair<ProxyId, ProxyId>> pairs;
+    size_t reported = tree.updatePairs([&](ProxyId first, ProxyId second) {
+        EXPECT_LT(first, second);
+        EXPECT_TRUE(pairs.emplace(first, second).second) << "Duplicate pair";
+    });
+    EXPECT_EQ(reported, 2u);
+    EXPECT_EQ(pairs, (std::set<std::pair<ProxyId, ProxyId>>{{a, b}, {b, c}}));
+    EXPECT_TRUE(tree.getMovedProxies().empty());
+
+    // Nothing moved: no pairs
+    EXPECT_EQ(tree.updatePairs([](ProxyId, ProxyId) {}), 0u);
+
+    // Only the moved proxy's pairs are reported again
+    tree.touchProxy(c);
+    pairs.clear();
+    reported =
+        tree.updatePairs([&](ProxyId first, ProxyId second) { pairs.emplace(first, second); });
+    EXPECT_EQ(reported, 1u);
+    EXPECT_EQ(pairs, (std::set<std::pair<ProxyId, ProxyId>>{{b, c}}));
+}
+
+TEST(DynamicAABBTreeTest, DestroyedMovedProxyIsSkipped) {
+    DynamicAABBTree tree;
+    const ProxyId a = tree.createProxy(unitBoxAt(Vec3::zero()), 0);
+    const ProxyId b = tree.createProxy(unitBoxAt(Vec3::zero()), 1);
+    tree.destroyProxy(a);
+
+    ASSERT_EQ(tree.getMovedProxies().size(), 2u);
+    EXPECT_EQ(tree.getMovedProxies()[0], InvalidProxyId);
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.updatePairs([](ProxyId, ProxyId) { ADD_FAILURE() << "Unexpected pair"; }), 0u);
+    EXPECT_FALSE(tree.wasMoved(b));
+}
+
+TEST(DynamicAABBTreeTest, MassDestroyAfterMassMoveLeavesHoles) {
+    DynamicAABBTree tree;
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(tree.createProxy(unitBoxAt(Vec3(static_cast<float>(i) * 3.0f, 0, 0)), 0));
+    }
+    tree.clearMoved();
+    for (const ProxyId id : ids) {
+        tree.touchProxy(id);
+    }
+
+    // Every other proxy goes, then a few come back under recycled ids
+    for (size_t i = 0; i < ids.size(); i += 2) {
+        tree.destroyProxy(ids[i]);
+    }
+    for (int i = 0; i < 10; ++i) {
+        const ProxyId id = tree.createProxy(unitBoxAt(Vec3(static_cast<float>(i) * 6.0f, 0, 0)), 0);
+        EXPECT_EQ(std::count(tree.getMovedProxies().begin(), tree.getMovedProxies().end(), id), 1);
+    }
+    EXPECT_TRUE(tree.validate());
+
+    const auto moved = tree.getMovedProxies();
+    EXPECT_EQ(moved.size(), 1010u);
+    EXPECT_EQ(std::count(moved.begin(), moved.end(), InvalidProxyId), 500);
+    EXPECT_EQ(tree.updatePairs([](ProxyId, ProxyId) {}), 0u);
+}
+
+TEST(DynamicAABBTreeTest, ForEachProxyVisitsAllLeaves) {
+    DynamicAABBTree tree;
+    std::set<uint64_t> expected;
+    for (uint64_t i = 0; i < 20; ++i) {
+        tree.createProxy(unitBoxAt(Vec3(static_cast<float>(i), 0, 0)), i);
+        expected.insert(i);
+    }
+
+    std::set<uint64_t> visited;
+    tree.forEachProxy([&](ProxyId id, const AABB& fatAABB) {
+        EXPECT_EQ(fatAABB, tree.getFatAABB(id));
+        visited.insert(tree.getUserData(id));
+    });
+    EXPECT_EQ(visited, expected);
+}
+
+// ============================================================================
+// Balance and batch updates
+// ============================================================================
+
+TEST(DynamicAABBTreeTest, SortedInsertionStaysBalanced) {
+    DynamicAABBTree tree;
+    for (int i = 0; i < 1024; ++i) {
+        tree.createProxy(unitBoxAt(Vec3(static_cast<float>(i) * 2.0f, 0, 0)), 0);
+    }
+
+    EXPECT_TRUE(tree.validate());
+    EXPECT_LE(tree.getMaxBalance(), 1);
+    // AVL bound: height <= 1.44 log2(n)
+    EXPECT_LE(tree.getHeight(), 15);
+}
+
+TEST(DynamicAABBTreeTest, MoveProxiesMatchesIndividualMoves) {
+    DynamicAABBTree batched;
+    DynamicAABBTree single;
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 64; ++i) {
+        const float x = static_cast<float>(i % 8) * 2.0f;
+        const float z = static_cast<float>(i / 8) * 2.0f;
+        const AABB box = unitBoxAt(Vec3(x, 0, z));
+        ids.push_back(batched.createProxy(box, 0));
+        single.createProxy(box, 0);
+    }
+    batched.clearMoved();
+    single.clearMoved();
+
+    // Every other proxy moves far, the rest jiggle
+    std::vector<ProxyMove> moves;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        const Vec3 displacement = i % 2 == 0 ? Vec3(0, 5, 0) : Vec3(0, 0.01f, 0);
+        const AABB box = batched.getFatAABB(ids[i]);
+        const AABB moved = AABB::fromCenterExtents(box.center() + displacement, Vec3(0.5f));
+        moves.push_back({ids[i], moved, displacement});
+        single.moveProxy(ids[i], moved, displacement);
+    }
+
+    EXPECT_EQ(batched.moveProxies(moves), 32u);
+    EXPECT_TRUE(batched.validate());
+    EXPECT_EQ(batched.getMovedProxies().size(), 32u);
+    for (const ProxyId id : ids) {
+        EXPECT_EQ(batched.getFatAABB(id), single.getFatAABB(id));
+    }
+}
+
+TEST(DynamicAABBTreeTest, StressRandomOperations) {
+    DynamicAABBTree tree;
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    std::vector<ProxyId> live;
+    std::vector<Vec3> centers(4096);
+    for (int i = 0; i < 5000; ++i) {
+        const int choice = action(rng);
+        if (live.empty() || choice < 3) {
+            const Vec3 center(position(rng), position(rng), position(rng));
+            const ProxyId id = tree.createProxy(unitBoxAt(center), 0);
+            ASSERT_LT(id, centers.size());
+            centers[id] = center;
+            live.push_back(id);
+        } else if (choice < 5) {
+            const size_t slot = static_cast<size_t>(rng()) % live.size();
+            tree.destroyProxy(live[slot]);
+            live[slot] = live.back();
+            live.pop_back();
+        } else {
+            const ProxyId id = live[static_cast<size_t>(rng()) % live.size()];
+            const Vec3 displacement(step(rng), step(rng), step(rng));
+            centers[id] = centers[id] + displacement;
+            tree.moveProxy(id, unitBoxAt(centers[id]), displacement);
+        }
+
+        if (i % 500 == 0) {
+            ASSERT_TRUE(tree.validate()) << "after operation " << i;
+        }
+    }
+
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getProxyCount(), live.size());
+    EXPECT_LE(tree.getMaxBalance(), 1);
+}
+
+// ============================================================================
+// Rebuilds
+// ============================================================================
+
+TEST(DynamicAABBTreeTest, SahCostIsTrackedIncrementally) {
+    RebuildScene scene({}, 600);
+    for (int i = 0; i < 10; ++i) {
+        scene.step();
+    }
+
+    // The area ratio counts the leaves as well
+    float leafArea = 0.0f;
+    AABB root;
+    scene.tree.forEachProxy([&](ProxyId, const AABB& fatAABB) {
+        leafArea += fatAABB.surfaceArea();
+        root.merge(fatAABB);
+    });
+    const float expected = scene.tree.getAreaRatio() - leafArea / root.surfaceArea();
+    EXPECT_NEAR(scene.tree.getSahCost(), expected, 1.0e-3f * expected);
+}
+
+TEST(DynamicAABBTreeTest, RebuildLowersCostAndKeepsProxies) {
+    // Sorted insertion: the worst case for incremental insertion
+    DynamicAABBTree tree;
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 512; ++i) {
+        const float x = static_cast<float>(i % 64);
+        const float z = static_cast<float>(i / 64);
+        ids.push_back(tree.createProxy(unitBoxAt(Vec3(x, 0.0f, z)), static_cast<uint64_t>(i)));
+    }
+    const float before = tree.getSahCost();
+    const AABB region(Vec3(10.0f, -1.0f, 2.0f), Vec3(20.0f, 1.0f, 4.0f));
+    const std::vector<ProxyId> hits = queryAll(tree, region);
+
+    tree.rebuild();
+    EXPECT_EQ(tree.getRebuildCount(), 1u);
+    EXPECT_FALSE(tree.isRebuilding());
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getProxyCount(), 512u);
+    EXPECT_EQ(tree.getNodeCount(), 2 * 512u - 1);
+    EXPECT_LT(tree.getSahCost(), before);
+    EXPECT_EQ(queryAll(tree, region), hits);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(tree.getUserData(ids[i]), i);
+    }
+}
+
+TEST(DynamicAABBTreeTest, BackgroundRebuildReplaysDeltas) {
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 2;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    const std::array<axiom::core::JobSystem*, 2> jobSystems = {nullptr, &jobs};
+    for (axiom::core::JobSystem* jobSystem : jobSystems) {
+        RebuildScene scene({.rebuildMinProxies = 64, .rebuildSteps = 3}, 800);
+
+        // The first call starts the rebuild; the tree keeps working meanwhile
+        EXPECT_FALSE(scene.tree.updateRebuild(jobSystem));
+        EXPECT_TRUE(scene.tree.isRebuilding());
+        for (int step = 0; step < 2; ++step) {
+            scene.step();
+            scene.expectQueriesMatch();
+            EXPECT_FALSE(scene.tree.updateRebuild(jobSystem));
+            EXPECT_TRUE(scene.tree.isRebuilding());
+        }
+
+        // The third installs it, with every change made since the snapshot
+        scene.step();
+        EXPECT_TRUE(scene.tree.updateRebuild(jobSystem));
+        EXPECT_FALSE(scene.tree.isRebuilding());
+        EXPECT_EQ(scene.tree.getRebuildCount(), 1u);
+        EXPECT_TRUE(scene.tree.validate());
+        EXPECT_EQ(scene.tree.getProxyCount(), scene.live.size());
+        scene.expectQueriesMatch();
+
+        // A fresh tree does not need another one
+        EXPECT_FALSE(scene.tree.updateRebuild(jobSystem));
+        EXPECT_FALSE(scene.tree.isRebuilding());
+    }
+}
+
+TEST(DynamicAABBTreeTest, RebuildDoesNotDependOnThreads) {
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 3;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    const auto run = [](axiom::core::JobSystem* jobSystem) {
+        RebuildScene scene({.rebuildMinProxies = 64, .rebuildSteps = 2}, 700);
+        for (int step = 0; step < 4; ++step) {
+            scene.tree.updateRebuild(jobSystem);
+            scene.step();
+        }
+        EXPECT_EQ(scene.tree.getRebuildCount(), 1u);
+        std::vector<ProxyId> order;
+        scene.tree.query(AABB(Vec3(-60.0f), Vec3(60.0f)), [&](ProxyId id) {
+            order.push_back(id);
+            return true;
+        });
+        return order;
+    };
+    EXPECT_EQ(run(&jobs), run(nullptr));
+}
+
+TEST(DynamicAABBTreeTest, MovingATreeKeepsItsRebuild) {
+    axiom::core::JobSystem jobs;
+    RebuildScene scene({.rebuildMinProxies = 64, .rebuildSteps = 1}, 300);
+    scene.tree.updateRebuild(&jobs);
+    DynamicAABBTree moved = std::move(scene.tree);
+    EXPECT_TRUE(moved.isRebuilding());
+    EXPECT_TRUE(moved.updateRebuild(&jobs));
+    EXPECT_TRUE(moved.validate());
+    EXPECT_EQ(moved.getProxyCount(), 300u);
+}
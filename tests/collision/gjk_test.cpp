@@ -0,0 +1,337 @@
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/overlapping_pair_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float Tolerance = 1.0e-3f;
+
+Quat randomRotation(std::mt19937& rng) {
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+    Vec3 axis(component(rng), component(rng), component(rng));
+    if (axis.lengthSquared() < 1.0e-3f) {
+        axis = Vec3::unitY();
+    }
+    return Quat::fromAxisAngle(axis.normalized(), angle(rng));
+}
+
+std::array<Vec3, 8> boxCorners(const Vec3& halfExtents) {
+    std::array<Vec3, 8> corners;
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i] = Vec3((i & 1) != 0 ? halfExtents.x : -halfExtents.x,
+                          (i & 2) != 0 ? halfExtents.y : -halfExtents.y,
+                          (i & 4) != 0 ? halfExtents.z : -halfExtents.z);
+    }
+    return corners;
+}
+
+/// Signed distance from a point to an oriented box
+float pointBoxDistance(const Vec3& point, const Transform& box, const Vec3& halfExtents) {
+    const Vec3 local = box.rotation.conjugate() * (point - box.position);
+    Vec3 outside = Vec3::zero();
+    float inside = -1.0e30f;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const float d = std::abs(local[axis]) - halfExtents[axis];
+        outside[axis] = std::max(d, 0.0f);
+        inside = std::max(inside, d);
+    }
+    return outside.lengthSquared() > 0.0f ? outside.length() : inside;
+}
+
+}  // namespace
+
+// ============================================================================
+// Distance and penetration
+// ============================================================================
+
+TEST(GjkTest, SpheresAreExact) {
+    const ConvexShape a = ConvexShape::sphere(1.0f);
+    const ConvexShape b = ConvexShape::sphere(0.5f);
+
+    const ConvexContact apart =
+        collideConvex(a, Transform(Vec3::zero()), b, Transform(Vec3(0, 3, 0)), 5.0f);
+    EXPECT_TRUE(apart.touching);
+    EXPECT_NEAR(apart.distance, 1.5f, Tolerance);
+    EXPECT_NEAR(apart.normal.y, 1.0f, Tolerance);
+    EXPECT_NEAR(apart.pointA.y, 1.0f, Tolerance);
+    EXPECT_NEAR(apart.pointB.y, 2.5f, Tolerance);
+    EXPECT_EQ(apart.epaIterations, 0u);
+
+    // Penetration comes from the radii alone: no EPA
+    const ConvexContact deep =
+        collideConvex(a, Transform(Vec3::zero()), b, Transform(Vec3(1.2f, 0, 0)));
+    EXPECT_TRUE(deep.touching);
+    EXPECT_NEAR(deep.distance, -0.3f, Tolerance);
+    EXPECT_NEAR(deep.normal.x, 1.0f, Tolerance);
+    EXPECT_EQ(deep.epaIterations, 0u);
+
+    const ConvexContact far =
+        collideConvex(a, Transform(Vec3::zero()), b, Transform(Vec3(0, 0, 4)));
+    EXPECT_FALSE(far.touching);
+    EXPECT_GT(far.distance, 0.0f);
+}
+
+TEST(GjkTest, BoxesPenetrateAlongTheShallowAxis) {
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f));
+    const ConvexContact contact = collideConvex(box, Transform(Vec3::zero()), box,
+                                                Transform(Vec3(1.9f, 0.3f, -0.2f)));
+    ASSERT_TRUE(contact.touching);
+    EXPECT_GT(contact.epaIterations, 0u);
+    EXPECT_NEAR(contact.distance, -0.1f, Tolerance);
+    EXPECT_NEAR(contact.normal.x, 1.0f, Tolerance);
+    EXPECT_NEAR(contact.pointA.x, 1.0f, Tolerance);
+    EXPECT_NEAR(contact.pointB.x, 0.9f, Tolerance);
+}
+
+TEST(GjkTest, CapsuleRestingOnBox) {
+    // Lying along X on top of a slab
+    const ConvexShape capsule = ConvexShape::capsule(0.25f, 2.0f);
+    const ConvexShape slab = ConvexShape::box(Vec3(5.0f, 0.5f, 5.0f));
+    const Transform lying(Vec3(0, 0.7f, 0), Quat::fromAxisAngle(Vec3::unitZ(), 1.5707963f));
+
+    const ConvexContact contact =
+        collideConvex(slab, Transform(Vec3::zero()), capsule, lying, 0.1f);
+    ASSERT_TRUE(contact.touching);
+    EXPECT_NEAR(contact.distance, -0.05f, Tolerance);
+    EXPECT_NEAR(contact.normal.y, 1.0f, Tolerance);
+    EXPECT_NEAR(contact.pointA.y, 0.5f, Tolerance);
+    EXPECT_NEAR(contact.pointB.y, 0.45f, Tolerance);
+}
+
+TEST(GjkTest, SphereAgainstRotatedBoxMatchesAnalytic) {
+    const Vec3 halfExtents(1.0f, 0.5f, 2.0f);
+    const ConvexShape box = ConvexShape::box(halfExtents);
+    const ConvexShape sphere = ConvexShape::sphere(0.4f);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-3.0f, 3.0f);
+    int penetrating = 0;
+    for (int i = 0; i < 500; ++i) {
+        const Transform boxTransform(Vec3(0.5f, -0.2f, 0.1f), randomRotation(rng));
+        const Vec3 center(position(rng), position(rng), position(rng));
+
+        const ConvexContact contact =
+            collideConvex(box, boxTransform, sphere, Transform(center), 10.0f);
+        const float expected = pointBoxDistance(center, boxTransform, halfExtents) - 0.4f;
+        ASSERT_TRUE(contact.touching);
+        ASSERT_NEAR(contact.distance, expected, Tolerance) << "case " << i;
+        ASSERT_NEAR(contact.normal.length(), 1.0f, Tolerance);
+        penetrating += contact.distance < 0.0f ? 1 : 0;
+
+        // The witness points are the distance apart along the normal
+        EXPECT_NEAR((contact.pointB - contact.pointA).dot(contact.normal), contact.distance,
+                    Tolerance);
+    }
+    EXPECT_GT(penetrating, 20);
+}
+
+TEST(GjkTest, HullMatchesEquivalentBox) {
+    const Vec3 halfExtents(0.8f, 0.3f, 0.5f);
+    const std::array<Vec3, 8> corners = boxCorners(halfExtents);
+    const ConvexShape hull = ConvexShape::convex(corners);
+    const ConvexShape box = ConvexShape::box(halfExtents);
+    const ConvexShape other = ConvexShape::box(Vec3(0.6f, 0.6f, 0.2f));
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> offset(-1.5f, 1.5f);
+    for (int i = 0; i < 300; ++i) {
+        const Transform transformA(Vec3::zero(), randomRotation(rng));
+        const Transform transformB(Vec3(offset(rng), offset(rng), offset(rng)),
+                                   randomRotation(rng));
+
+        const ConvexContact fromBox = collideConvex(box, transformA, other, transformB, 5.0f);
+        const ConvexContact fromHull = collideConvex(hull, transformA, other, transformB, 5.0f);
+        ASSERT_EQ(fromBox.touching, fromHull.touching);
+        ASSERT_NEAR(fromBox.distance, fromHull.distance, Tolerance) << "case " << i;
+        EXPECT_EQ(overlapConvex(hull, transformA, other, transformB), fromBox.distance < 0.0f)
+            << "case " << i;
+    }
+}
+
+TEST(GjkTest, TiltedBarBelowBoxIsNeverOverlapping) {
+    // The Minkowski difference has a large flat face toward the origin, so GJK
+    // builds nearly flat tetrahedra whose inside test is pure rounding noise
+    const ConvexShape bar = ConvexShape::box(Vec3(2.0f, 0.05f, 0.05f));
+    const ConvexShape box = ConvexShape::box(Vec3(0.2f));
+    const Transform boxTransform(Vec3(0, 1.5f, 0));
+
+    for (int i = 0; i < 2000; ++i) {
+        const float angle = 0.09f * static_cast<float>(i) / 2000.0f;
+        const Transform barTransform(Vec3::zero(), Quat::fromAxisAngle(Vec3::unitZ(), angle));
+
+        const ConvexContact contact = collideConvex(bar, barTransform, box, boxTransform,
+                                                    std::numeric_limits<float>::max());
+        ASSERT_EQ(contact.epaIterations, 0u) << "angle " << angle;
+        ASSERT_GT(contact.distance, 1.2f) << "angle " << angle;
+        ASSERT_LT(contact.distance, 1.3f) << "angle " << angle;
+        ASSERT_FALSE(overlapConvex(bar, barTransform, box, boxTransform)) << "angle " << angle;
+    }
+}
+
+// ============================================================================
+// Warm starting
+// ============================================================================
+
+TEST(GjkTest, WarmStartConvergesInFewIterations) {
+    const std::array<Vec3, 8> corners = boxCorners(Vec3(0.5f));
+    const ConvexShape crate = ConvexShape::convex(corners, 0.02f);
+    const ConvexShape ground = ConvexShape::box(Vec3(10.0f, 0.5f, 10.0f));
+    const Transform groundTransform(Vec3::zero());
+
+    SimplexCache cache;
+    uint32_t coldIterations = 0;
+    uint32_t warmIterations = 0;
+    uint32_t maxWarmIterations = 0;
+    for (int frame = 0; frame < 60; ++frame) {
+        // Sliding and slowly turning just above the ground
+        const float t = static_cast<float>(frame) * 0.01f;
+        const Transform transform(Vec3(t, 1.05f, 0.5f * t),
+                                  Quat::fromAxisAngle(Vec3::unitY(), t));
+
+        const ConvexContact warm = collideConvex(ground, groundTransform, crate, transform,
+                                                 0.1f, &cache);
+        const ConvexContact cold = collideConvex(ground, groundTransform, crate, transform, 0.1f);
+        ASSERT_TRUE(warm.touching);
+        ASSERT_NEAR(warm.distance, cold.distance, Tolerance);
+        if (frame > 0) {
+            warmIterations += warm.gjkIterations;
+            coldIterations += cold.gjkIterations;
+            maxWarmIterations = std::max(maxWarmIterations, warm.gjkIterations);
+        }
+    }
+    EXPECT_LE(maxWarmIterations, 2u);
+    EXPECT_LT(warmIterations, coldIterations);
+}
+
+TEST(GjkTest, CachedAxisRejectsSeparatedPairs) {
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f));
+    SimplexCache cache;
+
+    const ConvexContact first =
+        collideConvex(box, Transform(Vec3::zero()), box, Transform(Vec3(3, 0, 0)), 0.0f, &cache);
+    EXPECT_FALSE(first.touching);
+    EXPECT_FALSE(first.separatedByCache);
+    EXPECT_GT(cache.separatingAxis.lengthSquared(), 0.0f);
+
+    // Still apart: rejected without running GJK
+    const ConvexContact second = collideConvex(box, Transform(Vec3::zero()), box,
+                                               Transform(Vec3(2.5f, 0.2f, 0)), 0.0f, &cache);
+    EXPECT_FALSE(second.touching);
+    EXPECT_TRUE(second.separatedByCache);
+    EXPECT_EQ(second.gjkIterations, 0u);
+    EXPECT_FALSE(overlapConvex(box, Transform(Vec3::zero()), box, Transform(Vec3(2.5f, 0, 0)),
+                               &cache));
+
+    // Moved into contact: the axis no longer separates and GJK runs again
+    const ConvexContact third = collideConvex(box, Transform(Vec3::zero()), box,
+                                              Transform(Vec3(0.9f, 0, 0)), 0.0f, &cache);
+    EXPECT_TRUE(third.touching);
+    EXPECT_FALSE(third.separatedByCache);
+    EXPECT_NEAR(third.distance, -0.1f, Tolerance);
+    EXPECT_EQ(cache.separatingAxis.lengthSquared(), 0.0f);
+}
+
+TEST(GjkTest, PairCacheStartsNewPairsCold) {
+    OverlappingPairCache pairs;
+    pairs.beginUpdate();
+    pairs.addPair(1, 2);
+    pairs.endUpdate();
+    const PairId id = pairs.getAddedPairs()[0];
+    EXPECT_EQ(pairs.getSimplexCache(id).count, 0u);
+
+    const ConvexShape sphere = ConvexShape::sphere(1.0f);
+    collideConvex(sphere, Transform(Vec3::zero()), sphere, Transform(Vec3(1.5f, 0, 0)), 0.0f,
+                  &pairs.getSimplexCache(id));
+    EXPECT_GT(pairs.getPair(id).simplex.count, 0u);
+
+    // Removed, then recycled for another pair
+    pairs.beginUpdate();
+    pairs.endUpdate();
+    pairs.beginUpdate();
+    pairs.addPair(3, 4);
+    pairs.endUpdate();
+    ASSERT_EQ(pairs.getAddedPairs()[0], id);
+    EXPECT_EQ(pairs.getSimplexCache(id).count, 0u);
+}
+
+// ============================================================================
+// Shape casts
+// ============================================================================
+
+TEST(GjkTest, SphereCastStopsAtBoxFace) {
+    const ConvexShape sphere = ConvexShape::sphere(0.5f);
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f));
+    const ConvexCast cast = castConvex(sphere, Transform(Vec3(-5, 0.2f, 0)), Vec3::unitX(), 10.0f,
+                                       box, Transform(Vec3::zero()));
+    ASSERT_TRUE(cast.hit);
+    EXPECT_NEAR(cast.distance, 3.5f, 2.0f * Tolerance);
+    EXPECT_NEAR(cast.normal.x, -1.0f, Tolerance);
+    EXPECT_NEAR(cast.point.x, -1.0f, 2.0f * Tolerance);
+    EXPECT_LE(cast.iterations, 8u);
+}
+
+TEST(GjkTest, PointCastIsARaycast) {
+    // A zero-radius sphere against the top cap of a rotated capsule
+    const ConvexShape point = ConvexShape::sphere(0.0f);
+    const ConvexShape capsule = ConvexShape::capsule(0.5f, 2.0f);
+    const Transform transform(Vec3(0, 1, 0), Quat::fromAxisAngle(Vec3::unitY(), 0.7f));
+    const ConvexCast cast =
+        castConvex(point, Transform(Vec3(0, 6, 0)), -Vec3::unitY(), 10.0f, capsule, transform);
+    ASSERT_TRUE(cast.hit);
+    EXPECT_NEAR(cast.distance, 3.5f, 2.0f * Tolerance);
+    EXPECT_NEAR(cast.normal.y, 1.0f, Tolerance);
+}
+
+TEST(GjkTest, CastMissesAndStartsInside) {
+    const ConvexShape sphere = ConvexShape::sphere(0.5f);
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f));
+
+    // Too short, and moving away
+    EXPECT_FALSE(castConvex(sphere, Transform(Vec3(-5, 0, 0)), Vec3::unitX(), 3.0f, box,
+                            Transform(Vec3::zero()))
+                     .hit);
+    EXPECT_FALSE(castConvex(sphere, Transform(Vec3(-5, 0, 0)), -Vec3::unitX(), 10.0f, box,
+                            Transform(Vec3::zero()))
+                     .hit);
+    // Passing beside the box
+    EXPECT_FALSE(castConvex(sphere, Transform(Vec3(-5, 2, 0)), Vec3::unitX(), 10.0f, box,
+                            Transform(Vec3::zero()))
+                     .hit);
+
+    const ConvexCast inside = castConvex(sphere, Transform(Vec3(1.2f, 0, 0)), Vec3::unitX(), 10.0f,
+                                         box, Transform(Vec3::zero()));
+    ASSERT_TRUE(inside.hit);
+    EXPECT_EQ(inside.distance, 0.0f);
+}
+
+// ============================================================================
+// Bounds
+// ============================================================================
+
+TEST(GjkTest, ComputeAABBCoversShape) {
+    const ConvexShape capsule = ConvexShape::capsule(0.5f, 2.0f);
+    const axiom::math::AABB upright = capsule.computeAABB(Transform(Vec3(1, 2, 3)));
+    EXPECT_NEAR(upright.min.y, 0.5f, Tolerance);
+    EXPECT_NEAR(upright.max.y, 3.5f, Tolerance);
+    EXPECT_NEAR(upright.min.x, 0.5f, Tolerance);
+
+    const ConvexShape box = ConvexShape::box(Vec3(1.0f, 0.5f, 0.5f));
+    const axiom::math::AABB turned =
+        box.computeAABB(Transform(Vec3::zero(), Quat::fromAxisAngle(Vec3::unitZ(), 1.5707963f)));
+    EXPECT_NEAR(turned.max.x, 0.5f, Tolerance);
+    EXPECT_NEAR(turned.max.y, 1.0f, Tolerance);
+}
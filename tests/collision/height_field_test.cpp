@@ -0,0 +1,265 @@
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/continuous_collision.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Rolling hills with a cliff, sampleCount x sampleCount samples
+std::vector<float> makeHeights(uint32_t sampleCount) {
+    std::vector<float> heights;
+    for (uint32_t z = 0; z < sampleCount; ++z) {
+        for (uint32_t x = 0; x < sampleCount; ++x) {
+            const float fx = static_cast<float>(x);
+            const float fz = static_cast<float>(z);
+            const float cliff = x > sampleCount / 2 ? 6.0f : 0.0f;
+            heights.push_back(3.0f * std::sin(fx * 0.21f) * std::cos(fz * 0.13f) + cliff);
+        }
+    }
+    return heights;
+}
+
+HeightField build(std::span<const float> heights, uint32_t sampleCount, float cellSize,
+                  std::span<const uint8_t> materials = {}) {
+    auto result = HeightField::create(heights, sampleCount, sampleCount, cellSize, materials);
+    EXPECT_TRUE(result.isSuccess());
+    return std::move(result).value();
+}
+
+/// The triangles of a height field as a mesh, as a reference
+TriangleMesh toMesh(const HeightField& field) {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    const uint32_t cellCount = field.getStats().cellCount;
+    for (uint32_t triangle = 0; triangle < 2 * cellCount; ++triangle) {
+        for (const Vec3& vertex : field.getTriangle(triangle)) {
+            indices.push_back(static_cast<uint32_t>(vertices.size()));
+            vertices.push_back(vertex);
+        }
+    }
+    return TriangleMesh::create(vertices, indices).value();
+}
+
+AABB triangleBounds(const std::array<Vec3, 3>& vertices) {
+    AABB bounds(vertices[0]);
+    bounds.expand(vertices[1]);
+    bounds.expand(vertices[2]);
+    return bounds;
+}
+
+}  // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(HeightFieldTest, CreateRejectsInvalidInput) {
+    const std::vector<float> heights(16, 1.0f);
+    EXPECT_FALSE(HeightField::create(heights, 1, 16, 1.0f).isSuccess());
+    EXPECT_FALSE(HeightField::create(heights, 4, 3, 1.0f).isSuccess());
+    EXPECT_FALSE(HeightField::create(heights, 4, 4, 0.0f).isSuccess());
+    EXPECT_FALSE(HeightField::create(heights, 4, 4, 1.0f, std::vector<uint8_t>(8)).isSuccess());
+
+    std::vector<float> invalid = heights;
+    invalid[5] = std::nanf("");
+    const auto result = HeightField::create(invalid, 4, 4, 1.0f);
+    ASSERT_FALSE(result.isSuccess());
+    EXPECT_EQ(result.errorCode(), axiom::core::ErrorCode::InvalidShape);
+
+    // Flat terrain is valid, with nothing to quantize
+    const auto flat = HeightField::create(heights, 4, 4, 1.0f, std::vector<uint8_t>(9));
+    ASSERT_TRUE(flat.isSuccess());
+    EXPECT_FLOAT_EQ(flat.value().getHeight(2, 3), 1.0f);
+    EXPECT_FLOAT_EQ(flat.value().getBounds().max.x, 3.0f);
+}
+
+TEST(HeightFieldTest, HeightsAreWithinHalfAStep) {
+    constexpr uint32_t SampleCount = 257;
+    const std::vector<float> heights = makeHeights(SampleCount);
+    const HeightField field = build(heights, SampleCount, 0.5f);
+
+    const auto [lowest, highest] = std::minmax_element(heights.begin(), heights.end());
+    EXPECT_NEAR(field.getHeightStep(), (*highest - *lowest) / 65535.0f, 1.0e-9f);
+    float worst = 0.0f;
+    for (uint32_t z = 0; z < SampleCount; ++z) {
+        for (uint32_t x = 0; x < SampleCount; ++x) {
+            worst = std::max(worst, std::abs(field.getHeight(x, z) - heights[z * SampleCount + x]));
+        }
+    }
+    EXPECT_LE(worst, field.getHeightStep() * 0.5f + 1.0e-5f);
+
+    // Two bytes per sample, plus the pyramid: far below a mesh of the same triangles
+    const HeightFieldStats stats = field.getStats();
+    EXPECT_EQ(stats.cellCount, 256u * 256u);
+    EXPECT_EQ(stats.levelCount, 6u);  // 32x32 blocks of 8x8 cells up to 1x1
+    EXPECT_LT(stats.memoryBytes, SampleCount * SampleCount * 2 + 8192);
+    EXPECT_LT(stats.memoryBytes * 8, toMesh(field).getStats().memoryBytes);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+TEST(HeightFieldTest, QueryAABBReportsEveryOverlappingTriangle) {
+    constexpr uint32_t SampleCount = 101;
+    const std::vector<float> heights = makeHeights(SampleCount);
+    std::vector<uint8_t> materials(100 * 100, 2);
+    materials[50 * 100 + 50] = HeightField::HoleMaterial;
+    const HeightField field = build(heights, SampleCount, 1.0f, materials);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-5.0f, 105.0f);
+    std::uniform_real_distribution<float> height(-4.0f, 10.0f);
+    std::uniform_real_distribution<float> size(0.1f, 6.0f);
+    for (int i = 0; i < 300; ++i) {
+        const AABB box = AABB::fromCenterExtents(Vec3(position(rng), height(rng), position(rng)),
+                                                 Vec3(size(rng), size(rng), size(rng)));
+        std::vector<uint32_t> reported;
+        field.queryAABB(box, [&](uint32_t triangle, const std::array<Vec3, 3>& vertices) {
+            EXPECT_EQ(vertices, field.getTriangle(triangle));
+            EXPECT_EQ(field.getMaterial(triangle), 2u);
+            reported.push_back(triangle);
+            return true;
+        });
+        std::sort(reported.begin(), reported.end());
+
+        // Every triangle whose bounds overlap, and only triangles of cells that do
+        for (uint32_t triangle = 0; triangle < 2 * 100 * 100; ++triangle) {
+            const AABB bounds = triangleBounds(field.getTriangle(triangle));
+            const bool found = std::binary_search(reported.begin(), reported.end(), triangle);
+            if (triangle / 2 == 50 * 100 + 50) {
+                EXPECT_FALSE(found);
+            } else if (bounds.intersects(box)) {
+                EXPECT_TRUE(found) << "box " << i << " triangle " << triangle;
+            }
+        }
+        for (const uint32_t triangle : reported) {
+            AABB cell = triangleBounds(field.getTriangle(triangle & ~1u));
+            cell.merge(triangleBounds(field.getTriangle(triangle | 1u)));
+            cell.expand(1.0f + field.getHeightStep());
+            EXPECT_TRUE(cell.intersects(box)) << "box " << i << " triangle " << triangle;
+        }
+    }
+}
+
+TEST(HeightFieldTest, RaycastMatchesTriangleMesh) {
+    constexpr uint32_t SampleCount = 129;
+    const std::vector<float> heights = makeHeights(SampleCount);
+    const HeightField field = build(heights, SampleCount, 0.75f);
+    const TriangleMesh mesh = toMesh(field);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> position(-10.0f, 106.0f);
+    std::uniform_real_distribution<float> height(-6.0f, 15.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    uint32_t hits = 0;
+    for (int i = 0; i < 2000; ++i) {
+        const Vec3 origin(position(rng), height(rng), position(rng));
+        Vec3 direction(component(rng), component(rng), component(rng));
+        if (i % 10 == 0) {
+            direction = Vec3(0.0f, -1.0f, 0.0f);  // Axis-aligned rays
+        } else if (i % 10 == 1) {
+            direction.y = 0.0f;  // Horizontal rays into the hills
+        }
+        direction = direction.normalized();
+
+        MeshRayHit expected;
+        HeightFieldRayHit hit;
+        const bool onMesh = mesh.raycast(origin, direction, 80.0f, expected);
+        ASSERT_EQ(field.raycast(origin, direction, 80.0f, hit), onMesh) << "ray " << i;
+        if (!onMesh) {
+            continue;
+        }
+        ++hits;
+        EXPECT_NEAR(hit.distance, expected.distance, 1.0e-3f) << "ray " << i;
+        EXPECT_LE(hit.normal.dot(direction), 0.0f);
+        EXPECT_NEAR((hit.point - (origin + direction * hit.distance)).length(), 0.0f, 1.0e-4f);
+    }
+    EXPECT_GT(hits, 400u);
+}
+
+TEST(HeightFieldTest, RaysPassThroughHolesAndReportMaterials) {
+    const std::vector<float> heights(5 * 5, 0.0f);
+    std::vector<uint8_t> materials(16, 7);
+    materials[1 * 4 + 1] = HeightField::HoleMaterial;
+    materials[2 * 4 + 2] = 3;
+    const HeightField field = build(heights, 5, 1.0f, materials);
+
+    HeightFieldRayHit hit;
+    EXPECT_FALSE(field.raycast(Vec3(1.5f, 5.0f, 1.5f), Vec3(0, -1, 0), 10.0f, hit));
+    ASSERT_TRUE(field.raycast(Vec3(2.5f, 5.0f, 2.2f), Vec3(0, -1, 0), 10.0f, hit));
+    EXPECT_FLOAT_EQ(hit.distance, 5.0f);
+    EXPECT_EQ(hit.triangle / 2, 2u * 4 + 2);
+    EXPECT_EQ(hit.material, 3u);
+    EXPECT_GT(hit.normal.y, 0.99f);
+
+    // From below, the two-sided triangles face the ray
+    ASSERT_TRUE(field.raycast(Vec3(0.5f, -1.0f, 3.5f), Vec3(0, 1, 0), 10.0f, hit));
+    EXPECT_EQ(hit.material, 7u);
+    EXPECT_LT(hit.normal.y, -0.99f);
+    EXPECT_FALSE(field.raycast(Vec3(0.5f, -1.0f, 3.5f), Vec3(0, 1, 0), 0.5f, hit));
+}
+
+// ============================================================================
+// Shape
+// ============================================================================
+
+TEST(HeightFieldTest, BoxRestsOnTerrain) {
+    using enum ShapeType;
+    static_assert(getContactKernel(HeightField, Box) == &collideHeightFieldConvex);
+    static_assert(getContactKernel(Capsule, HeightField) ==
+                  &collideFlipped<collideHeightFieldConvex>);
+    static_assert(getContactKernel(HeightField, Mesh) == &collideNothing);
+    static_assert(getContactKernel(HeightField, Plane) == &collideNothing);
+
+    const std::vector<float> heights(33 * 33, 2.0f);
+    const axiom::collision::HeightField field = build(heights, 33, 1.0f);
+    const ConvexShape ground = ConvexShape::heightField(field);
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f));
+    const Transform groundTransform(Vec3(-16.0f, 0.0f, -16.0f));
+    const Transform boxTransform(Vec3(0.3f, 2.49f, -0.2f),
+                                 Quat::fromAxisAngle(Vec3::unitY(), 0.4f));
+
+    const AABB bounds = ground.computeAABB(groundTransform);
+    EXPECT_FLOAT_EQ(bounds.min.x, -16.0f);
+    EXPECT_FLOAT_EQ(bounds.max.y, 2.0f);
+
+    ContactManifold manifold;
+    const ContactPair pair{&box, &boxTransform, &ground, &groundTransform, nullptr};
+    getContactKernel(Box, HeightField)(pair, 0.02f, manifold);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, -1.0f, 1.0e-3f);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_NEAR(manifold.points[i].separation, -0.01f, 1.0e-3f);
+        EXPECT_LT(manifold.points[i].featureId, 2u * 32 * 32);
+    }
+
+    // A sphere shot at the terrain stops on it
+    const ConvexShape ball = ConvexShape::sphere(0.1f);
+    BodyMotion shot;
+    shot.shape = &ball;
+    shot.transform = Transform(Vec3(1.0f, 6.0f, 1.0f));
+    shot.linearVelocity = Vec3(0.0f, -600.0f, 0.0f);
+    shot.mode = CcdMode::Bullet;
+    BodyMotion target;
+    target.shape = &ground;
+    target.transform = groundTransform;
+    const TimeOfImpact impact = computeTimeOfImpact(shot, target, 1.0f / 60.0f);
+    ASSERT_TRUE(impact.hit);
+    EXPECT_NEAR(impact.pointB.y, 2.0f, 1.0e-3f);
+}
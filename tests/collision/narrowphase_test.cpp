@@ -0,0 +1,244 @@
+#include "axiom/collision/narrowphase.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+constexpr float MaxDistance = 0.02f;
+
+constexpr std::array<Vec3, 4> TetrahedronPoints = {
+    Vec3(0.0f, 0.8f, 0.0f), Vec3(-0.7f, -0.4f, 0.5f), Vec3(0.7f, -0.4f, 0.5f),
+    Vec3(0.0f, -0.4f, -0.8f)};
+
+/// Spheres, boxes, capsules and hulls packed in a 12 m cube, so most have neighbours
+struct Scene {
+    std::array<ConvexShape, 4> shapes = {
+        ConvexShape::sphere(0.6f), ConvexShape::box(Vec3(0.5f, 0.4f, 0.6f)),
+        ConvexShape::capsule(0.3f, 1.0f), ConvexShape::convex(TetrahedronPoints, 0.1f)};
+    std::vector<SceneObject> objects;
+
+    explicit Scene(uint32_t count) {
+        std::mt19937 rng(4);
+        std::uniform_real_distribution<float> position(-6.0f, 6.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+        for (uint32_t i = 0; i < count; ++i) {
+            const Vec3 axis = Vec3(position(rng), position(rng), position(rng)).normalized();
+            objects.push_back({&shapes[i % shapes.size()],
+                               Transform(Vec3(position(rng), position(rng), position(rng)),
+                                         Quat::fromAxisAngle(axis, angle(rng)))});
+        }
+    }
+
+    /// Move every object a little, so pairs start and stop overlapping
+    void step(uint32_t frame) {
+        std::mt19937 rng(frame);
+        std::uniform_real_distribution<float> offset(-0.3f, 0.3f);
+        for (SceneObject& object : objects) {
+            object.transform.position += Vec3(offset(rng), offset(rng), offset(rng));
+        }
+    }
+
+    /// Report the pairs whose bounds overlap, as a broadphase would
+    void updatePairs(OverlappingPairCache& cache) const {
+        std::vector<AABB> bounds;
+        for (const SceneObject& object : objects) {
+            AABB box = object.shape->computeAABB(object.transform);
+            bounds.emplace_back(box.min - Vec3(MaxDistance), box.max + Vec3(MaxDistance));
+        }
+        cache.beginUpdate();
+        for (ProxyId a = 0; a < objects.size(); ++a) {
+            for (ProxyId b = a + 1; b < objects.size(); ++b) {
+                if (bounds[a].intersects(bounds[b])) {
+                    cache.addPair(b, a);
+                }
+            }
+        }
+        cache.endUpdate();
+    }
+};
+
+/// Contacts of a few frames of a scene, with or without a job system
+std::vector<std::vector<NarrowphaseContact>> runFrames(axiom::core::JobSystem* jobs,
+                                                       uint32_t batchSize) {
+    Scene scene(600);
+    OverlappingPairCache cache;
+    Narrowphase narrowphase({.batchSize = batchSize});
+    std::vector<std::vector<NarrowphaseContact>> frames;
+    for (uint32_t frame = 0; frame < 4; ++frame) {
+        scene.updatePairs(cache);
+        narrowphase.update(cache, scene.objects, jobs);
+        EXPECT_FALSE(narrowphase.getStats().reordered);
+        const auto contacts = narrowphase.getContacts();
+        frames.emplace_back(contacts.begin(), contacts.end());
+        if (jobs != nullptr) {
+            jobs->flipScratchAllocators();
+        }
+        scene.step(frame + 1);
+    }
+    return frames;
+}
+
+void expectSameContacts(const std::vector<NarrowphaseContact>& expected,
+                        const std::vector<NarrowphaseContact>& actual) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].a, expected[i].a);
+        EXPECT_EQ(actual[i].b, expected[i].b);
+        ASSERT_EQ(actual[i].manifold.pointCount, expected[i].manifold.pointCount);
+        EXPECT_EQ(actual[i].manifold.normal, expected[i].manifold.normal);
+        for (uint32_t k = 0; k < expected[i].manifold.pointCount; ++k) {
+            EXPECT_EQ(actual[i].manifold.points[k].separation,
+                      expected[i].manifold.points[k].separation);
+        }
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Contacts
+// ============================================================================
+
+TEST(NarrowphaseTest, MatchesDispatcherInKeyOrder) {
+    const Scene scene(400);
+    OverlappingPairCache cache;
+    scene.updatePairs(cache);
+    Narrowphase narrowphase({.batchSize = 16});
+    narrowphase.update(cache, scene.objects);
+
+    // Every overlapping pair, generated one at a time
+    uint32_t touching = 0;
+    uint32_t points = 0;
+    cache.forEachPair([&](PairId id, const OverlappingPair& pair) {
+        const SceneObject& a = scene.objects[pair.a];
+        const SceneObject& b = scene.objects[pair.b];
+        ContactManifold manifold;
+        generateContacts({a.shape, &a.transform, b.shape, &b.transform, nullptr}, MaxDistance,
+                         manifold);
+        touching += manifold.pointCount > 0 ? 1u : 0u;
+        points += manifold.pointCount;
+        EXPECT_EQ(cache.getManifold(id).getPointCount(), manifold.pointCount);
+    });
+    ASSERT_GT(touching, 50u);
+
+    const NarrowphaseStats& stats = narrowphase.getStats();
+    EXPECT_EQ(stats.pairCount, cache.getPairCount());
+    EXPECT_EQ(stats.batchCount, (cache.getPairCount() + 15) / 16);
+    EXPECT_EQ(stats.touchingCount, touching);
+    EXPECT_EQ(stats.pointCount, points);
+    EXPECT_EQ(stats.overflowCount, 0u);
+
+    const auto contacts = narrowphase.getContacts();
+    ASSERT_EQ(contacts.size(), touching);
+    for (size_t i = 0; i < contacts.size(); ++i) {
+        const NarrowphaseContact& contact = contacts[i];
+        EXPECT_EQ(cache.getPair(contact.pair).a, contact.a);
+        EXPECT_EQ(cache.getPair(contact.pair).b, contact.b);
+        EXPECT_GT(contact.manifold.pointCount, 0u);
+        if (i > 0) {
+            const NarrowphaseContact& previous = contacts[i - 1];
+            EXPECT_TRUE(previous.a < contact.a ||
+                        (previous.a == contact.a && previous.b < contact.b));
+        }
+    }
+}
+
+TEST(NarrowphaseTest, ObjectsWithoutShapeNeverTouch) {
+    Scene scene(2);
+    scene.objects[0].transform = Transform();
+    scene.objects[1].transform = Transform(Vec3(0.5f, 0.0f, 0.0f));
+    OverlappingPairCache cache;
+    scene.updatePairs(cache);
+    Narrowphase narrowphase;
+    narrowphase.update(cache, scene.objects);
+    ASSERT_EQ(narrowphase.getContacts().size(), 1u);
+    const PairId pair = narrowphase.getContacts()[0].pair;
+    EXPECT_GT(cache.getManifold(pair).getPointCount(), 0u);
+
+    // The pair stays in the cache, but its contacts are cleared
+    std::vector<SceneObject> objects = scene.objects;
+    objects[1].shape = nullptr;
+    narrowphase.update(cache, objects);
+    EXPECT_TRUE(narrowphase.getContacts().empty());
+    EXPECT_EQ(cache.getManifold(pair).getPointCount(), 0u);
+}
+
+// ============================================================================
+// Determinism
+// ============================================================================
+
+TEST(NarrowphaseTest, ResultsDoNotDependOnThreadCount) {
+    const auto serial = runFrames(nullptr, 32);
+    for (uint32_t workers : {1u, 2u, 4u, 8u}) {
+        for (bool participates : {true, false}) {
+            axiom::core::JobSystemConfig config;
+            config.workerCount = workers;
+            config.mainThreadParticipates = participates;
+            axiom::core::JobSystem jobs(config);
+            const auto parallel = runFrames(&jobs, 32);
+            ASSERT_EQ(parallel.size(), serial.size());
+            for (size_t frame = 0; frame < serial.size(); ++frame) {
+                expectSameContacts(serial[frame], parallel[frame]);
+            }
+        }
+    }
+}
+
+TEST(NarrowphaseTest, FullScratchFallsBackToTheHeap) {
+    const auto serial = runFrames(nullptr, 8);
+
+    axiom::core::JobSystemConfig config;
+    config.workerCount = 4;
+    config.scratchBytesPerWorker = 2048;
+    axiom::core::JobSystem jobs(config);
+    Scene scene(600);
+    OverlappingPairCache cache;
+    Narrowphase narrowphase({.batchSize = 8});
+    scene.updatePairs(cache);
+    narrowphase.update(cache, scene.objects, &jobs);
+    EXPECT_GT(narrowphase.getStats().overflowCount, 0u);
+    const auto contacts = narrowphase.getContacts();
+    expectSameContacts(serial[0], {contacts.begin(), contacts.end()});
+}
+
+TEST(NarrowphaseTest, KeyOrderIsPatchedOrRebuilt) {
+    Scene scene(300);
+    OverlappingPairCache cache;
+    Narrowphase narrowphase;
+    scene.updatePairs(cache);
+    narrowphase.update(cache, scene.objects);
+    EXPECT_FALSE(narrowphase.getStats().reordered);
+    const size_t first = narrowphase.getContacts().size();
+
+    // A second update for the same cache update keeps the order
+    narrowphase.update(cache, scene.objects);
+    EXPECT_FALSE(narrowphase.getStats().reordered);
+    EXPECT_EQ(narrowphase.getContacts().size(), first);
+
+    // Missed cache updates have their deltas lost: the order is sorted from scratch
+    for (uint32_t frame = 1; frame <= 3; ++frame) {
+        scene.step(frame);
+        scene.updatePairs(cache);
+    }
+    narrowphase.update(cache, scene.objects);
+    EXPECT_TRUE(narrowphase.getStats().reordered);
+    EXPECT_EQ(narrowphase.getStats().pairCount, cache.getPairCount());
+    const auto contacts = narrowphase.getContacts();
+    for (size_t i = 1; i < contacts.size(); ++i) {
+        EXPECT_LT(uint64_t{contacts[i - 1].a} << 32 | contacts[i - 1].b,
+                  uint64_t{contacts[i].a} << 32 | contacts[i].b);
+    }
+}
@@ -0,0 +1,247 @@
+#include "axiom/collision/overlapping_pair_cache.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+
+namespace {
+
+using PairSet = std::set<std::pair<ProxyId, ProxyId>>;
+
+PairSet toSet(const OverlappingPairCache& cache, std::span<const PairId> ids) {
+    PairSet pairs;
+    for (const PairId id : ids) {
+        pairs.emplace(cache.getPair(id).a, cache.getPair(id).b);
+    }
+    return pairs;
+}
+
+void runFrame(OverlappingPairCache& cache, const PairSet& pairs) {
+    cache.beginUpdate();
+    for (const auto& [a, b] : pairs) {
+        cache.addPair(a, b);
+    }
+    cache.endUpdate();
+}
+
+}  // namespace
+
+// ============================================================================
+// Deltas
+// ============================================================================
+
+TEST(OverlappingPairCacheTest, ReportsAddedAndRemovedPairs) {
+    OverlappingPairCache cache;
+    EXPECT_EQ(cache.getPairCount(), 0u);
+
+    runFrame(cache, {{1, 2}, {2, 3}, {4, 9}});
+    EXPECT_EQ(toSet(cache, cache.getAddedPairs()), (PairSet{{1, 2}, {2, 3}, {4, 9}}));
+    EXPECT_TRUE(cache.getRemovedPairs().empty());
+    EXPECT_EQ(cache.getPairCount(), 3u);
+
+    runFrame(cache, {{1, 2}, {4, 9}, {5, 6}});
+    EXPECT_EQ(toSet(cache, cache.getAddedPairs()), (PairSet{{5, 6}}));
+    EXPECT_EQ(toSet(cache, cache.getRemovedPairs()), (PairSet{{2, 3}}));
+    EXPECT_EQ(cache.getPairCount(), 3u);
+
+    runFrame(cache, {});
+    EXPECT_TRUE(cache.getAddedPairs().empty());
+    EXPECT_EQ(cache.getRemovedPairs().size(), 3u);
+    EXPECT_EQ(cache.getPairCount(), 0u);
+    EXPECT_EQ(cache.getStats().removedCount, 3u);
+}
+
+TEST(OverlappingPairCacheTest, PersistingPairsKeepIdAndUserData) {
+    OverlappingPairCache cache;
+    cache.beginUpdate();
+    cache.addPair(7, 3);  // Order is normalized
+    cache.addPair(3, 7);
+    cache.endUpdate();
+    ASSERT_EQ(cache.getAddedPairs().size(), 1u);
+
+    const PairId id = cache.getAddedPairs()[0];
+    EXPECT_EQ(cache.getPair(id).a, 3u);
+    EXPECT_EQ(cache.getPair(id).b, 7u);
+    EXPECT_EQ(cache.findPair(7, 3), id);
+    cache.setUserData(id, 42);
+
+    for (int frame = 0; frame < 5; ++frame) {
+        runFrame(cache, {{3, 7}});
+        EXPECT_TRUE(cache.getAddedPairs().empty());
+        EXPECT_TRUE(cache.getRemovedPairs().empty());
+    }
+    EXPECT_EQ(cache.findPair(3, 7), id);
+    EXPECT_EQ(cache.getPair(id).userData, 42u);
+    EXPECT_EQ(cache.findPair(3, 8), InvalidPairId);
+}
+
+TEST(OverlappingPairCacheTest, RemovedPairsStayReadableUntilNextUpdate) {
+    OverlappingPairCache cache;
+    runFrame(cache, {{1, 2}});
+    const PairId id = cache.getAddedPairs()[0];
+    cache.setUserData(id, 99);
+
+    runFrame(cache, {});
+    ASSERT_EQ(cache.getRemovedPairs().size(), 1u);
+    EXPECT_EQ(cache.getRemovedPairs()[0], id);
+    EXPECT_EQ(cache.getPair(id).userData, 99u);
+    EXPECT_EQ(cache.findPair(1, 2), InvalidPairId);
+
+    // The id is recycled once the removal has been seen
+    runFrame(cache, {{5, 8}});
+    ASSERT_EQ(cache.getAddedPairs().size(), 1u);
+    EXPECT_EQ(cache.getAddedPairs()[0], id);
+    EXPECT_EQ(cache.getPair(id).userData, 0u);
+    EXPECT_EQ(cache.getPairCapacity(), 1u);
+}
+
+TEST(OverlappingPairCacheTest, RefreshKeepsUnreportedPairs) {
+    OverlappingPairCache cache;
+    runFrame(cache, {{1, 2}, {3, 4}, {5, 6}});
+
+    // Incremental broadphases only report new pairs
+    cache.beginUpdate();
+    cache.addPair(7, 8);
+    cache.refreshPairs([](const OverlappingPair& pair) { return pair.a != 3; });
+    cache.endUpdate();
+
+    EXPECT_EQ(toSet(cache, cache.getAddedPairs()), (PairSet{{7, 8}}));
+    EXPECT_EQ(toSet(cache, cache.getRemovedPairs()), (PairSet{{3, 4}}));
+    EXPECT_EQ(cache.getPairCount(), 3u);
+}
+
+TEST(OverlappingPairCacheTest, RemovePairsContainingProxy) {
+    OverlappingPairCache cache;
+    runFrame(cache, {{1, 2}, {2, 3}, {3, 4}});
+
+    cache.removePairsContaining(2);
+    EXPECT_EQ(cache.getPairCount(), 1u);
+    EXPECT_EQ(cache.findPair(1, 2), InvalidPairId);
+
+    // Proxy 2 was recycled: its pair with 1 is a new pair
+    runFrame(cache, {{1, 2}, {3, 4}});
+    EXPECT_EQ(toSet(cache, cache.getAddedPairs()), (PairSet{{1, 2}}));
+    EXPECT_EQ(toSet(cache, cache.getRemovedPairs()), (PairSet{{1, 2}, {2, 3}}));
+}
+
+TEST(OverlappingPairCacheTest, MatchesReferenceOverManyFrames) {
+    OverlappingPairCacheConfig config;
+    config.initialCapacity = 16;  // Forces growth, overflow and shrinking
+    OverlappingPairCache cache(config);
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<ProxyId> proxy(0, 300);
+    std::map<std::pair<ProxyId, ProxyId>, PairId> reference;
+    PairSet current;
+
+    for (int frame = 0; frame < 60; ++frame) {
+        // Drop some pairs, keep most, add a burst every few frames
+        PairSet next;
+        for (const auto& pair : current) {
+            if (rng() % 10 != 0) {
+                next.insert(pair);
+            }
+        }
+        const int newPairs = frame % 20 == 0 ? 3000 : 50;
+        for (int i = 0; i < newPairs; ++i) {
+            const ProxyId a = proxy(rng);
+            const ProxyId b = proxy(rng);
+            if (a != b) {
+                next.emplace(std::min(a, b), std::max(a, b));
+            }
+        }
+        if (frame % 20 == 10) {
+            next.clear();
+        }
+
+        runFrame(cache, next);
+
+        PairSet expectedAdded;
+        PairSet expectedRemoved;
+        std::set_difference(next.begin(), next.end(), current.begin(), current.end(),
+                            std::inserter(expectedAdded, expectedAdded.end()));
+        std::set_difference(current.begin(), current.end(), next.begin(), next.end(),
+                            std::inserter(expectedRemoved, expectedRemoved.end()));
+        ASSERT_EQ(toSet(cache, cache.getAddedPairs()), expectedAdded) << "frame " << frame;
+        ASSERT_EQ(toSet(cache, cache.getRemovedPairs()), expectedRemoved) << "frame " << frame;
+        ASSERT_EQ(cache.getPairCount(), next.size());
+
+        // Persisting pairs keep their id
+        for (const auto& pair : expectedRemoved) {
+            reference.erase(pair);
+        }
+        for (const PairId id : cache.getAddedPairs()) {
+            reference[{cache.getPair(id).a, cache.getPair(id).b}] = id;
+        }
+        for (const auto& [pair, id] : reference) {
+            ASSERT_EQ(cache.findPair(pair.first, pair.second), id);
+        }
+        current = std::move(next);
+    }
+}
+
+// ============================================================================
+// Concurrent insertion
+// ============================================================================
+
+TEST(OverlappingPairCacheTest, ConcurrentInsertionMatchesSerial) {
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 4;
+    jobConfig.mainThreadParticipates = false;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    OverlappingPairCacheConfig config;
+    config.initialCapacity = 64;  // The first frames overflow the table
+    OverlappingPairCache parallel(config);
+    OverlappingPairCache serial(config);
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<ProxyId> proxy(0, 2000);
+    for (int frame = 0; frame < 8; ++frame) {
+        // Duplicates on purpose: several tasks often find the same pair
+        std::vector<std::pair<ProxyId, ProxyId>> reported;
+        for (int i = 0; i < 20000; ++i) {
+            const ProxyId a = proxy(rng);
+            const ProxyId b = proxy(rng);
+            if (a != b) {
+                reported.emplace_back(a, b);
+                reported.emplace_back(b, a);
+            }
+        }
+
+        parallel.beginUpdate();
+        jobs.parallelFor(static_cast<uint32_t>(reported.size()), 256,
+                         [&](uint32_t begin, uint32_t end) {
+                             for (uint32_t i = begin; i < end; ++i) {
+                                 parallel.addPair(reported[i].first, reported[i].second);
+                             }
+                         });
+        parallel.endUpdate();
+
+        serial.beginUpdate();
+        for (const auto& [a, b] : reported) {
+            serial.addPair(a, b);
+        }
+        serial.endUpdate();
+
+        const auto parallelAdded = parallel.getAddedPairs();
+        const auto serialAdded = serial.getAddedPairs();
+        ASSERT_TRUE(std::equal(parallelAdded.begin(), parallelAdded.end(), serialAdded.begin(),
+                               serialAdded.end()))
+            << "frame " << frame;
+        EXPECT_EQ(parallel.getPairCount(), serial.getPairCount());
+        EXPECT_EQ(toSet(parallel, parallel.getRemovedPairs()),
+                  toSet(serial, serial.getRemovedPairs()));
+    }
+    EXPECT_GT(parallel.getStats().slotCount, 2 * parallel.getPairCount() - 1);
+}
@@ -0,0 +1,477 @@
+#include "axiom/collision/scene_query.hpp"
+#include "axiom/collision/compound_shape.hpp"
+#include "axiom/collision/gjk.hpp"
+#include "axiom/collision/height_field.hpp"
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// castConvex stops within its tolerance of the surface
+constexpr float Tolerance = 5.0e-3f;
+
+constexpr std::array<Vec3, 4> TetrahedronPoints = {
+    Vec3(0.0f, 0.8f, 0.0f), Vec3(-0.7f, -0.4f, 0.5f), Vec3(0.7f, -0.4f, 0.5f),
+    Vec3(0.0f, -0.4f, -0.8f)};
+
+/// Random spheres, boxes, capsules and hulls spread over the three default structures
+struct Scene {
+    LayeredBroadphase broadphase;
+    std::vector<std::unique_ptr<ConvexShape>> shapes;
+    std::vector<SceneObject> objects;
+    std::vector<ProxyId> proxies;
+
+    explicit Scene(uint32_t count, uint32_t seed = 1) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+        std::uniform_real_distribution<float> size(0.3f, 1.5f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+        constexpr std::array<CollisionLayer, 3> Layers = {
+            CollisionLayer::Static, CollisionLayer::Dynamic, CollisionLayer::Debris};
+        for (uint32_t i = 0; i < count; ++i) {
+            switch (i % 4) {
+                case 0:
+                    addShape(ConvexShape::sphere(size(rng)));
+                    break;
+                case 1:
+                    addShape(ConvexShape::box(Vec3(size(rng), size(rng), size(rng))));
+                    break;
+                case 2:
+                    addShape(ConvexShape::capsule(0.5f * size(rng), 2.0f * size(rng)));
+                    break;
+                default:
+                    addShape(ConvexShape::convex(TetrahedronPoints, 0.1f));
+                    break;
+            }
+            const Transform transform(
+                Vec3(position(rng), position(rng), position(rng)),
+                Quat::fromAxisAngle(Vec3(1.0f, 2.0f, 0.5f).normalized(), angle(rng)));
+            addObject(Layers[i % 3], transform, i % 5 == 0 ? 0x2u : 0x1u);
+        }
+        update();
+    }
+
+    void addShape(const ConvexShape& shape) {
+        shapes.push_back(std::make_unique<ConvexShape>(shape));
+    }
+
+    ProxyId addObject(CollisionLayer layer, const Transform& transform, uint32_t category) {
+        objects.push_back({shapes.back().get(), transform});
+        CollisionFilter filter;
+        filter.categoryBits = category;
+        proxies.push_back(broadphase.createProxy(layer, shapes.back()->computeAABB(transform),
+                                                 filter, objects.size() - 1));
+        return proxies.back();
+    }
+
+    void update() {
+        broadphase.updatePairs([](ProxyId, ProxyId) {});
+    }
+
+    SceneQuery query() const { return SceneQuery(broadphase, objects); }
+};
+
+std::vector<Ray> makeRays(uint32_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::vector<Ray> rays;
+    for (uint32_t i = 0; i < count; ++i) {
+        Vec3 direction(component(rng), component(rng), component(rng));
+        if (i % 10 == 0) {
+            direction = Vec3(0.0f, 0.0f, 1.0f);  // Axis-aligned rays
+        }
+        rays.push_back({Vec3(position(rng), position(rng), position(rng)),
+                        direction.normalized(), 30.0f});
+    }
+    return rays;
+}
+
+/// Distance to the first object a ray hits, cast one object at a time
+float bruteForceRay(const Scene& scene, const Ray& ray, uint32_t categoryMask = UINT32_MAX) {
+    float best = std::numeric_limits<float>::infinity();
+    const ConvexShape point = ConvexShape::sphere(0.0f);
+    for (size_t i = 0; i < scene.objects.size(); ++i) {
+        if ((scene.broadphase.getFilter(scene.proxies[i]).categoryBits & categoryMask) == 0) {
+            continue;
+        }
+        const ConvexCast cast = castConvex(point, Transform(ray.origin), ray.direction,
+                                           ray.maxDistance, *scene.objects[i].shape,
+                                           scene.objects[i].transform, 1.0e-5f);
+        if (cast.hit) {
+            best = std::min(best, cast.distance);
+        }
+    }
+    return best;
+}
+
+}  // namespace
+
+// ============================================================================
+// Rays
+// ============================================================================
+
+TEST(SceneQueryTest, RaycastMatchesBruteForce) {
+    const Scene scene(300);
+    const std::vector<Ray> rays = makeRays(1000, 2);
+    std::vector<SceneHit> hits(rays.size());
+    const uint32_t hitCount = scene.query().raycast(rays, hits);
+
+    uint32_t expectedCount = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        const float expected = bruteForceRay(scene, rays[i]);
+        ASSERT_EQ(hits[i].hasHit(), std::isfinite(expected)) << "ray " << i;
+        if (!hits[i].hasHit()) {
+            continue;
+        }
+        ++expectedCount;
+        EXPECT_NEAR(hits[i].distance, expected, Tolerance) << "ray " << i;
+        EXPECT_NEAR(hits[i].normal.length(), 1.0f, 1.0e-3f);
+        if (hits[i].distance > 0.0f) {
+            EXPECT_LE(hits[i].normal.dot(rays[i].direction), 1.0e-3f);
+        }
+        const Vec3 expectedPoint = rays[i].origin + rays[i].direction * hits[i].distance;
+        EXPECT_LT((hits[i].point - expectedPoint).length(), 2.0f * Tolerance);
+    }
+    EXPECT_EQ(hitCount, expectedCount);
+    EXPECT_GT(hitCount, 100u);
+}
+
+TEST(SceneQueryTest, AnyHitAgreesWithClosestHit) {
+    const Scene scene(300);
+    const std::vector<Ray> rays = makeRays(1000, 3);
+    std::vector<SceneHit> closest(rays.size());
+    std::vector<SceneHit> any(rays.size());
+    const uint32_t closestCount = scene.query().raycast(rays, closest);
+    const uint32_t anyCount =
+        scene.query().raycast(rays, any, {.mode = SceneQueryMode::AnyHit});
+
+    EXPECT_EQ(anyCount, closestCount);
+    for (size_t i = 0; i < rays.size(); ++i) {
+        ASSERT_EQ(any[i].hasHit(), closest[i].hasHit()) << "ray " << i;
+        if (any[i].hasHit()) {
+            EXPECT_GE(any[i].distance, closest[i].distance - Tolerance);
+            EXPECT_LE(any[i].distance, rays[i].maxDistance);
+        }
+    }
+}
+
+TEST(SceneQueryTest, LayerAndCategoryMasks) {
+    const Scene scene(300);
+    const std::vector<Ray> rays = makeRays(500, 4);
+    std::vector<SceneHit> hits(rays.size());
+
+    scene.query().raycast(rays, hits, {.layerMask = layerBit(CollisionLayer::Dynamic)});
+    for (const SceneHit& hit : hits) {
+        if (hit.hasHit()) {
+            EXPECT_EQ(scene.broadphase.getLayer(hit.proxy), CollisionLayer::Dynamic);
+        }
+    }
+
+    scene.query().raycast(rays, hits, {.categoryMask = 0x2u});
+    uint32_t hitCount = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        const float expected = bruteForceRay(scene, rays[i], 0x2u);
+        ASSERT_EQ(hits[i].hasHit(), std::isfinite(expected)) << "ray " << i;
+        if (hits[i].hasHit()) {
+            ++hitCount;
+            EXPECT_EQ(scene.broadphase.getFilter(hits[i].proxy).categoryBits, 0x2u);
+            EXPECT_NEAR(hits[i].distance, expected, Tolerance);
+        }
+    }
+    EXPECT_GT(hitCount, 0u);
+}
+
+TEST(SceneQueryTest, RaysHitPlacedMeshAndPlane) {
+    // A tilted square of two triangles above a ground plane
+    const std::vector<Vec3> vertices = {Vec3(-5, 0, -5), Vec3(5, 0, -5), Vec3(5, 0, 5),
+                                        Vec3(-5, 0, 5)};
+    const std::vector<uint32_t> indices = {0, 2, 1, 0, 3, 2};
+    const TriangleMesh mesh = TriangleMesh::create(vertices, indices).value();
+
+    Scene scene(0);
+    scene.addShape(ConvexShape::triangleMesh(mesh));
+    const Transform meshTransform(Vec3(0, 4, 0), Quat::fromAxisAngle(Vec3::unitX(), 0.3f));
+    const ProxyId meshProxy = scene.addObject(CollisionLayer::Static, meshTransform, 0x1u);
+    scene.addShape(ConvexShape::plane());
+    const ProxyId groundProxy =
+        scene.addObject(CollisionLayer::Static, Transform(Vec3::zero()), 0x1u);
+    scene.update();
+
+    std::vector<Ray> rays;
+    for (int i = 0; i < 20; ++i) {
+        const float x = -9.5f + static_cast<float>(i);
+        rays.push_back({Vec3(x, 10.0f, 0.5f), Vec3(0, -1, 0), 20.0f});
+    }
+    std::vector<SceneHit> hits(rays.size());
+    EXPECT_EQ(scene.query().raycast(rays, hits), rays.size());
+
+    const axiom::collision::ShapeFrame frame(meshTransform);
+    for (size_t i = 0; i < rays.size(); ++i) {
+        MeshRayHit expected;
+        const bool onMesh = mesh.raycast(frame.toLocal(rays[i].origin),
+                                         frame.unrotate(rays[i].direction), 20.0f, expected);
+        if (onMesh) {
+            EXPECT_EQ(hits[i].proxy, meshProxy) << "ray " << i;
+            EXPECT_NEAR(hits[i].distance, expected.distance, 1.0e-4f);
+            EXPECT_LT(hits[i].triangle, 2u);
+            EXPECT_GT(hits[i].normal.y, 0.9f);
+        } else {
+            EXPECT_EQ(hits[i].proxy, groundProxy) << "ray " << i;
+            EXPECT_NEAR(hits[i].distance, 10.0f, 1.0e-4f);
+            EXPECT_EQ(hits[i].triangle, UINT32_MAX);
+        }
+    }
+}
+
+TEST(SceneQueryTest, RaysAndCastsHitPlacedHeightField) {
+    // A 16 m slope rising along X, turned a quarter around Y
+    std::vector<float> heights;
+    for (uint32_t z = 0; z < 17; ++z) {
+        for (uint32_t x = 0; x < 17; ++x) {
+            heights.push_back(0.25f * static_cast<float>(x));
+        }
+    }
+    const HeightField terrain = HeightField::create(heights, 17, 17, 1.0f).value();
+
+    Scene scene(0);
+    scene.addShape(ConvexShape::heightField(terrain));
+    const Transform transform(Vec3(-8.0f, 0.0f, 8.0f),
+                              Quat::fromAxisAngle(Vec3::unitY(), 1.5707964f));
+    const ProxyId proxy = scene.addObject(CollisionLayer::Static, transform, 0x1u);
+    scene.update();
+
+    std::vector<Ray> rays;
+    for (int i = 0; i < 12; ++i) {
+        rays.push_back({Vec3(-5.5f + static_cast<float>(i), 10.0f, 0.5f), Vec3(0, -1, 0), 20.0f});
+    }
+    std::vector<SceneHit> hits(rays.size());
+    EXPECT_EQ(scene.query().raycast(rays, hits), rays.size());
+
+    const axiom::collision::ShapeFrame frame(transform);
+    for (size_t i = 0; i < rays.size(); ++i) {
+        HeightFieldRayHit expected;
+        ASSERT_TRUE(terrain.raycast(frame.toLocal(rays[i].origin),
+                                    frame.unrotate(rays[i].direction), 20.0f, expected));
+        EXPECT_EQ(hits[i].proxy, proxy);
+        EXPECT_NEAR(hits[i].distance, expected.distance, 1.0e-4f) << "ray " << i;
+        EXPECT_EQ(hits[i].triangle, expected.triangle);
+        EXPECT_GT(hits[i].normal.y, 0.9f);
+    }
+
+    // A sphere dropped on the slope stops radius / cos(slope) above the surface
+    const ConvexShape ball = ConvexShape::sphere(0.25f);
+    const std::vector<ShapeCast> casts = {
+        {&ball, Transform(Vec3(0.5f, 10.0f, 0.5f)), Vec3(0, -1, 0), 20.0f}};
+    std::vector<SceneHit> castHits(casts.size());
+    EXPECT_EQ(scene.query().shapeCast(casts, castHits), 1u);
+    EXPECT_EQ(castHits[0].proxy, proxy);
+    EXPECT_LT(castHits[0].triangle, 2u * 16 * 16);
+    EXPECT_NEAR(castHits[0].distance, hits[6].distance - 0.25f * std::sqrt(1.0625f), Tolerance);
+}
+
+TEST(SceneQueryTest, RaysAndCastsHitPlacedDistanceField) {
+    // A 2 m cube, raised and turned about Y
+    std::vector<Vec3> vertices;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        vertices.emplace_back((corner & 1) != 0 ? 1.0f : -1.0f, (corner & 2) != 0 ? 1.0f : -1.0f,
+                              (corner & 4) != 0 ? 1.0f : -1.0f);
+    }
+    const std::vector<uint32_t> indices = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                                           2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+    const SignedDistanceField field =
+        SignedDistanceField::create(vertices, indices, {.cellSize = 0.1f, .narrowBand = 0.3f})
+            .value();
+
+    Scene scene(0);
+    scene.addShape(ConvexShape::signedDistanceField(field));
+    const Transform transform(Vec3(0.0f, 2.0f, 0.0f), Quat::fromAxisAngle(Vec3::unitY(), 0.5f));
+    const ProxyId proxy = scene.addObject(CollisionLayer::Static, transform, 0x1u);
+    scene.update();
+
+    const std::vector<Ray> rays = {{Vec3(0.3f, 10.0f, -0.2f), Vec3(0, -1, 0), 20.0f},
+                                   {Vec3(-6.0f, 2.5f, 0.1f), Vec3(1, 0, 0), 20.0f},
+                                   {Vec3(3.0f, 10.0f, 0.0f), Vec3(0, -1, 0), 20.0f}};
+    std::vector<SceneHit> hits(rays.size());
+    EXPECT_EQ(scene.query().raycast(rays, hits), 2u);
+    EXPECT_EQ(hits[0].proxy, proxy);
+    EXPECT_NEAR(hits[0].distance, 7.0f, Tolerance);
+    EXPECT_GT(hits[0].normal.y, 0.99f);
+    EXPECT_EQ(hits[0].triangle, UINT32_MAX);
+    EXPECT_EQ(hits[1].proxy, proxy);
+    EXPECT_LT(hits[1].normal.x, -0.8f);
+    EXPECT_FALSE(hits[2].hasHit());
+
+    // A sphere and a box dropped on top stop on it
+    const ConvexShape ball = ConvexShape::sphere(0.25f);
+    const ConvexShape box = ConvexShape::box(Vec3(0.2f));
+    const std::vector<ShapeCast> casts = {
+        {&ball, Transform(Vec3(0.2f, 10.0f, 0.0f)), Vec3(0, -1, 0), 20.0f},
+        {&box, Transform(Vec3(-0.2f, 10.0f, 0.1f)), Vec3(0, -1, 0), 20.0f}};
+    std::vector<SceneHit> castHits(casts.size());
+    EXPECT_EQ(scene.query().shapeCast(casts, castHits), 2u);
+    EXPECT_EQ(castHits[0].proxy, proxy);
+    EXPECT_NEAR(castHits[0].distance, 7.0f - 0.25f, Tolerance);
+    EXPECT_NEAR(castHits[1].distance, 7.0f - 0.2f, Tolerance);
+    EXPECT_NEAR(castHits[1].point.y, 3.0f, Tolerance);
+}
+
+TEST(SceneQueryTest, RaysAndCastsHitCompoundChildren) {
+    // Two posts with a bar between their tops, turned about Y
+    const std::array<CompoundChild, 3> parts = {
+        CompoundChild{ConvexShape::box(Vec3(0.2f, 1.0f, 0.2f)), Transform(Vec3(-1.5f, 0, 0))},
+        CompoundChild{ConvexShape::box(Vec3(0.2f, 1.0f, 0.2f)), Transform(Vec3(1.5f, 0, 0))},
+        CompoundChild{ConvexShape::capsule(0.2f, 2.0f),
+                      Transform(Vec3(0.0f, 1.2f, 0.0f),
+                                Quat::fromAxisAngle(Vec3::unitZ(), 1.5707964f))}};
+    const CompoundShape gate = CompoundShape::create(parts).value();
+
+    Scene scene(0);
+    scene.addShape(ConvexShape::compoundShape(gate));
+    const Transform transform(Vec3(0.0f, 1.0f, 0.0f), Quat::fromAxisAngle(Vec3::unitY(), 0.3f));
+    const ProxyId proxy = scene.addObject(CollisionLayer::Static, transform, 0x1u);
+    scene.update();
+
+    // Down onto the bar, down through the gap under it (hitting nothing), and onto a post top
+    const Vec3 post = transform.position + transform.rotation * Vec3(1.5f, 0.0f, 0.0f);
+    const std::vector<Ray> rays = {{Vec3(0.0f, 10.0f, 0.0f), Vec3(0, -1, 0), 20.0f},
+                                   {Vec3(0.0f, 1.5f, 5.0f), Vec3(0, 0, -1), 20.0f},
+                                   {Vec3(post.x, 10.0f, post.z), Vec3(0, -1, 0), 20.0f}};
+    std::vector<SceneHit> hits(rays.size());
+    EXPECT_EQ(scene.query().raycast(rays, hits), 2u);
+    EXPECT_EQ(hits[0].proxy, proxy);
+    EXPECT_NEAR(hits[0].distance, 10.0f - 2.4f, Tolerance);
+    EXPECT_GT(hits[0].normal.y, 0.99f);
+    EXPECT_FALSE(hits[1].hasHit());
+    EXPECT_EQ(hits[2].proxy, proxy);
+    EXPECT_NEAR(hits[2].distance, 10.0f - 2.0f, Tolerance);
+
+    // A ball swept along the gate stops at the first post
+    const ConvexShape ball = ConvexShape::sphere(0.1f);
+    const Vec3 along = transform.rotation * Vec3(1.0f, 0.0f, 0.0f);
+    const std::vector<ShapeCast> casts = {
+        {&ball, Transform(transform.position - along * 5.0f), along, 20.0f}};
+    std::vector<SceneHit> castHits(casts.size());
+    EXPECT_EQ(scene.query().shapeCast(casts, castHits), 1u);
+    EXPECT_EQ(castHits[0].proxy, proxy);
+    EXPECT_NEAR(castHits[0].distance, 5.0f - 1.5f - 0.2f - 0.1f, Tolerance);
+}
+
+// ============================================================================
+// Shape casts
+// ============================================================================
+
+TEST(SceneQueryTest, ShapeCastMatchesBruteForce) {
+    const Scene scene(200, 5);
+    const ConvexShape sphere = ConvexShape::sphere(0.4f);
+    const ConvexShape box = ConvexShape::box(Vec3(0.3f, 0.6f, 0.3f));
+
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::vector<ShapeCast> casts;
+    for (int i = 0; i < 300; ++i) {
+        const Vec3 direction =
+            Vec3(component(rng), component(rng), component(rng)).normalized();
+        casts.push_back({i % 2 == 0 ? &sphere : &box,
+                         Transform(Vec3(position(rng), position(rng), position(rng))), direction,
+                         20.0f});
+    }
+    std::vector<SceneHit> hits(casts.size());
+    const uint32_t hitCount = scene.query().shapeCast(casts, hits);
+
+    uint32_t expectedCount = 0;
+    for (size_t i = 0; i < casts.size(); ++i) {
+        float expected = std::numeric_limits<float>::infinity();
+        for (const SceneObject& object : scene.objects) {
+            const ConvexCast cast =
+                castConvex(*casts[i].shape, casts[i].transform, casts[i].direction,
+                           casts[i].maxDistance, *object.shape, object.transform);
+            if (cast.hit) {
+                expected = std::min(expected, cast.distance);
+            }
+        }
+        ASSERT_EQ(hits[i].hasHit(), std::isfinite(expected)) << "cast " << i;
+        if (hits[i].hasHit()) {
+            ++expectedCount;
+            EXPECT_NEAR(hits[i].distance, expected, Tolerance) << "cast " << i;
+        }
+    }
+    EXPECT_EQ(hitCount, expectedCount);
+    EXPECT_GT(hitCount, 30u);
+}
+
+TEST(SceneQueryTest, ShapeCastAgainstMeshAndPlane) {
+    const std::vector<Vec3> vertices = {Vec3(-5, 0, -5), Vec3(5, 0, -5), Vec3(5, 0, 5),
+                                        Vec3(-5, 0, 5)};
+    const std::vector<uint32_t> indices = {0, 2, 1, 0, 3, 2};
+    const TriangleMesh mesh = TriangleMesh::create(vertices, indices).value();
+
+    Scene scene(0);
+    scene.addShape(ConvexShape::triangleMesh(mesh));
+    const ProxyId meshProxy = scene.addObject(CollisionLayer::Static, Transform(Vec3(0, 3, 0)),
+                                              0x1u);
+    scene.addShape(ConvexShape::plane());
+    const ProxyId groundProxy =
+        scene.addObject(CollisionLayer::Static, Transform(Vec3::zero()), 0x1u);
+    scene.update();
+
+    const ConvexShape sphere = ConvexShape::sphere(0.5f);
+    const std::vector<ShapeCast> casts = {
+        {&sphere, Transform(Vec3(1, 8, 1)), Vec3(0, -1, 0), 20.0f},
+        {&sphere, Transform(Vec3(8, 8, 1)), Vec3(0, -1, 0), 20.0f},
+        {&sphere, Transform(Vec3(8, 8, 1)), Vec3(0, -1, 0), 5.0f},
+    };
+    std::vector<SceneHit> hits(casts.size());
+    EXPECT_EQ(scene.query().shapeCast(casts, hits), 2u);
+
+    EXPECT_EQ(hits[0].proxy, meshProxy);
+    EXPECT_NEAR(hits[0].distance, 4.5f, Tolerance);
+    EXPECT_LT(hits[0].triangle, 2u);
+    EXPECT_EQ(hits[1].proxy, groundProxy);
+    EXPECT_NEAR(hits[1].distance, 7.5f, Tolerance);
+    EXPECT_NEAR(hits[1].normal.y, 1.0f, 1.0e-4f);
+    EXPECT_FALSE(hits[2].hasHit());
+}
+
+// ============================================================================
+// Threading
+// ============================================================================
+
+TEST(SceneQueryTest, ParallelBatchesMatchSerial) {
+    const Scene scene(300);
+    const std::vector<Ray> rays = makeRays(2000, 7);
+    axiom::core::JobSystemConfig config;
+    config.workerCount = 4;
+    config.mainThreadParticipates = false;
+    axiom::core::JobSystem jobs(config);
+
+    for (const SceneQueryMode mode : {SceneQueryMode::ClosestHit, SceneQueryMode::AnyHit}) {
+        std::vector<SceneHit> serial(rays.size());
+        std::vector<SceneHit> parallel(rays.size());
+        const uint32_t serialCount = scene.query().raycast(rays, serial, {.mode = mode});
+        const uint32_t parallelCount =
+            scene.query().raycast(rays, parallel, {.mode = mode, .jobSystem = &jobs});
+        EXPECT_EQ(parallelCount, serialCount);
+        for (size_t i = 0; i < rays.size(); ++i) {
+            ASSERT_EQ(parallel[i].proxy, serial[i].proxy) << "ray " << i;
+            ASSERT_EQ(parallel[i].distance, serial[i].distance) << "ray " << i;
+        }
+    }
+}
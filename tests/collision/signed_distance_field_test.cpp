@@ -0,0 +1,288 @@
+#include "axiom/collision/signed_distance_field.hpp"
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Quat;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+/// Closed triangle mesh, counter-clockwise from outside
+struct Mesh {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+};
+
+/// Icosahedron subdivided and pushed out onto a sphere
+Mesh makeIcosphere(float radius, uint32_t subdivisions) {
+    const float t = 0.5f * (1.0f + std::sqrt(5.0f));
+    Mesh mesh;
+    mesh.vertices = {Vec3(-1, t, 0), Vec3(1, t, 0),  Vec3(-1, -t, 0), Vec3(1, -t, 0),
+                     Vec3(0, -1, t), Vec3(0, 1, t),  Vec3(0, -1, -t), Vec3(0, 1, -t),
+                     Vec3(t, 0, -1), Vec3(t, 0, 1),  Vec3(-t, 0, -1), Vec3(-t, 0, 1)};
+    mesh.indices = {0, 11, 5, 0, 5,  1,  0,  1,  7,  0,  7, 10, 0, 10, 11, 1, 5, 9, 5, 11,
+                    4, 11, 10, 2, 10, 7, 6, 7, 1, 8, 3, 9,  4, 3,  4,  2, 3, 2, 6, 3,
+                    6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1};
+    for (uint32_t level = 0; level < subdivisions; ++level) {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+        const auto midpoint = [&](uint32_t a, uint32_t b) {
+            const auto key = std::minmax(a, b);
+            const auto [it, inserted] =
+                midpoints.try_emplace(key, static_cast<uint32_t>(mesh.vertices.size()));
+            if (inserted) {
+                mesh.vertices.push_back((mesh.vertices[a] + mesh.vertices[b]) * 0.5f);
+            }
+            return it->second;
+        };
+        std::vector<uint32_t> indices;
+        for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+            const uint32_t a = mesh.indices[i];
+            const uint32_t b = mesh.indices[i + 1];
+            const uint32_t c = mesh.indices[i + 2];
+            const uint32_t ab = midpoint(a, b);
+            const uint32_t bc = midpoint(b, c);
+            const uint32_t ca = midpoint(c, a);
+            indices.insert(indices.end(), {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca});
+        }
+        mesh.indices = std::move(indices);
+    }
+    for (Vec3& vertex : mesh.vertices) {
+        vertex = vertex.normalized() * radius;
+    }
+    return mesh;
+}
+
+/// Axis-aligned cube of twelve triangles
+Mesh makeCube(float halfExtent) {
+    Mesh mesh;
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+        mesh.vertices.emplace_back((corner & 1) != 0 ? halfExtent : -halfExtent,
+                                   (corner & 2) != 0 ? halfExtent : -halfExtent,
+                                   (corner & 4) != 0 ? halfExtent : -halfExtent);
+    }
+    mesh.indices = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                    2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+    return mesh;
+}
+
+SignedDistanceField build(const Mesh& mesh, const SignedDistanceFieldConfig& config = {}) {
+    auto result = SignedDistanceField::create(mesh.vertices, mesh.indices, config);
+    EXPECT_TRUE(result.isSuccess()) << result.errorMessage();
+    return std::move(result).value();
+}
+
+std::vector<Vec3> makeShellPoints(size_t count, float minRadius, float maxRadius,
+                                  uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> radius(minRadius, maxRadius);
+    std::vector<Vec3> points;
+    while (points.size() < count) {
+        const Vec3 direction(component(rng), component(rng), component(rng));
+        if (direction.length() > 0.1f) {
+            points.push_back(direction.normalized() * radius(rng));
+        }
+    }
+    return points;
+}
+
+}  // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(SignedDistanceFieldTest, CreateRejectsInvalidInput) {
+    const Mesh cube = makeCube(0.5f);
+    const auto create = [&](const SignedDistanceFieldConfig& config) {
+        return SignedDistanceField::create(cube.vertices, cube.indices, config);
+    };
+    EXPECT_EQ(create({.cellSize = 0.0f}).errorCode(), axiom::core::ErrorCode::InvalidShape);
+    EXPECT_EQ(create({.cellSize = 0.1f, .narrowBand = 0.05f}).errorCode(),
+              axiom::core::ErrorCode::InvalidShape);
+    EXPECT_EQ(create({.cellSize = 1.0e-4f, .narrowBand = 1.0e-4f}).errorCode(),
+              axiom::core::ErrorCode::InvalidShape);
+
+    const std::vector<uint32_t> badIndices = {0, 1, 8};
+    EXPECT_FALSE(SignedDistanceField::create(cube.vertices, badIndices).isSuccess());
+
+    // An empty field is never touched
+    const SignedDistanceField empty;
+    DistanceFieldRayHit hit;
+    EXPECT_FALSE(empty.raycast(Vec3::zero(), Vec3::unitX(), 10.0f, hit));
+    EXPECT_GT(empty.sample(Vec3::zero()), 1.0e30f);
+}
+
+TEST(SignedDistanceFieldTest, StoresOnlyTheNarrowBand) {
+    const Mesh sphere = makeIcosphere(1.0f, 3);
+    const SignedDistanceFieldConfig config = {.cellSize = 0.025f, .narrowBand = 0.05f};
+    const SignedDistanceField field = build(sphere, config);
+    const DistanceFieldStats stats = field.getStats();
+    EXPECT_GT(stats.brickCount, 0u);
+    EXPECT_LT(stats.brickCount, stats.brickSlotCount / 2);
+
+    // Less than half of a dense grid of floats over the same box
+    constexpr uint32_t Cells = SignedDistanceField::BrickCells;
+    const uint64_t denseSamples = uint64_t{stats.brickSlotCount} * Cells * Cells * Cells;
+    EXPECT_LT(stats.memoryBytes, denseSamples * sizeof(float) / 2);
+
+    // Building in parallel lays the bricks out identically
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 4;
+    axiom::core::JobSystem jobs(jobConfig);
+    SignedDistanceFieldConfig parallelConfig = config;
+    parallelConfig.jobSystem = &jobs;
+    const SignedDistanceField parallel = build(sphere, parallelConfig);
+    EXPECT_EQ(parallel.getStats().brickCount, stats.brickCount);
+    for (const Vec3& point : makeShellPoints(200, 0.9f, 1.1f, 5)) {
+        EXPECT_EQ(parallel.sample(point), field.sample(point));
+    }
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+TEST(SignedDistanceFieldTest, SphereDistanceAndGradientMatchAnalytic) {
+    const SignedDistanceField field = build(makeIcosphere(1.0f, 4));
+    for (const Vec3& point : makeShellPoints(500, 0.88f, 1.12f, 1)) {
+        Vec3 gradient;
+        const float distance = field.sampleGradient(point, gradient);
+        EXPECT_NEAR(distance, point.length() - 1.0f, 5.0e-3f) << point.x << " " << point.y;
+        EXPECT_NEAR(gradient.length(), 1.0f, 0.1f);
+        EXPECT_GT(gradient.normalized().dot(point.normalized()), 0.98f);
+    }
+
+    // Beyond the band the field only keeps its sign
+    EXPECT_NEAR(field.sample(Vec3(0.2f, 0.1f, 0.0f)), -field.getNarrowBand(), 1.0e-6f);
+    EXPECT_GE(field.sample(Vec3(0.0f, 1.5f, 0.0f)), field.getNarrowBand() - 1.0e-6f);
+    EXPECT_GT(field.sample(Vec3(5.0f, 0.0f, 0.0f)), 3.0f);
+}
+
+TEST(SignedDistanceFieldTest, SignIsRightAtEdgesAndCorners) {
+    // Points near a cube's edges and corners, where face normals alone give the
+    // wrong sign; next to a feature, interpolation is within half a cell
+    constexpr float CellSize = 0.04f;
+    const SignedDistanceField field = build(makeCube(0.5f), {.cellSize = CellSize});
+    const float s = 0.54f;
+    const std::array<Vec3, 3> outside = {Vec3(s, s, s), Vec3(s, s, 0.1f), Vec3(-s, 0.2f, -s)};
+    for (const Vec3& point : outside) {
+        const Vec3 overhang(std::max(std::abs(point.x) - 0.5f, 0.0f),
+                            std::max(std::abs(point.y) - 0.5f, 0.0f),
+                            std::max(std::abs(point.z) - 0.5f, 0.0f));
+        EXPECT_NEAR(field.sample(point), overhang.length(), 0.5f * CellSize);
+    }
+    const float i = 0.45f;
+    const std::array<Vec3, 3> inside = {Vec3(i, i, i), Vec3(-i, i, 0.1f), Vec3(0.2f, -i, -i)};
+    for (const Vec3& point : inside) {
+        EXPECT_NEAR(field.sample(point), -0.05f, 0.5f * CellSize);
+    }
+}
+
+// ============================================================================
+// Collision
+// ============================================================================
+
+TEST(SignedDistanceFieldTest, RaycastFindsTheSurface) {
+    const SignedDistanceField field = build(makeIcosphere(1.0f, 4));
+    DistanceFieldRayHit hit;
+    ASSERT_TRUE(field.raycast(Vec3(-3.0f, 0.3f, 0.0f), Vec3::unitX(), 5.0f, hit));
+    const float surface = std::sqrt(1.0f - 0.09f);
+    EXPECT_NEAR(hit.distance, 3.0f - surface, 5.0e-3f);
+    EXPECT_GT(hit.normal.dot(Vec3(-surface, 0.3f, 0.0f)), 0.99f);
+
+    EXPECT_FALSE(field.raycast(Vec3(-3.0f, 0.3f, 0.0f), Vec3::unitX(), 1.5f, hit));
+    EXPECT_FALSE(field.raycast(Vec3(-3.0f, 1.2f, 0.0f), Vec3::unitX(), 10.0f, hit));
+    ASSERT_TRUE(field.raycast(Vec3(0.1f, 0.0f, 0.0f), Vec3::unitY(), 5.0f, hit));
+    EXPECT_EQ(hit.distance, 0.0f);
+}
+
+TEST(SignedDistanceFieldTest, ParticlesCollideWithPlacedField) {
+    const SignedDistanceField field = build(makeIcosphere(1.0f, 4));
+    const Transform transform(Vec3(3.0f, -1.0f, 2.0f),
+                              Quat::fromAxisAngle(Vec3(1.0f, 1.0f, 0.0f).normalized(), 0.7f));
+    std::vector<Vec3> positions;
+    for (const Vec3& point : makeShellPoints(300, 0.5f, 1.5f, 2)) {
+        positions.push_back(transform.position + point);
+    }
+    positions.push_back(Vec3(40.0f, 0.0f, 0.0f));
+
+    constexpr float Radius = 0.05f;
+    constexpr float MaxDistance = 0.02f;
+    std::vector<DistanceFieldContact> contacts(positions.size());
+    const uint32_t count =
+        field.collideParticles(transform, positions, Radius, MaxDistance, contacts);
+
+    // Particles sunk deeper than the band have no gradient to be pushed out along
+    uint32_t expected = 0;
+    for (const Vec3& position : positions) {
+        const float distance = (position - transform.position).length() - 1.0f;
+        expected += distance - Radius <= MaxDistance && distance > -field.getNarrowBand() ? 1u : 0u;
+    }
+    EXPECT_NEAR(static_cast<float>(count), static_cast<float>(expected), 3.0f);
+    ASSERT_GT(count, 0u);
+
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const DistanceFieldContact& contact = contacts[i];
+        EXPECT_TRUE(i == 0 || contact.particle > previous);
+        previous = contact.particle;
+        const Vec3 offset = positions[contact.particle] - transform.position;
+        EXPECT_NEAR(contact.separation, offset.length() - 1.0f - Radius, 5.0e-3f);
+        EXPECT_LE(contact.separation, MaxDistance);
+        EXPECT_GT(contact.normal.dot(offset.normalized()), 0.98f);
+        EXPECT_NEAR((contact.point - transform.position).length(), 1.0f, 5.0e-3f);
+    }
+}
+
+TEST(SignedDistanceFieldTest, BoxRestsOnField) {
+    using enum ShapeType;
+    static_assert(getContactKernel(DistanceField, Box) == &collideDistanceFieldConvex);
+    static_assert(getContactKernel(Sphere, DistanceField) ==
+                  &collideFlipped<collideDistanceFieldConvex>);
+    static_assert(getContactKernel(DistanceField, Mesh) == &collideNothing);
+    static_assert(getContactKernel(DistanceField, DistanceField) == &collideNothing);
+
+    const SignedDistanceField field = build(makeCube(1.0f));
+    const ConvexShape ground = ConvexShape::signedDistanceField(field);
+    const ConvexShape box = ConvexShape::box(Vec3(0.5f));
+    const Transform groundTransform(Vec3(0.0f, -1.0f, 0.0f));
+    const Transform boxTransform(Vec3(0.1f, 0.49f, -0.2f),
+                                 Quat::fromAxisAngle(Vec3::unitY(), 0.4f));
+
+    const AABB bounds = ground.computeAABB(groundTransform);
+    EXPECT_FLOAT_EQ(bounds.min.y, -2.0f);
+    EXPECT_FLOAT_EQ(bounds.max.y, 0.0f);
+
+    ContactManifold manifold;
+    const ContactPair pair{&box, &boxTransform, &ground, &groundTransform, nullptr};
+    getContactKernel(Box, DistanceField)(pair, 0.02f, manifold);
+    ASSERT_EQ(manifold.pointCount, 4u);
+    EXPECT_NEAR(manifold.normal.y, -1.0f, 1.0e-2f);
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_NEAR(manifold.points[i].separation, -0.01f, 2.0e-3f);
+        EXPECT_NEAR(manifold.points[i].pointB.y, 0.0f, 2.0e-3f);
+        EXPECT_LT(manifold.points[i].featureId, 8u);
+    }
+
+    // A sphere floating clear of the surface has no contact
+    const ConvexShape ball = ConvexShape::sphere(0.2f);
+    const Transform ballTransform(Vec3(0.0f, 0.5f, 0.0f));
+    ContactManifold none;
+    getContactKernel(Sphere, DistanceField)(
+        {&ball, &ballTransform, &ground, &groundTransform, nullptr}, 0.02f, none);
+    EXPECT_EQ(none.pointCount, 0u);
+}
@@ -0,0 +1,277 @@
+#include "axiom/collision/dynamic_aabb_tree.hpp"
+#include "axiom/collision/sweep_and_prune.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+using PairSet = std::set<std::pair<ProxyId, ProxyId>>;
+
+AABB boxAt(const Vec3& center, float halfExtent = 0.5f) {
+    return AABB::fromCenterExtents(center, Vec3(halfExtent));
+}
+
+PairSet collectPairs(SweepAndPrune& sap) {
+    PairSet pairs;
+    const size_t reported = sap.updatePairs([&](ProxyId a, ProxyId b) {
+        EXPECT_LT(a, b);
+        EXPECT_TRUE(pairs.emplace(a, b).second) << "Duplicate pair " << a << ", " << b;
+    });
+    EXPECT_EQ(reported, pairs.size());
+    return pairs;
+}
+
+PairSet bruteForcePairs(const SweepAndPrune& sap, const std::vector<ProxyId>& ids) {
+    PairSet pairs;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            if (sap.getAABB(ids[i]).intersects(sap.getAABB(ids[j]))) {
+                pairs.emplace(std::min(ids[i], ids[j]), std::max(ids[i], ids[j]));
+            }
+        }
+    }
+    return pairs;
+}
+
+}  // namespace
+
+// ============================================================================
+// Pairs
+// ============================================================================
+
+TEST(SweepAndPruneTest, EmptyAndSingleProxy) {
+    SweepAndPrune sap;
+    EXPECT_TRUE(collectPairs(sap).empty());
+
+    sap.createProxy(boxAt(Vec3::zero()), 0);
+    EXPECT_TRUE(collectPairs(sap).empty());
+    EXPECT_EQ(sap.getProxyCount(), 1u);
+}
+
+TEST(SweepAndPruneTest, PairsMatchBruteForce) {
+    SweepAndPrune sap;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> size(0.2f, 2.0f);
+
+    std::vector<ProxyId> ids;
+    for (uint64_t i = 0; i < 800; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(sap.createProxy(boxAt(center, size(rng)), i));
+    }
+
+    const PairSet pairs = collectPairs(sap);
+    EXPECT_FALSE(pairs.empty());
+    EXPECT_EQ(pairs, bruteForcePairs(sap, ids));
+}
+
+TEST(SweepAndPruneTest, CoherentMotionUsesInsertionSort) {
+    SweepAndPrune sap;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> jiggle(-0.05f, 0.05f);
+
+    std::vector<ProxyId> ids;
+    std::vector<Vec3> centers;
+    for (int i = 0; i < 500; ++i) {
+        centers.emplace_back(position(rng), position(rng), position(rng));
+        ids.push_back(sap.createProxy(boxAt(centers.back()), 0));
+    }
+    collectPairs(sap);
+    EXPECT_TRUE(sap.getStats().usedRadixSort);  // Everything was new
+
+    for (int frame = 0; frame < 5; ++frame) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            centers[i] = centers[i] + Vec3(jiggle(rng), jiggle(rng), jiggle(rng));
+            sap.moveProxy(ids[i], boxAt(centers[i]));
+        }
+        const PairSet pairs = collectPairs(sap);
+        EXPECT_FALSE(sap.getStats().usedRadixSort) << "frame " << frame;
+        EXPECT_EQ(pairs, bruteForcePairs(sap, ids)) << "frame " << frame;
+    }
+}
+
+TEST(SweepAndPruneTest, TeleportsFallBackToRadixSort) {
+    SweepAndPrune sap;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 400; ++i) {
+        ids.push_back(sap.createProxy(boxAt(Vec3(position(rng), position(rng), position(rng))), 0));
+    }
+    collectPairs(sap);
+
+    // Scramble every proxy, including negative and positive coordinates
+    for (const ProxyId id : ids) {
+        sap.moveProxy(id, boxAt(Vec3(position(rng), position(rng), position(rng)), 1.5f));
+    }
+    const PairSet pairs = collectPairs(sap);
+    EXPECT_TRUE(sap.getStats().usedRadixSort);
+    EXPECT_EQ(pairs, bruteForcePairs(sap, ids));
+}
+
+TEST(SweepAndPruneTest, DestroyAndRecycleBetweenUpdates) {
+    SweepAndPrune sap;
+    const ProxyId a = sap.createProxy(boxAt(Vec3(0, 0, 0)), 0);
+    const ProxyId b = sap.createProxy(boxAt(Vec3(0.5f, 0, 0)), 1);
+    EXPECT_EQ(collectPairs(sap), (PairSet{{a, b}}));
+
+    // The recycled id must be listed once, with its new bounds
+    sap.destroyProxy(b);
+    const ProxyId c = sap.createProxy(boxAt(Vec3(-0.5f, 0, 0)), 2);
+    EXPECT_EQ(c, b);
+    EXPECT_EQ(sap.getUserData(c), 2u);
+    EXPECT_EQ(collectPairs(sap), (PairSet{{a, c}}));
+
+    sap.destroyProxy(a);
+    EXPECT_TRUE(collectPairs(sap).empty());
+    EXPECT_EQ(sap.getProxyCount(), 1u);
+}
+
+TEST(SweepAndPruneTest, SweepAxisFollowsLongestSpread) {
+    SweepAndPrune sap;
+    for (int i = 0; i < 100; ++i) {
+        sap.createProxy(boxAt(Vec3(0, 0, static_cast<float>(i) * 3.0f)), 0);
+    }
+    sap.update();
+    EXPECT_EQ(sap.getSweepAxis(), 2u);
+
+    // The next update re-sorts on z and still finds nothing
+    EXPECT_TRUE(collectPairs(sap).empty());
+    EXPECT_EQ(sap.getStats().sweepAxis, 2u);
+}
+
+TEST(SweepAndPruneTest, BandsReportEachPairOnce) {
+    SweepAndPrune sap;
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    std::uniform_real_distribution<float> size(0.2f, 1.0f);
+    std::uniform_real_distribution<float> jiggle(-0.2f, 0.2f);
+
+    // Enough proxies to be banded, a few of them spanning many bands
+    std::vector<ProxyId> ids;
+    std::vector<Vec3> centers;
+    std::vector<float> sizes;
+    for (uint64_t i = 0; i < 2000; ++i) {
+        centers.emplace_back(position(rng), position(rng), position(rng));
+        sizes.push_back(i % 100 == 0 ? 8.0f : size(rng));
+        ids.push_back(sap.createProxy(boxAt(centers.back(), sizes.back()), i));
+    }
+    EXPECT_EQ(collectPairs(sap), bruteForcePairs(sap, ids));
+    EXPECT_EQ(sap.getStats().bandWidth, 0.0f);  // Layout not chosen yet
+
+    for (int frame = 0; frame < 4; ++frame) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            centers[i] = centers[i] + Vec3(jiggle(rng), jiggle(rng), jiggle(rng));
+            sap.moveProxy(ids[i], boxAt(centers[i], sizes[i]));
+        }
+        EXPECT_EQ(collectPairs(sap), bruteForcePairs(sap, ids)) << "frame " << frame;
+        EXPECT_GT(sap.getStats().bandWidth, 0.0f);
+        EXPECT_GT(sap.getStats().entryCount, sap.getProxyCount());
+    }
+
+    // Queries spanning several bands report each proxy once
+    for (int q = 0; q < 20; ++q) {
+        const AABB region = boxAt(Vec3(position(rng), position(rng), position(rng)), 5.0f);
+        std::vector<ProxyId> hits;
+        sap.query(region, [&](ProxyId id) {
+            hits.push_back(id);
+            return true;
+        });
+        std::vector<ProxyId> expected;
+        for (const ProxyId id : ids) {
+            if (sap.getAABB(id).intersects(region)) {
+                expected.push_back(id);
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(hits, expected);
+    }
+}
+
+TEST(SweepAndPruneTest, QueryMatchesBruteForce) {
+    SweepAndPrune sap;
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 600; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(sap.createProxy(boxAt(center, size(rng)), 0));
+    }
+    sap.update();
+
+    for (int q = 0; q < 40; ++q) {
+        const AABB region = boxAt(Vec3(position(rng), position(rng), position(rng)), 6.0f);
+        std::vector<ProxyId> hits;
+        sap.query(region, [&](ProxyId id) {
+            hits.push_back(id);
+            return true;
+        });
+        std::vector<ProxyId> expected;
+        for (const ProxyId id : ids) {
+            if (sap.getAABB(id).intersects(region)) {
+                expected.push_back(id);
+            }
+        }
+        std::sort(hits.begin(), hits.end());
+        EXPECT_EQ(hits, expected);
+    }
+}
+
+TEST(SweepAndPruneTest, ParallelRadixSortMatchesTree) {
+    // Large enough for the radix sort to be split across workers
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 4;
+    jobConfig.mainThreadParticipates = false;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    SweepAndPruneConfig config;
+    config.jobSystem = &jobs;
+    SweepAndPrune sap(config);
+
+    DynamicAABBTreeConfig treeConfig;
+    treeConfig.fatMargin = 0.0f;
+    DynamicAABBTree tree(treeConfig);
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    for (uint64_t i = 0; i < 20000; ++i) {
+        const AABB box = boxAt(Vec3(position(rng), position(rng), position(rng)));
+        sap.createProxy(box, i);
+        tree.createProxy(box, i);
+    }
+
+    // Compare by user data: the two structures assign different ids
+    std::set<std::pair<uint64_t, uint64_t>> expected;
+    tree.updatePairs([&](ProxyId a, ProxyId b) {
+        expected.emplace(std::minmax(tree.getUserData(a), tree.getUserData(b)));
+    });
+    EXPECT_FALSE(expected.empty());
+
+    // The first update sweeps a single band, the second re-sorts into bands
+    for (int update = 0; update < 2; ++update) {
+        std::set<std::pair<uint64_t, uint64_t>> pairs;
+        sap.updatePairs([&](ProxyId a, ProxyId b) {
+            pairs.emplace(std::minmax(sap.getUserData(a), sap.getUserData(b)));
+        });
+        EXPECT_TRUE(sap.getStats().usedRadixSort);
+        EXPECT_EQ(pairs, expected) << "update " << update;
+    }
+    EXPECT_GT(sap.getStats().bandWidth, 0.0f);
+}
@@ -0,0 +1,378 @@
+#include "axiom/collision/contact_kernels.hpp"
+#include "axiom/collision/triangle_mesh.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Transform;
+using axiom::math::Vec3;
+
+namespace {
+
+struct MeshData {
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+
+    std::array<Vec3, 3> triangle(uint32_t t) const {
+        return {vertices[indices[3 * t]], vertices[indices[3 * t + 1]],
+                vertices[indices[3 * t + 2]]};
+    }
+    uint32_t triangleCount() const { return static_cast<uint32_t>(indices.size() / 3); }
+};
+
+/// Gently rolling terrain of cells x cells quads over [-size, size]^2
+MeshData makeTerrain(uint32_t cells, float size) {
+    MeshData mesh;
+    const float step = 2.0f * size / static_cast<float>(cells);
+    for (uint32_t z = 0; z <= cells; ++z) {
+        for (uint32_t x = 0; x <= cells; ++x) {
+            const float px = -size + step * static_cast<float>(x);
+            const float pz = -size + step * static_cast<float>(z);
+            mesh.vertices.emplace_back(px, 0.3f * std::sin(px * 0.5f) * std::cos(pz * 0.5f), pz);
+        }
+    }
+    for (uint32_t z = 0; z < cells; ++z) {
+        for (uint32_t x = 0; x < cells; ++x) {
+            const uint32_t i = z * (cells + 1) + x;
+            mesh.indices.insert(mesh.indices.end(), {i, i + cells + 1, i + 1});
+            mesh.indices.insert(mesh.indices.end(), {i + 1, i + cells + 1, i + cells + 2});
+        }
+    }
+    return mesh;
+}
+
+/// Random triangles of about the given size in a cube of half-size extent
+MeshData makeSoup(uint32_t triangles, float extent, float size, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-extent, extent);
+    std::uniform_real_distribution<float> offset(-size, size);
+    MeshData mesh;
+    for (uint32_t t = 0; t < triangles; ++t) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        for (uint32_t k = 0; k < 3; ++k) {
+            mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+            mesh.vertices.push_back(center + Vec3(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+    return mesh;
+}
+
+/// One triangle of a mesh, on its own
+MeshData single(const MeshData& data, uint32_t t) {
+    const std::array<Vec3, 3> vertices = data.triangle(t);
+    return {{vertices[0], vertices[1], vertices[2]}, {0, 1, 2}};
+}
+
+TriangleMesh build(const MeshData& data, const TriangleMeshConfig& config = {}) {
+    auto result = TriangleMesh::create(data.vertices, data.indices, config);
+    EXPECT_TRUE(result.isSuccess());
+    return std::move(result).value();
+}
+
+AABB triangleBounds(const std::array<Vec3, 3>& vertices) {
+    AABB bounds(vertices[0]);
+    bounds.expand(vertices[1]);
+    bounds.expand(vertices[2]);
+    return bounds;
+}
+
+std::vector<uint32_t> queryTriangles(const TriangleMesh& mesh, const AABB& box) {
+    std::vector<uint32_t> triangles;
+    mesh.queryAABB(box, [&](uint32_t triangle, const std::array<Vec3, 3>&) {
+        triangles.push_back(triangle);
+        return true;
+    });
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+/// Brute-force two-sided ray cast, as a reference
+float rayDistance(const MeshData& data, const Vec3& origin, const Vec3& direction,
+                  float maxDistance) {
+    float closest = std::numeric_limits<float>::infinity();
+    for (uint32_t t = 0; t < data.triangleCount(); ++t) {
+        const std::array<Vec3, 3> v = data.triangle(t);
+        const Vec3 edge1 = v[1] - v[0];
+        const Vec3 edge2 = v[2] - v[0];
+        const Vec3 p = direction.cross(edge2);
+        const float determinant = edge1.dot(p);
+        if (std::abs(determinant) < 1.0e-12f) {
+            continue;
+        }
+        const Vec3 s = origin - v[0];
+        const float u = s.dot(p) / determinant;
+        const Vec3 q = s.cross(edge1);
+        const float w = direction.dot(q) / determinant;
+        const float distance = edge2.dot(q) / determinant;
+        if (u >= 0.0f && w >= 0.0f && u + w <= 1.0f && distance >= 0.0f &&
+            distance <= maxDistance) {
+            closest = std::min(closest, distance);
+        }
+    }
+    return closest;
+}
+
+}  // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+TEST(TriangleMeshTest, CreateRejectsInvalidInput) {
+    const std::vector<Vec3> vertices = {Vec3(0, 0, 0), Vec3(1, 0, 0), Vec3(0, 0, 1)};
+    EXPECT_TRUE(TriangleMesh::create(vertices, std::vector<uint32_t>{}).isFailure());
+    EXPECT_TRUE(TriangleMesh::create(vertices, std::vector<uint32_t>{0, 1}).isFailure());
+    const auto outOfRange = TriangleMesh::create(vertices, std::vector<uint32_t>{0, 1, 3});
+    ASSERT_TRUE(outOfRange.isFailure());
+    EXPECT_EQ(outOfRange.errorCode(), axiom::core::ErrorCode::InvalidShape);
+
+    const auto one = TriangleMesh::create(vertices, std::vector<uint32_t>{0, 1, 2});
+    ASSERT_TRUE(one.isSuccess());
+    EXPECT_EQ(one.value().getTriangleCount(), 1u);
+    EXPECT_EQ(one.value().getNodes().size(), 1u);
+}
+
+TEST(TriangleMeshTest, TerrainIsCompactAndComplete) {
+    const MeshData data = makeTerrain(128, 64.0f);
+    const TriangleMesh mesh = build(data);
+    const TriangleMeshStats stats = mesh.getStats();
+
+    EXPECT_EQ(stats.triangleCount, data.triangleCount());
+    EXPECT_EQ(stats.vertexCount, data.vertices.size());
+    EXPECT_TRUE(stats.compressedIndices);
+    EXPECT_LE(stats.depth, 12u);
+    // Nodes, 8-byte triangles, ids and vertices: under the 36 bytes of a raw triangle
+    EXPECT_LT(stats.memoryBytes, static_cast<size_t>(stats.triangleCount) * 32);
+
+    // Every triangle is stored exactly once, with its original vertices
+    std::vector<uint32_t> seen(data.triangleCount(), 0);
+    mesh.forEachTriangle([&](uint32_t triangle, const std::array<Vec3, 3>& vertices) {
+        ++seen[triangle];
+        const std::array<Vec3, 3> expected = data.triangle(triangle);
+        for (size_t k = 0; k < 3; ++k) {
+            EXPECT_EQ(vertices[k], expected[k]);
+        }
+    });
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](uint32_t count) { return count == 1; }));
+    EXPECT_EQ(queryTriangles(mesh, mesh.getBounds()).size(), data.triangleCount());
+}
+
+TEST(TriangleMeshTest, FarApartIndicesFallBackToFullIndices) {
+    // A fan around one vertex: the deltas to the center exceed 16 bits
+    MeshData data;
+    data.vertices.emplace_back(0.0f, 0.0f, 0.0f);
+    constexpr uint32_t Spokes = 40000;
+    for (uint32_t i = 0; i <= Spokes; ++i) {
+        const float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(Spokes);
+        data.vertices.emplace_back(std::cos(angle), 0.0f, std::sin(angle));
+    }
+    for (uint32_t i = 0; i < Spokes; ++i) {
+        data.indices.insert(data.indices.end(), {0, i + 1, i + 2});
+    }
+
+    const TriangleMesh mesh = build(data);
+    EXPECT_FALSE(mesh.getStats().compressedIndices);
+    MeshRayHit hit;
+    ASSERT_TRUE(mesh.raycast(Vec3(0.5f, 1.0f, 0.01f), Vec3(0.0f, -1.0f, 0.0f), 10.0f, hit));
+    EXPECT_NEAR(hit.distance, 1.0f, 1.0e-5f);
+    EXPECT_EQ(data.triangle(hit.triangle)[0], Vec3(0.0f, 0.0f, 0.0f));
+}
+
+TEST(TriangleMeshTest, ParallelBuildMatchesSerial) {
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 4;
+    jobConfig.mainThreadParticipates = false;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    const MeshData data = makeSoup(60000, 50.0f, 0.5f, 5);
+    TriangleMeshConfig parallelConfig;
+    parallelConfig.jobSystem = &jobs;
+    const TriangleMesh parallel = build(data, parallelConfig);
+    const TriangleMesh serial = build(data);
+
+    // The same nodes, byte for byte
+    ASSERT_EQ(parallel.getNodes().size(), serial.getNodes().size());
+    EXPECT_EQ(std::memcmp(parallel.getNodes().data(), serial.getNodes().data(),
+                          serial.getNodes().size_bytes()),
+              0);
+    EXPECT_EQ(parallel.getStats().depth, serial.getStats().depth);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+TEST(TriangleMeshTest, QueryAABBMatchesBruteForce) {
+    const MeshData data = makeSoup(5000, 20.0f, 1.0f, 1);
+    const TriangleMesh mesh = build(data);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> position(-22.0f, 22.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+    for (int i = 0; i < 200; ++i) {
+        const AABB box = AABB::fromCenterExtents(Vec3(position(rng), position(rng), position(rng)),
+                                                 Vec3(size(rng), size(rng), size(rng)));
+        std::vector<uint32_t> expected;
+        for (uint32_t t = 0; t < data.triangleCount(); ++t) {
+            if (triangleBounds(data.triangle(t)).intersects(box)) {
+                expected.push_back(t);
+            }
+        }
+        ASSERT_EQ(queryTriangles(mesh, box), expected) << "box " << i;
+    }
+}
+
+TEST(TriangleMeshTest, RaycastMatchesBruteForce) {
+    const MeshData data = makeSoup(5000, 20.0f, 1.0f, 3);
+    const TriangleMesh mesh = build(data);
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    uint32_t hits = 0;
+    for (int i = 0; i < 500; ++i) {
+        const Vec3 origin(position(rng), position(rng), position(rng));
+        Vec3 direction(component(rng), component(rng), component(rng));
+        if (i % 10 == 0) {
+            direction = Vec3(0.0f, -1.0f, 0.0f);  // Axis-aligned rays
+        }
+        direction = direction.normalized();
+        const float expected = rayDistance(data, origin, direction, 30.0f);
+
+        MeshRayHit hit;
+        const bool found = mesh.raycast(origin, direction, 30.0f, hit);
+        ASSERT_EQ(found, std::isfinite(expected)) << "ray " << i;
+        if (!found) {
+            continue;
+        }
+        ++hits;
+        EXPECT_NEAR(hit.distance, expected, 1.0e-4f) << "ray " << i;
+        EXPECT_LE(hit.normal.dot(direction), 0.0f);
+        EXPECT_NEAR(rayDistance(single(data, hit.triangle), origin, direction, 30.0f),
+                    hit.distance, 1.0e-4f);
+    }
+    EXPECT_GT(hits, 50u);
+}
+
+TEST(TriangleMeshTest, PacketRaycastMatchesSingleRays) {
+    const MeshData data = makeSoup(5000, 20.0f, 1.0f, 3);
+    const TriangleMesh mesh = build(data);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    for (int packetIndex = 0; packetIndex < 100; ++packetIndex) {
+        // A coherent fan from one point, with one lane left inactive
+        const Vec3 origin(position(rng), position(rng), position(rng));
+        const Vec3 axis = Vec3(component(rng), component(rng), component(rng)).normalized();
+        RayPacket packet;
+        std::array<Vec3, RayPacket::Width> directions;
+        for (uint32_t lane = 0; lane + 1 < RayPacket::Width; ++lane) {
+            directions[lane] =
+                (axis + Vec3(component(rng), component(rng), component(rng)) * 0.2f).normalized();
+            packet.setRay(lane, origin, directions[lane], 30.0f);
+        }
+
+        RayPacket anyPacket = packet;
+        std::array<MeshRayHit, RayPacket::Width> hits;
+        std::array<MeshRayHit, RayPacket::Width> anyHits;
+        const uint32_t mask = mesh.raycast(packet, hits);
+        const uint32_t anyMask = mesh.raycast(anyPacket, anyHits, true);
+        EXPECT_EQ(anyMask, mask);
+        EXPECT_EQ(mask >> (RayPacket::Width - 1), 0u);
+        for (uint32_t lane = 0; lane + 1 < RayPacket::Width; ++lane) {
+            MeshRayHit expected;
+            const bool found = mesh.raycast(origin, directions[lane], 30.0f, expected);
+            ASSERT_EQ((mask >> lane) & 1u, found ? 1u : 0u) << "packet " << packetIndex;
+            if (found) {
+                EXPECT_NEAR(hits[lane].distance, expected.distance, 1.0e-4f);
+                EXPECT_GE(anyHits[lane].distance, expected.distance - 1.0e-4f);
+                EXPECT_LE(hits[lane].normal.dot(directions[lane]), 0.0f);
+            }
+        }
+    }
+}
+
+TEST(TriangleMeshTest, ClosestPointMatchesBruteForce) {
+    const MeshData data = makeSoup(3000, 20.0f, 1.0f, 6);
+    const TriangleMesh mesh = build(data);
+
+    std::vector<TriangleMesh> triangles;
+    for (uint32_t t = 0; t < data.triangleCount(); ++t) {
+        triangles.push_back(build(single(data, t)));
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+    for (int i = 0; i < 100; ++i) {
+        const Vec3 point(position(rng), position(rng), position(rng));
+        float expected = std::numeric_limits<float>::infinity();
+        for (const TriangleMesh& triangle : triangles) {
+            MeshClosestPoint candidate;
+            ASSERT_TRUE(triangle.closestPoint(point, 1000.0f, candidate));
+            expected = std::min(expected, candidate.distance);
+        }
+
+        MeshClosestPoint result;
+        ASSERT_TRUE(mesh.closestPoint(point, 100.0f, result));
+        EXPECT_NEAR(result.distance, expected, 1.0e-4f) << "point " << i;
+        EXPECT_NEAR((result.point - point).length(), result.distance, 1.0e-4f);
+        MeshClosestPoint onTriangle;
+        ASSERT_TRUE(triangles[result.triangle].closestPoint(point, 1000.0f, onTriangle));
+        EXPECT_NEAR(onTriangle.distance, result.distance, 1.0e-4f);
+    }
+
+    MeshClosestPoint none;
+    EXPECT_FALSE(mesh.closestPoint(Vec3(100.0f, 0.0f, 0.0f), 10.0f, none));
+}
+
+// ============================================================================
+// Contacts
+// ============================================================================
+
+TEST(TriangleMeshTest, BoxRestingOnTerrainGetsAManifold) {
+    const MeshData data = makeTerrain(16, 8.0f);
+    const TriangleMesh mesh = build(data);
+    const ConvexShape ground = ConvexShape::triangleMesh(mesh);
+    const ConvexShape crate = ConvexShape::box(Vec3(0.5f));
+    const Transform groundTransform(Vec3::zero());
+    const Transform crateTransform(Vec3(0.0f, 0.49f, 0.0f));
+
+    EXPECT_EQ(getContactKernel(ShapeType::Mesh, ShapeType::Box), &collideMeshConvex);
+    const AABB bounds = ground.computeAABB(groundTransform);
+    EXPECT_TRUE(bounds.contains(mesh.getBounds()));
+
+    ContactManifold manifold;
+    generateContacts({&ground, &groundTransform, &crate, &crateTransform, nullptr}, 0.02f,
+                     manifold);
+    ASSERT_GE(manifold.pointCount, 1u);
+    EXPECT_GT(manifold.normal.y, 0.9f);  // From the mesh up into the box
+    for (uint32_t i = 0; i < manifold.pointCount; ++i) {
+        EXPECT_LT(manifold.points[i].separation, 0.02f);
+        EXPECT_LT(manifold.points[i].featureId, data.triangleCount());
+    }
+
+    // Reversed order: same contact, flipped
+    ContactManifold flipped;
+    generateContacts({&crate, &crateTransform, &ground, &groundTransform, nullptr}, 0.02f,
+                     flipped);
+    ASSERT_EQ(flipped.pointCount, manifold.pointCount);
+    EXPECT_LT(flipped.normal.y, -0.9f);
+
+    // Far above the terrain: nothing
+    const Transform above(Vec3(0.0f, 3.0f, 0.0f));
+    ContactManifold none;
+    generateContacts({&ground, &groundTransform, &crate, &above, nullptr}, 0.02f, none);
+    EXPECT_EQ(none.pointCount, 0u);
+}
@@ -0,0 +1,247 @@
+#include "axiom/collision/uniform_grid.hpp"
+#include "axiom/core/job_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace axiom::collision;
+using axiom::math::AABB;
+using axiom::math::Vec3;
+
+namespace {
+
+using PairSet = std::set<std::pair<ProxyId, ProxyId>>;
+
+AABB boxAt(const Vec3& center, float halfExtent = 0.5f) {
+    return AABB::fromCenterExtents(center, Vec3(halfExtent));
+}
+
+PairSet collectPairs(UniformGrid& grid) {
+    PairSet pairs;
+    const size_t reported = grid.updatePairs([&](ProxyId a, ProxyId b) {
+        EXPECT_LT(a, b);
+        EXPECT_TRUE(pairs.emplace(a, b).second) << "Duplicate pair " << a << ", " << b;
+    });
+    EXPECT_EQ(reported, pairs.size());
+    return pairs;
+}
+
+PairSet bruteForcePairs(const UniformGrid& grid, const std::vector<ProxyId>& ids) {
+    PairSet pairs;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            if (grid.getAABB(ids[i]).intersects(grid.getAABB(ids[j]))) {
+                pairs.emplace(std::min(ids[i], ids[j]), std::max(ids[i], ids[j]));
+            }
+        }
+    }
+    return pairs;
+}
+
+std::vector<ProxyId> queryHits(const UniformGrid& grid, const AABB& region) {
+    std::vector<ProxyId> hits;
+    grid.query(region, [&](ProxyId id) {
+        hits.push_back(id);
+        return true;
+    });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+}  // namespace
+
+// ============================================================================
+// Pairs
+// ============================================================================
+
+TEST(UniformGridTest, EmptyAndSingleProxy) {
+    UniformGrid grid;
+    EXPECT_TRUE(collectPairs(grid).empty());
+    EXPECT_TRUE(queryHits(grid, boxAt(Vec3::zero())).empty());
+
+    const ProxyId id = grid.createProxy(boxAt(Vec3::zero()), 7);
+    EXPECT_TRUE(collectPairs(grid).empty());
+    EXPECT_EQ(grid.getProxyCount(), 1u);
+    EXPECT_EQ(grid.getUserData(id), 7u);
+    EXPECT_EQ(queryHits(grid, boxAt(Vec3(0.8f, 0, 0))), std::vector<ProxyId>{id});
+}
+
+TEST(UniformGridTest, PairsMatchBruteForce) {
+    UniformGrid grid;
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+    std::uniform_real_distribution<float> size(0.1f, 1.5f);
+
+    std::vector<ProxyId> ids;
+    for (uint64_t i = 0; i < 1500; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(grid.createProxy(boxAt(center, size(rng)), i));
+    }
+
+    const PairSet pairs = collectPairs(grid);
+    EXPECT_FALSE(pairs.empty());
+    EXPECT_EQ(pairs, bruteForcePairs(grid, ids));
+    EXPECT_GT(grid.getStats().entryCount, grid.getProxyCount());  // Some span several cells
+}
+
+TEST(UniformGridTest, CellSizeFollowsMedianSize) {
+    UniformGrid grid;
+    for (int i = 0; i < 99; ++i) {
+        grid.createProxy(boxAt(Vec3(static_cast<float>(i) * 2.0f, 0, 0), 0.25f), 0);
+    }
+    grid.createProxy(boxAt(Vec3::zero(), 10.0f), 0);  // One outlier does not move the median
+    grid.update();
+    EXPECT_FLOAT_EQ(grid.getStats().cellSize, 0.75f);  // 1.5 x median size 0.5
+
+    UniformGridConfig config;
+    config.cellSize = 3.0f;
+    UniformGrid fixed(config);
+    fixed.createProxy(boxAt(Vec3::zero(), 0.25f), 0);
+    fixed.update();
+    EXPECT_FLOAT_EQ(fixed.getStats().cellSize, 3.0f);
+}
+
+TEST(UniformGridTest, LargeProxiesAreReportedOnce) {
+    // Small cells: every proxy covers many cells and every pair shares several
+    UniformGridConfig config;
+    config.cellSize = 0.25f;
+    config.maxCellsPerProxy = 4096;
+    UniformGrid grid(config);
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> size(0.3f, 1.2f);
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 200; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(grid.createProxy(boxAt(center, size(rng)), 0));
+    }
+
+    EXPECT_EQ(collectPairs(grid), bruteForcePairs(grid, ids));
+    EXPECT_EQ(grid.getStats().oversizedCount, 0u);
+    EXPECT_GT(grid.getStats().entryCount, 20u * grid.getProxyCount());
+}
+
+TEST(UniformGridTest, OversizedProxiesAreTestedAgainstEverything) {
+    UniformGridConfig config;
+    config.cellSize = 1.0f;
+    config.maxCellsPerProxy = 8;
+    UniformGrid grid(config);
+
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 300; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(grid.createProxy(boxAt(center, 0.3f), 0));
+    }
+    // Ground slab and two overlapping walls
+    ids.push_back(grid.createProxy(AABB(Vec3(-10, -1, -10), Vec3(10, 0, 10)), 0));
+    ids.push_back(grid.createProxy(AABB(Vec3(-10, -1, -10), Vec3(-9, 10, 10)), 0));
+    ids.push_back(grid.createProxy(AABB(Vec3(-10, -1, -10), Vec3(10, 10, -9)), 0));
+
+    EXPECT_EQ(collectPairs(grid), bruteForcePairs(grid, ids));
+    EXPECT_EQ(grid.getStats().oversizedCount, 3u);
+
+    const AABB region = boxAt(Vec3(-9.5f, 0, 0), 1.0f);
+    std::vector<ProxyId> expected;
+    for (const ProxyId id : ids) {
+        if (grid.getAABB(id).intersects(region)) {
+            expected.push_back(id);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(queryHits(grid, region), expected);
+}
+
+TEST(UniformGridTest, MovesDestroysAndRecycles) {
+    UniformGrid grid;
+    const ProxyId a = grid.createProxy(boxAt(Vec3(0, 0, 0)), 0);
+    const ProxyId b = grid.createProxy(boxAt(Vec3(0.5f, 0, 0)), 1);
+    EXPECT_EQ(collectPairs(grid), (PairSet{{a, b}}));
+
+    grid.moveProxy(b, boxAt(Vec3(5, 0, 0)));
+    EXPECT_TRUE(collectPairs(grid).empty());
+
+    grid.destroyProxy(b);
+    const ProxyId c = grid.createProxy(boxAt(Vec3(-0.5f, 0, 0)), 2);
+    EXPECT_EQ(c, b);
+    EXPECT_EQ(collectPairs(grid), (PairSet{{a, c}}));
+
+    grid.destroyProxy(a);
+    EXPECT_TRUE(collectPairs(grid).empty());
+    EXPECT_EQ(grid.getProxyCount(), 1u);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+TEST(UniformGridTest, QueryMatchesBruteForce) {
+    UniformGrid grid;
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    std::vector<ProxyId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        const Vec3 center(position(rng), position(rng), position(rng));
+        ids.push_back(grid.createProxy(boxAt(center, size(rng)), 0));
+    }
+    grid.update();
+
+    // Small regions look cells up; huge ones walk the occupied cells
+    for (const float halfExtent : {0.5f, 4.0f, 100.0f}) {
+        for (int q = 0; q < 20; ++q) {
+            const Vec3 center(position(rng), position(rng), position(rng));
+            const AABB region = boxAt(center, halfExtent);
+            std::vector<ProxyId> expected;
+            for (const ProxyId id : ids) {
+                if (grid.getAABB(id).intersects(region)) {
+                    expected.push_back(id);
+                }
+            }
+            EXPECT_EQ(queryHits(grid, region), expected) << "half extent " << halfExtent;
+        }
+    }
+}
+
+// ============================================================================
+// Parallel build
+// ============================================================================
+
+TEST(UniformGridTest, ParallelBuildMatchesSerialOrder) {
+    axiom::core::JobSystemConfig jobConfig;
+    jobConfig.workerCount = 4;
+    jobConfig.mainThreadParticipates = false;
+    axiom::core::JobSystem jobs(jobConfig);
+
+    UniformGridConfig parallelConfig;
+    parallelConfig.jobSystem = &jobs;
+    UniformGrid parallel(parallelConfig);
+    UniformGrid serial;
+
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> size(0.2f, 0.8f);
+    for (uint64_t i = 0; i < 40000; ++i) {
+        const AABB box = boxAt(Vec3(position(rng), position(rng), position(rng)), size(rng));
+        parallel.createProxy(box, i);
+        serial.createProxy(box, i);
+    }
+
+    // Same pairs in the same order
+    std::vector<std::pair<ProxyId, ProxyId>> parallelPairs;
+    std::vector<std::pair<ProxyId, ProxyId>> serialPairs;
+    parallel.updatePairs([&](ProxyId a, ProxyId b) { parallelPairs.emplace_back(a, b); });
+    serial.updatePairs([&](ProxyId a, ProxyId b) { serialPairs.emplace_back(a, b); });
+    EXPECT_FALSE(serialPairs.empty());
+    EXPECT_EQ(parallelPairs, serialPairs);
+    EXPECT_EQ(parallel.getStats().cellCount, serial.getStats().cellCount);
+}
@@ -0,0 +1,238 @@
+#include "axiom/core/coroutine.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+namespace {
+
+TaskExecutorConfig makeConfig(uint32_t threads) {
+    TaskExecutorConfig config;
+    config.threadCount = threads;
+    config.pollInterval = std::chrono::microseconds(50);
+    return config;
+}
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<int> addAnswers() {
+    const int a = co_await answer();
+    const int b = co_await answer();
+    co_return a + b;
+}
+
+Task<int> recurse(int depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return 1 + co_await recurse(depth - 1);
+}
+
+}  // namespace
+
+// ============================================================================
+// Task
+// ============================================================================
+
+TEST(TaskTest, DefaultConstructedIsInvalid) {
+    Task<int> task;
+    EXPECT_FALSE(task.isValid());
+    EXPECT_TRUE(task.isReady());
+}
+
+TEST(TaskTest, IsLazy) {
+    bool started = false;
+    auto makeTask = [&started]() -> Task<void> {
+        started = true;
+        co_return;
+    };
+
+    Task<void> task = makeTask();
+    EXPECT_TRUE(task.isValid());
+    EXPECT_FALSE(task.isReady());
+    EXPECT_FALSE(started);
+
+    syncWait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(TaskTest, SyncWaitReturnsValue) {
+    EXPECT_EQ(syncWait(answer()), 42);
+}
+
+TEST(TaskTest, NestedAwait) {
+    EXPECT_EQ(syncWait(addAnswers()), 84);
+}
+
+TEST(TaskTest, DeepChainDoesNotOverflowStack) {
+    // Symmetric transfer keeps the stack flat regardless of chain depth
+    EXPECT_EQ(syncWait(recurse(10000)), 10000);
+}
+
+TEST(TaskTest, MoveOnlyResult) {
+    auto makeTask = []() -> Task<std::unique_ptr<int>> { co_return std::make_unique<int>(7); };
+    std::unique_ptr<int> value = syncWait(makeTask());
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 7);
+}
+
+TEST(TaskTest, FramesComeFromPools) {
+    const CoroutineFrameStats before = getCoroutineFrameStats();
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(syncWait(addAnswers()), 84);
+    }
+
+    const CoroutineFrameStats after = getCoroutineFrameStats();
+    EXPECT_GE(after.pooledAllocations - before.pooledAllocations, 300u);
+    EXPECT_EQ(after.heapAllocations, before.heapAllocations);
+    EXPECT_EQ(after.liveFrames, before.liveFrames);
+}
+
+// ============================================================================
+// TaskExecutor
+// ============================================================================
+
+TEST(TaskExecutorTest, ThreadCount) {
+    TaskExecutor executor(makeConfig(3));
+    EXPECT_EQ(executor.getThreadCount(), 3u);
+    EXPECT_FALSE(executor.isExecutorThread());
+}
+
+TEST(TaskExecutorTest, ScheduleMovesToExecutorThread) {
+    TaskExecutor executor(makeConfig(2));
+
+    auto makeTask = [](TaskExecutor& exec) -> Task<bool> {
+        const bool before = exec.isExecutorThread();
+        co_await exec.schedule();
+        co_return !before && exec.isExecutorThread();
+    };
+
+    EXPECT_TRUE(syncWait(makeTask(executor)));
+}
+
+TEST(TaskExecutorTest, PollUntilResumesWhenPredicateHolds) {
+    TaskExecutor executor(makeConfig(1));
+    std::atomic<bool> flag{false};
+
+    auto makeTask = [](TaskExecutor& exec, std::atomic<bool>& f) -> Task<bool> {
+        co_await exec.pollUntil([&f] { return f.load(std::memory_order_acquire); });
+        co_return exec.isExecutorThread();
+    };
+
+    std::thread setter([&flag] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        flag.store(true, std::memory_order_release);
+    });
+
+    EXPECT_TRUE(syncWait(makeTask(executor, flag)));
+    setter.join();
+}
+
+TEST(TaskExecutorTest, PollUntilAlreadySatisfiedDoesNotSuspend) {
+    TaskExecutor executor(makeConfig(1));
+
+    auto makeTask = [](TaskExecutor& exec) -> Task<bool> {
+        co_await exec.pollUntil([] { return true; });
+        co_return exec.isExecutorThread();
+    };
+
+    // Never left the calling thread
+    EXPECT_FALSE(syncWait(makeTask(executor)));
+}
+
+TEST(TaskExecutorTest, UntilDoneWaitsForJobCounter) {
+    JobSystemConfig jobConfig;
+    jobConfig.workerCount = 1;
+    jobConfig.mainThreadParticipates = false;  // Jobs must run without anyone calling wait()
+    jobConfig.scratchBytesPerWorker = 64 * 1024;
+    JobSystem jobs(jobConfig);
+    TaskExecutor executor(makeConfig(1));
+
+    std::atomic<int> sum{0};
+    auto makeTask = [](TaskExecutor& exec, JobSystem& js, std::atomic<int>& total) -> Task<int> {
+        JobCounter counter;
+        for (int i = 1; i <= 10; ++i) {
+            js.run(counter, [&total, i] { total.fetch_add(i, std::memory_order_relaxed); });
+        }
+        co_await exec.untilDone(counter);
+        co_return total.load(std::memory_order_relaxed);
+    };
+
+    EXPECT_EQ(syncWait(makeTask(executor, jobs, sum)), 55);
+}
+
+TEST(TaskExecutorTest, ReadFile) {
+    TaskExecutor executor(makeConfig(1));
+
+    const std::string path = ::testing::TempDir() + "axiom_coroutine_read_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "axiom";
+    }
+
+    auto makeTask = [](TaskExecutor& exec, std::string p) -> Task<std::string> {
+        auto result = co_await exec.readFile(std::move(p));
+        if (result.isFailure()) {
+            co_return std::string();
+        }
+        const auto& bytes = result.value();
+        co_return std::string(bytes.begin(), bytes.end());
+    };
+
+    EXPECT_EQ(syncWait(makeTask(executor, path)), "axiom");
+    std::remove(path.c_str());
+}
+
+TEST(TaskExecutorTest, ReadMissingFileFails) {
+    TaskExecutor executor(makeConfig(1));
+
+    auto makeTask = [](TaskExecutor& exec) -> Task<ErrorCode> {
+        auto result = co_await exec.readFile("/nonexistent/axiom/file.bin");
+        co_return result.isFailure() ? result.errorCode() : ErrorCode::Success;
+    };
+
+    EXPECT_EQ(syncWait(makeTask(executor)), ErrorCode::FileNotFound);
+}
+
+TEST(TaskExecutorTest, SpawnAndWaitIdle) {
+    TaskExecutor executor(makeConfig(2));
+    std::atomic<int> completed{0};
+    constexpr int TaskCount = 200;
+
+    auto makeTask = [](TaskExecutor& exec, std::atomic<int>& done, int i) -> Task<void> {
+        co_await exec.schedule();
+        if (i % 4 == 0) {
+            co_await exec.pollUntil([] { return true; });
+        }
+        const int value = co_await answer();
+        if (value == 42) {
+            done.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    for (int i = 0; i < TaskCount; ++i) {
+        executor.spawn(makeTask(executor, completed, i));
+    }
+    executor.waitIdle();
+
+    EXPECT_EQ(completed.load(), TaskCount);
+    EXPECT_EQ(executor.getPendingTaskCount(), 0u);
+}
+
+TEST(TaskExecutorTest, WaitIdleWithNothingSpawned) {
+    TaskExecutor executor(makeConfig(1));
+    executor.waitIdle();
+    EXPECT_EQ(executor.getPendingTaskCount(), 0u);
+}
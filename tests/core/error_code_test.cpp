@@ -53,6 +53,11 @@ TEST(ErrorCodeTest, ErrorCodeToString_ValidationErrors) {
     EXPECT_STREQ(errorCodeToString(ErrorCode::OutOfRange), "Value out of range");
 }
 
+TEST(ErrorCodeTest, ErrorCodeToString_IOErrors) {
+    EXPECT_STREQ(errorCodeToString(ErrorCode::FileNotFound), "File not found");
+    EXPECT_STREQ(errorCodeToString(ErrorCode::FileReadFailed), "File read failed");
+}
+
 // Test error category detection
 TEST(ErrorCodeTest, GetErrorCategory_Success) {
     EXPECT_EQ(getErrorCategory(ErrorCode::Success), ErrorCategory::None);
@@ -93,6 +98,11 @@ TEST(ErrorCodeTest, GetErrorCategory_ValidationErrors) {
     EXPECT_EQ(getErrorCategory(ErrorCode::OutOfRange), ErrorCategory::Validation);
 }
 
+TEST(ErrorCodeTest, GetErrorCategory_IOErrors) {
+    EXPECT_EQ(getErrorCategory(ErrorCode::FileNotFound), ErrorCategory::IO);
+    EXPECT_EQ(getErrorCategory(ErrorCode::FileReadFailed), ErrorCategory::IO);
+}
+
 // Test error category to string conversion
 TEST(ErrorCodeTest, ErrorCategoryToString_AllCategories) {
     EXPECT_STREQ(errorCategoryToString(ErrorCategory::None), "None");
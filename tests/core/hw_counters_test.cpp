@@ -0,0 +1,205 @@
+#include "axiom/core/hw_counters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+namespace {
+
+const HwZoneStats* findZone(const std::vector<HwZoneStats>& zones, const char* name) {
+    auto it = std::find_if(zones.begin(), zones.end(),
+                           [name](const HwZoneStats& zone) { return zone.name == name; });
+    return it != zones.end() ? &*it : nullptr;
+}
+
+/// Work the compiler cannot remove, touching memory and taking branches
+uint64_t busyWork(uint32_t iterations) {
+    std::vector<uint32_t> data(4096);
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        const uint32_t index = (i * 2654435761u) & 4095u;
+        data[index] += i;
+        if (data[index] & 1u) {
+            sum += data[index];
+        }
+    }
+    return sum;
+}
+
+}  // namespace
+
+// ============================================================================
+// Events
+// ============================================================================
+
+TEST(HwCountersTest, EventToString) {
+    EXPECT_STREQ(hwEventToString(HwEvent::Cycles), "Cycles");
+    EXPECT_STREQ(hwEventToString(HwEvent::Instructions), "Instructions");
+    EXPECT_STREQ(hwEventToString(HwEvent::L1DataMisses), "L1DataMisses");
+    EXPECT_STREQ(hwEventToString(HwEvent::LastLevelCacheMisses), "LastLevelCacheMisses");
+    EXPECT_STREQ(hwEventToString(HwEvent::BranchMisses), "BranchMisses");
+    EXPECT_STREQ(hwEventToString(HwEvent::Count), "Unknown");
+}
+
+TEST(HwCountersTest, ReadingMatchesAvailability) {
+    const HwCounterValues values = readThreadHwCounters();
+    for (size_t e = 0; e < HwEventCount; ++e) {
+        const auto event = static_cast<HwEvent>(e);
+        EXPECT_EQ(values.has(event), isHwEventAvailable(event)) << hwEventToString(event);
+    }
+}
+
+TEST(HwCountersTest, CountersAdvanceWhenAvailable) {
+    if (!isHwEventAvailable(HwEvent::Instructions)) {
+        // Degraded mode (no perf_event access): readings carry no counters
+        const uint32_t instructionsBit = 1u << static_cast<uint32_t>(HwEvent::Instructions);
+        EXPECT_EQ(readThreadHwCounters().validMask & instructionsBit, 0u);
+        return;
+    }
+
+    const HwCounterValues before = readThreadHwCounters();
+    EXPECT_NE(busyWork(100000), 0u);
+    const HwCounterValues after = readThreadHwCounters();
+    EXPECT_GT(after.get(HwEvent::Instructions), before.get(HwEvent::Instructions) + 100000);
+}
+
+// ============================================================================
+// HwZoneStats
+// ============================================================================
+
+TEST(HwZoneStatsTest, DerivedValues) {
+    HwZoneStats stats;
+    stats.calls = 4;
+    stats.nanoseconds = 2000000;
+    stats.counters.validMask = (1u << static_cast<uint32_t>(HwEvent::Cycles)) |
+                               (1u << static_cast<uint32_t>(HwEvent::Instructions)) |
+                               (1u << static_cast<uint32_t>(HwEvent::L1DataMisses));
+    stats.counters.values[static_cast<size_t>(HwEvent::Cycles)] = 1000;
+    stats.counters.values[static_cast<size_t>(HwEvent::Instructions)] = 2500;
+    stats.counters.values[static_cast<size_t>(HwEvent::L1DataMisses)] = 80;
+
+    EXPECT_DOUBLE_EQ(stats.getIpc(), 2.5);
+    EXPECT_DOUBLE_EQ(stats.getMilliseconds(), 2.0);
+
+    // Without elements, averages are per call
+    EXPECT_DOUBLE_EQ(stats.getPerElement(HwEvent::L1DataMisses), 20.0);
+
+    stats.elements = 40;
+    EXPECT_DOUBLE_EQ(stats.getPerElement(HwEvent::L1DataMisses), 2.0);
+
+    // Uncounted events report zero
+    EXPECT_DOUBLE_EQ(stats.getPerElement(HwEvent::BranchMisses), 0.0);
+}
+
+TEST(HwZoneStatsTest, IpcWithoutCountersIsZero) {
+    HwZoneStats stats;
+    stats.calls = 1;
+    EXPECT_DOUBLE_EQ(stats.getIpc(), 0.0);
+}
+
+// ============================================================================
+// HwCounterRegistry / HwCounterScope
+// ============================================================================
+
+TEST(HwCounterRegistryTest, RegisterZone) {
+    auto& registry = HwCounterRegistry::getInstance();
+    const HwZoneId a = registry.registerZone("HwTest.RegisterA");
+    const HwZoneId b = registry.registerZone("HwTest.RegisterB");
+
+    EXPECT_NE(a, InvalidHwZoneId);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(registry.registerZone("HwTest.RegisterA"), a);
+    EXPECT_EQ(registry.registerZone(nullptr), InvalidHwZoneId);
+}
+
+TEST(HwCounterRegistryTest, ScopeRecordsCallsTimeAndElements) {
+    auto& registry = HwCounterRegistry::getInstance();
+    const HwZoneId outer = registry.registerZone("HwTest.Outer");
+    const HwZoneId inner = registry.registerZone("HwTest.Inner");
+
+    for (int i = 0; i < 3; ++i) {
+        HwCounterScope outerScope(outer);
+        HwCounterScope::addElements(10);
+        {
+            HwCounterScope innerScope(inner);
+            HwCounterScope::addElements(1000);
+            EXPECT_NE(busyWork(20000), 0u);
+        }
+    }
+    HwCounterScope::addElements(5);  // No active scope: ignored
+
+    const auto zones = registry.snapshot();
+    const HwZoneStats* outerStats = findZone(zones, "HwTest.Outer");
+    const HwZoneStats* innerStats = findZone(zones, "HwTest.Inner");
+    ASSERT_NE(outerStats, nullptr);
+    ASSERT_NE(innerStats, nullptr);
+
+    EXPECT_EQ(outerStats->calls, 3u);
+    EXPECT_EQ(innerStats->calls, 3u);
+    EXPECT_EQ(outerStats->elements, 30u);
+    EXPECT_EQ(innerStats->elements, 3000u);
+    EXPECT_GE(outerStats->nanoseconds, innerStats->nanoseconds);  // Zones are inclusive
+
+    if (isHwEventAvailable(HwEvent::Instructions)) {
+        EXPECT_TRUE(innerStats->counters.has(HwEvent::Instructions));
+        EXPECT_GE(outerStats->counters.get(HwEvent::Instructions),
+                  innerStats->counters.get(HwEvent::Instructions));
+    } else {
+        EXPECT_EQ(innerStats->counters.validMask, 0u);
+    }
+}
+
+TEST(HwCounterRegistryTest, ConcurrentScopes) {
+    auto& registry = HwCounterRegistry::getInstance();
+    const HwZoneId zone = registry.registerZone("HwTest.Concurrent");
+    constexpr uint32_t ThreadCount = 4;
+    constexpr uint32_t PerThread = 200;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([zone] {
+            for (uint32_t i = 0; i < PerThread; ++i) {
+                HwCounterScope scope(zone);
+                HwCounterScope::addElements(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto zones = registry.snapshot();
+    const HwZoneStats* stats = findZone(zones, "HwTest.Concurrent");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->calls, ThreadCount * PerThread);
+    EXPECT_EQ(stats->elements, 2u * ThreadCount * PerThread);
+}
+
+TEST(HwCounterRegistryTest, WriteTextAndReset) {
+    auto& registry = HwCounterRegistry::getInstance();
+    const HwZoneId zone = registry.registerZone("HwTest.Report");
+    {
+        HwCounterScope scope(zone);
+        HwCounterScope::addElements(64);
+    }
+
+    std::ostringstream out;
+    registry.writeText(out);
+    const std::string report = out.str();
+    EXPECT_NE(report.find("HwTest.Report calls=1"), std::string::npos);
+    EXPECT_NE(report.find("elements=64"), std::string::npos);
+    if (!isHwEventAvailable(HwEvent::Cycles)) {
+        EXPECT_NE(report.find("no hardware counters"), std::string::npos);
+    }
+
+    registry.reset();
+    EXPECT_EQ(findZone(registry.snapshot(), "HwTest.Report"), nullptr);
+    EXPECT_EQ(registry.registerZone("HwTest.Report"), zone);  // Registrations survive reset
+}
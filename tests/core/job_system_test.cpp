@@ -0,0 +1,286 @@
+#include "axiom/core/job_system.hpp"
+#include "axiom/memory/linear_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+namespace {
+
+JobSystemConfig makeConfig(uint32_t workers, bool mainThreadParticipates = true) {
+    JobSystemConfig config;
+    config.workerCount = workers;
+    config.mainThreadParticipates = mainThreadParticipates;
+    config.scratchBytesPerWorker = 64 * 1024;
+    return config;
+}
+
+}  // namespace
+
+// ============================================================================
+// WorkStealingDeque
+// ============================================================================
+
+TEST(WorkStealingDequeTest, OwnerPopIsLifo) {
+    WorkStealingDeque<int> deque(4);
+    for (int i = 0; i < 3; ++i) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.size(), 3u);
+
+    int value = -1;
+    ASSERT_TRUE(deque.pop(value));
+    EXPECT_EQ(value, 2);
+    ASSERT_TRUE(deque.steal(value));
+    EXPECT_EQ(value, 0);
+    ASSERT_TRUE(deque.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(deque.pop(value));
+    EXPECT_FALSE(deque.steal(value));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowsPreservingOrder) {
+    WorkStealingDeque<int> deque(2);
+    for (int i = 0; i < 100; ++i) {
+        deque.push(i);
+    }
+    EXPECT_GE(deque.capacity(), 100u);
+
+    int value = -1;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(deque.steal(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachItemOnce) {
+    constexpr int kItems = 20000;
+    constexpr int kThieves = 3;
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> seen(kItems);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t) {
+        thieves.emplace_back([&] {
+            int value = 0;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(value)) {
+                    seen[static_cast<size_t>(value)].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int value = 0;
+    for (int i = 0; i < kItems; ++i) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value)) {
+            seen[static_cast<size_t>(value)].fetch_add(1);
+        }
+    }
+    while (deque.pop(value)) {
+        seen[static_cast<size_t>(value)].fetch_add(1);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < kItems; ++i) {
+        EXPECT_EQ(seen[static_cast<size_t>(i)].load(), 1) << "item " << i;
+    }
+}
+
+// ============================================================================
+// JobSystem
+// ============================================================================
+
+TEST(JobSystemTest, WorkerCountAndIndices) {
+    JobSystem jobs(makeConfig(3));
+    EXPECT_EQ(jobs.getWorkerCount(), 3u);
+    EXPECT_EQ(jobs.getCurrentWorkerIndex(), 0u);
+
+    std::thread outsider([&] {
+        EXPECT_EQ(jobs.getCurrentWorkerIndex(), JobSystem::InvalidWorkerIndex);
+    });
+    outsider.join();
+}
+
+TEST(JobSystemTest, MainThreadDoesNotParticipate) {
+    JobSystem jobs(makeConfig(2, false));
+    EXPECT_EQ(jobs.getCurrentWorkerIndex(), JobSystem::InvalidWorkerIndex);
+
+    JobCounter counter;
+    std::atomic<uint32_t> index{JobSystem::InvalidWorkerIndex};
+    jobs.run(counter, [&] { index = jobs.getCurrentWorkerIndex(); });
+    jobs.wait(counter);
+    EXPECT_LT(index.load(), 2u);
+}
+
+TEST(JobSystemTest, RunAndWait) {
+    JobSystem jobs(makeConfig(4));
+    JobCounter counter;
+    std::atomic<int> sum{0};
+
+    for (int i = 1; i <= 100; ++i) {
+        jobs.run(counter, [&sum, i] { sum.fetch_add(i); });
+    }
+    jobs.wait(counter);
+
+    EXPECT_TRUE(counter.isDone());
+    EXPECT_EQ(counter.getPending(), 0u);
+    EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(JobSystemTest, SingleWorkerRunsEverythingInWait) {
+    JobSystem jobs(makeConfig(1));
+    JobCounter counter;
+    int count = 0;  // only the main thread executes jobs
+
+    for (int i = 0; i < 1000; ++i) {
+        jobs.run(counter, [&count] { ++count; });
+    }
+    EXPECT_EQ(counter.getPending(), 1000u);
+    jobs.wait(counter);
+    EXPECT_EQ(count, 1000);
+}
+
+TEST(JobSystemTest, NestedForkJoin) {
+    JobSystem jobs(makeConfig(4));
+    std::atomic<int> leaves{0};
+
+    JobCounter outer;
+    for (int i = 0; i < 8; ++i) {
+        jobs.run(outer, [&] {
+            JobCounter inner;
+            for (int j = 0; j < 8; ++j) {
+                jobs.run(inner, [&leaves] { leaves.fetch_add(1); });
+            }
+            jobs.wait(inner);
+        });
+    }
+    jobs.wait(outer);
+
+    EXPECT_EQ(leaves.load(), 64);
+}
+
+TEST(JobSystemTest, CounterIsReusable) {
+    JobSystem jobs(makeConfig(2));
+    JobCounter counter;
+    std::atomic<int> runs{0};
+
+    for (int frame = 0; frame < 50; ++frame) {
+        jobs.run(counter, [&runs] { runs.fetch_add(1); });
+        jobs.run(counter, [&runs] { runs.fetch_add(1); });
+        jobs.wait(counter);
+    }
+    EXPECT_EQ(runs.load(), 100);
+}
+
+TEST(JobSystemTest, SubmitFromExternalThread) {
+    JobSystem jobs(makeConfig(2));
+    JobCounter counter;
+    std::atomic<int> runs{0};
+
+    std::thread producer([&] {
+        for (int i = 0; i < 100; ++i) {
+            jobs.run(counter, [&runs] { runs.fetch_add(1); });
+        }
+        jobs.wait(counter);
+    });
+    producer.join();
+
+    EXPECT_EQ(runs.load(), 100);
+}
+
+TEST(JobSystemTest, ParallelForCoversRangeExactlyOnce) {
+    JobSystem jobs(makeConfig(4));
+    constexpr uint32_t kCount = 10007;
+    std::vector<std::atomic<int>> hits(kCount);
+
+    jobs.parallelFor(kCount, 0, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (uint32_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(hits[i].load(), 1) << "index " << i;
+    }
+}
+
+TEST(JobSystemTest, ParallelForRespectsGrainSize) {
+    JobSystem jobs(makeConfig(4));
+    std::atomic<uint32_t> largestChunk{0};
+    std::atomic<uint32_t> total{0};
+
+    jobs.parallelFor(1000, 37, [&](uint32_t begin, uint32_t end) {
+        uint32_t size = end - begin;
+        total.fetch_add(size);
+        uint32_t current = largestChunk.load();
+        while (size > current && !largestChunk.compare_exchange_weak(current, size)) {
+        }
+    });
+
+    EXPECT_EQ(total.load(), 1000u);
+    EXPECT_LE(largestChunk.load(), 37u);
+}
+
+TEST(JobSystemTest, ParallelForSmallAndEmptyRanges) {
+    JobSystem jobs(makeConfig(2));
+    int calls = 0;
+    jobs.parallelFor(0, 0, [&](uint32_t, uint32_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    jobs.parallelFor(5, 16, [&](uint32_t begin, uint32_t end) {
+        ++calls;
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 5u);
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(JobSystemTest, AutoGrainSize) {
+    JobSystem jobs(makeConfig(4));
+    EXPECT_EQ(jobs.getAutoGrainSize(3200), 100u);
+    EXPECT_EQ(jobs.getAutoGrainSize(5), 1u);
+}
+
+TEST(JobSystemTest, ScratchAllocatorIsPerWorker) {
+    JobSystem jobs(makeConfig(3));
+    std::vector<axiom::memory::FrameAllocator*> allocators(jobs.getWorkerCount(), nullptr);
+
+    jobs.parallelFor(64, 1, [&](uint32_t, uint32_t) {
+        auto& scratch = jobs.getScratchAllocator();
+        int* data = scratch.allocateArray<int>(16);
+        ASSERT_NE(data, nullptr);
+        std::iota(data, data + 16, 0);
+        EXPECT_EQ(data[15], 15);
+        allocators[jobs.getCurrentWorkerIndex()] = &scratch;
+    });
+
+    for (size_t i = 0; i < allocators.size(); ++i) {
+        for (size_t j = i + 1; j < allocators.size(); ++j) {
+            if (allocators[i] != nullptr && allocators[j] != nullptr) {
+                EXPECT_NE(allocators[i], allocators[j]);
+            }
+        }
+    }
+
+    EXPECT_GT(jobs.getScratchAllocator().getAllocatedSize() +
+                  (allocators[1] ? allocators[1]->getAllocatedSize() : 0u) +
+                  (allocators[2] ? allocators[2]->getAllocatedSize() : 0u),
+              0u);
+
+    // Two flips release everything allocated above
+    jobs.flipScratchAllocators();
+    jobs.flipScratchAllocators();
+    EXPECT_EQ(jobs.getScratchAllocator().getAllocatedSize(), 0u);
+}
@@ -0,0 +1,190 @@
+#include "axiom/core/mpmc_queue.hpp"
+#include "axiom/core/spsc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+// ============================================================================
+// SpscQueue
+// ============================================================================
+
+TEST(SpscQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(SpscQueue<int>(0).getCapacity(), 2u);
+    EXPECT_EQ(SpscQueue<int>(100).getCapacity(), 128u);
+    EXPECT_EQ(SpscQueue<int>(128).getCapacity(), 128u);
+}
+
+TEST(SpscQueueTest, FifoOrder) {
+    SpscQueue<int> queue(8);
+    EXPECT_TRUE(queue.isEmpty());
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_EQ(queue.getSizeApprox(), 5u);
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, FullQueueRejectsPush) {
+    SpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(99));
+
+    int value = -1;
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.tryPush(4));
+}
+
+TEST(SpscQueueTest, WrapsAround) {
+    SpscQueue<int> queue(4);
+    int value = -1;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPush(i + 1000));
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+}
+
+TEST(SpscQueueTest, MoveOnlyElements) {
+    SpscQueue<std::unique_ptr<std::string>> queue(4);
+    EXPECT_TRUE(queue.tryPush(std::make_unique<std::string>("contact")));
+
+    std::unique_ptr<std::string> value;
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, "contact");
+}
+
+TEST(SpscQueueTest, StressProducerConsumer) {
+    constexpr uint64_t Count = 200000;
+    SpscQueue<uint64_t> queue(64);
+
+    std::thread producer([&queue] {
+        for (uint64_t i = 0; i < Count; ++i) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (expected < Count) {
+        if (queue.tryPop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+// ============================================================================
+// MpmcQueue
+// ============================================================================
+
+TEST(MpmcQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(MpmcQueue<int>(1).getCapacity(), 2u);
+    EXPECT_EQ(MpmcQueue<int>(1000).getCapacity(), 1024u);
+}
+
+TEST(MpmcQueueTest, FifoOrderSingleThread) {
+    MpmcQueue<int> queue(8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(8));
+    EXPECT_EQ(queue.getSizeApprox(), 8u);
+
+    int value = -1;
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(MpmcQueueTest, WrapsAround) {
+    MpmcQueue<int> queue(2);
+    int value = -1;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(MpmcQueueTest, StressMultipleProducersAndConsumers) {
+    constexpr uint32_t Producers = 4;
+    constexpr uint32_t Consumers = 4;
+    constexpr uint64_t PerProducer = 20000;
+    MpmcQueue<uint64_t> queue(128);
+
+    std::atomic<uint64_t> consumed{0};
+    std::atomic<uint64_t> sum{0};
+    // Per producer, values must arrive in push order at any single consumer
+    std::vector<std::vector<uint64_t>> lastSeen(Consumers, std::vector<uint64_t>(Producers, 0));
+    std::atomic<bool> orderViolated{false};
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < Producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (uint64_t i = 1; i <= PerProducer; ++i) {
+                const uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (uint32_t c = 0; c < Consumers; ++c) {
+        threads.emplace_back([&, c] {
+            uint64_t value = 0;
+            while (consumed.load(std::memory_order_relaxed) < Producers * PerProducer) {
+                if (!queue.tryPop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto producer = static_cast<uint32_t>(value >> 32);
+                const uint64_t sequence = value & 0xFFFFFFFFu;
+                if (sequence <= lastSeen[c][producer]) {
+                    orderViolated.store(true, std::memory_order_relaxed);
+                }
+                lastSeen[c][producer] = sequence;
+                sum.fetch_add(sequence, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(consumed.load(), Producers * PerProducer);
+    EXPECT_EQ(sum.load(), Producers * (PerProducer * (PerProducer + 1) / 2));
+    EXPECT_FALSE(orderViolated.load());
+    EXPECT_EQ(queue.getSizeApprox(), 0u);
+}
@@ -0,0 +1,265 @@
+#include "axiom/core/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+namespace {
+
+/// Relative error bound of the log-linear buckets (half a sub-bucket of the smallest mantissa)
+constexpr double kBucketTolerance = 0.035;
+
+}  // namespace
+
+// ============================================================================
+// HistogramSnapshot bucket mapping
+// ============================================================================
+
+TEST(MetricsHistogramTest, BucketIndexIsMonotonic) {
+    size_t previous = 0;
+    for (double v = 1e-5; v < 1e12; v *= 1.01) {
+        const size_t index = HistogramSnapshot::bucketIndex(v);
+        EXPECT_GE(index, previous);
+        EXPECT_LT(index, HistogramSnapshot::BucketCount);
+        previous = index;
+    }
+}
+
+TEST(MetricsHistogramTest, BucketValueIsWithinTolerance) {
+    for (double v : {0.001, 0.25, 1.0, 3.7, 16.6, 1234.5, 987654.0}) {
+        const double representative =
+            HistogramSnapshot::bucketValue(HistogramSnapshot::bucketIndex(v));
+        EXPECT_NEAR(representative, v, v * kBucketTolerance) << "value " << v;
+    }
+}
+
+TEST(MetricsHistogramTest, OutOfRangeValuesAreClamped) {
+    EXPECT_EQ(HistogramSnapshot::bucketIndex(0.0), 0u);
+    EXPECT_EQ(HistogramSnapshot::bucketIndex(-5.0), 0u);
+    EXPECT_EQ(HistogramSnapshot::bucketIndex(std::nan("")), 0u);
+    EXPECT_EQ(HistogramSnapshot::bucketIndex(1e300), HistogramSnapshot::BucketCount - 1);
+}
+
+TEST(MetricsHistogramTest, EmptySnapshotQueries) {
+    HistogramSnapshot h;
+    EXPECT_EQ(h.mean(), 0.0);
+    EXPECT_EQ(h.p50(), 0.0);
+    EXPECT_EQ(h.p99(), 0.0);
+}
+
+TEST(MetricsHistogramTest, MergeCombinesCountsAndExtremes) {
+    HistogramSnapshot a;
+    a.count = 1;
+    a.sum = 2.0;
+    a.min = 2.0;
+    a.max = 2.0;
+    a.buckets.assign(HistogramSnapshot::BucketCount, 0);
+    a.buckets[HistogramSnapshot::bucketIndex(2.0)] = 1;
+
+    HistogramSnapshot b = a;
+    b.sum = 8.0;
+    b.min = 8.0;
+    b.max = 8.0;
+    b.buckets.assign(HistogramSnapshot::BucketCount, 0);
+    b.buckets[HistogramSnapshot::bucketIndex(8.0)] = 1;
+
+    HistogramSnapshot merged;
+    merged.merge(a);
+    merged.merge(b);
+    EXPECT_EQ(merged.count, 2u);
+    EXPECT_DOUBLE_EQ(merged.sum, 10.0);
+    EXPECT_DOUBLE_EQ(merged.min, 2.0);
+    EXPECT_DOUBLE_EQ(merged.max, 8.0);
+    EXPECT_DOUBLE_EQ(merged.mean(), 5.0);
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+TEST(MetricsRegistryTest, RegisterSameNameReturnsSameId) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId a = registry.registerCounter("MetricsTest.SameName");
+    const MetricId b = registry.registerCounter("MetricsTest.SameName");
+    EXPECT_NE(a, InvalidMetricId);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(registry.registerCounter(nullptr), InvalidMetricId);
+}
+
+TEST(MetricsRegistryTest, InvalidIdIsIgnored) {
+    auto& registry = MetricsRegistry::getInstance();
+    registry.add(InvalidMetricId, 5);
+    registry.set(InvalidMetricId, 1.0);
+    registry.record(InvalidMetricId, 1.0);
+    SUCCEED();
+}
+
+TEST(MetricsRegistryTest, CounterSumsAcrossThreads) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId id = registry.registerCounter("MetricsTest.ThreadedCounter");
+
+    constexpr int kThreads = 4;
+    constexpr int kIncrements = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&registry, id] {
+            for (int i = 0; i < kIncrements; ++i) {
+                registry.add(id);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Shards of exited threads still contribute to the total
+    const MetricsSnapshot snap = registry.snapshot();
+    const MetricSample* sample = snap.find("MetricsTest.ThreadedCounter");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->kind, MetricKind::Counter);
+    EXPECT_EQ(sample->counter, static_cast<uint64_t>(kThreads * kIncrements));
+}
+
+TEST(MetricsRegistryTest, GaugeKeepsLastValue) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId id = registry.registerGauge("MetricsTest.Gauge");
+    registry.set(id, 3.0);
+    registry.set(id, 7.5);
+
+    const MetricsSnapshot snap = registry.snapshot();
+    ASSERT_NE(snap.find("MetricsTest.Gauge"), nullptr);
+    EXPECT_DOUBLE_EQ(snap.find("MetricsTest.Gauge")->gauge, 7.5);
+}
+
+TEST(MetricsRegistryTest, HistogramPercentiles) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId id = registry.registerHistogram("MetricsTest.Percentiles");
+    for (int i = 1; i <= 1000; ++i) {
+        registry.record(id, static_cast<double>(i));
+    }
+
+    const MetricsSnapshot snap = registry.snapshot();
+    const HistogramSnapshot* h = snap.findHistogram("MetricsTest.Percentiles");
+    ASSERT_NE(h, nullptr);
+    EXPECT_EQ(h->count, 1000u);
+    EXPECT_DOUBLE_EQ(h->min, 1.0);
+    EXPECT_DOUBLE_EQ(h->max, 1000.0);
+    EXPECT_DOUBLE_EQ(h->mean(), 500.5);
+    EXPECT_NEAR(h->p50(), 500.0, 500.0 * kBucketTolerance);
+    EXPECT_NEAR(h->p95(), 950.0, 950.0 * kBucketTolerance);
+    EXPECT_NEAR(h->p99(), 990.0, 990.0 * kBucketTolerance);
+    EXPECT_DOUBLE_EQ(h->percentile(1.0), 1000.0);
+    EXPECT_DOUBLE_EQ(h->percentile(0.0), 1.0);
+}
+
+TEST(MetricsRegistryTest, HistogramMergesThreadShards) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId id = registry.registerHistogram("MetricsTest.ThreadedHistogram");
+
+    constexpr int kThreads = 4;
+    constexpr int kSamples = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&registry, id, t] {
+            for (int i = 0; i < kSamples; ++i) {
+                registry.record(id, static_cast<double>(t + 1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const MetricsSnapshot snap = registry.snapshot();
+    const HistogramSnapshot* h = snap.findHistogram("MetricsTest.ThreadedHistogram");
+    ASSERT_NE(h, nullptr);
+    EXPECT_EQ(h->count, static_cast<uint64_t>(kThreads * kSamples));
+    EXPECT_DOUBLE_EQ(h->min, 1.0);
+    EXPECT_DOUBLE_EQ(h->max, 4.0);
+    EXPECT_DOUBLE_EQ(h->sum, kSamples * (1.0 + 2.0 + 3.0 + 4.0));
+}
+
+TEST(MetricsRegistryTest, FindHistogramRejectsOtherKinds) {
+    auto& registry = MetricsRegistry::getInstance();
+    registry.registerCounter("MetricsTest.NotAHistogram");
+    const MetricsSnapshot snap = registry.snapshot();
+    EXPECT_NE(snap.find("MetricsTest.NotAHistogram"), nullptr);
+    EXPECT_EQ(snap.findHistogram("MetricsTest.NotAHistogram"), nullptr);
+    EXPECT_EQ(snap.find("MetricsTest.DoesNotExist"), nullptr);
+}
+
+TEST(MetricsRegistryTest, ResetClearsValues) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId counter = registry.registerCounter("MetricsTest.ResetCounter");
+    const MetricId histogram = registry.registerHistogram("MetricsTest.ResetHistogram");
+    registry.add(counter, 10);
+    registry.record(histogram, 5.0);
+
+    registry.reset();
+
+    const MetricsSnapshot snap = registry.snapshot();
+    EXPECT_EQ(snap.find("MetricsTest.ResetCounter")->counter, 0u);
+    EXPECT_EQ(snap.findHistogram("MetricsTest.ResetHistogram")->count, 0u);
+
+    // Registrations survive a reset
+    EXPECT_EQ(registry.registerCounter("MetricsTest.ResetCounter"), counter);
+}
+
+// ============================================================================
+// Dumps
+// ============================================================================
+
+TEST(MetricsSnapshotTest, TextAndJsonDumps) {
+    auto& registry = MetricsRegistry::getInstance();
+    const MetricId id = registry.registerHistogram("MetricsTest.Dump");
+    registry.record(id, 2.0);
+    registry.registerCounter("MetricsTest.Dump\"Quoted");
+
+    const MetricsSnapshot snap = registry.snapshot();
+
+    std::ostringstream text;
+    snap.writeText(text);
+    EXPECT_NE(text.str().find("MetricsTest.Dump [histogram] count=1"), std::string::npos);
+
+    std::ostringstream json;
+    snap.writeJson(json);
+    const std::string doc = json.str();
+    EXPECT_EQ(doc.front(), '{');
+    EXPECT_NE(doc.find("\"MetricsTest.Dump\": {\"kind\": \"histogram\", \"count\": 1"),
+              std::string::npos);
+    EXPECT_NE(doc.find("\"MetricsTest.Dump\\\"Quoted\""), std::string::npos);
+}
+
+// ============================================================================
+// Macros
+// ============================================================================
+
+TEST(MetricsMacroTest, MacrosRecordIntoRegistry) {
+#ifdef AXIOM_ENABLE_METRICS
+    for (int i = 0; i < 3; ++i) {
+        AXIOM_METRIC_COUNTER("MetricsTest.MacroCounter", 2);
+        AXIOM_METRIC_GAUGE("MetricsTest.MacroGauge", i);
+        AXIOM_METRIC_HISTOGRAM("MetricsTest.MacroHistogram", 1.5f);
+    }
+    {
+        AXIOM_METRIC_SCOPE_TIMER("MetricsTest.MacroTimer");
+    }
+
+    const MetricsSnapshot snap = MetricsRegistry::getInstance().snapshot();
+    EXPECT_EQ(snap.find("MetricsTest.MacroCounter")->counter, 6u);
+    EXPECT_DOUBLE_EQ(snap.find("MetricsTest.MacroGauge")->gauge, 2.0);
+    EXPECT_EQ(snap.findHistogram("MetricsTest.MacroHistogram")->count, 3u);
+    EXPECT_EQ(snap.findHistogram("MetricsTest.MacroTimer")->count, 1u);
+#else
+    AXIOM_METRIC_COUNTER("MetricsTest.MacroCounter", 2);
+    AXIOM_METRIC_GAUGE("MetricsTest.MacroGauge", 1);
+    AXIOM_METRIC_HISTOGRAM("MetricsTest.MacroHistogram", 1.5f);
+    AXIOM_METRIC_SCOPE_TIMER("MetricsTest.MacroTimer");
+    SUCCEED();
+#endif
+}
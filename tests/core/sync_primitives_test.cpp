@@ -0,0 +1,234 @@
+#include "axiom/core/cache_line.hpp"
+#include "axiom/core/seqlock.hpp"
+#include "axiom/core/spin_mutex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+// ============================================================================
+// CacheLinePadded / ShardedCounter
+// ============================================================================
+
+TEST(CacheLinePaddedTest, OccupiesWholeCacheLines) {
+    static_assert(sizeof(CacheLinePadded<uint32_t>) == CacheLineSize);
+    static_assert(alignof(CacheLinePadded<uint32_t>) == CacheLineSize);
+    static_assert(sizeof(PaddedAtomic<uint64_t>) == CacheLineSize);
+
+    PaddedAtomic<uint64_t> counters[2];
+    const auto first = reinterpret_cast<uintptr_t>(&counters[0].value);
+    const auto second = reinterpret_cast<uintptr_t>(&counters[1].value);
+    EXPECT_EQ(first % CacheLineSize, 0u);
+    EXPECT_EQ(second - first, CacheLineSize);
+}
+
+TEST(CacheLinePaddedTest, ForwardsConstructorArguments) {
+    CacheLinePadded<std::vector<int>> padded(3u, 7);
+    EXPECT_EQ(padded->size(), 3u);
+    EXPECT_EQ(padded.get()[2], 7);
+}
+
+TEST(ShardedCounterTest, ShardCountRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(ShardedCounter(3).getShardCount(), 4u);
+    EXPECT_EQ(ShardedCounter(8).getShardCount(), 8u);
+    EXPECT_GE(ShardedCounter().getShardCount(), 1u);
+}
+
+TEST(ShardedCounterTest, AddLoadReset) {
+    ShardedCounter counter(4);
+    counter.add();
+    counter.add(41);
+    EXPECT_EQ(counter.load(), 42u);
+
+    counter.reset();
+    EXPECT_EQ(counter.load(), 0u);
+}
+
+TEST(ShardedCounterTest, StressConcurrentAdds) {
+    constexpr uint32_t ThreadCount = 8;
+    constexpr uint64_t PerThread = 50000;
+    ShardedCounter counter(4);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back([&counter] {
+            for (uint64_t i = 0; i < PerThread; ++i) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.load(), ThreadCount * PerThread);
+}
+
+// ============================================================================
+// SeqLock
+// ============================================================================
+
+namespace {
+
+/// Every field holds the same value, so a torn read is detectable
+struct Snapshot {
+    uint64_t a = 0;
+    uint64_t b = 0;
+    uint32_t c = 0;
+    float d = 0.0f;
+};
+
+}  // namespace
+
+TEST(SeqLockTest, StoreAndLoad) {
+    SeqLock<Snapshot> lock;
+    EXPECT_EQ(lock.getVersion(), 0u);
+    EXPECT_EQ(lock.load().a, 0u);
+
+    lock.store({1, 2, 3, 4.0f});
+    const Snapshot snapshot = lock.load();
+    EXPECT_EQ(snapshot.a, 1u);
+    EXPECT_EQ(snapshot.b, 2u);
+    EXPECT_EQ(snapshot.c, 3u);
+    EXPECT_FLOAT_EQ(snapshot.d, 4.0f);
+    EXPECT_EQ(lock.getVersion(), 1u);
+}
+
+TEST(SeqLockTest, InitialValue) {
+    SeqLock<int> lock(17);
+    EXPECT_EQ(lock.load(), 17);
+
+    int value = 0;
+    EXPECT_TRUE(lock.tryLoad(value));
+    EXPECT_EQ(value, 17);
+}
+
+TEST(SeqLockTest, StressReadersNeverSeeTornValues) {
+    constexpr uint32_t ReaderCount = 3;
+    constexpr uint64_t Writes = 50000;
+    constexpr uint64_t MinReads = 1000;
+    SeqLock<Snapshot> lock;
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::atomic<uint32_t> started{0};
+    std::array<std::atomic<uint64_t>, ReaderCount> reads{};
+
+    std::vector<std::thread> readers;
+    for (uint32_t r = 0; r < ReaderCount; ++r) {
+        readers.emplace_back([&, r] {
+            started.fetch_add(1, std::memory_order_release);
+            uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const Snapshot snapshot = lock.load();
+                if (snapshot.b != snapshot.a || snapshot.c != static_cast<uint32_t>(snapshot.a) ||
+                    snapshot.d != static_cast<float>(snapshot.c) || snapshot.a < last) {
+                    torn.store(true, std::memory_order_relaxed);
+                }
+                last = snapshot.a;
+                reads[r].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Wait for every reader, then keep writing until each has read enough
+    // values to race the writer (yielding so one core still runs them)
+    while (started.load(std::memory_order_acquire) < ReaderCount) {
+        std::this_thread::yield();
+    }
+    const auto readersDone = [&] {
+        return std::all_of(reads.begin(), reads.end(), [](const std::atomic<uint64_t>& count) {
+            return count.load(std::memory_order_relaxed) >= MinReads;
+        });
+    };
+    // Values stay below 2^24, exactly representable as float
+    uint64_t written = 0;
+    while ((written < Writes || !readersDone()) && written < (1u << 24) - 1) {
+        ++written;
+        const auto value = static_cast<uint32_t>(written);
+        lock.store({value, value, value, static_cast<float>(value)});
+        if (written % 64 == 0 && !readersDone()) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(torn.load());
+    for (const auto& count : reads) {
+        EXPECT_GE(count.load(), MinReads);
+    }
+}
+
+// ============================================================================
+// SpinMutex
+// ============================================================================
+
+TEST(SpinMutexTest, LockUnlock) {
+    SpinMutex mutex;
+    EXPECT_FALSE(mutex.isLocked());
+
+    mutex.lock();
+    EXPECT_TRUE(mutex.isLocked());
+    EXPECT_FALSE(mutex.tryLock());
+    mutex.unlock();
+
+    EXPECT_FALSE(mutex.isLocked());
+    EXPECT_TRUE(mutex.tryLock());
+    mutex.unlock();
+}
+
+TEST(SpinMutexTest, WorksWithStdLocks) {
+    SpinMutex first;
+    SpinMutex second;
+    {
+        std::scoped_lock lock(first, second);
+        EXPECT_TRUE(first.isLocked());
+        EXPECT_TRUE(second.isLocked());
+    }
+    EXPECT_FALSE(first.isLocked());
+    EXPECT_FALSE(second.isLocked());
+}
+
+TEST(SpinMutexTest, StressMutualExclusion) {
+    constexpr uint32_t ThreadCount = 8;
+    constexpr uint32_t PerThread = 20000;
+
+    // Spin count 0 forces every contended acquisition through the parking path
+    for (uint32_t spinCount : {0u, SpinMutex::DefaultSpinCount}) {
+        SpinMutex mutex(spinCount);
+        uint64_t counter = 0;  // Deliberately non-atomic
+        std::atomic<uint32_t> inside{0};
+        std::atomic<bool> overlapped{false};
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < ThreadCount; ++t) {
+            threads.emplace_back([&] {
+                for (uint32_t i = 0; i < PerThread; ++i) {
+                    std::lock_guard<SpinMutex> lock(mutex);
+                    if (inside.fetch_add(1, std::memory_order_relaxed) != 0) {
+                        overlapped.store(true, std::memory_order_relaxed);
+                    }
+                    ++counter;
+                    inside.fetch_sub(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        EXPECT_EQ(counter, uint64_t{ThreadCount} * PerThread) << "spinCount " << spinCount;
+        EXPECT_FALSE(overlapped.load()) << "spinCount " << spinCount;
+        EXPECT_FALSE(mutex.isLocked());
+    }
+}
@@ -0,0 +1,324 @@
+#include "axiom/core/task_graph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace axiom::core;
+
+namespace {
+
+JobSystemConfig makeConfig(uint32_t workers, bool mainThreadParticipates = true) {
+    JobSystemConfig config;
+    config.workerCount = workers;
+    config.mainThreadParticipates = mainThreadParticipates;
+    config.scratchBytesPerWorker = 64 * 1024;
+    return config;
+}
+
+bool contains(const std::vector<uint32_t>& values, uint32_t value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+}  // namespace
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+TEST(TaskGraphTest, DerivesEdgesFromDeclarations) {
+    int a = 0;
+    int b = 0;
+    TaskGraph graph;
+    auto resA = graph.addResource("A", &a);
+    auto resB = graph.addResource("B", &b);
+
+    const uint32_t writeA = graph.addNode("WriteA", [](TaskContext&) {}).writes(resA).getIndex();
+    const uint32_t readA1 = graph.addNode("ReadA1", [](TaskContext&) {}).reads(resA).getIndex();
+    const uint32_t readA2 =
+        graph.addNode("ReadA2", [](TaskContext&) {}).reads(resA).writes(resB).getIndex();
+    const uint32_t rewriteA =
+        graph.addNode("RewriteA", [](TaskContext&) {}).writes(resA).getIndex();
+    const uint32_t writeB = graph.addNode("WriteB", [](TaskContext&) {}).writes(resB).getIndex();
+
+    ASSERT_TRUE(graph.compile().isSuccess());
+    EXPECT_TRUE(graph.isCompiled());
+
+    // Read after write
+    EXPECT_TRUE(contains(graph.getNodeSuccessors(writeA), readA1));
+    EXPECT_TRUE(contains(graph.getNodeSuccessors(writeA), readA2));
+    // Readers of the same version do not depend on each other
+    EXPECT_FALSE(contains(graph.getNodeSuccessors(readA1), readA2));
+    // Write after read
+    EXPECT_TRUE(contains(graph.getNodeSuccessors(readA1), rewriteA));
+    EXPECT_TRUE(contains(graph.getNodeSuccessors(readA2), rewriteA));
+    // Write after write
+    EXPECT_TRUE(contains(graph.getNodeSuccessors(readA2), writeB));
+    EXPECT_TRUE(graph.getNodeSuccessors(rewriteA).empty());
+}
+
+TEST(TaskGraphTest, HeadDependingOnTailIsRejected) {
+    int a = 0;
+    TaskGraph graph;
+    auto resA = graph.addResource("A", &a);
+    graph.addNode("Tail", [](TaskContext&) {}).writes(resA).overlapsNextFrame();
+    graph.addNode("Head", [](TaskContext&) {}).reads(resA);
+
+    auto result = graph.compile();
+    EXPECT_TRUE(result.isFailure());
+    EXPECT_EQ(result.errorCode(), ErrorCode::InvalidParameter);
+    EXPECT_FALSE(graph.isCompiled());
+}
+
+TEST(TaskGraphTest, StageNames) {
+    EXPECT_STREQ(taskStageToString(TaskStage::Broadphase), "Broadphase");
+    EXPECT_STREQ(taskStageToString(TaskStage::Integration), "Integration");
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+TEST(TaskGraphTest, PipelineRunsInDependencyOrder) {
+    JobSystem jobs(makeConfig(4));
+
+    struct Stage {
+        int value = 0;
+    };
+    Stage bodies, aabbs, pairs, contacts, islands, velocities;
+    std::atomic<int> sequence{0};
+    std::vector<int> order(6, -1);
+
+    TaskGraph graph;
+    auto rBodies = graph.addResource("Bodies", &bodies);
+    auto rAabbs = graph.addResource("AABBs", &aabbs);
+    auto rPairs = graph.addResource("Pairs", &pairs);
+    auto rContacts = graph.addResource("Contacts", &contacts);
+    auto rIslands = graph.addResource("Islands", &islands);
+    auto rVelocities = graph.addResource("Velocities", &velocities);
+
+    graph.addNode("Update AABBs", [&](TaskContext& ctx) {
+             order[0] = sequence++;
+             ctx.write(rAabbs).value = ctx.read(rBodies).value + 1;
+         })
+        .reads(rBodies)
+        .writes(rAabbs)
+        .stage(TaskStage::Broadphase);
+    graph.addNode("Broadphase", [&](TaskContext& ctx) {
+             order[1] = sequence++;
+             ctx.write(rPairs).value = ctx.read(rAabbs).value + 1;
+         })
+        .reads(rAabbs)
+        .writes(rPairs)
+        .stage(TaskStage::Broadphase);
+    graph.addNode("Narrowphase", [&](TaskContext& ctx) {
+             order[2] = sequence++;
+             ctx.write(rContacts).value = ctx.read(rPairs).value + 1;
+         })
+        .reads(rPairs)
+        .writes(rContacts)
+        .stage(TaskStage::Narrowphase);
+    graph.addNode("Island build", [&](TaskContext& ctx) {
+             order[3] = sequence++;
+             ctx.write(rIslands).value = ctx.read(rContacts).value + 1;
+         })
+        .reads(rContacts)
+        .writes(rIslands)
+        .stage(TaskStage::Solver);
+    graph.addNode("Solve", [&](TaskContext& ctx) {
+             order[4] = sequence++;
+             ctx.write(rVelocities).value = ctx.read(rIslands).value + 1;
+         })
+        .reads(rIslands)
+        .writes(rVelocities)
+        .stage(TaskStage::Solver);
+    graph.addNode("Integrate", [&](TaskContext& ctx) {
+             order[5] = sequence++;
+             ctx.write(rBodies).value = ctx.read(rVelocities).value + 1;
+         })
+        .reads(rVelocities)
+        .writes(rBodies)
+        .stage(TaskStage::Integration);
+
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    graph.execute(jobs);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(order[static_cast<size_t>(i)], i);
+    }
+    EXPECT_EQ(bodies.value, 6);
+
+    // The same compiled graph runs again
+    sequence = 0;
+    graph.execute(jobs);
+    EXPECT_EQ(bodies.value, 12);
+    EXPECT_EQ(graph.getFrameCount(), 2u);
+    graph.waitIdle(jobs);
+}
+
+TEST(TaskGraphTest, IndependentNodesAllRun) {
+    JobSystem jobs(makeConfig(4));
+    std::vector<int> data(16, 0);
+
+    TaskGraph graph;
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto resource = graph.addResource("Item", &data[i]);
+        graph.addNode("Increment", [resource](TaskContext& ctx) { ++ctx.write(resource); })
+            .writes(resource);
+    }
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    for (int frame = 0; frame < 10; ++frame) {
+        graph.execute(jobs);
+    }
+    graph.waitIdle(jobs);
+
+    for (int value : data) {
+        EXPECT_EQ(value, 10);
+    }
+}
+
+TEST(TaskGraphTest, NodesCanUseParallelFor) {
+    JobSystem jobs(makeConfig(4));
+    std::vector<int> values(1000, 1);
+
+    TaskGraph graph;
+    auto resource = graph.addResource("Values", &values);
+    graph.addNode("Double", [resource](TaskContext& ctx) {
+             auto& v = ctx.write(resource);
+             ctx.getJobSystem().parallelFor(static_cast<uint32_t>(v.size()), 64,
+                                            [&v](uint32_t begin, uint32_t end) {
+                                                for (uint32_t i = begin; i < end; ++i) {
+                                                    v[i] *= 2;
+                                                }
+                                            });
+         })
+        .writes(resource);
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    graph.execute(jobs);
+    graph.waitIdle(jobs);
+    for (int value : values) {
+        EXPECT_EQ(value, 2);
+    }
+}
+
+TEST(TaskGraphTest, TailOverlapsNextFrameHead) {
+    // The main thread must not execute the tail itself while waiting for the head
+    JobSystem jobs(makeConfig(2, false));
+    int state = 0;
+    int debugLines = 0;
+    std::atomic<bool> released{false};
+    std::atomic<bool> tailSawRelease{false};
+
+    TaskGraph graph;
+    auto rState = graph.addResource("State", &state);
+    auto rDebug = graph.addResource("Debug", &debugLines);
+    graph.addNode("Step", [&](TaskContext& ctx) { ++ctx.write(rState); }).writes(rState);
+    graph.addNode("Debug draw", [&](TaskContext& ctx) {
+             const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+             while (!released.load() && std::chrono::steady_clock::now() < deadline) {
+                 std::this_thread::yield();
+             }
+             tailSawRelease = released.load();
+             ctx.write(rDebug) = 1;
+         })
+        .writes(rDebug)
+        .overlapsNextFrame();
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    // execute() returns while the tail is still blocked
+    graph.execute(jobs);
+    EXPECT_EQ(state, 1);
+    released = true;
+    graph.waitIdle(jobs);
+
+    EXPECT_TRUE(tailSawRelease.load());
+    EXPECT_EQ(debugLines, 1);
+}
+
+TEST(TaskGraphTest, ConflictingNextFrameNodesWaitForTail) {
+    JobSystem jobs(makeConfig(3));
+    uint64_t frameValue = 0;
+    std::vector<uint64_t> observed;
+    std::atomic<int> mismatches{0};
+
+    TaskGraph graph;
+    auto rFrame = graph.addResource("Frame", &frameValue);
+    auto rObserved = graph.addResource("Observed", &observed);
+    graph.addNode("Write frame", [&](TaskContext& ctx) { ctx.write(rFrame) = ctx.getFrameIndex(); })
+        .writes(rFrame);
+    graph.addNode("Stats", [&](TaskContext& ctx) {
+             // The next frame's writer must not overwrite the value while this runs
+             const uint64_t seen = ctx.read(rFrame);
+             std::this_thread::yield();
+             if (seen != ctx.getFrameIndex() || ctx.read(rFrame) != seen) {
+                 ++mismatches;
+             }
+             ctx.write(rObserved).push_back(seen);
+         })
+        .reads(rFrame)
+        .writes(rObserved)
+        .overlapsNextFrame();
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    constexpr uint64_t kFrames = 200;
+    for (uint64_t frame = 0; frame < kFrames; ++frame) {
+        graph.execute(jobs);
+    }
+    graph.waitIdle(jobs);
+
+    EXPECT_EQ(mismatches.load(), 0);
+    ASSERT_EQ(observed.size(), kFrames);
+    for (uint64_t frame = 0; frame < kFrames; ++frame) {
+        EXPECT_EQ(observed[frame], frame);
+    }
+}
+
+TEST(TaskGraphTest, RecordsStageTimings) {
+    JobSystem jobs(makeConfig(2));
+    int a = 0;
+    int b = 0;
+
+    TaskGraph graph;
+    auto rA = graph.addResource("A", &a);
+    auto rB = graph.addResource("B", &b);
+    const uint32_t broad =
+        graph.addNode("Broadphase", [](TaskContext&) {
+                 std::this_thread::sleep_for(std::chrono::milliseconds(2));
+             })
+            .writes(rA)
+            .stage(TaskStage::Broadphase)
+            .getIndex();
+    graph.addNode("Solve", [](TaskContext&) {
+             std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         })
+        .reads(rA)
+        .writes(rB)
+        .stage(TaskStage::Solver);
+    ASSERT_TRUE(graph.compile().isSuccess());
+
+    graph.execute(jobs);
+    graph.waitIdle(jobs);
+
+    const TaskGraphTimings& timings = graph.getLastFrameTimings();
+    EXPECT_EQ(timings.frame, 0u);
+    EXPECT_GE(timings.getStageMs(TaskStage::Broadphase), 1.5f);
+    EXPECT_GE(timings.getStageMs(TaskStage::Solver), 0.5f);
+    EXPECT_EQ(timings.getStageMs(TaskStage::Narrowphase), 0.0f);
+    EXPECT_GE(timings.totalMs,
+              timings.getStageMs(TaskStage::Broadphase) + timings.getStageMs(TaskStage::Solver));
+    EXPECT_GE(graph.getNodeTimeMs(broad), 1.5f);
+    EXPECT_STREQ(graph.getNodeName(broad), "Broadphase");
+
+#ifdef AXIOM_ENABLE_METRICS
+    const MetricsSnapshot snap = MetricsRegistry::getInstance().snapshot();
+    const HistogramSnapshot* step = snap.findHistogram(metric_names::StepTime);
+    ASSERT_NE(step, nullptr);
+    EXPECT_GE(step->count, 1u);
+#endif
+}
@@ -1,3 +1,4 @@
+#include "axiom/collision/contact_manifold.hpp"
 #include "axiom/debug/debug_draw.hpp"
 #include "axiom/debug/physics_debug_draw.hpp"
 #include "axiom/gpu/vk_instance.hpp"
@@ -177,6 +178,29 @@ TEST_F(PhysicsDebugDrawTest, DrawPlaneShape) {
     EXPECT_GT(vertexCountAfter, vertexCountBefore);
 }
 
+// Test drawing a triangle mesh shape
+TEST_F(PhysicsDebugDrawTest, DrawMeshShape) {
+    createPhysicsDebugDraw();
+
+    // Two triangles forming a quad
+    const float vertices[] = {0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1};
+    const uint32_t indices[] = {0, 2, 1, 0, 3, 2};
+    DebugShape mesh;
+    mesh.type = ShapeType::Mesh;
+    mesh.transform = Transform(Vec3(0, 0, 0), Quat::identity());
+    mesh.vertices = vertices;
+    mesh.vertexCount = 4;
+    mesh.indices = indices;
+    mesh.indexCount = 6;
+
+    size_t vertexCountBefore = debugDraw_->getVertexCount();
+    ASSERT_NO_THROW({ physicsDebugDraw_->drawCollisionShape(mesh); });
+    size_t vertexCountAfter = debugDraw_->getVertexCount();
+
+    // The shared diagonal is drawn once: 5 edges = 10 vertices
+    EXPECT_EQ(vertexCountAfter - vertexCountBefore, 10u);
+}
+
 // Test drawing a contact point
 TEST_F(PhysicsDebugDrawTest, DrawContactPoint) {
     createPhysicsDebugDraw();
@@ -212,6 +236,30 @@ TEST_F(PhysicsDebugDrawTest, DrawContactPointDisabled) {
     EXPECT_EQ(vertexCountAfter, vertexCountBefore);
 }
 
+// Test drawing a persistent contact manifold
+TEST_F(PhysicsDebugDrawTest, DrawContactManifold) {
+    createPhysicsDebugDraw();
+
+    axiom::collision::ContactManifold contacts;
+    contacts.normal = Vec3(0, 1, 0);
+    contacts.pointCount = 2;
+    contacts.points[1].pointA = contacts.points[1].pointB = Vec3(1, 0, 0);
+    contacts.points[1].featureId = 1;
+    axiom::collision::PersistentManifold manifold;
+    manifold.update(contacts, Transform(Vec3(0, 0, 0)), Transform(Vec3(0, 0, 0)));
+
+    DebugContactPoint contact;
+    contact.normal = Vec3(0, 1, 0);
+    size_t vertexCountBefore = debugDraw_->getVertexCount();
+    physicsDebugDraw_->drawContactPoint(contact);
+    const size_t verticesPerPoint = debugDraw_->getVertexCount() - vertexCountBefore;
+
+    // One contact point visualization per manifold point
+    vertexCountBefore = debugDraw_->getVertexCount();
+    physicsDebugDraw_->drawContactManifold(manifold);
+    EXPECT_EQ(debugDraw_->getVertexCount() - vertexCountBefore, 2 * verticesPerPoint);
+}
+
 // Test drawing a constraint
 TEST_F(PhysicsDebugDrawTest, DrawConstraint) {
     createPhysicsDebugDraw();
@@ -284,4 +284,72 @@ TEST_F(PhysicsDebugPanelTest, VeryLargeBodyCounts) {
     ImGui::Render();
 }
 
+// Test: applyMetrics fills the distribution fields from registry histograms
+TEST_F(PhysicsDebugPanelTest, ApplyMetricsFillsPercentiles) {
+    auto& registry = core::MetricsRegistry::getInstance();
+    const core::MetricId step = registry.registerHistogram(core::metric_names::StepTime);
+    const core::MetricId pairs = registry.registerHistogram(core::metric_names::BroadphasePairs);
+    registry.reset();
+    for (int i = 1; i <= 100; ++i) {
+        registry.record(step, static_cast<double>(i) * 0.1);
+        registry.record(pairs, 1000.0);
+    }
+
+    PhysicsWorldStats stats{};
+    applyMetrics(registry.snapshot(), stats);
+
+    EXPECT_EQ(stats.stepSampleCount, 100u);
+    EXPECT_NEAR(stats.stepTimeP50, 5.0f, 0.2f);
+    EXPECT_NEAR(stats.stepTimeP99, 9.9f, 0.4f);
+    EXPECT_FLOAT_EQ(stats.stepTimeMax, 10.0f);
+    EXPECT_EQ(stats.broadphasePairsMax, 1000u);
+    EXPECT_NEAR(static_cast<float>(stats.broadphasePairsP50), 1000.0f, 35.0f);
+
+    // Panel renders the percentile block without issues
+    PhysicsDebugPanel panel;
+    PhysicsWorldConfig config{};
+    ImGui::NewFrame();
+    EXPECT_NO_THROW({ panel.render(stats, config); });
+    ImGui::Render();
+}
+
+// Test: applyTaskGraphTimings copies frame and stage times
+TEST_F(PhysicsDebugPanelTest, ApplyTaskGraphTimings) {
+    core::TaskGraphTimings timings;
+    timings.totalMs = 4.0f;
+    timings.stageMs[static_cast<size_t>(core::TaskStage::Broadphase)] = 1.0f;
+    timings.stageMs[static_cast<size_t>(core::TaskStage::Narrowphase)] = 0.5f;
+    timings.stageMs[static_cast<size_t>(core::TaskStage::Solver)] = 2.0f;
+    timings.stageMs[static_cast<size_t>(core::TaskStage::Integration)] = 0.25f;
+
+    PhysicsWorldStats stats{};
+    applyTaskGraphTimings(timings, stats);
+
+    EXPECT_FLOAT_EQ(stats.totalStepTime, 4.0f);
+    EXPECT_FLOAT_EQ(stats.broadphaseTime, 1.0f);
+    EXPECT_FLOAT_EQ(stats.narrowphaseTime, 0.5f);
+    EXPECT_FLOAT_EQ(stats.solverTime, 2.0f);
+    EXPECT_FLOAT_EQ(stats.integrationTime, 0.25f);
+}
+
+// Test: applyContactManifolds counts the points of the persistent manifolds
+TEST_F(PhysicsDebugPanelTest, ApplyContactManifolds) {
+    collision::OverlappingPairCache pairs;
+    pairs.beginUpdate();
+    pairs.addPair(0, 1);
+    pairs.endUpdate();
+
+    collision::ContactManifold contacts;
+    contacts.normal = math::Vec3::unitY();
+    contacts.pointCount = 2;
+    contacts.points[1].pointA = contacts.points[1].pointB = math::Vec3(1.0f, 0.0f, 0.0f);
+    contacts.points[1].featureId = 1;
+    const math::Transform identity(math::Vec3::zero());
+    pairs.getManifold(pairs.findPair(0, 1)).update(contacts, identity, identity);
+
+    PhysicsWorldStats stats{};
+    applyContactManifolds(pairs, stats);
+    EXPECT_EQ(stats.contactPointCount, 2u);
+}
+
 }  // namespace axiom::gui